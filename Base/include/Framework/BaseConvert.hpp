@@ -28,13 +28,17 @@
 
 #pragma once
 
+#include "Framework/Collection/Array.hpp"
 #include "Framework/ParseException.hpp"
 #include "Framework/String.hpp"
 
 namespace bpf
 {
     /**
-     * Utility class to convert numbers in bases different from decimal
+     * Utility class to convert numbers in bases different from decimal.
+     * ASCII alphabets are decoded through a 256 entry reverse lookup table built once in the constructor;
+     * alphabets whose size is a power of two use shifts and masks instead of divisions and can also encode
+     * and decode whole byte buffers (ex: base16, base32 or base64 without padding)
      * WARNING: This class does not work on decimal types
      * @tparam T the type of number
      */
@@ -42,32 +46,94 @@ namespace bpf
     class BP_TPL_API BaseConvert
     {
     private:
+        static constexpr uint8 INVALID_DIGIT = 0xFF;
+
         String _base;
+        T _radix;
+        uint32 _shift;
+        bool _ascii;
+        char _digits[128];
+        uint8 _reverse[256];
+        collection::Array<fchar> _unicode;
+
+        String ToStringUnicode(T nbr) const;
+        T FromStringUnicode(const String &nbr) const;
+        void CheckBulk() const;
 
     public:
         /**
          * Constructs an instance of BaseConvert
          * @param base the set of characters to use for the base
          */
-        inline explicit BaseConvert(String base)
-            : _base(std::move(base))
-        {
-        }
+        explicit BaseConvert(String base);
 
         /**
          * Converts a number string to an actual number type
          * @param nbr the number string
+         * @throw ParseException if nbr contains a character outside of the base or does not fit in T
          * @return the converted number
          */
-        T FromString(const String &nbr);
+        T FromString(const String &nbr) const;
 
         /**
          * Converts a number type to a number string
-         * @param nbr the number to convert to a string
+         * @param nbr the number to convert to a string, negative numbers give an empty string
          * @return the number as a string in the target base
          */
-        String ToString(T nbr);
+        String ToString(T nbr) const;
+
+        /**
+         * Returns the number of bits encoded by a single digit
+         * @return log2 of the base size if it is a power of two, 0 otherwise
+         */
+        inline uint32 GetBitsPerDigit() const noexcept
+        {
+            return (_shift);
+        }
+
+        /**
+         * Returns the number of digits Encode writes for a buffer
+         * @param size the size in bytes of the buffer to encode
+         * @return number of characters
+         */
+        inline fsize GetEncodedSize(const fsize size) const noexcept
+        {
+            return (_shift == 0 ? 0 : (size * 8 + _shift - 1) / _shift);
+        }
+
+        /**
+         * Returns the number of bytes Decode writes for a string
+         * @param len the number of characters to decode
+         * @return number of bytes
+         */
+        inline fsize GetDecodedSize(const fsize len) const noexcept
+        {
+            return (len * _shift / 8);
+        }
+
+        /**
+         * Encodes a byte buffer, most significant bits first; the last digit is padded with zero bits.
+         * Requires an ASCII base whose size is a power of two
+         * @param data the bytes to encode
+         * @param size the number of bytes to encode
+         * @param out output buffer of at least GetEncodedSize(size) characters, not null terminated
+         * @throw RuntimeException if the base does not support bulk encoding
+         * @return number of characters written
+         */
+        fsize Encode(const void *data, fsize size, char *out) const;
+
+        /**
+         * Decodes characters produced by Encode; trailing padding bits are dropped.
+         * Requires an ASCII base whose size is a power of two
+         * @param str the characters to decode
+         * @param len the number of characters to decode
+         * @param out output buffer of at least GetDecodedSize(len) bytes
+         * @throw ParseException if str contains a character outside of the base
+         * @throw RuntimeException if the base does not support bulk encoding
+         * @return number of bytes written
+         */
+        fsize Decode(const char *str, fsize len, void *out) const;
     };
 }
 
-#include "Framework/BaseConvert.impl.hpp"
\ No newline at end of file
+#include "Framework/BaseConvert.impl.hpp"
@@ -27,37 +27,210 @@
 // SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #pragma once
+#include "Framework/RuntimeException.hpp"
+#include <cstring>
+#include <limits>
+#include <type_traits>
 
 namespace bpf
 {
     template <typename T>
-    T BaseConvert<T>::FromString(const String &nbr)
+    constexpr uint8 BaseConvert<T>::INVALID_DIGIT;
+
+    template <typename T>
+    BaseConvert<T>::BaseConvert(String base)
+        : _base(std::move(base))
+        , _radix(static_cast<T>(_base.Len()))
+        , _shift(0)
+        , _ascii(_base.Size() == _base.Len() && _base.Len() <= 128)
     {
-        T res = 0;
-        T cb = 1;
+        if (_base.Len() < 2)
+            throw RuntimeException("BaseConvert", "A base needs at least 2 digits");
+        if ((_base.Len() & (_base.Len() - 1)) == 0)
+        {
+            while ((1 << _shift) < _base.Len())
+                ++_shift;
+        }
+        std::memset(_reverse, INVALID_DIGIT, sizeof(_reverse));
+        if (!_ascii)
+        {
+            _unicode = _base.ToUTF32();
+            return;
+        }
+        for (fisize i = 0; i != _base.Size(); ++i)
+        {
+            _digits[i] = (*_base)[i];
+            auto c = static_cast<uint8>(_digits[i]);
+            if (_reverse[c] == INVALID_DIGIT)
+                _reverse[c] = static_cast<uint8>(i);
+        }
+    }
+
+    template <typename T>
+    T BaseConvert<T>::FromStringUnicode(const String &nbr) const
+    {
+        using U = typename std::make_unsigned<T>::type;
+        const auto limit = static_cast<U>(std::numeric_limits<T>::max());
+        auto radix = static_cast<U>(_radix);
+        const auto count = static_cast<fsize>(_base.Len());
+        auto chars = nbr.ToUTF32();
+        U res = 0;
 
-        for (fisize i = nbr.Len() - 1; i >= 0; --i)
+        for (fisize i = 0; i != nbr.Len(); ++i)
         {
-            if (!_base.Contains(nbr[i]))
+            fsize d = 0;
+            while (d != count && _unicode[d] != chars[i])
+                ++d;
+            if (d == count)
                 throw ParseException("Invalid string");
-            res += (T)(_base.IndexOf(nbr[i])) * cb;
-            cb *= (T)_base.Len();
+            if (res > (limit - d) / radix)
+                throw ParseException("Out of range");
+            res = res * radix + static_cast<U>(d);
         }
-        return (res);
+        return (static_cast<T>(res));
     }
 
     template <typename T>
-    String BaseConvert<T>::ToString(T nbr)
+    T BaseConvert<T>::FromString(const String &nbr) const
     {
-        String res = "";
+        using U = typename std::make_unsigned<T>::type;
+        const auto limit = static_cast<U>(std::numeric_limits<T>::max());
+        const char *str = *nbr;
+        U res = 0;
 
-        if (nbr == 0)
-            return ("0");
-        while (nbr > 0)
+        if (!_ascii)
+            return (FromStringUnicode(nbr));
+        if (_shift != 0)
         {
-            res += _base[nbr % _base.Len()];
-            nbr /= (T)_base.Len();
+            for (fisize i = 0; i != nbr.Size(); ++i)
+            {
+                uint8 d = _reverse[static_cast<uint8>(str[i])];
+                if (d == INVALID_DIGIT)
+                    throw ParseException("Invalid string");
+                if (res > (limit >> _shift))
+                    throw ParseException("Out of range");
+                res = (res << _shift) | d;
+            }
+            return (static_cast<T>(res));
+        }
+        auto radix = static_cast<U>(_radix);
+        for (fisize i = 0; i != nbr.Size(); ++i)
+        {
+            uint8 d = _reverse[static_cast<uint8>(str[i])];
+            if (d == INVALID_DIGIT)
+                throw ParseException("Invalid string");
+            if (res > (limit - d) / radix)
+                throw ParseException("Out of range");
+            res = res * radix + d;
+        }
+        return (static_cast<T>(res));
+    }
+
+    template <typename T>
+    String BaseConvert<T>::ToStringUnicode(T nbr) const
+    {
+        fchar digits[sizeof(T) * 8 + 1];
+        fsize pos = sizeof(T) * 8;
+
+        digits[pos] = 0;
+        do
+        {
+            digits[--pos] = _unicode[static_cast<fsize>(nbr % _radix)];
+            nbr /= _radix;
+        } while (nbr > 0);
+        return (String::FromUTF32(digits + pos));
+    }
+
+    template <typename T>
+    String BaseConvert<T>::ToString(T nbr) const
+    {
+        using U = typename std::make_unsigned<T>::type;
+        char digits[sizeof(T) * 8];
+        char *end = digits + sizeof(T) * 8;
+        char *p = end;
+
+        if (nbr < 0)
+            return ("");
+        if (!_ascii)
+            return (ToStringUnicode(nbr));
+        auto value = static_cast<U>(nbr);
+        if (_shift != 0)
+        {
+            const auto mask = static_cast<U>(_radix - 1);
+            do
+            {
+                *--p = _digits[value & mask];
+                value >>= _shift;
+            } while (value != 0);
+        }
+        else
+        {
+            auto radix = static_cast<U>(_radix);
+            do
+            {
+                *--p = _digits[value % radix];
+                value /= radix;
+            } while (value != 0);
+        }
+        return (String(p, static_cast<fsize>(end - p)));
+    }
+
+    template <typename T>
+    void BaseConvert<T>::CheckBulk() const
+    {
+        if (!_ascii || _shift == 0)
+            throw RuntimeException("BaseConvert", "Bulk conversion requires an ASCII base whose size is a power of two");
+    }
+
+    template <typename T>
+    fsize BaseConvert<T>::Encode(const void *data, const fsize size, char *out) const
+    {
+        const auto *bytes = static_cast<const uint8 *>(data);
+        const uint32 mask = (1U << _shift) - 1;
+        char *start = out;
+        uint32 acc = 0;
+        uint32 bits = 0;
+
+        CheckBulk();
+        for (fsize i = 0; i != size; ++i)
+        {
+            acc = (acc << 8) | bytes[i];
+            bits += 8;
+            while (bits >= _shift)
+            {
+                bits -= _shift;
+                *out++ = _digits[(acc >> bits) & mask];
+            }
+            acc &= (1U << bits) - 1;
+        }
+        if (bits > 0)
+            *out++ = _digits[(acc << (_shift - bits)) & mask];
+        return (static_cast<fsize>(out - start));
+    }
+
+    template <typename T>
+    fsize BaseConvert<T>::Decode(const char *str, const fsize len, void *out) const
+    {
+        auto *bytes = static_cast<uint8 *>(out);
+        uint8 *start = bytes;
+        uint32 acc = 0;
+        uint32 bits = 0;
+
+        CheckBulk();
+        for (fsize i = 0; i != len; ++i)
+        {
+            uint8 d = _reverse[static_cast<uint8>(str[i])];
+            if (d == INVALID_DIGIT)
+                throw ParseException("Invalid string");
+            acc = (acc << _shift) | d;
+            bits += _shift;
+            if (bits >= 8)
+            {
+                bits -= 8;
+                *bytes++ = static_cast<uint8>(acc >> bits);
+                acc &= (1U << bits) - 1;
+            }
         }
-        return (res.Reverse());
+        return (static_cast<fsize>(bytes - start));
     }
 }
@@ -28,6 +28,7 @@
 
 #pragma once
 #include "Framework/Collection/Array.Iterator.hpp"
+#include "Framework/Collection/Sorting.hpp"
 #include "Framework/Collection/Utility.hpp"
 #include "Framework/IndexException.hpp"
 #include "Framework/TypeInfo.hpp"
@@ -119,6 +120,23 @@ namespace bpf
              */
             void Swap(const Iterator &a, const Iterator &b);
 
+            /**
+             * Sorts this collection in place
+             * @param stable if true this function will apply an adaptive Merge-Sort algorithm, otherwise this function uses a pattern-defeating Quick-Sort algorithm
+             * @tparam Comparator comparision operator
+             */
+            template <template <typename> class Comparator = ops::Less>
+            void Sort(bool stable = false);
+
+            /**
+             * Sorts this collection in place using a ThreadPool
+             * @param pool the ThreadPool to sort on
+             * @param stable if true the order of equal elements is preserved
+             * @tparam Comparator comparision operator
+             */
+            template <template <typename> class Comparator = ops::Less>
+            void Sort(system::ThreadPool &pool, bool stable = false);
+
             /**
              * Returns the length of the array
              * @return size of collection as an unsigned number
@@ -384,6 +402,23 @@ namespace bpf
              */
             void Swap(const Iterator &a, const Iterator &b);
 
+            /**
+             * Sorts this collection in place
+             * @param stable if true this function will apply an adaptive Merge-Sort algorithm, otherwise this function uses a pattern-defeating Quick-Sort algorithm
+             * @tparam Comparator comparision operator
+             */
+            template <template <typename> class Comparator = ops::Less>
+            void Sort(bool stable = false);
+
+            /**
+             * Sorts this collection in place using a ThreadPool
+             * @param pool the ThreadPool to sort on
+             * @param stable if true the order of equal elements is preserved
+             * @tparam Comparator comparision operator
+             */
+            template <template <typename> class Comparator = ops::Less>
+            void Sort(system::ThreadPool &pool, bool stable = false);
+
             /**
              * Returns an element const mode
              * @param id the index of the element, in case of out of bounds, throws
@@ -180,6 +180,40 @@ namespace bpf
             _arr[b.Position()] = std::move(tmp);
         }
 
+        template <typename T, fsize I>
+        template <template <typename> class Comparator>
+        void Array<T, I>::Sort(const bool stable)
+        {
+            if (stable)
+                Sorting::Stable<Comparator>(_arr, I);
+            else
+                Sorting::Unstable<Comparator>(_arr, I);
+        }
+
+        template <typename T>
+        template <template <typename> class Comparator>
+        void Array<T>::Sort(const bool stable)
+        {
+            if (stable)
+                Sorting::Stable<Comparator>(_arr, _size);
+            else
+                Sorting::Unstable<Comparator>(_arr, _size);
+        }
+
+        template <typename T, fsize I>
+        template <template <typename> class Comparator>
+        void Array<T, I>::Sort(system::ThreadPool &pool, const bool stable)
+        {
+            Sorting::Parallel<Comparator>(pool, _arr, I, stable);
+        }
+
+        template <typename T>
+        template <template <typename> class Comparator>
+        void Array<T>::Sort(system::ThreadPool &pool, const bool stable)
+        {
+            Sorting::Parallel<Comparator>(pool, _arr, _size, stable);
+        }
+
         template <typename T, fsize I>
         typename Array<T, I>::Iterator Array<T, I>::FindByKey(const fsize pos)
         {
@@ -28,6 +28,7 @@
 
 #pragma once
 #include "Framework/Collection/Array.hpp"
+#include "Framework/Collection/Sorting.hpp"
 
 namespace bpf
 {
@@ -43,14 +44,6 @@ namespace bpf
         private:
             fsize _curid;
             Array<T> _arr;
-            template <template <typename> class Comparator>
-            fsize Partition(fsize start, fsize end);
-            template <template <typename> class Comparator>
-            void QuickSort(fsize start, fsize end);
-            template <template <typename> class Comparator>
-            void Merge(const Array<T> &a, Array<T> &c, fsize start, fsize mid, fsize end);
-            template <template <typename> class Comparator>
-            void MergeSort();
 
         public:
             using Iterator = typename Array<T>::Iterator;
@@ -395,12 +388,21 @@ namespace bpf
 
             /**
              * Sorts this collection in place
-             * @param stable if true this function will apply a Merge-Sort algorithm, otherwise this function uses the Quick-Sort algorithm
+             * @param stable if true this function will apply an adaptive Merge-Sort algorithm, otherwise this function uses a pattern-defeating Quick-Sort algorithm
              * @tparam Comparator comparision operator
              */
             template <template <typename> class Comparator = ops::Less>
             void Sort(bool stable = false);
 
+            /**
+             * Sorts this collection in place using a ThreadPool
+             * @param pool the ThreadPool to sort on
+             * @param stable if true the order of equal elements is preserved
+             * @tparam Comparator comparision operator
+             */
+            template <template <typename> class Comparator = ops::Less>
+            void Sort(system::ThreadPool &pool, bool stable = false);
+
             /**
              * Returns an iterator to the begining of the collection
              * @return new iterator
@@ -150,114 +150,19 @@ namespace bpf
 
         template <typename T>
         template <template <typename> class Comparator>
-        void ArrayList<T>::Merge(const Array<T> &a, Array<T> &c, const fsize start, const fsize mid, const fsize end)
-        {
-            fsize n1 = mid - start + 1;
-            fsize n2 = end - mid;
-            fsize i = 0;
-            fsize j = 0;
-            fsize k = 0;
-
-            while (i < n1 || j < n2)
-            {
-                if (i < n1 && j < n2)
-                {
-                    if (Comparator<T>::Eval(a[mid + 1 + j], a[start + i]))
-                    {
-                        c[k + start] = std::move(a[mid + 1 + j]);
-                        ++j;
-                    }
-                    else
-                    {
-                        c[k + start] = std::move(a[start + i]);
-                        ++i;
-                    }
-                    ++k;
-                }
-                else if (i < n1)
-                {
-                    c[k + start] = std::move(a[start + i]);
-                    ++k;
-                    ++i;
-                }
-                else if (j < n2)
-                {
-                    c[k + start] = std::move(a[mid + 1 + j]);
-                    ++k;
-                    ++j;
-                }
-            }
-        }
-
-        template <typename T>
-        template <template <typename> class Comparator>
-        void ArrayList<T>::MergeSort()
-        {
-            fsize n = _curid;
-            Array<T> c(_curid);
-            Array<T> &a = _arr;
-            fsize sz = 1;
-
-            while (sz <= n - 1)
-            {
-                for (fsize i = 0; i < n - 1; i += sz * 2)
-                {
-                    fsize mid = (n - 1 < i + sz - 1) ? n - 1 : i + sz - 1;
-                    fsize end = (n - 1 < i + 2 * sz - 1) ? n - 1 : i + 2 * sz - 1;
-
-                    Merge<Comparator>(a, c, i, mid, end);
-                }
-                auto tmp = std::move(c);
-                c = std::move(a);
-                a = std::move(tmp);
-                sz *= 2;
-            }
-        }
-
-        template <typename T>
-        template <template <typename> class Comparator>
-        fsize ArrayList<T>::Partition(fsize start, fsize end)
-        {
-            fsize x = end;
-            fsize iter = start;
-            for (fsize j = start; j < end; ++j)
-            {
-                if (Comparator<T>::Eval(_arr[j], _arr[x]))
-                {
-                    T tmp = std::move(_arr[iter]);
-                    _arr[iter] = std::move(_arr[j]);
-                    _arr[j] = std::move(tmp);
-                    ++iter;
-                }
-            }
-            T tmp = std::move(_arr[iter]);
-            _arr[iter] = std::move(_arr[end]);
-            _arr[end] = std::move(tmp);
-            return (iter);
-        }
-
-        template <typename T>
-        template <template <typename> class Comparator>
-        void ArrayList<T>::QuickSort(fsize start, fsize end)
+        void ArrayList<T>::Sort(const bool stable)
         {
-            if (start < _curid && end < _curid && start < end)
-            {
-                fsize res = Partition<Comparator>(start, end);
-                QuickSort<Comparator>(start, res - 1);
-                QuickSort<Comparator>(res + 1, end);
-            }
+            if (stable)
+                Sorting::Stable<Comparator>(*_arr, _curid);
+            else
+                Sorting::Unstable<Comparator>(*_arr, _curid);
         }
 
         template <typename T>
         template <template <typename> class Comparator>
-        void ArrayList<T>::Sort(const bool stable)
+        void ArrayList<T>::Sort(system::ThreadPool &pool, const bool stable)
         {
-            if (_curid == 0 || _curid == 1)
-                return;
-            if (!stable)
-                QuickSort<Comparator>(0, _curid - 1);
-            else
-                MergeSort<Comparator>();
+            Sorting::Parallel<Comparator>(pool, *_arr, _curid, stable);
         }
 
         template <typename T>
@@ -0,0 +1,246 @@
+// Copyright (c) 2020, BlockProject 3D
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without modification,
+// are permitted provided that the following conditions are met:
+// 
+//     * Redistributions of source code must retain the above copyright notice,
+//       this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above copyright notice,
+//       this list of conditions and the following disclaimer in the documentation
+//       and/or other materials provided with the distribution.
+//     * Neither the name of BlockProject 3D nor the names of its contributors
+//       may be used to endorse or promote products derived from this software
+//       without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#pragma once
+#include "Framework/Collection/Iterator.hpp"
+
+namespace bpf
+{
+    namespace collection
+    {
+        namespace _bpf_internal_btree
+        {
+            /**
+             * Position in the linked leaf level of a BTreeMap
+             * @tparam LeafType the leaf node type
+             * @tparam Reverse true to walk from the maximum key to the minimum key
+             */
+            template <typename LeafType, bool Reverse>
+            class Cursor
+            {
+            private:
+                // Moves toward greater keys, falls off the chain after the last entry
+                void Up() noexcept
+                {
+                    if (_node == nullptr)
+                        return;
+                    if (++_index == _node->Count)
+                    {
+                        _node = _node->Next;
+                        _index = 0;
+                    }
+                }
+
+                // Moves toward smaller keys, falls off the chain before the first entry
+                void Down() noexcept
+                {
+                    if (_node == nullptr)
+                        return;
+                    if (_index > 0)
+                        --_index;
+                    else
+                    {
+                        _node = _node->Prev;
+                        _index = _node != nullptr ? _node->Count - 1 : 0;
+                    }
+                }
+
+            public:
+                LeafType *_node;
+                fsize _index;
+                LeafType *_edge;
+
+                inline Cursor(LeafType *node, const fsize index, LeafType *edge) noexcept
+                    : _node(node)
+                    , _index(index)
+                    , _edge(edge)
+                {
+                }
+
+                inline void Next() noexcept
+                {
+                    if (Reverse)
+                        Down();
+                    else
+                        Up();
+                }
+
+                void Previous() noexcept
+                {
+                    if (_node == nullptr)
+                    {
+                        // Going back from end() restarts at the edge of the leaf chain
+                        _node = _edge;
+                        _index = (_node != nullptr && !Reverse) ? _node->Count - 1 : 0;
+                    }
+                    else if (Reverse && (_index + 1 < _node->Count || _node->Next != nullptr))
+                        Up();
+                    else if (!Reverse && (_index > 0 || _node->Prev != nullptr))
+                        Down();
+                }
+
+                inline bool operator==(const Cursor &other) const noexcept
+                {
+                    return (_node == other._node && _index == other._index);
+                }
+            };
+        }
+
+        template <typename EntryType, typename LeafType, bool Reverse = false>
+        class BP_TPL_API BTreeMapConstIterator
+            : public ConstIterator<BTreeMapConstIterator<EntryType, LeafType, Reverse>, EntryType>
+        {
+        private:
+            _bpf_internal_btree::Cursor<LeafType, Reverse> _cursor;
+
+        public:
+            inline BTreeMapConstIterator(LeafType *node, const fsize index, LeafType *edge)
+                : _cursor(node, index, edge)
+            {
+            }
+
+            inline BTreeMapConstIterator &operator++()
+            {
+                _cursor.Next();
+                return (*this);
+            }
+
+            inline BTreeMapConstIterator &operator--()
+            {
+                _cursor.Previous();
+                return (*this);
+            }
+
+            inline const EntryType &operator*() const
+            {
+                return (_cursor._node->Entries[_cursor._index]);
+            }
+
+            inline const EntryType *operator->() const
+            {
+                return (&_cursor._node->Entries[_cursor._index]);
+            }
+
+            inline bool operator==(const BTreeMapConstIterator &other) const
+            {
+                return (_cursor == other._cursor);
+            }
+
+            inline bool operator!=(const BTreeMapConstIterator &other) const
+            {
+                return (!(_cursor == other._cursor));
+            }
+        };
+
+        template <typename Map, typename EntryType, typename LeafType, bool Reverse = false>
+        class BP_TPL_API BTreeMapIterator : public Iterator<BTreeMapIterator<Map, EntryType, LeafType, Reverse>, EntryType>
+        {
+        private:
+            _bpf_internal_btree::Cursor<LeafType, Reverse> _cursor;
+
+        public:
+            inline BTreeMapIterator(LeafType *node, const fsize index, LeafType *edge)
+                : _cursor(node, index, edge)
+            {
+            }
+
+            inline BTreeMapIterator &operator++()
+            {
+                _cursor.Next();
+                return (*this);
+            }
+
+            inline BTreeMapIterator &operator--()
+            {
+                _cursor.Previous();
+                return (*this);
+            }
+
+            inline EntryType &operator*()
+            {
+                return (_cursor._node->Entries[_cursor._index]);
+            }
+
+            inline EntryType *operator->()
+            {
+                return (&_cursor._node->Entries[_cursor._index]);
+            }
+
+            inline const EntryType &operator*() const
+            {
+                return (_cursor._node->Entries[_cursor._index]);
+            }
+
+            inline const EntryType *operator->() const
+            {
+                return (&_cursor._node->Entries[_cursor._index]);
+            }
+
+            inline bool operator==(const BTreeMapIterator &other) const
+            {
+                return (_cursor == other._cursor);
+            }
+
+            inline bool operator!=(const BTreeMapIterator &other) const
+            {
+                return (!(_cursor == other._cursor));
+            }
+
+            friend Map;
+        };
+
+        /**
+         * Pair of iterators usable in a range-based for loop
+         * @tparam I the iterator type
+         */
+        template <typename I>
+        class BP_TPL_API BTreeMapRange
+        {
+        private:
+            I _begin;
+            I _end;
+
+        public:
+            inline BTreeMapRange(const I &begin, const I &end)
+                : _begin(begin)
+                , _end(end)
+            {
+            }
+
+            inline I begin() const
+            {
+                return (_begin);
+            }
+
+            inline I end() const
+            {
+                return (_end);
+            }
+        };
+    }
+}
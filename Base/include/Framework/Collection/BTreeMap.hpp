@@ -0,0 +1,456 @@
+// Copyright (c) 2020, BlockProject 3D
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without modification,
+// are permitted provided that the following conditions are met:
+// 
+//     * Redistributions of source code must retain the above copyright notice,
+//       this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above copyright notice,
+//       this list of conditions and the following disclaimer in the documentation
+//       and/or other materials provided with the distribution.
+//     * Neither the name of BlockProject 3D nor the names of its contributors
+//       may be used to endorse or promote products derived from this software
+//       without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#pragma once
+#include "Framework/Collection/BTreeMap.Iterator.hpp"
+#include "Framework/Collection/Utility.hpp"
+#include "Framework/IndexException.hpp"
+#include "Framework/Types.hpp"
+#include <initializer_list>
+
+namespace bpf
+{
+    namespace collection
+    {
+        namespace _bpf_internal_btree
+        {
+            /**
+             * Number of items of a given size fitting in a node of a given size, clamped to [8, 64]
+             */
+            constexpr fsize NodeCapacity(const fsize size, const fsize bytes)
+            {
+                return (bytes / size < 8 ? 8 : (bytes / size > 64 ? 64 : bytes / size));
+            }
+        }
+
+        /**
+         * B+ tree based ordered map. Entries are stored in wide leaves linked together, so lookups touch
+         * one node per level and iteration walks contiguous arrays. Requires default constructible keys and values.
+         * Any insertion or removal invalidates all iterators
+         * @tparam K the key type
+         * @tparam V the value type
+         * @tparam Less the less than operator
+         */
+        template <typename K, typename V, template <typename T> class Less = ops::Less>
+        class BP_TPL_API BTreeMap
+        {
+        public:
+            struct Entry
+            {
+                K Key;
+                V Value;
+            };
+
+            /**
+             * Number of entries per leaf, leaves span a few cache lines
+             */
+            static constexpr fsize LEAF_SIZE = _bpf_internal_btree::NodeCapacity(sizeof(Entry), 512);
+
+            /**
+             * Number of keys per inner node
+             */
+            static constexpr fsize INNER_SIZE = _bpf_internal_btree::NodeCapacity(sizeof(K) + sizeof(void *), 512);
+
+            struct Leaf
+            {
+                fsize Count;
+                Leaf *Prev;
+                Leaf *Next;
+                Entry Entries[LEAF_SIZE];
+            };
+
+        private:
+            static constexpr fsize MIN_LEAF = LEAF_SIZE / 2;
+            static constexpr fsize MIN_INNER = (INNER_SIZE - 1) / 2;
+            static constexpr fsize MAX_HEIGHT = 64;
+
+            struct Inner
+            {
+                fsize Count;
+                K Keys[INNER_SIZE];
+                void *Children[INNER_SIZE + 1];
+            };
+
+            struct PathItem
+            {
+                Inner *Node;
+                fsize Index;
+            };
+
+        public:
+            using Iterator = BTreeMapIterator<BTreeMap<K, V, Less>, Entry, Leaf>;
+            using CIterator = BTreeMapConstIterator<Entry, Leaf>;
+            using ReverseIterator = BTreeMapIterator<BTreeMap<K, V, Less>, Entry, Leaf, true>;
+            using CReverseIterator = BTreeMapConstIterator<Entry, Leaf, true>;
+
+        private:
+            void *_root;
+            Leaf *_first;
+            Leaf *_last;
+            fsize _height;
+            fsize _count;
+
+            static fsize LowerIndex(const Leaf *leaf, const K &key);
+            static fsize UpperIndex(const Leaf *leaf, const K &key);
+            static fsize ChildIndex(const Inner *node, const K &key);
+            static Entry *InsertAt(Leaf *leaf, fsize pos, const K &key);
+            static void InsertAt(Inner *node, fsize pos, const K &key, void *child);
+            static void RemoveAt(Inner *node, fsize pos);
+            Leaf *FindLeaf(const K &key, PathItem *path) const;
+            Leaf *Bound(const K &key, bool upper, fsize &index) const;
+            Entry *FindEntry(const K &key) const;
+            Entry *InsertEntry(const K &key);
+            void InsertSeparator(PathItem *path, fsize level, const K &key, void *right);
+            void RemoveEntry(const K &key);
+            void FixLeaf(Leaf *leaf, PathItem *path);
+            void FixInner(Inner *node, PathItem *path, fsize level);
+            void DeleteTree(void *node, fsize height);
+            template <typename It>
+            void Load(It entries, fsize count);
+
+        public:
+            /**
+             * Constructs an empty BTreeMap
+             */
+            BTreeMap();
+
+            /**
+             * Copy constructor
+             */
+            BTreeMap(const BTreeMap &other);
+
+            /**
+             * Move constructor
+             */
+            BTreeMap(BTreeMap &&other) noexcept;
+
+            /**
+             * Constructs a BTreeMap from an existing initializer list, sorted lists are bulk loaded
+             * @param entries the initial list of key-value pairs to add to this new BTreeMap
+             */
+            BTreeMap(const std::initializer_list<Entry> &entries);
+
+            ~BTreeMap();
+
+            /**
+             * Replaces the content of this map by an array of entries in O(n) when the array is sorted
+             * by strictly increasing keys, falls back to inserting one entry at a time otherwise
+             * @param entries pointer to the first entry
+             * @param count number of entries
+             */
+            void BulkLoad(const Entry *entries, fsize count);
+
+            /**
+             * Adds a new element in this map, replaces if key already exists
+             * @param key the key of the element
+             * @param value the value to insert
+             */
+            void Add(const K &key, const V &value);
+
+            /**
+             * Adds a new element in this map, replaces if key already exists
+             * @param key the key of the element
+             * @param value the value to insert
+             */
+            void Add(const K &key, V &&value);
+
+            /**
+             * Removes an element from the map
+             * @param key the key of the element to remove
+             */
+            void RemoveAt(const K &key);
+
+            /**
+             * Removes an element from the map
+             * @param pos iterator of the element to remove, updated to the next element
+             */
+            void RemoveAt(Iterator &pos);
+
+            /**
+             * Removes an element from the map
+             * @param pos iterator of the element to remove
+             */
+            void RemoveAt(Iterator &&pos);
+
+            /**
+             * Clears the content of this BTreeMap
+             */
+            void Clear();
+
+            /**
+             * Removes an element by value
+             * @param value the value to search for
+             * @param all wether to remove all occurances or just the first one
+             * @tparam Comparator the comparision operator to use for comparing values
+             */
+            template <template <typename> class Comparator = ops::Equal>
+            void Remove(const V &value, bool all = true);
+
+            /**
+             * Compare BTreeMap by performing a per-element check
+             * @param other BTreeMap to compare with
+             * @return true if the two maps are equal, false otherwise
+             */
+            bool operator==(const BTreeMap<K, V, Less> &other) const noexcept;
+
+            /**
+             * Compare BTreeMap by performing a per-element check
+             * @param other BTreeMap to compare with
+             * @return false if the two maps are equal, true otherwise
+             */
+            inline bool operator!=(const BTreeMap<K, V, Less> &other) const noexcept
+            {
+                return (!operator==(other));
+            }
+
+            /**
+             * Locate an item by key inside this map
+             * @param key the key of the item to search for
+             * @return iterator to the found item or end() if none
+             */
+            Iterator FindByKey(const K &key);
+
+            /**
+             * Locate an item by performing per-element check
+             * @tparam Comparator comparision operator to use
+             * @param val the value to search for
+             * @return iterator to the found item or end() if none
+             */
+            template <template <typename> class Comparator = ops::Equal>
+            Iterator FindByValue(const V &val);
+
+            /**
+             * Returns the first element whose key is not less than a given key
+             * @param key the key to search for
+             * @return iterator to the found item or end() if none
+             */
+            Iterator LowerBound(const K &key);
+
+            /**
+             * Returns the first element whose key is not less than a given key
+             * @param key the key to search for
+             * @return iterator to the found item or end() if none
+             */
+            CIterator LowerBound(const K &key) const;
+
+            /**
+             * Returns the first element whose key is greater than a given key
+             * @param key the key to search for
+             * @return iterator to the found item or end() if none
+             */
+            Iterator UpperBound(const K &key);
+
+            /**
+             * Returns the first element whose key is greater than a given key
+             * @param key the key to search for
+             * @return iterator to the found item or end() if none
+             */
+            CIterator UpperBound(const K &key) const;
+
+            /**
+             * Returns the elements whose keys are in [low, high)
+             * @param low the inclusive lower key
+             * @param high the exclusive upper key
+             * @return iterable range
+             */
+            inline BTreeMapRange<Iterator> Range(const K &low, const K &high)
+            {
+                return (BTreeMapRange<Iterator>(LowerBound(low), Less<K>::Eval(low, high) ? LowerBound(high) : LowerBound(low)));
+            }
+
+            /**
+             * Returns the elements whose keys are in [low, high)
+             * @param low the inclusive lower key
+             * @param high the exclusive upper key
+             * @return iterable range
+             */
+            inline BTreeMapRange<CIterator> Range(const K &low, const K &high) const
+            {
+                return (BTreeMapRange<CIterator>(LowerBound(low), Less<K>::Eval(low, high) ? LowerBound(high) : LowerBound(low)));
+            }
+
+            /**
+             * Returns an element const mode
+             * @param key the key of the element
+             * @throw IndexException if key is not in this map
+             * @return immutable item
+             */
+            const V &operator[](const K &key) const;
+
+            /**
+             * Returns the element with the minimum key value
+             * @return iterator to the minimum element
+             */
+            inline Iterator FindMin()
+            {
+                return (begin());
+            }
+
+            /**
+             * Returns the element with the maximum key value
+             * @return iterator to the maximum element
+             */
+            inline Iterator FindMax()
+            {
+                return (_last != nullptr ? Iterator(_last, _last->Count - 1, _last) : end());
+            }
+
+            /**
+             * Returns an element non-const mode
+             * @param key the key of the element
+             * @return mutable item, default constructed if the key was not in this map
+             */
+            V &operator[](const K &key);
+
+            /**
+             * Copy assignment operator
+             */
+            BTreeMap &operator=(const BTreeMap &other);
+
+            /**
+             * Move assignment operator
+             */
+            BTreeMap &operator=(BTreeMap &&other) noexcept;
+
+            /**
+             * Create a new BTreeMap from concatenation of two maps
+             * @param other map to concatenate with
+             * @return new BTreeMap
+             */
+            BTreeMap operator+(const BTreeMap &other) const;
+
+            /**
+             * Appends the content of a BTreeMap at the end of this map
+             * @param other map to append
+             */
+            void operator+=(const BTreeMap &other);
+
+            /**
+             * Check if a particular key exists
+             * @param key the key to check
+             * @return true if the specified key exists, false otherwise
+             */
+            inline bool HasKey(const K &key) const
+            {
+                return (FindEntry(key) != nullptr);
+            }
+
+            /**
+             * Returns the number of items in this map
+             * @return number of items as unsigned
+             */
+            inline fsize Size() const
+            {
+                return (_count);
+            }
+
+            /**
+             * Returns the number of levels of this tree, 0 when empty
+             * @return height as unsigned
+             */
+            inline fsize Height() const
+            {
+                return (_root == nullptr ? 0 : _height + 1);
+            }
+
+            /**
+             * Returns an iterator to the begining of the collection
+             * @return new iterator
+             */
+            inline CIterator begin() const
+            {
+                return (CIterator(_first, 0, _last));
+            }
+
+            /**
+             * Returns an iterator to the end of the collection
+             * @return new iterator
+             */
+            inline CIterator end() const
+            {
+                return (CIterator(nullptr, 0, _last));
+            }
+
+            /**
+             * Returns an iterator to the begining of the collection
+             * @return new iterator
+             */
+            inline Iterator begin()
+            {
+                return (Iterator(_first, 0, _last));
+            }
+
+            /**
+             * Returns an iterator to the end of the collection
+             * @return new iterator
+             */
+            inline Iterator end()
+            {
+                return (Iterator(nullptr, 0, _last));
+            }
+
+            /**
+             * Returns a reverse iterator to the begining of the collection
+             * @return new iterator
+             */
+            inline CReverseIterator rbegin() const
+            {
+                return (CReverseIterator(_last, _last != nullptr ? _last->Count - 1 : 0, _first));
+            }
+
+            /**
+             * Returns a reverse iterator to the end of the collection
+             * @return new iterator
+             */
+            inline CReverseIterator rend() const
+            {
+                return (CReverseIterator(nullptr, 0, _first));
+            }
+
+            /**
+             * Returns a reverse iterator to the begining of the collection
+             * @return new iterator
+             */
+            inline ReverseIterator rbegin()
+            {
+                return (ReverseIterator(_last, _last != nullptr ? _last->Count - 1 : 0, _first));
+            }
+
+            /**
+             * Returns a reverse iterator to the end of the collection
+             * @return new iterator
+             */
+            inline ReverseIterator rend()
+            {
+                return (ReverseIterator(nullptr, 0, _first));
+            }
+        };
+    }
+}
+
+#include "Framework/Collection/BTreeMap.impl.hpp"
@@ -0,0 +1,760 @@
+// Copyright (c) 2020, BlockProject 3D
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without modification,
+// are permitted provided that the following conditions are met:
+// 
+//     * Redistributions of source code must retain the above copyright notice,
+//       this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above copyright notice,
+//       this list of conditions and the following disclaimer in the documentation
+//       and/or other materials provided with the distribution.
+//     * Neither the name of BlockProject 3D nor the names of its contributors
+//       may be used to endorse or promote products derived from this software
+//       without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#pragma once
+#include "Framework/Collection/ArrayList.hpp"
+#include "Framework/Memory/MemUtils.hpp"
+#include <utility>
+
+namespace bpf
+{
+    namespace collection
+    {
+        template <typename K, typename V, template <typename T> class Less>
+        constexpr fsize BTreeMap<K, V, Less>::LEAF_SIZE;
+
+        template <typename K, typename V, template <typename T> class Less>
+        constexpr fsize BTreeMap<K, V, Less>::INNER_SIZE;
+
+        template <typename K, typename V, template <typename T> class Less>
+        BTreeMap<K, V, Less>::BTreeMap()
+            : _root(nullptr)
+            , _first(nullptr)
+            , _last(nullptr)
+            , _height(0)
+            , _count(0)
+        {
+        }
+
+        template <typename K, typename V, template <typename T> class Less>
+        BTreeMap<K, V, Less>::BTreeMap(const BTreeMap &other)
+            : _root(nullptr)
+            , _first(nullptr)
+            , _last(nullptr)
+            , _height(0)
+            , _count(0)
+        {
+            Load(other.begin(), other._count);
+        }
+
+        template <typename K, typename V, template <typename T> class Less>
+        BTreeMap<K, V, Less>::BTreeMap(BTreeMap &&other) noexcept
+            : _root(other._root)
+            , _first(other._first)
+            , _last(other._last)
+            , _height(other._height)
+            , _count(other._count)
+        {
+            other._root = nullptr;
+            other._first = nullptr;
+            other._last = nullptr;
+            other._height = 0;
+            other._count = 0;
+        }
+
+        template <typename K, typename V, template <typename T> class Less>
+        BTreeMap<K, V, Less>::BTreeMap(const std::initializer_list<Entry> &entries)
+            : _root(nullptr)
+            , _first(nullptr)
+            , _last(nullptr)
+            , _height(0)
+            , _count(0)
+        {
+            BulkLoad(entries.begin(), entries.size());
+        }
+
+        template <typename K, typename V, template <typename T> class Less>
+        BTreeMap<K, V, Less>::~BTreeMap()
+        {
+            Clear();
+        }
+
+        template <typename K, typename V, template <typename T> class Less>
+        void BTreeMap<K, V, Less>::DeleteTree(void *node, const fsize height)
+        {
+            if (height == 0)
+            {
+                memory::MemUtils::Delete(static_cast<Leaf *>(node));
+                return;
+            }
+            Inner *inner = static_cast<Inner *>(node);
+            for (fsize i = 0; i <= inner->Count; ++i)
+                DeleteTree(inner->Children[i], height - 1);
+            memory::MemUtils::Delete(inner);
+        }
+
+        template <typename K, typename V, template <typename T> class Less>
+        void BTreeMap<K, V, Less>::Clear()
+        {
+            if (_root != nullptr)
+                DeleteTree(_root, _height);
+            _root = nullptr;
+            _first = nullptr;
+            _last = nullptr;
+            _height = 0;
+            _count = 0;
+        }
+
+        template <typename K, typename V, template <typename T> class Less>
+        BTreeMap<K, V, Less> &BTreeMap<K, V, Less>::operator=(const BTreeMap &other)
+        {
+            if (this == &other)
+                return (*this);
+            Load(other.begin(), other._count);
+            return (*this);
+        }
+
+        template <typename K, typename V, template <typename T> class Less>
+        BTreeMap<K, V, Less> &BTreeMap<K, V, Less>::operator=(BTreeMap &&other) noexcept
+        {
+            Clear();
+            _root = other._root;
+            _first = other._first;
+            _last = other._last;
+            _height = other._height;
+            _count = other._count;
+            other._root = nullptr;
+            other._first = nullptr;
+            other._last = nullptr;
+            other._height = 0;
+            other._count = 0;
+            return (*this);
+        }
+
+        template <typename K, typename V, template <typename T> class Less>
+        fsize BTreeMap<K, V, Less>::LowerIndex(const Leaf *leaf, const K &key)
+        {
+            const Entry *base = leaf->Entries;
+            fsize n = leaf->Count;
+
+            if (n == 0)
+                return (0);
+            // Branchless binary search: the select compiles to a conditional move on scalar keys
+            while (n > 1)
+            {
+                fsize half = n / 2;
+                base = Less<K>::Eval(base[half - 1].Key, key) ? base + half : base;
+                n -= half;
+            }
+            return (static_cast<fsize>(base - leaf->Entries) + (Less<K>::Eval(base->Key, key) ? 1 : 0));
+        }
+
+        template <typename K, typename V, template <typename T> class Less>
+        fsize BTreeMap<K, V, Less>::UpperIndex(const Leaf *leaf, const K &key)
+        {
+            const Entry *base = leaf->Entries;
+            fsize n = leaf->Count;
+
+            if (n == 0)
+                return (0);
+            while (n > 1)
+            {
+                fsize half = n / 2;
+                base = Less<K>::Eval(key, base[half - 1].Key) ? base : base + half;
+                n -= half;
+            }
+            return (static_cast<fsize>(base - leaf->Entries) + (Less<K>::Eval(key, base->Key) ? 0 : 1));
+        }
+
+        template <typename K, typename V, template <typename T> class Less>
+        fsize BTreeMap<K, V, Less>::ChildIndex(const Inner *node, const K &key)
+        {
+            const K *base = node->Keys;
+            fsize n = node->Count;
+
+            // Keys[i] is the smallest key of Children[i + 1], the child index is the upper bound of the key
+            while (n > 1)
+            {
+                fsize half = n / 2;
+                base = Less<K>::Eval(key, base[half - 1]) ? base : base + half;
+                n -= half;
+            }
+            return (static_cast<fsize>(base - node->Keys) + (Less<K>::Eval(key, *base) ? 0 : 1));
+        }
+
+        template <typename K, typename V, template <typename T> class Less>
+        typename BTreeMap<K, V, Less>::Leaf *BTreeMap<K, V, Less>::FindLeaf(const K &key, PathItem *path) const
+        {
+            void *node = _root;
+
+            if (node == nullptr)
+                return (nullptr);
+            for (fsize level = _height; level > 0; --level)
+            {
+                Inner *inner = static_cast<Inner *>(node);
+                fsize index = ChildIndex(inner, key);
+                if (path != nullptr)
+                    path[level] = PathItem{inner, index};
+                node = inner->Children[index];
+            }
+            return (static_cast<Leaf *>(node));
+        }
+
+        template <typename K, typename V, template <typename T> class Less>
+        typename BTreeMap<K, V, Less>::Leaf *BTreeMap<K, V, Less>::Bound(const K &key, const bool upper, fsize &index) const
+        {
+            Leaf *leaf = FindLeaf(key, nullptr);
+
+            index = 0;
+            if (leaf == nullptr)
+                return (nullptr);
+            fsize pos = upper ? UpperIndex(leaf, key) : LowerIndex(leaf, key);
+            if (pos == leaf->Count)
+                return (leaf->Next);
+            index = pos;
+            return (leaf);
+        }
+
+        template <typename K, typename V, template <typename T> class Less>
+        typename BTreeMap<K, V, Less>::Entry *BTreeMap<K, V, Less>::FindEntry(const K &key) const
+        {
+            Leaf *leaf = FindLeaf(key, nullptr);
+
+            if (leaf == nullptr)
+                return (nullptr);
+            fsize pos = LowerIndex(leaf, key);
+            if (pos == leaf->Count || Less<K>::Eval(key, leaf->Entries[pos].Key))
+                return (nullptr);
+            return (&leaf->Entries[pos]);
+        }
+
+        template <typename K, typename V, template <typename T> class Less>
+        typename BTreeMap<K, V, Less>::Entry *BTreeMap<K, V, Less>::InsertAt(Leaf *leaf, const fsize pos, const K &key)
+        {
+            for (fsize i = leaf->Count; i > pos; --i)
+                leaf->Entries[i] = std::move(leaf->Entries[i - 1]);
+            leaf->Entries[pos].Key = key;
+            leaf->Entries[pos].Value = V();
+            ++leaf->Count;
+            return (&leaf->Entries[pos]);
+        }
+
+        template <typename K, typename V, template <typename T> class Less>
+        void BTreeMap<K, V, Less>::InsertAt(Inner *node, const fsize pos, const K &key, void *child)
+        {
+            for (fsize i = node->Count; i > pos; --i)
+            {
+                node->Keys[i] = std::move(node->Keys[i - 1]);
+                node->Children[i + 1] = node->Children[i];
+            }
+            node->Keys[pos] = key;
+            node->Children[pos + 1] = child;
+            ++node->Count;
+        }
+
+        template <typename K, typename V, template <typename T> class Less>
+        void BTreeMap<K, V, Less>::RemoveAt(Inner *node, const fsize pos)
+        {
+            for (fsize i = pos; i + 1 < node->Count; ++i)
+            {
+                node->Keys[i] = std::move(node->Keys[i + 1]);
+                node->Children[i + 1] = node->Children[i + 2];
+            }
+            --node->Count;
+        }
+
+        template <typename K, typename V, template <typename T> class Less>
+        typename BTreeMap<K, V, Less>::Entry *BTreeMap<K, V, Less>::InsertEntry(const K &key)
+        {
+            PathItem path[MAX_HEIGHT + 1];
+
+            if (_root == nullptr)
+            {
+                Leaf *leaf = memory::MemUtils::New<Leaf>();
+                leaf->Count = 0;
+                leaf->Prev = nullptr;
+                leaf->Next = nullptr;
+                _root = leaf;
+                _first = leaf;
+                _last = leaf;
+                _height = 0;
+            }
+            Leaf *leaf = FindLeaf(key, path);
+            fsize pos = LowerIndex(leaf, key);
+            if (pos < leaf->Count && !Less<K>::Eval(key, leaf->Entries[pos].Key))
+                return (&leaf->Entries[pos]);
+            ++_count;
+            if (leaf->Count < LEAF_SIZE)
+                return (InsertAt(leaf, pos, key));
+            Leaf *right = memory::MemUtils::New<Leaf>();
+            fsize mid = LEAF_SIZE / 2;
+            for (fsize i = mid; i != LEAF_SIZE; ++i)
+            {
+                right->Entries[i - mid] = std::move(leaf->Entries[i]);
+                leaf->Entries[i] = Entry();
+            }
+            right->Count = LEAF_SIZE - mid;
+            leaf->Count = mid;
+            right->Prev = leaf;
+            right->Next = leaf->Next;
+            if (leaf->Next != nullptr)
+                leaf->Next->Prev = right;
+            else
+                _last = right;
+            leaf->Next = right;
+            Entry *entry = pos <= mid ? InsertAt(leaf, pos, key) : InsertAt(right, pos - mid, key);
+            InsertSeparator(path, 1, right->Entries[0].Key, right);
+            return (entry);
+        }
+
+        template <typename K, typename V, template <typename T> class Less>
+        void BTreeMap<K, V, Less>::InsertSeparator(PathItem *path, const fsize level, const K &key, void *right)
+        {
+            if (level > _height)
+            {
+                Inner *root = memory::MemUtils::New<Inner>();
+                root->Count = 1;
+                root->Keys[0] = key;
+                root->Children[0] = _root;
+                root->Children[1] = right;
+                _root = root;
+                ++_height;
+                return;
+            }
+            Inner *node = path[level].Node;
+            fsize pos = path[level].Index;
+            if (node->Count < INNER_SIZE)
+            {
+                InsertAt(node, pos, key, right);
+                return;
+            }
+            Inner *sibling = memory::MemUtils::New<Inner>();
+            fsize mid = INNER_SIZE / 2;
+            K up = std::move(node->Keys[mid]);
+            sibling->Count = INNER_SIZE - mid - 1;
+            for (fsize i = 0; i != sibling->Count; ++i)
+                sibling->Keys[i] = std::move(node->Keys[mid + 1 + i]);
+            for (fsize i = 0; i <= sibling->Count; ++i)
+                sibling->Children[i] = node->Children[mid + 1 + i];
+            node->Count = mid;
+            if (pos <= mid)
+                InsertAt(node, pos, key, right);
+            else
+                InsertAt(sibling, pos - mid - 1, key, right);
+            InsertSeparator(path, level + 1, up, sibling);
+        }
+
+        template <typename K, typename V, template <typename T> class Less>
+        void BTreeMap<K, V, Less>::RemoveEntry(const K &key)
+        {
+            PathItem path[MAX_HEIGHT + 1];
+            Leaf *leaf = FindLeaf(key, path);
+
+            if (leaf == nullptr)
+                return;
+            fsize pos = LowerIndex(leaf, key);
+            if (pos == leaf->Count || Less<K>::Eval(key, leaf->Entries[pos].Key))
+                return;
+            for (fsize i = pos; i + 1 < leaf->Count; ++i)
+                leaf->Entries[i] = std::move(leaf->Entries[i + 1]);
+            --leaf->Count;
+            leaf->Entries[leaf->Count] = Entry();
+            --_count;
+            FixLeaf(leaf, path);
+        }
+
+        template <typename K, typename V, template <typename T> class Less>
+        void BTreeMap<K, V, Less>::FixLeaf(Leaf *leaf, PathItem *path)
+        {
+            if (_height == 0)
+            {
+                if (leaf->Count == 0)
+                {
+                    memory::MemUtils::Delete(leaf);
+                    _root = nullptr;
+                    _first = nullptr;
+                    _last = nullptr;
+                }
+                return;
+            }
+            if (leaf->Count >= MIN_LEAF)
+                return;
+            Inner *parent = path[1].Node;
+            fsize index = path[1].Index;
+            if (index > 0)
+            {
+                Leaf *left = static_cast<Leaf *>(parent->Children[index - 1]);
+                if (left->Count > MIN_LEAF)
+                {
+                    for (fsize i = leaf->Count; i > 0; --i)
+                        leaf->Entries[i] = std::move(leaf->Entries[i - 1]);
+                    --left->Count;
+                    leaf->Entries[0] = std::move(left->Entries[left->Count]);
+                    left->Entries[left->Count] = Entry();
+                    ++leaf->Count;
+                    parent->Keys[index - 1] = leaf->Entries[0].Key;
+                    return;
+                }
+            }
+            if (index < parent->Count)
+            {
+                Leaf *right = static_cast<Leaf *>(parent->Children[index + 1]);
+                if (right->Count > MIN_LEAF)
+                {
+                    leaf->Entries[leaf->Count++] = std::move(right->Entries[0]);
+                    for (fsize i = 0; i + 1 < right->Count; ++i)
+                        right->Entries[i] = std::move(right->Entries[i + 1]);
+                    --right->Count;
+                    right->Entries[right->Count] = Entry();
+                    parent->Keys[index] = right->Entries[0].Key;
+                    return;
+                }
+            }
+            fsize sep = index > 0 ? index - 1 : index;
+            Leaf *left = static_cast<Leaf *>(parent->Children[sep]);
+            Leaf *right = static_cast<Leaf *>(parent->Children[sep + 1]);
+            for (fsize i = 0; i != right->Count; ++i)
+                left->Entries[left->Count + i] = std::move(right->Entries[i]);
+            left->Count += right->Count;
+            left->Next = right->Next;
+            if (right->Next != nullptr)
+                right->Next->Prev = left;
+            else
+                _last = left;
+            memory::MemUtils::Delete(right);
+            RemoveAt(parent, sep);
+            FixInner(parent, path, 1);
+        }
+
+        template <typename K, typename V, template <typename T> class Less>
+        void BTreeMap<K, V, Less>::FixInner(Inner *node, PathItem *path, const fsize level)
+        {
+            if (level == _height)
+            {
+                if (node->Count == 0)
+                {
+                    _root = node->Children[0];
+                    --_height;
+                    memory::MemUtils::Delete(node);
+                }
+                return;
+            }
+            if (node->Count >= MIN_INNER)
+                return;
+            Inner *parent = path[level + 1].Node;
+            fsize index = path[level + 1].Index;
+            if (index > 0)
+            {
+                Inner *left = static_cast<Inner *>(parent->Children[index - 1]);
+                if (left->Count > MIN_INNER)
+                {
+                    node->Children[node->Count + 1] = node->Children[node->Count];
+                    for (fsize i = node->Count; i > 0; --i)
+                    {
+                        node->Keys[i] = std::move(node->Keys[i - 1]);
+                        node->Children[i] = node->Children[i - 1];
+                    }
+                    node->Keys[0] = std::move(parent->Keys[index - 1]);
+                    node->Children[0] = left->Children[left->Count];
+                    ++node->Count;
+                    --left->Count;
+                    parent->Keys[index - 1] = std::move(left->Keys[left->Count]);
+                    return;
+                }
+            }
+            if (index < parent->Count)
+            {
+                Inner *right = static_cast<Inner *>(parent->Children[index + 1]);
+                if (right->Count > MIN_INNER)
+                {
+                    node->Keys[node->Count] = std::move(parent->Keys[index]);
+                    node->Children[node->Count + 1] = right->Children[0];
+                    ++node->Count;
+                    parent->Keys[index] = std::move(right->Keys[0]);
+                    for (fsize i = 0; i + 1 < right->Count; ++i)
+                        right->Keys[i] = std::move(right->Keys[i + 1]);
+                    for (fsize i = 0; i != right->Count; ++i)
+                        right->Children[i] = right->Children[i + 1];
+                    --right->Count;
+                    return;
+                }
+            }
+            fsize sep = index > 0 ? index - 1 : index;
+            Inner *left = static_cast<Inner *>(parent->Children[sep]);
+            Inner *right = static_cast<Inner *>(parent->Children[sep + 1]);
+            left->Keys[left->Count] = std::move(parent->Keys[sep]);
+            for (fsize i = 0; i != right->Count; ++i)
+                left->Keys[left->Count + 1 + i] = std::move(right->Keys[i]);
+            for (fsize i = 0; i <= right->Count; ++i)
+                left->Children[left->Count + 1 + i] = right->Children[i];
+            left->Count += right->Count + 1;
+            memory::MemUtils::Delete(right);
+            RemoveAt(parent, sep);
+            FixInner(parent, path, level + 1);
+        }
+
+        template <typename K, typename V, template <typename T> class Less>
+        template <typename It>
+        void BTreeMap<K, V, Less>::Load(It entries, const fsize count)
+        {
+            Clear();
+            if (count == 0)
+                return;
+            // Nodes are filled evenly so that every node but the root respects the minimum occupancy
+            fsize leaves = (count + LEAF_SIZE - 1) / LEAF_SIZE;
+            ArrayList<void *> level(leaves);
+            ArrayList<const K *> mins(leaves);
+            Leaf *prev = nullptr;
+            for (fsize l = 0; l != leaves; ++l)
+            {
+                Leaf *leaf = memory::MemUtils::New<Leaf>();
+                leaf->Count = count / leaves + (l < count % leaves ? 1 : 0);
+                leaf->Prev = prev;
+                leaf->Next = nullptr;
+                for (fsize i = 0; i != leaf->Count; ++i, ++entries)
+                    leaf->Entries[i] = *entries;
+                if (prev != nullptr)
+                    prev->Next = leaf;
+                else
+                    _first = leaf;
+                level.Add(leaf);
+                mins.Add(&leaf->Entries[0].Key);
+                prev = leaf;
+            }
+            _last = prev;
+            _count = count;
+            while (level.Size() > 1)
+            {
+                fsize size = level.Size();
+                fsize groups = (size + INNER_SIZE) / (INNER_SIZE + 1);
+                ArrayList<void *> up(groups);
+                ArrayList<const K *> upMins(groups);
+                fsize child = 0;
+                for (fsize g = 0; g != groups; ++g)
+                {
+                    Inner *node = memory::MemUtils::New<Inner>();
+                    fsize n = size / groups + (g < size % groups ? 1 : 0);
+                    node->Count = n - 1;
+                    node->Children[0] = level[child];
+                    for (fsize i = 1; i != n; ++i)
+                    {
+                        node->Keys[i - 1] = *mins[child + i];
+                        node->Children[i] = level[child + i];
+                    }
+                    up.Add(node);
+                    upMins.Add(mins[child]);
+                    child += n;
+                }
+                level = std::move(up);
+                mins = std::move(upMins);
+                ++_height;
+            }
+            _root = level[0];
+        }
+
+        template <typename K, typename V, template <typename T> class Less>
+        void BTreeMap<K, V, Less>::BulkLoad(const Entry *entries, const fsize count)
+        {
+            for (fsize i = 1; i < count; ++i)
+            {
+                if (!Less<K>::Eval(entries[i - 1].Key, entries[i].Key))
+                {
+                    Clear();
+                    for (fsize j = 0; j != count; ++j)
+                        Add(entries[j].Key, entries[j].Value);
+                    return;
+                }
+            }
+            Load(entries, count);
+        }
+
+        template <typename K, typename V, template <typename T> class Less>
+        void BTreeMap<K, V, Less>::Add(const K &key, const V &value)
+        {
+            InsertEntry(key)->Value = value;
+        }
+
+        template <typename K, typename V, template <typename T> class Less>
+        void BTreeMap<K, V, Less>::Add(const K &key, V &&value)
+        {
+            InsertEntry(key)->Value = std::move(value);
+        }
+
+        template <typename K, typename V, template <typename T> class Less>
+        void BTreeMap<K, V, Less>::RemoveAt(const K &key)
+        {
+            RemoveEntry(key);
+        }
+
+        template <typename K, typename V, template <typename T> class Less>
+        void BTreeMap<K, V, Less>::RemoveAt(Iterator &pos)
+        {
+            if (pos._cursor._node == nullptr)
+                return;
+            Iterator next = pos;
+            ++next;
+            K key = pos->Key;
+            if (next._cursor._node == nullptr)
+            {
+                RemoveEntry(key);
+                pos = end();
+                return;
+            }
+            // Removal may rebalance leaves, the next element is located again by key
+            K nextKey = next->Key;
+            RemoveEntry(key);
+            pos = FindByKey(nextKey);
+        }
+
+        template <typename K, typename V, template <typename T> class Less>
+        void BTreeMap<K, V, Less>::RemoveAt(Iterator &&pos)
+        {
+            if (pos._cursor._node == nullptr)
+                return;
+            K key = pos->Key;
+            RemoveEntry(key);
+        }
+
+        template <typename K, typename V, template <typename T> class Less>
+        template <template <typename> class Comparator>
+        void BTreeMap<K, V, Less>::Remove(const V &value, const bool all)
+        {
+            ArrayList<K> keys;
+
+            for (auto &entry : *this)
+            {
+                if (Comparator<V>::Eval(entry.Value, value))
+                {
+                    keys.Add(entry.Key);
+                    if (!all)
+                        break;
+                }
+            }
+            for (auto &key : keys)
+                RemoveEntry(key);
+        }
+
+        template <typename K, typename V, template <typename T> class Less>
+        const V &BTreeMap<K, V, Less>::operator[](const K &key) const
+        {
+            Entry *entry = FindEntry(key);
+
+            if (entry == nullptr)
+                throw bpf::IndexException(0);
+            return (entry->Value);
+        }
+
+        template <typename K, typename V, template <typename T> class Less>
+        V &BTreeMap<K, V, Less>::operator[](const K &key)
+        {
+            return (InsertEntry(key)->Value);
+        }
+
+        template <typename K, typename V, template <typename T> class Less>
+        typename BTreeMap<K, V, Less>::Iterator BTreeMap<K, V, Less>::FindByKey(const K &key)
+        {
+            Iterator it = LowerBound(key);
+
+            if (it != end() && !Less<K>::Eval(key, it->Key))
+                return (it);
+            return (end());
+        }
+
+        template <typename K, typename V, template <typename T> class Less>
+        template <template <typename> class Comparator>
+        typename BTreeMap<K, V, Less>::Iterator BTreeMap<K, V, Less>::FindByValue(const V &val)
+        {
+            for (auto it = begin(); it != end(); ++it)
+            {
+                if (Comparator<V>::Eval(it->Value, val))
+                    return (it);
+            }
+            return (end());
+        }
+
+        template <typename K, typename V, template <typename T> class Less>
+        typename BTreeMap<K, V, Less>::Iterator BTreeMap<K, V, Less>::LowerBound(const K &key)
+        {
+            fsize index;
+            Leaf *leaf = Bound(key, false, index);
+
+            return (Iterator(leaf, index, _last));
+        }
+
+        template <typename K, typename V, template <typename T> class Less>
+        typename BTreeMap<K, V, Less>::CIterator BTreeMap<K, V, Less>::LowerBound(const K &key) const
+        {
+            fsize index;
+            Leaf *leaf = Bound(key, false, index);
+
+            return (CIterator(leaf, index, _last));
+        }
+
+        template <typename K, typename V, template <typename T> class Less>
+        typename BTreeMap<K, V, Less>::Iterator BTreeMap<K, V, Less>::UpperBound(const K &key)
+        {
+            fsize index;
+            Leaf *leaf = Bound(key, true, index);
+
+            return (Iterator(leaf, index, _last));
+        }
+
+        template <typename K, typename V, template <typename T> class Less>
+        typename BTreeMap<K, V, Less>::CIterator BTreeMap<K, V, Less>::UpperBound(const K &key) const
+        {
+            fsize index;
+            Leaf *leaf = Bound(key, true, index);
+
+            return (CIterator(leaf, index, _last));
+        }
+
+        template <typename K, typename V, template <typename T> class Less>
+        BTreeMap<K, V, Less> BTreeMap<K, V, Less>::operator+(const BTreeMap &other) const
+        {
+            BTreeMap res = *this;
+
+            res += other;
+            return (res);
+        }
+
+        template <typename K, typename V, template <typename T> class Less>
+        void BTreeMap<K, V, Less>::operator+=(const BTreeMap &other)
+        {
+            for (auto &entry : other)
+                Add(entry.Key, entry.Value);
+        }
+
+        template <typename K, typename V, template <typename T> class Less>
+        bool BTreeMap<K, V, Less>::operator==(const BTreeMap<K, V, Less> &other) const noexcept
+        {
+            if (_count != other._count)
+                return (false);
+            auto it = begin();
+            auto it1 = other.begin();
+
+            while (it != end())
+            {
+                if (Less<K>::Eval(it->Key, it1->Key) || Less<K>::Eval(it1->Key, it->Key) || it->Value != it1->Value)
+                    return (false);
+                ++it;
+                ++it1;
+            }
+            return (true);
+        }
+    }
+}
@@ -34,7 +34,7 @@ namespace bpf
 {
     namespace collection
     {
-        template <typename T>
+        template <typename T, template <typename> class Allocator>
         class BP_TPL_API List;
 
         template <typename T, typename NodeType, template <typename, typename> class IType,
@@ -104,7 +104,8 @@ namespace bpf
                 return (*this);
             }
 
-            friend class List<T>;
+            template <typename, template <typename> class>
+            friend class List;
         };
 
         template <typename T, typename NodeType>
@@ -184,7 +185,8 @@ namespace bpf
             using Base::operator->;
             using Base::operator*;
 
-            friend class List<T>;
+            template <typename, template <typename> class>
+            friend class List;
         };
 
         template <typename T, typename NodeType>
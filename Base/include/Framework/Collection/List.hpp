@@ -28,8 +28,10 @@
 
 #pragma once
 #include "Framework/Collection/List.Iterator.hpp"
+#include "Framework/Collection/Sorting.hpp"
 #include "Framework/Collection/Utility.hpp"
 #include "Framework/IndexException.hpp"
+#include "Framework/Memory/HeapAllocator.hpp"
 #include "Framework/Types.hpp"
 #include <functional>
 
@@ -40,8 +42,9 @@ namespace bpf
         /**
          * A simple double linked list
          * @tparam T the type of element to store
+         * @tparam Allocator the node allocation policy
          */
-        template <typename T>
+        template <typename T, template <typename> class Allocator = memory::HeapAllocator>
         class BP_TPL_API List
         {
         private:
@@ -76,15 +79,8 @@ namespace bpf
             Node *_first;
             Node *_last;
             fsize _count;
+            Allocator<Node> _alloc;
 
-            template <template <typename> class Comparator>
-            Node *Partition(Node *start, Node *end);
-            template <template <typename> class Comparator>
-            void QuickSort(Node *start, Node *end);
-            template <template <typename> class Comparator>
-            void Merge(Node **startl, Node **endl, Node **startr, Node **endr);
-            template <template <typename> class Comparator>
-            void MergeSort();
             void RemoveNode(Node *toRM);
             void Swap(Node *a, Node *b);
             Node *GetNode(fsize id) const;
@@ -93,35 +89,35 @@ namespace bpf
             /**
              * Constructs an empty List
              */
-            List<T>();
+            List<T, Allocator>();
 
             /**
              * Constructs a List from an existing initializer list
              * @param lst the initial list of items to add to this new List
              */
-            List<T>(const std::initializer_list<T> &lst);
+            List<T, Allocator>(const std::initializer_list<T> &lst);
 
             /**
              * Copy constructor
              */
-            List<T>(const List<T> &other);
+            List<T, Allocator>(const List<T, Allocator> &other);
 
             /**
              * Move constructor
              */
-            List<T>(List<T> &&other) noexcept;
+            List<T, Allocator>(List<T, Allocator> &&other) noexcept;
 
-            ~List<T>();
+            ~List<T, Allocator>();
 
             /**
              * Move assignment operator
              */
-            List<T> &operator=(List<T> &&other) noexcept;
+            List<T, Allocator> &operator=(List<T, Allocator> &&other) noexcept;
 
             /**
              * Copy assignment operator
              */
-            List<T> &operator=(const List<T> &other);
+            List<T, Allocator> &operator=(const List<T, Allocator> &other);
 
             /**
              * Adds an item at the end of this list
@@ -184,27 +180,27 @@ namespace bpf
              * @param other list to concatenate with
              * @return new list
              */
-            List<T> operator+(const List<T> &other) const;
+            List<T, Allocator> operator+(const List<T, Allocator> &other) const;
 
             /**
              * Appends the content of a list at the end of this list
              * @param other list to append
              */
-            void operator+=(const List<T> &other);
+            void operator+=(const List<T, Allocator> &other);
 
             /**
              * Compare List by performing a per-element check
              * @param other List to compare with
              * @return true if the two lists are equal, false otherwise
              */
-            bool operator==(const List<T> &other) const noexcept;
+            bool operator==(const List<T, Allocator> &other) const noexcept;
 
             /**
              * Compare List by performing a per-element check
              * @param other ArrayList to compare with
              * @return false if the two lists are equal, true otherwise
              */
-            inline bool operator!=(const List<T> &other) const noexcept
+            inline bool operator!=(const List<T, Allocator> &other) const noexcept
             {
                 return (!operator==(other));
             }
@@ -272,9 +268,10 @@ namespace bpf
             void RemoveLast();
 
             /**
-             * Sorts this collection in place
-             * @param stable if true this function will apply a Merge-Sort algorithm, otherwise this function uses the
-             * Quick-Sort algorithm
+             * Sorts this collection in place. Elements are moved to a contiguous buffer, sorted and moved back
+             * into the existing nodes
+             * @param stable if true this function will apply an adaptive Merge-Sort algorithm, otherwise this
+             * function uses a pattern-defeating Quick-Sort algorithm
              * @tparam Comparator comparision operator
              */
             template <template <typename> class Comparator = ops::Less>
@@ -28,32 +28,34 @@
 
 #pragma once
 #include "Framework/Memory/MemUtils.hpp"
+#include <type_traits>
 
 namespace bpf
 {
     namespace collection
     {
-        template <typename T>
-        inline List<T>::List()
+        template <typename T, template <typename> class Allocator>
+        inline List<T, Allocator>::List()
             : _first(nullptr)
             , _last(nullptr)
             , _count(0)
         {
         }
 
-        template <typename T>
-        inline List<T>::List(List<T> &&other) noexcept
+        template <typename T, template <typename> class Allocator>
+        inline List<T, Allocator>::List(List<T, Allocator> &&other) noexcept
             : _first(other._first)
             , _last(other._last)
             , _count(other._count)
+            , _alloc(std::move(other._alloc))
         {
             other._first = nullptr;
             other._last = nullptr;
             other._count = 0;
         }
 
-        template <typename T>
-        List<T>::List(const List<T> &other)
+        template <typename T, template <typename> class Allocator>
+        List<T, Allocator>::List(const List<T, Allocator> &other)
             : _first(nullptr)
             , _last(nullptr)
             , _count(0)
@@ -62,8 +64,8 @@ namespace bpf
                 Add(elem);
         }
 
-        template <typename T>
-        List<T>::List(const std::initializer_list<T> &lst)
+        template <typename T, template <typename> class Allocator>
+        List<T, Allocator>::List(const std::initializer_list<T> &lst)
             : _first(nullptr)
             , _last(nullptr)
             , _count(0)
@@ -72,27 +74,28 @@ namespace bpf
                 Add(elem);
         }
 
-        template <typename T>
-        inline List<T>::~List()
+        template <typename T, template <typename> class Allocator>
+        inline List<T, Allocator>::~List()
         {
             Clear();
         }
 
-        template <typename T>
-        List<T> &List<T>::operator=(List<T> &&other) noexcept
+        template <typename T, template <typename> class Allocator>
+        List<T, Allocator> &List<T, Allocator>::operator=(List<T, Allocator> &&other) noexcept
         {
             Clear();
             _first = other._first;
             _last = other._last;
             _count = other._count;
+            _alloc = std::move(other._alloc);
             other._first = nullptr;
             other._last = nullptr;
             other._count = 0;
             return (*this);
         }
 
-        template <typename T>
-        List<T> &List<T>::operator=(const List<T> &other)
+        template <typename T, template <typename> class Allocator>
+        List<T, Allocator> &List<T, Allocator>::operator=(const List<T, Allocator> &other)
         {
             if (this == &other)
                 return (*this);
@@ -102,28 +105,28 @@ namespace bpf
             return (*this);
         }
 
-        template <typename T>
-        List<T> List<T>::operator+(const List<T> &other) const
+        template <typename T, template <typename> class Allocator>
+        List<T, Allocator> List<T, Allocator>::operator+(const List<T, Allocator> &other) const
         {
-            List<T> cpy = *this;
+            List<T, Allocator> cpy = *this;
 
             for (const auto &elem : other)
                 cpy.Add(elem);
             return (cpy);
         }
 
-        template <typename T>
-        void List<T>::operator+=(const List<T> &other)
+        template <typename T, template <typename> class Allocator>
+        void List<T, Allocator>::operator+=(const List<T, Allocator> &other)
         {
             for (const auto &elem : other)
                 Add(elem);
         }
 
-        template <typename T>
-        void List<T>::Insert(fsize pos, const T &elem)
+        template <typename T, template <typename> class Allocator>
+        void List<T, Allocator>::Insert(fsize pos, const T &elem)
         {
             Node *nd = GetNode(pos);
-            Node *newi = memory::MemUtils::New<Node>(elem);
+            Node *newi = _alloc.New(elem);
 
             newi->Next = nd;
             if (nd != nullptr)
@@ -146,11 +149,11 @@ namespace bpf
             ++_count;
         }
 
-        template <typename T>
-        void List<T>::Insert(fsize pos, T &&elem)
+        template <typename T, template <typename> class Allocator>
+        void List<T, Allocator>::Insert(fsize pos, T &&elem)
         {
             Node *nd = GetNode(pos);
-            Node *newi = memory::MemUtils::New<Node>(std::move(elem));
+            Node *newi = _alloc.New(std::move(elem));
 
             newi->Next = nd;
             if (nd != nullptr)
@@ -173,11 +176,11 @@ namespace bpf
             ++_count;
         }
 
-        template <typename T>
-        void List<T>::Insert(const Iterator &pos, const T &elem)
+        template <typename T, template <typename> class Allocator>
+        void List<T, Allocator>::Insert(const Iterator &pos, const T &elem)
         {
             Node *nd = pos._cur;
-            Node *newi = memory::MemUtils::New<Node>(elem);
+            Node *newi = _alloc.New(elem);
 
             newi->Next = nd;
             if (nd != nullptr)
@@ -200,11 +203,11 @@ namespace bpf
             ++_count;
         }
 
-        template <typename T>
-        void List<T>::Insert(const Iterator &pos, T &&elem)
+        template <typename T, template <typename> class Allocator>
+        void List<T, Allocator>::Insert(const Iterator &pos, T &&elem)
         {
             Node *nd = pos._cur;
-            Node *newi = memory::MemUtils::New<Node>(std::move(elem));
+            Node *newi = _alloc.New(std::move(elem));
 
             newi->Next = nd;
             if (nd != nullptr)
@@ -227,10 +230,10 @@ namespace bpf
             ++_count;
         }
 
-        template <typename T>
-        void List<T>::Add(const T &elem)
+        template <typename T, template <typename> class Allocator>
+        void List<T, Allocator>::Add(const T &elem)
         {
-            Node *newi = memory::MemUtils::New<Node>(elem);
+            Node *newi = _alloc.New(elem);
 
             if (_last == nullptr)
                 _first = newi;
@@ -243,10 +246,10 @@ namespace bpf
             ++_count;
         }
 
-        template <typename T>
-        void List<T>::Add(T &&elem)
+        template <typename T, template <typename> class Allocator>
+        void List<T, Allocator>::Add(T &&elem)
         {
-            Node *newi = memory::MemUtils::New<Node>(std::move(elem));
+            Node *newi = _alloc.New(std::move(elem));
 
             if (_last == nullptr)
                 _first = newi;
@@ -259,15 +262,22 @@ namespace bpf
             ++_count;
         }
 
-        template <typename T>
-        inline void List<T>::Clear()
+        template <typename T, template <typename> class Allocator>
+        inline void List<T, Allocator>::Clear()
         {
+            if (Allocator<Node>::BULK_RELEASE && std::is_trivially_destructible<T>::value)
+            {
+                _first = nullptr;
+                _last = nullptr;
+                _count = 0;
+            }
             while (_count > 0)
                 RemoveLast();
+            _alloc.Release();
         }
 
-        template <typename T>
-        inline void List<T>::Swap(Node *a, Node *b)
+        template <typename T, template <typename> class Allocator>
+        inline void List<T, Allocator>::Swap(Node *a, Node *b)
         {
             T tmpdata = std::move(a->Data);
 
@@ -275,132 +285,28 @@ namespace bpf
             b->Data = std::move(tmpdata);
         }
 
-        template <typename T>
+        template <typename T, template <typename> class Allocator>
         template <template <typename> class Comparator>
-        void List<T>::Merge(Node **startl1, Node **endl1, Node **startr1, Node **endr1)
+        void List<T, Allocator>::Sort(const bool stable)
         {
-            if (Comparator<T>::Eval((*startr1)->Data, (*startl1)->Data))
-            {
-                std::swap(*startl1, *startr1);
-                std::swap(*endl1, *endr1);
-            }
-            Node *startl = *startl1;
-            Node *endl = *endl1;
-            Node *startr = *startr1;
-            Node *endrnext = (*endr1)->Next;
-            while (startl != endl && startr != endrnext)
-            {
-                if (Comparator<T>::Eval(startr->Data, startl->Next->Data))
-                {
-                    Node *tmp = startr->Next;
-                    startr->Next = startl->Next;
-                    startl->Next = startr;
-                    startr = tmp;
-                }
-                startl = startl->Next;
-            }
-            if (startl == endl)
-                startl->Next = startr;
-            else
-                *endr1 = *endl1;
-        }
-
-        template <typename T>
-        template <template <typename> class Comparator>
-        void List<T>::MergeSort()
-        {
-            Node *curNode = nullptr;
-            Node *startl;
-            Node *startr;
-            Node *endl;
-            Node *endr;
-
-            for (fsize sz = 1; sz < _count; sz *= 2)
-            {
-                startl = _first;
-                while (startl != nullptr)
-                {
-                    bool first = false;
-                    if (startl == _first)
-                        first = true;
-                    endl = startl;
-                    for (fsize i = 0; endl->Next != nullptr && i != sz - 1; ++i)
-                        endl = endl->Next;
-                    startr = endl->Next;
-                    if (startr == nullptr)
-                        break;
-                    endr = startr;
-                    for (fsize i = 0; endr->Next != nullptr && i != sz - 1; ++i)
-                        endr = endr->Next;
-                    Node *cpy = endr->Next; // Get a hold on the start for the next partitions before Merge function destroys it...
-                    Merge<Comparator>(&startl, &endl, &startr, &endr);
-                    if (first)
-                        _first = startl;
-                    else
-                        curNode->Next = startl;
-                    curNode = endr;
-                    startl = cpy;
-                }
-                curNode->Next = startl;
-            }
-        }
-
-        template <typename T>
-        template <template <typename> class Comparator>
-        typename List<T>::Node *List<T>::Partition(Node *start, Node *end)
-        {
-            Node *x = end;
-            Node *iter = start;
-            for (Node *j = start; j != end; j = j->Next)
-            {
-                if (Comparator<T>::Eval(j->Data, x->Data))
-                {
-                    Swap(iter, j);
-                    iter = iter->Next;
-                }
-            }
-            Swap(iter, end);
-            return (iter);
-        }
-
-        template <typename T>
-        template <template <typename> class Comparator>
-        void List<T>::QuickSort(Node *start, Node *end)
-        {
-            if (end != nullptr && start != end && start != end->Next)
-            {
-                Node *res = Partition<Comparator>(start, end);
-                QuickSort<Comparator>(start, res->Prev);
-                QuickSort<Comparator>(res->Next, end);
-            }
-        }
-
-        template <typename T>
-        template <template <typename> class Comparator>
-        void List<T>::Sort(const bool stable) //TODO: Adapt to use different sorting functions
-        {
-            if (Size() == 0 || Size() == 1)
+            if (_count < 2)
                 return;
-            if (!stable)
-                QuickSort<Comparator>(_first, _last);
+            T *buf = memory::MemUtils::NewArray<T>(_count);
+            fsize i = 0;
+            for (Node *cur = _first; cur != nullptr; cur = cur->Next)
+                buf[i++] = std::move(cur->Data);
+            if (stable)
+                Sorting::Stable<Comparator>(buf, _count);
             else
-            {
-                MergeSort<Comparator>();
-                /* Re-chain the broken list */
-                Node *cur = _first;
-                Node *last = nullptr;
-                while (cur != nullptr)
-                {
-                    cur->Prev = last;
-                    last = cur;
-                    cur = cur->Next;
-                }
-                _last = last;
-            }
+                Sorting::Unstable<Comparator>(buf, _count);
+            i = 0;
+            for (Node *cur = _first; cur != nullptr; cur = cur->Next)
+                cur->Data = std::move(buf[i++]);
+            memory::MemUtils::DeleteArray(buf, _count);
         }
 
-        template <typename T>
-        void List<T>::Swap(const Iterator &a, const Iterator &b)
+        template <typename T, template <typename> class Allocator>
+        void List<T, Allocator>::Swap(const Iterator &a, const Iterator &b)
         {
             Node *an = a._cur;
             Node *bn = b._cur;
@@ -409,8 +315,8 @@ namespace bpf
             Swap(an, bn);
         }
 
-        template <typename T>
-        void List<T>::RemoveAt(Iterator &pos)
+        template <typename T, template <typename> class Allocator>
+        void List<T, Allocator>::RemoveAt(Iterator &pos)
         {
             if (pos._cur == nullptr)
                 return;
@@ -419,8 +325,8 @@ namespace bpf
             pos._cur = next;
         }
 
-        template <typename T>
-        void List<T>::RemoveAt(Iterator &&pos)
+        template <typename T, template <typename> class Allocator>
+        void List<T, Allocator>::RemoveAt(Iterator &&pos)
         {
             if (pos._cur == nullptr)
                 return;
@@ -429,8 +335,8 @@ namespace bpf
             pos._cur = next;
         }
 
-        template <typename T>
-        typename List<T>::Node *List<T>::GetNode(fsize id) const
+        template <typename T, template <typename> class Allocator>
+        typename List<T, Allocator>::Node *List<T, Allocator>::GetNode(fsize id) const
         {
             if (id < _count)
             {
@@ -452,8 +358,8 @@ namespace bpf
             return nullptr;
         }
 
-        template <typename T>
-        void List<T>::RemoveAt(fsize const pos)
+        template <typename T, template <typename> class Allocator>
+        void List<T, Allocator>::RemoveAt(fsize const pos)
         {
             Node *toRM = GetNode(pos);
 
@@ -461,8 +367,8 @@ namespace bpf
                 RemoveNode(toRM);
         }
 
-        template <typename T>
-        void List<T>::RemoveNode(Node *toRM)
+        template <typename T, template <typename> class Allocator>
+        void List<T, Allocator>::RemoveNode(Node *toRM)
         {
             if (toRM == _last)
                 RemoveLast();
@@ -477,14 +383,14 @@ namespace bpf
                     _first = next;
                 if (next)
                     next->Prev = prev;
-                memory::MemUtils::Delete(toRM);
+                _alloc.Delete(toRM);
                 --_count;
             }
         }
 
-        template <typename T>
+        template <typename T, template <typename> class Allocator>
         template <template <typename> class Comparator>
-        void List<T>::Remove(const T &elem, const bool all)
+        void List<T, Allocator>::Remove(const T &elem, const bool all)
         {
             Node *cur = _first;
 
@@ -501,8 +407,8 @@ namespace bpf
             }
         }
 
-        template <typename T>
-        void List<T>::RemoveLast()
+        template <typename T, template <typename> class Allocator>
+        void List<T, Allocator>::RemoveLast()
         {
             if (_last)
             {
@@ -512,14 +418,14 @@ namespace bpf
                     lst->Next = nullptr;
                 else
                     _first = nullptr;
-                memory::MemUtils::Delete(_last);
+                _alloc.Delete(_last);
                 _last = lst;
                 --_count;
             }
         }
 
-        template <typename T>
-        inline const T &List<T>::operator[](fsize const id) const
+        template <typename T, template <typename> class Allocator>
+        inline const T &List<T, Allocator>::operator[](fsize const id) const
         {
             Node *elem = GetNode(id);
 
@@ -528,8 +434,8 @@ namespace bpf
             return (elem->Data);
         }
 
-        template <typename T>
-        inline T &List<T>::operator[](fsize const id)
+        template <typename T, template <typename> class Allocator>
+        inline T &List<T, Allocator>::operator[](fsize const id)
         {
             Node *elem = GetNode(id);
 
@@ -538,16 +444,16 @@ namespace bpf
             return (elem->Data);
         }
 
-        template <typename T>
-        typename List<T>::Iterator List<T>::FindByKey(const fsize pos)
+        template <typename T, template <typename> class Allocator>
+        typename List<T, Allocator>::Iterator List<T, Allocator>::FindByKey(const fsize pos)
         {
             Node *elem = GetNode(pos);
             return (Iterator(elem, _last));
         }
 
-        template <typename T>
+        template <typename T, template <typename> class Allocator>
         template <template <typename> class Comparator>
-        typename List<T>::Iterator List<T>::FindByValue(const T &val)
+        typename List<T, Allocator>::Iterator List<T, Allocator>::FindByValue(const T &val)
         {
             Node *cur = _first;
 
@@ -561,8 +467,8 @@ namespace bpf
             return (Iterator(nullptr, _last));
         }
 
-        template <typename T>
-        typename List<T>::Iterator List<T>::Find(const std::function<bool(const fsize pos, const T &val)> &comparator)
+        template <typename T, template <typename> class Allocator>
+        typename List<T, Allocator>::Iterator List<T, Allocator>::Find(const std::function<bool(const fsize pos, const T &val)> &comparator)
         {
             Node *cur = _first;
             fsize pos = 0;
@@ -577,8 +483,8 @@ namespace bpf
             return (Iterator(nullptr, _last));
         }
 
-        template <typename T>
-        bool List<T>::operator==(const List<T> &other) const noexcept
+        template <typename T, template <typename> class Allocator>
+        bool List<T, Allocator>::operator==(const List<T, Allocator> &other) const noexcept
         {
             if (_count != other._count)
                 return (false);
@@ -30,6 +30,7 @@
 #include "Framework/Collection/Map.Iterator.hpp"
 #include "Framework/Collection/Utility.hpp"
 #include "Framework/IndexException.hpp"
+#include "Framework/Memory/HeapAllocator.hpp"
 #include "Framework/Types.hpp"
 #include <functional>
 #include <initializer_list>
@@ -44,8 +45,10 @@ namespace bpf
          * @tparam V the value type
          * @tparam Greater the greater than operator
          * @tparam Less the less than operator
+         * @tparam Allocator the node allocation policy
          */
-        template <typename K, typename V, template <typename T> class Greater = ops::Greater, template <typename T> class Less = ops::Less>
+        template <typename K, typename V, template <typename T> class Greater = ops::Greater, template <typename T> class Less = ops::Less,
+                  template <typename T> class Allocator = memory::HeapAllocator>
         class BP_TPL_API Map
         {
         public:
@@ -65,7 +68,7 @@ namespace bpf
             };
 
         public:
-            using Iterator = MapIterator<Map<K, V, Greater, Less>, Entry, Node>;
+            using Iterator = MapIterator<Map<K, V, Greater, Less, Allocator>, Entry, Node>;
             using CIterator = MapConstIterator<Entry, Node>;
             using ReverseIterator = MapReverseIterator<Entry, Node>;
             using CReverseIterator = MapConstReverseIterator<Entry, Node>;
@@ -73,6 +76,7 @@ namespace bpf
         private:
             Node *_root;
             fsize _count;
+            Allocator<Node> _alloc;
             fisize Height(Node *node);
             fisize Balance(Node *node);
             void LeftRotate(Node *node);
@@ -166,14 +170,14 @@ namespace bpf
              * @param other Map to compare with
              * @return true if the two maps are equal, false otherwise
              */
-            bool operator==(const Map<K, V, Greater, Less> &other) const noexcept;
+            bool operator==(const Map<K, V, Greater, Less, Allocator> &other) const noexcept;
 
             /**
              * Compare Map by performing a per-element check
              * @param other Map to compare with
              * @return false if the two maps are equal, true otherwise
              */
-            inline bool operator!=(const Map<K, V, Greater, Less> &other) const noexcept
+            inline bool operator!=(const Map<K, V, Greater, Less, Allocator> &other) const noexcept
             {
                 return (!operator==(other));
             }
@@ -27,21 +27,21 @@
 // SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #pragma once
-#include "Framework/Memory/MemUtils.hpp"
+#include <type_traits>
 
 namespace bpf
 {
     namespace collection
     {
-        template <typename K, typename V, template <typename T> class Greater, template <typename T> class Less>
-        Map<K, V, Greater, Less>::Map()
+        template <typename K, typename V, template <typename T> class Greater, template <typename T> class Less, template <typename T> class Allocator>
+        Map<K, V, Greater, Less, Allocator>::Map()
             : _root(nullptr)
             , _count(0)
         {
         }
 
-        template <typename K, typename V, template <typename T> class Greater, template <typename T> class Less>
-        Map<K, V, Greater, Less>::Map(const Map &other)
+        template <typename K, typename V, template <typename T> class Greater, template <typename T> class Less, template <typename T> class Allocator>
+        Map<K, V, Greater, Less, Allocator>::Map(const Map &other)
             : _root(nullptr)
             , _count(0)
         {
@@ -49,17 +49,18 @@ namespace bpf
                 Add(entry.Key, entry.Value);
         }
 
-        template <typename K, typename V, template <typename T> class Greater, template <typename T> class Less>
-        Map<K, V, Greater, Less>::Map(Map &&other) noexcept
+        template <typename K, typename V, template <typename T> class Greater, template <typename T> class Less, template <typename T> class Allocator>
+        Map<K, V, Greater, Less, Allocator>::Map(Map &&other) noexcept
             : _root(other._root)
             , _count(other._count)
+            , _alloc(std::move(other._alloc))
         {
             other._root = nullptr;
             other._count = 0;
         }
 
-        template <typename K, typename V, template <typename T> class Greater, template <typename T> class Less>
-        Map<K, V, Greater, Less>::Map(const std::initializer_list<Entry> &entries)
+        template <typename K, typename V, template <typename T> class Greater, template <typename T> class Less, template <typename T> class Allocator>
+        Map<K, V, Greater, Less, Allocator>::Map(const std::initializer_list<Entry> &entries)
             : _root(nullptr)
             , _count(0)
         {
@@ -67,35 +68,38 @@ namespace bpf
                 Add(entry.Key, entry.Value);
         }
 
-        template <typename K, typename V, template <typename T> class Greater, template <typename T> class Less>
-        Map<K, V, Greater, Less>::~Map()
+        template <typename K, typename V, template <typename T> class Greater, template <typename T> class Less, template <typename T> class Allocator>
+        Map<K, V, Greater, Less, Allocator>::~Map()
         {
             Clear();
         }
 
-        template <typename K, typename V, template <typename T> class Greater, template <typename T> class Less>
-        void Map<K, V, Greater, Less>::Clear()
+        template <typename K, typename V, template <typename T> class Greater, template <typename T> class Less, template <typename T> class Allocator>
+        void Map<K, V, Greater, Less, Allocator>::Clear()
         {
-            if (_root == nullptr)
-                return;
-            Stack<Node *> stack = {_root};
-
-            while (stack.Size() > 0)
+            // Nodes of a pool allocated map with trivially destructible entries are released with their chunks
+            if (_root != nullptr && !(Allocator<Node>::BULK_RELEASE && std::is_trivially_destructible<Entry>::value))
             {
-                Node *elem = stack.Pop();
+                Stack<Node *> stack = {_root};
 
-                if (elem->Left != nullptr)
-                    stack.Push(elem->Left);
-                if (elem->Right != nullptr)
-                    stack.Push(elem->Right);
-                memory::MemUtils::Delete(elem);
+                while (stack.Size() > 0)
+                {
+                    Node *elem = stack.Pop();
+
+                    if (elem->Left != nullptr)
+                        stack.Push(elem->Left);
+                    if (elem->Right != nullptr)
+                        stack.Push(elem->Right);
+                    _alloc.Delete(elem);
+                }
             }
+            _alloc.Release();
             _root = nullptr;
             _count = 0;
         }
 
-        template <typename K, typename V, template <typename T> class Greater, template <typename T> class Less>
-        Map<K, V, Greater, Less> &Map<K, V, Greater, Less>::operator=(const Map &other)
+        template <typename K, typename V, template <typename T> class Greater, template <typename T> class Less, template <typename T> class Allocator>
+        Map<K, V, Greater, Less, Allocator> &Map<K, V, Greater, Less, Allocator>::operator=(const Map &other)
         {
             if (this == &other)
                 return (*this);
@@ -105,48 +109,49 @@ namespace bpf
             return (*this);
         }
 
-        template <typename K, typename V, template <typename T> class Greater, template <typename T> class Less>
-        Map<K, V, Greater, Less> &Map<K, V, Greater, Less>::operator=(Map &&other) noexcept
+        template <typename K, typename V, template <typename T> class Greater, template <typename T> class Less, template <typename T> class Allocator>
+        Map<K, V, Greater, Less, Allocator> &Map<K, V, Greater, Less, Allocator>::operator=(Map &&other) noexcept
         {
             Clear();
             _root = other._root;
             _count = other._count;
+            _alloc = std::move(other._alloc);
             other._root = nullptr;
             other._count = 0;
             return (*this);
         }
 
-        template <typename K, typename V, template <typename T> class Greater, template <typename T> class Less>
-        Map<K, V, Greater, Less> Map<K, V, Greater, Less>::operator+(const Map<K, V, Greater, Less> &other) const
+        template <typename K, typename V, template <typename T> class Greater, template <typename T> class Less, template <typename T> class Allocator>
+        Map<K, V, Greater, Less, Allocator> Map<K, V, Greater, Less, Allocator>::operator+(const Map<K, V, Greater, Less, Allocator> &other) const
         {
-            Map<K, V, Greater, Less> cpy = *this;
+            Map<K, V, Greater, Less, Allocator> cpy = *this;
 
             for (const auto &elem : other)
                 cpy.Add(elem.Key, elem.Value);
             return (cpy);
         }
 
-        template <typename K, typename V, template <typename T> class Greater, template <typename T> class Less>
-        void Map<K, V, Greater, Less>::operator+=(const Map<K, V, Greater, Less> &other)
+        template <typename K, typename V, template <typename T> class Greater, template <typename T> class Less, template <typename T> class Allocator>
+        void Map<K, V, Greater, Less, Allocator>::operator+=(const Map<K, V, Greater, Less, Allocator> &other)
         {
             for (const auto &elem : other)
                 Add(elem.Key, elem.Value);
         }
 
-        template <typename K, typename V, template <typename T> class Greater, template <typename T> class Less>
-        fisize Map<K, V, Greater, Less>::Height(Node *node)
+        template <typename K, typename V, template <typename T> class Greater, template <typename T> class Less, template <typename T> class Allocator>
+        fisize Map<K, V, Greater, Less, Allocator>::Height(Node *node)
         {
             return (node != nullptr ? node->Height : 0);
         }
 
-        template <typename K, typename V, template <typename T> class Greater, template <typename T> class Less>
-        fisize Map<K, V, Greater, Less>::Balance(Node *node)
+        template <typename K, typename V, template <typename T> class Greater, template <typename T> class Less, template <typename T> class Allocator>
+        fisize Map<K, V, Greater, Less, Allocator>::Balance(Node *node)
         {
             return (node != nullptr ? Height(node->Left) - Height(node->Right) : 0);
         }
 
-        template <typename K, typename V, template <typename T> class Greater, template <typename T> class Less>
-        void Map<K, V, Greater, Less>::LeftRotate(Node *node)
+        template <typename K, typename V, template <typename T> class Greater, template <typename T> class Less, template <typename T> class Allocator>
+        void Map<K, V, Greater, Less, Allocator>::LeftRotate(Node *node)
         {
             Node *nd = node->Right;
             node->Right = nd->Left;
@@ -171,8 +176,8 @@ namespace bpf
                 nd->Height = 1 + Height(nd->Right);
         }
 
-        template <typename K, typename V, template <typename T> class Greater, template <typename T> class Less>
-        void Map<K, V, Greater, Less>::RightRotate(Node *node)
+        template <typename K, typename V, template <typename T> class Greater, template <typename T> class Less, template <typename T> class Allocator>
+        void Map<K, V, Greater, Less, Allocator>::RightRotate(Node *node)
         {
             Node *nd = node->Left;
             node->Left = nd->Right;
@@ -197,15 +202,15 @@ namespace bpf
                 nd->Height = 1 + Height(nd->Right);
         }
 
-        template <typename K, typename V, template <typename T> class Greater, template <typename T> class Less>
-        typename Map<K, V, Greater, Less>::Node *Map<K, V, Greater, Less>::InsertNode(const K &key)
+        template <typename K, typename V, template <typename T> class Greater, template <typename T> class Less, template <typename T> class Allocator>
+        typename Map<K, V, Greater, Less, Allocator>::Node *Map<K, V, Greater, Less, Allocator>::InsertNode(const K &key)
         {
             Node *newNode;
 
             /* BST standard add */
             if (_root == nullptr)
             {
-                newNode = memory::MemUtils::New<Node>();
+                newNode = _alloc.New();
                 newNode->KeyVal.Key = key;
                 /* Data structure augmentation */
                 newNode->Height = 1; //Every new node is a leaf
@@ -236,7 +241,7 @@ namespace bpf
                     return (cur);
             }
             ++_count;
-            newNode = memory::MemUtils::New<Node>();
+            newNode = _alloc.New();
             newNode->KeyVal.Key = key;
             /* Data structure augmentation */
             newNode->Height = 1; //Every new node is a leaf
@@ -272,16 +277,16 @@ namespace bpf
             return (newNode);
         }
 
-        template <typename K, typename V, template <typename T> class Greater, template <typename T> class Less>
-        typename Map<K, V, Greater, Less>::Node *Map<K, V, Greater, Less>::FindMin(Node *node)
+        template <typename K, typename V, template <typename T> class Greater, template <typename T> class Less, template <typename T> class Allocator>
+        typename Map<K, V, Greater, Less, Allocator>::Node *Map<K, V, Greater, Less, Allocator>::FindMin(Node *node)
         {
             while (node != nullptr && node->Left != nullptr)
                 node = node->Left;
             return (node);
         }
 
-        template <typename K, typename V, template <typename T> class Greater, template <typename T> class Less>
-        void Map<K, V, Greater, Less>::SwapKeyVal(Node *a, Node *b)
+        template <typename K, typename V, template <typename T> class Greater, template <typename T> class Less, template <typename T> class Allocator>
+        void Map<K, V, Greater, Less, Allocator>::SwapKeyVal(Node *a, Node *b)
         {
             K tmp = std::move(a->KeyVal.Key);
             V tmp1 = std::move(a->KeyVal.Value);
@@ -292,8 +297,8 @@ namespace bpf
             b->KeyVal.Value = std::move(tmp1);
         }
 
-        template <typename K, typename V, template <typename T> class Greater, template <typename T> class Less>
-        void Map<K, V, Greater, Less>::SwapVal(Node *a, Node *b)
+        template <typename K, typename V, template <typename T> class Greater, template <typename T> class Less, template <typename T> class Allocator>
+        void Map<K, V, Greater, Less, Allocator>::SwapVal(Node *a, Node *b)
         {
             V tmp = std::move(a->KeyVal.Value);
 
@@ -301,8 +306,8 @@ namespace bpf
             b->KeyVal.Value = std::move(tmp);
         }
 
-        template <typename K, typename V, template <typename T> class Greater, template <typename T> class Less>
-        void Map<K, V, Greater, Less>::RemoveNode(Node *node)
+        template <typename K, typename V, template <typename T> class Greater, template <typename T> class Less, template <typename T> class Allocator>
+        void Map<K, V, Greater, Less, Allocator>::RemoveNode(Node *node)
         {
             /* Data structure augmentation */
             Node *parent = node;
@@ -312,7 +317,7 @@ namespace bpf
             {
                 if (node == _root)
                 {
-                    memory::MemUtils::Delete(node);
+                    _alloc.Delete(node);
                     _root = nullptr;
                     return;
                 }
@@ -321,17 +326,21 @@ namespace bpf
                 else
                     node->Parent->Right = nullptr;
                 parent = parent->Parent;
-                memory::MemUtils::Delete(node);
+                _alloc.Delete(node);
             }
             else if (node->Left != nullptr && node->Right != nullptr) // Case 3 node has two children, find min in right sub tree then swap and finally remove
             {
                 Node *nd = FindMin(node->Right);
                 SwapKeyVal(nd, node);
+                // The minimum has no left child but may have a right one
                 if (nd->Parent->Left == nd)
-                    nd->Parent->Left = nullptr;
+                    nd->Parent->Left = nd->Right;
                 else
-                    nd->Parent->Right = nullptr;
-                memory::MemUtils::Delete(nd);
+                    nd->Parent->Right = nd->Right;
+                if (nd->Right != nullptr)
+                    nd->Right->Parent = nd->Parent;
+                parent = nd->Parent;
+                _alloc.Delete(nd);
             }
             else // Case 2 node has one child
             {
@@ -341,7 +350,9 @@ namespace bpf
                         _root = _root->Left;
                     else
                         _root = _root->Right;
+                    _root->Parent = nullptr;
                     parent = _root;
+                    _alloc.Delete(node);
                 }
                 else if (node->Parent->Left == node)
                 {
@@ -357,6 +368,7 @@ namespace bpf
                         node->Right->Parent = node->Parent;
                         parent = node->Right;
                     }
+                    _alloc.Delete(node);
                 }
                 else
                 {
@@ -372,7 +384,7 @@ namespace bpf
                         node->Right->Parent = node->Parent;
                         parent = node->Right;
                     }
-                    memory::MemUtils::Delete(node);
+                    _alloc.Delete(node);
                 }
             }
 
@@ -401,24 +413,24 @@ namespace bpf
             }
         }
 
-        template <typename K, typename V, template <typename T> class Greater, template <typename T> class Less>
-        void Map<K, V, Greater, Less>::Add(const K &key, const V &value)
+        template <typename K, typename V, template <typename T> class Greater, template <typename T> class Less, template <typename T> class Allocator>
+        void Map<K, V, Greater, Less, Allocator>::Add(const K &key, const V &value)
         {
             Node *newNode = InsertNode(key);
 
             newNode->KeyVal.Value = value;
         }
 
-        template <typename K, typename V, template <typename T> class Greater, template <typename T> class Less>
-        void Map<K, V, Greater, Less>::Add(const K &key, V &&value)
+        template <typename K, typename V, template <typename T> class Greater, template <typename T> class Less, template <typename T> class Allocator>
+        void Map<K, V, Greater, Less, Allocator>::Add(const K &key, V &&value)
         {
             Node *newNode = InsertNode(key);
 
             newNode->KeyVal.Value = std::move(value);
         }
 
-        template <typename K, typename V, template <typename T> class Greater, template <typename T> class Less>
-        typename Map<K, V, Greater, Less>::Node *Map<K, V, Greater, Less>::FindNode(const K &key) const
+        template <typename K, typename V, template <typename T> class Greater, template <typename T> class Less, template <typename T> class Allocator>
+        typename Map<K, V, Greater, Less, Allocator>::Node *Map<K, V, Greater, Less, Allocator>::FindNode(const K &key) const
         {
             Node *nd = _root;
 
@@ -434,8 +446,8 @@ namespace bpf
             return (nd);
         }
 
-        template <typename K, typename V, template <typename T> class Greater, template <typename T> class Less>
-        void Map<K, V, Greater, Less>::RemoveAt(const K &key)
+        template <typename K, typename V, template <typename T> class Greater, template <typename T> class Less, template <typename T> class Allocator>
+        void Map<K, V, Greater, Less, Allocator>::RemoveAt(const K &key)
         {
             Node *nd = FindNode(key);
 
@@ -446,8 +458,8 @@ namespace bpf
             }
         }
 
-        template <typename K, typename V, template <typename T> class Greater, template <typename T> class Less>
-        void Map<K, V, Greater, Less>::RemoveAt(Iterator &pos)
+        template <typename K, typename V, template <typename T> class Greater, template <typename T> class Less, template <typename T> class Allocator>
+        void Map<K, V, Greater, Less, Allocator>::RemoveAt(Iterator &pos)
         {
             Iterator cpy = pos;
 
@@ -464,8 +476,8 @@ namespace bpf
             }
         }
 
-        template <typename K, typename V, template <typename T> class Greater, template <typename T> class Less>
-        void Map<K, V, Greater, Less>::RemoveAt(Iterator &&pos)
+        template <typename K, typename V, template <typename T> class Greater, template <typename T> class Less, template <typename T> class Allocator>
+        void Map<K, V, Greater, Less, Allocator>::RemoveAt(Iterator &&pos)
         {
             Iterator cpy = pos;
 
@@ -483,17 +495,17 @@ namespace bpf
             }
         }
 
-        template <typename K, typename V, template <typename T> class Greater, template <typename T> class Less>
-        void Map<K, V, Greater, Less>::Swap(const Iterator &a, const Iterator &b)
+        template <typename K, typename V, template <typename T> class Greater, template <typename T> class Less, template <typename T> class Allocator>
+        void Map<K, V, Greater, Less, Allocator>::Swap(const Iterator &a, const Iterator &b)
         {
             if (a._curNode == nullptr || b._curNode == nullptr)
                 return;
             SwapVal(a._curNode, b._curNode);
         }
 
-        template <typename K, typename V, template <typename T> class Greater, template <typename T> class Less>
+        template <typename K, typename V, template <typename T> class Greater, template <typename T> class Less, template <typename T> class Allocator>
         template <template <typename> class Comparator>
-        void Map<K, V, Greater, Less>::Remove(const V &value, const bool all)
+        void Map<K, V, Greater, Less, Allocator>::Remove(const V &value, const bool all)
         {
             for (auto &entry : *this)
             {
@@ -506,8 +518,8 @@ namespace bpf
             }
         }
 
-        template <typename K, typename V, template <typename T> class Greater, template <typename T> class Less>
-        const V &Map<K, V, Greater, Less>::operator[](const K &key) const
+        template <typename K, typename V, template <typename T> class Greater, template <typename T> class Less, template <typename T> class Allocator>
+        const V &Map<K, V, Greater, Less, Allocator>::operator[](const K &key) const
         {
             Node *nd = FindNode(key);
 
@@ -516,8 +528,8 @@ namespace bpf
             return (nd->KeyVal.Value);
         }
 
-        template <typename K, typename V, template <typename T> class Greater, template <typename T> class Less>
-        V &Map<K, V, Greater, Less>::operator[](const K &key)
+        template <typename K, typename V, template <typename T> class Greater, template <typename T> class Less, template <typename T> class Allocator>
+        V &Map<K, V, Greater, Less, Allocator>::operator[](const K &key)
         {
             Node *nd = FindNode(key);
 
@@ -529,17 +541,17 @@ namespace bpf
             return (nd->KeyVal.Value);
         }
 
-        template <typename K, typename V, template <typename T> class Greater, template <typename T> class Less>
-        typename Map<K, V, Greater, Less>::Iterator Map<K, V, Greater, Less>::FindByKey(const K &key)
+        template <typename K, typename V, template <typename T> class Greater, template <typename T> class Less, template <typename T> class Allocator>
+        typename Map<K, V, Greater, Less, Allocator>::Iterator Map<K, V, Greater, Less, Allocator>::FindByKey(const K &key)
         {
             Node *nd = FindNode(key);
 
             return (Iterator(_root, nd));
         }
 
-        template <typename K, typename V, template <typename T> class Greater, template <typename T> class Less>
+        template <typename K, typename V, template <typename T> class Greater, template <typename T> class Less, template <typename T> class Allocator>
         template <template <typename> class Comparator>
-        typename Map<K, V, Greater, Less>::Iterator Map<K, V, Greater, Less>::FindByValue(const V &val)
+        typename Map<K, V, Greater, Less, Allocator>::Iterator Map<K, V, Greater, Less, Allocator>::FindByValue(const V &val)
         {
             for (auto it = begin(); it != end(); ++it)
             {
@@ -549,8 +561,8 @@ namespace bpf
             return (Iterator(_root, nullptr));
         }
 
-        template <typename K, typename V, template <typename T> class Greater, template <typename T> class Less>
-        typename Map<K, V, Greater, Less>::Iterator Map<K, V, Greater, Less>::Find(const std::function<int(const Node &node)> &comparator)
+        template <typename K, typename V, template <typename T> class Greater, template <typename T> class Less, template <typename T> class Allocator>
+        typename Map<K, V, Greater, Less, Allocator>::Iterator Map<K, V, Greater, Less, Allocator>::Find(const std::function<int(const Node &node)> &comparator)
         {
             Node *nd = _root;
 
@@ -567,8 +579,8 @@ namespace bpf
             return (Iterator(_root, nd));
         }
 
-        template <typename K, typename V, template <typename T> class Greater, template <typename T> class Less>
-        typename Map<K, V, Greater, Less>::Iterator Map<K, V, Greater, Less>::FindMin()
+        template <typename K, typename V, template <typename T> class Greater, template <typename T> class Less, template <typename T> class Allocator>
+        typename Map<K, V, Greater, Less, Allocator>::Iterator Map<K, V, Greater, Less, Allocator>::FindMin()
         {
             Node *node = _root;
 
@@ -577,8 +589,8 @@ namespace bpf
             return (Iterator(_root, node));
         }
 
-        template <typename K, typename V, template <typename T> class Greater, template <typename T> class Less>
-        typename Map<K, V, Greater, Less>::Iterator Map<K, V, Greater, Less>::FindMax()
+        template <typename K, typename V, template <typename T> class Greater, template <typename T> class Less, template <typename T> class Allocator>
+        typename Map<K, V, Greater, Less, Allocator>::Iterator Map<K, V, Greater, Less, Allocator>::FindMax()
         {
             Node *node = _root;
 
@@ -587,8 +599,8 @@ namespace bpf
             return (Iterator(_root, node));
         }
 
-        template <typename K, typename V, template <typename T> class Greater, template <typename T> class Less>
-        bool Map<K, V, Greater, Less>::operator==(const Map<K, V, Greater, Less> &other) const noexcept
+        template <typename K, typename V, template <typename T> class Greater, template <typename T> class Less, template <typename T> class Allocator>
+        bool Map<K, V, Greater, Less, Allocator>::operator==(const Map<K, V, Greater, Less, Allocator> &other) const noexcept
         {
             if (_count != other._count)
                 return (false);
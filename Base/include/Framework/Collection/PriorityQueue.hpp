@@ -4,7 +4,7 @@
 //
 // Redistribution and use in source and binary forms, with or without modification,
 // are permitted provided that the following conditions are met:
-//
+// 
 //     * Redistributions of source code must retain the above copyright notice,
 //       this list of conditions and the following disclaimer.
 //     * Redistributions in binary form must reproduce the above copyright notice,
@@ -36,12 +36,16 @@ namespace bpf
     namespace collection
     {
         /**
-         * Priority queue implemented using min/max heap
+         * Priority queue implemented using a 4-ary min/max heap.
+         * Keys and values are stored together in a single contiguous buffer: children of a node are adjacent in
+         * memory, which halves the height of the heap compared to a binary heap at the cost of more comparisons
+         * per level. Values do not need to be copyable nor default constructible
          * @tparam K the key type
          * @tparam V the value type
          * @tparam HeapFunc heap comparision operator usually set to either MaxHeap or MinHeap
+         * @tparam Indexed true to track the position of every element, enabling handle based UpdatePriority and Remove
          */
-        template <typename K, typename V, template <typename> class HeapFunc = MaxHeap>
+        template <typename K, typename V, template <typename> class HeapFunc = MaxHeap, bool Indexed = false>
         class BP_TPL_API PriorityQueue
         {
         public:
@@ -51,17 +55,48 @@ namespace bpf
                 V Value;
             };
 
+            /**
+             * Identifies an element of an indexed queue for as long as it stays in the queue.
+             * Handles of removed elements are reused
+             */
+            using Handle = fsize;
+
+            /**
+             * Number of children per node
+             */
+            static constexpr fsize ARITY = 4;
+
+            /**
+             * Handle returned by non indexed queues
+             */
+            static constexpr Handle NO_HANDLE = static_cast<Handle>(-1);
+
         private:
+            /**
+             * Heap size in bytes up to which children are selected without branches
+             */
+            static constexpr fsize BRANCHLESS_BYTES = 262144;
+
             fsize _maxSize;
-            fsize _tailPtr;
             fsize _count;
-            // MSVC absolutely wants to instantiate unused C++ template member functions !
-            // Seriously Microsoft, please fix your fucking non standard compliant compiler !!
-            Array<K> _dataK;
-            Array<V> _dataV;
+            fsize _capacity;
+            Entry *_data;
+            // Heap position -> handle
+            Array<fsize> _handles;
+            // Handle -> heap position, or next free handle for released handles
+            Array<fsize> _positions;
+            fsize _handleCount;
+            fsize _freeHandle;
 
-            void BubbleUp(fsize i);
-            void SinkDown(fsize i);
+            void Grow(fsize capacity);
+            Handle Acquire();
+            void Track(fsize i, fsize handle);
+            fsize BestChild(fsize i) const;
+            void SiftUp(fsize i);
+            void SiftDown(fsize i);
+            Entry Extract(fsize i);
+            void CopyFrom(const PriorityQueue<K, V, HeapFunc, Indexed> &other);
+            void Destroy();
 
         public:
             /**
@@ -79,77 +114,71 @@ namespace bpf
             /**
              * Copy constructor
              */
-            inline PriorityQueue(const PriorityQueue<K, V, HeapFunc> &other)
-                : _maxSize(other._maxSize)
-                , _tailPtr(other._tailPtr)
-                , _count(other._count)
-                , _dataK(other._dataK)
-                , _dataV(other._dataV)
-            {
-            }
+            PriorityQueue(const PriorityQueue<K, V, HeapFunc, Indexed> &other);
 
             /**
              * Move constructor
              */
-            inline PriorityQueue(PriorityQueue<K, V, HeapFunc> &&other) noexcept
-                : _maxSize(other._maxSize)
-                , _tailPtr(other._tailPtr)
-                , _count(other._count)
-                , _dataK(std::move(other._dataK))
-                , _dataV(std::move(other._dataV))
-            {
-                other._tailPtr = 0;
-                other._count = 0;
-            }
+            PriorityQueue(PriorityQueue<K, V, HeapFunc, Indexed> &&other) noexcept;
+
+            ~PriorityQueue();
 
             /**
              * Copy assignment operator
              */
-            inline PriorityQueue<K, V, HeapFunc> &operator=(const PriorityQueue<K, V, HeapFunc> &other)
-            {
-                if (this == &other)
-                    return (*this);
-                _maxSize = other._maxSize;
-                _tailPtr = other._tailPtr;
-                _count = other._count;
-                _dataK = other._dataK;
-                _dataV = other._dataV;
-                return (*this);
-            }
+            PriorityQueue<K, V, HeapFunc, Indexed> &operator=(const PriorityQueue<K, V, HeapFunc, Indexed> &other);
 
             /**
              * Move assignment operator
              */
-            inline PriorityQueue<K, V, HeapFunc> &operator=(PriorityQueue<K, V, HeapFunc> &&other) noexcept
-            {
-                _maxSize = other._maxSize;
-                _tailPtr = other._tailPtr;
-                _count = other._count;
-                _dataK = std::move(other._dataK);
-                _dataV = std::move(other._dataV);
-                other._tailPtr = 0;
-                other._count = 0;
-                return (*this);
-            }
+            PriorityQueue<K, V, HeapFunc, Indexed> &operator=(PriorityQueue<K, V, HeapFunc, Indexed> &&other) noexcept;
 
             /**
              * Clears this queue
              */
             void Clear();
 
+            /**
+             * Ensures this queue can hold at least count elements without reallocating.
+             * Has no effect on queues with a maximum size
+             * @param count the number of elements to reserve space for
+             */
+            void Reserve(fsize count);
+
+            /**
+             * Constructs an element in place on the queue
+             * @tparam Args the types of arguments to the value constructor
+             * @param key the key for that element
+             * @param args arguments to the value constructor
+             * @throw IndexException if the queue is limited and full
+             * @return a handle to the new element, NO_HANDLE if this queue is not indexed
+             */
+            template <typename... Args>
+            Handle Emplace(const K &key, Args &&... args);
+
             /**
              * Pushes an element on the queue
              * @param key the key for that element
              * @param value the value for that element
+             * @throw IndexException if the queue is limited and full
+             * @return a handle to the new element, NO_HANDLE if this queue is not indexed
              */
-            void Push(const K &key, const V &value);
+            inline Handle Push(const K &key, const V &value)
+            {
+                return (Emplace(key, value));
+            }
 
             /**
              * Pushes an element on the queue
              * @param key the key for that element
              * @param value the value for that element
+             * @throw IndexException if the queue is limited and full
+             * @return a handle to the new element, NO_HANDLE if this queue is not indexed
              */
-            void Push(const K &key, V &&value);
+            inline Handle Push(const K &key, V &&value)
+            {
+                return (Emplace(key, std::move(value)));
+            }
 
             /**
              * Extracts the top of the queue
@@ -158,6 +187,29 @@ namespace bpf
              */
             V Pop();
 
+            /**
+             * Changes the key of an element and restores the heap order. Only available on indexed queues
+             * @param handle the handle of the element returned by Push or Emplace
+             * @param key the new key
+             * @throw IndexException if the handle does not refer to an element of this queue
+             */
+            void UpdatePriority(Handle handle, const K &key);
+
+            /**
+             * Removes an element from the queue. Only available on indexed queues
+             * @param handle the handle of the element returned by Push or Emplace
+             * @throw IndexException if the handle does not refer to an element of this queue
+             * @return the removed item
+             */
+            V Remove(Handle handle);
+
+            /**
+             * Checks if a handle refers to an element of this queue. Only available on indexed queues
+             * @param handle the handle to check
+             * @return true if the element is in this queue
+             */
+            bool Contains(Handle handle) const;
+
             /**
              * Returns the top of the queue
              * @throw IndexException if the queue is empty
@@ -165,9 +217,9 @@ namespace bpf
              */
             inline V &Top()
             {
-                if (Size() <= 0)
+                if (_count == 0)
                     throw IndexException(0);
-                return (_dataV[1]);
+                return (_data[0].Value);
             }
 
             /**
@@ -177,9 +229,21 @@ namespace bpf
              */
             inline const V &Top() const
             {
-                if (Size() <= 0)
+                if (_count == 0)
                     throw IndexException(0);
-                return (_dataV[1]);
+                return (_data[0].Value);
+            }
+
+            /**
+             * Returns the key of the top of the queue
+             * @throw IndexException if the queue is empty
+             * @return immutable key
+             */
+            inline const K &TopKey() const
+            {
+                if (_count == 0)
+                    throw IndexException(0);
+                return (_data[0].Key);
             }
 
             /**
@@ -190,6 +254,15 @@ namespace bpf
             {
                 return (_count);
             }
+
+            /**
+             * Returns the number of items this queue can hold before reallocating
+             * @return capacity as unsigned
+             */
+            inline fsize Capacity() const
+            {
+                return (_capacity);
+            }
         };
     }
 }
@@ -4,7 +4,7 @@
 //
 // Redistribution and use in source and binary forms, with or without modification,
 // are permitted provided that the following conditions are met:
-//
+// 
 //     * Redistributions of source code must retain the above copyright notice,
 //       this list of conditions and the following disclaimer.
 //     * Redistributions in binary form must reproduce the above copyright notice,
@@ -27,153 +27,370 @@
 // SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #pragma once
+#include "Framework/Memory/Memory.hpp"
+#include <new>
+#include <utility>
 
 namespace bpf
 {
     namespace collection
     {
-        template <typename K, typename V, template <typename> class HeapFunc>
-        void PriorityQueue<K, V, HeapFunc>::BubbleUp(fsize i)
+        template <typename K, typename V, template <typename> class HeapFunc, bool Indexed>
+        constexpr fsize PriorityQueue<K, V, HeapFunc, Indexed>::ARITY;
+
+        template <typename K, typename V, template <typename> class HeapFunc, bool Indexed>
+        constexpr fsize PriorityQueue<K, V, HeapFunc, Indexed>::BRANCHLESS_BYTES;
+
+        template <typename K, typename V, template <typename> class HeapFunc, bool Indexed>
+        constexpr typename PriorityQueue<K, V, HeapFunc, Indexed>::Handle PriorityQueue<K, V, HeapFunc, Indexed>::NO_HANDLE;
+
+        template <typename K, typename V, template <typename> class HeapFunc, bool Indexed>
+        void PriorityQueue<K, V, HeapFunc, Indexed>::Grow(const fsize capacity)
+        {
+            Entry *mem = static_cast<Entry *>(memory::Memory::Malloc(capacity * sizeof(Entry)));
+            for (fsize i = 0; i != _count; ++i)
+            {
+                new (mem + i) Entry(std::move(_data[i]));
+                _data[i].~Entry();
+            }
+            memory::Memory::Free(_data);
+            _data = mem;
+            _capacity = capacity;
+            if (Indexed)
+            {
+                // A queue never holds more handles than its capacity so that Acquire cannot fail
+                _handles.Resize(capacity);
+                _positions.Resize(capacity);
+            }
+        }
+
+        template <typename K, typename V, template <typename> class HeapFunc, bool Indexed>
+        typename PriorityQueue<K, V, HeapFunc, Indexed>::Handle PriorityQueue<K, V, HeapFunc, Indexed>::Acquire()
+        {
+            if (_freeHandle != NO_HANDLE)
+            {
+                Handle handle = _freeHandle;
+                _freeHandle = (*_positions)[handle];
+                return (handle);
+            }
+            return (_handleCount++);
+        }
+
+        template <typename K, typename V, template <typename> class HeapFunc, bool Indexed>
+        inline void PriorityQueue<K, V, HeapFunc, Indexed>::Track(const fsize i, const fsize handle)
         {
-            fsize parent = i / 2;
+            if (Indexed)
+            {
+                (*_handles)[i] = handle;
+                (*_positions)[handle] = i;
+            }
+        }
 
-            while (i > 1 && HeapFunc<K>::Eval(_dataK[i], _dataK[parent]))
+        template <typename K, typename V, template <typename> class HeapFunc, bool Indexed>
+        void PriorityQueue<K, V, HeapFunc, Indexed>::SiftUp(fsize i)
+        {
+            if (i == 0)
+                return;
+            fsize parent = (i - 1) / ARITY;
+            if (HeapFunc<K>::Eval(_data[parent].Key, _data[i].Key))
+                return;
+            Entry entry = std::move(_data[i]);
+            fsize handle = Indexed ? (*_handles)[i] : 0;
+            do
             {
-                K key = std::move(_dataK[i]);
-                V value = std::move(_dataV[i]);
-                _dataK[i] = std::move(_dataK[parent]);
-                _dataV[i] = std::move(_dataV[parent]);
-                _dataK[parent] = std::move(key);
-                _dataV[parent] = std::move(value);
+                _data[i] = std::move(_data[parent]);
+                if (Indexed)
+                    Track(i, (*_handles)[parent]);
                 i = parent;
-                parent = i / 2;
+                parent = (i - 1) / ARITY;
+            } while (i > 0 && !HeapFunc<K>::Eval(_data[parent].Key, entry.Key));
+            _data[i] = std::move(entry);
+            Track(i, handle);
+        }
+
+        template <typename K, typename V, template <typename> class HeapFunc, bool Indexed>
+        inline fsize PriorityQueue<K, V, HeapFunc, Indexed>::BestChild(const fsize i) const
+        {
+            fsize first = i * ARITY + 1;
+            if (first >= _count)
+                return (0);
+            // Once the heap no longer fits in cache, branches let the CPU speculatively load the next level
+            // while conditional moves would serialize the memory accesses
+            if (_count - first >= ARITY && _count * sizeof(Entry) <= BRANCHLESS_BYTES)
+            {
+                // Tournament on the 4 children: independent comparisons compile to conditional moves
+                fsize left = HeapFunc<K>::Eval(_data[first].Key, _data[first + 1].Key) ? first : first + 1;
+                fsize right = HeapFunc<K>::Eval(_data[first + 2].Key, _data[first + 3].Key) ? first + 2 : first + 3;
+                return (HeapFunc<K>::Eval(_data[left].Key, _data[right].Key) ? left : right);
+            }
+            fsize last = _count - first < ARITY ? _count : first + ARITY;
+            fsize best = first;
+            for (fsize child = first + 1; child < last; ++child)
+            {
+                if (!HeapFunc<K>::Eval(_data[best].Key, _data[child].Key))
+                    best = child;
             }
+            return (best);
         }
 
-        template <typename K, typename V, template <typename> class HeapFunc>
-        void PriorityQueue<K, V, HeapFunc>::SinkDown(fsize i)
+        template <typename K, typename V, template <typename> class HeapFunc, bool Indexed>
+        void PriorityQueue<K, V, HeapFunc, Indexed>::SiftDown(fsize i)
         {
-            fsize left = i * 2;
-            fsize right = i * 2 + 1;
-            fsize k = i;
+            fsize best = BestChild(i);
+            if (best == 0 || HeapFunc<K>::Eval(_data[i].Key, _data[best].Key))
+                return;
+            Entry entry = std::move(_data[i]);
+            fsize handle = Indexed ? (*_handles)[i] : 0;
+            do
+            {
+                _data[i] = std::move(_data[best]);
+                if (Indexed)
+                    Track(i, (*_handles)[best]);
+                i = best;
+                best = BestChild(i);
+            } while (best != 0 && !HeapFunc<K>::Eval(entry.Key, _data[best].Key));
+            _data[i] = std::move(entry);
+            Track(i, handle);
+        }
 
-            while (left < _tailPtr + 1 && right < _tailPtr + 1 && (HeapFunc<K>::Eval(_dataK[left], _dataK[i]) || HeapFunc<K>::Eval(_dataK[right], _dataK[i])))
+        template <typename K, typename V, template <typename> class HeapFunc, bool Indexed>
+        typename PriorityQueue<K, V, HeapFunc, Indexed>::Entry PriorityQueue<K, V, HeapFunc, Indexed>::Extract(const fsize i)
+        {
+            Entry res = std::move(_data[i]);
+            if (Indexed)
             {
-                if (HeapFunc<K>::Eval(_dataK[left], _dataK[right]))
-                    k = left;
-                else if (HeapFunc<K>::Eval(_dataK[right], _dataK[left]))
-                    k = right;
-                if (k != i)
+                Handle handle = (*_handles)[i];
+                (*_positions)[handle] = _freeHandle;
+                _freeHandle = handle;
+            }
+            --_count;
+            if (i == 0 && _count > 0)
+            {
+                // The last element almost always belongs to the bottom of the heap: the hole moves down to a leaf
+                // without comparing against it, then the last element fills the hole and moves up
+                fsize hole = 0;
+                for (fsize best = BestChild(0); best != 0; best = BestChild(hole))
                 {
-                    K key = std::move(_dataK[i]);
-                    V value = std::move(_dataV[i]);
-                    _dataK[i] = std::move(_dataK[k]);
-                    _dataV[i] = std::move(_dataV[k]);
-                    _dataK[k] = std::move(key);
-                    _dataV[k] = std::move(value);
-                    i = k;
-                    left = i * 2;
-                    right = i * 2 + 1;
+                    _data[hole] = std::move(_data[best]);
+                    if (Indexed)
+                        Track(hole, (*_handles)[best]);
+                    hole = best;
                 }
+                _data[hole] = std::move(_data[_count]);
+                if (Indexed)
+                    Track(hole, (*_handles)[_count]);
+                _data[_count].~Entry();
+                SiftUp(hole);
+            }
+            else if (i != _count)
+            {
+                _data[i] = std::move(_data[_count]);
+                if (Indexed)
+                    Track(i, (*_handles)[_count]);
+                _data[_count].~Entry();
+                if (i > 0 && !HeapFunc<K>::Eval(_data[(i - 1) / ARITY].Key, _data[i].Key))
+                    SiftUp(i);
                 else
-                    break;
+                    SiftDown(i);
             }
+            else
+                _data[_count].~Entry();
+            return (res);
+        }
+
+        template <typename K, typename V, template <typename> class HeapFunc, bool Indexed>
+        void PriorityQueue<K, V, HeapFunc, Indexed>::CopyFrom(const PriorityQueue<K, V, HeapFunc, Indexed> &other)
+        {
+            _maxSize = other._maxSize;
+            _capacity = other._capacity;
+            _data = _capacity > 0 ? static_cast<Entry *>(memory::Memory::Malloc(_capacity * sizeof(Entry))) : nullptr;
+            for (_count = 0; _count != other._count; ++_count)
+                new (_data + _count) Entry(other._data[_count]);
+            _handles = other._handles;
+            _positions = other._positions;
+            _handleCount = other._handleCount;
+            _freeHandle = other._freeHandle;
+        }
+
+        template <typename K, typename V, template <typename> class HeapFunc, bool Indexed>
+        void PriorityQueue<K, V, HeapFunc, Indexed>::Destroy()
+        {
+            for (fsize i = 0; i != _count; ++i)
+                _data[i].~Entry();
+            memory::Memory::Free(_data);
+            _data = nullptr;
+            _count = 0;
+            _capacity = 0;
         }
 
-        template <typename K, typename V, template <typename> class HeapFunc>
-        inline PriorityQueue<K, V, HeapFunc>::PriorityQueue(const fsize maxsize)
+        template <typename K, typename V, template <typename> class HeapFunc, bool Indexed>
+        PriorityQueue<K, V, HeapFunc, Indexed>::PriorityQueue(const fsize maxsize)
             : _maxSize(maxsize)
-            , _tailPtr(0)
             , _count(0)
-            , _dataK(maxsize > 0 ? (maxsize + 1) : 8)
-            , _dataV(maxsize > 0 ? (maxsize + 1) : 8)
+            , _capacity(0)
+            , _data(nullptr)
+            , _handleCount(0)
+            , _freeHandle(NO_HANDLE)
         {
+            if (maxsize > 0)
+                Grow(maxsize);
         }
 
-        template <typename K, typename V, template <typename> class HeapFunc>
-        PriorityQueue<K, V, HeapFunc>::PriorityQueue(const std::initializer_list<Entry> &lst)
+        template <typename K, typename V, template <typename> class HeapFunc, bool Indexed>
+        PriorityQueue<K, V, HeapFunc, Indexed>::PriorityQueue(const std::initializer_list<Entry> &lst)
             : _maxSize(0)
-            , _tailPtr(0)
             , _count(0)
-            , _dataK(8)
-            , _dataV(8)
+            , _capacity(0)
+            , _data(nullptr)
+            , _handleCount(0)
+            , _freeHandle(NO_HANDLE)
         {
+            Reserve(lst.size());
             for (auto &elem : lst)
                 Push(elem.Key, elem.Value);
         }
 
-        template <typename K, typename V, template <typename> class HeapFunc>
-        void PriorityQueue<K, V, HeapFunc>::Clear()
+        template <typename K, typename V, template <typename> class HeapFunc, bool Indexed>
+        PriorityQueue<K, V, HeapFunc, Indexed>::PriorityQueue(const PriorityQueue<K, V, HeapFunc, Indexed> &other)
+            : _count(0)
+            , _data(nullptr)
+        {
+            CopyFrom(other);
+        }
+
+        template <typename K, typename V, template <typename> class HeapFunc, bool Indexed>
+        PriorityQueue<K, V, HeapFunc, Indexed>::PriorityQueue(PriorityQueue<K, V, HeapFunc, Indexed> &&other) noexcept
+            : _maxSize(other._maxSize)
+            , _count(other._count)
+            , _capacity(other._capacity)
+            , _data(other._data)
+            , _handles(std::move(other._handles))
+            , _positions(std::move(other._positions))
+            , _handleCount(other._handleCount)
+            , _freeHandle(other._freeHandle)
+        {
+            other._data = nullptr;
+            other._count = 0;
+            other._capacity = 0;
+            other._handleCount = 0;
+            other._freeHandle = NO_HANDLE;
+        }
+
+        template <typename K, typename V, template <typename> class HeapFunc, bool Indexed>
+        PriorityQueue<K, V, HeapFunc, Indexed>::~PriorityQueue()
+        {
+            Destroy();
+        }
+
+        template <typename K, typename V, template <typename> class HeapFunc, bool Indexed>
+        PriorityQueue<K, V, HeapFunc, Indexed> &PriorityQueue<K, V, HeapFunc, Indexed>::operator=(const PriorityQueue<K, V, HeapFunc, Indexed> &other)
+        {
+            if (this == &other)
+                return (*this);
+            Destroy();
+            CopyFrom(other);
+            return (*this);
+        }
+
+        template <typename K, typename V, template <typename> class HeapFunc, bool Indexed>
+        PriorityQueue<K, V, HeapFunc, Indexed> &PriorityQueue<K, V, HeapFunc, Indexed>::operator=(PriorityQueue<K, V, HeapFunc, Indexed> &&other) noexcept
         {
-            _tailPtr = 0;
+            if (this == &other)
+                return (*this);
+            Destroy();
+            _maxSize = other._maxSize;
+            _count = other._count;
+            _capacity = other._capacity;
+            _data = other._data;
+            _handles = std::move(other._handles);
+            _positions = std::move(other._positions);
+            _handleCount = other._handleCount;
+            _freeHandle = other._freeHandle;
+            other._data = nullptr;
+            other._count = 0;
+            other._capacity = 0;
+            other._handleCount = 0;
+            other._freeHandle = NO_HANDLE;
+            return (*this);
+        }
+
+        template <typename K, typename V, template <typename> class HeapFunc, bool Indexed>
+        void PriorityQueue<K, V, HeapFunc, Indexed>::Clear()
+        {
+            for (fsize i = 0; i != _count; ++i)
+                _data[i].~Entry();
             _count = 0;
+            _handleCount = 0;
+            _freeHandle = NO_HANDLE;
         }
 
-        template <typename K, typename V, template <typename> class HeapFunc>
-        void PriorityQueue<K, V, HeapFunc>::Push(const K &key, const V &value)
+        template <typename K, typename V, template <typename> class HeapFunc, bool Indexed>
+        void PriorityQueue<K, V, HeapFunc, Indexed>::Reserve(const fsize count)
         {
-            if (_maxSize == 0)
-            {
-                if (_tailPtr + 1 >= _dataK.Size())
-                {
-                    _dataK.Resize(_dataK.Size() * 2);
-                    _dataV.Resize(_dataV.Size() * 2);
-                }
-            }
-            else
-            {
-                if (_tailPtr + 1 >= _dataK.Size())
-                    throw IndexException(_tailPtr);
-            }
-            _dataK[_tailPtr + 1] = key;
-            _dataV[_tailPtr + 1] = value;
-            //Bubble up
-            BubbleUp(_tailPtr + 1);
-            ++_tailPtr;
-            ++_count;
+            if (_maxSize == 0 && count > _capacity)
+                Grow(count);
         }
 
-        template <typename K, typename V, template <typename> class HeapFunc>
-        void PriorityQueue<K, V, HeapFunc>::Push(const K &key, V &&value)
+        template <typename K, typename V, template <typename> class HeapFunc, bool Indexed>
+        template <typename... Args>
+        typename PriorityQueue<K, V, HeapFunc, Indexed>::Handle PriorityQueue<K, V, HeapFunc, Indexed>::Emplace(const K &key, Args &&... args)
         {
-            if (_maxSize == 0)
+            if (_count == _capacity)
             {
-                if (_tailPtr + 1 >= _dataK.Size())
-                {
-                    _dataK.Resize(_dataK.Size() * 2);
-                    _dataV.Resize(_dataV.Size() * 2);
-                }
+                if (_maxSize != 0)
+                    throw IndexException(static_cast<fisize>(_count));
+                Grow(_capacity == 0 ? 8 : _capacity * 2);
             }
-            else
+            new (_data + _count) Entry{key, V(std::forward<Args>(args)...)};
+            Handle handle = NO_HANDLE;
+            if (Indexed)
             {
-                if (_tailPtr + 1 >= _dataK.Size())
-                    throw IndexException(_tailPtr);
+                handle = Acquire();
+                Track(_count, handle);
             }
-            _dataK[_tailPtr + 1] = key;
-            _dataV[_tailPtr + 1] = std::move(value);
-            //Bubble up
-            BubbleUp(_tailPtr + 1);
-            ++_tailPtr;
-            ++_count;
+            SiftUp(_count++);
+            return (handle);
         }
 
-        template <typename K, typename V, template <typename> class HeapFunc>
-        V PriorityQueue<K, V, HeapFunc>::Pop()
+        template <typename K, typename V, template <typename> class HeapFunc, bool Indexed>
+        V PriorityQueue<K, V, HeapFunc, Indexed>::Pop()
         {
             if (_count == 0)
                 throw IndexException(0);
-            V v = std::move(_dataV[1]);
-            _dataV[1] = std::move(_dataV[_tailPtr]);
-            _dataK[1] = std::move(_dataK[_tailPtr]);
-            //Sink down
-            SinkDown(1);
-            --_tailPtr;
-            --_count;
-#ifdef WINDOWS
-            return (std::move(v));
-#else
-            return (v); //Unix wants to be potentially slower (copy instead of move)
-#endif
+            return (std::move(Extract(0).Value));
+        }
+
+        template <typename K, typename V, template <typename> class HeapFunc, bool Indexed>
+        void PriorityQueue<K, V, HeapFunc, Indexed>::UpdatePriority(const Handle handle, const K &key)
+        {
+            static_assert(Indexed, "UpdatePriority requires an indexed PriorityQueue");
+            if (!Contains(handle))
+                throw IndexException(static_cast<fisize>(handle));
+            fsize i = (*_positions)[handle];
+            _data[i].Key = key;
+            if (i > 0 && !HeapFunc<K>::Eval(_data[(i - 1) / ARITY].Key, key))
+                SiftUp(i);
+            else
+                SiftDown(i);
+        }
+
+        template <typename K, typename V, template <typename> class HeapFunc, bool Indexed>
+        V PriorityQueue<K, V, HeapFunc, Indexed>::Remove(const Handle handle)
+        {
+            static_assert(Indexed, "Remove requires an indexed PriorityQueue");
+            if (!Contains(handle))
+                throw IndexException(static_cast<fisize>(handle));
+            return (std::move(Extract((*_positions)[handle]).Value));
+        }
+
+        template <typename K, typename V, template <typename> class HeapFunc, bool Indexed>
+        bool PriorityQueue<K, V, HeapFunc, Indexed>::Contains(const Handle handle) const
+        {
+            static_assert(Indexed, "Contains requires an indexed PriorityQueue");
+            if (handle >= _handleCount)
+                return (false);
+            fsize i = (*_positions)[handle];
+            return (i < _count && (*_handles)[i] == handle);
         }
     }
 }
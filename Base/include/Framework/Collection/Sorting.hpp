@@ -0,0 +1,121 @@
+// Copyright (c) 2020, BlockProject 3D
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without modification,
+// are permitted provided that the following conditions are met:
+// 
+//     * Redistributions of source code must retain the above copyright notice,
+//       this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above copyright notice,
+//       this list of conditions and the following disclaimer in the documentation
+//       and/or other materials provided with the distribution.
+//     * Neither the name of BlockProject 3D nor the names of its contributors
+//       may be used to endorse or promote products derived from this software
+//       without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#pragma once
+#include "Framework/Collection/Utility.hpp"
+#include "Framework/Types.hpp"
+
+namespace bpf
+{
+    namespace system
+    {
+        class BPF_API ThreadPool;
+    }
+
+    namespace collection
+    {
+        /**
+         * Sorting algorithms over contiguous ranges, used by the Sort functions of all collections.
+         * Comparators follow the collection convention: Comparator<T>::Eval(a, b) is true when a must be placed before b
+         */
+        class BP_TPL_API Sorting
+        {
+        public:
+            /**
+             * Sorts a range with pattern-defeating quicksort: O(n log n) worst case, O(n) on sorted, reversed
+             * and many-duplicates inputs. Large ranges of integer or floating point numbers compared with
+             * ops::Less or ops::Greater are radix sorted
+             * @tparam Comparator comparision operator
+             * @tparam T the type of element
+             * @param data pointer to the first element
+             * @param count number of elements
+             */
+            template <template <typename> class Comparator = ops::Less, typename T>
+            static void Unstable(T *data, fsize count);
+
+            /**
+             * Sorts a range with an adaptive merge sort preserving the order of equal elements: runs already in
+             * order are not merged again. Allocates a scratch buffer of count / 2 elements
+             * @tparam Comparator comparision operator
+             * @tparam T the type of element
+             * @param data pointer to the first element
+             * @param count number of elements
+             */
+            template <template <typename> class Comparator = ops::Less, typename T>
+            static void Stable(T *data, fsize count);
+
+            /**
+             * Sorts a range with an adaptive merge sort preserving the order of equal elements
+             * @tparam Comparator comparision operator
+             * @tparam T the type of element
+             * @param data pointer to the first element
+             * @param count number of elements
+             * @param scratch buffer of at least count / 2 + 1 elements, reused by all merges
+             */
+            template <template <typename> class Comparator = ops::Less, typename T>
+            static void Stable(T *data, fsize count, T *scratch);
+
+            /**
+             * Sorts integer or floating point numbers in increasing order with a least significant digit radix sort
+             * @tparam T the type of number
+             * @param data pointer to the first element
+             * @param count number of elements
+             * @param scratch buffer of at least count elements
+             */
+            template <typename T>
+            static void Radix(T *data, fsize count, T *scratch);
+
+            /**
+             * Sorts integer or floating point numbers in increasing order with a least significant digit radix sort.
+             * Allocates a scratch buffer of count elements
+             * @tparam T the type of number
+             * @param data pointer to the first element
+             * @param count number of elements
+             */
+            template <typename T>
+            static void Radix(T *data, fsize count);
+
+            /**
+             * Sorts a range on a ThreadPool and the calling thread: one block per thread is sorted, then blocks
+             * are merged in rounds where every thread produces an equal share of the output.
+             * Small ranges are sorted on the calling thread. The result is always stable when stable is true
+             * @tparam Comparator comparision operator
+             * @tparam Pool the type of pool, system::ThreadPool
+             * @tparam T the type of element
+             * @param pool the pool to run on
+             * @param data pointer to the first element
+             * @param count number of elements
+             * @param stable true to keep the order of equal elements
+             */
+            template <template <typename> class Comparator = ops::Less, typename Pool, typename T>
+            static void Parallel(Pool &pool, T *data, fsize count, bool stable = false);
+        };
+    }
+}
+
+#include "Framework/Collection/Sorting.impl.hpp"
@@ -0,0 +1,741 @@
+// Copyright (c) 2020, BlockProject 3D
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without modification,
+// are permitted provided that the following conditions are met:
+// 
+//     * Redistributions of source code must retain the above copyright notice,
+//       this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above copyright notice,
+//       this list of conditions and the following disclaimer in the documentation
+//       and/or other materials provided with the distribution.
+//     * Neither the name of BlockProject 3D nor the names of its contributors
+//       may be used to endorse or promote products derived from this software
+//       without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include "Framework/Memory/MemUtils.hpp"
+#include <cstring>
+#include <type_traits>
+#include <utility>
+
+namespace bpf
+{
+    namespace collection
+    {
+        namespace _bpf_internal_sort
+        {
+            constexpr fsize INSERTION_THRESHOLD = 24;
+            constexpr fsize NINTHER_THRESHOLD = 128;
+            constexpr fsize PARTIAL_INSERTION_LIMIT = 8;
+            constexpr fsize STABLE_RUN = 32;
+            constexpr fsize RADIX_THRESHOLD = 256;
+            constexpr fsize PARALLEL_THRESHOLD = 32768;
+            constexpr fsize PARALLEL_GRAIN = 4096;
+
+            template <typename T>
+            class Scratch
+            {
+            private:
+                T *_mem;
+                fsize _size;
+
+            public:
+                explicit inline Scratch(const fsize size)
+                    : _mem(memory::MemUtils::NewArray<T>(size))
+                    , _size(size)
+                {
+                }
+
+                inline ~Scratch()
+                {
+                    memory::MemUtils::DeleteArray(_mem, _size);
+                }
+
+                Scratch(const Scratch<T> &other) = delete;
+                Scratch<T> &operator=(const Scratch<T> &other) = delete;
+
+                inline T *operator*() noexcept
+                {
+                    return (_mem);
+                }
+            };
+
+            template <typename T>
+            inline void Swap(T &a, T &b)
+            {
+                T tmp = std::move(a);
+                a = std::move(b);
+                b = std::move(tmp);
+            }
+
+            template <typename T>
+            inline void Reverse(T *begin, T *end)
+            {
+                while (begin < end)
+                    Swap(*begin++, *--end);
+            }
+
+            inline int Log2(fsize n)
+            {
+                int res = 0;
+                while (n >>= 1)
+                    ++res;
+                return (res);
+            }
+
+            template <template <typename> class Comparator, typename T>
+            void InsertionSort(T *begin, T *end)
+            {
+                if (begin == end)
+                    return;
+                for (T *cur = begin + 1; cur != end; ++cur)
+                {
+                    T *sift = cur;
+                    T *sift1 = cur - 1;
+                    if (Comparator<T>::Eval(*sift, *sift1))
+                    {
+                        T tmp = std::move(*sift);
+                        do
+                        {
+                            *sift-- = std::move(*sift1);
+                        } while (sift != begin && Comparator<T>::Eval(tmp, *--sift1));
+                        *sift = std::move(tmp);
+                    }
+                }
+            }
+
+            /**
+             * Insertion sort without bound check: *(begin - 1) must not be greater than any element of the range
+             */
+            template <template <typename> class Comparator, typename T>
+            void UnguardedInsertionSort(T *begin, T *end)
+            {
+                if (begin == end)
+                    return;
+                for (T *cur = begin + 1; cur != end; ++cur)
+                {
+                    T *sift = cur;
+                    T *sift1 = cur - 1;
+                    if (Comparator<T>::Eval(*sift, *sift1))
+                    {
+                        T tmp = std::move(*sift);
+                        do
+                        {
+                            *sift-- = std::move(*sift1);
+                        } while (Comparator<T>::Eval(tmp, *--sift1));
+                        *sift = std::move(tmp);
+                    }
+                }
+            }
+
+            /**
+             * Insertion sort giving up once more than PARTIAL_INSERTION_LIMIT elements were moved
+             * @return true if the range is sorted
+             */
+            template <template <typename> class Comparator, typename T>
+            bool PartialInsertionSort(T *begin, T *end)
+            {
+                if (begin == end)
+                    return (true);
+                fsize moved = 0;
+                for (T *cur = begin + 1; cur != end; ++cur)
+                {
+                    T *sift = cur;
+                    T *sift1 = cur - 1;
+                    if (Comparator<T>::Eval(*sift, *sift1))
+                    {
+                        T tmp = std::move(*sift);
+                        do
+                        {
+                            *sift-- = std::move(*sift1);
+                        } while (sift != begin && Comparator<T>::Eval(tmp, *--sift1));
+                        *sift = std::move(tmp);
+                        moved += static_cast<fsize>(cur - sift);
+                    }
+                    if (moved > PARTIAL_INSERTION_LIMIT)
+                        return (false);
+                }
+                return (true);
+            }
+
+            template <template <typename> class Comparator, typename T>
+            inline void Sort2(T *a, T *b)
+            {
+                if (Comparator<T>::Eval(*b, *a))
+                    Swap(*a, *b);
+            }
+
+            template <template <typename> class Comparator, typename T>
+            inline void Sort3(T *a, T *b, T *c)
+            {
+                Sort2<Comparator>(a, b);
+                Sort2<Comparator>(b, c);
+                Sort2<Comparator>(a, b);
+            }
+
+            template <template <typename> class Comparator, typename T>
+            void SiftDown(T *data, fsize root, const fsize count)
+            {
+                T tmp = std::move(data[root]);
+                while (true)
+                {
+                    fsize child = 2 * root + 1;
+                    if (child >= count)
+                        break;
+                    if (child + 1 < count && Comparator<T>::Eval(data[child], data[child + 1]))
+                        ++child;
+                    if (!Comparator<T>::Eval(tmp, data[child]))
+                        break;
+                    data[root] = std::move(data[child]);
+                    root = child;
+                }
+                data[root] = std::move(tmp);
+            }
+
+            template <template <typename> class Comparator, typename T>
+            void HeapSort(T *begin, T *end)
+            {
+                fsize count = static_cast<fsize>(end - begin);
+                for (fsize i = count / 2; i > 0; --i)
+                    SiftDown<Comparator>(begin, i - 1, count);
+                for (fsize i = count - 1; i > 0; --i)
+                {
+                    Swap(begin[0], begin[i]);
+                    SiftDown<Comparator>(begin, 0, i);
+                }
+            }
+
+            /**
+             * Partitions around the pivot *begin, elements equal to the pivot go right.
+             * The median selection guarantees an element not less than the pivot exists at the end of the range
+             */
+            template <template <typename> class Comparator, typename T>
+            T *PartitionRight(T *begin, T *end, bool &alreadyPartitioned)
+            {
+                T pivot = std::move(*begin);
+                T *first = begin;
+                T *last = end;
+
+                while (Comparator<T>::Eval(*++first, pivot))
+                    ;
+                if (first - 1 == begin)
+                {
+                    while (first < last && !Comparator<T>::Eval(*--last, pivot))
+                        ;
+                }
+                else
+                {
+                    while (!Comparator<T>::Eval(*--last, pivot))
+                        ;
+                }
+                alreadyPartitioned = first >= last;
+                while (first < last)
+                {
+                    Swap(*first, *last);
+                    while (Comparator<T>::Eval(*++first, pivot))
+                        ;
+                    while (!Comparator<T>::Eval(*--last, pivot))
+                        ;
+                }
+                T *pivotPos = first - 1;
+                *begin = std::move(*pivotPos);
+                *pivotPos = std::move(pivot);
+                return (pivotPos);
+            }
+
+            /**
+             * Partitions around the pivot *begin, elements equal to the pivot go left.
+             * Only used when the element before the range equals the pivot, the left part is then already sorted
+             */
+            template <template <typename> class Comparator, typename T>
+            T *PartitionLeft(T *begin, T *end)
+            {
+                T pivot = std::move(*begin);
+                T *first = begin;
+                T *last = end;
+
+                while (Comparator<T>::Eval(pivot, *--last))
+                    ;
+                if (last + 1 == end)
+                {
+                    while (first < last && !Comparator<T>::Eval(pivot, *++first))
+                        ;
+                }
+                else
+                {
+                    while (!Comparator<T>::Eval(pivot, *++first))
+                        ;
+                }
+                while (first < last)
+                {
+                    Swap(*first, *last);
+                    while (Comparator<T>::Eval(pivot, *--last))
+                        ;
+                    while (!Comparator<T>::Eval(pivot, *++first))
+                        ;
+                }
+                T *pivotPos = last;
+                *begin = std::move(*pivotPos);
+                *pivotPos = std::move(pivot);
+                return (pivotPos);
+            }
+
+            template <template <typename> class Comparator, typename T>
+            void PdqSort(T *begin, T *end, int badAllowed, bool leftmost)
+            {
+                while (true)
+                {
+                    fsize size = static_cast<fsize>(end - begin);
+                    if (size < INSERTION_THRESHOLD)
+                    {
+                        if (leftmost)
+                            InsertionSort<Comparator>(begin, end);
+                        else
+                            UnguardedInsertionSort<Comparator>(begin, end);
+                        return;
+                    }
+                    fsize half = size / 2;
+                    if (size > NINTHER_THRESHOLD)
+                    {
+                        Sort3<Comparator>(begin, begin + half, end - 1);
+                        Sort3<Comparator>(begin + 1, begin + (half - 1), end - 2);
+                        Sort3<Comparator>(begin + 2, begin + (half + 1), end - 3);
+                        Sort3<Comparator>(begin + (half - 1), begin + half, begin + (half + 1));
+                        Swap(*begin, *(begin + half));
+                    }
+                    else
+                        Sort3<Comparator>(begin + half, begin, end - 1);
+                    if (!leftmost && !Comparator<T>::Eval(*(begin - 1), *begin))
+                    {
+                        begin = PartitionLeft<Comparator>(begin, end) + 1;
+                        continue;
+                    }
+                    bool alreadyPartitioned;
+                    T *pivotPos = PartitionRight<Comparator>(begin, end, alreadyPartitioned);
+                    fsize lsize = static_cast<fsize>(pivotPos - begin);
+                    fsize rsize = static_cast<fsize>(end - (pivotPos + 1));
+                    if (lsize < size / 8 || rsize < size / 8)
+                    {
+                        if (--badAllowed == 0)
+                        {
+                            HeapSort<Comparator>(begin, end);
+                            return;
+                        }
+                        // Break patterns which may have caused the bad partition
+                        if (lsize >= INSERTION_THRESHOLD)
+                        {
+                            Swap(*begin, *(begin + lsize / 4));
+                            Swap(*(pivotPos - 1), *(pivotPos - lsize / 4));
+                            if (lsize > NINTHER_THRESHOLD)
+                            {
+                                Swap(*(begin + 1), *(begin + (lsize / 4 + 1)));
+                                Swap(*(begin + 2), *(begin + (lsize / 4 + 2)));
+                                Swap(*(pivotPos - 2), *(pivotPos - (lsize / 4 + 1)));
+                                Swap(*(pivotPos - 3), *(pivotPos - (lsize / 4 + 2)));
+                            }
+                        }
+                        if (rsize >= INSERTION_THRESHOLD)
+                        {
+                            Swap(*(pivotPos + 1), *(pivotPos + (1 + rsize / 4)));
+                            Swap(*(end - 1), *(end - rsize / 4));
+                            if (rsize > NINTHER_THRESHOLD)
+                            {
+                                Swap(*(pivotPos + 2), *(pivotPos + (2 + rsize / 4)));
+                                Swap(*(pivotPos + 3), *(pivotPos + (3 + rsize / 4)));
+                                Swap(*(end - 2), *(end - (1 + rsize / 4)));
+                                Swap(*(end - 3), *(end - (2 + rsize / 4)));
+                            }
+                        }
+                    }
+                    else if (alreadyPartitioned && PartialInsertionSort<Comparator>(begin, pivotPos)
+                             && PartialInsertionSort<Comparator>(pivotPos + 1, end))
+                        return;
+                    PdqSort<Comparator>(begin, pivotPos, badAllowed, leftmost);
+                    begin = pivotPos + 1;
+                    leftmost = false;
+                }
+            }
+
+            /**
+             * Merges the sorted runs [first, mid) and [mid, last); the smallest run is moved to the scratch buffer
+             */
+            template <template <typename> class Comparator, typename T>
+            void MergeRuns(T *first, T *mid, T *last, T *scratch)
+            {
+                if (!Comparator<T>::Eval(*mid, *(mid - 1)))
+                    return;
+                // Leading left elements not after *mid and trailing right elements not before *(mid - 1) are in place
+                fsize lo = 0;
+                fsize hi = static_cast<fsize>(mid - first);
+                while (lo < hi)
+                {
+                    fsize m = lo + (hi - lo) / 2;
+                    if (Comparator<T>::Eval(*mid, first[m]))
+                        hi = m;
+                    else
+                        lo = m + 1;
+                }
+                first += lo;
+                lo = 0;
+                hi = static_cast<fsize>(last - mid);
+                while (lo < hi)
+                {
+                    fsize m = lo + (hi - lo) / 2;
+                    if (Comparator<T>::Eval(mid[m], *(mid - 1)))
+                        lo = m + 1;
+                    else
+                        hi = m;
+                }
+                last = mid + lo;
+                fsize n1 = static_cast<fsize>(mid - first);
+                fsize n2 = static_cast<fsize>(last - mid);
+                if (n1 <= n2)
+                {
+                    for (fsize i = 0; i != n1; ++i)
+                        scratch[i] = std::move(first[i]);
+                    T *l = scratch;
+                    T *lend = scratch + n1;
+                    T *r = mid;
+                    T *out = first;
+                    while (l != lend && r != last)
+                    {
+                        if (Comparator<T>::Eval(*r, *l))
+                            *out++ = std::move(*r++);
+                        else
+                            *out++ = std::move(*l++);
+                    }
+                    while (l != lend)
+                        *out++ = std::move(*l++);
+                }
+                else
+                {
+                    for (fsize i = 0; i != n2; ++i)
+                        scratch[i] = std::move(mid[i]);
+                    T *l = mid;
+                    T *r = scratch + n2;
+                    T *out = last;
+                    while (l != first && r != scratch)
+                    {
+                        if (Comparator<T>::Eval(*(r - 1), *(l - 1)))
+                            *--out = std::move(*--l);
+                        else
+                            *--out = std::move(*--r);
+                    }
+                    while (r != scratch)
+                        *--out = std::move(*--r);
+                }
+            }
+
+            template <template <typename> class Comparator, typename T>
+            void MergeSort(T *data, const fsize count, T *scratch)
+            {
+                if (count < 2)
+                    return;
+                fsize desc = 1;
+                while (desc < count && Comparator<T>::Eval(data[desc], data[desc - 1]))
+                    ++desc;
+                if (desc == count)
+                {
+                    Reverse(data, data + count);
+                    return;
+                }
+                for (fsize start = 0; start < count; start += STABLE_RUN)
+                    InsertionSort<Comparator>(data + start, data + (count - start < STABLE_RUN ? count : start + STABLE_RUN));
+                for (fsize width = STABLE_RUN; width < count; width *= 2)
+                {
+                    for (fsize start = 0; start + width < count; start += 2 * width)
+                    {
+                        fsize end = count - start - width < width ? count : start + 2 * width;
+                        MergeRuns<Comparator>(data + start, data + start + width, data + end, scratch);
+                    }
+                }
+            }
+
+            template <typename T, bool Integer = std::is_integral<T>::value && !std::is_same<T, bool>::value,
+                      bool Float = std::is_floating_point<T>::value && (sizeof(T) == 4 || sizeof(T) == 8)>
+            class RadixKey
+            {
+            public:
+                static constexpr bool SUPPORTED = false;
+                static constexpr bool STABLE = false;
+                using Key = uint8;
+            };
+
+            template <typename T>
+            class RadixKey<T, true, false>
+            {
+            public:
+                static constexpr bool SUPPORTED = true;
+                static constexpr bool STABLE = true;
+                using Key = typename std::make_unsigned<T>::type;
+
+                inline static Key Get(const T value) noexcept
+                {
+                    // Flipping the sign bit maps signed order onto unsigned order
+                    return (std::is_signed<T>::value ? static_cast<Key>(static_cast<Key>(value) ^ (static_cast<Key>(1) << (sizeof(T) * 8 - 1)))
+                                                     : static_cast<Key>(value));
+                }
+            };
+
+            template <typename T>
+            class RadixKey<T, false, true>
+            {
+            public:
+                static constexpr bool SUPPORTED = true;
+                // -0.0 and 0.0 compare equal but are ordered by their bits
+                static constexpr bool STABLE = false;
+                using Key = typename std::conditional<sizeof(T) == 4, uint32, uint64>::type;
+
+                inline static Key Get(const T value) noexcept
+                {
+                    Key bits;
+                    std::memcpy(&bits, &value, sizeof(T));
+                    constexpr Key sign = static_cast<Key>(1) << (sizeof(T) * 8 - 1);
+                    return ((bits & sign) ? static_cast<Key>(~bits) : static_cast<Key>(bits | sign));
+                }
+            };
+
+            template <typename T>
+            void RadixSort(T *data, const fsize count, T *scratch)
+            {
+                using Key = typename RadixKey<T>::Key;
+                constexpr fsize PASSES = sizeof(Key);
+                fsize counts[PASSES][256];
+
+                std::memset(counts, 0, sizeof(counts));
+                for (fsize i = 0; i != count; ++i)
+                {
+                    Key key = RadixKey<T>::Get(data[i]);
+                    for (fsize p = 0; p != PASSES; ++p)
+                        ++counts[p][(key >> (p * 8)) & 0xFF];
+                }
+                T *src = data;
+                T *dst = scratch;
+                for (fsize p = 0; p != PASSES; ++p)
+                {
+                    fsize *offsets = counts[p];
+                    // A digit shared by all elements does not reorder anything
+                    if (offsets[(RadixKey<T>::Get(src[0]) >> (p * 8)) & 0xFF] == count)
+                        continue;
+                    fsize sum = 0;
+                    for (fsize d = 0; d != 256; ++d)
+                    {
+                        fsize c = offsets[d];
+                        offsets[d] = sum;
+                        sum += c;
+                    }
+                    for (fsize i = 0; i != count; ++i)
+                        dst[offsets[(RadixKey<T>::Get(src[i]) >> (p * 8)) & 0xFF]++] = src[i];
+                    T *tmp = src;
+                    src = dst;
+                    dst = tmp;
+                }
+                if (src != data)
+                    std::memcpy(data, src, count * sizeof(T));
+            }
+
+            template <typename T, template <typename> class Comparator>
+            class RadixDispatch
+            {
+            public:
+                static constexpr bool ASCENDING = std::is_same<Comparator<T>, ops::Less<T>>::value;
+                static constexpr bool DESCENDING = std::is_same<Comparator<T>, ops::Greater<T>>::value;
+                static constexpr bool UNSTABLE = RadixKey<T>::SUPPORTED && (ASCENDING || DESCENDING);
+                static constexpr bool STABLE = UNSTABLE && RadixKey<T>::STABLE;
+            };
+
+            template <bool Enable>
+            class RadixSorter
+            {
+            public:
+                template <template <typename> class Comparator, typename T>
+                inline static bool Run(T *, fsize)
+                {
+                    return (false);
+                }
+            };
+
+            template <>
+            class RadixSorter<true>
+            {
+            public:
+                template <template <typename> class Comparator, typename T>
+                static bool Run(T *data, const fsize count)
+                {
+                    if (count < RADIX_THRESHOLD)
+                        return (false);
+                    Scratch<T> scratch(count);
+                    RadixSort(data, count, *scratch);
+                    if (RadixDispatch<T, Comparator>::DESCENDING)
+                        Reverse(data, data + count);
+                    return (true);
+                }
+            };
+
+            /**
+             * Finds how many elements of a come before output position pos when merging a and b;
+             * on equal elements a goes first
+             */
+            template <template <typename> class Comparator, typename T>
+            fsize CoRank(const fsize pos, const T *a, const fsize n1, const T *b, const fsize n2)
+            {
+                fsize lo = pos > n2 ? pos - n2 : 0;
+                fsize hi = pos < n1 ? pos : n1;
+                while (lo < hi)
+                {
+                    fsize i = lo + (hi - lo) / 2;
+                    fsize j = pos - i;
+                    if (j > 0 && !Comparator<T>::Eval(b[j - 1], a[i]))
+                        lo = i + 1;
+                    else
+                        hi = i;
+                }
+                return (lo);
+            }
+
+            /**
+             * Produces the output positions [start, end) of a merge round with runs of width elements
+             */
+            template <template <typename> class Comparator, typename T>
+            void MergeSlice(T *src, T *dst, const fsize count, const fsize width, const fsize start, const fsize end)
+            {
+                for (fsize pair = start - start % (2 * width); pair < end; pair += 2 * width)
+                {
+                    fsize mid = count - pair < width ? count : pair + width;
+                    fsize last = count - pair < 2 * width ? count : pair + 2 * width;
+                    fsize lo = start > pair ? start : pair;
+                    fsize hi = end < last ? end : last;
+                    T *a = src + pair;
+                    T *b = src + mid;
+                    fsize n1 = mid - pair;
+                    fsize n2 = last - mid;
+                    fsize i = CoRank<Comparator>(lo - pair, a, n1, b, n2);
+                    fsize j = lo - pair - i;
+                    fsize iend = CoRank<Comparator>(hi - pair, a, n1, b, n2);
+                    fsize jend = hi - pair - iend;
+                    T *out = dst + lo;
+                    while (i < iend && j < jend)
+                    {
+                        if (Comparator<T>::Eval(b[j], a[i]))
+                            *out++ = std::move(b[j++]);
+                        else
+                            *out++ = std::move(a[i++]);
+                    }
+                    while (i < iend)
+                        *out++ = std::move(a[i++]);
+                    while (j < jend)
+                        *out++ = std::move(b[j++]);
+                }
+            }
+        }
+
+        template <template <typename> class Comparator, typename T>
+        void Sorting::Unstable(T *data, const fsize count)
+        {
+            if (count < 2)
+                return;
+            if (_bpf_internal_sort::RadixSorter<_bpf_internal_sort::RadixDispatch<T, Comparator>::UNSTABLE>::template Run<Comparator>(data, count))
+                return;
+            _bpf_internal_sort::PdqSort<Comparator>(data, data + count, _bpf_internal_sort::Log2(count), true);
+        }
+
+        template <template <typename> class Comparator, typename T>
+        void Sorting::Stable(T *data, const fsize count)
+        {
+            if (count < 2)
+                return;
+            if (_bpf_internal_sort::RadixSorter<_bpf_internal_sort::RadixDispatch<T, Comparator>::STABLE>::template Run<Comparator>(data, count))
+                return;
+            if (count <= _bpf_internal_sort::STABLE_RUN)
+            {
+                _bpf_internal_sort::InsertionSort<Comparator>(data, data + count);
+                return;
+            }
+            _bpf_internal_sort::Scratch<T> scratch(count / 2 + 1);
+            _bpf_internal_sort::MergeSort<Comparator>(data, count, *scratch);
+        }
+
+        template <template <typename> class Comparator, typename T>
+        void Sorting::Stable(T *data, const fsize count, T *scratch)
+        {
+            _bpf_internal_sort::MergeSort<Comparator>(data, count, scratch);
+        }
+
+        template <typename T>
+        void Sorting::Radix(T *data, const fsize count, T *scratch)
+        {
+            static_assert(_bpf_internal_sort::RadixKey<T>::SUPPORTED, "Radix sort requires integer or floating point elements");
+            if (count < 2)
+                return;
+            _bpf_internal_sort::RadixSort(data, count, scratch);
+        }
+
+        template <typename T>
+        void Sorting::Radix(T *data, const fsize count)
+        {
+            static_assert(_bpf_internal_sort::RadixKey<T>::SUPPORTED, "Radix sort requires integer or floating point elements");
+            if (count < 2)
+                return;
+            _bpf_internal_sort::Scratch<T> scratch(count);
+            _bpf_internal_sort::RadixSort(data, count, *scratch);
+        }
+
+        template <template <typename> class Comparator, typename Pool, typename T>
+        void Sorting::Parallel(Pool &pool, T *data, const fsize count, const bool stable)
+        {
+            fsize parts = pool.GetThreadCount() + 1;
+            if (count < _bpf_internal_sort::PARALLEL_THRESHOLD || parts < 2)
+            {
+                if (stable)
+                    Stable<Comparator>(data, count);
+                else
+                    Unstable<Comparator>(data, count);
+                return;
+            }
+            fsize block = (count + parts - 1) / parts;
+            pool.ParallelFor(parts, [&](fsize start, fsize end) {
+                for (fsize b = start; b != end && b * block < count; ++b)
+                {
+                    fsize size = count - b * block < block ? count - b * block : block;
+                    if (stable)
+                        Stable<Comparator>(data + b * block, size);
+                    else
+                        Unstable<Comparator>(data + b * block, size);
+                }
+            }, 1);
+            _bpf_internal_sort::Scratch<T> scratch(count);
+            T *src = data;
+            T *dst = *scratch;
+            fsize grain = count / parts > _bpf_internal_sort::PARALLEL_GRAIN ? count / parts : _bpf_internal_sort::PARALLEL_GRAIN;
+            for (fsize width = block; width < count; width *= 2)
+            {
+                pool.ParallelFor(count, [&](fsize start, fsize end) {
+                    _bpf_internal_sort::MergeSlice<Comparator>(src, dst, count, width, start, end);
+                }, grain);
+                T *tmp = src;
+                src = dst;
+                dst = tmp;
+            }
+            if (src != data)
+            {
+                pool.ParallelFor(count, [&](fsize start, fsize end) {
+                    for (fsize i = start; i != end; ++i)
+                        data[i] = std::move(src[i]);
+                }, grain);
+            }
+        }
+    }
+}
@@ -35,12 +35,13 @@ namespace bpf
     /**
      * Provides string representation to all List types
      * @tparam T the type of item to store
+     * @tparam Allocator the node allocation policy
      */
-    template <typename T>
-    class String::Stringifier<collection::List<T>>
+    template <typename T, template <typename> class Allocator>
+    class String::Stringifier<collection::List<T, Allocator>>
     {
     public:
-        inline static String Stringify(const collection::List<T> &lst, const fsize prec = 0)
+        inline static String Stringify(const collection::List<T, Allocator> &lst, const fsize prec = 0)
         {
             String res = "[";
 
@@ -38,12 +38,13 @@ namespace bpf
      * @tparam V the value type
      * @tparam Greater the greater than operator
      * @tparam Less the less than operator
+     * @tparam Allocator the node allocation policy
      */
-    template <typename K, typename V, template <typename T> class Greater, template <typename T> class Less>
-    class String::Stringifier<collection::Map<K, V, Greater, Less>>
+    template <typename K, typename V, template <typename T> class Greater, template <typename T> class Less, template <typename T> class Allocator>
+    class String::Stringifier<collection::Map<K, V, Greater, Less, Allocator>>
     {
     public:
-        inline static String Stringify(const collection::Map<K, V, Greater, Less> &map, const fsize prec = 0)
+        inline static String Stringify(const collection::Map<K, V, Greater, Less, Allocator> &map, const fsize prec = 0)
         {
             String res = "{";
             fsize i = 0;
@@ -30,12 +30,15 @@
 #include "Framework/Memory/ClassCastException.hpp"
 #include "Framework/Memory/MemUtils.hpp"
 #include "Framework/TypeInfo.hpp"
+#include <new>
+#include <type_traits>
 #include <utility>
 
 namespace bpf
 {
     /**
-     * Cross platform dynamic variable type
+     * Cross platform dynamic variable type.
+     * Trivially copyable values of at most 16 bytes are stored inline without allocating
      */
     class BPF_API Dynamic
     {
@@ -104,14 +107,89 @@ namespace bpf
             }
         };
 
-        Storage *_storage;
+        /**
+         * Type information of values stored inline
+         */
+        struct InlineType
+        {
+            fsize (*TypeId)() noexcept;
+            const char *(*TypeName)() noexcept;
+            bool (*Equals)(const void *a, const void *b);
+        };
+
+        template <typename T>
+        inline static bool InlineEquals(const void *a, const void *b)
+        {
+            return (*static_cast<const T *>(a) == *static_cast<const T *>(b));
+        }
+
+        template <typename T>
+        inline static const InlineType *GetInlineType() noexcept
+        {
+            static const InlineType type = {&TypeIndex<T>, &TypeName<T>, &InlineEquals<T>};
+            return (&type);
+        }
+
+        /**
+         * Number of bytes available to store small trivially copyable values without allocating
+         */
+        static constexpr fsize INLINE_SIZE = 16;
+
+        template <typename T>
+        using StorageKind = std::integral_constant<int, std::is_same<std::nullptr_t, T>::value ? 0
+                                                        : (std::is_trivially_copyable<T>::value && sizeof(T) <= INLINE_SIZE
+                                                           && alignof(T) <= alignof(uint64)) ? 1 : 2>;
+
+        // Non null when the value is stored in _inline
+        const InlineType *_type;
+        union
+        {
+            Storage *_storage;
+            alignas(uint64) uint8 _inline[INLINE_SIZE];
+        };
+
+        template <typename T, typename Q>
+        inline void Store(Q &&, std::integral_constant<int, 0>) noexcept
+        {
+            _type = nullptr;
+            _storage = nullptr;
+        }
+
+        template <typename T, typename Q>
+        inline void Store(Q &&value, std::integral_constant<int, 1>) noexcept
+        {
+            new (_inline) T(std::forward<Q>(value));
+            _type = GetInlineType<T>();
+        }
+
+        template <typename T, typename Q>
+        inline void Store(Q &&value, std::integral_constant<int, 2>)
+        {
+            _type = nullptr;
+            _storage = memory::MemUtils::New<DynamicStorage<T>>(std::forward<Q>(value));
+        }
+
+        void Reset() noexcept;
+        void CopyFrom(const Dynamic &other);
+        void MoveFrom(Dynamic &other) noexcept;
+
+        inline void *Data() const noexcept
+        {
+            return (_type != nullptr ? const_cast<uint8 *>(_inline) : _storage->DataPtr);
+        }
+
+        inline bool IsNull() const noexcept
+        {
+            return (_type == nullptr && _storage == nullptr);
+        }
 
     public:
         /**
          * Constructs a null dynamic
          */
         inline Dynamic()
-            : _storage(nullptr)
+            : _type(nullptr)
+            , _storage(nullptr)
         {
         }
 
@@ -119,17 +197,18 @@ namespace bpf
          * Copy constructor
          */
         inline Dynamic(const Dynamic &other)
-            : _storage(other._storage == nullptr ? nullptr : other._storage->Clone())
+            : _type(nullptr)
+            , _storage(nullptr)
         {
+            CopyFrom(other);
         }
 
         /**
          * Move constructor
          */
         inline Dynamic(Dynamic &&other) noexcept
-            : _storage(other._storage)
         {
-            other._storage = nullptr;
+            MoveFrom(other);
         }
 
         /**
@@ -140,10 +219,7 @@ namespace bpf
         template <typename T>
         inline Dynamic(const T &other, typename std::enable_if<!std::is_same<T, Dynamic>::value>::type * = 0)
         {
-            if (std::is_same<std::nullptr_t, typename std::remove_cv<T>::type>::value)
-                _storage = nullptr;
-            else
-                _storage = memory::MemUtils::New<DynamicStorage<T>>(other);
+            Store<T>(other, StorageKind<T>());
         }
 
         /**
@@ -154,10 +230,8 @@ namespace bpf
         template <typename T>
         inline Dynamic(T &&other, typename std::enable_if<!std::is_same<T, Dynamic &>::value>::type * = 0)
         {
-            if (std::is_same<std::nullptr_t, typename std::remove_cv<T>::type>::value)
-                _storage = nullptr;
-            else
-                _storage = memory::MemUtils::New<DynamicStorage<T>>(std::forward<T>(other));
+            using Type = typename std::decay<T>::type;
+            Store<Type>(std::forward<T>(other), StorageKind<Type>());
         }
 
         ~Dynamic();
@@ -168,6 +242,8 @@ namespace bpf
          */
         inline fsize TypeId() const noexcept
         {
+            if (_type != nullptr)
+                return (_type->TypeId());
             return (_storage == nullptr ? 0 : _storage->TypeId);
         }
 
@@ -190,14 +266,8 @@ namespace bpf
         template <typename T>
         inline Dynamic &operator=(const T &other)
         {
-            if (std::is_same<std::nullptr_t, typename std::remove_cv<T>::type>::value)
-            {
-                memory::MemUtils::Delete(_storage);
-                _storage = nullptr;
-                return (*this);
-            }
-            memory::MemUtils::Delete(_storage);
-            _storage = memory::MemUtils::New<DynamicStorage<T>>(other);
+            Reset();
+            Store<T>(other, StorageKind<T>());
             return (*this);
         }
 
@@ -210,14 +280,9 @@ namespace bpf
         template <typename T>
         inline typename std::enable_if<!std::is_same<T, Dynamic &>::value, Dynamic &>::type operator=(T &&other)
         {
-            if (std::is_same<std::nullptr_t, typename std::remove_cv<T>::type>::value)
-            {
-                memory::MemUtils::Delete(_storage);
-                _storage = nullptr;
-                return (*this);
-            }
-            memory::MemUtils::Delete(_storage);
-            _storage = memory::MemUtils::New<DynamicStorage<T>>(std::forward<T>(other));
+            using Type = typename std::decay<T>::type;
+            Reset();
+            Store<Type>(std::forward<T>(other), StorageKind<Type>());
             return (*this);
         }
 
@@ -244,12 +309,13 @@ namespace bpf
         template <typename T>
         explicit inline operator T &()
         {
-            if (_storage == nullptr)
+            if (IsNull())
                 throw memory::ClassCastException("Cannot cast null object");
             if (TypeIndex<T>() != TypeId())
-                throw memory::ClassCastException(String("Cannot cast from ") + _storage->GetTypeName() + " to " +
-                                                 TypeName<T>());
-            return (*reinterpret_cast<T *>(_storage->DataPtr));
+                throw memory::ClassCastException(String("Cannot cast from ")
+                                                 + (_type != nullptr ? _type->TypeName() : _storage->GetTypeName())
+                                                 + " to " + TypeName<T>());
+            return (*reinterpret_cast<T *>(Data()));
         }
 
         /**
@@ -261,12 +327,13 @@ namespace bpf
         template <typename T>
         explicit inline operator const T &() const
         {
-            if (_storage == nullptr)
+            if (IsNull())
                 throw memory::ClassCastException("Cannot cast null object");
             if (TypeIndex<T>() != TypeId())
-                throw memory::ClassCastException(String("Cannot cast from ") + _storage->GetTypeName() + " to " +
-                                                 TypeName<T>());
-            return (*reinterpret_cast<T *>(_storage->DataPtr));
+                throw memory::ClassCastException(String("Cannot cast from ")
+                                                 + (_type != nullptr ? _type->TypeName() : _storage->GetTypeName())
+                                                 + " to " + TypeName<T>());
+            return (*reinterpret_cast<T *>(Data()));
         }
     };
 }
@@ -0,0 +1,261 @@
+// Copyright (c) 2020, BlockProject 3D
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without modification,
+// are permitted provided that the following conditions are met:
+// 
+//     * Redistributions of source code must retain the above copyright notice,
+//       this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above copyright notice,
+//       this list of conditions and the following disclaimer in the documentation
+//       and/or other materials provided with the distribution.
+//     * Neither the name of BlockProject 3D nor the names of its contributors
+//       may be used to endorse or promote products derived from this software
+//       without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#pragma once
+#include "Framework/Memory/MemUtils.hpp"
+#include "Framework/RuntimeException.hpp"
+#include "Framework/Types.hpp"
+#include <cstddef>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace bpf
+{
+    /**
+     * Move-only function wrapper storing small callables inline
+     * @tparam Fn the function signature (using functional-like notation)
+     * @tparam InlineSize the number of bytes available to store a callable without allocating
+     */
+    template <typename Fn, fsize InlineSize = 4 * sizeof(void *)>
+    class BP_TPL_API Function;
+
+    /**
+     * Move-only function wrapper storing small callables inline.
+     * Callables of at most InlineSize bytes with a non throwing move constructor are stored inside the Function
+     * itself, larger ones are allocated on the heap
+     * @tparam R the return type
+     * @tparam Args the argument types
+     * @tparam InlineSize the number of bytes available to store a callable without allocating
+     */
+    template <typename R, typename... Args, fsize InlineSize>
+    class BP_TPL_API Function<R(Args...), InlineSize>
+    {
+    private:
+        static_assert(InlineSize >= sizeof(void *), "Function inline storage must at least hold a pointer");
+
+        enum class EOperation
+        {
+            MOVE,
+            DESTROY
+        };
+
+        using Invoker = R (*)(void *storage, Args &&... args);
+        using Manager = void (*)(EOperation op, void *dst, void *src);
+
+        template <typename F>
+        class InlineCallable
+        {
+        public:
+            static R Invoke(void *storage, Args &&... args)
+            {
+                return (static_cast<R>((*static_cast<F *>(storage))(std::forward<Args>(args)...)));
+            }
+
+            static void Manage(const EOperation op, void *dst, void *src)
+            {
+                F *f = static_cast<F *>(src);
+                if (op == EOperation::MOVE)
+                    new (dst) F(std::move(*f));
+                f->~F();
+            }
+        };
+
+        template <typename F>
+        class HeapCallable
+        {
+        public:
+            static R Invoke(void *storage, Args &&... args)
+            {
+                return (static_cast<R>((**static_cast<F **>(storage))(std::forward<Args>(args)...)));
+            }
+
+            static void Manage(const EOperation op, void *dst, void *src)
+            {
+                if (op == EOperation::MOVE)
+                    *static_cast<F **>(dst) = *static_cast<F **>(src);
+                else
+                    memory::MemUtils::Delete(*static_cast<F **>(src));
+            }
+        };
+
+        Invoker _invoke;
+        Manager _manage;
+        alignas(std::max_align_t) uint8 _storage[InlineSize];
+
+        template <typename T>
+        inline static bool IsNull(T *ptr) noexcept
+        {
+            return (ptr == nullptr);
+        }
+
+        template <typename T>
+        inline static bool IsNull(const T &) noexcept
+        {
+            return (false);
+        }
+
+        template <typename F, typename T>
+        inline void Store(T &&callable, std::true_type)
+        {
+            new (_storage) F(std::forward<T>(callable));
+            _invoke = &InlineCallable<F>::Invoke;
+            _manage = &InlineCallable<F>::Manage;
+        }
+
+        template <typename F, typename T>
+        inline void Store(T &&callable, std::false_type)
+        {
+            *reinterpret_cast<F **>(_storage) = memory::MemUtils::New<F>(std::forward<T>(callable));
+            _invoke = &HeapCallable<F>::Invoke;
+            _manage = &HeapCallable<F>::Manage;
+        }
+
+    public:
+        /**
+         * Checks if a callable type is stored without allocating
+         * @tparam F the type of callable
+         * @return true if F fits in the inline storage
+         */
+        template <typename F>
+        inline static constexpr bool IsStoredInline() noexcept
+        {
+            return (sizeof(F) <= InlineSize && alignof(F) <= alignof(std::max_align_t)
+                    && std::is_nothrow_move_constructible<F>::value);
+        }
+
+        /**
+         * Constructs a null function
+         */
+        inline Function() noexcept
+            : _invoke(nullptr)
+            , _manage(nullptr)
+        {
+        }
+
+        /**
+         * Constructs a null function
+         */
+        inline Function(std::nullptr_t) noexcept
+            : _invoke(nullptr)
+            , _manage(nullptr)
+        {
+        }
+
+        /**
+         * Constructs a function from a callable object, a lambda or a function pointer
+         * @tparam F the type of callable
+         * @param callable the callable to store
+         */
+        template <typename F, typename = typename std::enable_if<!std::is_same<typename std::decay<F>::type, Function>::value>::type>
+        inline Function(F &&callable)
+            : _invoke(nullptr)
+            , _manage(nullptr)
+        {
+            using Type = typename std::decay<F>::type;
+            if (IsNull(callable))
+                return;
+            Store<Type>(std::forward<F>(callable), std::integral_constant<bool, IsStoredInline<Type>()>());
+        }
+
+        /**
+         * Move constructor
+         */
+        inline Function(Function &&other) noexcept
+            : _invoke(other._invoke)
+            , _manage(other._manage)
+        {
+            if (_manage != nullptr)
+                _manage(EOperation::MOVE, _storage, other._storage);
+            other._invoke = nullptr;
+            other._manage = nullptr;
+        }
+
+        Function(const Function &other) = delete;
+
+        inline ~Function()
+        {
+            if (_manage != nullptr)
+                _manage(EOperation::DESTROY, nullptr, _storage);
+        }
+
+        /**
+         * Move assignment operator
+         */
+        inline Function &operator=(Function &&other) noexcept
+        {
+            if (this == &other)
+                return (*this);
+            if (_manage != nullptr)
+                _manage(EOperation::DESTROY, nullptr, _storage);
+            _invoke = other._invoke;
+            _manage = other._manage;
+            if (_manage != nullptr)
+                _manage(EOperation::MOVE, _storage, other._storage);
+            other._invoke = nullptr;
+            other._manage = nullptr;
+            return (*this);
+        }
+
+        Function &operator=(const Function &other) = delete;
+
+        /**
+         * Resets this function to null
+         */
+        inline Function &operator=(std::nullptr_t) noexcept
+        {
+            if (_manage != nullptr)
+                _manage(EOperation::DESTROY, nullptr, _storage);
+            _invoke = nullptr;
+            _manage = nullptr;
+            return (*this);
+        }
+
+        /**
+         * Conversion operator used to check if the function is valid
+         * @return true if this function is safe to be called, false otherwise
+         */
+        inline operator bool() const noexcept
+        {
+            return (_invoke != nullptr);
+        }
+
+        /**
+         * Invokes the function
+         * @param args the arguments to pass to the function
+         * @throw RuntimeException in case this function is null
+         * @return the return value of the function
+         */
+        inline R operator()(Args... args) const
+        {
+            if (_invoke == nullptr)
+                throw RuntimeException("Function", "Attempt to call null");
+            return (_invoke(const_cast<uint8 *>(_storage), std::forward<Args>(args)...));
+        }
+    };
+}
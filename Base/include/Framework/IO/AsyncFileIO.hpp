@@ -0,0 +1,212 @@
+// Copyright (c) 2020, BlockProject 3D
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without modification,
+// are permitted provided that the following conditions are met:
+// 
+//     * Redistributions of source code must retain the above copyright notice,
+//       this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above copyright notice,
+//       this list of conditions and the following disclaimer in the documentation
+//       and/or other materials provided with the distribution.
+//     * Neither the name of BlockProject 3D nor the names of its contributors
+//       may be used to endorse or promote products derived from this software
+//       without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#pragma once
+#include "Framework/Collection/HashMap.hpp"
+#include "Framework/Collection/List.hpp"
+#include "Framework/IO/FileStream.hpp"
+#include "Framework/IO/IOVector.hpp"
+#include "Framework/String.hpp"
+#include <functional>
+
+namespace bpf
+{
+    namespace io
+    {
+        class AsyncIOBackend;
+        struct AsyncIORequest;
+
+        /**
+         * Result of an asynchronous input/output operation
+         */
+        struct BPF_API AsyncIOResult
+        {
+            /**
+             * Identifier of the request as returned when it was queued
+             */
+            uint64 Id;
+
+            /**
+             * Number of bytes transferred
+             */
+            fsize Bytes;
+
+            /**
+             * True if the operation succeeded, false otherwise
+             */
+            bool Success;
+
+            /**
+             * System error message when the operation failed
+             */
+            String Error;
+        };
+
+        /**
+         * Asynchronous file input/output engine.
+         * Requests are positional reads and writes on FileStream objects; they are queued and submitted in batches to
+         * io_uring on Linux, or otherwise executed as pread/pwrite calls by a ThreadPool.
+         * Completion callbacks always run on the thread calling Poll or Wait.
+         * An AsyncFileIO must only be used from a single thread. Buffers and files must stay valid until the
+         * completion callback of the request has run
+         */
+        class BPF_API AsyncFileIO
+        {
+        public:
+            /**
+             * Callback invoked on completion of a request
+             */
+            using Callback = std::function<void(const AsyncIOResult &result)>;
+
+        private:
+            AsyncIOBackend *_backend;
+            fsize _fileQueueDepth;
+            uint64 _nextId;
+            fsize _inflight;
+            collection::List<AsyncIORequest *> _waiting;
+            collection::HashMap<fsize, fsize> _fileInflight;
+
+            uint64 Queue(FileStream &file, bool write, uint64 pos, const IOVector *buffers, fsize count, Callback &&callback);
+            fsize Complete(bool wait);
+
+        public:
+            /**
+             * Creates a new AsyncFileIO
+             * @param queueDepth the maximum number of requests in flight at the same time
+             * @param fileQueueDepth the maximum number of requests in flight at the same time on a single file
+             * @param threads the number of threads to use when io_uring is not available
+             * @param kernelQueue true to use io_uring when available, false to always use the ThreadPool backend
+             */
+            explicit AsyncFileIO(fsize queueDepth = 128, fsize fileQueueDepth = 32, fsize threads = 4, bool kernelQueue = true);
+
+            /**
+             * Waits for all requests to complete before destroying this AsyncFileIO
+             */
+            ~AsyncFileIO();
+
+            /**
+             * Cannot copy an AsyncFileIO
+             */
+            AsyncFileIO(const AsyncFileIO &other) = delete;
+
+            /**
+             * Cannot copy an AsyncFileIO
+             */
+            AsyncFileIO &operator=(const AsyncFileIO &other) = delete;
+
+            /**
+             * Queues a positional read
+             * @param file the file to read from
+             * @param pos position in bytes in the file to start reading at
+             * @param buf buffer to receive the read bytes
+             * @param size the size of the receiving buffer
+             * @param callback function to call on completion
+             * @return identifier of the request
+             */
+            uint64 Read(FileStream &file, uint64 pos, void *buf, fsize size, Callback callback);
+
+            /**
+             * Queues a positional scatter read
+             * @param file the file to read from
+             * @param pos position in bytes in the file to start reading at
+             * @param buffers the receiving buffers, the array itself is copied
+             * @param count the number of buffers
+             * @param callback function to call on completion
+             * @return identifier of the request
+             */
+            uint64 ReadV(FileStream &file, uint64 pos, const IOVector *buffers, fsize count, Callback callback);
+
+            /**
+             * Queues a positional write
+             * @param file the file to write to
+             * @param pos position in bytes in the file to start writing at
+             * @param buf the buffer with the bytes to write
+             * @param size the size of the buffer
+             * @param callback function to call on completion
+             * @return identifier of the request
+             */
+            uint64 Write(FileStream &file, uint64 pos, const void *buf, fsize size, Callback callback);
+
+            /**
+             * Queues a positional gather write
+             * @param file the file to write to
+             * @param pos position in bytes in the file to start writing at
+             * @param buffers the buffers to write, the array itself is copied
+             * @param count the number of buffers
+             * @param callback function to call on completion
+             * @return identifier of the request
+             */
+            uint64 WriteV(FileStream &file, uint64 pos, const IOVector *buffers, fsize count, Callback callback);
+
+            /**
+             * Submits as many queued requests as the queue depths allow in a single batch.
+             * Poll and Wait also submit queued requests
+             * @throw IOException in case of system error
+             * @return number of requests submitted
+             */
+            fsize Submit();
+
+            /**
+             * Runs the callbacks of all completed requests without blocking
+             * @throw IOException in case of system error
+             * @return number of completed requests
+             */
+            fsize Poll();
+
+            /**
+             * Blocks until at least count requests have completed, or no request is left, and runs their callbacks
+             * @param count the minimum number of requests to wait for
+             * @throw IOException in case of system error
+             * @return number of completed requests
+             */
+            fsize Wait(fsize count = 1);
+
+            /**
+             * Blocks until all requests have completed
+             * @throw IOException in case of system error
+             */
+            void WaitAll();
+
+            /**
+             * Returns the number of requests which have not yet completed
+             * @return number of requests queued or in flight
+             */
+            inline fsize GetPendingCount() const noexcept
+            {
+                return (_waiting.Size() + _inflight);
+            }
+
+            /**
+             * Returns true if requests are executed by the kernel (io_uring), false if they are executed by a
+             * ThreadPool
+             * @return true if io_uring is in use
+             */
+            bool IsKernelQueue() const noexcept;
+        };
+    }
+}
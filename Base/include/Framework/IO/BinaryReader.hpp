@@ -44,12 +44,16 @@ namespace bpf
         private:
             IInputStream &_stream;
             ByteBuf _buf;
+            const uint8 *_direct;
+            fsize _directSize;
+            fsize _directPos;
             system::EPlatformEndianess _targetorder;
             bool _buffered;
             EStringSerializer _serializer;
 
             uint8 ReadByte();
             bool ReadByte2(uint8 &out);
+            bool Refill();
             void ReadSubBuf(void *out, fsize size);
 
         public:
@@ -62,6 +66,9 @@ namespace bpf
             explicit inline BinaryReader(IInputStream &stream, system::EPlatformEndianess order = system::PLATFORM_LITTLEENDIAN, bool buffered = true)
                 : _stream(stream)
                 , _buf(READ_BUF_SIZE)
+                , _direct(nullptr)
+                , _directSize(0)
+                , _directPos(0)
                 , _targetorder(order)
                 , _buffered(buffered)
                 , _serializer(EStringSerializer::VARCHAR_32)
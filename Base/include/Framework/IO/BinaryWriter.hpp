@@ -88,6 +88,16 @@ namespace bpf
              */
             fsize Write(const void *buf, fsize bufsize) final;
 
+            /**
+             * Writes the raw bytes of a view to this stream, taking into account buffering
+             * @param view the bytes to write
+             * @return number of bytes written
+             */
+            inline fsize Write(const ByteView &view)
+            {
+                return (Write(*view, view.Size()));
+            }
+
             inline IDataOutputStream &operator<<(uint8 u) final
             {
                 WriteByte(u);
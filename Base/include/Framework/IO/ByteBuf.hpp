@@ -27,6 +27,7 @@
 // SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #pragma once
+#include "Framework/IO/ByteView.hpp"
 #include "Framework/IO/IInputStream.hpp"
 #include "Framework/IO/IOutputStream.hpp"
 #include "Framework/IndexException.hpp"
@@ -54,6 +55,12 @@ namespace bpf
              */
             explicit ByteBuf(fsize size);
 
+            /**
+             * Constructs a ByteBuf holding a copy of the bytes of a view
+             * @param view the bytes to copy
+             */
+            explicit ByteBuf(const ByteView &view);
+
             /**
              * Move constructor
              */
@@ -96,6 +103,41 @@ namespace bpf
 
             fsize Read(void *buf, fsize bufsize) final;
 
+            fsize ReadDirect(const uint8 *&data, fsize maxsize) final;
+
+            /**
+             * Writes the bytes of a view to this buffer
+             * @param view the bytes to write
+             * @return number of bytes written
+             */
+            inline fsize Write(const ByteView &view)
+            {
+                return (Write(*view, view.Size()));
+            }
+
+            /**
+             * Returns a view of the bytes written to this buffer
+             * @return new ByteView
+             */
+            inline ByteView View() const noexcept
+            {
+                return (ByteView(_buf, _written));
+            }
+
+            /**
+             * Returns a view of a range of this buffer
+             * @param pos the index of the first byte
+             * @param size the number of bytes
+             * @throw IndexException if the range is out of bounds
+             * @return new ByteView
+             */
+            inline ByteView View(const fsize pos, const fsize size) const
+            {
+                if (pos > _size || size > _size - pos)
+                    throw IndexException((fint)(pos + size));
+                return (ByteView(_buf + pos, size));
+            }
+
             /**
              * Returns a raw pointer to the beginning of this buffer
              * @return mutable pointer to the buffer start 
@@ -0,0 +1,165 @@
+// Copyright (c) 2020, BlockProject 3D
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without modification,
+// are permitted provided that the following conditions are met:
+// 
+//     * Redistributions of source code must retain the above copyright notice,
+//       this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above copyright notice,
+//       this list of conditions and the following disclaimer in the documentation
+//       and/or other materials provided with the distribution.
+//     * Neither the name of BlockProject 3D nor the names of its contributors
+//       may be used to endorse or promote products derived from this software
+//       without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#pragma once
+#include "Framework/IndexException.hpp"
+#include "Framework/Types.hpp"
+#include <cstring>
+
+namespace bpf
+{
+    namespace io
+    {
+        /**
+         * Non-owning read only slice of bytes (pointer and length).
+         * A ByteView never copies nor frees the bytes it references: the owner must keep them alive
+         */
+        class ByteView
+        {
+        private:
+            const uint8 *_data;
+            fsize _size;
+
+        public:
+            /**
+             * Constructs an empty ByteView
+             */
+            inline ByteView() noexcept
+                : _data(nullptr)
+                , _size(0)
+            {
+            }
+
+            /**
+             * Constructs a ByteView
+             * @param data pointer to the first byte
+             * @param size number of bytes
+             */
+            inline ByteView(const void *data, const fsize size) noexcept
+                : _data(reinterpret_cast<const uint8 *>(data))
+                , _size(size)
+            {
+            }
+
+            /**
+             * Returns a raw pointer to the beginning of this view
+             * @return immutable pointer to the first byte
+             */
+            inline const uint8 *operator*() const noexcept
+            {
+                return (_data);
+            }
+
+            /**
+             * Returns the number of bytes in this view
+             * @return size in bytes as unsigned
+             */
+            inline fsize Size() const noexcept
+            {
+                return (_size);
+            }
+
+            /**
+             * Checks if this view is empty
+             * @return true if this view has no bytes
+             */
+            inline bool IsEmpty() const noexcept
+            {
+                return (_size == 0);
+            }
+
+            /**
+             * Returns a byte at a given index
+             * @param id the index of the byte to get
+             * @throw IndexException if index out of bounds
+             * @return copy of the byte at index id
+             */
+            inline uint8 operator[](const fsize id) const
+            {
+                if (id >= _size)
+                    throw IndexException((fint)id);
+                return (_data[id]);
+            }
+
+            /**
+             * Returns a sub-view of this view without copying
+             * @param pos the index of the first byte
+             * @param size the maximum number of bytes, clamped to the end of this view
+             * @throw IndexException if pos out of bounds
+             * @return new ByteView
+             */
+            inline ByteView Sub(const fsize pos, const fsize size) const
+            {
+                if (pos > _size)
+                    throw IndexException((fint)pos);
+                return (ByteView(_data + pos, size > _size - pos ? _size - pos : size));
+            }
+
+            /**
+             * Returns a sub-view from a given index to the end of this view without copying
+             * @param pos the index of the first byte
+             * @throw IndexException if pos out of bounds
+             * @return new ByteView
+             */
+            inline ByteView Sub(const fsize pos) const
+            {
+                return (Sub(pos, _size));
+            }
+
+            /**
+             * Compares the bytes of two views
+             * @param other operand
+             * @return true if both views have the same bytes
+             */
+            inline bool operator==(const ByteView &other) const noexcept
+            {
+                return (_size == other._size && (_size == 0 || std::memcmp(_data, other._data, _size) == 0));
+            }
+
+            /**
+             * Compares the bytes of two views
+             * @param other operand
+             * @return false if both views have the same bytes
+             */
+            inline bool operator!=(const ByteView &other) const noexcept
+            {
+                return (!operator==(other));
+            }
+
+            inline const uint8 *begin() const noexcept
+            {
+                return (_data);
+            }
+
+            inline const uint8 *end() const noexcept
+            {
+                return (_data + _size);
+            }
+        };
+    }
+}
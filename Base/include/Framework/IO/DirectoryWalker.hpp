@@ -0,0 +1,172 @@
+// Copyright (c) 2020, BlockProject 3D
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without modification,
+// are permitted provided that the following conditions are met:
+// 
+//     * Redistributions of source code must retain the above copyright notice,
+//       this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above copyright notice,
+//       this list of conditions and the following disclaimer in the documentation
+//       and/or other materials provided with the distribution.
+//     * Neither the name of BlockProject 3D nor the names of its contributors
+//       may be used to endorse or promote products derived from this software
+//       without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#pragma once
+#include "Framework/Collection/Stack.hpp"
+#include "Framework/IO/EFileType.hpp"
+#include "Framework/IO/File.hpp"
+#include <functional>
+
+namespace bpf
+{
+    namespace io
+    {
+        struct DirectoryLevel;
+
+        /**
+         * Streaming directory/folder iterator. Entries are read in large batches straight from the system
+         * (getdents64 on Linux) and exposed one at a time without building a File per entry; the entry type comes
+         * from the directory listing itself, stat is only used on file systems which do not report it.
+         * Symbolic links are never followed. Sub-directories which cannot be opened are silently skipped
+         */
+        class BPF_API DirectoryWalker
+        {
+        private:
+            File _root;
+            collection::Stack<DirectoryLevel *> _levels;
+            std::function<bool(const DirectoryWalker &walker)> _filter;
+            bool _recursive;
+            bool _descend;
+            const char *_name;
+            fsize _nameLen;
+            EFileType _type;
+#ifdef WINDOWS
+            String _nameBuf;
+#endif
+
+            bool ReadEntry(DirectoryLevel &level);
+            void Descend();
+            void PopLevel();
+
+        public:
+            /**
+             * Creates a new DirectoryWalker
+             * @param dir the directory/folder to walk
+             * @param recursive true to also walk all sub-directories/folders, depth first
+             * @throw IOException if the directory/folder cannot be opened
+             */
+            explicit DirectoryWalker(const File &dir, bool recursive = true);
+
+            ~DirectoryWalker();
+
+            /**
+             * Cannot copy a DirectoryWalker
+             */
+            DirectoryWalker(const DirectoryWalker &other) = delete;
+
+            /**
+             * Cannot copy a DirectoryWalker
+             */
+            DirectoryWalker &operator=(const DirectoryWalker &other) = delete;
+
+            /**
+             * Sets a filter function; entries for which the filter returns false are not returned by Next.
+             * Filtered-out directories/folders are still walked when recursive
+             * @param filter the filter function, called with this walker positioned on the candidate entry
+             */
+            inline void SetFilter(std::function<bool(const DirectoryWalker &walker)> filter)
+            {
+                _filter = std::move(filter);
+            }
+
+            /**
+             * Moves to the next entry
+             * @return true if an entry is available, false if the walk is finished
+             */
+            bool Next();
+
+            /**
+             * Prevents the walker from entering the current directory/folder entry
+             */
+            inline void Skip() noexcept
+            {
+                _descend = false;
+            }
+
+            /**
+             * Returns the name of the current entry without copying it
+             * @return raw UTF-8 name, valid until the next call to Next
+             */
+            inline const char *GetRawName() const noexcept
+            {
+                return (_name);
+            }
+
+            /**
+             * Returns the size of the name of the current entry
+             * @return size in bytes
+             */
+            inline fsize GetNameLength() const noexcept
+            {
+                return (_nameLen);
+            }
+
+            /**
+             * Returns the name of the current entry
+             * @return new high-level string
+             */
+            inline String GetName() const
+            {
+                return (String(_name, _nameLen));
+            }
+
+            /**
+             * Returns the type of the current entry
+             * @return entry type
+             */
+            inline EFileType GetType() const noexcept
+            {
+                return (_type);
+            }
+
+            /**
+             * Returns the depth of the current entry, 0 for direct children of the walked directory/folder
+             * @return depth as unsigned
+             */
+            inline fsize GetDepth() const noexcept
+            {
+                return (_levels.Size() - 1);
+            }
+
+            /**
+             * Returns the path of the current entry relative to the walked directory/folder
+             * @return new high-level string using '/' as path separator
+             */
+            String GetRelativePath() const;
+
+            /**
+             * Returns the current entry as a File
+             * @return new File
+             */
+            inline File GetFile() const
+            {
+                return (_root + GetRelativePath());
+            }
+        };
+    }
+}
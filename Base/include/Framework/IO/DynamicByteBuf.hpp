@@ -26,3 +26,143 @@
 // NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
 // SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
+#pragma once
+#include "Framework/Collection/List.hpp"
+#include "Framework/IO/ByteBuf.hpp"
+#include "Framework/Memory/SharedPtr.hpp"
+
+namespace bpf
+{
+    namespace io
+    {
+        /**
+         * Default size in bytes of a DynamicByteBuf segment
+         */
+        constexpr fsize DYNAMIC_BYTEBUF_SEGMENT_SIZE = 4096;
+
+        /**
+         * Growable FIFO byte buffer made of a chain of reference counted ByteBuf segments.
+         * Writing appends to the last segment or chains a new one, reading consumes the first segments: bytes are
+         * never moved nor reallocated. Consumed segments are recycled for later writes (ring behavior) unless they
+         * are still referenced elsewhere. Not thread safe
+         */
+        class BPF_API DynamicByteBuf final : public IInputStream, public IOutputStream
+        {
+        private:
+            struct Segment
+            {
+                memory::SharedPtr<ByteBuf> Buffer;
+                fsize Start;
+                fsize End;
+                bool Owned;
+            };
+
+            collection::List<Segment> _segments;
+            collection::List<memory::SharedPtr<ByteBuf>> _free;
+            fsize _segmentSize;
+            fsize _maxFree;
+            fsize _size;
+
+            void PopSegment();
+            void Trim();
+
+        public:
+            /**
+             * Constructs a DynamicByteBuf
+             * @param segmentSize the size in bytes of the segments allocated by Write
+             * @param maxFree the maximum number of consumed segments kept for reuse
+             */
+            explicit DynamicByteBuf(fsize segmentSize = DYNAMIC_BYTEBUF_SEGMENT_SIZE, fsize maxFree = 8);
+
+            /**
+             * Appends bytes, copying them into the segments of this buffer
+             * @param buf the buffer with the bytes to write
+             * @param bufsize the size of the buffer
+             * @return number of bytes written, always bufsize
+             */
+            fsize Write(const void *buf, fsize bufsize) final;
+
+            /**
+             * Appends the bytes of a view, copying them into the segments of this buffer
+             * @param view the bytes to write
+             * @return number of bytes written, always the size of the view
+             */
+            inline fsize Write(const ByteView &view)
+            {
+                return (Write(*view, view.Size()));
+            }
+
+            /**
+             * Appends a range of an existing buffer without copying it. The buffer is shared, not modified: later
+             * writes start a new segment
+             * @param buffer the buffer to chain
+             * @param pos the index of the first byte to append
+             * @param size the number of bytes to append
+             * @throw IndexException if the range is out of bounds
+             */
+            void Append(const memory::SharedPtr<ByteBuf> &buffer, fsize pos, fsize size);
+
+            /**
+             * Appends the written bytes of an existing buffer without copying it
+             * @param buffer the buffer to chain
+             */
+            inline void Append(const memory::SharedPtr<ByteBuf> &buffer)
+            {
+                Append(buffer, 0, buffer->GetWrittenBytes());
+            }
+
+            /**
+             * Reads and consumes bytes from the front of this buffer
+             * @param buf buffer to receive the read bytes
+             * @param bufsize the size of the receiving buffer
+             * @return number of bytes read
+             */
+            fsize Read(void *buf, fsize bufsize) final;
+
+            /**
+             * Consumes bytes from the front of this buffer without copying them, at most one segment at a time
+             * @param data receives a pointer to the bytes read
+             * @param maxsize the maximum number of bytes to read
+             * @return number of bytes read, 0 if this buffer is empty
+             */
+            fsize ReadDirect(const uint8 *&data, fsize maxsize) final;
+
+            /**
+             * Returns the first contiguous readable bytes without consuming them.
+             * The view remains valid until the next function call modifying this buffer
+             * @return view of the first segment, empty if this buffer is empty
+             */
+            ByteView Peek() const noexcept;
+
+            /**
+             * Discards bytes from the front of this buffer
+             * @param size the number of bytes to discard, clamped to the readable size
+             */
+            void Consume(fsize size);
+
+            /**
+             * Discards all bytes and recycles the segments
+             */
+            void Clear();
+
+            /**
+             * Returns the number of readable bytes
+             * @return size in bytes as unsigned
+             */
+            inline fsize Size() const noexcept
+            {
+                return (_size);
+            }
+
+            /**
+             * Returns the number of segments currently chained, including a segment drained by ReadDirect
+             * which is released by the next call
+             * @return number of segments
+             */
+            inline fsize GetSegmentCount() const noexcept
+            {
+                return (_segments.Size());
+            }
+        };
+    }
+}
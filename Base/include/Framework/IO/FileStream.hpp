@@ -29,6 +29,7 @@
 #pragma once
 #include "Framework/IO/File.hpp"
 #include "Framework/IO/IInputStream.hpp"
+#include "Framework/IO/IOVector.hpp"
 #include "Framework/IO/IOutputStream.hpp"
 
 namespace bpf
@@ -45,6 +46,8 @@ namespace bpf
          */
         constexpr fint FILE_MODE_TRUNCATE = 0x80;
 
+        class AsyncIOBackend;
+
         /**
          * Class to represent a file stream open as read, write or random access
          */
@@ -125,6 +128,50 @@ namespace bpf
              * @return number of bytes written
              */
             fsize Write(const void *buf, fsize bufsize) final;
+
+            /**
+             * Reads bytes at the given position in the file. On POSIX systems the file cursor is not moved, on
+             * Windows it is left after the last byte read
+             * @param pos position in bytes in the file to start reading at
+             * @param buf buffer to receive the read bytes
+             * @param bufsize the size of the receiving buffer
+             * @throw IOException in case of system error
+             * @return number of bytes read
+             */
+            fsize ReadAt(uint64 pos, void *buf, fsize bufsize);
+
+            /**
+             * Writes bytes at the given position in the file. On POSIX systems the file cursor is not moved, on
+             * Windows it is left after the last byte written
+             * @param pos position in bytes in the file to start writing at
+             * @param buf the buffer with the bytes to write
+             * @param bufsize the size of the buffer
+             * @throw IOException in case of system error
+             * @return number of bytes written
+             */
+            fsize WriteAt(uint64 pos, const void *buf, fsize bufsize);
+
+            /**
+             * Reads bytes at the given position in the file, filling each buffer in order (scatter read)
+             * @param pos position in bytes in the file to start reading at
+             * @param buffers the receiving buffers
+             * @param count the number of buffers
+             * @throw IOException in case of system error
+             * @return total number of bytes read
+             */
+            fsize ReadV(uint64 pos, const IOVector *buffers, fsize count);
+
+            /**
+             * Writes the content of each buffer in order at the given position in the file (gather write)
+             * @param pos position in bytes in the file to start writing at
+             * @param buffers the buffers to write
+             * @param count the number of buffers
+             * @throw IOException in case of system error
+             * @return total number of bytes written
+             */
+            fsize WriteV(uint64 pos, const IOVector *buffers, fsize count);
+
+            friend class AsyncIOBackend;
         };
     }
 }
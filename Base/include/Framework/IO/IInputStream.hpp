@@ -50,6 +50,22 @@ namespace bpf
              * @return number of bytes read
              */
             virtual fsize Read(void *buf, fsize bufsize) = 0;
+
+            /**
+             * Reads bytes from this stream without copying them, when the stream already holds its data in memory.
+             * The returned memory is owned by the stream and remains valid until the next call to any function of
+             * this stream. Readers call this before falling back to Read
+             * @param data receives a pointer to the bytes read
+             * @param maxsize the maximum number of bytes to read
+             * @throw IOException in case of system error
+             * @return number of bytes read, 0 if the end of the stream is reached or if zero-copy reads are not supported
+             */
+            virtual fsize ReadDirect(const uint8 *&data, fsize maxsize)
+            {
+                (void)maxsize;
+                data = nullptr;
+                return (0);
+            }
         };
     }
 }
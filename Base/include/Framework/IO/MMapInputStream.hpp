@@ -0,0 +1,115 @@
+// Copyright (c) 2020, BlockProject 3D
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without modification,
+// are permitted provided that the following conditions are met:
+// 
+//     * Redistributions of source code must retain the above copyright notice,
+//       this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above copyright notice,
+//       this list of conditions and the following disclaimer in the documentation
+//       and/or other materials provided with the distribution.
+//     * Neither the name of BlockProject 3D nor the names of its contributors
+//       may be used to endorse or promote products derived from this software
+//       without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#pragma once
+#include "Framework/IO/IInputStream.hpp"
+#include "Framework/IO/MemoryMapper.hpp"
+
+namespace bpf
+{
+    namespace io
+    {
+        /**
+         * Default size in bytes of the window mapped by a MMapInputStream
+         */
+        constexpr fsize MMAP_WINDOW_SIZE = 16 * 1024 * 1024;
+
+        /**
+         * Input stream reading a file through a memory mapped window which slides over the file.
+         * This stream supports zero-copy reads: BinaryReader and TextReader access the mapped pages directly
+         */
+        class BPF_API MMapInputStream final : public IInputStream
+        {
+        private:
+            MemoryMapper _mapper;
+            EMapAdvice _advice;
+            uint64 _fileSize;
+            uint64 _pos;
+            uint64 _windowPos;
+            fsize _windowSize;
+            fsize _windowCapacity;
+            const uint8 *_data;
+
+            bool UpdateWindow();
+
+        public:
+            /**
+             * Creates a new MMapInputStream
+             * @param file the file to read
+             * @param advice the access pattern hint to apply to each mapped window. With EMapAdvice::SEQUENTIAL
+             * each new window is additionally prefetched
+             * @param windowSize the maximum size in bytes of the mapped window
+             * @throw IOException in case of system error
+             */
+            explicit MMapInputStream(const File &file, EMapAdvice advice = EMapAdvice::SEQUENTIAL, fsize windowSize = MMAP_WINDOW_SIZE);
+
+            /**
+             * Sets the stream cursor position to pos, the window is re-mapped on the next read if needed
+             * @param pos new cursor position
+             */
+            void Seek(uint64 pos);
+
+            /**
+             * Returns the current stream cursor position
+             * @return position in bytes from the beginning of the file
+             */
+            inline uint64 GetPosition() const noexcept
+            {
+                return (_pos);
+            }
+
+            /**
+             * Returns the size of the file mapped by this stream
+             * @return size in bytes
+             */
+            inline uint64 GetSize() const noexcept
+            {
+                return (_fileSize);
+            }
+
+            /**
+             * Reads bytes from this stream, copying them out of the mapped window
+             * @param buf buffer to receive the read bytes
+             * @param bufsize the size of the receiving buffer
+             * @throw IOException in case of system error
+             * @return number of bytes read
+             */
+            fsize Read(void *buf, fsize bufsize) final;
+
+            /**
+             * Reads bytes from this stream without copying them, the returned pointer points into the mapped window.
+             * At most the remaining bytes of the current window are returned
+             * @param data receives a pointer to the bytes read
+             * @param maxsize the maximum number of bytes to read
+             * @throw IOException in case of system error
+             * @return number of bytes read, 0 if the end of the file is reached
+             */
+            fsize ReadDirect(const uint8 *&data, fsize maxsize) final;
+        };
+    }
+}
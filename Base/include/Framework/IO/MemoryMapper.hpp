@@ -27,6 +27,7 @@
 // SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #pragma once
+#include "Framework/IO/EMapAdvice.hpp"
 #include "Framework/IO/File.hpp"
 
 namespace bpf
@@ -87,6 +88,13 @@ namespace bpf
              */
             void Map(uint64 pos, fsize size);
 
+            /**
+             * Gives the system a hint on how the current mapping will be accessed.
+             * On platforms without support for access hints this function does nothing
+             * @param advice the expected access pattern
+             */
+            void Advise(EMapAdvice advice);
+
             /**
              * Unmaps any previous mappings of the file
              */
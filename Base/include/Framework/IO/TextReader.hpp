@@ -43,11 +43,15 @@ namespace bpf
         private:
             IInputStream &_stream;
             ByteBuf _buf;
+            const uint8 *_direct;
+            fsize _directSize;
+            fsize _directPos;
             bool _buffered;
             String _seps;
             ECharacterEncoding _encoder;
 
             bool ReadByte2(uint8 &out);
+            bool Refill();
             bool ReadSubBuf(void *out, fsize size);
             bool CheckIsSeparator(uint8 byte);
 
@@ -61,6 +65,9 @@ namespace bpf
             explicit inline TextReader(IInputStream &stream, const ECharacterEncoding encoder = ECharacterEncoding::UTF8, bool buffered = true)
                 : _stream(stream)
                 , _buf(READ_BUF_SIZE)
+                , _direct(nullptr)
+                , _directSize(0)
+                , _directPos(0)
                 , _buffered(buffered)
                 , _seps("\r\n\t ")
                 , _encoder(encoder)
@@ -0,0 +1,74 @@
+// Copyright (c) 2020, BlockProject 3D
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without modification,
+// are permitted provided that the following conditions are met:
+// 
+//     * Redistributions of source code must retain the above copyright notice,
+//       this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above copyright notice,
+//       this list of conditions and the following disclaimer in the documentation
+//       and/or other materials provided with the distribution.
+//     * Neither the name of BlockProject 3D nor the names of its contributors
+//       may be used to endorse or promote products derived from this software
+//       without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#pragma once
+#include "Framework/Log/AsyncLogBackend.hpp"
+#include "Framework/Log/ILogAdapter.hpp"
+#include "Framework/Memory/SharedPtr.hpp"
+
+namespace bpf
+{
+    namespace log
+    {
+        /**
+         * Log adapter forwarding messages to a shared AsyncLogBackend.
+         * Several Logger instances may share the same backend; create all adapters before logging as the
+         * SharedPtr reference count itself is not thread-safe
+         */
+        class BPF_API AsyncLogAdapter final : public ILogAdapter
+        {
+        private:
+            memory::SharedPtr<AsyncLogBackend> _backend;
+
+        public:
+            /**
+             * Constructs an AsyncLogAdapter
+             * @param backend the backend to forward messages to
+             */
+            explicit inline AsyncLogAdapter(memory::SharedPtr<AsyncLogBackend> backend)
+                : _backend(std::move(backend))
+            {
+            }
+
+            inline void LogMessage(ELogLevel level, const String &category, const String &msg) final
+            {
+                _backend->Submit(level, category, msg);
+            }
+
+            inline void Log(const String &category, const LogRecord &record) final
+            {
+                _backend->Submit(category, record);
+            }
+
+            inline void Flush() final
+            {
+                _backend->Flush();
+            }
+        };
+    }
+}
@@ -0,0 +1,151 @@
+// Copyright (c) 2020, BlockProject 3D
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without modification,
+// are permitted provided that the following conditions are met:
+// 
+//     * Redistributions of source code must retain the above copyright notice,
+//       this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above copyright notice,
+//       this list of conditions and the following disclaimer in the documentation
+//       and/or other materials provided with the distribution.
+//     * Neither the name of BlockProject 3D nor the names of its contributors
+//       may be used to endorse or promote products derived from this software
+//       without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#pragma once
+#include <atomic>
+#include "Framework/Collection/List.hpp"
+#include "Framework/Log/ELogLevel.hpp"
+#include "Framework/Log/EOverflowPolicy.hpp"
+#include "Framework/Log/ILogAdapter.hpp"
+#include "Framework/Log/LogRecord.hpp"
+#include "Framework/Memory/UniquePtr.hpp"
+#include "Framework/System/ConditionVariable.hpp"
+#include "Framework/System/Mutex.hpp"
+
+class AsyncLogWorker;
+
+namespace bpf
+{
+    namespace log
+    {
+        /**
+         * Asynchronous log backend: messages are pushed by any number of threads into a bounded lock-free ring and a
+         * background thread dispatches them in batches to the registered log adapters, flushing the adapters
+         * periodically instead of after every message.
+         * Use AsyncLogAdapter to plug a backend into one or more Logger instances
+         */
+        class BPF_API AsyncLogBackend
+        {
+        private:
+            struct Record
+            {
+                String Category;
+                LogRecord Data;
+            };
+
+            struct Cell
+            {
+                std::atomic<fsize> Sequence;
+                Record Data;
+            };
+
+            Cell *_cells;
+            fsize _mask;
+            std::atomic<fsize> _enqueuePos;
+            fsize _dequeuePos;
+            std::atomic<fsize> _flushedPos;
+            std::atomic<fsize> _dropped;
+            std::atomic<bool> _flushRequest;
+            std::atomic<bool> _exit;
+            EOverflowPolicy _policy;
+            uint32 _flushInterval;
+            system::Mutex _handlersLock;
+            collection::List<memory::UniquePtr<ILogAdapter>> _handlers;
+            AsyncLogWorker *_worker;
+            system::Mutex _signalLock;
+            system::ConditionVariable _workAvailable;
+            system::ConditionVariable _progress;
+            std::atomic<bool> _parked;
+            std::atomic<fsize> _waiters;
+
+            bool TryPush(const String &category, const LogRecord &record);
+            bool TryPop(Record &rec);
+            bool HasPending() const noexcept;
+            void WakeWorker();
+            void WakeWaiters();
+
+        public:
+            /**
+             * Constructs an AsyncLogBackend and starts its background thread
+             * @param capacity the maximum number of pending messages (rounded up to the next power of 2)
+             * @param policy what to do when the queue is full
+             * @param flushInterval the maximum time in milliseconds a message may stay in an adapter buffer
+             */
+            explicit AsyncLogBackend(fsize capacity = 8192, EOverflowPolicy policy = EOverflowPolicy::BLOCK,
+                                     uint32 flushInterval = 100);
+
+            /**
+             * Drains all pending messages, flushes the log adapters and stops the background thread
+             */
+            ~AsyncLogBackend();
+
+            AsyncLogBackend(const AsyncLogBackend &other) = delete;
+            AsyncLogBackend &operator=(const AsyncLogBackend &other) = delete;
+
+            /**
+             * Adds a new log adapter. Adapters are only ever called from the background thread
+             * @param ptr UniquePtr to the new ILogAdapter
+             */
+            void AddHandler(memory::UniquePtr<ILogAdapter> &&ptr);
+
+            /**
+             * Queues a message for asynchronous dispatch. This function is thread-safe
+             * @param level the level of severity
+             * @param category the category name
+             * @param msg the message text
+             * @return true if the message was queued, false if it was dropped because of the overflow policy
+             */
+            bool Submit(ELogLevel level, const String &category, const String &msg);
+
+            /**
+             * Queues a structured record for asynchronous dispatch; the record is only formatted by the background
+             * thread if a log adapter needs the text. This function is thread-safe
+             * @param category the category name
+             * @param record the log record
+             * @return true if the record was queued, false if it was dropped because of the overflow policy
+             */
+            bool Submit(const String &category, const LogRecord &record);
+
+            /**
+             * Blocks until all messages queued before this call have been written and the log adapters flushed
+             */
+            void Flush();
+
+            /**
+             * Returns the total number of messages dropped since this backend was created
+             * @return number of dropped messages as unsigned
+             */
+            inline fsize GetDroppedCount() const noexcept
+            {
+                return (_dropped.load(std::memory_order_relaxed));
+            }
+
+            friend class ::AsyncLogWorker;
+        };
+    }
+}
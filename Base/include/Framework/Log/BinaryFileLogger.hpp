@@ -0,0 +1,114 @@
+// Copyright (c) 2020, BlockProject 3D
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without modification,
+// are permitted provided that the following conditions are met:
+// 
+//     * Redistributions of source code must retain the above copyright notice,
+//       this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above copyright notice,
+//       this list of conditions and the following disclaimer in the documentation
+//       and/or other materials provided with the distribution.
+//     * Neither the name of BlockProject 3D nor the names of its contributors
+//       may be used to endorse or promote products derived from this software
+//       without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#pragma once
+#include "Framework/Collection/HashMap.hpp"
+#include "Framework/IO/ByteBuf.hpp"
+#include "Framework/IO/File.hpp"
+#include "Framework/IO/FileStream.hpp"
+#include "Framework/Log/ILogAdapter.hpp"
+#include "Framework/System/Platform.hpp"
+
+namespace bpf
+{
+    namespace log
+    {
+        /**
+         * Magic number at the start of every binary log file
+         */
+        constexpr uint32 BINARY_LOG_MAGIC = 0x474F4C42;
+
+        /**
+         * Version of the binary log file format
+         */
+        constexpr uint8 BINARY_LOG_VERSION = 1;
+
+        /**
+         * Binary log entry defining a format string
+         */
+        constexpr uint8 BINARY_LOG_FORMAT = 0;
+
+        /**
+         * Binary log entry defining a category name
+         */
+        constexpr uint8 BINARY_LOG_CATEGORY = 1;
+
+        /**
+         * Binary log entry containing a log record
+         */
+        constexpr uint8 BINARY_LOG_RECORD = 2;
+
+        /**
+         * Format id of records which are already formatted
+         */
+        constexpr uint32 BINARY_LOG_NO_FORMAT = 0xFFFFFFFF;
+
+        /**
+         * Log adapter writing structured records to a compact binary file without formatting them.
+         * Format strings and categories are written once and then referenced by id. Use BinaryLogReader to decode the
+         * file offline
+         */
+        class BPF_API BinaryFileLogger final : public ILogAdapter
+        {
+        private:
+            io::FileStream _stream;
+            io::ByteBuf _buf;
+            collection::HashMap<fsize, uint32> _formats;
+            collection::HashMap<String, uint32> _categories;
+
+            void Append(const void *data, fsize size);
+            void AppendString(const char *str, fsize len);
+
+            template <typename T>
+            inline void AppendValue(T v)
+            {
+                if (system::Platform::GetEndianess() != system::PLATFORM_LITTLEENDIAN)
+                    system::Platform::ReverseBuffer(&v, sizeof(T));
+                Append(&v, sizeof(T));
+            }
+            uint32 GetCategoryId(const String &category);
+            uint32 GetFormatId(const char *format);
+
+        public:
+            /**
+             * Constructs a BinaryFileLogger; the file is truncated
+             * @param file the file to write logs to
+             * @param bufSize the size in bytes of the write buffer
+             */
+            explicit BinaryFileLogger(const io::File &file, fsize bufSize = 65536);
+
+            ~BinaryFileLogger();
+
+            void LogMessage(ELogLevel level, const String &category, const String &msg) final;
+
+            void Log(const String &category, const LogRecord &record) final;
+
+            void Flush() final;
+        };
+    }
+}
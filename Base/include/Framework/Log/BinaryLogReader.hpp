@@ -0,0 +1,69 @@
+// Copyright (c) 2020, BlockProject 3D
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without modification,
+// are permitted provided that the following conditions are met:
+// 
+//     * Redistributions of source code must retain the above copyright notice,
+//       this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above copyright notice,
+//       this list of conditions and the following disclaimer in the documentation
+//       and/or other materials provided with the distribution.
+//     * Neither the name of BlockProject 3D nor the names of its contributors
+//       may be used to endorse or promote products derived from this software
+//       without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#pragma once
+#include "Framework/Collection/ArrayList.hpp"
+#include "Framework/IO/BinaryReader.hpp"
+#include "Framework/IO/IInputStream.hpp"
+#include "Framework/Log/LogRecord.hpp"
+
+namespace bpf
+{
+    namespace log
+    {
+        /**
+         * Decodes log files written by BinaryFileLogger
+         */
+        class BPF_API BinaryLogReader
+        {
+        private:
+            io::BinaryReader _reader;
+            collection::ArrayList<String> _formats;
+            collection::ArrayList<String> _categories;
+
+            bool ReadString(String &str);
+
+        public:
+            /**
+             * Constructs a BinaryLogReader and checks the file header
+             * @param stream the stream to read from
+             * @throw io::IOException if the stream is not a binary log file
+             */
+            explicit BinaryLogReader(io::IInputStream &stream);
+
+            /**
+             * Reads the next record; the returned record references format strings owned by this reader
+             * @param category the category name
+             * @param record the decoded log record
+             * @throw io::IOException if the file is truncated or corrupted
+             * @return false if the end of the stream has been reached, true otherwise
+             */
+            bool ReadNext(String &category, LogRecord &record);
+        };
+    }
+}
@@ -27,32 +27,43 @@
 // SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #pragma once
+#include "Framework/IO/ByteBuf.hpp"
 #include "Framework/IO/FileStream.hpp"
 #include "Framework/IO/File.hpp"
-#include "Framework/IO/TextWriter.hpp"
 #include "Framework/Log/ILogAdapter.hpp"
+#include "Framework/System/DateTime.hpp"
 
 namespace bpf
 {
     namespace log
     {
         /**
-         * A simple file log adapter
+         * A simple file log adapter.
+         * Lines are accumulated in an internal buffer which is written to the file when full or on Flush
          */
         class BPF_API FileLogger final : public ILogAdapter
         {
         private:
             io::FileStream _stream;
-            io::TextWriter _writer;
+            io::ByteBuf _buf;
+            system::DateTime _lastTime;
+            String _lastTimeStr;
+
+            void Append(const void *data, fsize size);
 
         public:
             /**
              * Constructs a FileLogger
              * @param file the file to write logs to
+             * @param bufSize the size in bytes of the write buffer
              */
-            explicit FileLogger(const io::File &file);
+            explicit FileLogger(const io::File &file, fsize bufSize = 4096);
+
+            ~FileLogger();
 
             void LogMessage(ELogLevel level, const String &category, const String &msg) final;
+
+            void Flush() final;
         };
     }
 }
@@ -29,6 +29,7 @@
 #pragma once
 #include "Framework/String.hpp"
 #include "Framework/Log/ELogLevel.hpp"
+#include "Framework/Log/LogRecord.hpp"
 
 namespace bpf
 {
@@ -49,6 +50,24 @@ namespace bpf
              * @param msg the message text
              */
             virtual void LogMessage(ELogLevel level, const String &category, const String &msg) = 0;
+
+            /**
+             * Logs the given structured record. The default implementation formats the record and calls LogMessage;
+             * override this function in adapters which can store records without formatting them
+             * @param category the category name
+             * @param record the log record
+             */
+            virtual void Log(const String &category, const LogRecord &record)
+            {
+                LogMessage(record.GetLevel(), category, record.ToString());
+            }
+
+            /**
+             * Writes any buffered message to the underlying device
+             */
+            virtual void Flush()
+            {
+            }
         };
     }
 }
@@ -0,0 +1,356 @@
+// Copyright (c) 2020, BlockProject 3D
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without modification,
+// are permitted provided that the following conditions are met:
+// 
+//     * Redistributions of source code must retain the above copyright notice,
+//       this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above copyright notice,
+//       this list of conditions and the following disclaimer in the documentation
+//       and/or other materials provided with the distribution.
+//     * Neither the name of BlockProject 3D nor the names of its contributors
+//       may be used to endorse or promote products derived from this software
+//       without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#pragma once
+#include <cstring>
+#include <type_traits>
+#include "Framework/Log/ELogLevel.hpp"
+#include "Framework/String.hpp"
+
+namespace bpf
+{
+    namespace log
+    {
+        /**
+         * Maximum number of bytes of argument data stored inline in a LogRecord
+         */
+        constexpr fsize LOG_RECORD_BUF_SIZE = 128;
+
+        /**
+         * A structured log message: the format string is kept by pointer and the arguments are captured in a compact
+         * binary form, the text is only built when a log adapter needs it (see ToString).
+         * Arguments that cannot be captured (unsupported types or not enough space) cause the record to be formatted
+         * immediately instead
+         */
+        class BPF_API LogRecord
+        {
+        public:
+            /**
+             * Type tag of a captured argument
+             */
+            enum EArgType
+            {
+                ARG_INT,
+                ARG_UINT,
+                ARG_FLOAT,
+                ARG_DOUBLE,
+                ARG_BOOL,
+                ARG_STRING
+            };
+
+            /**
+             * Decoded view of a captured argument
+             */
+            struct Argument
+            {
+                EArgType Type;
+                union
+                {
+                    int64 Int;
+                    uint64 UInt;
+                    float Float;
+                    double Double;
+                    bool Bool;
+                };
+
+                /**
+                 * Pointer to the null-terminated string data when Type is ARG_STRING
+                 */
+                const char *Str;
+
+                /**
+                 * Size in bytes of the string data when Type is ARG_STRING
+                 */
+                fsize StrLen;
+            };
+
+        private:
+            ELogLevel _level;
+            int64 _time;
+            const char *_format;
+            fsize _size;
+            fsize _argc;
+            String _text;
+            uint8 _data[LOG_RECORD_BUF_SIZE];
+
+            static int64 CurrentTime() noexcept;
+            bool PushRaw(EArgType type, const void *data, fsize size, fsize extra = 0);
+
+            inline bool PushAll() noexcept
+            {
+                return (true);
+            }
+
+            template <typename T, typename... Args>
+            inline bool PushAll(const T &t, const Args &... args)
+            {
+                return (Push(t) && PushAll(args...));
+            }
+
+            static String FormatArgument(const String &pattern, const Argument &arg);
+
+        public:
+            /**
+             * Constructs an empty record
+             */
+            LogRecord() noexcept;
+
+            /**
+             * Constructs a record from an already formatted message
+             * @param level the level of severity
+             * @param text the message text
+             */
+            LogRecord(ELogLevel level, const String &text);
+
+            /**
+             * Constructs a record by capturing a format string and its arguments
+             * @tparam Args the type of arguments
+             * @param level the level of severity
+             * @param format the format (see bpf::String::Format); the pointer must stay valid for the lifetime of the
+             * record, usually a string literal
+             * @param args the argument values
+             */
+            template <typename... Args>
+            LogRecord(const ELogLevel level, const char *format, const Args &... args)
+                : _level(level)
+                , _time(CurrentTime())
+                , _format(format)
+                , _size(0)
+                , _argc(0)
+            {
+                if (!PushAll(args...))
+                {
+                    _format = nullptr;
+                    _size = 0;
+                    _argc = 0;
+                    _text = String::Format(format, args...);
+                }
+            }
+
+            /**
+             * Copy constructor
+             */
+            LogRecord(const LogRecord &other);
+
+            /**
+             * Move constructor
+             */
+            LogRecord(LogRecord &&other) noexcept;
+
+            /**
+             * Copy assignment operator
+             */
+            LogRecord &operator=(const LogRecord &other);
+
+            /**
+             * Move assignment operator
+             */
+            LogRecord &operator=(LogRecord &&other) noexcept;
+
+            /**
+             * Captures a signed integer argument
+             * @param i the value
+             * @return false if there is not enough space left in this record, true otherwise
+             */
+            template <typename T>
+            inline typename std::enable_if<std::is_integral<T>::value && std::is_signed<T>::value, bool>::type
+            Push(const T &i)
+            {
+                int64 v = i;
+                return (PushRaw(ARG_INT, &v, sizeof(int64)));
+            }
+
+            /**
+             * Captures an unsigned integer argument
+             * @param i the value
+             * @return false if there is not enough space left in this record, true otherwise
+             */
+            template <typename T>
+            inline typename std::enable_if<std::is_integral<T>::value && std::is_unsigned<T>::value
+                                               && !std::is_same<T, bool>::value,
+                                           bool>::type
+            Push(const T &i)
+            {
+                uint64 v = i;
+                return (PushRaw(ARG_UINT, &v, sizeof(uint64)));
+            }
+
+            /**
+             * Captures a boolean argument
+             * @param b the value
+             * @return false if there is not enough space left in this record, true otherwise
+             */
+            inline bool Push(const bool b)
+            {
+                return (PushRaw(ARG_BOOL, &b, sizeof(bool)));
+            }
+
+            /**
+             * Captures a float argument
+             * @param f the value
+             * @return false if there is not enough space left in this record, true otherwise
+             */
+            inline bool Push(const float f)
+            {
+                return (PushRaw(ARG_FLOAT, &f, sizeof(float)));
+            }
+
+            /**
+             * Captures a double argument
+             * @param d the value
+             * @return false if there is not enough space left in this record, true otherwise
+             */
+            inline bool Push(const double d)
+            {
+                return (PushRaw(ARG_DOUBLE, &d, sizeof(double)));
+            }
+
+            /**
+             * Captures a string argument
+             * @param str the string data
+             * @param len the size in bytes of the string data
+             * @return false if there is not enough space left in this record, true otherwise
+             */
+            bool Push(const char *str, fsize len);
+
+            /**
+             * Captures a null-terminated string argument
+             * @param str the string
+             * @return false if there is not enough space left in this record, true otherwise
+             */
+            inline bool Push(const char *str)
+            {
+                if (str == nullptr)
+                    str = "(NULL)";
+                return (Push(str, std::strlen(str)));
+            }
+
+            /**
+             * Captures a string argument
+             * @param str the string
+             * @return false if there is not enough space left in this record, true otherwise
+             */
+            inline bool Push(const String &str)
+            {
+                return (Push(*str, str.Size()));
+            }
+
+            /**
+             * Fallback for types which cannot be captured: always fails so that the record gets formatted immediately
+             * @return false
+             */
+            template <typename T>
+            inline typename std::enable_if<!std::is_integral<T>::value && !std::is_same<T, float>::value
+                                               && !std::is_same<T, double>::value
+                                               && !std::is_convertible<T, const char *>::value
+                                               && !std::is_same<T, String>::value,
+                                           bool>::type
+            Push(const T &)
+            {
+                return (false);
+            }
+
+            /**
+             * Reads the next captured argument
+             * @param cursor byte offset of the argument to read, updated to point to the next argument
+             * @param arg the decoded argument
+             * @return false if there is no more argument to read, true otherwise
+             */
+            bool NextArgument(fsize &cursor, Argument &arg) const noexcept;
+
+            /**
+             * Sets the time stamp of this record
+             * @param time number of microseconds since January 1, 1970 UTC
+             */
+            inline void SetTime(const int64 time) noexcept
+            {
+                _time = time;
+            }
+
+            /**
+             * Sets the format string of this record
+             * @param format the format string; the pointer must stay valid for the lifetime of the record
+             */
+            inline void SetFormat(const char *format) noexcept
+            {
+                _format = format;
+            }
+
+            /**
+             * Returns the level of severity
+             * @return log level
+             */
+            inline ELogLevel GetLevel() const noexcept
+            {
+                return (_level);
+            }
+
+            /**
+             * Returns the time stamp of this record
+             * @return number of microseconds since January 1, 1970 UTC
+             */
+            inline int64 GetTime() const noexcept
+            {
+                return (_time);
+            }
+
+            /**
+             * Returns the format string
+             * @return low-level format string or nullptr if this record is already formatted
+             */
+            inline const char *GetFormat() const noexcept
+            {
+                return (_format);
+            }
+
+            /**
+             * Returns the already formatted text of this record
+             * @return high-level string, empty if this record is not formatted yet
+             */
+            inline const String &GetText() const noexcept
+            {
+                return (_text);
+            }
+
+            /**
+             * Returns the number of captured arguments
+             * @return number of arguments as unsigned
+             */
+            inline fsize GetArgumentCount() const noexcept
+            {
+                return (_argc);
+            }
+
+            /**
+             * Builds the message text
+             * @return new formatted string
+             */
+            String ToString() const;
+        };
+    }
+}
@@ -31,13 +31,46 @@
 #include "Framework/Collection/List.hpp"
 #include "Framework/Log/ILogAdapter.hpp"
 #include "Framework/Log/ELogLevel.hpp"
+#include "Framework/System/Mutex.hpp"
+#include "Framework/System/ScopeLock.hpp"
+
+#ifndef BP_LOG_MAX_LEVEL
+    /**
+     * Compile-time maximum log level as an integer (see ELogLevel): messages with a greater level are compiled out.
+     * Define it to -1 to remove all log messages
+     */
+    #define BP_LOG_MAX_LEVEL 3
+#endif
+
+#if BP_LOG_MAX_LEVEL >= 0
+    #define BP_LOG_ERROR(logger, ...) (logger).Error(__VA_ARGS__)
+#else
+    #define BP_LOG_ERROR(logger, ...) ((void)0)
+#endif
+#if BP_LOG_MAX_LEVEL >= 1
+    #define BP_LOG_WARNING(logger, ...) (logger).Warning(__VA_ARGS__)
+#else
+    #define BP_LOG_WARNING(logger, ...) ((void)0)
+#endif
+#if BP_LOG_MAX_LEVEL >= 2
+    #define BP_LOG_INFO(logger, ...) (logger).Info(__VA_ARGS__)
+#else
+    #define BP_LOG_INFO(logger, ...) ((void)0)
+#endif
+#if BP_LOG_MAX_LEVEL >= 3
+    #define BP_LOG_DEBUG(logger, ...) (logger).Debug(__VA_ARGS__)
+#else
+    #define BP_LOG_DEBUG(logger, ...) ((void)0)
+#endif
 
 namespace bpf
 {
     namespace log
     {
         /**
-         * Utility to handle message logging
+         * Utility to handle message logging.
+         * Logging functions are thread-safe: calls to the log adapters are serialized. To keep slow adapters off the
+         * calling thread, route them through an AsyncLogBackend
          */
         class BPF_API Logger
         {
@@ -45,15 +78,30 @@ namespace bpf
             collection::List<memory::UniquePtr<ILogAdapter>> _handlers;
             String _name;
             ELogLevel _level;
+            system::Mutex _lock;
 
             template <typename ...Args>
             inline void LogMessage(const ELogLevel level, const String &format, Args &&...args)
             {
-                if (level > _level)
+                if ((int)level > BP_LOG_MAX_LEVEL || level > _level)
                     return;
+                auto msg = String::Format(format, std::forward<Args &&>(args)...);
+                system::ScopeLock lock(_lock);
                 for (auto &ptr : _handlers)
-                    ptr->LogMessage(level, _name, String::Format(format, std::forward<Args &&>(args)...));
+                    ptr->LogMessage(level, _name, msg);
             }
+
+            template <typename ...Args>
+            inline void LogStructured(const ELogLevel level, const char *format, const Args &...args)
+            {
+                if ((int)level > BP_LOG_MAX_LEVEL || level > _level)
+                    return;
+                LogRecord record(level, format, args...);
+                system::ScopeLock lock(_lock);
+                for (auto &ptr : _handlers)
+                    ptr->Log(_name, record);
+            }
+
         public:
             /**
              * Constructs a Logger
@@ -97,6 +145,11 @@ namespace bpf
              */
             void AddHandler(memory::UniquePtr<ILogAdapter> &&ptr);
 
+            /**
+             * Flushes all log adapters
+             */
+            void Flush();
+
             /**
              * Logs an information message
              * @tparam Args the type of arguments
@@ -109,6 +162,33 @@ namespace bpf
                 LogMessage(ELogLevel::INFO, format, std::forward<Args &>(args)...);
             }
 
+            /**
+             * Logs an information message without building any string until a log adapter needs the text
+             * @tparam N the size of the format string
+             * @tparam Args the type of arguments
+             * @param format the format (see bpf::String::Format for more information); a string literal, it is only
+             * referenced by the message
+             * @param args the argument values
+             */
+            template <fsize N, typename ...Args>
+            inline void Info(const char (&format)[N], Args &&...args)
+            {
+                LogStructured(ELogLevel::INFO, format, args...);
+            }
+
+            /**
+             * Logs an information message from a mutable character buffer, the format is copied
+             * @tparam N the size of the buffer
+             * @tparam Args the type of arguments
+             * @param format the format (see bpf::String::Format for more information)
+             * @param args the argument values
+             */
+            template <fsize N, typename ...Args>
+            inline void Info(char (&format)[N], Args &&...args)
+            {
+                LogMessage(ELogLevel::INFO, String(format), std::forward<Args &&>(args)...);
+            }
+
             /**
              * Logs a debug message
              * @tparam Args the type of arguments
@@ -121,6 +201,33 @@ namespace bpf
                 LogMessage(ELogLevel::DEBUG, format, std::forward<Args &&>(args)...);
             }
 
+            /**
+             * Logs a debug message without building any string until a log adapter needs the text
+             * @tparam N the size of the format string
+             * @tparam Args the type of arguments
+             * @param format the format (see bpf::String::Format for more information); a string literal, it is only
+             * referenced by the message
+             * @param args the argument values
+             */
+            template <fsize N, typename ...Args>
+            inline void Debug(const char (&format)[N], Args &&...args)
+            {
+                LogStructured(ELogLevel::DEBUG, format, args...);
+            }
+
+            /**
+             * Logs a debug message from a mutable character buffer, the format is copied
+             * @tparam N the size of the buffer
+             * @tparam Args the type of arguments
+             * @param format the format (see bpf::String::Format for more information)
+             * @param args the argument values
+             */
+            template <fsize N, typename ...Args>
+            inline void Debug(char (&format)[N], Args &&...args)
+            {
+                LogMessage(ELogLevel::DEBUG, String(format), std::forward<Args &&>(args)...);
+            }
+
             /**
              * Logs a warning message
              * @tparam Args the type of arguments
@@ -133,6 +240,33 @@ namespace bpf
                 LogMessage(ELogLevel::WARNING, format, std::forward<Args &&>(args)...);
             }
 
+            /**
+             * Logs a warning message without building any string until a log adapter needs the text
+             * @tparam N the size of the format string
+             * @tparam Args the type of arguments
+             * @param format the format (see bpf::String::Format for more information); a string literal, it is only
+             * referenced by the message
+             * @param args the argument values
+             */
+            template <fsize N, typename ...Args>
+            inline void Warning(const char (&format)[N], Args &&...args)
+            {
+                LogStructured(ELogLevel::WARNING, format, args...);
+            }
+
+            /**
+             * Logs a warning message from a mutable character buffer, the format is copied
+             * @tparam N the size of the buffer
+             * @tparam Args the type of arguments
+             * @param format the format (see bpf::String::Format for more information)
+             * @param args the argument values
+             */
+            template <fsize N, typename ...Args>
+            inline void Warning(char (&format)[N], Args &&...args)
+            {
+                LogMessage(ELogLevel::WARNING, String(format), std::forward<Args &&>(args)...);
+            }
+
             /**
              * Logs an error message
              * @tparam Args the type of arguments
@@ -144,6 +278,33 @@ namespace bpf
             {
                 LogMessage(ELogLevel::ERROR, format, std::forward<Args &&>(args)...);
             }
+
+            /**
+             * Logs an error message without building any string until a log adapter needs the text
+             * @tparam N the size of the format string
+             * @tparam Args the type of arguments
+             * @param format the format (see bpf::String::Format for more information); a string literal, it is only
+             * referenced by the message
+             * @param args the argument values
+             */
+            template <fsize N, typename ...Args>
+            inline void Error(const char (&format)[N], Args &&...args)
+            {
+                LogStructured(ELogLevel::ERROR, format, args...);
+            }
+
+            /**
+             * Logs an error message from a mutable character buffer, the format is copied
+             * @tparam N the size of the buffer
+             * @tparam Args the type of arguments
+             * @param format the format (see bpf::String::Format for more information)
+             * @param args the argument values
+             */
+            template <fsize N, typename ...Args>
+            inline void Error(char (&format)[N], Args &&...args)
+            {
+                LogMessage(ELogLevel::ERROR, String(format), std::forward<Args &&>(args)...);
+            }
         };
     }
 }
@@ -0,0 +1,237 @@
+// Copyright (c) 2020, BlockProject 3D
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without modification,
+// are permitted provided that the following conditions are met:
+// 
+//     * Redistributions of source code must retain the above copyright notice,
+//       this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above copyright notice,
+//       this list of conditions and the following disclaimer in the documentation
+//       and/or other materials provided with the distribution.
+//     * Neither the name of BlockProject 3D nor the names of its contributors
+//       may be used to endorse or promote products derived from this software
+//       without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#pragma once
+#include "Framework/Math/BoundingBox.hpp"
+#include "Framework/Math/Matrix.hpp"
+#include "Framework/Math/Quaternion.hpp"
+#include "Framework/Math/Vector.hpp"
+#include "Framework/System/ThreadPool.hpp"
+
+namespace bpf
+{
+    namespace math
+    {
+        /**
+         * Structure of arrays view over 3D vectors: coordinates are stored in 3 separate arrays.
+         * The span does not own the arrays
+         * @tparam T the number type
+         */
+        template <typename T>
+        class BP_TPL_API Vector3Span
+        {
+        public:
+            /**
+             * X coordinates
+             */
+            T *X;
+
+            /**
+             * Y coordinates
+             */
+            T *Y;
+
+            /**
+             * Z coordinates
+             */
+            T *Z;
+
+            /**
+             * Number of vectors
+             */
+            fsize Size;
+
+            /**
+             * Constructs a Vector3Span
+             * @param x array of X coordinates
+             * @param y array of Y coordinates
+             * @param z array of Z coordinates
+             * @param size number of vectors
+             */
+            inline Vector3Span(T *x, T *y, T *z, const fsize size) noexcept
+                : X(x)
+                , Y(y)
+                , Z(z)
+                , Size(size)
+            {
+            }
+
+            /**
+             * Returns a span over a range of vectors
+             * @param pos index of the first vector
+             * @param size number of vectors
+             * @return new Vector3Span
+             */
+            inline Vector3Span Sub(const fsize pos, const fsize size) const noexcept
+            {
+                return (Vector3Span(X + pos, Y + pos, Z + pos, size));
+            }
+
+            /**
+             * Reads a vector
+             * @param id the index of the vector
+             * @return copy of the vector
+             */
+            inline Vector3<T> operator[](const fsize id) const noexcept
+            {
+                return (Vector3<T>(X[id], Y[id], Z[id]));
+            }
+        };
+
+        /**
+         * Batch operations over arrays of vectors, matrices and quaternions.
+         * All functions of this class accept the same array as input and output.
+         * Single precision specializations use the SIMD kernels; prefer Vector3Span over arrays of Vector3
+         * as the structure of arrays layout transforms 4 vectors per instruction.
+         * The ThreadPool overloads split the arrays using ThreadPool::ParallelFor
+         * @tparam T the number type
+         */
+        template <typename T>
+        class BP_TPL_API Batch
+        {
+        public:
+            /**
+             * Transforms an array of 4D vectors
+             * @param matrix the transform matrix
+             * @param in vectors to transform
+             * @param out receives the transformed vectors
+             * @param count number of vectors
+             */
+            static void Transform(const Matrix4<T> &matrix, const Vector4<T> *in, Vector4<T> *out, fsize count) noexcept;
+
+            /**
+             * Transforms an array of 3D points (w = 1)
+             * @param matrix the transform matrix
+             * @param in points to transform
+             * @param out receives the transformed points
+             * @param count number of points
+             */
+            static void TransformPoints(const Matrix4<T> &matrix, const Vector3<T> *in, Vector3<T> *out, fsize count) noexcept;
+
+            /**
+             * Transforms an array of 3D directions (w = 0): translation is ignored
+             * @param matrix the transform matrix
+             * @param in directions to transform
+             * @param out receives the transformed directions
+             * @param count number of directions
+             */
+            static void TransformDirections(const Matrix4<T> &matrix, const Vector3<T> *in, Vector3<T> *out, fsize count) noexcept;
+
+            /**
+             * Transforms an array of 2D points (w = 1)
+             * @param matrix the transform matrix
+             * @param in points to transform
+             * @param out receives the transformed points
+             * @param count number of points
+             */
+            static void TransformPoints(const Matrix3<T> &matrix, const Vector2<T> *in, Vector2<T> *out, fsize count) noexcept;
+
+            /**
+             * Transforms a span of 3D points (w = 1)
+             * @param matrix the transform matrix
+             * @param in points to transform
+             * @param out receives the transformed points, must be at least as large as in
+             */
+            static void TransformPoints(const Matrix4<T> &matrix, const Vector3Span<T> &in, const Vector3Span<T> &out) noexcept;
+
+            /**
+             * Transforms a span of 3D directions (w = 0)
+             * @param matrix the transform matrix
+             * @param in directions to transform
+             * @param out receives the transformed directions, must be at least as large as in
+             */
+            static void TransformDirections(const Matrix4<T> &matrix, const Vector3Span<T> &in, const Vector3Span<T> &out) noexcept;
+
+            /**
+             * Computes the bounding box of an array of points
+             * @param points the points
+             * @param count number of points
+             * @return new BoundingBox, empty and centered at zero if count is 0
+             */
+            static BoundingBox<T> ComputeBounds(const Vector3<T> *points, fsize count) noexcept;
+
+            /**
+             * Computes the bounding box of a span of points
+             * @param points the points
+             * @return new BoundingBox, empty and centered at zero if the span is empty
+             */
+            static BoundingBox<T> ComputeBounds(const Vector3Span<T> &points) noexcept;
+
+            /**
+             * Converts an array of quaternions to rotation matrices
+             * @param in quaternions to convert
+             * @param out receives the matrices
+             * @param count number of quaternions
+             */
+            static void ToMatrices(const Quaternion<T> *in, Matrix4<T> *out, fsize count) noexcept;
+
+            /**
+             * Transforms an array of 4D vectors in parallel
+             * @param pool the ThreadPool to run on
+             * @param matrix the transform matrix
+             * @param in vectors to transform
+             * @param out receives the transformed vectors
+             * @param count number of vectors
+             */
+            static void Transform(system::ThreadPool &pool, const Matrix4<T> &matrix, const Vector4<T> *in, Vector4<T> *out, fsize count);
+
+            /**
+             * Transforms an array of 3D points (w = 1) in parallel
+             * @param pool the ThreadPool to run on
+             * @param matrix the transform matrix
+             * @param in points to transform
+             * @param out receives the transformed points
+             * @param count number of points
+             */
+            static void TransformPoints(system::ThreadPool &pool, const Matrix4<T> &matrix, const Vector3<T> *in, Vector3<T> *out, fsize count);
+
+            /**
+             * Transforms a span of 3D points (w = 1) in parallel
+             * @param pool the ThreadPool to run on
+             * @param matrix the transform matrix
+             * @param in points to transform
+             * @param out receives the transformed points, must be at least as large as in
+             */
+            static void TransformPoints(system::ThreadPool &pool, const Matrix4<T> &matrix, const Vector3Span<T> &in, const Vector3Span<T> &out);
+
+            /**
+             * Converts an array of quaternions to rotation matrices in parallel
+             * @param pool the ThreadPool to run on
+             * @param in quaternions to convert
+             * @param out receives the matrices
+             * @param count number of quaternions
+             */
+            static void ToMatrices(system::ThreadPool &pool, const Quaternion<T> *in, Matrix4<T> *out, fsize count);
+        };
+
+        using Vector3fSpan = Vector3Span<float>;
+        using Batchf = Batch<float>;
+    }
+}
+
+#include "Framework/Math/Batch.impl.hpp"
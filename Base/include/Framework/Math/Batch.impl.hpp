@@ -0,0 +1,284 @@
+// Copyright (c) 2020, BlockProject 3D
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without modification,
+// are permitted provided that the following conditions are met:
+// 
+//     * Redistributions of source code must retain the above copyright notice,
+//       this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above copyright notice,
+//       this list of conditions and the following disclaimer in the documentation
+//       and/or other materials provided with the distribution.
+//     * Neither the name of BlockProject 3D nor the names of its contributors
+//       may be used to endorse or promote products derived from this software
+//       without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#pragma once
+#include "Framework/Math/SIMD.hpp"
+
+namespace bpf
+{
+    namespace math
+    {
+        template <typename T>
+        void Batch<T>::Transform(const Matrix4<T> &matrix, const Vector4<T> *in, Vector4<T> *out, fsize count) noexcept
+        {
+            const T *m = *matrix;
+
+            for (fsize i = 0; i != count; ++i)
+            {
+                T x = in[i].X;
+                T y = in[i].Y;
+                T z = in[i].Z;
+                T w = in[i].W;
+                out[i].X = m[0] * x + m[1] * y + m[2] * z + m[3] * w;
+                out[i].Y = m[4] * x + m[5] * y + m[6] * z + m[7] * w;
+                out[i].Z = m[8] * x + m[9] * y + m[10] * z + m[11] * w;
+                out[i].W = m[12] * x + m[13] * y + m[14] * z + m[15] * w;
+            }
+        }
+
+        template <typename T>
+        void Batch<T>::TransformPoints(const Matrix4<T> &matrix, const Vector3<T> *in, Vector3<T> *out, fsize count) noexcept
+        {
+            const T *m = *matrix;
+
+            for (fsize i = 0; i != count; ++i)
+            {
+                T x = in[i].X;
+                T y = in[i].Y;
+                T z = in[i].Z;
+                out[i].X = m[0] * x + m[1] * y + m[2] * z + m[3];
+                out[i].Y = m[4] * x + m[5] * y + m[6] * z + m[7];
+                out[i].Z = m[8] * x + m[9] * y + m[10] * z + m[11];
+            }
+        }
+
+        template <typename T>
+        void Batch<T>::TransformDirections(const Matrix4<T> &matrix, const Vector3<T> *in, Vector3<T> *out, fsize count) noexcept
+        {
+            const T *m = *matrix;
+
+            for (fsize i = 0; i != count; ++i)
+            {
+                T x = in[i].X;
+                T y = in[i].Y;
+                T z = in[i].Z;
+                out[i].X = m[0] * x + m[1] * y + m[2] * z;
+                out[i].Y = m[4] * x + m[5] * y + m[6] * z;
+                out[i].Z = m[8] * x + m[9] * y + m[10] * z;
+            }
+        }
+
+        template <typename T>
+        void Batch<T>::TransformPoints(const Matrix3<T> &matrix, const Vector2<T> *in, Vector2<T> *out, fsize count) noexcept
+        {
+            const T *m = *matrix;
+
+            for (fsize i = 0; i != count; ++i)
+            {
+                T x = in[i].X;
+                T y = in[i].Y;
+                out[i].X = m[0] * x + m[1] * y + m[2];
+                out[i].Y = m[3] * x + m[4] * y + m[5];
+            }
+        }
+
+        template <typename T>
+        void Batch<T>::TransformPoints(const Matrix4<T> &matrix, const Vector3Span<T> &in, const Vector3Span<T> &out) noexcept
+        {
+            const T *m = *matrix;
+
+            for (fsize i = 0; i != in.Size; ++i)
+            {
+                T x = in.X[i];
+                T y = in.Y[i];
+                T z = in.Z[i];
+                out.X[i] = m[0] * x + m[1] * y + m[2] * z + m[3];
+                out.Y[i] = m[4] * x + m[5] * y + m[6] * z + m[7];
+                out.Z[i] = m[8] * x + m[9] * y + m[10] * z + m[11];
+            }
+        }
+
+        template <typename T>
+        void Batch<T>::TransformDirections(const Matrix4<T> &matrix, const Vector3Span<T> &in, const Vector3Span<T> &out) noexcept
+        {
+            const T *m = *matrix;
+
+            for (fsize i = 0; i != in.Size; ++i)
+            {
+                T x = in.X[i];
+                T y = in.Y[i];
+                T z = in.Z[i];
+                out.X[i] = m[0] * x + m[1] * y + m[2] * z;
+                out.Y[i] = m[4] * x + m[5] * y + m[6] * z;
+                out.Z[i] = m[8] * x + m[9] * y + m[10] * z;
+            }
+        }
+
+        template <typename T>
+        BoundingBox<T> Batch<T>::ComputeBounds(const Vector3<T> *points, fsize count) noexcept
+        {
+            if (count == 0)
+                return (BoundingBox<T>(Vector3<T>::Zero, Vector3<T>::Zero));
+            Vector3<T> min = points[0];
+            Vector3<T> max = points[0];
+            for (fsize i = 1; i != count; ++i)
+            {
+                const Vector3<T> &p = points[i];
+                if (p.X < min.X)
+                    min.X = p.X;
+                if (p.Y < min.Y)
+                    min.Y = p.Y;
+                if (p.Z < min.Z)
+                    min.Z = p.Z;
+                if (p.X > max.X)
+                    max.X = p.X;
+                if (p.Y > max.Y)
+                    max.Y = p.Y;
+                if (p.Z > max.Z)
+                    max.Z = p.Z;
+            }
+            return (BoundingBox<T>::FromMinMax(min, max));
+        }
+
+        template <typename T>
+        BoundingBox<T> Batch<T>::ComputeBounds(const Vector3Span<T> &points) noexcept
+        {
+            if (points.Size == 0)
+                return (BoundingBox<T>(Vector3<T>::Zero, Vector3<T>::Zero));
+            Vector3<T> min = points[0];
+            Vector3<T> max = points[0];
+            for (fsize i = 1; i != points.Size; ++i)
+            {
+                if (points.X[i] < min.X)
+                    min.X = points.X[i];
+                if (points.Y[i] < min.Y)
+                    min.Y = points.Y[i];
+                if (points.Z[i] < min.Z)
+                    min.Z = points.Z[i];
+                if (points.X[i] > max.X)
+                    max.X = points.X[i];
+                if (points.Y[i] > max.Y)
+                    max.Y = points.Y[i];
+                if (points.Z[i] > max.Z)
+                    max.Z = points.Z[i];
+            }
+            return (BoundingBox<T>::FromMinMax(min, max));
+        }
+
+        template <typename T>
+        void Batch<T>::ToMatrices(const Quaternion<T> *in, Matrix4<T> *out, fsize count) noexcept
+        {
+            for (fsize i = 0; i != count; ++i)
+            {
+                const Quaternion<T> &q = in[i];
+                T ww = q.W * q.W;
+                T ii = q.I * q.I;
+                T jj = q.J * q.J;
+                T kk = q.K * q.K;
+                T ij = 2 * q.I * q.J;
+                T ik = 2 * q.I * q.K;
+                T jk = 2 * q.J * q.K;
+                T wi = 2 * q.W * q.I;
+                T wj = 2 * q.W * q.J;
+                T wk = 2 * q.W * q.K;
+                T *m = *out[i];
+                m[0] = ww + ii - jj - kk;
+                m[1] = ij - wk;
+                m[2] = ik + wj;
+                m[3] = 0;
+                m[4] = ij + wk;
+                m[5] = ww - ii + jj - kk;
+                m[6] = jk - wi;
+                m[7] = 0;
+                m[8] = ik - wj;
+                m[9] = jk + wi;
+                m[10] = ww - ii - jj + kk;
+                m[11] = 0;
+                m[12] = 0;
+                m[13] = 0;
+                m[14] = 0;
+                m[15] = 1;
+            }
+        }
+
+        template <typename T>
+        void Batch<T>::Transform(system::ThreadPool &pool, const Matrix4<T> &matrix, const Vector4<T> *in, Vector4<T> *out, fsize count)
+        {
+            pool.ParallelFor(count, [&](fsize start, fsize end) {
+                Transform(matrix, in + start, out + start, end - start);
+            });
+        }
+
+        template <typename T>
+        void Batch<T>::TransformPoints(system::ThreadPool &pool, const Matrix4<T> &matrix, const Vector3<T> *in, Vector3<T> *out, fsize count)
+        {
+            pool.ParallelFor(count, [&](fsize start, fsize end) {
+                TransformPoints(matrix, in + start, out + start, end - start);
+            });
+        }
+
+        template <typename T>
+        void Batch<T>::TransformPoints(system::ThreadPool &pool, const Matrix4<T> &matrix, const Vector3Span<T> &in, const Vector3Span<T> &out)
+        {
+            pool.ParallelFor(in.Size, [&](fsize start, fsize end) {
+                TransformPoints(matrix, in.Sub(start, end - start), out.Sub(start, end - start));
+            });
+        }
+
+        template <typename T>
+        void Batch<T>::ToMatrices(system::ThreadPool &pool, const Quaternion<T> *in, Matrix4<T> *out, fsize count)
+        {
+            pool.ParallelFor(count, [&](fsize start, fsize end) {
+                ToMatrices(in + start, out + start, end - start);
+            });
+        }
+
+        template <>
+        inline void Batch<float>::Transform(const Matrix4<float> &matrix, const Vector4<float> *in, Vector4<float> *out, fsize count) noexcept
+        {
+            // Vector4f is 4 contiguous floats, arrays of Vector4f can be handed as is to the kernel
+            if (count > 0)
+                simd::Mat4MulVec4Array(*matrix, &in->X, &out->X, count);
+        }
+
+        template <>
+        inline void Batch<float>::TransformPoints(const Matrix4<float> &matrix, const Vector3Span<float> &in, const Vector3Span<float> &out) noexcept
+        {
+            simd::Mat4TransformSoA(*matrix, in.X, in.Y, in.Z, out.X, out.Y, out.Z, in.Size, 1.0f);
+        }
+
+        template <>
+        inline void Batch<float>::TransformDirections(const Matrix4<float> &matrix, const Vector3Span<float> &in, const Vector3Span<float> &out) noexcept
+        {
+            simd::Mat4TransformSoA(*matrix, in.X, in.Y, in.Z, out.X, out.Y, out.Z, in.Size, 0.0f);
+        }
+
+        template <>
+        inline BoundingBox<float> Batch<float>::ComputeBounds(const Vector3Span<float> &points) noexcept
+        {
+            if (points.Size == 0)
+                return (BoundingBox<float>(Vector3<float>::Zero, Vector3<float>::Zero));
+            Vector3<float> min;
+            Vector3<float> max;
+            simd::MinMax(points.X, points.Size, min.X, max.X);
+            simd::MinMax(points.Y, points.Size, min.Y, max.Y);
+            simd::MinMax(points.Z, points.Size, min.Z, max.Z);
+            return (BoundingBox<float>::FromMinMax(min, max));
+        }
+    }
+}
@@ -0,0 +1,234 @@
+// Copyright (c) 2020, BlockProject 3D
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without modification,
+// are permitted provided that the following conditions are met:
+// 
+//     * Redistributions of source code must retain the above copyright notice,
+//       this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above copyright notice,
+//       this list of conditions and the following disclaimer in the documentation
+//       and/or other materials provided with the distribution.
+//     * Neither the name of BlockProject 3D nor the names of its contributors
+//       may be used to endorse or promote products derived from this software
+//       without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#pragma once
+#include "Framework/Math/SIMD.hpp"
+#include "Framework/Memory/MemUtils.hpp"
+
+namespace bpf
+{
+    namespace system
+    {
+        class ThreadPool;
+    }
+
+    namespace math
+    {
+        namespace _bpf_internal_gemm
+        {
+            /**
+             * Register tile of the micro-kernel: Run adds to c the MR x NR product of an MR rows panel of A
+             * and an NR columns panel of B, both packed k-major
+             */
+            template <typename T>
+            struct Kernel
+            {
+                enum
+                {
+                    MR = 4,
+                    NR = 4
+                };
+
+                static void Run(const fsize kc, const T *a, const T *b, T *c, const fsize ldc) noexcept
+                {
+                    T acc[MR * NR];
+
+                    for (fsize i = 0; i != MR * NR; ++i)
+                        acc[i] = 0;
+                    for (fsize k = 0; k != kc; ++k, a += MR, b += NR)
+                    {
+                        for (fsize i = 0; i != MR; ++i)
+                        {
+                            for (fsize j = 0; j != NR; ++j)
+                                acc[i * NR + j] += a[i] * b[j];
+                        }
+                    }
+                    for (fsize i = 0; i != MR; ++i)
+                    {
+                        for (fsize j = 0; j != NR; ++j)
+                            c[i * ldc + j] += acc[i * NR + j];
+                    }
+                }
+            };
+
+#ifdef BP_MATH_SSE
+            template <>
+            struct Kernel<float>
+            {
+                enum
+                {
+                    MR = 4,
+                    NR = 8
+                };
+
+                static void Run(const fsize kc, const float *a, const float *b, float *c, const fsize ldc) noexcept
+                {
+                    __m128 c00 = _mm_setzero_ps(), c01 = _mm_setzero_ps();
+                    __m128 c10 = _mm_setzero_ps(), c11 = _mm_setzero_ps();
+                    __m128 c20 = _mm_setzero_ps(), c21 = _mm_setzero_ps();
+                    __m128 c30 = _mm_setzero_ps(), c31 = _mm_setzero_ps();
+
+                    for (fsize k = 0; k != kc; ++k, a += MR, b += NR)
+                    {
+                        __m128 b0 = _mm_loadu_ps(b);
+                        __m128 b1 = _mm_loadu_ps(b + 4);
+                        __m128 a0 = _mm_set1_ps(a[0]);
+                        __m128 a1 = _mm_set1_ps(a[1]);
+                        __m128 a2 = _mm_set1_ps(a[2]);
+                        __m128 a3 = _mm_set1_ps(a[3]);
+                        c00 = _mm_add_ps(c00, _mm_mul_ps(a0, b0));
+                        c01 = _mm_add_ps(c01, _mm_mul_ps(a0, b1));
+                        c10 = _mm_add_ps(c10, _mm_mul_ps(a1, b0));
+                        c11 = _mm_add_ps(c11, _mm_mul_ps(a1, b1));
+                        c20 = _mm_add_ps(c20, _mm_mul_ps(a2, b0));
+                        c21 = _mm_add_ps(c21, _mm_mul_ps(a2, b1));
+                        c30 = _mm_add_ps(c30, _mm_mul_ps(a3, b0));
+                        c31 = _mm_add_ps(c31, _mm_mul_ps(a3, b1));
+                    }
+                    Store(c, c00, c01);
+                    Store(c + ldc, c10, c11);
+                    Store(c + 2 * ldc, c20, c21);
+                    Store(c + 3 * ldc, c30, c31);
+                }
+
+            private:
+                inline static void Store(float *c, const __m128 lo, const __m128 hi) noexcept
+                {
+                    _mm_storeu_ps(c, _mm_add_ps(_mm_loadu_ps(c), lo));
+                    _mm_storeu_ps(c + 4, _mm_add_ps(_mm_loadu_ps(c + 4), hi));
+                }
+            };
+
+            template <>
+            struct Kernel<double>
+            {
+                enum
+                {
+                    MR = 4,
+                    NR = 4
+                };
+
+                static void Run(const fsize kc, const double *a, const double *b, double *c, const fsize ldc) noexcept
+                {
+                    __m128d c00 = _mm_setzero_pd(), c01 = _mm_setzero_pd();
+                    __m128d c10 = _mm_setzero_pd(), c11 = _mm_setzero_pd();
+                    __m128d c20 = _mm_setzero_pd(), c21 = _mm_setzero_pd();
+                    __m128d c30 = _mm_setzero_pd(), c31 = _mm_setzero_pd();
+
+                    for (fsize k = 0; k != kc; ++k, a += MR, b += NR)
+                    {
+                        __m128d b0 = _mm_loadu_pd(b);
+                        __m128d b1 = _mm_loadu_pd(b + 2);
+                        __m128d a0 = _mm_set1_pd(a[0]);
+                        __m128d a1 = _mm_set1_pd(a[1]);
+                        __m128d a2 = _mm_set1_pd(a[2]);
+                        __m128d a3 = _mm_set1_pd(a[3]);
+                        c00 = _mm_add_pd(c00, _mm_mul_pd(a0, b0));
+                        c01 = _mm_add_pd(c01, _mm_mul_pd(a0, b1));
+                        c10 = _mm_add_pd(c10, _mm_mul_pd(a1, b0));
+                        c11 = _mm_add_pd(c11, _mm_mul_pd(a1, b1));
+                        c20 = _mm_add_pd(c20, _mm_mul_pd(a2, b0));
+                        c21 = _mm_add_pd(c21, _mm_mul_pd(a2, b1));
+                        c30 = _mm_add_pd(c30, _mm_mul_pd(a3, b0));
+                        c31 = _mm_add_pd(c31, _mm_mul_pd(a3, b1));
+                    }
+                    Store(c, c00, c01);
+                    Store(c + ldc, c10, c11);
+                    Store(c + 2 * ldc, c20, c21);
+                    Store(c + 3 * ldc, c30, c31);
+                }
+
+            private:
+                inline static void Store(double *c, const __m128d lo, const __m128d hi) noexcept
+                {
+                    _mm_storeu_pd(c, _mm_add_pd(_mm_loadu_pd(c), lo));
+                    _mm_storeu_pd(c + 2, _mm_add_pd(_mm_loadu_pd(c + 2), hi));
+                }
+            };
+#endif
+        }
+
+        /**
+         * Dense matrix product engine on row major arrays, used by the dynamic Matrix.
+         * Large products are tiled so that a KC x NC panel of B stays in L2/L3 and an MC x KC panel of A in L1/L2;
+         * both panels are packed into contiguous micro-panels consumed by a register blocked micro-kernel
+         * (SSE for float and double)
+         * @tparam T the number type
+         */
+        template <typename T>
+        class BP_TPL_API Gemm
+        {
+        private:
+            using Kernel = _bpf_internal_gemm::Kernel<T>;
+
+            static void PackA(const T *a, fsize lda, fsize mc, fsize kc, T *dest) noexcept;
+            static void PackB(const T *b, fsize ldb, fsize kc, fsize nc, T *dest) noexcept;
+
+        public:
+            /**
+             * Number of rows of A per block
+             */
+            static constexpr fsize MC = 128;
+
+            /**
+             * Depth of a block
+             */
+            static constexpr fsize KC = 256;
+
+            /**
+             * Number of columns of B per block
+             */
+            static constexpr fsize NC = 2048;
+
+            /**
+             * Computes c += a * b
+             * @param a n x m row major matrix
+             * @param b m x p row major matrix
+             * @param c n x p row major matrix
+             * @param n number of rows of a
+             * @param m number of columns of a
+             * @param p number of columns of b
+             */
+            static void MultiplyAdd(const T *a, const T *b, T *c, fsize n, fsize m, fsize p);
+
+            /**
+             * Computes c += a * b splitting the rows of c across a ThreadPool
+             * @param pool the ThreadPool to run on
+             * @param a n x m row major matrix
+             * @param b m x p row major matrix
+             * @param c n x p row major matrix
+             * @param n number of rows of a
+             * @param m number of columns of a
+             * @param p number of columns of b
+             */
+            static void MultiplyAdd(system::ThreadPool &pool, const T *a, const T *b, T *c, fsize n, fsize m, fsize p);
+        };
+    }
+}
+
+#include "Framework/Math/Gemm.impl.hpp"
@@ -0,0 +1,172 @@
+// Copyright (c) 2020, BlockProject 3D
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without modification,
+// are permitted provided that the following conditions are met:
+// 
+//     * Redistributions of source code must retain the above copyright notice,
+//       this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above copyright notice,
+//       this list of conditions and the following disclaimer in the documentation
+//       and/or other materials provided with the distribution.
+//     * Neither the name of BlockProject 3D nor the names of its contributors
+//       may be used to endorse or promote products derived from this software
+//       without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#pragma once
+
+namespace bpf
+{
+    namespace math
+    {
+        namespace _bpf_internal_gemm
+        {
+            /**
+             * Runs func over [0, count) on a ThreadPool. T makes every call dependent: the ThreadPool definition is
+             * then only needed where the parallel overloads are instantiated and not by every Matrix user
+             */
+            template <typename T, typename Pool, typename Func>
+            inline void ParallelFor(Pool &pool, const fsize count, const Func &func, const fsize grain)
+            {
+                pool.ParallelFor(count, func, grain);
+            }
+        }
+
+        template <typename T>
+        constexpr fsize Gemm<T>::MC;
+
+        template <typename T>
+        constexpr fsize Gemm<T>::KC;
+
+        template <typename T>
+        constexpr fsize Gemm<T>::NC;
+
+        template <typename T>
+        void Gemm<T>::PackA(const T *a, const fsize lda, const fsize mc, const fsize kc, T *dest) noexcept
+        {
+            for (fsize i = 0; i < mc; i += Kernel::MR)
+            {
+                for (fsize k = 0; k != kc; ++k)
+                {
+                    for (fsize r = 0; r != Kernel::MR; ++r)
+                        *dest++ = i + r < mc ? a[(i + r) * lda + k] : (T)0;
+                }
+            }
+        }
+
+        template <typename T>
+        void Gemm<T>::PackB(const T *b, const fsize ldb, const fsize kc, const fsize nc, T *dest) noexcept
+        {
+            for (fsize j = 0; j < nc; j += Kernel::NR)
+            {
+                for (fsize k = 0; k != kc; ++k)
+                {
+                    const T *row = b + k * ldb + j;
+                    if (j + Kernel::NR <= nc)
+                    {
+                        for (fsize c = 0; c != Kernel::NR; ++c)
+                            *dest++ = row[c];
+                    }
+                    else
+                    {
+                        for (fsize c = 0; c != Kernel::NR; ++c)
+                            *dest++ = j + c < nc ? row[c] : (T)0;
+                    }
+                }
+            }
+        }
+
+        template <typename T>
+        void Gemm<T>::MultiplyAdd(const T *a, const T *b, T *c, const fsize n, const fsize m, const fsize p)
+        {
+            if (n == 0 || m == 0 || p == 0)
+                return;
+            if (n * m * p <= 32 * 32 * 32)
+            {
+                // Packing does not pay off on small products: i-k-j order keeps the accesses to b and c contiguous
+                for (fsize i = 0; i != n; ++i)
+                {
+                    for (fsize k = 0; k != m; ++k)
+                    {
+                        T f = a[i * m + k];
+                        for (fsize j = 0; j != p; ++j)
+                            c[i * p + j] += f * b[k * p + j];
+                    }
+                }
+                return;
+            }
+            const fsize mr = Kernel::MR;
+            const fsize nr = Kernel::NR;
+            fsize mcMax = (n < MC ? n : MC) + mr - 1;
+            fsize kcMax = m < KC ? m : KC;
+            fsize ncMax = (p < NC ? p : NC) + nr - 1;
+            T *packA = memory::MemUtils::NewArray<T>((mcMax - mcMax % mr) * kcMax);
+            T *packB = memory::MemUtils::NewArray<T>((ncMax - ncMax % nr) * kcMax);
+            T edge[mr * nr];
+
+            for (fsize jc = 0; jc < p; jc += NC)
+            {
+                fsize nc = p - jc < NC ? p - jc : NC;
+                for (fsize pc = 0; pc < m; pc += KC)
+                {
+                    fsize kc = m - pc < KC ? m - pc : KC;
+                    PackB(b + pc * p + jc, p, kc, nc, packB);
+                    for (fsize ic = 0; ic < n; ic += MC)
+                    {
+                        fsize mc = n - ic < MC ? n - ic : MC;
+                        PackA(a + ic * m + pc, m, mc, kc, packA);
+                        for (fsize jr = 0; jr < nc; jr += nr)
+                        {
+                            for (fsize ir = 0; ir < mc; ir += mr)
+                            {
+                                T *dest = c + (ic + ir) * p + jc + jr;
+                                if (ir + mr <= mc && jr + nr <= nc)
+                                {
+                                    Kernel::Run(kc, packA + ir * kc, packB + jr * kc, dest, p);
+                                    continue;
+                                }
+                                // Partial tile on the border of c: compute into a scratch tile and add the valid part
+                                for (fsize i = 0; i != mr * nr; ++i)
+                                    edge[i] = 0;
+                                Kernel::Run(kc, packA + ir * kc, packB + jr * kc, edge, nr);
+                                for (fsize i = 0; i != mr && ir + i < mc; ++i)
+                                {
+                                    for (fsize j = 0; j != nr && jr + j < nc; ++j)
+                                        dest[i * p + j] += edge[i * nr + j];
+                                }
+                            }
+                        }
+                    }
+                }
+            }
+            memory::MemUtils::DeleteArray(packA, (mcMax - mcMax % mr) * kcMax);
+            memory::MemUtils::DeleteArray(packB, (ncMax - ncMax % nr) * kcMax);
+        }
+
+        template <typename T>
+        void Gemm<T>::MultiplyAdd(system::ThreadPool &pool, const T *a, const T *b, T *c, const fsize n, const fsize m,
+                                  const fsize p)
+        {
+            // Each part owns a band of rows of c, B panels are packed independently by every part
+            _bpf_internal_gemm::ParallelFor<T>(
+                pool, n,
+                [&](fsize start, fsize end) {
+                    MultiplyAdd(a + start * m, b, c + start * p, end - start, m, p);
+                },
+                Kernel::MR * 16);
+        }
+    }
+}
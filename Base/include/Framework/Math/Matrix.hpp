@@ -35,6 +35,11 @@
 
 namespace bpf
 {
+    namespace system
+    {
+        class ThreadPool;
+    }
+
     namespace math
     {
         /**
@@ -388,14 +393,23 @@ namespace bpf
             }
 
             /**
-             * Computes the inverse of this matrix
+             * Computes the inverse of this matrix, in closed form up to order 4 and by LU decomposition above
              * @throw NonInvertibleMatrixException if the matrix is not invertible (ie determinant is null)
              * @return new inversed matrix
              */
             Matrix<T, N, N> Inverse() const;
 
             /**
-             * Computes the determinant of this matrix
+             * Solves the linear system a * x = b using an LU decomposition with partial pivoting
+             * @param a the system matrix
+             * @param b the right hand side
+             * @throw NonInvertibleMatrixException if the matrix is singular
+             * @return the solution x
+             */
+            static Vector<T, N> Solve(const Matrix<T, N, N> &a, const Vector<T, N> &b);
+
+            /**
+             * Computes the determinant of this matrix, in closed form up to order 4 and by LU decomposition above
              * @return number
              */
             T GetDeterminant() const;
@@ -684,7 +698,7 @@ namespace bpf
             }
 
             /**
-             * Computes the inverse of this matrix
+             * Computes the inverse of this matrix, in closed form up to order 4 and by LU decomposition above
              * @throw NonInvertibleMatrixException if the matrix is not invertible (ie determinant is null)
              * @throw NonSquareMatrixException if the matrix is not a square matrix
              * @return new inversed matrix
@@ -692,7 +706,18 @@ namespace bpf
             Matrix<T> Inverse() const;
 
             /**
-             * Computes the determinant of this matrix
+             * Solves the linear system a * x = b using an LU decomposition with partial pivoting
+             * @param a the system matrix
+             * @param b the right hand side
+             * @throw NonSquareMatrixException if the matrix is not a square matrix
+             * @throw IncompatibleMatrixSizeException if b does not match the order of the matrix
+             * @throw NonInvertibleMatrixException if the matrix is singular
+             * @return the solution x
+             */
+            static Vector<T> Solve(const Matrix<T> &a, const Vector<T> &b);
+
+            /**
+             * Computes the determinant of this matrix, in closed form up to order 4 and by LU decomposition above
              * @throw NonSquareMatrixException if the matrix is not a square matrix
              * @return number
              */
@@ -732,6 +757,34 @@ namespace bpf
              */
             Matrix<T> operator*(const Matrix<T> &other) const;
 
+            /**
+             * Performs matrix-matrix multiplication, splitting large products across a ThreadPool
+             * @param pool the ThreadPool to run on
+             * @param a left operand
+             * @param b right operand
+             * @throw IncompatibleMatrixSizeException when the matrices have incompatible size
+             * @return new matrix
+             */
+            static Matrix<T> Multiply(system::ThreadPool &pool, const Matrix<T> &a, const Matrix<T> &b);
+
+            /**
+             * Adds the product a * b to this matrix without allocating a temporary, this must be neither a nor b
+             * @param a left operand
+             * @param b right operand
+             * @throw IncompatibleMatrixSizeException when the matrices have incompatible size
+             */
+            void MultiplyAdd(const Matrix<T> &a, const Matrix<T> &b);
+
+            /**
+             * Adds the product a * b to this matrix without allocating a temporary, this must be neither a nor b.
+             * Large products are split across a ThreadPool
+             * @param pool the ThreadPool to run on
+             * @param a left operand
+             * @param b right operand
+             * @throw IncompatibleMatrixSizeException when the matrices have incompatible size
+             */
+            void MultiplyAdd(system::ThreadPool &pool, const Matrix<T> &a, const Matrix<T> &b);
+
             /**
              * Performs matrix addition
              * @param other operand
@@ -27,6 +27,8 @@
 // SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #pragma once
+#include "Framework/Math/Gemm.hpp"
+#include "Framework/Math/SIMD.hpp"
 #include <utility>
 #undef minor //FUCK YOU LINUX
 #undef major //FUCK YOU LINUX
@@ -36,11 +38,328 @@
 #include "Framework/Math/NonSquareMatrixException.hpp"
 
 #include "Framework/Memory/MemUtils.hpp"
+#include <type_traits>
 
 namespace bpf
 {
     namespace math
     {
+        /**
+         * Row major square matrix kernels shared by the static and dynamic matrices.
+         * Orders up to 4 use closed forms, larger orders use an LU decomposition with partial pivoting (O(N^3))
+         * or the fraction-free Bareiss elimination for the determinant of integer matrices
+         */
+        namespace _bpf_internal_mat
+        {
+            template <typename T>
+            inline T Abs(const T val) noexcept
+            {
+                return ((val < 0) ? (-val) : (val));
+            }
+
+            template <typename T>
+            T ClosedDeterminant(const T *m, const fsize n) noexcept
+            {
+                switch (n)
+                {
+                case 0:
+                    return ((T)1);
+                case 1:
+                    return (m[0]);
+                case 2:
+                    return (m[0] * m[3] - m[1] * m[2]);
+                case 3:
+                    return (m[0] * (m[4] * m[8] - m[5] * m[7]) - m[1] * (m[3] * m[8] - m[5] * m[6])
+                            + m[2] * (m[3] * m[7] - m[4] * m[6]));
+                default:
+                    break;
+                }
+                // Laplace expansion along the two first rows: products of 2x2 determinants
+                T s0 = m[0] * m[5] - m[4] * m[1];
+                T s1 = m[0] * m[6] - m[4] * m[2];
+                T s2 = m[0] * m[7] - m[4] * m[3];
+                T s3 = m[1] * m[6] - m[5] * m[2];
+                T s4 = m[1] * m[7] - m[5] * m[3];
+                T s5 = m[2] * m[7] - m[6] * m[3];
+                T c0 = m[8] * m[13] - m[12] * m[9];
+                T c1 = m[8] * m[14] - m[12] * m[10];
+                T c2 = m[8] * m[15] - m[12] * m[11];
+                T c3 = m[9] * m[14] - m[13] * m[10];
+                T c4 = m[9] * m[15] - m[13] * m[11];
+                T c5 = m[10] * m[15] - m[14] * m[11];
+                return (s0 * c5 - s1 * c4 + s2 * c3 + s3 * c2 - s4 * c1 + s5 * c0);
+            }
+
+            template <typename T>
+            bool ClosedInverse(const T *m, const fsize n, T *out) noexcept
+            {
+                if (n == 0)
+                    return (true);
+                if (n == 1)
+                {
+                    if (m[0] == 0)
+                        return (false);
+                    out[0] = (T)1 / m[0];
+                    return (true);
+                }
+                if (n == 2)
+                {
+                    T det = m[0] * m[3] - m[1] * m[2];
+                    if (det == 0)
+                        return (false);
+                    det = (T)1 / det;
+                    out[0] = det * m[3];
+                    out[1] = det * -m[1];
+                    out[2] = det * -m[2];
+                    out[3] = det * m[0];
+                    return (true);
+                }
+                if (n == 3)
+                {
+                    T a0 = m[4] * m[8] - m[5] * m[7];
+                    T a1 = m[5] * m[6] - m[3] * m[8];
+                    T a2 = m[3] * m[7] - m[4] * m[6];
+                    T det = m[0] * a0 + m[1] * a1 + m[2] * a2;
+                    if (det == 0)
+                        return (false);
+                    det = (T)1 / det;
+                    out[0] = det * a0;
+                    out[1] = det * (m[2] * m[7] - m[1] * m[8]);
+                    out[2] = det * (m[1] * m[5] - m[2] * m[4]);
+                    out[3] = det * a1;
+                    out[4] = det * (m[0] * m[8] - m[2] * m[6]);
+                    out[5] = det * (m[2] * m[3] - m[0] * m[5]);
+                    out[6] = det * a2;
+                    out[7] = det * (m[1] * m[6] - m[0] * m[7]);
+                    out[8] = det * (m[0] * m[4] - m[1] * m[3]);
+                    return (true);
+                }
+                T s0 = m[0] * m[5] - m[4] * m[1];
+                T s1 = m[0] * m[6] - m[4] * m[2];
+                T s2 = m[0] * m[7] - m[4] * m[3];
+                T s3 = m[1] * m[6] - m[5] * m[2];
+                T s4 = m[1] * m[7] - m[5] * m[3];
+                T s5 = m[2] * m[7] - m[6] * m[3];
+                T c0 = m[8] * m[13] - m[12] * m[9];
+                T c1 = m[8] * m[14] - m[12] * m[10];
+                T c2 = m[8] * m[15] - m[12] * m[11];
+                T c3 = m[9] * m[14] - m[13] * m[10];
+                T c4 = m[9] * m[15] - m[13] * m[11];
+                T c5 = m[10] * m[15] - m[14] * m[11];
+                T det = s0 * c5 - s1 * c4 + s2 * c3 + s3 * c2 - s4 * c1 + s5 * c0;
+                if (det == 0)
+                    return (false);
+                det = (T)1 / det;
+                out[0] = det * (m[5] * c5 - m[6] * c4 + m[7] * c3);
+                out[1] = det * (-m[1] * c5 + m[2] * c4 - m[3] * c3);
+                out[2] = det * (m[13] * s5 - m[14] * s4 + m[15] * s3);
+                out[3] = det * (-m[9] * s5 + m[10] * s4 - m[11] * s3);
+                out[4] = det * (-m[4] * c5 + m[6] * c2 - m[7] * c1);
+                out[5] = det * (m[0] * c5 - m[2] * c2 + m[3] * c1);
+                out[6] = det * (-m[12] * s5 + m[14] * s2 - m[15] * s1);
+                out[7] = det * (m[8] * s5 - m[10] * s2 + m[11] * s1);
+                out[8] = det * (m[4] * c4 - m[5] * c2 + m[7] * c0);
+                out[9] = det * (-m[0] * c4 + m[1] * c2 - m[3] * c0);
+                out[10] = det * (m[12] * s4 - m[13] * s2 + m[15] * s0);
+                out[11] = det * (-m[8] * s4 + m[9] * s2 - m[11] * s0);
+                out[12] = det * (-m[4] * c3 + m[5] * c1 - m[6] * c0);
+                out[13] = det * (m[0] * c3 - m[1] * c1 + m[2] * c0);
+                out[14] = det * (-m[12] * s3 + m[13] * s1 - m[14] * s0);
+                out[15] = det * (m[8] * s3 - m[9] * s1 + m[10] * s0);
+                return (true);
+            }
+
+            /**
+             * Decomposes in place a matrix into P * A = L * U, L having an implicit unit diagonal
+             * @param a the matrix to decompose, receives L and U
+             * @param perm receives the row permutation P
+             * @param n order of the matrix
+             * @param odd set to true if the permutation has an odd number of swaps
+             * @return false if the matrix is singular
+             */
+            template <typename T>
+            bool LUDecompose(T *a, fsize *perm, const fsize n, bool &odd) noexcept
+            {
+                odd = false;
+                for (fsize i = 0; i != n; ++i)
+                    perm[i] = i;
+                for (fsize k = 0; k != n; ++k)
+                {
+                    fsize p = k;
+                    T max = Abs(a[k * n + k]);
+                    for (fsize i = k + 1; i != n; ++i)
+                    {
+                        if (Abs(a[i * n + k]) > max)
+                        {
+                            max = Abs(a[i * n + k]);
+                            p = i;
+                        }
+                    }
+                    if (max == 0)
+                        return (false);
+                    if (p != k)
+                    {
+                        for (fsize j = 0; j != n; ++j)
+                            std::swap(a[k * n + j], a[p * n + j]);
+                        std::swap(perm[k], perm[p]);
+                        odd = !odd;
+                    }
+                    T inv = (T)1 / a[k * n + k];
+                    for (fsize i = k + 1; i != n; ++i)
+                    {
+                        T f = a[i * n + k] * inv;
+                        a[i * n + k] = f;
+                        if (f == 0)
+                            continue;
+                        for (fsize j = k + 1; j != n; ++j)
+                            a[i * n + j] -= f * a[k * n + j];
+                    }
+                }
+                return (true);
+            }
+
+            /**
+             * Solves L * U * x = y in place
+             * @param lu the decomposed matrix
+             * @param n order of the matrix
+             * @param x contains the permuted right hand side on input and the solution on output
+             * @param stride distance between two consecutive elements of x
+             */
+            template <typename T>
+            void LUSolve(const T *lu, const fsize n, T *x, const fsize stride) noexcept
+            {
+                for (fsize i = 1; i < n; ++i)
+                {
+                    T sum = x[i * stride];
+                    for (fsize k = 0; k != i; ++k)
+                        sum -= lu[i * n + k] * x[k * stride];
+                    x[i * stride] = sum;
+                }
+                for (fsize i = n; i-- > 0;)
+                {
+                    T sum = x[i * stride];
+                    for (fsize k = i + 1; k < n; ++k)
+                        sum -= lu[i * n + k] * x[k * stride];
+                    x[i * stride] = sum / lu[i * n + i];
+                }
+            }
+
+            /**
+             * Fraction-free Gaussian elimination, exact for integer matrices
+             * @param a the matrix, destroyed
+             * @param n order of the matrix
+             * @return the determinant
+             */
+            template <typename T>
+            T BareissDeterminant(T *a, const fsize n) noexcept
+            {
+                T sign = 1;
+                T prev = 1;
+
+                for (fsize k = 0; k + 1 < n; ++k)
+                {
+                    if (a[k * n + k] == 0)
+                    {
+                        fsize p = k + 1;
+                        while (p != n && a[p * n + k] == 0)
+                            ++p;
+                        if (p == n)
+                            return (0);
+                        for (fsize j = 0; j != n; ++j)
+                            std::swap(a[k * n + j], a[p * n + j]);
+                        sign = -sign;
+                    }
+                    for (fsize i = k + 1; i != n; ++i)
+                    {
+                        for (fsize j = k + 1; j != n; ++j)
+                            a[i * n + j] = (a[i * n + j] * a[k * n + k] - a[i * n + k] * a[k * n + j]) / prev;
+                    }
+                    prev = a[k * n + k];
+                }
+                return (sign * a[n * n - 1]);
+            }
+
+            /**
+             * Computes the determinant of a matrix
+             * @param m the matrix
+             * @param n order of the matrix
+             * @param lu scratch memory of n * n elements
+             * @param perm scratch memory of n elements
+             * @return the determinant
+             */
+            template <typename T>
+            T Determinant(const T *m, const fsize n, T *lu, fsize *perm) noexcept
+            {
+                if (n <= 4)
+                    return (ClosedDeterminant(m, n));
+                for (fsize i = 0; i != n * n; ++i)
+                    lu[i] = m[i];
+                if (std::is_integral<T>::value)
+                    return (BareissDeterminant(lu, n));
+                bool odd;
+                if (!LUDecompose(lu, perm, n, odd))
+                    return (0);
+                T det = odd ? (T)-1 : (T)1;
+                for (fsize i = 0; i != n; ++i)
+                    det *= lu[i * n + i];
+                return (det);
+            }
+
+            /**
+             * Computes the inverse of a matrix
+             * @param m the matrix
+             * @param n order of the matrix
+             * @param out receives the inverse
+             * @param lu scratch memory of n * n elements
+             * @param perm scratch memory of n elements
+             * @return false if the matrix is singular
+             */
+            template <typename T>
+            bool Invert(const T *m, const fsize n, T *out, T *lu, fsize *perm) noexcept
+            {
+                if (n <= 4)
+                    return (ClosedInverse(m, n, out));
+                for (fsize i = 0; i != n * n; ++i)
+                    lu[i] = m[i];
+                bool odd;
+                if (!LUDecompose(lu, perm, n, odd))
+                    return (false);
+                // Column j of the inverse solves A * x = e(j), P * e(j) being column j of the permuted identity
+                for (fsize i = 0; i != n; ++i)
+                {
+                    for (fsize j = 0; j != n; ++j)
+                        out[i * n + j] = perm[i] == j ? (T)1 : (T)0;
+                }
+                for (fsize j = 0; j != n; ++j)
+                    LUSolve(lu, n, out + j, n);
+                return (true);
+            }
+
+            /**
+             * Solves the linear system m * x = b
+             * @param m the matrix
+             * @param n order of the matrix
+             * @param b the right hand side
+             * @param x receives the solution
+             * @param lu scratch memory of n * n elements
+             * @param perm scratch memory of n elements
+             * @return false if the matrix is singular
+             */
+            template <typename T>
+            bool Solve(const T *m, const fsize n, const T *b, T *x, T *lu, fsize *perm) noexcept
+            {
+                for (fsize i = 0; i != n * n; ++i)
+                    lu[i] = m[i];
+                bool odd;
+                if (!LUDecompose(lu, perm, n, odd))
+                    return (false);
+                for (fsize i = 0; i != n; ++i)
+                    x[i] = b[perm[i]];
+                LUSolve(lu, n, x, 1);
+                return (true);
+            }
+        }
+
         template <typename T, fsize N>
         Matrix<T, N, N> Matrix<T, N, N>::GenIdentity() noexcept
         {
@@ -263,23 +582,24 @@ namespace bpf
         template <typename T, fsize N>
         Matrix<T, N, N> Matrix<T, N, N>::Inverse() const
         {
-            T det = GetDeterminant();
-            Matrix<T, N - 1, N - 1> minor;
             Matrix<T, N, N> res;
+            T lu[N * N];
+            fsize perm[N];
 
-            if (det == 0)
+            if (!_bpf_internal_mat::Invert(_arr, N, res._arr, lu, perm))
+                throw NonInvertibleMatrixException();
+            return (res);
+        }
+
+        template <typename T, fsize N>
+        Vector<T, N> Matrix<T, N, N>::Solve(const Matrix<T, N, N> &a, const Vector<T, N> &b)
+        {
+            Vector<T, N> res;
+            T lu[N * N];
+            fsize perm[N];
+
+            if (!_bpf_internal_mat::Solve(a._arr, N, *b, *res, lu, perm))
                 throw NonInvertibleMatrixException();
-            det = (T)1 / det;
-            for (fsize j = 0; j != N; ++j)
-            {
-                for (fsize i = 0; i != N; ++i)
-                {
-                    GetMinor(minor, j, i);
-                    res(j, i) = det * minor.GetDeterminant();
-                    if ((i + j) % 2 == 1)
-                        res(j, i) = -res(j, i);
-                }
-            }
             return (res);
         }
 
@@ -311,15 +631,10 @@ namespace bpf
         template <typename T, fsize N>
         T Matrix<T, N, N>::GetDeterminant() const
         {
-            T det = 0;
-            Matrix<T, N - 1, N - 1> minor;
+            T lu[N * N];
+            fsize perm[N];
 
-            for (fsize i = 0; i != N; ++i)
-            {
-                GetMinor(minor, 0, i);
-                det += (i % 2 == 1 ? -1 : 1) * operator()(i, 0) * minor.GetDeterminant();
-            }
-            return (det);
+            return (_bpf_internal_mat::Determinant(_arr, N, lu, perm));
         }
 
         template <typename T>
@@ -439,23 +754,32 @@ namespace bpf
         {
             if (_m != _n)
                 throw NonSquareMatrixException();
-            T det = GetDeterminant();
-            Matrix<T> minor(_n - 1, _n - 1);
             Matrix<T> res(_n, _n);
+            Matrix<T> lu(_n, _n);
+            auto *perm = memory::MemUtils::NewArray<fsize>(_n);
+            bool flag = _bpf_internal_mat::Invert(_arr, _n, res._arr, lu._arr, perm);
 
-            if (det == 0)
+            memory::MemUtils::DeleteArray(perm, _n);
+            if (!flag)
+                throw NonInvertibleMatrixException();
+            return (res);
+        }
+
+        template <typename T>
+        Vector<T> Matrix<T>::Solve(const Matrix<T> &a, const Vector<T> &b)
+        {
+            if (a._m != a._n)
+                throw NonSquareMatrixException();
+            if (b.Dim() != a._n)
+                throw IncompatibleMatrixSizeException((fisize)a._n, (fisize)b.Dim());
+            Vector<T> res(a._n);
+            Matrix<T> lu(a._n, a._n);
+            auto *perm = memory::MemUtils::NewArray<fsize>(a._n);
+            bool flag = _bpf_internal_mat::Solve(a._arr, a._n, *b, *res, lu._arr, perm);
+
+            memory::MemUtils::DeleteArray(perm, a._n);
+            if (!flag)
                 throw NonInvertibleMatrixException();
-            det = (T)1 / det;
-            for (fsize j = 0; j != _n; ++j)
-            {
-                for (fsize i = 0; i != _n; ++i)
-                {
-                    GetMinor(minor, j, i);
-                    res(j, i) = det * minor.GetDeterminant();
-                    if ((i + j) % 2 == 1)
-                        res(j, i) = -res(j, i);
-                }
-            }
             return (res);
         }
 
@@ -464,16 +788,13 @@ namespace bpf
         {
             if (_m != _n)
                 throw NonSquareMatrixException();
-            if (_n == 1)
-                return (operator()(0, 0));
-            T det = 0;
-            Matrix<T> minor(_n - 1, _n - 1);
+            if (_n <= 4)
+                return (_bpf_internal_mat::ClosedDeterminant(_arr, _n));
+            Matrix<T> lu(_n, _n);
+            auto *perm = memory::MemUtils::NewArray<fsize>(_n);
+            T det = _bpf_internal_mat::Determinant(_arr, _n, lu._arr, perm);
 
-            for (fsize i = 0; i != _n; ++i)
-            {
-                GetMinor(minor, 0, i);
-                det += (i % 2 == 1 ? -1 : 1) * operator()(i, 0) * minor.GetDeterminant();
-            }
+            memory::MemUtils::DeleteArray(perm, _n);
             return (det);
         }
 
@@ -522,21 +843,43 @@ namespace bpf
         {
             if (_m != other._n)
                 throw IncompatibleMatrixSizeException((fisize)_m, (fisize)other._n);
-            Matrix<T> mat(_n, other._m);
+            Matrix<T> mat(_n, other._m, (T)0);
 
-            for (fsize i = 0; i != _n; ++i)
-            {
-                for (fsize j = 0; j != other._m; ++j)
-                {
-                    T res = 0;
-                    for (fsize k = 0; k != _m; ++k)
-                        res += _arr[i * _m + k] * other._arr[k * other._m + j];
-                    mat._arr[i * other._m + j] = res;
-                }
-            }
+            Gemm<T>::MultiplyAdd(_arr, other._arr, mat._arr, _n, _m, other._m);
+            return (mat);
+        }
+
+        template <typename T>
+        Matrix<T> Matrix<T>::Multiply(system::ThreadPool &pool, const Matrix<T> &a, const Matrix<T> &b)
+        {
+            if (a._m != b._n)
+                throw IncompatibleMatrixSizeException((fisize)a._m, (fisize)b._n);
+            Matrix<T> mat(a._n, b._m, (T)0);
+
+            Gemm<T>::MultiplyAdd(pool, a._arr, b._arr, mat._arr, a._n, a._m, b._m);
             return (mat);
         }
 
+        template <typename T>
+        void Matrix<T>::MultiplyAdd(const Matrix<T> &a, const Matrix<T> &b)
+        {
+            if (a._m != b._n)
+                throw IncompatibleMatrixSizeException((fisize)a._m, (fisize)b._n);
+            if (a._n != _n || b._m != _m)
+                throw IncompatibleMatrixSizeException((fisize)_n, (fisize)a._n);
+            Gemm<T>::MultiplyAdd(a._arr, b._arr, _arr, _n, a._m, _m);
+        }
+
+        template <typename T>
+        void Matrix<T>::MultiplyAdd(system::ThreadPool &pool, const Matrix<T> &a, const Matrix<T> &b)
+        {
+            if (a._m != b._n)
+                throw IncompatibleMatrixSizeException((fisize)a._m, (fisize)b._n);
+            if (a._n != _n || b._m != _m)
+                throw IncompatibleMatrixSizeException((fisize)_n, (fisize)a._n);
+            Gemm<T>::MultiplyAdd(pool, a._arr, b._arr, _arr, _n, a._m, _m);
+        }
+
         template <typename T>
         Matrix<T> Matrix<T>::operator+(const Matrix<T> &other) const
         {
@@ -612,5 +955,30 @@ namespace bpf
                 operator()(x, colb) = std::move(tmp);
             }
         }
+
+        template <>
+        template <>
+        inline Matrix<float, 4, 4> Matrix<float, 4, 4>::operator*<4>(const Matrix<float, 4, 4> &other) const
+        {
+            Matrix<float, 4, 4> res;
+            simd::Mat4Mul(_arr, other._arr, res._arr);
+            return (res);
+        }
+
+        template <>
+        inline Vector<float, 4> Matrix<float, 4, 4>::operator*(const Vector<float, 4> &other) const
+        {
+            Vector<float, 4> res;
+            simd::Mat4MulVec4(_arr, &other.X, &res.X);
+            return (res);
+        }
+
+        template <>
+        inline Matrix<float, 4, 4> Matrix<float, 4, 4>::Transpose() const
+        {
+            Matrix<float, 4, 4> res;
+            simd::Mat4Transpose(_arr, res._arr);
+            return (res);
+        }
     }
 }
@@ -29,6 +29,7 @@
 #pragma once
 #include "Framework/Math/Vector.hpp"
 #include "Framework/Collection/ArrayList.hpp"
+#include "Framework/Math/Batch.hpp"
 #include "Framework/Math/Transform2.hpp"
 
 namespace bpf
@@ -45,12 +45,8 @@ namespace bpf
         template <typename T>
         void Polygon2<T>::Transform(const Matrix3<T> &matrix)
         {
-            for (auto &v : Vertices)
-            {
-                Vector3<T> vec(v, 1.0f);
-                auto res = matrix * vec;
-                v = Vector2<T>(res.X, res.Y);
-            }
+            if (Vertices.Size() > 0)
+                Batch<T>::TransformPoints(matrix, &Vertices[0], &Vertices[0], Vertices.Size());
         }
 
         template <typename T>
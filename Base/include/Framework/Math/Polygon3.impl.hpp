@@ -57,12 +57,8 @@ namespace bpf
         template <typename T>
         void Polygon3<T>::Transform(const Matrix4<T> &matrix)
         {
-            for (auto &v : Vertices)
-            {
-                Vector4<T> vec(v, 1.0f);
-                auto res = matrix * vec;
-                v = Vector3<T>(res.X, res.Y, res.Z);
-            }
+            if (Vertices.Size() > 0)
+                Batch<T>::TransformPoints(matrix, &Vertices[0], &Vertices[0], Vertices.Size());
         }
     }
 }
@@ -27,6 +27,7 @@
 // SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #pragma once
+#include "Framework/Math/SIMD.hpp"
 
 namespace bpf
 {
@@ -190,5 +191,21 @@ namespace bpf
             else
                 return (Quaternionf(forward, dir));
         }
+
+        template <>
+        inline Quaternion<float> Quaternion<float>::operator*(const Quaternion<float> &other) const
+        {
+            Quaternion<float> res;
+            simd::QuatMul(&I, &other.I, &res.I);
+            return (res);
+        }
+
+        template <>
+        inline Vector<float, 3> Quaternion<float>::Rotate(const Vector<float, 3> &v) const
+        {
+            Vector<float, 3> res;
+            simd::QuatRotate(&I, &v.X, &res.X);
+            return (res);
+        }
     }
 }
@@ -35,16 +35,22 @@ namespace bpf
     namespace math
     {
         /**
-         * Random number generator utility
+         * Random number generator utility based on xoshiro256**.
+         * Each instance owns its state: instances never influence each other, a single instance must not be used
+         * from several threads at the same time (use one instance per thread, see Jump)
          */
         class BPF_API Random
         {
         private:
-            static fint IntBounds(fint min, fint max);
+            uint64 _state[4];
+
+            void Seed(uint64 seed) noexcept;
+            uint32 Bounded(uint32 range) noexcept;
 
         public:
             /**
-             * Constructs a random with a default seed
+             * Constructs a random with a seed derived from the current time; two instances constructed
+             * at the same time still produce different sequences
              */
             Random();
 
@@ -54,63 +60,105 @@ namespace bpf
              */
             explicit Random(long seed);
 
+            /**
+             * Generates the next 64 bits of the sequence
+             * @return new 64 bit unsigned integer
+             */
+            uint64 NextUInt64() noexcept;
+
+            /**
+             * Generates the next 32 bits of the sequence
+             * @return new 32 bit unsigned integer
+             */
+            inline uint32 NextUInt32() noexcept
+            {
+                return ((uint32)(NextUInt64() >> 32));
+            }
+
             /**
              * Generate a new random integer
-             * @param max maximum value
-             * @return new 32 bit integer
+             * @param max maximum value (inclusive)
+             * @return new 32 bit integer between 0 and max
              */
             fint NextInt(fint max = bpf::Int::MaxValue);
 
             /**
              * Generate a new random integer
-             * @param min minimum value
-             * @param max maximum value
+             * @param min minimum value (inclusive)
+             * @param max maximum value (inclusive)
              * @return new 32 bit integer
              */
             fint NextInt(fint min, fint max);
 
             /**
              * Generate a new random integer
-             * @param max maximum value
+             * @param max maximum value (inclusive)
              * @return new 8 bit integer
              */
             uint8 NextByte(uint8 max = bpf::UInt8::MaxValue);
 
             /**
              * Generate a new random integer
-             * @param min minimum value
-             * @param max maximum value
+             * @param min minimum value (inclusive)
+             * @param max maximum value (inclusive)
              * @return new 8 bit integer
              */
             uint8 NextByte(uint8 min, uint8 max);
 
             /**
              * Generate a new random integer
-             * @param max maximum value
+             * @param max maximum value (inclusive)
              * @return new 16 bit integer
              */
             uint16 NextShort(uint16 max = bpf::UInt16::MaxValue);
 
             /**
              * Generate a new random integer
-             * @param min minimum value
-             * @param max maximum value
+             * @param min minimum value (inclusive)
+             * @param max maximum value (inclusive)
              * @return new 16 bit integer
              */
             uint16 NextShort(uint16 min, uint16 max);
 
             /**
-             * Generate a new random float
+             * Generate a new random float with 24 bits of precision
              * @param min minimum value
-             * @return random float between 0 and 1 added with min
+             * @return random float in [0, 1) added with min
              */
             float NextFloat(float min = 0);
 
             /**
-             * Generate a new random double
-             * @return random double between 0 and 1
+             * Generate a new random double with 53 bits of precision
+             * @return random double in [0, 1)
              */
             double NextDouble();
+
+            /**
+             * Fills an array with random floats in [0, 1), two floats per 64 bits of the sequence
+             * @param out the array to fill
+             * @param count number of floats
+             */
+            void Fill(float *out, fsize count) noexcept;
+
+            /**
+             * Fills an array with random doubles in [0, 1)
+             * @param out the array to fill
+             * @param count number of doubles
+             */
+            void Fill(double *out, fsize count) noexcept;
+
+            /**
+             * Fills a buffer with random bytes
+             * @param out the buffer to fill
+             * @param size number of bytes
+             */
+            void Fill(uint8 *out, fsize size) noexcept;
+
+            /**
+             * Advances the sequence by 2^128 steps. Copying a Random then calling Jump on the copy
+             * gives non-overlapping sequences, one per thread
+             */
+            void Jump() noexcept;
         };
     }
 }
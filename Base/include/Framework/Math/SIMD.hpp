@@ -0,0 +1,366 @@
+// Copyright (c) 2020, BlockProject 3D
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without modification,
+// are permitted provided that the following conditions are met:
+// 
+//     * Redistributions of source code must retain the above copyright notice,
+//       this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above copyright notice,
+//       this list of conditions and the following disclaimer in the documentation
+//       and/or other materials provided with the distribution.
+//     * Neither the name of BlockProject 3D nor the names of its contributors
+//       may be used to endorse or promote products derived from this software
+//       without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#pragma once
+#include "Framework/Types.hpp"
+
+// Define BP_MATH_NO_SIMD to force the scalar kernels
+#ifndef BP_MATH_NO_SIMD
+    #if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+        #define BP_MATH_SSE
+        #include <emmintrin.h>
+    #endif
+    #if defined(BP_MATH_SSE) && defined(__AVX__)
+        #define BP_MATH_AVX
+        #include <immintrin.h>
+    #endif
+#endif
+
+namespace bpf
+{
+    namespace math
+    {
+        /**
+         * Single precision kernels backing the Vector4f, Matrix4f and Quaternionf specializations and the Batch functions.
+         * SSE2 is used when the target supports it (AVX for matrix products when enabled at compile time),
+         * otherwise the kernels fall back to scalar code. Matrices are row major, quaternions are laid out I, J, K, W.
+         * Pointers need not be aligned; out must not alias the inputs unless stated otherwise
+         */
+        namespace simd
+        {
+            inline void Vec4Add(const float *a, const float *b, float *out) noexcept
+            {
+#ifdef BP_MATH_SSE
+                _mm_storeu_ps(out, _mm_add_ps(_mm_loadu_ps(a), _mm_loadu_ps(b)));
+#else
+                for (fsize i = 0; i != 4; ++i)
+                    out[i] = a[i] + b[i];
+#endif
+            }
+
+            inline void Vec4Sub(const float *a, const float *b, float *out) noexcept
+            {
+#ifdef BP_MATH_SSE
+                _mm_storeu_ps(out, _mm_sub_ps(_mm_loadu_ps(a), _mm_loadu_ps(b)));
+#else
+                for (fsize i = 0; i != 4; ++i)
+                    out[i] = a[i] - b[i];
+#endif
+            }
+
+            inline void Vec4Mul(const float *a, const float *b, float *out) noexcept
+            {
+#ifdef BP_MATH_SSE
+                _mm_storeu_ps(out, _mm_mul_ps(_mm_loadu_ps(a), _mm_loadu_ps(b)));
+#else
+                for (fsize i = 0; i != 4; ++i)
+                    out[i] = a[i] * b[i];
+#endif
+            }
+
+            inline void Vec4Div(const float *a, const float *b, float *out) noexcept
+            {
+#ifdef BP_MATH_SSE
+                _mm_storeu_ps(out, _mm_div_ps(_mm_loadu_ps(a), _mm_loadu_ps(b)));
+#else
+                for (fsize i = 0; i != 4; ++i)
+                    out[i] = a[i] / b[i];
+#endif
+            }
+
+            inline void Vec4Scale(const float *a, const float b, float *out) noexcept
+            {
+#ifdef BP_MATH_SSE
+                _mm_storeu_ps(out, _mm_mul_ps(_mm_loadu_ps(a), _mm_set1_ps(b)));
+#else
+                for (fsize i = 0; i != 4; ++i)
+                    out[i] = a[i] * b;
+#endif
+            }
+
+            inline float Vec4Dot(const float *a, const float *b) noexcept
+            {
+#ifdef BP_MATH_SSE
+                __m128 m = _mm_mul_ps(_mm_loadu_ps(a), _mm_loadu_ps(b));
+                __m128 s = _mm_add_ps(m, _mm_shuffle_ps(m, m, _MM_SHUFFLE(2, 3, 0, 1)));
+                s = _mm_add_ss(s, _mm_movehl_ps(s, s));
+                return (_mm_cvtss_f32(s));
+#else
+                return (a[0] * b[0] + a[1] * b[1] + a[2] * b[2] + a[3] * b[3]);
+#endif
+            }
+
+            /**
+             * Row major 4x4 matrix product: out = a * b
+             */
+            inline void Mat4Mul(const float *a, const float *b, float *out) noexcept
+            {
+#if defined(BP_MATH_AVX)
+                // Two rows of the result per iteration, rows of b duplicated in both 128 bits lanes
+                __m256 b0 = _mm256_broadcast_ps(reinterpret_cast<const __m128 *>(b));
+                __m256 b1 = _mm256_broadcast_ps(reinterpret_cast<const __m128 *>(b + 4));
+                __m256 b2 = _mm256_broadcast_ps(reinterpret_cast<const __m128 *>(b + 8));
+                __m256 b3 = _mm256_broadcast_ps(reinterpret_cast<const __m128 *>(b + 12));
+                for (fsize i = 0; i != 16; i += 8)
+                {
+                    __m256 rows = _mm256_loadu_ps(a + i);
+                    __m256 r = _mm256_mul_ps(_mm256_permute_ps(rows, _MM_SHUFFLE(0, 0, 0, 0)), b0);
+                    r = _mm256_add_ps(r, _mm256_mul_ps(_mm256_permute_ps(rows, _MM_SHUFFLE(1, 1, 1, 1)), b1));
+                    r = _mm256_add_ps(r, _mm256_mul_ps(_mm256_permute_ps(rows, _MM_SHUFFLE(2, 2, 2, 2)), b2));
+                    r = _mm256_add_ps(r, _mm256_mul_ps(_mm256_permute_ps(rows, _MM_SHUFFLE(3, 3, 3, 3)), b3));
+                    _mm256_storeu_ps(out + i, r);
+                }
+#elif defined(BP_MATH_SSE)
+                __m128 b0 = _mm_loadu_ps(b);
+                __m128 b1 = _mm_loadu_ps(b + 4);
+                __m128 b2 = _mm_loadu_ps(b + 8);
+                __m128 b3 = _mm_loadu_ps(b + 12);
+                for (fsize i = 0; i != 16; i += 4)
+                {
+                    // Row i of the result is a linear combination of the rows of b
+                    __m128 r = _mm_mul_ps(_mm_set1_ps(a[i]), b0);
+                    r = _mm_add_ps(r, _mm_mul_ps(_mm_set1_ps(a[i + 1]), b1));
+                    r = _mm_add_ps(r, _mm_mul_ps(_mm_set1_ps(a[i + 2]), b2));
+                    r = _mm_add_ps(r, _mm_mul_ps(_mm_set1_ps(a[i + 3]), b3));
+                    _mm_storeu_ps(out + i, r);
+                }
+#else
+                for (fsize i = 0; i != 4; ++i)
+                {
+                    for (fsize j = 0; j != 4; ++j)
+                    {
+                        out[i * 4 + j] = a[i * 4] * b[j] + a[i * 4 + 1] * b[4 + j] + a[i * 4 + 2] * b[8 + j]
+                            + a[i * 4 + 3] * b[12 + j];
+                    }
+                }
+#endif
+            }
+
+            /**
+             * Row major 4x4 matrix transpose
+             */
+            inline void Mat4Transpose(const float *m, float *out) noexcept
+            {
+#ifdef BP_MATH_SSE
+                __m128 r0 = _mm_loadu_ps(m);
+                __m128 r1 = _mm_loadu_ps(m + 4);
+                __m128 r2 = _mm_loadu_ps(m + 8);
+                __m128 r3 = _mm_loadu_ps(m + 12);
+                _MM_TRANSPOSE4_PS(r0, r1, r2, r3);
+                _mm_storeu_ps(out, r0);
+                _mm_storeu_ps(out + 4, r1);
+                _mm_storeu_ps(out + 8, r2);
+                _mm_storeu_ps(out + 12, r3);
+#else
+                for (fsize i = 0; i != 4; ++i)
+                {
+                    for (fsize j = 0; j != 4; ++j)
+                        out[j * 4 + i] = m[i * 4 + j];
+                }
+#endif
+            }
+
+            /**
+             * Row major 4x4 matrix by column vector product: out = m * v
+             */
+            inline void Mat4MulVec4(const float *m, const float *v, float *out) noexcept
+            {
+#ifdef BP_MATH_SSE
+                __m128 vec = _mm_loadu_ps(v);
+                __m128 r0 = _mm_mul_ps(_mm_loadu_ps(m), vec);
+                __m128 r1 = _mm_mul_ps(_mm_loadu_ps(m + 4), vec);
+                __m128 r2 = _mm_mul_ps(_mm_loadu_ps(m + 8), vec);
+                __m128 r3 = _mm_mul_ps(_mm_loadu_ps(m + 12), vec);
+                // After the transpose r0..r3 hold the k-th product of every row: summing them gives the 4 dot products
+                _MM_TRANSPOSE4_PS(r0, r1, r2, r3);
+                _mm_storeu_ps(out, _mm_add_ps(_mm_add_ps(_mm_add_ps(r0, r1), r2), r3));
+#else
+                for (fsize i = 0; i != 4; ++i)
+                    out[i] = m[i * 4] * v[0] + m[i * 4 + 1] * v[1] + m[i * 4 + 2] * v[2] + m[i * 4 + 3] * v[3];
+#endif
+            }
+
+            /**
+             * Transforms count 4D vectors stored contiguously (X, Y, Z, W) by a row major 4x4 matrix.
+             * in and out may point to the same array
+             */
+            inline void Mat4MulVec4Array(const float *m, const float *in, float *out, fsize count) noexcept
+            {
+#ifdef BP_MATH_SSE
+                // m * v is the sum of the columns of m weighted by the coordinates of v
+                __m128 c0 = _mm_loadu_ps(m);
+                __m128 c1 = _mm_loadu_ps(m + 4);
+                __m128 c2 = _mm_loadu_ps(m + 8);
+                __m128 c3 = _mm_loadu_ps(m + 12);
+                _MM_TRANSPOSE4_PS(c0, c1, c2, c3);
+                for (fsize i = 0; i != count; ++i)
+                {
+                    __m128 v = _mm_loadu_ps(in + i * 4);
+                    __m128 r = _mm_mul_ps(_mm_shuffle_ps(v, v, _MM_SHUFFLE(0, 0, 0, 0)), c0);
+                    r = _mm_add_ps(r, _mm_mul_ps(_mm_shuffle_ps(v, v, _MM_SHUFFLE(1, 1, 1, 1)), c1));
+                    r = _mm_add_ps(r, _mm_mul_ps(_mm_shuffle_ps(v, v, _MM_SHUFFLE(2, 2, 2, 2)), c2));
+                    r = _mm_add_ps(r, _mm_mul_ps(_mm_shuffle_ps(v, v, _MM_SHUFFLE(3, 3, 3, 3)), c3));
+                    _mm_storeu_ps(out + i * 4, r);
+                }
+#else
+                for (fsize i = 0; i != count; ++i)
+                {
+                    float v[4] = {in[i * 4], in[i * 4 + 1], in[i * 4 + 2], in[i * 4 + 3]};
+                    Mat4MulVec4(m, v, out + i * 4);
+                }
+#endif
+            }
+
+            /**
+             * Transforms count 3D vectors stored as separate X, Y and Z arrays by a row major 4x4 matrix,
+             * the implicit 4th coordinate being w (1 for points, 0 for directions).
+             * The output arrays may be the input arrays
+             */
+            inline void Mat4TransformSoA(const float *m, const float *x, const float *y, const float *z, float *outX,
+                                         float *outY, float *outZ, fsize count, float w) noexcept
+            {
+                fsize i = 0;
+#ifdef BP_MATH_SSE
+                __m128 m00 = _mm_set1_ps(m[0]), m01 = _mm_set1_ps(m[1]), m02 = _mm_set1_ps(m[2]);
+                __m128 m10 = _mm_set1_ps(m[4]), m11 = _mm_set1_ps(m[5]), m12 = _mm_set1_ps(m[6]);
+                __m128 m20 = _mm_set1_ps(m[8]), m21 = _mm_set1_ps(m[9]), m22 = _mm_set1_ps(m[10]);
+                __m128 t0 = _mm_set1_ps(m[3] * w), t1 = _mm_set1_ps(m[7] * w), t2 = _mm_set1_ps(m[11] * w);
+                for (; i + 4 <= count; i += 4)
+                {
+                    __m128 vx = _mm_loadu_ps(x + i);
+                    __m128 vy = _mm_loadu_ps(y + i);
+                    __m128 vz = _mm_loadu_ps(z + i);
+                    __m128 rx = _mm_add_ps(_mm_add_ps(_mm_mul_ps(m00, vx), _mm_mul_ps(m01, vy)),
+                                           _mm_add_ps(_mm_mul_ps(m02, vz), t0));
+                    __m128 ry = _mm_add_ps(_mm_add_ps(_mm_mul_ps(m10, vx), _mm_mul_ps(m11, vy)),
+                                           _mm_add_ps(_mm_mul_ps(m12, vz), t1));
+                    __m128 rz = _mm_add_ps(_mm_add_ps(_mm_mul_ps(m20, vx), _mm_mul_ps(m21, vy)),
+                                           _mm_add_ps(_mm_mul_ps(m22, vz), t2));
+                    _mm_storeu_ps(outX + i, rx);
+                    _mm_storeu_ps(outY + i, ry);
+                    _mm_storeu_ps(outZ + i, rz);
+                }
+#endif
+                for (; i != count; ++i)
+                {
+                    float vx = x[i];
+                    float vy = y[i];
+                    float vz = z[i];
+                    outX[i] = m[0] * vx + m[1] * vy + m[2] * vz + m[3] * w;
+                    outY[i] = m[4] * vx + m[5] * vy + m[6] * vz + m[7] * w;
+                    outZ[i] = m[8] * vx + m[9] * vy + m[10] * vz + m[11] * w;
+                }
+            }
+
+            /**
+             * Computes the minimum and maximum of count (> 0) values
+             */
+            inline void MinMax(const float *values, fsize count, float &min, float &max) noexcept
+            {
+                fsize i = 0;
+                min = values[0];
+                max = values[0];
+#ifdef BP_MATH_SSE
+                if (count >= 4)
+                {
+                    __m128 vmin = _mm_loadu_ps(values);
+                    __m128 vmax = vmin;
+                    for (i = 4; i + 4 <= count; i += 4)
+                    {
+                        __m128 v = _mm_loadu_ps(values + i);
+                        vmin = _mm_min_ps(vmin, v);
+                        vmax = _mm_max_ps(vmax, v);
+                    }
+                    vmin = _mm_min_ps(vmin, _mm_shuffle_ps(vmin, vmin, _MM_SHUFFLE(2, 3, 0, 1)));
+                    vmin = _mm_min_ss(vmin, _mm_movehl_ps(vmin, vmin));
+                    vmax = _mm_max_ps(vmax, _mm_shuffle_ps(vmax, vmax, _MM_SHUFFLE(2, 3, 0, 1)));
+                    vmax = _mm_max_ss(vmax, _mm_movehl_ps(vmax, vmax));
+                    min = _mm_cvtss_f32(vmin);
+                    max = _mm_cvtss_f32(vmax);
+                }
+#endif
+                for (; i != count; ++i)
+                {
+                    if (values[i] < min)
+                        min = values[i];
+                    if (values[i] > max)
+                        max = values[i];
+                }
+            }
+
+            /**
+             * Hamilton product of two quaternions: out = a * b
+             */
+            inline void QuatMul(const float *a, const float *b, float *out) noexcept
+            {
+#ifdef BP_MATH_SSE
+                __m128 qa = _mm_loadu_ps(a);
+                __m128 qb = _mm_loadu_ps(b);
+                const __m128 signW = _mm_set_ps(-0.0f, 0.0f, 0.0f, 0.0f);
+                // Lanes are I, J, K, W
+                __m128 r = _mm_mul_ps(_mm_shuffle_ps(qa, qa, _MM_SHUFFLE(3, 3, 3, 3)), qb);
+                __m128 t = _mm_mul_ps(_mm_shuffle_ps(qa, qa, _MM_SHUFFLE(0, 2, 1, 0)),
+                                      _mm_shuffle_ps(qb, qb, _MM_SHUFFLE(0, 3, 3, 3)));
+                r = _mm_add_ps(r, _mm_xor_ps(t, signW));
+                t = _mm_mul_ps(_mm_shuffle_ps(qa, qa, _MM_SHUFFLE(1, 0, 2, 1)),
+                               _mm_shuffle_ps(qb, qb, _MM_SHUFFLE(1, 1, 0, 2)));
+                r = _mm_add_ps(r, _mm_xor_ps(t, signW));
+                t = _mm_mul_ps(_mm_shuffle_ps(qa, qa, _MM_SHUFFLE(2, 1, 0, 2)),
+                               _mm_shuffle_ps(qb, qb, _MM_SHUFFLE(2, 0, 2, 1)));
+                _mm_storeu_ps(out, _mm_sub_ps(r, t));
+#else
+                out[0] = a[3] * b[0] + a[0] * b[3] + a[1] * b[2] - a[2] * b[1];
+                out[1] = a[3] * b[1] + a[1] * b[3] + a[2] * b[0] - a[0] * b[2];
+                out[2] = a[3] * b[2] + a[2] * b[3] + a[0] * b[1] - a[1] * b[0];
+                out[3] = a[3] * b[3] - a[0] * b[0] - a[1] * b[1] - a[2] * b[2];
+#endif
+            }
+
+            /**
+             * Computes q * (0, v) * conjugate(q) without building the intermediate quaternions:
+             * (w^2 - u.u) v + 2 (u.v) u + 2 w (u x v) where u is the imaginary part of q
+             * @param q the quaternion
+             * @param v the 3D vector to rotate
+             * @param out receives the 3D rotated vector
+             */
+            inline void QuatRotate(const float *q, const float *v, float *out) noexcept
+            {
+                float w = q[3];
+                float uu = q[0] * q[0] + q[1] * q[1] + q[2] * q[2];
+                float uv = q[0] * v[0] + q[1] * v[1] + q[2] * v[2];
+                float s = w * w - uu;
+                float cx = q[1] * v[2] - q[2] * v[1];
+                float cy = q[2] * v[0] - q[0] * v[2];
+                float cz = q[0] * v[1] - q[1] * v[0];
+                out[0] = s * v[0] + 2 * uv * q[0] + 2 * w * cx;
+                out[1] = s * v[1] + 2 * uv * q[1] + 2 * w * cy;
+                out[2] = s * v[2] + 2 * uv * q[2] + 2 * w * cz;
+            }
+        }
+    }
+}
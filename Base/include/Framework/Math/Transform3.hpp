@@ -30,6 +30,7 @@
 #include "Framework/Math/Quaternion.hpp"
 #include "Framework/Math/Vector.hpp"
 #include "Framework/Math/Matrix.hpp"
+#include "Framework/Math/Batch.hpp"
 
 namespace bpf
 {
@@ -167,6 +168,22 @@ namespace bpf
              */
             Vector3<T> WorldToLocal(const Vector3<T> &world);
 
+            /**
+             * Transforms an array of points, the matrix of this transform is computed only once
+             * @param local 3D points to transform
+             * @param world receives the transformed points, may be the local array
+             * @param count number of points
+             */
+            void LocalToWorld(const Vector3<T> *local, Vector3<T> *world, fsize count) const noexcept;
+
+            /**
+             * Reverts transformation from an array of points, the inverse matrix of this transform is computed only once
+             * @param world 3D points to revert transformation
+             * @param local receives the de-transformed points, may be the world array
+             * @param count number of points
+             */
+            void WorldToLocal(const Vector3<T> *world, Vector3<T> *local, fsize count) const;
+
             /**
              * Computes the matrix of this transform
              * @return order 4 square matrix
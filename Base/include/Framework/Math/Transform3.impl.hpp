@@ -120,11 +120,23 @@ namespace bpf
         template <typename T>
         Vector3<T> Transform3<T>::WorldToLocal(const Vector3<T> &world)
         {
-            auto res = ToMatrix().Invert() * Vector4<T>(world, (T)1);
+            auto res = ToMatrix().Inverse() * Vector4<T>(world, (T)1);
 
             return (Vector3<T>(res.X, res.Y, res.Z));
         }
 
+        template <typename T>
+        void Transform3<T>::LocalToWorld(const Vector3<T> *local, Vector3<T> *world, fsize count) const noexcept
+        {
+            Batch<T>::TransformPoints(ToMatrix(), local, world, count);
+        }
+
+        template <typename T>
+        void Transform3<T>::WorldToLocal(const Vector3<T> *world, Vector3<T> *local, fsize count) const
+        {
+            Batch<T>::TransformPoints(ToMatrix().Inverse(), world, local, count);
+        }
+
         template <typename T>
         Transform3<T> Transform3<T>::operator+(const Transform3 &other) const noexcept
         {
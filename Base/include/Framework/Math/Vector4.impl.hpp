@@ -27,6 +27,7 @@
 // SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #pragma once
+#include "Framework/Math/SIMD.hpp"
 
 namespace bpf
 {
@@ -95,5 +96,81 @@ namespace bpf
                 throw IndexException((fisize)l);
             }
         }
+
+        template <>
+        inline Vector<float, 4> Vector<float, 4>::operator+(const Vector<float, 4> &other) const
+        {
+            Vector<float, 4> res;
+            simd::Vec4Add(&X, &other.X, &res.X);
+            return (res);
+        }
+
+        template <>
+        inline Vector<float, 4> Vector<float, 4>::operator-(const Vector<float, 4> &other) const
+        {
+            Vector<float, 4> res;
+            simd::Vec4Sub(&X, &other.X, &res.X);
+            return (res);
+        }
+
+        template <>
+        inline Vector<float, 4> Vector<float, 4>::operator*(const Vector<float, 4> &other) const
+        {
+            Vector<float, 4> res;
+            simd::Vec4Mul(&X, &other.X, &res.X);
+            return (res);
+        }
+
+        template <>
+        inline Vector<float, 4> Vector<float, 4>::operator/(const Vector<float, 4> &other) const
+        {
+            Vector<float, 4> res;
+            simd::Vec4Div(&X, &other.X, &res.X);
+            return (res);
+        }
+
+        template <>
+        inline Vector<float, 4> Vector<float, 4>::operator*(const float other) const
+        {
+            Vector<float, 4> res;
+            simd::Vec4Scale(&X, other, &res.X);
+            return (res);
+        }
+
+        template <>
+        inline void Vector<float, 4>::operator+=(const Vector<float, 4> &other)
+        {
+            simd::Vec4Add(&X, &other.X, &X);
+        }
+
+        template <>
+        inline void Vector<float, 4>::operator-=(const Vector<float, 4> &other)
+        {
+            simd::Vec4Sub(&X, &other.X, &X);
+        }
+
+        template <>
+        inline void Vector<float, 4>::operator*=(const Vector<float, 4> &other)
+        {
+            simd::Vec4Mul(&X, &other.X, &X);
+        }
+
+        template <>
+        inline void Vector<float, 4>::operator*=(const float other)
+        {
+            simd::Vec4Scale(&X, other, &X);
+        }
+
+        template <>
+        inline float Vector<float, 4>::Dot(const Vector<float, 4> &other) const
+        {
+            return (simd::Vec4Dot(&X, &other.X));
+        }
+
+        template <>
+        inline float Vector<float, 4>::NormSquared() const
+        {
+            return (simd::Vec4Dot(&X, &X));
+        }
     }
 }
@@ -28,12 +28,42 @@
 
 #pragma once
 
+#include "Framework/Collection/ArrayList.hpp"
 #include "Framework/EvalException.hpp"
 #include "Framework/IndexException.hpp"
 #include "Framework/String.hpp"
+#include <initializer_list>
 
 namespace bpf
 {
+    namespace _bpf_internal_evale
+    {
+        template <typename T>
+        class Compiler;
+
+        enum EOpCode
+        {
+            EVAL_OP_CONST = 0,
+            EVAL_OP_VAR,
+            EVAL_OP_ADD,
+            EVAL_OP_SUB,
+            EVAL_OP_MUL,
+            EVAL_OP_DIV,
+            EVAL_OP_MOD,
+            EVAL_OP_POW,
+            EVAL_OP_NEG,
+            EVAL_OP_CALL
+        };
+
+        template <typename T>
+        struct Instruction
+        {
+            EOpCode Op;
+            fsize Index;
+            T Value;
+        };
+    }
+
     /**
      * Utility to evaluate simple math expressions
      * @tparam T the type to evaluate to
@@ -45,6 +75,98 @@ namespace bpf
         static T EvalNbr(const char *expr, char **endptr);
 
     public:
+        /**
+         * Maximum stack depth of a compiled expression
+         */
+        static constexpr fsize MAX_DEPTH = 64;
+
+        /**
+         * A compiled expression: stack machine bytecode with constant sub-expressions folded.
+         * A Program is immutable once compiled and can be evaluated concurrently from several threads
+         */
+        class BP_TPL_API Program
+        {
+        private:
+            collection::ArrayList<_bpf_internal_evale::Instruction<T>> _code;
+            collection::ArrayList<String> _variables;
+            fsize _depth;
+
+        public:
+            inline Program()
+                : _depth(0)
+            {
+            }
+
+            /**
+             * Returns the names of the variables of this program; the index of a name is the index of the value
+             * expected by Evaluate
+             * @return variable names
+             */
+            inline const collection::ArrayList<String> &GetVariables() const noexcept
+            {
+                return (_variables);
+            }
+
+            /**
+             * Returns the index of a variable
+             * @param name the variable name
+             * @return index of the variable, -1 if this program does not use that variable
+             */
+            fisize GetVariableIndex(const String &name) const noexcept;
+
+            /**
+             * Returns the number of instructions of this program
+             * @return unsigned
+             */
+            inline fsize GetInstructionCount() const noexcept
+            {
+                return (_code.Size());
+            }
+
+            /**
+             * Evaluates this program
+             * @param variables values of the variables, ordered as GetVariables
+             * @throw EvalException when there is a math error, variables are missing or the program is empty
+             * @return evaluated number
+             */
+            T Evaluate(const T *variables = nullptr) const;
+
+            /**
+             * Evaluates this program
+             * @param variables values of the variables, ordered as GetVariables
+             * @throw EvalException when there is a math error or variables are missing
+             * @return evaluated number
+             */
+            inline T Evaluate(const std::initializer_list<T> &variables) const
+            {
+                if (variables.size() < _variables.Size())
+                    throw EvalException("Missing variable values");
+                return (Evaluate(variables.begin()));
+            }
+
+            /**
+             * Evaluates this program over arrays of variable values, one instruction at a time over chunks of rows
+             * @param variables one array of count values per variable, ordered as GetVariables
+             * @param out receives the count results
+             * @param count number of evaluations
+             * @throw EvalException when there is a math error or the program is empty
+             */
+            void Evaluate(const T *const *variables, T *out, fsize count) const;
+
+            friend class _bpf_internal_evale::Compiler<T>;
+        };
+
+        /**
+         * Compiles a math expression string. Supports + - * / % ^, parenthesis, variables
+         * and the functions abs, sqrt, sin, cos, tan, exp, log, floor, ceil, min, max, pow and clamp
+         * @param str the expression string
+         * @param variables optional variable names fixing the order of the first variables,
+         * other identifiers are appended in order of appearance
+         * @throw EvalException when the expression is invalid or a constant sub-expression has a math error
+         * @return compiled program
+         */
+        Program Compile(const String &str, const collection::ArrayList<String> &variables = collection::ArrayList<String>()) const;
+
         /**
          * Evaluates a math expression string
          * @param str the expression string
@@ -91,4 +213,4 @@ namespace bpf
     };
 }
 
-#include "Framework/MathEval.impl.hpp"
\ No newline at end of file
+#include "Framework/MathEval.impl.hpp"
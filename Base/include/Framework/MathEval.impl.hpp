@@ -27,80 +27,14 @@
 // SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #pragma once
+#include "Framework/Collection/Array.hpp"
+#include <cmath>
+#include <cstdlib>
 
 namespace bpf
 {
     namespace _bpf_internal_evale
     {
-        enum EEvalExprOperator
-        {
-            EVAL_EXPR_ADD = 0,
-            EVAL_EXPR_SUB,
-            EVAL_EXPR_MUL,
-            EVAL_EXPR_DIV,
-            EVAL_EXPR_MOD,
-            EVAL_EXPR_NONE,
-        };
-
-        enum EEvalExprCode
-        {
-            EVAL_EXPR_PARENTHESIS = 0,
-            EVAL_EXPR_DIVIDE_ZERO,
-            EVAL_EXPR_MODULO_ZERO,
-            EVAL_EXPR_SYNTHAX_INCORRECT,
-            EVAL_EXPR_INVALID_NUMBER,
-            EVAL_EXPR_SUCCESS,
-        };
-
-        template <typename T>
-        static EEvalExprCode Operation(char const **expr, T &res, bool parenthesis);
-
-        static unsigned char IsOperator(char const expr)
-        {
-            return (expr == '+' || expr == '-' || expr == '*' || expr == '/');
-        }
-
-        static void DeleteSpace(char const **expr)
-        {
-            while (**expr && (**expr == ' ' || **expr == '\t'))
-                ++(*expr);
-        }
-
-        template <typename T>
-        static EEvalExprCode Calc(T const left, T const right, T &res, EEvalExprOperator const op)
-        {
-            EEvalExprCode status = EVAL_EXPR_SUCCESS;
-
-            switch (op)
-            {
-            case EVAL_EXPR_ADD:
-                res = left + right;
-                break;
-            case EVAL_EXPR_SUB:
-                res = left - right;
-                break;
-            case EVAL_EXPR_MUL:
-                res = left * right;
-                break;
-            case EVAL_EXPR_DIV:
-                if (right)
-                    res = left / right;
-                else
-                    status = EVAL_EXPR_DIVIDE_ZERO;
-                break;
-            case EVAL_EXPR_MOD:
-                if (right != 0.0)
-                    res = (T)(((uint64)left) % ((uint64)right));
-                else
-                    status = EVAL_EXPR_MODULO_ZERO;
-                break;
-            default:
-                status = EVAL_EXPR_SYNTHAX_INCORRECT;
-                break;
-            }
-            return status;
-        }
-
         template <typename T>
         T EvalNbr(const char *expr, char **endptr)
         {
@@ -108,194 +42,535 @@ namespace bpf
         }
 
         template <>
-        fint EvalNbr(char const *expr, char **endptr)
+        inline fint EvalNbr(char const *expr, char **endptr)
         {
             return (std::strtol(expr, endptr, 0));
         }
 
         template <>
-        uint32 EvalNbr(char const *expr, char **endptr)
+        inline uint32 EvalNbr(char const *expr, char **endptr)
         {
             return (std::strtoul(expr, endptr, 0));
         }
 
         template <>
-        int64 EvalNbr(char const *expr, char **endptr)
+        inline int64 EvalNbr(char const *expr, char **endptr)
         {
             return (std::strtoll(expr, endptr, 0));
         }
 
         template <>
-        uint64 EvalNbr(char const *expr, char **endptr)
+        inline uint64 EvalNbr(char const *expr, char **endptr)
         {
             return (std::strtoull(expr, endptr, 0));
         }
 
         template <>
-        float EvalNbr(char const *expr, char **endptr)
+        inline float EvalNbr(char const *expr, char **endptr)
         {
             return (std::strtof(expr, endptr));
         }
 
         template <>
-        double EvalNbr(char const *expr, char **endptr)
+        inline double EvalNbr(char const *expr, char **endptr)
         {
             return (std::strtod(expr, endptr));
         }
 
         template <typename T>
-        static EEvalExprCode Number(char const **expr, T &num)
+        struct Function
         {
-            EEvalExprCode status = EVAL_EXPR_SUCCESS;
+            const char *Name;
+            fsize Arity;
+            T (*Call)(const T *args);
+        };
 
-            DeleteSpace(expr);
-            if (**expr)
+        template <typename T>
+        class Functions
+        {
+        private:
+            static T Abs(const T *a)
+            {
+                return (a[0] < 0 ? -a[0] : a[0]);
+            }
+            static T Sqrt(const T *a)
+            {
+                return ((T)std::sqrt((double)a[0]));
+            }
+            static T Sin(const T *a)
+            {
+                return ((T)std::sin((double)a[0]));
+            }
+            static T Cos(const T *a)
+            {
+                return ((T)std::cos((double)a[0]));
+            }
+            static T Tan(const T *a)
+            {
+                return ((T)std::tan((double)a[0]));
+            }
+            static T Exp(const T *a)
+            {
+                return ((T)std::exp((double)a[0]));
+            }
+            static T Log(const T *a)
             {
-                num = EvalNbr<T>(*expr, (char **)expr);
-                if (**expr == '(')
+                return ((T)std::log((double)a[0]));
+            }
+            static T Floor(const T *a)
+            {
+                return ((T)std::floor((double)a[0]));
+            }
+            static T Ceil(const T *a)
+            {
+                return ((T)std::ceil((double)a[0]));
+            }
+            static T Min(const T *a)
+            {
+                return (a[1] < a[0] ? a[1] : a[0]);
+            }
+            static T Max(const T *a)
+            {
+                return (a[0] < a[1] ? a[1] : a[0]);
+            }
+            static T Clamp(const T *a)
+            {
+                return (a[0] < a[1] ? a[1] : (a[2] < a[0] ? a[2] : a[0]));
+            }
+
+        public:
+            static T Pow(const T *a)
+            {
+                return ((T)std::pow((double)a[0], (double)a[1]));
+            }
+
+            static const Function<T> *Get(fsize &count)
+            {
+                static const Function<T> functions[] = {
+                    {"abs", 1, &Abs},     {"sqrt", 1, &Sqrt},   {"sin", 1, &Sin},     {"cos", 1, &Cos},
+                    {"tan", 1, &Tan},     {"exp", 1, &Exp},     {"log", 1, &Log},     {"floor", 1, &Floor},
+                    {"ceil", 1, &Ceil},   {"min", 2, &Min},     {"max", 2, &Max},     {"pow", 2, &Pow},
+                    {"clamp", 3, &Clamp}};
+
+                count = sizeof(functions) / sizeof(Function<T>);
+                return (functions);
+            }
+        };
+
+        /**
+         * Applies a binary operator
+         */
+        template <typename T>
+        inline T Apply(const EOpCode op, const T left, const T right)
+        {
+            switch (op)
+            {
+            case EVAL_OP_ADD:
+                return (left + right);
+            case EVAL_OP_SUB:
+                return (left - right);
+            case EVAL_OP_MUL:
+                return (left * right);
+            case EVAL_OP_DIV:
+                if (right == 0)
+                    throw EvalException("Division by zero");
+                return (left / right);
+            case EVAL_OP_MOD:
+                if (right == 0)
+                    throw EvalException("Modulo by zero");
+                return ((T)(((uint64)left) % ((uint64)right)));
+            default:
+            {
+                T args[2] = {left, right};
+                return (Functions<T>::Pow(args));
+            }
+            }
+        }
+
+        /**
+         * Recursive descent parser emitting postfix code; sub-expressions made only of constants
+         * are folded as they are emitted
+         */
+        template <typename T>
+        class Compiler
+        {
+        private:
+            const char *_expr;
+            typename MathEval<T>::Program &_program;
+
+            void SkipSpaces()
+            {
+                while (*_expr == ' ' || *_expr == '\t')
+                    ++_expr;
+            }
+
+            bool IsConst(const fsize fromEnd) const
+            {
+                auto &code = _program._code;
+                return (code.Size() >= fromEnd && code[code.Size() - fromEnd].Op == EVAL_OP_CONST);
+            }
+
+            void EmitConst(const T value)
+            {
+                _program._code.Add(Instruction<T>{EVAL_OP_CONST, 0, value});
+            }
+
+            void EmitBinary(const EOpCode op)
+            {
+                auto &code = _program._code;
+                if (IsConst(1) && IsConst(2))
+                {
+                    T right = code.Last().Value;
+                    code.RemoveLast();
+                    code.Last().Value = Apply(op, code.Last().Value, right);
+                    return;
+                }
+                code.Add(Instruction<T>{op, 0, T()});
+            }
+
+            void EmitCall(const fsize id, const Function<T> &func)
+            {
+                auto &code = _program._code;
+                bool constant = true;
+                for (fsize i = 1; i <= func.Arity; ++i)
+                    constant &= IsConst(i);
+                if (constant)
                 {
-                    if (num == 0.0)
+                    T args[3];
+                    for (fsize i = 0; i != func.Arity; ++i)
+                        args[i] = code[code.Size() - func.Arity + i].Value;
+                    for (fsize i = 0; i != func.Arity; ++i)
+                        code.RemoveLast();
+                    EmitConst(func.Call(args));
+                    return;
+                }
+                code.Add(Instruction<T>{EVAL_OP_CALL, id, T()});
+            }
+
+            void EmitVariable(const String &name)
+            {
+                auto &vars = _program._variables;
+                fsize id = 0;
+                while (id != vars.Size() && vars[id] != name)
+                    ++id;
+                if (id == vars.Size())
+                    vars.Add(name);
+                _program._code.Add(Instruction<T>{EVAL_OP_VAR, id, T()});
+            }
+
+            void Identifier()
+            {
+                const char *start = _expr;
+                while ((*_expr >= 'a' && *_expr <= 'z') || (*_expr >= 'A' && *_expr <= 'Z') || *_expr == '_'
+                       || (*_expr >= '0' && *_expr <= '9'))
+                    ++_expr;
+                String name(start, (fsize)(_expr - start));
+                SkipSpaces();
+                if (*_expr != '(')
+                {
+                    EmitVariable(name);
+                    return;
+                }
+                fsize count;
+                const Function<T> *funcs = Functions<T>::Get(count);
+                fsize id = 0;
+                while (id != count && name != funcs[id].Name)
+                    ++id;
+                if (id == count)
+                    throw EvalException(String("Unknown function '") + name + "'");
+                ++_expr;
+                for (fsize i = 0; i != funcs[id].Arity; ++i)
+                {
+                    if (i > 0)
                     {
-                        ++(*expr);
-                        status = Operation(expr, num, true);
+                        if (*_expr != ',')
+                            throw EvalException(String("Wrong number of arguments to '") + name + "'");
+                        ++_expr;
                     }
+                    Sum();
                 }
-                else if (!(!**expr || IsOperator(**expr) || **expr == ' ' || **expr == '\t' || **expr == ')'))
-                    status = EVAL_EXPR_INVALID_NUMBER;
+                if (*_expr != ')')
+                    throw EvalException(String("Wrong number of arguments to '") + name + "'");
+                ++_expr;
+                EmitCall(id, funcs[id]);
             }
-            return status;
-        }
 
-        template <typename T>
-        static EEvalExprCode Product(char const **expr, T &res)
-        {
-            T leftOperand = 0;
-            T rightOperand = 0;
-            EEvalExprOperator op = EVAL_EXPR_MUL;
-            EEvalExprCode status;
+            void Primary()
+            {
+                SkipSpaces();
+                if (*_expr == '(')
+                {
+                    ++_expr;
+                    Sum();
+                    if (*_expr != ')')
+                        throw EvalException("Missing parenthesis");
+                    ++_expr;
+                }
+                else if ((*_expr >= '0' && *_expr <= '9') || *_expr == '.')
+                {
+                    char *end;
+                    T num = EvalNbr<T>(_expr, &end);
+                    if (end == _expr)
+                        throw EvalException("Number expected");
+                    _expr = end;
+                    EmitConst(num);
+                }
+                else if ((*_expr >= 'a' && *_expr <= 'z') || (*_expr >= 'A' && *_expr <= 'Z') || *_expr == '_')
+                    Identifier();
+                else
+                    throw EvalException("Number expected");
+                SkipSpaces();
+            }
 
-            if ((status = Number(expr, leftOperand)) == EVAL_EXPR_SUCCESS)
+            void Power()
             {
-                DeleteSpace(expr);
-                switch (**expr)
+                Primary();
+                if (*_expr == '^')
                 {
-                case '*':
-                case '/':
-                    if (**expr == '/')
-                        op = EVAL_EXPR_DIV;
-                case '%':
-                    if (**expr == '%')
-                        op = EVAL_EXPR_MOD;
-                    ++(*expr);
-                    DeleteSpace(expr);
-                    status = (IsOperator(**expr)) ? EVAL_EXPR_SYNTHAX_INCORRECT : Product(expr, rightOperand);
-                    break;
-                case '(':
-                    status = EVAL_EXPR_SYNTHAX_INCORRECT;
-                    break;
-                case '+':
-                case '-':
-                case ')':
-                case '\0':
-                    rightOperand = (T)1.0;
-                    break;
-                default:
-                    status = EVAL_EXPR_SYNTHAX_INCORRECT;
-                    break;
+                    ++_expr;
+                    Unary();
+                    EmitBinary(EVAL_OP_POW);
                 }
-                if (status == EVAL_EXPR_SUCCESS)
+            }
+
+            void Unary()
+            {
+                SkipSpaces();
+                if (*_expr == '-')
                 {
-                    if (rightOperand != 1.0 || op == EVAL_EXPR_MOD)
-                        status = Calc(leftOperand, rightOperand, res, op);
+                    ++_expr;
+                    Unary();
+                    if (IsConst(1))
+                        _program._code.Last().Value = -_program._code.Last().Value;
                     else
-                        res = leftOperand;
+                        _program._code.Add(Instruction<T>{EVAL_OP_NEG, 0, T()});
+                }
+                else if (*_expr == '+')
+                {
+                    ++_expr;
+                    Unary();
                 }
+                else
+                    Power();
             }
-            return status;
-        }
 
-        template <typename T>
-        static EEvalExprCode Sum(char const **expr, T &res)
-        {
-            T leftOperand = 0;
-            T rightOperand = 0;
-            EEvalExprOperator op = EVAL_EXPR_ADD;
-            EEvalExprCode status;
+            void Product()
+            {
+                Unary();
+                while (*_expr == '*' || *_expr == '/' || *_expr == '%')
+                {
+                    EOpCode op = *_expr == '*' ? EVAL_OP_MUL : (*_expr == '/' ? EVAL_OP_DIV : EVAL_OP_MOD);
+                    ++_expr;
+                    Unary();
+                    EmitBinary(op);
+                }
+            }
 
-            if ((status = Product(expr, leftOperand)) == EVAL_EXPR_SUCCESS)
+            void Sum()
             {
-                switch (**expr)
+                Product();
+                while (*_expr == '+' || *_expr == '-')
                 {
-                case '-':
-                    op = EVAL_EXPR_SUB;
-                case '+':
-                    ++(*expr);
-                    DeleteSpace(expr);
-                    status = (IsOperator(**expr)) ? EVAL_EXPR_SYNTHAX_INCORRECT : Sum(expr, rightOperand);
-                    if (status == EVAL_EXPR_SUCCESS)
-                        status = Calc(leftOperand, rightOperand, res, op);
-                    break;
-                default:
-                    res = leftOperand;
-                    break;
+                    EOpCode op = *_expr == '+' ? EVAL_OP_ADD : EVAL_OP_SUB;
+                    ++_expr;
+                    Product();
+                    EmitBinary(op);
                 }
             }
-            return status;
-        }
 
-        template <typename T>
-        static EEvalExprCode Operation(char const **expr, T &res, bool const parenthesis)
+        public:
+            Compiler(const char *expr, typename MathEval<T>::Program &program)
+                : _expr(expr)
+                , _program(program)
+            {
+            }
+
+            void Run(const collection::ArrayList<String> &variables)
+            {
+                for (auto &name : variables)
+                    _program._variables.Add(name);
+                SkipSpaces();
+                if (*_expr == '\0')
+                    EmitConst(T());
+                else
+                    Sum();
+                if (*_expr == ')')
+                    throw EvalException("Missing parenthesis");
+                if (*_expr != '\0')
+                    throw EvalException("Syntax error");
+                fsize count;
+                const Function<T> *funcs = Functions<T>::Get(count);
+                fsize depth = 0;
+                for (auto &ins : _program._code)
+                {
+                    if (ins.Op == EVAL_OP_CONST || ins.Op == EVAL_OP_VAR)
+                        ++depth;
+                    else if (ins.Op == EVAL_OP_CALL)
+                        depth -= funcs[ins.Index].Arity - 1;
+                    else if (ins.Op != EVAL_OP_NEG)
+                        --depth;
+                    if (depth > _program._depth)
+                        _program._depth = depth;
+                }
+                if (_program._depth > MathEval<T>::MAX_DEPTH)
+                    throw EvalException("Expression too complex");
+            }
+        };
+    }
+
+    template <typename T>
+    constexpr fsize MathEval<T>::MAX_DEPTH;
+
+    template <typename T>
+    fisize MathEval<T>::Program::GetVariableIndex(const String &name) const noexcept
+    {
+        for (fsize i = 0; i != _variables.Size(); ++i)
         {
-            T operand = 0;
-            EEvalExprCode status = EVAL_EXPR_SUCCESS;
+            if (_variables[i] == name)
+                return ((fisize)i);
+        }
+        return (-1);
+    }
+
+    template <typename T>
+    T MathEval<T>::Program::Evaluate(const T *variables) const
+    {
+        using namespace _bpf_internal_evale;
+        T stack[MAX_DEPTH];
+        fsize top = 0;
+        fsize count;
+        const Function<T> *funcs = Functions<T>::Get(count);
 
-            DeleteSpace(expr);
-            switch (**expr)
+        if (_code.Size() == 0)
+            throw EvalException("Empty program");
+        if (variables == nullptr && _variables.Size() > 0)
+            throw EvalException("Missing variable values");
+        for (auto &ins : _code)
+        {
+            switch (ins.Op)
             {
-            case '\0':
+            case EVAL_OP_CONST:
+                stack[top++] = ins.Value;
+                break;
+            case EVAL_OP_VAR:
+                stack[top++] = variables[ins.Index];
+                break;
+            case EVAL_OP_NEG:
+                stack[top - 1] = -stack[top - 1];
+                break;
+            case EVAL_OP_CALL:
+                top -= funcs[ins.Index].Arity;
+                stack[top] = funcs[ins.Index].Call(stack + top);
+                ++top;
                 break;
             default:
-                if (((status = Sum(expr, res)) == EVAL_EXPR_SUCCESS) && **expr == '(')
-                {
-                    ++(*expr);
-                    status = Operation(expr, operand, true);
-                }
+                --top;
+                stack[top - 1] = Apply(ins.Op, stack[top - 1], stack[top]);
                 break;
             }
-            if (parenthesis)
+        }
+        return (stack[0]);
+    }
+
+    template <typename T>
+    void MathEval<T>::Program::Evaluate(const T *const *variables, T *out, const fsize count) const
+    {
+        using namespace _bpf_internal_evale;
+        constexpr fsize CHUNK = 64;
+        collection::Array<T> regs(_depth * CHUNK);
+        fsize fcount;
+        const Function<T> *funcs = Functions<T>::Get(fcount);
+
+        if (_code.Size() == 0)
+            throw EvalException("Empty program");
+        for (fsize start = 0; start < count; start += CHUNK)
+        {
+            fsize n = count - start < CHUNK ? count - start : CHUNK;
+            T *top = *regs;
+            // Every instruction runs over the whole chunk: the dispatch cost is paid once per chunk
+            for (auto &ins : _code)
             {
-                if (**expr == ')')
-                    ++(*expr);
-                else
-                    status = EVAL_EXPR_PARENTHESIS;
+                // Operands are addressed from the register below top: top itself may be one past the last register
+                T *below;
+                switch (ins.Op)
+                {
+                case EVAL_OP_CONST:
+                    for (fsize i = 0; i != n; ++i)
+                        top[i] = ins.Value;
+                    top += CHUNK;
+                    break;
+                case EVAL_OP_VAR:
+                    for (fsize i = 0; i != n; ++i)
+                        top[i] = variables[ins.Index][start + i];
+                    top += CHUNK;
+                    break;
+                case EVAL_OP_NEG:
+                    below = top - CHUNK;
+                    for (fsize i = 0; i != n; ++i)
+                        below[i] = -below[i];
+                    break;
+                case EVAL_OP_ADD:
+                    top -= CHUNK;
+                    below = top - CHUNK;
+                    for (fsize i = 0; i != n; ++i)
+                        below[i] += top[i];
+                    break;
+                case EVAL_OP_SUB:
+                    top -= CHUNK;
+                    below = top - CHUNK;
+                    for (fsize i = 0; i != n; ++i)
+                        below[i] -= top[i];
+                    break;
+                case EVAL_OP_MUL:
+                    top -= CHUNK;
+                    below = top - CHUNK;
+                    for (fsize i = 0; i != n; ++i)
+                        below[i] *= top[i];
+                    break;
+                case EVAL_OP_CALL:
+                {
+                    const Function<T> &func = funcs[ins.Index];
+                    top -= CHUNK * func.Arity;
+                    for (fsize i = 0; i != n; ++i)
+                    {
+                        T args[3];
+                        for (fsize j = 0; j != func.Arity; ++j)
+                            args[j] = top[j * CHUNK + i];
+                        top[i] = func.Call(args);
+                    }
+                    top += CHUNK;
+                    break;
+                }
+                default:
+                    top -= CHUNK;
+                    below = top - CHUNK;
+                    for (fsize i = 0; i != n; ++i)
+                        below[i] = Apply(ins.Op, below[i], top[i]);
+                    break;
+                }
             }
-            res += operand;
-            return status;
+            for (fsize i = 0; i != n; ++i)
+                out[start + i] = regs[i];
         }
     }
 
+    template <typename T>
+    typename MathEval<T>::Program MathEval<T>::Compile(const String &str, const collection::ArrayList<String> &variables) const
+    {
+        Program program;
+
+        _bpf_internal_evale::Compiler<T>(*str, program).Run(variables);
+        return (program);
+    }
+
     template <typename T>
     T MathEval<T>::Evaluate(const bpf::String &str)
     {
-        const char *ptr = *str;
-        T res = 0;
-        _bpf_internal_evale::EEvalExprCode code = _bpf_internal_evale::Operation(&ptr, res, false);
+        Program program = Compile(str);
 
-        switch (code)
-        {
-        case _bpf_internal_evale::EVAL_EXPR_DIVIDE_ZERO:
-            throw EvalException("Division by zero");
-        case _bpf_internal_evale::EVAL_EXPR_INVALID_NUMBER:
-            throw EvalException("Number expected");
-        case _bpf_internal_evale::EVAL_EXPR_MODULO_ZERO:
-            throw EvalException("Modulo by zero");
-        case _bpf_internal_evale::EVAL_EXPR_SYNTHAX_INCORRECT:
-            throw EvalException("Syntax error");
-        case _bpf_internal_evale::EVAL_EXPR_PARENTHESIS:
-            throw EvalException("Missing parenthesis");
-        default:
-            return (res);
-        }
+        if (program.GetVariables().Size() > 0)
+            throw EvalException(String("Unknown variable '") + program.GetVariables()[0] + "'");
+        return (program.Evaluate());
     }
 
     template <typename T>
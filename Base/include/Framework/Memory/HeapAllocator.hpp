@@ -0,0 +1,85 @@
+// Copyright (c) 2020, BlockProject 3D
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without modification,
+// are permitted provided that the following conditions are met:
+// 
+//     * Redistributions of source code must retain the above copyright notice,
+//       this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above copyright notice,
+//       this list of conditions and the following disclaimer in the documentation
+//       and/or other materials provided with the distribution.
+//     * Neither the name of BlockProject 3D nor the names of its contributors
+//       may be used to endorse or promote products derived from this software
+//       without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#pragma once
+#include "Framework/Memory/MemUtils.hpp"
+#include <utility>
+
+namespace bpf
+{
+    namespace memory
+    {
+        /**
+         * Node allocation policy of node based collections: one heap allocation per object.
+         * An allocation policy provides New, Delete and Release and tells through BULK_RELEASE
+         * whether Release frees the memory of every object still allocated
+         * @tparam T the type of object to allocate
+         */
+        template <typename T>
+        class BP_TPL_API HeapAllocator
+        {
+        public:
+            /**
+             * Objects must be deleted one by one, Release does nothing
+             */
+            static constexpr bool BULK_RELEASE = false;
+
+            /**
+             * Allocates a new object
+             * @tparam Args argument types to the constructor
+             * @param args arguments to the constructor
+             * @throw MemoryException in case allocation is impossible
+             * @return pointer to new allocated object
+             */
+            template <typename... Args>
+            inline T *New(Args &&... args)
+            {
+                return (MemUtils::New<T>(std::forward<Args>(args)...));
+            }
+
+            /**
+             * Frees an object
+             * @param obj pointer to object
+             */
+            inline void Delete(T *obj) noexcept
+            {
+                MemUtils::Delete(obj);
+            }
+
+            /**
+             * Releases all memory owned by this allocator
+             */
+            inline void Release() noexcept
+            {
+            }
+        };
+
+        template <typename T>
+        constexpr bool HeapAllocator<T>::BULK_RELEASE;
+    }
+}
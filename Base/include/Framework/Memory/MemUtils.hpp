@@ -28,6 +28,7 @@
 
 #pragma once
 #include "Framework/Memory/Memory.hpp"
+#include <utility>
 
 namespace bpf
 {
@@ -0,0 +1,220 @@
+// Copyright (c) 2020, BlockProject 3D
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without modification,
+// are permitted provided that the following conditions are met:
+// 
+//     * Redistributions of source code must retain the above copyright notice,
+//       this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above copyright notice,
+//       this list of conditions and the following disclaimer in the documentation
+//       and/or other materials provided with the distribution.
+//     * Neither the name of BlockProject 3D nor the names of its contributors
+//       may be used to endorse or promote products derived from this software
+//       without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#pragma once
+#include "Framework/Memory/Memory.hpp"
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace bpf
+{
+    namespace memory
+    {
+        /**
+         * Node allocation policy carving objects from chunks of growing size, with a free list of deleted slots.
+         * Release frees all chunks at once without calling destructors, so collections of trivially
+         * destructible elements skip per-node deletion in Clear. A pool belongs to a single collection and is not thread safe
+         * @tparam T the type of object to allocate
+         */
+        template <typename T>
+        class BP_TPL_API PoolAllocator
+        {
+        private:
+            union Slot
+            {
+                Slot *Next;
+                typename std::aligned_storage<sizeof(T), alignof(T)>::type Storage;
+            };
+
+            static constexpr fsize MIN_CHUNK = 32;
+            static constexpr fsize MAX_CHUNK = 4096;
+
+            // The first slot of every chunk links to the previously allocated chunk
+            Slot *_chunks;
+            Slot *_free;
+            Slot *_cur;
+            Slot *_end;
+            fsize _chunkSize;
+            fsize _capacity;
+
+            void Grow()
+            {
+                Slot *chunk = static_cast<Slot *>(Memory::Malloc((_chunkSize + 1) * sizeof(Slot)));
+
+                chunk->Next = _chunks;
+                _chunks = chunk;
+                _cur = chunk + 1;
+                _end = _cur + _chunkSize;
+                _capacity += _chunkSize;
+                if (_chunkSize < MAX_CHUNK)
+                    _chunkSize *= 2;
+            }
+
+        public:
+            /**
+             * Release frees every object
+             */
+            static constexpr bool BULK_RELEASE = true;
+
+            inline PoolAllocator() noexcept
+                : _chunks(nullptr)
+                , _free(nullptr)
+                , _cur(nullptr)
+                , _end(nullptr)
+                , _chunkSize(MIN_CHUNK)
+                , _capacity(0)
+            {
+            }
+
+            inline PoolAllocator(PoolAllocator &&other) noexcept
+                : _chunks(other._chunks)
+                , _free(other._free)
+                , _cur(other._cur)
+                , _end(other._end)
+                , _chunkSize(other._chunkSize)
+                , _capacity(other._capacity)
+            {
+                other._chunks = nullptr;
+                other._free = nullptr;
+                other._cur = nullptr;
+                other._end = nullptr;
+                other._chunkSize = MIN_CHUNK;
+                other._capacity = 0;
+            }
+
+            PoolAllocator(const PoolAllocator &other) = delete;
+
+            inline ~PoolAllocator()
+            {
+                Release();
+            }
+
+            inline PoolAllocator &operator=(PoolAllocator &&other) noexcept
+            {
+                if (this == &other)
+                    return (*this);
+                Release();
+                _chunks = other._chunks;
+                _free = other._free;
+                _cur = other._cur;
+                _end = other._end;
+                _chunkSize = other._chunkSize;
+                _capacity = other._capacity;
+                other._chunks = nullptr;
+                other._free = nullptr;
+                other._cur = nullptr;
+                other._end = nullptr;
+                other._chunkSize = MIN_CHUNK;
+                other._capacity = 0;
+                return (*this);
+            }
+
+            PoolAllocator &operator=(const PoolAllocator &other) = delete;
+
+            /**
+             * Allocates a new object
+             * @tparam Args argument types to the constructor
+             * @param args arguments to the constructor
+             * @throw MemoryException in case allocation is impossible
+             * @return pointer to new allocated object
+             */
+            template <typename... Args>
+            T *New(Args &&... args)
+            {
+                Slot *slot;
+
+                if (_free != nullptr)
+                {
+                    slot = _free;
+                    _free = _free->Next;
+                }
+                else
+                {
+                    if (_cur == _end)
+                        Grow();
+                    slot = _cur++;
+                }
+                try
+                {
+                    return (new (&slot->Storage) T(std::forward<Args>(args)...));
+                }
+                catch (...)
+                {
+                    slot->Next = _free;
+                    _free = slot;
+                    throw;
+                }
+            }
+
+            /**
+             * Destroys an object and recycles its slot
+             * @param obj pointer to object
+             */
+            inline void Delete(T *obj) noexcept
+            {
+                if (obj == nullptr)
+                    return;
+                obj->~T();
+                Slot *slot = reinterpret_cast<Slot *>(obj);
+                slot->Next = _free;
+                _free = slot;
+            }
+
+            /**
+             * Frees all chunks, objects still allocated are discarded without calling their destructor
+             */
+            void Release() noexcept
+            {
+                while (_chunks != nullptr)
+                {
+                    Slot *next = _chunks->Next;
+                    Memory::Free(_chunks);
+                    _chunks = next;
+                }
+                _free = nullptr;
+                _cur = nullptr;
+                _end = nullptr;
+                _chunkSize = MIN_CHUNK;
+                _capacity = 0;
+            }
+
+            /**
+             * Returns the number of object slots currently owned by this allocator
+             * @return number of slots as unsigned
+             */
+            inline fsize Capacity() const noexcept
+            {
+                return (_capacity);
+            }
+        };
+
+        template <typename T>
+        constexpr bool PoolAllocator<T>::BULK_RELEASE;
+    }
+}
@@ -193,6 +193,15 @@ namespace bpf
                 return (RawPtr);
             }
 
+            /**
+             * Returns the number of SharedPtr sharing the ownership of the instance
+             * @return number of strong references, 0 if this SharedPtr is null
+             */
+            inline fint GetUseCount() const noexcept
+            {
+                return (Count != nullptr ? *Count : 0);
+            }
+
             /**
              * Compare SharedPtr
              * @param other operand
@@ -0,0 +1,162 @@
+// Copyright (c) 2020, BlockProject 3D
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without modification,
+// are permitted provided that the following conditions are met:
+// 
+//     * Redistributions of source code must retain the above copyright notice,
+//       this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above copyright notice,
+//       this list of conditions and the following disclaimer in the documentation
+//       and/or other materials provided with the distribution.
+//     * Neither the name of BlockProject 3D nor the names of its contributors
+//       may be used to endorse or promote products derived from this software
+//       without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#pragma once
+#include "Framework/Types.hpp"
+
+namespace bpf
+{
+    /**
+     * Allocation-free conversions between numbers and their decimal text representation.
+     * Integers are formatted two digits at a time, floating point numbers are formatted to the shortest string
+     * which parses back to the exact same value (Schubfach) and parsed with the Eisel-Lemire algorithm.
+     * None of the functions depend on the current locale
+     */
+    class BPF_API NumberConvert
+    {
+    public:
+        /**
+         * Size of a buffer large enough to hold any number formatted by this class
+         */
+        static constexpr fsize MAX_CHARS = 32;
+
+        /**
+         * Outcome of a parse operation
+         */
+        enum class EParseResult
+        {
+            /**
+             * The whole input is a valid number which fits in the requested type
+             */
+            SUCCESS,
+
+            /**
+             * The input is not a number or contains trailing characters
+             */
+            INVALID_FORMAT,
+
+            /**
+             * The input is a valid number which cannot be represented by the requested type
+             */
+            OUT_OF_RANGE
+        };
+
+        /**
+         * Formats an unsigned integer in decimal
+         * @param value the value to format
+         * @param buffer output buffer of at least MAX_CHARS bytes, not null terminated
+         * @return number of characters written
+         */
+        static fsize Format(uint64 value, char *buffer) noexcept;
+
+        /**
+         * Formats a signed integer in decimal
+         * @param value the value to format
+         * @param buffer output buffer of at least MAX_CHARS bytes, not null terminated
+         * @return number of characters written
+         */
+        static fsize Format(int64 value, char *buffer) noexcept;
+
+        /**
+         * Formats an unsigned 32 bits integer in decimal
+         * @param value the value to format
+         * @param buffer output buffer of at least MAX_CHARS bytes, not null terminated
+         * @return number of characters written
+         */
+        static fsize Format(uint32 value, char *buffer) noexcept;
+
+        /**
+         * Formats a signed 32 bits integer in decimal
+         * @param value the value to format
+         * @param buffer output buffer of at least MAX_CHARS bytes, not null terminated
+         * @return number of characters written
+         */
+        static fsize Format(fint value, char *buffer) noexcept;
+
+        /**
+         * Formats a double to the shortest decimal string which parses back to the same double.
+         * Numbers with a decimal exponent in [-5, 17) are written in fixed notation, others in scientific
+         * notation (ex: 1e+20); non-finite values are written inf, -inf, nan or -nan
+         * @param value the value to format
+         * @param buffer output buffer of at least MAX_CHARS bytes, not null terminated
+         * @return number of characters written
+         */
+        static fsize Format(double value, char *buffer) noexcept;
+
+        /**
+         * Formats a float to the shortest decimal string which parses back to the same float
+         * @param value the value to format
+         * @param buffer output buffer of at least MAX_CHARS bytes, not null terminated
+         * @return number of characters written
+         */
+        static fsize Format(float value, char *buffer) noexcept;
+
+        /**
+         * Parses a signed integer. The syntax is the one of strtol with base 0: optional leading white spaces,
+         * optional sign, then a decimal number, an hexadecimal number prefixed by 0x or an octal number prefixed
+         * by 0
+         * @param str the characters to parse
+         * @param len the number of characters to parse
+         * @param res the parsed value, left untouched on failure
+         * @return SUCCESS if the whole input was parsed
+         */
+        static EParseResult Parse(const char *str, fsize len, int64 &res) noexcept;
+
+        /**
+         * Parses an unsigned integer, same syntax as the signed variant; a minus sign is only accepted in
+         * front of zero
+         * @param str the characters to parse
+         * @param len the number of characters to parse
+         * @param res the parsed value, left untouched on failure
+         * @return SUCCESS if the whole input was parsed
+         */
+        static EParseResult Parse(const char *str, fsize len, uint64 &res) noexcept;
+
+        /**
+         * Parses a double, correctly rounded. The syntax is the one of strtod: optional leading white spaces,
+         * optional sign, then a decimal number with optional exponent, inf, infinity, nan or an hexadecimal
+         * floating point number
+         * @param str the characters to parse
+         * @param len the number of characters to parse
+         * @param res the parsed value, left untouched on failure
+         * @return SUCCESS if the whole input was parsed, OUT_OF_RANGE if the number overflows to infinity or
+         * underflows to zero
+         */
+        static EParseResult Parse(const char *str, fsize len, double &res) noexcept;
+
+        /**
+         * Parses a float, correctly rounded (no double rounding through double)
+         * @param str the characters to parse
+         * @param len the number of characters to parse
+         * @param res the parsed value, left untouched on failure
+         * @return SUCCESS if the whole input was parsed, OUT_OF_RANGE if the number overflows to infinity or
+         * underflows to zero
+         */
+        static EParseResult Parse(const char *str, fsize len, float &res) noexcept;
+    };
+}
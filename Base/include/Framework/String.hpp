@@ -120,6 +120,13 @@ namespace bpf
          */
         String(const char *str);
 
+        /**
+         * Constructs a new string from a low-level buffer of UTF-8 data
+         * @param str pointer to an array of bytes containing UTF-8 data
+         * @param len the number of bytes to copy
+         */
+        String(const char *str, fsize len);
+
         /**
          * Constructs a new string from a single character
          * @param c the UTF32 code to construct the string from
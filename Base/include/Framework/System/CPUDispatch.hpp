@@ -0,0 +1,140 @@
+// Copyright (c) 2020, BlockProject 3D
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without modification,
+// are permitted provided that the following conditions are met:
+// 
+//     * Redistributions of source code must retain the above copyright notice,
+//       this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above copyright notice,
+//       this list of conditions and the following disclaimer in the documentation
+//       and/or other materials provided with the distribution.
+//     * Neither the name of BlockProject 3D nor the names of its contributors
+//       may be used to endorse or promote products derived from this software
+//       without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#pragma once
+#include "Framework/RuntimeException.hpp"
+#include "Framework/System/Platform.hpp"
+#include <initializer_list>
+#include <utility>
+
+namespace bpf
+{
+    namespace system
+    {
+        template <typename Signature>
+        class CPUDispatch;
+
+        /**
+         * Selects once, among several implementations of a function, the first one supported by the CPU.
+         * Meant to be stored in a static variable so that the selection only happens on first use:
+         * <pre>
+         * static const CPUDispatch<float(const float *, fsize)> sum = {
+         *     {CPU_FEATURE_AVX2 | CPU_FEATURE_FMA, &SumAVX2},
+         *     {CPU_FEATURE_SSE2, &SumSSE2},
+         *     {0, &SumScalar}};
+         * </pre>
+         * @tparam R the return type of the function
+         * @tparam Args the argument types of the function
+         */
+        template <typename R, typename... Args>
+        class BP_TPL_API CPUDispatch<R(Args...)>
+        {
+        public:
+            /**
+             * Function pointer type of the implementations
+             */
+            using Function = R (*)(Args...);
+
+            /**
+             * An implementation and the instruction set extensions it needs
+             */
+            struct Variant
+            {
+                /**
+                 * Required extensions, combination of ECPUFeature flags, 0 for a portable implementation
+                 */
+                uint32 Features;
+
+                /**
+                 * The implementation
+                 */
+                Function Func;
+            };
+
+        private:
+            Function _func;
+
+            void Select(const uint32 features, const std::initializer_list<Variant> &variants)
+            {
+                for (auto &v : variants)
+                {
+                    if ((features & v.Features) == v.Features)
+                    {
+                        _func = v.Func;
+                        return;
+                    }
+                }
+                throw RuntimeException("CPUDispatch", "No implementation is supported by this CPU");
+            }
+
+        public:
+            /**
+             * Selects the first variant supported by the CPU running the application
+             * @param variants the implementations, from the most to the least specialized
+             * @throw RuntimeException if no variant is supported
+             */
+            CPUDispatch(std::initializer_list<Variant> variants)
+                : _func(nullptr)
+            {
+                Select(Platform::GetCPUInfo().Features, variants);
+            }
+
+            /**
+             * Selects the first variant supported by a given set of extensions, for example to force a portable
+             * implementation
+             * @param features available extensions, combination of ECPUFeature flags
+             * @param variants the implementations, from the most to the least specialized
+             * @throw RuntimeException if no variant is supported
+             */
+            CPUDispatch(const uint32 features, std::initializer_list<Variant> variants)
+                : _func(nullptr)
+            {
+                Select(features, variants);
+            }
+
+            /**
+             * Calls the selected implementation
+             * @param args the arguments to forward
+             * @return the result of the implementation
+             */
+            inline R operator()(Args... args) const
+            {
+                return (_func(std::forward<Args>(args)...));
+            }
+
+            /**
+             * Returns the selected implementation
+             * @return function pointer
+             */
+            inline Function Get() const noexcept
+            {
+                return (_func);
+            }
+        };
+    }
+}
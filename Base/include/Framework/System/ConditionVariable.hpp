@@ -0,0 +1,93 @@
+// Copyright (c) 2020, BlockProject 3D
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without modification,
+// are permitted provided that the following conditions are met:
+// 
+//     * Redistributions of source code must retain the above copyright notice,
+//       this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above copyright notice,
+//       this list of conditions and the following disclaimer in the documentation
+//       and/or other materials provided with the distribution.
+//     * Neither the name of BlockProject 3D nor the names of its contributors
+//       may be used to endorse or promote products derived from this software
+//       without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#pragma once
+#include "Framework/System/Mutex.hpp"
+#include "Framework/Types.hpp"
+
+namespace bpf
+{
+    namespace system
+    {
+        /**
+         * Helper to represent a cross-platform condition variable used together with the Framework mutex (see Mutex)
+         */
+        class BPF_API ConditionVariable
+        {
+        private:
+            void *_handle;
+
+        public:
+            /**
+             * Constructs a condition variable
+             * @throw memory::MemoryException if out of memory
+             * @throw OSException in case of system error
+             */
+            ConditionVariable();
+
+            ~ConditionVariable();
+
+            /**
+             * Move constructor
+             */
+            ConditionVariable(ConditionVariable &&other) noexcept;
+
+            /**
+             * Move assignment operator
+             */
+            ConditionVariable &operator=(ConditionVariable &&other) noexcept;
+
+            /**
+             * Atomically unlocks the given mutex and blocks until this condition variable is signaled, the mutex is
+             * locked again before returning. Spurious wake ups are possible: always re-check the awaited condition
+             * @param mutex the mutex protecting the awaited condition, must be locked by the calling thread
+             * @throw OSException in case of system error
+             */
+            void Wait(const Mutex &mutex) const;
+
+            /**
+             * Same as Wait but gives up after a timeout
+             * @param mutex the mutex protecting the awaited condition, must be locked by the calling thread
+             * @param milliseconds the maximum time to wait in milliseconds
+             * @return false if the timeout expired, true otherwise
+             * @throw OSException in case of system error
+             */
+            bool Wait(const Mutex &mutex, uint32 milliseconds) const;
+
+            /**
+             * Wakes up one thread waiting on this condition variable
+             */
+            void Signal() const noexcept;
+
+            /**
+             * Wakes up all threads waiting on this condition variable
+             */
+            void Broadcast() const noexcept;
+        };
+    }
+}
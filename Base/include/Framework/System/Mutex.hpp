@@ -40,6 +40,8 @@ namespace bpf
         private:
             void *_handle;
 
+            friend class ConditionVariable;
+
         public:
             /**
              * Constructs a mutex
@@ -74,6 +74,30 @@ namespace bpf
             String NewLine;
         };
 
+        /**
+         * Instruction set extensions, used with CPU::HasFeatures
+         */
+        enum ECPUFeature
+        {
+            CPU_FEATURE_SSE2 = 0x1,
+            CPU_FEATURE_SSE3 = 0x2,
+            CPU_FEATURE_SSSE3 = 0x4,
+            CPU_FEATURE_SSE41 = 0x8,
+            CPU_FEATURE_SSE42 = 0x10,
+            CPU_FEATURE_POPCNT = 0x20,
+            CPU_FEATURE_AES = 0x40,
+            CPU_FEATURE_AVX = 0x80,
+            CPU_FEATURE_FMA = 0x100,
+            CPU_FEATURE_AVX2 = 0x200,
+            CPU_FEATURE_BMI1 = 0x400,
+            CPU_FEATURE_BMI2 = 0x800,
+            CPU_FEATURE_AVX512F = 0x1000,
+            CPU_FEATURE_AVX512DQ = 0x2000,
+            CPU_FEATURE_AVX512BW = 0x4000,
+            CPU_FEATURE_AVX512VL = 0x8000,
+            CPU_FEATURE_NEON = 0x10000
+        };
+
         /**
          * CPU specs structure
          */
@@ -81,21 +105,72 @@ namespace bpf
         {
             /**
              * Brand name.
-             * In release builds, a generic brand name is populated under Linux and OSX to prevent a bug in GCC itself
-             * On ARM based architectures, a generic brand name is populated as ARM instruction set does not provide any
-             * way to know the CPU brand name
+             * On ARM based architectures other than Mac, a generic brand name is populated as ARM instruction set does
+             * not provide any way to know the CPU brand name
              */
             String Name;
 
             /**
-             * Number of cores (may not be accurate on all systems)
+             * Number of logical processors online
              */
             fint NumCores;
 
             /**
-             * CPU frequency (may not be accurate on all systems)
+             * Maximum CPU frequency in MHz, 1 when it cannot be found
              */
             fint Freq;
+
+            /**
+             * Number of physical cores, logical processors sharing a core through SMT are counted once
+             */
+            fint NumPhysicalCores;
+
+            /**
+             * Number of logical processors per physical core (SMT siblings)
+             */
+            fint ThreadsPerCore;
+
+            /**
+             * Number of NUMA nodes
+             */
+            fint NumNodes;
+
+            /**
+             * Size in bytes of a cache line, 0 if unknown
+             */
+            fsize CacheLineSize;
+
+            /**
+             * Size in bytes of the level 1 data cache of a core, 0 if unknown
+             */
+            fsize L1CacheSize;
+
+            /**
+             * Size in bytes of the level 2 cache, 0 if unknown
+             */
+            fsize L2CacheSize;
+
+            /**
+             * Size in bytes of the level 3 cache, 0 if unknown
+             */
+            fsize L3CacheSize;
+
+            /**
+             * Supported instruction set extensions, combination of ECPUFeature flags.
+             * Extensions which need operating system support (AVX, AVX-512) are only reported when the operating system
+             * saves the corresponding registers
+             */
+            uint32 Features;
+
+            /**
+             * Checks if this CPU supports a set of instruction set extensions
+             * @param features combination of ECPUFeature flags
+             * @return true if all extensions are supported, false otherwise
+             */
+            inline bool HasFeatures(const uint32 features) const noexcept
+            {
+                return ((Features & features) == features);
+            }
         };
 
         /**
@@ -149,8 +224,8 @@ namespace bpf
         private:
             static Env InitEnvInfo();
             static OS InitOSInfo();
+            static CPU InitCPUInfo();
             static String IdentifyCPUBranding();
-            static String CPUIDIntToStr(fint data);
 
         public:
             /**
@@ -166,7 +241,7 @@ namespace bpf
             static const OS &GetOSInfo();
 
             /**
-             * Returns CPU specs
+             * Returns CPU specs, detected once on first call
              * @return CPU structure reference
              */
             static const CPU &GetCPUInfo();
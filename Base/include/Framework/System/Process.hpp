@@ -61,8 +61,10 @@ namespace bpf
                 void CleanupHandles(void *fdStdOut[2], void *fdStdErr[2], void *fdStdIn[2]);
 #else
                 static void CleanupHandles(int fdStdOut[2], int fdStdErr[2], int fdStdIn[2], int commonfd[2]);
+                static void CloseChildEnds(int fdStdOut[2], int fdStdErr[2], int fdStdIn[2]);
                 void ProcessWorker(int fdStdOut[2], int fdStdErr[2], int fdStdIn[2], int commonfd[2]);
                 static Process ProcessMaster(int pid, int fdStdOut[2], int fdStdErr[2], int fdStdIn[2], int commonfd[2]);
+                Process ProcessSpawn(int fdStdOut[2], int fdStdErr[2], int fdStdIn[2]);
 #endif
 
             public:
@@ -169,7 +171,9 @@ namespace bpf
                 }
 
                 /**
-                 * Create a process from the information defined in this builder
+                 * Create a process from the information defined in this builder.
+                 * On Linux the process is started with posix_spawn which does not duplicate the address space of the
+                 * calling process, other POSIX systems use fork
                  * @throw OSException in case the process could not be created
                  * @return instance to represent the new process
                  */
@@ -231,6 +235,7 @@ namespace bpf
                 void Close();
 
                 friend class Process;
+                friend class ProcessSupervisor;
             };
 
 #ifdef WINDOWS
@@ -342,6 +347,7 @@ namespace bpf
             PipeStream &GetStandardError();
 
             friend class Process::Builder;
+            friend class ProcessSupervisor;
         };
     }
 }
@@ -0,0 +1,203 @@
+// Copyright (c) 2020, BlockProject 3D
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without modification,
+// are permitted provided that the following conditions are met:
+// 
+//     * Redistributions of source code must retain the above copyright notice,
+//       this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above copyright notice,
+//       this list of conditions and the following disclaimer in the documentation
+//       and/or other materials provided with the distribution.
+//     * Neither the name of BlockProject 3D nor the names of its contributors
+//       may be used to endorse or promote products derived from this software
+//       without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#pragma once
+#include "Framework/Collection/ArrayList.hpp"
+#include "Framework/Collection/HashMap.hpp"
+#include "Framework/System/Process.hpp"
+#include <functional>
+
+namespace bpf
+{
+    namespace system
+    {
+        class ProcessReactor;
+        struct SupervisedProcess;
+
+        /**
+         * Identifies an output stream of a supervised process
+         */
+        enum class EProcessStream
+        {
+            /**
+             * Standard output
+             */
+            STANDARD_OUTPUT,
+
+            /**
+             * Standard error
+             */
+            STANDARD_ERROR
+        };
+
+        /**
+         * Event driven supervisor for many child processes.
+         * Redirected pipes are switched to non-blocking mode and multiplexed in a single epoll set on Linux (poll on
+         * other POSIX systems); process termination is observed through a pidfd when the kernel supports it, otherwise
+         * by polling waitpid at a short interval.
+         * All callbacks run on the thread calling Poll or Wait. All output of a process is delivered before its exit
+         * callback runs. A ProcessSupervisor must only be used from a single thread.
+         * Not supported on Windows
+         */
+        class BPF_API ProcessSupervisor
+        {
+        public:
+            /**
+             * Callback invoked for each chunk of output read from a process
+             */
+            using OutputCallback = std::function<void(uint64 id, EProcessStream stream, const uint8 *data, fsize size)>;
+
+            /**
+             * Callback invoked once a process has terminated, the process exit code is available
+             */
+            using ExitCallback = std::function<void(uint64 id, Process &process)>;
+
+        private:
+            ProcessReactor *_reactor;
+            uint8 *_buffer;
+            fsize _bufferSize;
+            uint64 _nextId;
+            fsize _polled;
+            collection::HashMap<uint64, SupervisedProcess *> _children;
+            collection::ArrayList<uint64> _exited;
+
+            SupervisedProcess &Get(uint64 id);
+            void Read(uint64 id, SupervisedProcess &child, EProcessStream stream, bool drain);
+            void Flush(SupervisedProcess &child);
+            void CloseInput(SupervisedProcess &child);
+            void Reap(uint64 id, SupervisedProcess &child);
+            void Retire(SupervisedProcess *child);
+            fsize Dispatch(int timeout);
+
+        public:
+            /**
+             * Creates a new ProcessSupervisor
+             * @param bufferSize the size of the buffer used to read process output, this is the maximum size of a
+             * chunk passed to an OutputCallback
+             * @throw OSException in case of system error
+             */
+            explicit ProcessSupervisor(fsize bufferSize = 65536);
+
+            /**
+             * Kills and reaps all processes still supervised
+             */
+            ~ProcessSupervisor();
+
+            /**
+             * Cannot copy a ProcessSupervisor
+             */
+            ProcessSupervisor(const ProcessSupervisor &other) = delete;
+
+            /**
+             * Cannot copy a ProcessSupervisor
+             */
+            ProcessSupervisor &operator=(const ProcessSupervisor &other) = delete;
+
+            /**
+             * Builds a process and starts supervising it
+             * @param builder the builder describing the process to start
+             * @param onOutput function to call for each chunk of redirected output
+             * @param onExit function to call when the process terminates
+             * @throw OSException in case of system error
+             * @return identifier of the process in this supervisor
+             */
+            uint64 Spawn(Process::Builder &builder, OutputCallback onOutput, ExitCallback onExit);
+
+            /**
+             * Starts supervising an already running process. The supervisor takes ownership of the redirected pipes
+             * @param process the process to supervise
+             * @param onOutput function to call for each chunk of redirected output
+             * @param onExit function to call when the process terminates
+             * @throw OSException in case of system error
+             * @return identifier of the process in this supervisor
+             */
+            uint64 Add(Process &&process, OutputCallback onOutput, ExitCallback onExit);
+
+            /**
+             * Writes to the standard input of a process without blocking. Bytes the pipe cannot accept immediately are
+             * buffered and sent as soon as the process reads its input
+             * @param id the identifier of the process
+             * @param buf the buffer with the bytes to write
+             * @param size the size of the buffer
+             * @throw OSException if the process is unknown or its standard input is not redirected
+             */
+            void Write(uint64 id, const void *buf, fsize size);
+
+            /**
+             * Closes the standard input of a process once all buffered bytes have been written
+             * @param id the identifier of the process
+             * @throw OSException if the process is unknown
+             */
+            void CloseInput(uint64 id);
+
+            /**
+             * Sends a termination signal to a process, the exit callback runs once the process has terminated
+             * @param id the identifier of the process
+             * @param force true to send SIGKILL, false to send SIGINT
+             * @throw OSException if the process is unknown or in case of system error
+             */
+            void Kill(uint64 id, bool force);
+
+            /**
+             * Runs the callbacks of all pending output and terminations without blocking
+             * @throw OSException in case of system error
+             * @return number of processes which terminated
+             */
+            fsize Poll();
+
+            /**
+             * Blocks until at least one event has been dispatched, or no process is left, and runs its callbacks
+             * @param timeout maximum time to wait in milliseconds, or -1 to wait forever
+             * @throw OSException in case of system error
+             * @return number of processes which terminated
+             */
+            fsize Wait(int timeout = -1);
+
+            /**
+             * Blocks until all processes have terminated
+             * @throw OSException in case of system error
+             */
+            void WaitAll();
+
+            /**
+             * Returns the number of processes which have not yet terminated
+             * @return number of supervised processes
+             */
+            inline fsize GetRunningCount() const noexcept
+            {
+                return (_children.Size());
+            }
+
+            /**
+             * Returns true if process termination is notified by the kernel (pidfd), false if it is polled
+             * @return true if termination is event driven
+             */
+            bool IsEventDriven() const noexcept;
+        };
+    }
+}
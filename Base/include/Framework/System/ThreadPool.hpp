@@ -29,10 +29,11 @@
 #pragma once
 #include "Framework/Collection/Queue.hpp"
 #include "Framework/Dynamic.hpp"
+#include "Framework/Function.hpp"
 #include "Framework/Memory/UniquePtr.hpp"
+#include "Framework/System/ConditionVariable.hpp"
 #include "Framework/System/Mutex.hpp"
 #include "Framework/System/Thread.hpp"
-#include <functional>
 
 class ThreadRuntime;
 
@@ -48,9 +49,9 @@ namespace bpf
         private:
             struct Task
             {
-                std::function<void()> Processing1;
-                std::function<Dynamic()> Processing;
-                std::function<void(Dynamic &)> Callback;
+                Function<void()> Processing1;
+                Function<Dynamic()> Processing;
+                Function<void(Dynamic &)> Callback;
                 Dynamic Output;
             };
 
@@ -60,6 +61,7 @@ namespace bpf
             collection::Queue<Task> _sharedInputQueue;
             Mutex _outputMutex;
             collection::Queue<Task> _sharedOutputQueue;
+            ConditionVariable _completed; // Signaled with the output mutex locked when a task output is queued
             ThreadRuntime *_threads; // Raw pointer cause Thread does not have a default constructor
 
         public:
@@ -91,7 +93,7 @@ namespace bpf
              * @param processing the actual threaded function
              * @param callback function to call on completion on the thread Poll is called
              */
-            void Run(std::function<Dynamic()> processing, std::function<void(Dynamic &)> callback);
+            void Run(Function<Dynamic()> processing, Function<void(Dynamic &)> callback);
 
             /**
              * Runs a task which does not produce any output
@@ -99,7 +101,18 @@ namespace bpf
              * Passing captures by pointer is undefined in the processing function.
              * @param processing the actual threaded function
              */
-            void Run(std::function<void()> processing);
+            void Run(Function<void()> processing);
+
+            /**
+             * Splits the range [0, count) in contiguous parts of at least grain items, runs them on this ThreadPool
+             * and on the calling thread and blocks until all parts completed.
+             * Wait is called while waiting so callbacks of other tasks may run during this call.
+             * The function must not throw
+             * @param count number of items
+             * @param func function called with the [start, end) bounds of each part
+             * @param grain minimum number of items per part
+             */
+            void ParallelFor(fsize count, const Function<void(fsize, fsize)> &func, fsize grain = 1024);
 
             /**
              * Checks if this ThreadPool is idle: it has no tasks anymore
@@ -110,6 +123,15 @@ namespace bpf
                 return (_tasks == 0);
             }
 
+            /**
+             * Returns the number of threads of this ThreadPool, the calling thread of ParallelFor excluded
+             * @return number of threads
+             */
+            inline fsize GetThreadCount() const noexcept
+            {
+                return (_tcount);
+            }
+
             /**
              * Call this function (usually on the main thread) in order to update the status of each task and run
              * callbacks when needed.
@@ -118,6 +140,12 @@ namespace bpf
              */
             void Poll();
 
+            /**
+             * Blocks until at least one task completed and then calls Poll. Returns immediately if this ThreadPool is
+             * idle. Same threading rules as Poll
+             */
+            void Wait();
+
             friend class ::ThreadRuntime;
         };
     }
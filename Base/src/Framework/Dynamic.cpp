@@ -27,41 +27,83 @@
 // SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include "Framework/Dynamic.hpp"
+#include <cstring>
 
 using namespace bpf;
 
 Dynamic::~Dynamic()
 {
-    memory::MemUtils::Delete(_storage);
+    Reset();
+}
+
+void Dynamic::Reset() noexcept
+{
+    if (_type == nullptr)
+        memory::MemUtils::Delete(_storage);
+    _type = nullptr;
+    _storage = nullptr;
+}
+
+void Dynamic::CopyFrom(const Dynamic &other)
+{
+    if (other._type != nullptr)
+    {
+        std::memcpy(_inline, other._inline, INLINE_SIZE);
+        _type = other._type;
+    }
+    else
+    {
+        _type = nullptr;
+        _storage = other._storage == nullptr ? nullptr : other._storage->Clone();
+    }
+}
+
+void Dynamic::MoveFrom(Dynamic &other) noexcept
+{
+    _type = other._type;
+    if (_type != nullptr)
+        std::memcpy(_inline, other._inline, INLINE_SIZE);
+    else
+        _storage = other._storage;
+    other._type = nullptr;
+    other._storage = nullptr;
 }
 
 Dynamic &Dynamic::operator=(const Dynamic &other)
 {
     if (this == &other)
         return (*this);
-    memory::MemUtils::Delete(_storage);
-    _storage = other._storage == nullptr ? nullptr : other._storage->Clone();
+    Reset();
+    CopyFrom(other);
     return (*this);
 }
 
 Dynamic &Dynamic::operator=(Dynamic &&other) noexcept
 {
-    memory::MemUtils::Delete(_storage);
-    _storage = other._storage;
-    other._storage = nullptr;
+    if (this == &other)
+        return (*this);
+    Reset();
+    MoveFrom(other);
     return (*this);
 }
 
 bool Dynamic::operator==(const Dynamic &other) const
 {
-    if (_storage == nullptr || other._storage == nullptr)
-        return (_storage == other._storage);
+    if (IsNull() || other.IsNull())
+        return (IsNull() && other.IsNull());
+    if (_type != nullptr)
+    {
+        // Inline types are compared by id: each module may instantiate its own type information
+        if (other._type == nullptr || _type->TypeId() != other._type->TypeId())
+            return (false);
+        return (_type->Equals(_inline, other._inline));
+    }
+    if (other._type != nullptr)
+        return (false);
     return (_storage->Equals(other._storage));
 }
 
 bool Dynamic::operator!=(const Dynamic &other) const
 {
-    if (_storage == nullptr || other._storage == nullptr)
-        return (_storage != other._storage);
-    return (!_storage->Equals(other._storage));
+    return (!(*this == other));
 }
@@ -0,0 +1,177 @@
+// Copyright (c) 2020, BlockProject 3D
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without modification,
+// are permitted provided that the following conditions are met:
+// 
+//     * Redistributions of source code must retain the above copyright notice,
+//       this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above copyright notice,
+//       this list of conditions and the following disclaimer in the documentation
+//       and/or other materials provided with the distribution.
+//     * Neither the name of BlockProject 3D nor the names of its contributors
+//       may be used to endorse or promote products derived from this software
+//       without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include "Framework/IO/AsyncFileIO.hpp"
+#include "AsyncIOBackend.hpp"
+#include "Framework/IO/IOException.hpp"
+#include "Framework/Memory/MemUtils.hpp"
+#include "Framework/Memory/UniquePtr.hpp"
+
+using namespace bpf::collection;
+using namespace bpf::memory;
+using namespace bpf::io;
+using namespace bpf;
+
+AsyncFileIO::AsyncFileIO(fsize queueDepth, fsize fileQueueDepth, fsize threads, bool kernelQueue)
+    : _backend(AsyncIOBackend::Create(queueDepth > 0 ? queueDepth : 1, threads > 0 ? threads : 1, kernelQueue))
+    , _fileQueueDepth(fileQueueDepth > 0 ? fileQueueDepth : 1)
+    , _nextId(0)
+    , _inflight(0)
+{
+}
+
+AsyncFileIO::~AsyncFileIO()
+{
+    try
+    {
+        WaitAll();
+    }
+    catch (const IOException &)
+    {
+        // Nothing can be reported from a destructor: give up on the remaining requests
+    }
+    for (auto *request : _waiting)
+        MemUtils::Delete(request);
+    MemUtils::Delete(_backend);
+}
+
+bool AsyncFileIO::IsKernelQueue() const noexcept
+{
+    return (_backend->IsKernelQueue());
+}
+
+uint64 AsyncFileIO::Queue(FileStream &file, bool write, uint64 pos, const IOVector *buffers, fsize count, Callback &&callback)
+{
+    auto *request = MemUtils::New<AsyncIORequest>();
+    request->File = &file;
+    request->Write = write;
+    request->Pos = pos;
+    request->Buffers = Array<IOVector>(count);
+    for (fsize i = 0; i != count; ++i)
+        request->Buffers[i] = buffers[i];
+    request->Callback = std::move(callback);
+    request->Result.Id = _nextId++;
+    request->Result.Bytes = 0;
+    request->Result.Success = false;
+    _waiting.Add(request);
+    return (request->Result.Id);
+}
+
+uint64 AsyncFileIO::Read(FileStream &file, uint64 pos, void *buf, fsize size, Callback callback)
+{
+    IOVector vec = {buf, size};
+    return (Queue(file, false, pos, &vec, 1, std::move(callback)));
+}
+
+uint64 AsyncFileIO::ReadV(FileStream &file, uint64 pos, const IOVector *buffers, fsize count, Callback callback)
+{
+    return (Queue(file, false, pos, buffers, count, std::move(callback)));
+}
+
+uint64 AsyncFileIO::Write(FileStream &file, uint64 pos, const void *buf, fsize size, Callback callback)
+{
+    IOVector vec = {const_cast<void *>(buf), size};
+    return (Queue(file, true, pos, &vec, 1, std::move(callback)));
+}
+
+uint64 AsyncFileIO::WriteV(FileStream &file, uint64 pos, const IOVector *buffers, fsize count, Callback callback)
+{
+    return (Queue(file, true, pos, buffers, count, std::move(callback)));
+}
+
+fsize AsyncFileIO::Submit()
+{
+    fsize count = 0;
+    auto it = _waiting.begin();
+
+    while (it != _waiting.end())
+    {
+        AsyncIORequest *request = *it;
+        auto key = reinterpret_cast<fsize>(request->File);
+        auto depth = _fileInflight.FindByKey(key);
+        if (depth != _fileInflight.end() && depth->Value >= _fileQueueDepth)
+        {
+            ++it;
+            continue;
+        }
+        if (!_backend->Push(request))
+            break;
+        if (depth == _fileInflight.end())
+            _fileInflight.Add(key, 1);
+        else
+            ++depth->Value;
+        ++_inflight;
+        ++count;
+        _waiting.RemoveAt(it);
+    }
+    if (count > 0)
+        _backend->Flush();
+    return (count);
+}
+
+fsize AsyncFileIO::Complete(bool wait)
+{
+    List<AsyncIORequest *> completed;
+
+    Submit();
+    _backend->Reap(completed, wait);
+    for (auto *ptr : completed)
+    {
+        UniquePtr<AsyncIORequest> request(ptr);
+        --_inflight;
+        auto key = reinterpret_cast<fsize>(request->File);
+        auto depth = _fileInflight.FindByKey(key);
+        if (--depth->Value == 0)
+            _fileInflight.RemoveAt(depth);
+        if (request->Callback)
+            request->Callback(request->Result);
+    }
+    if (completed.Size() > 0)
+        Submit();
+    return (completed.Size());
+}
+
+fsize AsyncFileIO::Poll()
+{
+    return (Complete(false));
+}
+
+fsize AsyncFileIO::Wait(fsize count)
+{
+    fsize total = 0;
+
+    while (total < count && GetPendingCount() > 0)
+        total += Complete(true);
+    return (total);
+}
+
+void AsyncFileIO::WaitAll()
+{
+    while (GetPendingCount() > 0)
+        Complete(true);
+}
@@ -0,0 +1,310 @@
+// Copyright (c) 2020, BlockProject 3D
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without modification,
+// are permitted provided that the following conditions are met:
+// 
+//     * Redistributions of source code must retain the above copyright notice,
+//       this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above copyright notice,
+//       this list of conditions and the following disclaimer in the documentation
+//       and/or other materials provided with the distribution.
+//     * Neither the name of BlockProject 3D nor the names of its contributors
+//       may be used to endorse or promote products derived from this software
+//       without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#ifdef LINUX
+    #include <cerrno>
+    #include <cstring>
+    #include <linux/io_uring.h>
+    #include <sys/mman.h>
+    #include <sys/syscall.h>
+    #include <unistd.h>
+#endif
+#include "AsyncIOBackend.hpp"
+#include "Framework/IO/IOException.hpp"
+#include "Framework/Memory/MemUtils.hpp"
+#include "Framework/System/ThreadPool.hpp"
+#include "OSPrivate.hpp"
+
+using namespace bpf::collection;
+using namespace bpf::memory;
+using namespace bpf::io;
+using namespace bpf;
+
+#ifdef LINUX
+class UringBackend final : public AsyncIOBackend
+{
+private:
+    int _ring;
+    fsize _capacity;
+    fsize _inflight;
+    unsigned _unsubmitted;
+    void *_sqRing;
+    fsize _sqRingSize;
+    void *_cqRing;
+    fsize _cqRingSize;
+    io_uring_sqe *_sqes;
+    fsize _sqesSize;
+    unsigned *_sqHead;
+    unsigned *_sqTail;
+    unsigned *_sqArray;
+    unsigned _sqMask;
+    unsigned _sqEntries;
+    unsigned *_cqHead;
+    unsigned *_cqTail;
+    io_uring_cqe *_cqes;
+    unsigned _cqMask;
+
+    int Enter(unsigned submit, unsigned wait)
+    {
+        int res = (int)syscall(__NR_io_uring_enter, _ring, submit, wait, wait > 0 ? IORING_ENTER_GETEVENTS : 0, nullptr, 0);
+        if (res >= 0)
+        {
+            _unsubmitted -= (unsigned)res;
+            return (res);
+        }
+        if (errno == EINTR || errno == EAGAIN || errno == EBUSY)
+            return (0);
+        throw IOException(String("Could not submit asynchronous requests : ") + OSPrivate::ObtainLastErrorString());
+    }
+
+public:
+    explicit UringBackend(fsize queueDepth)
+        : _ring(-1)
+        , _capacity(queueDepth)
+        , _inflight(0)
+        , _unsubmitted(0)
+        , _sqRing(MAP_FAILED)
+        , _sqRingSize(0)
+        , _cqRing(MAP_FAILED)
+        , _cqRingSize(0)
+        , _sqes(reinterpret_cast<io_uring_sqe *>(MAP_FAILED))
+        , _sqesSize(0)
+    {
+        io_uring_params params;
+        std::memset(&params, 0, sizeof(io_uring_params));
+        _ring = (int)syscall(__NR_io_uring_setup, (unsigned)queueDepth, &params);
+        if (_ring < 0)
+            return;
+        _sqRingSize = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+        _cqRingSize = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+        _sqesSize = params.sq_entries * sizeof(io_uring_sqe);
+        _sqRing = mmap(nullptr, _sqRingSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, _ring, IORING_OFF_SQ_RING);
+        _cqRing = mmap(nullptr, _cqRingSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, _ring, IORING_OFF_CQ_RING);
+        void *sqes = mmap(nullptr, _sqesSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, _ring, IORING_OFF_SQES);
+        _sqes = reinterpret_cast<io_uring_sqe *>(sqes);
+        if (_sqRing == MAP_FAILED || _cqRing == MAP_FAILED || sqes == MAP_FAILED)
+        {
+            Release();
+            return;
+        }
+        auto *sq = reinterpret_cast<uint8 *>(_sqRing);
+        auto *cq = reinterpret_cast<uint8 *>(_cqRing);
+        _sqHead = reinterpret_cast<unsigned *>(sq + params.sq_off.head);
+        _sqTail = reinterpret_cast<unsigned *>(sq + params.sq_off.tail);
+        _sqArray = reinterpret_cast<unsigned *>(sq + params.sq_off.array);
+        _sqMask = *reinterpret_cast<unsigned *>(sq + params.sq_off.ring_mask);
+        _sqEntries = params.sq_entries;
+        _cqHead = reinterpret_cast<unsigned *>(cq + params.cq_off.head);
+        _cqTail = reinterpret_cast<unsigned *>(cq + params.cq_off.tail);
+        _cqes = reinterpret_cast<io_uring_cqe *>(cq + params.cq_off.cqes);
+        _cqMask = *reinterpret_cast<unsigned *>(cq + params.cq_off.ring_mask);
+        // The completion queue must never overflow
+        if (_capacity > params.cq_entries)
+            _capacity = params.cq_entries;
+    }
+
+    ~UringBackend() final
+    {
+        Release();
+    }
+
+    void Release()
+    {
+        if (_sqRing != MAP_FAILED)
+            munmap(_sqRing, _sqRingSize);
+        if (_cqRing != MAP_FAILED)
+            munmap(_cqRing, _cqRingSize);
+        if (reinterpret_cast<void *>(_sqes) != MAP_FAILED)
+            munmap(_sqes, _sqesSize);
+        if (_ring != -1)
+            close(_ring);
+        _sqRing = MAP_FAILED;
+        _cqRing = MAP_FAILED;
+        _sqes = reinterpret_cast<io_uring_sqe *>(MAP_FAILED);
+        _ring = -1;
+    }
+
+    inline bool IsValid() const noexcept
+    {
+        return (_ring != -1);
+    }
+
+    bool IsKernelQueue() const noexcept final
+    {
+        return (true);
+    }
+
+    bool Push(AsyncIORequest *request) final
+    {
+        unsigned tail = *_sqTail;
+        if (_inflight >= _capacity || tail - __atomic_load_n(_sqHead, __ATOMIC_ACQUIRE) >= _sqEntries)
+            return (false);
+        unsigned idx = tail & _sqMask;
+        io_uring_sqe *sqe = &_sqes[idx];
+        std::memset(sqe, 0, sizeof(io_uring_sqe));
+        sqe->opcode = request->Write ? IORING_OP_WRITEV : IORING_OP_READV;
+        sqe->fd = GetHandle(*request->File);
+        sqe->off = request->Pos;
+        sqe->addr = reinterpret_cast<uintptr>(*request->Buffers);
+        sqe->len = (uint32)request->Buffers.Size();
+        sqe->user_data = reinterpret_cast<uintptr>(request);
+        _sqArray[idx] = idx;
+        __atomic_store_n(_sqTail, tail + 1, __ATOMIC_RELEASE);
+        ++_unsubmitted;
+        ++_inflight;
+        return (true);
+    }
+
+    void Flush() final
+    {
+        if (_unsubmitted > 0)
+            Enter(_unsubmitted, 0);
+    }
+
+    void Reap(List<AsyncIORequest *> &out, bool wait) final
+    {
+        while (true)
+        {
+            unsigned head = *_cqHead;
+            unsigned tail = __atomic_load_n(_cqTail, __ATOMIC_ACQUIRE);
+            fsize count = 0;
+            for (; head != tail; ++head)
+            {
+                io_uring_cqe *cqe = &_cqes[head & _cqMask];
+                auto *request = reinterpret_cast<AsyncIORequest *>(static_cast<uintptr>(cqe->user_data));
+                if (cqe->res >= 0)
+                {
+                    request->Result.Bytes = (fsize)cqe->res;
+                    request->Result.Success = true;
+                }
+                else
+                    request->Result.Error = String(std::strerror(-cqe->res));
+                out.Add(request);
+                ++count;
+            }
+            __atomic_store_n(_cqHead, head, __ATOMIC_RELEASE);
+            _inflight -= count;
+            if (count > 0 || !wait || _inflight == 0)
+                return;
+            Enter(_unsubmitted, 1);
+        }
+    }
+};
+#endif
+
+class PoolBackend final : public AsyncIOBackend
+{
+private:
+    system::ThreadPool _pool;
+    fsize _capacity;
+    fsize _inflight;
+    List<AsyncIORequest *> _completed;
+
+    static void Execute(AsyncIORequest *request)
+    {
+        try
+        {
+            if (request->Write)
+                request->Result.Bytes = request->File->WriteV(request->Pos, *request->Buffers, request->Buffers.Size());
+            else
+                request->Result.Bytes = request->File->ReadV(request->Pos, *request->Buffers, request->Buffers.Size());
+            request->Result.Success = true;
+        }
+        catch (const IOException &ex)
+        {
+            request->Result.Error = ex.Message();
+        }
+    }
+
+public:
+    PoolBackend(fsize queueDepth, fsize threads)
+        : _pool(threads, "AsyncFileIO")
+        , _capacity(queueDepth)
+        , _inflight(0)
+    {
+    }
+
+    bool IsKernelQueue() const noexcept final
+    {
+        return (false);
+    }
+
+    bool Push(AsyncIORequest *request) final
+    {
+        if (_inflight >= _capacity)
+            return (false);
+        ++_inflight;
+        // The request outlives the task: AsyncFileIO only frees it once returned by Reap
+        _pool.Run([request]() {
+            Execute(request);
+            return (Dynamic());
+        }, [this, request](Dynamic &) {
+            _completed.Add(request);
+        });
+        return (true);
+    }
+
+    void Flush() final
+    {
+    }
+
+    void Reap(List<AsyncIORequest *> &out, bool wait) final
+    {
+        while (true)
+        {
+            _pool.Poll();
+            if (_completed.Size() > 0)
+            {
+                _inflight -= _completed.Size();
+                for (auto *request : _completed)
+                    out.Add(request);
+                _completed.Clear();
+                return;
+            }
+            if (!wait || _inflight == 0)
+                return;
+            _pool.Wait();
+        }
+    }
+};
+
+AsyncIOBackend *AsyncIOBackend::Create(fsize queueDepth, fsize threads, bool kernelQueue)
+{
+#ifdef LINUX
+    if (kernelQueue)
+    {
+        auto *backend = MemUtils::New<UringBackend>(queueDepth);
+        if (backend->IsValid())
+            return (backend);
+        MemUtils::Delete(backend);
+    }
+#else
+    (void)kernelQueue;
+#endif
+    return (MemUtils::New<PoolBackend>(queueDepth, threads));
+}
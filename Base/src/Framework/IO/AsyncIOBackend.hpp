@@ -0,0 +1,103 @@
+// Copyright (c) 2020, BlockProject 3D
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without modification,
+// are permitted provided that the following conditions are met:
+// 
+//     * Redistributions of source code must retain the above copyright notice,
+//       this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above copyright notice,
+//       this list of conditions and the following disclaimer in the documentation
+//       and/or other materials provided with the distribution.
+//     * Neither the name of BlockProject 3D nor the names of its contributors
+//       may be used to endorse or promote products derived from this software
+//       without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#pragma once
+#include "Framework/Collection/Array.hpp"
+#include "Framework/Collection/List.hpp"
+#include "Framework/IO/AsyncFileIO.hpp"
+
+namespace bpf
+{
+    namespace io
+    {
+        /**
+         * Internal state of a queued asynchronous request
+         */
+        struct AsyncIORequest
+        {
+            FileStream *File;
+            bool Write;
+            uint64 Pos;
+            collection::Array<IOVector> Buffers;
+            AsyncFileIO::Callback Callback;
+            AsyncIOResult Result;
+        };
+
+        /**
+         * Executes asynchronous requests on behalf of AsyncFileIO
+         */
+        class AsyncIOBackend
+        {
+        protected:
+#ifndef WINDOWS
+            static inline int GetHandle(const FileStream &file) noexcept
+            {
+                return (file._handle);
+            }
+#endif
+
+        public:
+            virtual ~AsyncIOBackend() {}
+
+            /**
+             * Returns true if this backend executes requests in the kernel
+             */
+            virtual bool IsKernelQueue() const noexcept = 0;
+
+            /**
+             * Queues a request for the next Flush
+             * @param request the request to execute, must stay valid until returned by Reap
+             * @return false if this backend is full
+             */
+            virtual bool Push(AsyncIORequest *request) = 0;
+
+            /**
+             * Submits all requests pushed since the last call
+             * @throw IOException in case of system error
+             */
+            virtual void Flush() = 0;
+
+            /**
+             * Collects completed requests
+             * @param out list receiving completed requests
+             * @param wait true to block until at least one request completes, if any is in flight
+             * @throw IOException in case of system error
+             */
+            virtual void Reap(collection::List<AsyncIORequest *> &out, bool wait) = 0;
+
+            /**
+             * Creates the best available backend
+             * @param queueDepth the maximum number of requests in flight
+             * @param threads the number of threads of the ThreadPool backend
+             * @param kernelQueue true to try io_uring first
+             * @return new backend to be deleted with MemUtils::Delete
+             */
+            static AsyncIOBackend *Create(fsize queueDepth, fsize threads, bool kernelQueue);
+        };
+    }
+}
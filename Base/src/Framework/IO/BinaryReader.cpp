@@ -27,10 +27,26 @@
 // SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include "Framework/IO/BinaryReader.hpp"
+#include <cstring>
+#include <limits>
 
 using namespace bpf::io;
 using namespace bpf;
 
+bool BinaryReader::Refill()
+{
+    _directPos = 0;
+    _directSize = _stream.ReadDirect(_direct, std::numeric_limits<fsize>::max());
+    if (_directSize > 0)
+        return (true);
+    _buf.Clear();
+    uint8 buf[READ_BUF_SIZE];
+    fsize s = _stream.Read(buf, READ_BUF_SIZE);
+    _buf.Write(buf, s);
+    _buf.Seek(0);
+    return (s > 0);
+}
+
 uint8 BinaryReader::ReadByte()
 {
     uint8 out = 0;
@@ -40,15 +56,7 @@ uint8 BinaryReader::ReadByte()
         _stream.Read(&out, 1);
         return (out);
     }
-    if ((_buf.GetCursor() + 1) > _buf.GetWrittenBytes())
-    {
-        _buf.Clear();
-        uint8 buf[READ_BUF_SIZE];
-        fsize s = _stream.Read(buf, READ_BUF_SIZE);
-        _buf.Write(buf, s);
-        _buf.Seek(0);
-    }
-    _buf.Read(&out, 1);
+    ReadByte2(out);
     return (out);
 }
 
@@ -56,16 +64,13 @@ bool BinaryReader::ReadByte2(uint8 &out)
 {
     out = 0;
 
-    if (_buf.GetCursor() + 1 > _buf.GetWrittenBytes())
+    if (_directPos == _directSize && _buf.GetCursor() + 1 > _buf.GetWrittenBytes() && !Refill())
+        return (false);
+    if (_directPos < _directSize)
     {
-        _buf.Clear();
-        uint8 buf[READ_BUF_SIZE];
-        fsize s = _stream.Read(buf, READ_BUF_SIZE);
-        _buf.Write(buf, s);
-        _buf.Seek(0);
+        out = _direct[_directPos++];
+        return (true);
     }
-    if (_buf.GetCursor() + 1 > _buf.GetWrittenBytes())
-        return (false);
     _buf.Read(&out, 1);
     return (true);
 }
@@ -74,8 +79,16 @@ void BinaryReader::ReadSubBuf(void *out, const fsize size)
 {
     auto *res = reinterpret_cast<uint8 *>(out);
 
-    for (fsize i = 0; i != size; ++i)
-        res[i] = ReadByte();
+    if (_directSize - _directPos >= size)
+    {
+        std::memcpy(res, _direct + _directPos, size);
+        _directPos += size;
+    }
+    else
+    {
+        for (fsize i = 0; i != size; ++i)
+            res[i] = ReadByte();
+    }
     if (system::Platform::GetEndianess() != _targetorder)
         system::Platform::ReverseBuffer(res, size);
 }
@@ -119,10 +132,21 @@ fsize BinaryReader::Read(void *buf, fsize bufsize)
     {
         fsize read = 0;
         auto *data = reinterpret_cast<uint8 *>(buf);
-        for (fsize i = 0; i != bufsize; ++i)
+        while (read != bufsize)
         {
-            if (ReadByte2(data[i]))
+            if (_directPos < _directSize)
+            {
+                fsize len = _directSize - _directPos;
+                if (len > bufsize - read)
+                    len = bufsize - read;
+                std::memcpy(data + read, _direct + _directPos, len);
+                _directPos += len;
+                read += len;
+            }
+            else if (ReadByte2(data[read]))
                 ++read;
+            else
+                break;
         }
         return (read);
     }
@@ -42,6 +42,16 @@ ByteBuf::ByteBuf(const fsize size)
 {
 }
 
+ByteBuf::ByteBuf(const ByteView &view)
+    : _buf(static_cast<uint8 *>(Memory::Malloc(view.Size())))
+    , _cursor(0)
+    , _size(view.Size())
+    , _written(view.Size())
+{
+    if (_size > 0)
+        std::memcpy(_buf, *view, _size);
+}
+
 ByteBuf::ByteBuf(ByteBuf &&other) noexcept
     : _buf(other._buf)
     , _cursor(other._cursor)
@@ -138,3 +148,13 @@ fsize ByteBuf::Read(void *buf, fsize bufsize)
     _cursor += bufsize;
     return (bufsize);
 }
+
+fsize ByteBuf::ReadDirect(const uint8 *&data, fsize maxsize)
+{
+    // Readers ask for as much as possible: the sum with the cursor would overflow
+    if (maxsize > _written - _cursor)
+        maxsize = _written - _cursor;
+    data = _buf + _cursor;
+    _cursor += maxsize;
+    return (maxsize);
+}
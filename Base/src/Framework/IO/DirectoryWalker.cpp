@@ -0,0 +1,300 @@
+// Copyright (c) 2020, BlockProject 3D
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without modification,
+// are permitted provided that the following conditions are met:
+// 
+//     * Redistributions of source code must retain the above copyright notice,
+//       this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above copyright notice,
+//       this list of conditions and the following disclaimer in the documentation
+//       and/or other materials provided with the distribution.
+//     * Neither the name of BlockProject 3D nor the names of its contributors
+//       may be used to endorse or promote products derived from this software
+//       without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#ifdef WINDOWS
+    #include <Windows.h>
+#else
+    #include <cstring>
+    #include <dirent.h>
+    #include <fcntl.h>
+    #include <sys/stat.h>
+    #include <unistd.h>
+    #ifdef LINUX
+        #include <sys/syscall.h>
+    #endif
+#endif
+#include "Framework/IO/DirectoryWalker.hpp"
+#include "Framework/IO/IOException.hpp"
+#include "Framework/Memory/MemUtils.hpp"
+#include "OSPrivate.hpp"
+
+using namespace bpf::memory;
+using namespace bpf::io;
+using namespace bpf;
+
+#ifdef LINUX
+/**
+ * Size of the buffer receiving directory entries from getdents64, a few hundred entries per system call
+ */
+constexpr fsize DIRECTORY_BUF_SIZE = 32768;
+
+struct LinuxDirent64
+{
+    uint64 Ino;
+    int64 Off;
+    unsigned short Reclen;
+    unsigned char Type;
+    char Name[1];
+};
+#endif
+
+namespace bpf
+{
+    namespace io
+    {
+        struct DirectoryLevel
+        {
+            String Path;
+#ifdef WINDOWS
+            HANDLE Handle;
+            WIN32_FIND_DATAW Data;
+            bool Pending;
+#else
+            int Fd;
+    #ifdef LINUX
+            uint8 Buffer[DIRECTORY_BUF_SIZE];
+            fsize Pos;
+            fsize Len;
+    #else
+            DIR *Dir;
+    #endif
+#endif
+        };
+    }
+}
+
+#ifndef WINDOWS
+static DirectoryLevel *OpenLevel(int fd, const String &path)
+{
+    auto *level = MemUtils::New<DirectoryLevel>();
+    level->Path = path;
+    level->Fd = fd;
+    #ifdef LINUX
+    level->Pos = 0;
+    level->Len = 0;
+    #else
+    level->Dir = fdopendir(fd);
+    if (level->Dir == nullptr)
+    {
+        close(fd);
+        MemUtils::Delete(level);
+        return (nullptr);
+    }
+    #endif
+    return (level);
+}
+
+static EFileType TypeFromDirent(unsigned char type)
+{
+    switch (type)
+    {
+    case DT_REG:
+        return (EFileType::FILE);
+    case DT_DIR:
+        return (EFileType::DIRECTORY);
+    case DT_LNK:
+        return (EFileType::SYMLINK);
+    case DT_UNKNOWN:
+        return (EFileType::UNKNOWN);
+    default:
+        return (EFileType::OTHER);
+    }
+}
+
+static EFileType TypeFromStat(int dirfd, const char *name)
+{
+    struct stat st;
+
+    if (fstatat(dirfd, name, &st, AT_SYMLINK_NOFOLLOW) != 0)
+        return (EFileType::UNKNOWN);
+    if (S_ISREG(st.st_mode))
+        return (EFileType::FILE);
+    if (S_ISDIR(st.st_mode))
+        return (EFileType::DIRECTORY);
+    if (S_ISLNK(st.st_mode))
+        return (EFileType::SYMLINK);
+    return (EFileType::OTHER);
+}
+#else
+static DirectoryLevel *OpenLevel(const String &fullPath, const String &path)
+{
+    auto *level = MemUtils::New<DirectoryLevel>();
+    level->Path = path;
+    level->Pending = true;
+    level->Handle = FindFirstFileExW(reinterpret_cast<LPCWSTR>(*(fullPath + "\\*").ToUTF16()), FindExInfoBasic,
+                                     &level->Data, FindExSearchNameMatch, nullptr, FIND_FIRST_EX_LARGE_FETCH);
+    if (level->Handle == INVALID_HANDLE_VALUE)
+    {
+        MemUtils::Delete(level);
+        return (nullptr);
+    }
+    return (level);
+}
+#endif
+
+DirectoryWalker::DirectoryWalker(const File &dir, bool recursive)
+    : _root(dir)
+    , _recursive(recursive)
+    , _descend(false)
+    , _name(nullptr)
+    , _nameLen(0)
+    , _type(EFileType::UNKNOWN)
+{
+#ifdef WINDOWS
+    DirectoryLevel *level = OpenLevel(dir.PlatformPath(), "");
+#else
+    int fd = open(*dir.PlatformPath(), O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+    if (fd == -1)
+        throw IOException(String("Could not open directory '") + dir.PlatformPath() + "' : " + OSPrivate::ObtainLastErrorString());
+    DirectoryLevel *level = OpenLevel(fd, "");
+#endif
+    if (level == nullptr)
+        throw IOException(String("Could not open directory '") + dir.PlatformPath() + "' : " + OSPrivate::ObtainLastErrorString());
+    _levels.Push(level);
+}
+
+DirectoryWalker::~DirectoryWalker()
+{
+    while (_levels.Size() > 0)
+        PopLevel();
+}
+
+void DirectoryWalker::PopLevel()
+{
+    DirectoryLevel *level = _levels.Pop();
+#ifdef WINDOWS
+    FindClose(level->Handle);
+#elif defined(LINUX)
+    close(level->Fd);
+#else
+    closedir(level->Dir);
+#endif
+    MemUtils::Delete(level);
+}
+
+bool DirectoryWalker::ReadEntry(DirectoryLevel &level)
+{
+#ifdef WINDOWS
+    if (level.Pending)
+        level.Pending = false;
+    else if (!FindNextFileW(level.Handle, &level.Data))
+        return (false);
+    _nameBuf = String::FromUTF16(reinterpret_cast<const fchar16 *>(level.Data.cFileName));
+    _name = *_nameBuf;
+    _nameLen = _nameBuf.Size();
+    if (level.Data.dwFileAttributes & FILE_ATTRIBUTE_REPARSE_POINT)
+        _type = EFileType::SYMLINK;
+    else if (level.Data.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY)
+        _type = EFileType::DIRECTORY;
+    else if (level.Data.dwFileAttributes & FILE_ATTRIBUTE_DEVICE)
+        _type = EFileType::OTHER;
+    else
+        _type = EFileType::FILE;
+#elif defined(LINUX)
+    if (level.Pos >= level.Len)
+    {
+        long len = syscall(SYS_getdents64, level.Fd, level.Buffer, DIRECTORY_BUF_SIZE);
+        if (len <= 0)
+            return (false);
+        level.Len = (fsize)len;
+        level.Pos = 0;
+    }
+    auto *entry = reinterpret_cast<LinuxDirent64 *>(level.Buffer + level.Pos);
+    level.Pos += entry->Reclen;
+    _name = entry->Name;
+    _nameLen = std::strlen(entry->Name);
+    _type = TypeFromDirent(entry->Type);
+    if (_type == EFileType::UNKNOWN)
+        _type = TypeFromStat(level.Fd, _name);
+#else
+    struct dirent *entry = readdir(level.Dir);
+    if (entry == nullptr)
+        return (false);
+    _name = entry->d_name;
+    _nameLen = std::strlen(entry->d_name);
+    _type = TypeFromDirent(entry->d_type);
+    if (_type == EFileType::UNKNOWN)
+        _type = TypeFromStat(level.Fd, _name);
+#endif
+    return (true);
+}
+
+void DirectoryWalker::Descend()
+{
+    String path = GetRelativePath();
+#ifdef WINDOWS
+    DirectoryLevel *level = OpenLevel(_root.PlatformPath() + "\\" + path.Replace('/', '\\'), path);
+#else
+    int fd = openat(_levels.Top()->Fd, _name, O_RDONLY | O_DIRECTORY | O_NOFOLLOW | O_CLOEXEC);
+    if (fd == -1)
+        return;
+    DirectoryLevel *level = OpenLevel(fd, path);
+#endif
+    if (level != nullptr)
+        _levels.Push(level);
+}
+
+bool DirectoryWalker::Next()
+{
+    if (_descend)
+    {
+        _descend = false;
+        Descend();
+    }
+    while (_levels.Size() > 0)
+    {
+        if (!ReadEntry(*_levels.Top()))
+        {
+            PopLevel();
+            continue;
+        }
+        if (_name[0] == '.' && (_nameLen == 1 || (_nameLen == 2 && _name[1] == '.')))
+            continue;
+        _descend = _recursive && _type == EFileType::DIRECTORY;
+        if (_filter && !_filter(*this))
+        {
+            if (_descend)
+            {
+                _descend = false;
+                Descend();
+            }
+            continue;
+        }
+        return (true);
+    }
+    return (false);
+}
+
+String DirectoryWalker::GetRelativePath() const
+{
+    const String &path = _levels.Top()->Path;
+
+    if (path.IsEmpty())
+        return (String(_name, _nameLen));
+    return (path + '/' + String(_name, _nameLen));
+}
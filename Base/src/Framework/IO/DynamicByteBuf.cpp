@@ -26,3 +26,155 @@
 // NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
 // SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
+#include "Framework/IO/DynamicByteBuf.hpp"
+#include "Framework/Memory/Utility.hpp"
+#include <cstring>
+
+using namespace bpf::collection;
+using namespace bpf::memory;
+using namespace bpf::io;
+using namespace bpf;
+
+DynamicByteBuf::DynamicByteBuf(const fsize segmentSize, const fsize maxFree)
+    : _segmentSize(segmentSize > 0 ? segmentSize : DYNAMIC_BYTEBUF_SEGMENT_SIZE)
+    , _maxFree(maxFree)
+    , _size(0)
+{
+}
+
+void DynamicByteBuf::PopSegment()
+{
+    Segment &seg = _segments.First();
+    // Only recycle segments nobody else can observe
+    if (seg.Owned && seg.Buffer.GetUseCount() == 1 && _free.Size() < _maxFree)
+        _free.Add(std::move(seg.Buffer));
+    _segments.RemoveAt(0);
+}
+
+void DynamicByteBuf::Trim()
+{
+    while (_segments.Size() > 0 && _segments.First().Start == _segments.First().End)
+        PopSegment();
+}
+
+fsize DynamicByteBuf::Write(const void *buf, fsize bufsize)
+{
+    Trim();
+    auto *data = reinterpret_cast<const uint8 *>(buf);
+    fsize remaining = bufsize;
+    while (remaining > 0)
+    {
+        if (_segments.Size() == 0 || !_segments.Last().Owned || _segments.Last().End == _segmentSize)
+        {
+            Segment seg;
+            if (_free.Size() > 0)
+            {
+                seg.Buffer = std::move(_free.Last());
+                _free.RemoveLast();
+            }
+            else
+                seg.Buffer = MakeShared<ByteBuf>(_segmentSize);
+            seg.Start = 0;
+            seg.End = 0;
+            seg.Owned = true;
+            _segments.Add(std::move(seg));
+        }
+        Segment &tail = _segments.Last();
+        fsize len = _segmentSize - tail.End;
+        if (len > remaining)
+            len = remaining;
+        std::memcpy(**tail.Buffer + tail.End, data, len);
+        tail.End += len;
+        data += len;
+        remaining -= len;
+        _size += len;
+    }
+    return (bufsize);
+}
+
+void DynamicByteBuf::Append(const SharedPtr<ByteBuf> &buffer, const fsize pos, const fsize size)
+{
+    if (pos > buffer->Size() || size > buffer->Size() - pos)
+        throw IndexException((fint)(pos + size));
+    Trim();
+    if (size == 0)
+        return;
+    Segment seg;
+    seg.Buffer = buffer;
+    seg.Start = pos;
+    seg.End = pos + size;
+    seg.Owned = false;
+    _segments.Add(std::move(seg));
+    _size += size;
+}
+
+fsize DynamicByteBuf::Read(void *buf, fsize bufsize)
+{
+    Trim();
+    auto *out = reinterpret_cast<uint8 *>(buf);
+    fsize total = 0;
+    while (total < bufsize && _segments.Size() > 0)
+    {
+        Segment &head = _segments.First();
+        fsize len = head.End - head.Start;
+        if (len > bufsize - total)
+            len = bufsize - total;
+        std::memcpy(out + total, **head.Buffer + head.Start, len);
+        head.Start += len;
+        total += len;
+        if (head.Start == head.End)
+            PopSegment();
+    }
+    _size -= total;
+    return (total);
+}
+
+fsize DynamicByteBuf::ReadDirect(const uint8 *&data, fsize maxsize)
+{
+    Trim();
+    data = nullptr;
+    if (_segments.Size() == 0)
+        return (0);
+    // A drained head segment is only released by the next call, so that data stays valid until then
+    Segment &head = _segments.First();
+    if (maxsize > head.End - head.Start)
+        maxsize = head.End - head.Start;
+    data = **head.Buffer + head.Start;
+    head.Start += maxsize;
+    _size -= maxsize;
+    return (maxsize);
+}
+
+ByteView DynamicByteBuf::Peek() const noexcept
+{
+    for (const auto &seg : _segments)
+    {
+        if (seg.Start != seg.End)
+            return (ByteView(**seg.Buffer + seg.Start, seg.End - seg.Start));
+    }
+    return (ByteView());
+}
+
+void DynamicByteBuf::Consume(fsize size)
+{
+    Trim();
+    while (size > 0 && _segments.Size() > 0)
+    {
+        Segment &head = _segments.First();
+        fsize len = head.End - head.Start;
+        if (len > size)
+            len = size;
+        head.Start += len;
+        size -= len;
+        _size -= len;
+        if (head.Start == head.End)
+            PopSegment();
+    }
+}
+
+void DynamicByteBuf::Clear()
+{
+    while (_segments.Size() > 0)
+        PopSegment();
+    _size = 0;
+}
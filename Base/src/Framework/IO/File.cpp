@@ -32,10 +32,17 @@
     #include <Windows.h>
     #define PATH_MAX MAX_PATH
 #else
-    #include <dirent.h>
+    #include <cerrno>
     #include <cstdlib>
+    #include <dirent.h>
+    #include <fcntl.h>
     #include <sys/stat.h>
     #include <unistd.h>
+    #ifdef LINUX
+        #include <linux/fs.h>
+        #include <sys/ioctl.h>
+        #include <sys/sendfile.h>
+    #endif
 #endif
 #include "./OSPrivate.hpp"
 #include "Framework/IO/File.hpp"
@@ -149,27 +156,116 @@ File File::GetParent() const
     return (File(FullPath.Sub(0, FullPath.LastIndexOf('/'))));
 }
 
-bool File::CopyTo(const File &dst, bool overwrite) //NOLINT (False-positive / not yet implemented)
+#ifndef WINDOWS
+static bool CopyData(int in, int out, uint64 size)
+{
+    #ifdef LINUX
+    // Reflink: the copy shares the blocks of the source on copy-on-write file systems (btrfs, xfs...)
+    if (ioctl(out, FICLONE, in) == 0)
+        return (true);
+    uint64 done = 0;
+    bool kernelCopy = true;
+    while (kernelCopy && done < size)
+    {
+        ssize_t len = copy_file_range(in, nullptr, out, nullptr, (size_t)(size - done), 0);
+        if (len > 0)
+            done += (uint64)len;
+        else if (len == 0)
+            return (true);
+        else if (errno == EINTR)
+            continue;
+        else if (done == 0 && (errno == ENOSYS || errno == EXDEV || errno == EINVAL || errno == EOPNOTSUPP))
+            kernelCopy = false;
+        else
+            return (false);
+    }
+    if (kernelCopy)
+        return (true);
+    while (done < size)
+    {
+        ssize_t len = sendfile(out, in, nullptr, (size_t)(size - done));
+        if (len > 0)
+            done += (uint64)len;
+        else if (len == 0)
+            return (true);
+        else if (errno == EINTR)
+            continue;
+        else if (done == 0 && (errno == ENOSYS || errno == EINVAL))
+            break;
+        else
+            return (false);
+    }
+    if (done >= size)
+        return (true);
+    #else
+    (void)size;
+    #endif
+    uint8 buf[65536];
+    ssize_t len;
+    while ((len = read(in, buf, sizeof(buf))) != 0)
+    {
+        if (len == -1)
+        {
+            if (errno == EINTR)
+                continue;
+            return (false);
+        }
+        ssize_t written = 0;
+        while (written < len)
+        {
+            ssize_t res = write(out, buf + written, (size_t)(len - written));
+            if (res == -1)
+            {
+                if (errno == EINTR)
+                    continue;
+                return (false);
+            }
+            written += res;
+        }
+    }
+    return (true);
+}
+#endif
+
+bool File::CopyTo(const File &dst, bool overwrite)
 {
 #ifdef WINDOWS
     BOOL val = CopyFileW(reinterpret_cast<LPCWSTR>(*FullPath.ToUTF16()), reinterpret_cast<LPCWSTR>(*dst.FullPath.ToUTF16()), !overwrite);
     return (val == TRUE ? true : false);
 #else
-    return (false);
+    File out = dst.IsDirectory() ? dst + FileName : dst;
+    int in = open(*FullPath, O_RDONLY | O_CLOEXEC);
+    if (in == -1)
+        return (false);
+    struct stat st;
+    if (fstat(in, &st) != 0 || S_ISDIR(st.st_mode))
+    {
+        close(in);
+        return (false);
+    }
+    struct stat dstst;
+    if (stat(*out.FullPath, &dstst) == 0 && dstst.st_dev == st.st_dev && dstst.st_ino == st.st_ino)
+    {
+        close(in);
+        return (false);
+    }
+    int flags = O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC;
+    if (!overwrite)
+        flags |= O_EXCL;
+    int fd = open(*out.FullPath, flags, st.st_mode & 0777);
+    if (fd == -1)
+    {
+        close(in);
+        return (false);
+    }
+    bool res = CopyData(in, fd, (uint64)st.st_size);
+    close(in);
+    if (close(fd) != 0)
+        res = false;
+    if (!res)
+        unlink(*out.FullPath);
+    return (res);
 #endif
-    //TODO : Implement
-    //File out = dst;
-    /*IFileStream *src = Open(FILEMODE_READ);
-
-    if (dst.IsDirectory())
-        out = FFile(bpf::String(dst.GetPath()) + bpf::String("/") + GetFileName());
-    IFileStream *dest = out.Open(FILEMODE_WRITE);
-    uint8 buf[4096];
-    uint32 len;
-    while ((len = src->Read(buf, 4096)) > 0)
-        dest->Write(buf, len);
-    Close();
-    out.Close();*/
 }
 
 bool File::MoveTo(const File &dst)
@@ -327,8 +423,8 @@ List<File> File::ListFiles() const
             if (name != '.' && name != "..")
                 flns.Add(File(FullPath + '/' + name));
         }
+        closedir(d);
     }
-    closedir(d);
 #endif
     return (flns);
 }
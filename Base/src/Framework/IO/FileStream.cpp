@@ -30,6 +30,7 @@
     #include <Windows.h>
 #else
     #include <fcntl.h>
+    #include <sys/uio.h>
     #include <unistd.h>
 #endif
 #include "Framework/IO/FileStream.hpp"
@@ -39,6 +40,10 @@
 using namespace bpf::io;
 using namespace bpf;
 
+#ifndef WINDOWS
+static_assert(sizeof(IOVector) == sizeof(struct iovec), "IOVector must match the layout of struct iovec");
+#endif
+
 FileStream::FileStream(const File &file, fint mode)
     : _mode(mode)
 {
@@ -211,3 +216,97 @@ fsize FileStream::Write(const void *buf, fsize bufsize)
     return (len);
 #endif
 }
+
+fsize FileStream::ReadAt(uint64 pos, void *buf, fsize bufsize)
+{
+    if (!(_mode & FILE_MODE_READ))
+        throw IOException("File has not been oppened with read mode");
+#ifdef WINDOWS
+    DWORD readsize;
+    OVERLAPPED ov;
+    ZeroMemory(&ov, sizeof(OVERLAPPED));
+    ov.Offset = (DWORD)(pos & 0xFFFFFFFF);
+    ov.OffsetHigh = (DWORD)(pos >> 32);
+    if (ReadFile(_handle, buf, (DWORD)bufsize, &readsize, &ov) == FALSE)
+    {
+        if (GetLastError() == ERROR_HANDLE_EOF)
+            return (0);
+        throw IOException(String("Error reading file : ") + OSPrivate::ObtainLastErrorString());
+    }
+    return (readsize);
+#else
+    fsize len = pread(_handle, buf, bufsize, (off_t)pos);
+    if (len == (fsize)-1)
+        throw IOException(String("Error reading file : ") + OSPrivate::ObtainLastErrorString());
+    return (len);
+#endif
+}
+
+fsize FileStream::WriteAt(uint64 pos, const void *buf, fsize bufsize)
+{
+    if (!(_mode & FILE_MODE_WRITE))
+        throw IOException("File has not been oppened with write mode");
+    if (_mode & FILE_MODE_APPEND)
+        throw IOException("Cannot write at a position in append mode");
+#ifdef WINDOWS
+    DWORD writesize;
+    OVERLAPPED ov;
+    ZeroMemory(&ov, sizeof(OVERLAPPED));
+    ov.Offset = (DWORD)(pos & 0xFFFFFFFF);
+    ov.OffsetHigh = (DWORD)(pos >> 32);
+    if (WriteFile(_handle, buf, (DWORD)bufsize, &writesize, &ov) == FALSE)
+        throw IOException(String("Error writing file : ") + OSPrivate::ObtainLastErrorString());
+    return (writesize);
+#else
+    fsize len = pwrite(_handle, buf, bufsize, (off_t)pos);
+    if (len == (fsize)-1)
+        throw IOException(String("Error writing file : ") + OSPrivate::ObtainLastErrorString());
+    return (len);
+#endif
+}
+
+fsize FileStream::ReadV(uint64 pos, const IOVector *buffers, fsize count)
+{
+#ifdef WINDOWS
+    fsize total = 0;
+    for (fsize i = 0; i != count; ++i)
+    {
+        fsize len = ReadAt(pos + total, buffers[i].Data, buffers[i].Size);
+        total += len;
+        if (len < buffers[i].Size)
+            break;
+    }
+    return (total);
+#else
+    if (!(_mode & FILE_MODE_READ))
+        throw IOException("File has not been oppened with read mode");
+    fsize len = preadv(_handle, reinterpret_cast<const struct iovec *>(buffers), (int)count, (off_t)pos);
+    if (len == (fsize)-1)
+        throw IOException(String("Error reading file : ") + OSPrivate::ObtainLastErrorString());
+    return (len);
+#endif
+}
+
+fsize FileStream::WriteV(uint64 pos, const IOVector *buffers, fsize count)
+{
+#ifdef WINDOWS
+    fsize total = 0;
+    for (fsize i = 0; i != count; ++i)
+    {
+        fsize len = WriteAt(pos + total, buffers[i].Data, buffers[i].Size);
+        total += len;
+        if (len < buffers[i].Size)
+            break;
+    }
+    return (total);
+#else
+    if (!(_mode & FILE_MODE_WRITE))
+        throw IOException("File has not been oppened with write mode");
+    if (_mode & FILE_MODE_APPEND)
+        throw IOException("Cannot write at a position in append mode");
+    fsize len = pwritev(_handle, reinterpret_cast<const struct iovec *>(buffers), (int)count, (off_t)pos);
+    if (len == (fsize)-1)
+        throw IOException(String("Error writing file : ") + OSPrivate::ObtainLastErrorString());
+    return (len);
+#endif
+}
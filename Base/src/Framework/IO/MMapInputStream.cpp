@@ -0,0 +1,101 @@
+// Copyright (c) 2020, BlockProject 3D
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without modification,
+// are permitted provided that the following conditions are met:
+// 
+//     * Redistributions of source code must retain the above copyright notice,
+//       this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above copyright notice,
+//       this list of conditions and the following disclaimer in the documentation
+//       and/or other materials provided with the distribution.
+//     * Neither the name of BlockProject 3D nor the names of its contributors
+//       may be used to endorse or promote products derived from this software
+//       without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include "Framework/IO/MMapInputStream.hpp"
+#include <cstring>
+
+using namespace bpf::io;
+using namespace bpf;
+
+MMapInputStream::MMapInputStream(const File &file, EMapAdvice advice, fsize windowSize)
+    : _mapper(file, FILE_MODE_READ)
+    , _advice(advice)
+    , _fileSize(file.GetSizeBytes())
+    , _pos(0)
+    , _windowPos(0)
+    , _windowSize(0)
+    , _windowCapacity(windowSize > 0 ? windowSize : MMAP_WINDOW_SIZE)
+    , _data(nullptr)
+{
+}
+
+bool MMapInputStream::UpdateWindow()
+{
+    if (_pos >= _windowPos && _pos < _windowPos + _windowSize)
+        return (true);
+    if (_pos >= _fileSize)
+        return (false);
+    fsize size = _windowCapacity;
+    if (_fileSize - _pos < size)
+        size = (fsize)(_fileSize - _pos);
+    _windowSize = 0;
+    _mapper.Map(_pos, size);
+    _windowPos = _pos;
+    _windowSize = size;
+    _data = reinterpret_cast<const uint8 *>(*_mapper);
+    _mapper.Advise(_advice);
+    if (_advice == EMapAdvice::SEQUENTIAL)
+        _mapper.Advise(EMapAdvice::WILL_NEED);
+    return (true);
+}
+
+void MMapInputStream::Seek(uint64 pos)
+{
+    _pos = pos;
+}
+
+fsize MMapInputStream::ReadDirect(const uint8 *&data, fsize maxsize)
+{
+    data = nullptr;
+    if (maxsize == 0 || !UpdateWindow())
+        return (0);
+    fsize offset = (fsize)(_pos - _windowPos);
+    fsize len = _windowSize - offset;
+    if (len > maxsize)
+        len = maxsize;
+    data = _data + offset;
+    _pos += len;
+    return (len);
+}
+
+fsize MMapInputStream::Read(void *buf, fsize bufsize)
+{
+    auto *out = reinterpret_cast<uint8 *>(buf);
+    fsize read = 0;
+
+    while (read != bufsize)
+    {
+        const uint8 *data;
+        fsize len = ReadDirect(data, bufsize - read);
+        if (len == 0)
+            break;
+        std::memcpy(out + read, data, len);
+        read += len;
+    }
+    return (read);
+}
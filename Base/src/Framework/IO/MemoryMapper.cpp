@@ -197,7 +197,7 @@ void MemoryMapper::Map(uint64 pos, fsize size)
     up._data = nearestpsize;
     offsetLow = up._parts[0];
     offsetHeigh = up._parts[1];
-    _mem = MapViewOfFile(_mapper, md, offsetHeigh, offsetLow, size);
+    _mem = MapViewOfFile(_mapper, md, offsetHeigh, offsetLow, (SIZE_T)(size + (pos - nearestpsize)));
     if (_mem == nullptr)
         throw IOException(String("Could not map file '") + _file.PlatformPath() + "' : " + OSPrivate::ObtainLastErrorString());
     uint8 *addr = reinterpret_cast<uint8 *>(_mem);
@@ -214,16 +214,46 @@ void MemoryMapper::Map(uint64 pos, fsize size)
         md |= PROT_WRITE;
     if (_mode & FILE_MODE_READ)
         md |= PROT_READ;
-    _mem = mmap(nullptr, size, md, MAP_SHARED, _handle, nearestpsize);
-    _size = size;
+    _size = (fsize)(size + (pos - nearestpsize));
+    _mem = mmap(nullptr, _size, md, MAP_SHARED, _handle, nearestpsize);
     if (_mem == MAP_FAILED)
+    {
+        _mem = nullptr;
         throw IOException(String("Could not map file '") + _file.PlatformPath() + "' : " + OSPrivate::ObtainLastErrorString());
+    }
     auto *addr = reinterpret_cast<uint8 *>(_mem);
     addr += pos - nearestpsize;
     _memoff = addr;
 #endif
 }
 
+void MemoryMapper::Advise(EMapAdvice advice)
+{
+#ifndef WINDOWS
+    if (_mem == nullptr)
+        return;
+    int md = MADV_NORMAL;
+    switch (advice)
+    {
+    case EMapAdvice::NORMAL:
+        md = MADV_NORMAL;
+        break;
+    case EMapAdvice::SEQUENTIAL:
+        md = MADV_SEQUENTIAL;
+        break;
+    case EMapAdvice::RANDOM:
+        md = MADV_RANDOM;
+        break;
+    case EMapAdvice::WILL_NEED:
+        md = MADV_WILLNEED;
+        break;
+    }
+    madvise(_mem, _size, md);
+#else
+    (void)advice;
+#endif
+}
+
 void MemoryMapper::Unmap()
 {
 #ifdef WINDOWS
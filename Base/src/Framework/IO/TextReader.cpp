@@ -28,10 +28,26 @@
 
 #include "Framework/IO/TextReader.hpp"
 #include "Framework/Scalar.hpp"
+#include <cstring>
+#include <limits>
 
 using namespace bpf::io;
 using namespace bpf;
 
+bool TextReader::Refill()
+{
+    _directPos = 0;
+    _directSize = _stream.ReadDirect(_direct, std::numeric_limits<fsize>::max());
+    if (_directSize > 0)
+        return (true);
+    _buf.Clear();
+    uint8 buf[READ_BUF_SIZE];
+    fsize s = _stream.Read(buf, READ_BUF_SIZE);
+    _buf.Write(buf, s);
+    _buf.Seek(0);
+    return (s > 0);
+}
+
 bool TextReader::ReadByte2(uint8 &out)
 {
     out = 0;
@@ -40,16 +56,13 @@ bool TextReader::ReadByte2(uint8 &out)
     {
         return (_stream.Read(&out, 1) == 1);
     }
-    if (_buf.GetCursor() + 1 > _buf.GetWrittenBytes())
+    if (_directPos == _directSize && _buf.GetCursor() + 1 > _buf.GetWrittenBytes() && !Refill())
+        return (false);
+    if (_directPos < _directSize)
     {
-        _buf.Clear();
-        uint8 buf[READ_BUF_SIZE];
-        fsize s = _stream.Read(buf, READ_BUF_SIZE);
-        _buf.Write(buf, s);
-        _buf.Seek(0);
+        out = _direct[_directPos++];
+        return (true);
     }
-    if (_buf.GetCursor() + 1 > _buf.GetWrittenBytes())
-        return (false);
     _buf.Read(&out, 1);
     return (true);
 }
@@ -164,10 +177,21 @@ fsize TextReader::Read(void *buf, fsize bufsize)
     {
         fsize read = 0;
         auto *data = reinterpret_cast<uint8 *>(buf);
-        for (fsize i = 0; i != bufsize; ++i)
+        while (read != bufsize)
         {
-            if (ReadByte2(data[i]))
+            if (_directPos < _directSize)
+            {
+                fsize len = _directSize - _directPos;
+                if (len > bufsize - read)
+                    len = bufsize - read;
+                std::memcpy(data + read, _direct + _directPos, len);
+                _directPos += len;
+                read += len;
+            }
+            else if (ReadByte2(data[read]))
                 ++read;
+            else
+                break;
         }
         return (read);
     }
@@ -28,7 +28,7 @@
 
 #include "Framework/Json/Parser.hpp"
 #include "Framework/Json/JsonParseException.hpp"
-#include "Framework/Scalar.hpp"
+#include "Framework/NumberConvert.hpp"
 
 using namespace bpf::json;
 using namespace bpf;
@@ -124,11 +124,15 @@ bool Parser::CheckNumber(Json &j)
 {
     if (_tokens.Top().Type != Lexer::ETokenType::NUMBER)
         return (false);
+    const String &data = _tokens.Top().Data;
     int64 i;
-    if (!Int64::TryParse(_tokens.Top().Data, i))
-        j = Double::Parse(_tokens.Top().Data);
-    else
+    double d;
+    if (NumberConvert::Parse(*data, data.Size(), i) == NumberConvert::EParseResult::SUCCESS)
         j = i;
+    else if (NumberConvert::Parse(*data, data.Size(), d) == NumberConvert::EParseResult::SUCCESS)
+        j = d;
+    else
+        throw JsonParseException(_tokens.Top().Line, String("Invalid number '") + data + "'");
     _line = _tokens.Pop().Line;
     return (true);
 }
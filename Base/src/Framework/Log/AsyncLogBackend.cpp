@@ -0,0 +1,308 @@
+// Copyright (c) 2020, BlockProject 3D
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without modification,
+// are permitted provided that the following conditions are met:
+// 
+//     * Redistributions of source code must retain the above copyright notice,
+//       this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above copyright notice,
+//       this list of conditions and the following disclaimer in the documentation
+//       and/or other materials provided with the distribution.
+//     * Neither the name of BlockProject 3D nor the names of its contributors
+//       may be used to endorse or promote products derived from this software
+//       without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include "Framework/Log/AsyncLogBackend.hpp"
+#include "Framework/Memory/MemUtils.hpp"
+#include "Framework/System/ScopeLock.hpp"
+#include "Framework/System/Thread.hpp"
+#include "Framework/System/Timer.hpp"
+
+using namespace bpf::collection;
+using namespace bpf::memory;
+using namespace bpf::system;
+using namespace bpf::log;
+using namespace bpf;
+
+class AsyncLogWorker final : public Thread
+{
+private:
+    AsyncLogBackend &_backend;
+    fsize _reportedDrops;
+
+    void Dispatch(const String &category, const LogRecord &record)
+    {
+        for (auto &ptr : _backend._handlers)
+        {
+            try
+            {
+                ptr->Log(category, record);
+            }
+            catch (const Exception &ex)
+            {
+                ex.Print();
+            }
+        }
+    }
+
+    void FlushHandlers()
+    {
+        for (auto &ptr : _backend._handlers)
+        {
+            try
+            {
+                ptr->Flush();
+            }
+            catch (const Exception &ex)
+            {
+                ex.Print();
+            }
+        }
+    }
+
+    void ReportDrops()
+    {
+        auto dropped = _backend._dropped.load(std::memory_order_relaxed);
+        if (dropped == _reportedDrops)
+            return;
+        Dispatch("AsyncLog", LogRecord(ELogLevel::WARNING, String::ValueOf(dropped - _reportedDrops)
+                                                                + " log message(s) dropped: queue is full"));
+        _reportedDrops = dropped;
+    }
+
+public:
+    explicit AsyncLogWorker(AsyncLogBackend &backend)
+        : Thread("AsyncLog")
+        , _backend(backend)
+        , _reportedDrops(0)
+    {
+    }
+
+    void Run() final
+    {
+        AsyncLogBackend::Record rec;
+        Timer timer;
+        double elapsed = 0;
+        bool dirty = false;
+
+        while (true)
+        {
+            fsize count = 0;
+            {
+                ScopeLock lock(_backend._handlersLock);
+                while (count < _backend._mask + 1 && _backend.TryPop(rec))
+                {
+                    Dispatch(rec.Category, rec.Data);
+                    ++count;
+                }
+                if (_backend._policy == EOverflowPolicy::COUNT_DROPS)
+                    ReportDrops();
+                elapsed += timer.Reset();
+                dirty |= count > 0;
+                bool flushRequested = _backend._flushRequest.exchange(false)
+                    || _backend._exit.load(std::memory_order_acquire);
+                if (dirty && (flushRequested || elapsed * 1000.0 >= _backend._flushInterval))
+                {
+                    FlushHandlers();
+                    dirty = false;
+                    elapsed = 0;
+                }
+                if (!dirty)
+                    _backend._flushedPos.store(_backend._dequeuePos, std::memory_order_release);
+            }
+            // Free slots and flush progress are what blocked producers and Flush callers wait for
+            _backend.WakeWaiters();
+            if (count == 0)
+            {
+                if (_backend._exit.load(std::memory_order_acquire) && !dirty)
+                    break;
+                auto waited = static_cast<uint32>(elapsed * 1000.0);
+                if (!dirty)
+                    Park(0);
+                else
+                    Park(waited < _backend._flushInterval ? _backend._flushInterval - waited : 1);
+            }
+        }
+    }
+
+    // Blocks until a message is submitted, a flush is requested or timeout milliseconds elapsed (0 means forever)
+    void Park(const uint32 timeout)
+    {
+        ScopeLock lock(_backend._signalLock);
+        _backend._parked.store(true, std::memory_order_relaxed);
+        // Pairs with the fence in WakeWorker: either the producer sees the worker parked or the worker sees the message
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (!_backend.HasPending() && !_backend._flushRequest.load() && !_backend._exit.load())
+        {
+            if (timeout == 0)
+                _backend._workAvailable.Wait(_backend._signalLock);
+            else
+                _backend._workAvailable.Wait(_backend._signalLock, timeout);
+        }
+        _backend._parked.store(false, std::memory_order_relaxed);
+    }
+};
+
+AsyncLogBackend::AsyncLogBackend(const fsize capacity, const EOverflowPolicy policy, const uint32 flushInterval)
+    : _cells(nullptr)
+    , _mask(1)
+    , _enqueuePos(0)
+    , _dequeuePos(0)
+    , _flushedPos(0)
+    , _dropped(0)
+    , _flushRequest(false)
+    , _exit(false)
+    , _policy(policy)
+    , _flushInterval(flushInterval)
+    , _worker(nullptr)
+    , _parked(false)
+    , _waiters(0)
+{
+    while (_mask < capacity)
+        _mask <<= 1;
+    _cells = MemUtils::NewArray<Cell>(_mask);
+    for (fsize i = 0; i != _mask; ++i)
+        _cells[i].Sequence.store(i, std::memory_order_relaxed);
+    --_mask;
+    _worker = MemUtils::New<AsyncLogWorker>(*this);
+    _worker->Start();
+}
+
+AsyncLogBackend::~AsyncLogBackend()
+{
+    _exit.store(true, std::memory_order_release);
+    _flushRequest.store(true);
+    WakeWorker();
+    _worker->Join();
+    MemUtils::Delete(_worker);
+    MemUtils::DeleteArray(_cells, _mask + 1);
+}
+
+void AsyncLogBackend::AddHandler(UniquePtr<ILogAdapter> &&ptr)
+{
+    ScopeLock lock(_handlersLock);
+    _handlers.Add(std::move(ptr));
+}
+
+bool AsyncLogBackend::TryPush(const String &category, const LogRecord &record)
+{
+    auto pos = _enqueuePos.load(std::memory_order_relaxed);
+    Cell *cell;
+
+    while (true)
+    {
+        cell = &_cells[pos & _mask];
+        auto seq = cell->Sequence.load(std::memory_order_acquire);
+        auto diff = static_cast<int64>(seq) - static_cast<int64>(pos);
+        if (diff == 0)
+        {
+            if (_enqueuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                break;
+        }
+        else if (diff < 0)
+            return (false);
+        else
+            pos = _enqueuePos.load(std::memory_order_relaxed);
+    }
+    cell->Data.Category = category;
+    cell->Data.Data = record;
+    cell->Sequence.store(pos + 1, std::memory_order_release);
+    return (true);
+}
+
+bool AsyncLogBackend::TryPop(Record &rec)
+{
+    Cell &cell = _cells[_dequeuePos & _mask];
+
+    if (cell.Sequence.load(std::memory_order_acquire) != _dequeuePos + 1)
+        return (false);
+    rec.Category = std::move(cell.Data.Category);
+    rec.Data = std::move(cell.Data.Data);
+    cell.Sequence.store(_dequeuePos + _mask + 1, std::memory_order_release);
+    ++_dequeuePos;
+    return (true);
+}
+
+bool AsyncLogBackend::Submit(const ELogLevel level, const String &category, const String &msg)
+{
+    return (Submit(category, LogRecord(level, msg)));
+}
+
+bool AsyncLogBackend::HasPending() const noexcept
+{
+    return (_cells[_dequeuePos & _mask].Sequence.load(std::memory_order_acquire) == _dequeuePos + 1);
+}
+
+void AsyncLogBackend::WakeWorker()
+{
+    // The worker only needs a signal when it is parked, that is when the queue was empty
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (_parked.load(std::memory_order_relaxed))
+    {
+        ScopeLock lock(_signalLock);
+        _workAvailable.Signal();
+    }
+}
+
+void AsyncLogBackend::WakeWaiters()
+{
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (_waiters.load(std::memory_order_relaxed) > 0)
+    {
+        ScopeLock lock(_signalLock);
+        _progress.Broadcast();
+    }
+}
+
+bool AsyncLogBackend::Submit(const String &category, const LogRecord &record)
+{
+    if (!TryPush(category, record))
+    {
+        if (_policy != EOverflowPolicy::BLOCK)
+        {
+            _dropped.fetch_add(1, std::memory_order_relaxed);
+            return (false);
+        }
+        ScopeLock lock(_signalLock);
+        _waiters.fetch_add(1);
+        // Pairs with the fence in WakeWaiters: either the worker sees this waiter or this retry sees the free slot
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        while (!TryPush(category, record))
+            _progress.Wait(_signalLock);
+        _waiters.fetch_sub(1);
+    }
+    WakeWorker();
+    return (true);
+}
+
+void AsyncLogBackend::Flush()
+{
+    auto target = _enqueuePos.load(std::memory_order_acquire);
+
+    ScopeLock lock(_signalLock);
+    _waiters.fetch_add(1);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    // The request is renewed on every wake up as the worker may consume it before all messages up to target are
+    // published
+    while (_flushedPos.load(std::memory_order_acquire) < target)
+    {
+        _flushRequest.store(true);
+        _workAvailable.Signal();
+        _progress.Wait(_signalLock);
+    }
+    _waiters.fetch_sub(1);
+}
@@ -0,0 +1,162 @@
+// Copyright (c) 2020, BlockProject 3D
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without modification,
+// are permitted provided that the following conditions are met:
+// 
+//     * Redistributions of source code must retain the above copyright notice,
+//       this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above copyright notice,
+//       this list of conditions and the following disclaimer in the documentation
+//       and/or other materials provided with the distribution.
+//     * Neither the name of BlockProject 3D nor the names of its contributors
+//       may be used to endorse or promote products derived from this software
+//       without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include "Framework/Log/BinaryFileLogger.hpp"
+#include "Framework/IO/IOException.hpp"
+
+using namespace bpf::log;
+using namespace bpf::io;
+using namespace bpf;
+
+BinaryFileLogger::BinaryFileLogger(const File &file, const fsize bufSize)
+    : _stream(file, FILE_MODE_WRITE | FILE_MODE_TRUNCATE)
+    , _buf(bufSize)
+{
+    AppendValue(BINARY_LOG_MAGIC);
+    AppendValue(BINARY_LOG_VERSION);
+}
+
+BinaryFileLogger::~BinaryFileLogger()
+{
+    try
+    {
+        Flush();
+    }
+    catch (const IOException &e)
+    {
+        e.Print();
+    }
+}
+
+void BinaryFileLogger::Append(const void *data, const fsize size)
+{
+    if (_buf.GetWrittenBytes() + size > _buf.Size())
+    {
+        Flush();
+        if (size > _buf.Size())
+        {
+            _stream.Write(data, size);
+            return;
+        }
+    }
+    _buf.Write(data, size);
+}
+
+void BinaryFileLogger::AppendString(const char *str, const fsize len)
+{
+    AppendValue((uint32)len);
+    Append(str, len);
+}
+
+uint32 BinaryFileLogger::GetCategoryId(const String &category)
+{
+    auto it = _categories.FindByKey(category);
+
+    if (it != _categories.end())
+        return (it->Value);
+    auto id = (uint32)_categories.Size();
+    _categories.Add(category, id);
+    AppendValue(BINARY_LOG_CATEGORY);
+    AppendValue(id);
+    AppendString(*category, category.Size());
+    return (id);
+}
+
+uint32 BinaryFileLogger::GetFormatId(const char *format)
+{
+    auto key = reinterpret_cast<fsize>(format);
+    auto it = _formats.FindByKey(key);
+
+    if (it != _formats.end())
+        return (it->Value);
+    auto id = (uint32)_formats.Size();
+    _formats.Add(key, id);
+    AppendValue(BINARY_LOG_FORMAT);
+    AppendValue(id);
+    AppendString(format, std::strlen(format));
+    return (id);
+}
+
+void BinaryFileLogger::LogMessage(ELogLevel level, const String &category, const String &msg)
+{
+    Log(category, LogRecord(level, msg));
+}
+
+void BinaryFileLogger::Log(const String &category, const LogRecord &record)
+{
+    auto categoryId = GetCategoryId(category);
+    auto formatId = record.GetFormat() == nullptr ? BINARY_LOG_NO_FORMAT : GetFormatId(record.GetFormat());
+
+    AppendValue(BINARY_LOG_RECORD);
+    AppendValue((uint8)record.GetLevel());
+    AppendValue(record.GetTime());
+    AppendValue(categoryId);
+    AppendValue(formatId);
+    if (formatId == BINARY_LOG_NO_FORMAT)
+    {
+        AppendString(*record.GetText(), record.GetText().Size());
+        return;
+    }
+    AppendValue((uint32)record.GetArgumentCount());
+    fsize cursor = 0;
+    LogRecord::Argument arg;
+    while (record.NextArgument(cursor, arg))
+    {
+        AppendValue((uint8)arg.Type);
+        switch (arg.Type)
+        {
+        case LogRecord::ARG_INT:
+            AppendValue(arg.Int);
+            break;
+        case LogRecord::ARG_UINT:
+            AppendValue(arg.UInt);
+            break;
+        case LogRecord::ARG_FLOAT:
+            AppendValue(arg.Float);
+            break;
+        case LogRecord::ARG_DOUBLE:
+            AppendValue(arg.Double);
+            break;
+        case LogRecord::ARG_BOOL:
+            AppendValue((uint8)arg.Bool);
+            break;
+        case LogRecord::ARG_STRING:
+            AppendString(arg.Str, arg.StrLen);
+            break;
+        }
+    }
+}
+
+void BinaryFileLogger::Flush()
+{
+    // Inverse logic to avoid re-throwing the same exception
+    auto size = _buf.GetWrittenBytes();
+    _buf.Reset();
+    if (size > 0)
+        _stream.Write(*_buf, size);
+}
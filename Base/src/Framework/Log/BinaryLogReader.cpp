@@ -0,0 +1,171 @@
+// Copyright (c) 2020, BlockProject 3D
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without modification,
+// are permitted provided that the following conditions are met:
+// 
+//     * Redistributions of source code must retain the above copyright notice,
+//       this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above copyright notice,
+//       this list of conditions and the following disclaimer in the documentation
+//       and/or other materials provided with the distribution.
+//     * Neither the name of BlockProject 3D nor the names of its contributors
+//       may be used to endorse or promote products derived from this software
+//       without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include "Framework/Log/BinaryLogReader.hpp"
+#include "Framework/IO/IOException.hpp"
+#include "Framework/Log/BinaryFileLogger.hpp"
+
+using namespace bpf::log;
+using namespace bpf::io;
+using namespace bpf;
+
+BinaryLogReader::BinaryLogReader(IInputStream &stream)
+    : _reader(stream)
+{
+    uint32 magic = 0;
+    uint8 version = 0;
+
+    _reader >> magic;
+    _reader >> version;
+    if (magic != BINARY_LOG_MAGIC)
+        throw IOException("Not a binary log file");
+    if (version != BINARY_LOG_VERSION)
+        throw IOException(String("Unsupported binary log version ") + String::ValueOf(version));
+}
+
+bool BinaryLogReader::ReadString(String &str)
+{
+    uint32 len = 0;
+    char buf[1024];
+
+    _reader >> len;
+    // The length comes from the file: read in bounded chunks so that a corrupted length only fails on end of stream
+    str = "";
+    while (len > 0)
+    {
+        fsize chunk = len > sizeof(buf) ? sizeof(buf) : static_cast<fsize>(len);
+        if (_reader.Read(buf, chunk) != chunk)
+            return (false);
+        str += String(buf, chunk);
+        len -= static_cast<uint32>(chunk);
+    }
+    return (true);
+}
+
+bool BinaryLogReader::ReadNext(String &category, LogRecord &record)
+{
+    uint8 type;
+
+    while (_reader.Read(&type, 1) == 1)
+    {
+        uint32 id = 0;
+        String str;
+        switch (type)
+        {
+        case BINARY_LOG_FORMAT:
+            _reader >> id;
+            if (id != _formats.Size() || !ReadString(str))
+                throw IOException("Corrupted binary log file");
+            _formats.Add(std::move(str));
+            break;
+        case BINARY_LOG_CATEGORY:
+            _reader >> id;
+            if (id != _categories.Size() || !ReadString(str))
+                throw IOException("Corrupted binary log file");
+            _categories.Add(std::move(str));
+            break;
+        case BINARY_LOG_RECORD:
+        {
+            uint8 level = 0;
+            int64 time = 0;
+            uint32 categoryId = 0;
+            uint32 formatId = 0;
+            _reader >> level >> time >> categoryId >> formatId;
+            if (categoryId >= _categories.Size() || (formatId != BINARY_LOG_NO_FORMAT && formatId >= _formats.Size()))
+                throw IOException("Corrupted binary log file");
+            category = _categories[categoryId];
+            if (formatId == BINARY_LOG_NO_FORMAT)
+            {
+                if (!ReadString(str))
+                    throw IOException("Corrupted binary log file");
+                record = LogRecord((ELogLevel)level, str);
+                record.SetTime(time);
+                return (true);
+            }
+            record = LogRecord((ELogLevel)level, *_formats[formatId]);
+            record.SetTime(time);
+            uint32 argc = 0;
+            _reader >> argc;
+            for (uint32 i = 0; i != argc; ++i)
+            {
+                uint8 argType = 0;
+                _reader >> argType;
+                switch (argType)
+                {
+                case LogRecord::ARG_INT:
+                {
+                    int64 v = 0;
+                    _reader >> v;
+                    record.Push(v);
+                    break;
+                }
+                case LogRecord::ARG_UINT:
+                {
+                    uint64 v = 0;
+                    _reader >> v;
+                    record.Push(v);
+                    break;
+                }
+                case LogRecord::ARG_FLOAT:
+                {
+                    float v = 0;
+                    _reader >> v;
+                    record.Push(v);
+                    break;
+                }
+                case LogRecord::ARG_DOUBLE:
+                {
+                    double v = 0;
+                    _reader >> v;
+                    record.Push(v);
+                    break;
+                }
+                case LogRecord::ARG_BOOL:
+                {
+                    uint8 v = 0;
+                    _reader >> v;
+                    record.Push(v != 0);
+                    break;
+                }
+                case LogRecord::ARG_STRING:
+                    if (!ReadString(str))
+                        throw IOException("Corrupted binary log file");
+                    record.Push(str);
+                    break;
+                default:
+                    throw IOException("Corrupted binary log file");
+                }
+            }
+            return (true);
+        }
+        default:
+            throw IOException("Corrupted binary log file");
+        }
+    }
+    return (false);
+}
@@ -26,39 +26,76 @@
 // NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
 // SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
+#include <cstring>
 #include "Framework/Log/FileLogger.hpp"
-#include "Framework/System/DateTime.hpp"
+#include "Framework/IO/IOException.hpp"
 #include "Framework/System/Stringifier.DateTime.hpp"
 
 using namespace bpf::log;
 using namespace bpf::io;
 using namespace bpf;
 
-FileLogger::FileLogger(const File &file)
+FileLogger::FileLogger(const File &file, const fsize bufSize)
     : _stream(file, FILE_MODE_WRITE | FILE_MODE_APPEND)
-    , _writer(_stream)
+    , _buf(bufSize)
 {
 }
 
+FileLogger::~FileLogger()
+{
+    try
+    {
+        Flush();
+    }
+    catch (const IOException &e)
+    {
+        e.Print();
+    }
+}
+
+void FileLogger::Append(const void *data, const fsize size)
+{
+    if (_buf.GetWrittenBytes() + size > _buf.Size())
+    {
+        Flush();
+        if (size > _buf.Size())
+        {
+            _stream.Write(data, size);
+            return;
+        }
+    }
+    _buf.Write(data, size);
+}
+
 void FileLogger::LogMessage(ELogLevel level, const String &category, const String &msg)
 {
-    String lvl = "";
+    static const char *levels[] = {"ERROR", "WARNING", "INFO", "DEBUG"};
+#ifdef WINDOWS
+    static const char *newLine = "\r\n";
+#else
+    static const char *newLine = "\n";
+#endif
+    auto now = system::DateTime::Now();
 
-    switch (level)
+    if (_lastTimeStr.IsEmpty() || !(now == _lastTime))
     {
-    case ELogLevel::DEBUG:
-        lvl = "DEBUG";
-        break;
-    case ELogLevel::INFO:
-        lvl = "INFO";
-        break;
-    case ELogLevel::WARNING:
-        lvl = "WARNING";
-        break;
-    case ELogLevel::ERROR:
-        lvl = "ERROR";
-        break;
+        _lastTime = now;
+        _lastTimeStr = String('(') + String::ValueOf(now) + ")[";
     }
-    String res = String('(') + String::ValueOf(system::DateTime::Now()) + ")[" + category + "][" + lvl + "] " + msg;
-    _writer.WriteLine(res);
+    Append(*_lastTimeStr, _lastTimeStr.Size());
+    Append(*category, category.Size());
+    Append("][", 2);
+    Append(levels[(int)level], std::strlen(levels[(int)level]));
+    Append("] ", 2);
+    Append(*msg, msg.Size());
+    Append(newLine, std::strlen(newLine));
+}
+
+void FileLogger::Flush()
+{
+    // Inverse logic to avoid re-throwing the same exception
+    auto size = _buf.GetWrittenBytes();
+    _buf.Reset();
+    if (size > 0)
+        _stream.Write(*_buf, size);
 }
@@ -0,0 +1,229 @@
+// Copyright (c) 2020, BlockProject 3D
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without modification,
+// are permitted provided that the following conditions are met:
+// 
+//     * Redistributions of source code must retain the above copyright notice,
+//       this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above copyright notice,
+//       this list of conditions and the following disclaimer in the documentation
+//       and/or other materials provided with the distribution.
+//     * Neither the name of BlockProject 3D nor the names of its contributors
+//       may be used to endorse or promote products derived from this software
+//       without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include <chrono>
+#include "Framework/Log/LogRecord.hpp"
+
+using namespace bpf::log;
+using namespace bpf;
+
+LogRecord::LogRecord() noexcept
+    : _level(ELogLevel::INFO)
+    , _time(0)
+    , _format(nullptr)
+    , _size(0)
+    , _argc(0)
+{
+}
+
+LogRecord::LogRecord(const ELogLevel level, const String &text)
+    : _level(level)
+    , _time(CurrentTime())
+    , _format(nullptr)
+    , _size(0)
+    , _argc(0)
+    , _text(text)
+{
+}
+
+LogRecord::LogRecord(const LogRecord &other)
+    : _level(other._level)
+    , _time(other._time)
+    , _format(other._format)
+    , _size(other._size)
+    , _argc(other._argc)
+{
+    if (!other._text.IsEmpty())
+        _text = other._text;
+    std::memcpy(_data, other._data, _size);
+}
+
+LogRecord::LogRecord(LogRecord &&other) noexcept
+    : _level(other._level)
+    , _time(other._time)
+    , _format(other._format)
+    , _size(other._size)
+    , _argc(other._argc)
+    , _text(std::move(other._text))
+{
+    std::memcpy(_data, other._data, _size);
+}
+
+LogRecord &LogRecord::operator=(const LogRecord &other)
+{
+    if (this == &other)
+        return (*this);
+    _level = other._level;
+    _time = other._time;
+    _format = other._format;
+    _size = other._size;
+    _argc = other._argc;
+    if (other._text.IsEmpty())
+        _text = String();
+    else
+        _text = other._text;
+    std::memcpy(_data, other._data, _size);
+    return (*this);
+}
+
+LogRecord &LogRecord::operator=(LogRecord &&other) noexcept
+{
+    if (this == &other)
+        return (*this);
+    _level = other._level;
+    _time = other._time;
+    _format = other._format;
+    _size = other._size;
+    _argc = other._argc;
+    _text = std::move(other._text);
+    std::memcpy(_data, other._data, _size);
+    return (*this);
+}
+
+int64 LogRecord::CurrentTime() noexcept
+{
+    auto now = std::chrono::system_clock::now().time_since_epoch();
+    return (std::chrono::duration_cast<std::chrono::microseconds>(now).count());
+}
+
+bool LogRecord::PushRaw(const EArgType type, const void *data, const fsize size, const fsize extra)
+{
+    if (_size + 1 + size + extra > LOG_RECORD_BUF_SIZE)
+        return (false);
+    _data[_size++] = (uint8)type;
+    std::memcpy(_data + _size, data, size);
+    _size += size;
+    ++_argc;
+    return (true);
+}
+
+bool LogRecord::Push(const char *str, const fsize len)
+{
+    auto l = (uint32)len;
+    // The string bytes and null terminator are appended right after the length
+    if (len > 0xFFFFFFFF || !PushRaw(ARG_STRING, &l, sizeof(uint32), len + 1))
+        return (false);
+    std::memcpy(_data + _size, str, len);
+    _data[_size + len] = 0;
+    _size += len + 1;
+    return (true);
+}
+
+bool LogRecord::NextArgument(fsize &cursor, Argument &arg) const noexcept
+{
+    if (cursor >= _size)
+        return (false);
+    arg.Type = (EArgType)_data[cursor++];
+    arg.Str = nullptr;
+    arg.StrLen = 0;
+    switch (arg.Type)
+    {
+    case ARG_INT:
+        std::memcpy(&arg.Int, _data + cursor, sizeof(int64));
+        cursor += sizeof(int64);
+        break;
+    case ARG_UINT:
+        std::memcpy(&arg.UInt, _data + cursor, sizeof(uint64));
+        cursor += sizeof(uint64);
+        break;
+    case ARG_FLOAT:
+        std::memcpy(&arg.Float, _data + cursor, sizeof(float));
+        cursor += sizeof(float);
+        break;
+    case ARG_DOUBLE:
+        std::memcpy(&arg.Double, _data + cursor, sizeof(double));
+        cursor += sizeof(double);
+        break;
+    case ARG_BOOL:
+        std::memcpy(&arg.Bool, _data + cursor, sizeof(bool));
+        cursor += sizeof(bool);
+        break;
+    case ARG_STRING:
+    {
+        uint32 len;
+        std::memcpy(&len, _data + cursor, sizeof(uint32));
+        cursor += sizeof(uint32);
+        arg.Str = reinterpret_cast<const char *>(_data + cursor);
+        arg.StrLen = len;
+        cursor += len + 1;
+        break;
+    }
+    }
+    return (true);
+}
+
+String LogRecord::FormatArgument(const String &pattern, const Argument &arg)
+{
+    switch (arg.Type)
+    {
+    case ARG_INT:
+        return (String::Format(pattern, arg.Int));
+    case ARG_UINT:
+        return (String::Format(pattern, arg.UInt));
+    case ARG_FLOAT:
+        return (String::Format(pattern, arg.Float));
+    case ARG_DOUBLE:
+        return (String::Format(pattern, arg.Double));
+    case ARG_BOOL:
+        return (String::Format(pattern, arg.Bool));
+    case ARG_STRING:
+        return (String::Format(pattern, String(arg.Str, arg.StrLen)));
+    }
+    return (String());
+}
+
+String LogRecord::ToString() const
+{
+    if (_format == nullptr)
+        return (_text);
+    // Same algorithm as String::Format: each argument replaces the first pattern of the remaining format and an
+    // escaped pattern ends formatting by removing the first backslash only
+    String res;
+    String format = _format;
+    fsize cursor = 0;
+    Argument arg;
+
+    while (NextArgument(cursor, arg))
+    {
+        fisize i = format.IndexOf('[');
+        fisize j = format.IndexOf(']');
+        if (i > -1 && j > -1 && format.Sub(i - 1, i) != "\\")
+        {
+            res += format.Sub(0, i);
+            res += FormatArgument(String('[') + format.Sub(i + 1, j) + ']', arg);
+            format = format.Sub(j + 1);
+        }
+        else
+        {
+            res += format.Sub(0, format.IndexOf('\\'));
+            res += format.Sub(format.IndexOf('\\') + 1);
+            return (res);
+        }
+    }
+    return (res + format);
+}
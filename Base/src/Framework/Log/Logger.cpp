@@ -46,6 +46,7 @@ Logger::Logger(Logger &&other) noexcept
     : _handlers(std::move(other._handlers))
     , _name(std::move(other._name))
     , _level(other._level)
+    , _lock(std::move(other._lock))
 {
 }
 
@@ -55,10 +56,19 @@ Logger &Logger::operator=(Logger &&other) noexcept
     _handlers = std::move(other._handlers);
     _name = std::move(other._name);
     _level = other._level;
+    _lock = std::move(other._lock);
     return (*this);
 }
 
 void Logger::AddHandler(UniquePtr<ILogAdapter> &&ptr)
 {
+    system::ScopeLock lock(_lock);
     _handlers.Add(std::move(ptr));
 }
+
+void Logger::Flush()
+{
+    system::ScopeLock lock(_lock);
+    for (auto &ptr : _handlers)
+        ptr->Flush();
+}
@@ -26,73 +26,194 @@
 // NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
 // SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
-#include <cstdlib>
+#include <atomic>
+#include <cstring>
 #include <ctime>
 #include "Framework/Math/Random.hpp"
-#include "Framework/Math/Math.hpp"
+#include "Framework/Math/SIMD.hpp"
 
 using namespace bpf::math;
 using namespace bpf;
 
-fint Random::IntBounds(const fint min, const fint max)
+static inline uint64 RotateLeft(const uint64 x, const int k)
 {
-    fint rd = rand() % max;
+    return ((x << k) | (x >> (64 - k)));
+}
+
+static inline uint64 SplitMix64(uint64 &x)
+{
+    uint64 z = (x += 0x9E3779B97F4A7C15ULL);
 
-    while (rd < min || rd > max)
-        rd = rand() % max;
-    return (rd);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return (z ^ (z >> 31));
+}
+
+void Random::Seed(uint64 seed) noexcept
+{
+    // SplitMix64 expands the seed so that close seeds still give unrelated states, never all zero
+    for (fsize i = 0; i != 4; ++i)
+        _state[i] = SplitMix64(seed);
 }
 
 Random::Random(const long seed)
 {
-    srand((uint32)seed);
+    Seed((uint64)seed);
 }
 
 Random::Random()
 {
-    srand((unsigned int)time(nullptr));
+    static std::atomic<uint64> counter(0);
+
+    Seed((uint64)time(nullptr) ^ (++counter * 0xD1B54A32D192ED03ULL) ^ (uint64)(uintptr)this);
+}
+
+uint64 Random::NextUInt64() noexcept
+{
+    uint64 res = RotateLeft(_state[1] * 5, 7) * 9;
+    uint64 t = _state[1] << 17;
+
+    _state[2] ^= _state[0];
+    _state[3] ^= _state[1];
+    _state[1] ^= _state[2];
+    _state[0] ^= _state[3];
+    _state[2] ^= t;
+    _state[3] = RotateLeft(_state[3], 45);
+    return (res);
+}
+
+uint32 Random::Bounded(const uint32 range) noexcept
+{
+    // Lemire's multiply-shift: unbiased with on average less than one extra draw
+    uint64 m = (uint64)NextUInt32() * range;
+    uint32 low = (uint32)m;
+
+    if (low < range)
+    {
+        uint32 threshold = (0U - range) % range;
+        while (low < threshold)
+        {
+            m = (uint64)NextUInt32() * range;
+            low = (uint32)m;
+        }
+    }
+    return ((uint32)(m >> 32));
 }
 
 fint Random::NextInt(const fint max)
 {
-    return (rand() % max);
+    return (NextInt(0, max));
 }
 
-fint Random::NextInt(const fint min, const fint max)
+fint Random::NextInt(fint min, fint max)
 {
-    return (IntBounds(min, max));
+    if (min > max)
+    {
+        fint tmp = min;
+        min = max;
+        max = tmp;
+    }
+    uint32 range = (uint32)max - (uint32)min + 1;
+    if (range == 0)
+        return ((fint)NextUInt32());
+    return ((fint)((uint32)min + Bounded(range)));
 }
 
 uint8 Random::NextByte(const uint8 max)
 {
-    return ((uint8)IntBounds(0, max));
+    return ((uint8)NextInt(0, max));
 }
 
 uint8 Random::NextByte(const uint8 min, const uint8 max)
 {
-    return ((uint8)IntBounds(min, max));
+    return ((uint8)NextInt(min, max));
 }
 
 uint16 Random::NextShort(const uint16 max)
 {
-    return ((uint16)IntBounds(0, max));
+    return ((uint16)NextInt(0, max));
 }
 
 uint16 Random::NextShort(const uint16 min, const uint16 max)
 {
-    return ((uint16)IntBounds(min, max));
+    return ((uint16)NextInt(min, max));
 }
 
 float Random::NextFloat(const float min)
 {
-    fint start = Math<fint>::Abs(rand() % 256);
-
-    return (((float)start / 256.0f) + min);
+    return ((float)(NextUInt64() >> 40) * (1.0f / 16777216.0f) + min);
 }
 
 double Random::NextDouble()
 {
-    fint start = Math<fint>::Abs(rand() % 256);
+    return ((double)(NextUInt64() >> 11) * (1.0 / 9007199254740992.0));
+}
+
+void Random::Fill(float *out, const fsize count) noexcept
+{
+    fsize i = 0;
+
+#ifdef BP_MATH_SSE
+    const __m128 scale = _mm_set1_ps(1.0f / 16777216.0f);
+    for (; i + 4 <= count; i += 4)
+    {
+        uint64 a = NextUInt64();
+        uint64 b = NextUInt64();
+        // Each 32 bits half gives the 24 bits mantissa of one float
+        __m128i bits = _mm_srli_epi32(_mm_set_epi64x((int64)b, (int64)a), 8);
+        _mm_storeu_ps(out + i, _mm_mul_ps(_mm_cvtepi32_ps(bits), scale));
+    }
+#endif
+    while (i < count)
+    {
+        uint64 a = NextUInt64();
+        out[i++] = (float)((uint32)a >> 8) * (1.0f / 16777216.0f);
+        if (i < count)
+            out[i++] = (float)((uint32)(a >> 32) >> 8) * (1.0f / 16777216.0f);
+    }
+}
+
+void Random::Fill(double *out, const fsize count) noexcept
+{
+    for (fsize i = 0; i != count; ++i)
+        out[i] = (double)(NextUInt64() >> 11) * (1.0 / 9007199254740992.0);
+}
+
+void Random::Fill(uint8 *out, const fsize size) noexcept
+{
+    fsize i = 0;
+
+    for (; i + 8 <= size; i += 8)
+    {
+        uint64 bits = NextUInt64();
+        std::memcpy(out + i, &bits, 8);
+    }
+    if (i < size)
+    {
+        uint64 bits = NextUInt64();
+        std::memcpy(out + i, &bits, size - i);
+    }
+}
 
-    return ((double)start / 256.0f);
+void Random::Jump() noexcept
+{
+    static const uint64 JUMP[] = {0x180EC6D33CFD0ABAULL, 0xD5A61266F0C9392CULL, 0xA9582618E03FC9AAULL,
+                                  0x39ABDC4529B1661CULL};
+    uint64 s[4] = {0, 0, 0, 0};
+
+    for (fsize i = 0; i != 4; ++i)
+    {
+        for (int b = 0; b != 64; ++b)
+        {
+            if (JUMP[i] & (1ULL << b))
+            {
+                s[0] ^= _state[0];
+                s[1] ^= _state[1];
+                s[2] ^= _state[2];
+                s[3] ^= _state[3];
+            }
+            NextUInt64();
+        }
+    }
+    std::memcpy(_state, s, sizeof(s));
 }
@@ -27,9 +27,8 @@
 // SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include "Framework/Scalar.hpp"
+#include "Framework/NumberConvert.hpp"
 #include "Framework/ParseException.hpp"
-#include <cerrno>
-#include <cstdlib>
 
 using namespace bpf;
 
@@ -54,220 +53,181 @@ constexpr float Float::MinValue;
 constexpr double Double::MaxValue;
 constexpr double Double::MinValue;
 
+namespace _bpf_internal_scalar
+{
+    using EParseResult = NumberConvert::EParseResult;
+
+    template <typename T>
+    EParseResult ParseSigned(const String &str, T &res)
+    {
+        int64 value;
+        EParseResult status = NumberConvert::Parse(*str, str.Size(), value);
+
+        if (status != EParseResult::SUCCESS)
+            return (status);
+        if (value < std::numeric_limits<T>::min() || value > std::numeric_limits<T>::max())
+            return (EParseResult::OUT_OF_RANGE);
+        res = static_cast<T>(value);
+        return (EParseResult::SUCCESS);
+    }
+
+    template <typename T>
+    EParseResult ParseUnsigned(const String &str, T &res)
+    {
+        uint64 value;
+        EParseResult status = NumberConvert::Parse(*str, str.Size(), value);
+
+        if (status != EParseResult::SUCCESS)
+            return (status);
+        if (value > std::numeric_limits<T>::max())
+            return (EParseResult::OUT_OF_RANGE);
+        res = static_cast<T>(value);
+        return (EParseResult::SUCCESS);
+    }
+
+    template <typename T>
+    EParseResult ParseFloat(const String &str, T &res)
+    {
+        return (NumberConvert::Parse(*str, str.Size(), res));
+    }
+
+    void Check(const EParseResult status)
+    {
+        if (status == EParseResult::OUT_OF_RANGE)
+            throw ParseException("Out of range");
+        if (status != EParseResult::SUCCESS)
+            throw ParseException("Invalid string format");
+    }
+}
+
+using namespace _bpf_internal_scalar;
+
 fint Int::Parse(const String &str)
 {
-    errno = 0;
-    char *ptr;
-    long l = std::strtol(*str, &ptr, 0);
+    fint res = 0;
 
-    if (errno != 0 || ptr != *str + str.Size())
-        throw ParseException(errno == ERANGE ? "Out of range" : "Invalid string format");
-    return ((fint)l);
+    Check(ParseSigned(str, res));
+    return (res);
 }
 
 bool Int::TryParse(const String &str, fint &res)
 {
-    errno = 0;
-    char *ptr;
-    long l = std::strtol(*str, &ptr, 0);
-
-    res = (fint)l;
-    return (!(errno != 0 || ptr != *str + str.Size()));
+    return (ParseSigned(str, res) == EParseResult::SUCCESS);
 }
 
 uint32 UInt::Parse(const String &str)
 {
-    errno = 0;
-    char *ptr;
-    unsigned long l = std::strtoul(*str, &ptr, 0);
+    uint32 res = 0;
 
-    if (errno != 0 || ptr != *str + str.Size())
-        throw ParseException(errno == ERANGE ? "Out of range" : "Invalid string format");
-    return ((uint32)l);
+    Check(ParseUnsigned(str, res));
+    return (res);
 }
 
 bool UInt::TryParse(const String &str, uint32 &res)
 {
-    errno = 0;
-    char *ptr;
-    unsigned long l = std::strtoul(*str, &ptr, 0);
-
-    res = (uint32)l;
-    return (!(errno != 0 || ptr != *str + str.Size()));
+    return (ParseUnsigned(str, res) == EParseResult::SUCCESS);
 }
 
 int8 Int8::Parse(const String &str)
 {
-    errno = 0;
-    char *ptr;
-    long l = std::strtol(*str, &ptr, 0);
-
-    if (errno != 0)
-        throw ParseException(errno == ERANGE ? "Out of range" : "Invalid string format");
-    if (l < MinValue || l > MaxValue || ptr != *str + str.Size())
-        throw ParseException("Out of range");
-    return ((int8)l);
+    int8 res = 0;
+
+    Check(ParseSigned(str, res));
+    return (res);
 }
 
 bool Int8::TryParse(const String &str, int8 &res)
 {
-    errno = 0;
-    char *ptr;
-    long l = std::strtol(*str, &ptr, 0);
-
-    res = (int8)l;
-    return (!(errno != 0 || ptr != *str + str.Size() || l < MinValue || l > MaxValue));
+    return (ParseSigned(str, res) == EParseResult::SUCCESS);
 }
 
 uint8 UInt8::Parse(const String &str)
 {
-    errno = 0;
-    char *ptr;
-    unsigned long l = std::strtoul(*str, &ptr, 0);
-
-    if (errno != 0)
-        throw ParseException(errno == ERANGE ? "Out of range" : "Invalid string format");
-    if (l > MaxValue || ptr != *str + str.Size())
-        throw ParseException("Out of range");
-    return ((uint8)l);
+    uint8 res = 0;
+
+    Check(ParseUnsigned(str, res));
+    return (res);
 }
 
 bool UInt8::TryParse(const String &str, uint8 &res)
 {
-    errno = 0;
-    char *ptr;
-    unsigned long l = std::strtoul(*str, &ptr, 0);
-
-    res = (uint8)l;
-    return (!(errno != 0 || ptr != *str + str.Size() || l > MaxValue));
+    return (ParseUnsigned(str, res) == EParseResult::SUCCESS);
 }
 
 int16 Int16::Parse(const String &str)
 {
-    errno = 0;
-    char *ptr;
-    long l = std::strtol(*str, &ptr, 0);
-
-    if (errno != 0)
-        throw ParseException(errno == ERANGE ? "Out of range" : "Invalid string format");
-    if (l < MinValue || l > MaxValue || ptr != *str + str.Size())
-        throw ParseException("Out of range");
-    return ((int16)l);
+    int16 res = 0;
+
+    Check(ParseSigned(str, res));
+    return (res);
 }
 
 bool Int16::TryParse(const String &str, int16 &res)
 {
-    errno = 0;
-    char *ptr;
-    long l = std::strtol(*str, &ptr, 0);
-
-    res = (int16)l;
-    return (!(errno != 0 || ptr != *str + str.Size() || l < MinValue || l > MaxValue));
+    return (ParseSigned(str, res) == EParseResult::SUCCESS);
 }
 
 uint16 UInt16::Parse(const String &str)
 {
-    errno = 0;
-    char *ptr;
-    unsigned long l = std::strtoul(*str, &ptr, 0);
-
-    if (errno != 0)
-        throw ParseException(errno == ERANGE ? "Out of range" : "Invalid string format");
-    if (l > MaxValue || ptr != *str + str.Size())
-        throw ParseException("Out of range");
-    return ((uint16)l);
+    uint16 res = 0;
+
+    Check(ParseUnsigned(str, res));
+    return (res);
 }
 
 bool UInt16::TryParse(const String &str, uint16 &res)
 {
-    errno = 0;
-    char *ptr;
-    unsigned long l = std::strtoul(*str, &ptr, 0);
-
-    res = (uint16)l;
-    return (!(errno != 0 || ptr != *str + str.Size() || l > MaxValue));
+    return (ParseUnsigned(str, res) == EParseResult::SUCCESS);
 }
 
 int64 Int64::Parse(const String &str)
 {
-    errno = 0;
-    char *ptr;
-    int64 l = std::strtoll(*str, &ptr, 0);
+    int64 res = 0;
 
-    if (errno != 0 || ptr != *str + str.Size())
-        throw ParseException(errno == ERANGE ? "Out of range" : "Invalid string format");
-    return (l);
+    Check(ParseSigned(str, res));
+    return (res);
 }
 
 bool Int64::TryParse(const String &str, int64 &res)
 {
-    errno = 0;
-    char *ptr;
-    int64 l = std::strtoll(*str, &ptr, 0);
-
-    res = l;
-    return (!(errno != 0 || ptr != *str + str.Size()));
+    return (ParseSigned(str, res) == EParseResult::SUCCESS);
 }
 
 uint64 UInt64::Parse(const String &str)
 {
-    errno = 0;
-    char *ptr;
-    uint64 l = std::strtoull(*str, &ptr, 0);
+    uint64 res = 0;
 
-    if (errno != 0 || ptr != *str + str.Size())
-        throw ParseException(errno == ERANGE ? "Out of range" : "Invalid string format");
-    return (l);
+    Check(ParseUnsigned(str, res));
+    return (res);
 }
 
 bool UInt64::TryParse(const String &str, uint64 &res)
 {
-    errno = 0;
-    char *ptr;
-    uint64 l = std::strtoull(*str, &ptr, 0);
-
-    res = l;
-    return (!(errno != 0 || ptr != *str + str.Size()));
+    return (ParseUnsigned(str, res) == EParseResult::SUCCESS);
 }
 
 float Float::Parse(const String &str)
 {
-    errno = 0;
-    char *ptr;
-    auto f = (float)std::strtod(*str, &ptr);
+    float res = 0;
 
-    if (errno != 0 || ptr != *str + str.Size())
-        throw ParseException(errno == ERANGE ? "Out of range" : "Invalid string format");
-    return (f);
+    Check(ParseFloat(str, res));
+    return (res);
 }
 
 bool Float::TryParse(const String &str, float &res)
 {
-    errno = 0;
-    char *ptr;
-    float f = std::strtof(*str, &ptr);
-
-    res = f;
-    return (!(errno != 0 || ptr != *str + str.Size()));
+    return (ParseFloat(str, res) == EParseResult::SUCCESS);
 }
 
 double Double::Parse(const String &str)
 {
-    errno = 0;
-    char *ptr;
-    double d = std::strtod(*str, &ptr);
+    double res = 0;
 
-    if (errno != 0 || ptr != *str + str.Size())
-        throw ParseException(errno == ERANGE ? "Out of range" : "Invalid string format");
-    return (d);
+    Check(ParseFloat(str, res));
+    return (res);
 }
 
 bool Double::TryParse(const String &str, double &res)
 {
-    errno = 0;
-    char *ptr;
-    double d = std::strtod(*str, &ptr);
-
-    res = d;
-    return (!(errno != 0 || ptr != *str + str.Size()));
+    return (ParseFloat(str, res) == EParseResult::SUCCESS);
 }
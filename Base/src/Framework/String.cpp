@@ -32,8 +32,10 @@
 #include "Framework/EvalException.hpp"
 #include "Framework/IndexException.hpp"
 #include "Framework/Memory/Memory.hpp"
+#include "Framework/NumberConvert.hpp"
 #include "Framework/Scalar.hpp"
-#include <sstream>
+#include <cstdio>
+#include <limits>
 
 using namespace bpf::memory;
 using namespace bpf::collection;
@@ -282,6 +284,14 @@ String::String(const char *str)
     CopyString(str, Data, StrLen);
 }
 
+String::String(const char *str, const fsize len)
+    : Data(static_cast<char *>(Memory::Malloc(sizeof(char) * (len + 1))))
+    , StrLen(len)
+    , UnicodeLen(CalcUnicodeLen(str, len))
+{
+    CopyString(str, Data, len);
+}
+
 String::String(const fchar c)
     : Data(nullptr)
     , StrLen(1)
@@ -859,140 +869,108 @@ String String::Reverse() const
     return (res);
 }
 
+/**
+ * Left pads a formatted integer with zeros so that it is at least width characters long, sign included
+ */
+static String ZeroPad(const char *digits, const fsize len, const fsize width)
+{
+    if (len >= width)
+        return (String(digits, len));
+    String str;
+    fsize sign = digits[0] == '-' ? 1 : 0;
+    if (sign == 1)
+        str += '-';
+    for (fsize i = len; i != width; ++i)
+        str += '0';
+    return (str + String(digits + sign, len - sign));
+}
+
+/**
+ * Formats a number in fixed notation with prec digits after the decimal point
+ */
+template <typename T>
+static String FormatFixed(const char *format, const fsize prec, const T value)
+{
+    char buffer[128];
+    int len = std::snprintf(buffer, sizeof(buffer), format, static_cast<int>(prec), value);
+
+    if (len < 0)
+        return (String());
+    if (static_cast<fsize>(len) < sizeof(buffer))
+        return (String(buffer, static_cast<fsize>(len)));
+    auto *large = static_cast<char *>(Memory::Malloc(static_cast<fsize>(len) + 1));
+    std::snprintf(large, static_cast<fsize>(len) + 1, format, static_cast<int>(prec), value);
+    String str(large, static_cast<fsize>(len));
+    Memory::Free(large);
+    return (str);
+}
+
 String String::ValueOf(fint i, const fsize prec)
 {
-    std::stringstream strs;
-
-    if (prec > 0) //Dev of stringstream you are stupid; let me show you how it's supposed to be done!
-    {
-        strs << i;
-        String str = strs.str().c_str();
-        auto len = (fisize)(prec - str.Len());
-        if (len < 0)
-            return (str);
-        if (str[0] == '-')
-            str = str.Sub(1);
-        for (fisize j = 0; j < len; ++j)
-            str = String('0') + str;
-        if (i < 0)
-            str = String('-') + str;
-        return (str);
-    }
-    else
-        strs << i;
-    return (String(strs.str().c_str()));
+    char buffer[NumberConvert::MAX_CHARS];
+
+    return (ZeroPad(buffer, NumberConvert::Format(i, buffer), prec));
 }
 
 String String::ValueOf(uint32 i, const fsize prec)
 {
-    std::stringstream strs;
+    char buffer[NumberConvert::MAX_CHARS];
 
-    if (prec > 0)
-    {
-        strs << i;
-        String str = strs.str().c_str();
-        auto len = (fisize)(prec - str.Len());
-        if (len < 0)
-            return (str);
-        for (fisize j = 0; j < len; ++j)
-            str = String('0') + str;
-        return (str);
-    }
-    else
-        strs << i;
-    return (String(strs.str().c_str()));
+    return (ZeroPad(buffer, NumberConvert::Format(i, buffer), prec));
 }
 
 String String::ValueOf(uint64 i, const fsize prec)
 {
-    std::stringstream strs;
+    char buffer[NumberConvert::MAX_CHARS];
 
-    if (prec > 0)
-    {
-        strs << i;
-        String str = strs.str().c_str();
-        auto len = (fisize)(prec - str.Len());
-        if (len < 0)
-            return (str);
-        for (fisize j = 0; j < len; ++j)
-            str = String('0') + str;
-        return (str);
-    }
-    else
-        strs << i;
-    return (String(strs.str().c_str()));
+    return (ZeroPad(buffer, NumberConvert::Format(i, buffer), prec));
 }
 
 String String::ValueOf(int64 i, const fsize prec)
 {
-    std::stringstream strs;
+    char buffer[NumberConvert::MAX_CHARS];
 
-    if (prec > 0)
-    {
-        strs << i;
-        String str = strs.str().c_str();
-        auto len = (fisize)(prec - str.Len());
-        if (len < 0)
-            return (str);
-        if (str[0] == '-')
-            str = str.Sub(1);
-        for (fisize j = 0; j < len; ++j)
-            str = String('0') + str;
-        if (i < 0)
-            str = String('-') + str;
-        return (str);
-    }
-    else
-        strs << i;
-    return (String(strs.str().c_str()));
+    return (ZeroPad(buffer, NumberConvert::Format(i, buffer), prec));
 }
 
 String String::ValueOf(float f, const fsize prec)
 {
-    std::stringstream strs;
-
     if (prec > 0)
-    {
-        strs.precision(prec);
-        strs << std::fixed << f;
-    }
-    else
-        strs << f;
-    return (String(strs.str().c_str()));
+        return (FormatFixed("%.*f", prec, static_cast<double>(f)));
+    char buffer[NumberConvert::MAX_CHARS];
+    return (String(buffer, NumberConvert::Format(f, buffer)));
 }
 
 String String::ValueOf(double d, const fsize prec)
 {
-    std::stringstream strs;
-
     if (prec > 0)
-    {
-        strs.precision(prec);
-        strs << std::fixed << d;
-    }
-    else
-        strs << d;
-    return (String(strs.str().c_str()));
+        return (FormatFixed("%.*f", prec, d));
+    char buffer[NumberConvert::MAX_CHARS];
+    return (String(buffer, NumberConvert::Format(d, buffer)));
 }
 
 String String::ValueOf(long double d, const fsize prec)
 {
-    std::stringstream strs;
-
     if (prec > 0)
-    {
-        strs.precision(prec);
-        strs << std::fixed << d;
-    }
-    else
-        strs << d;
-    return (String(strs.str().c_str()));
+        return (FormatFixed("%.*Lf", prec, d));
+    if (static_cast<long double>(static_cast<double>(d)) == d)
+        return (ValueOf(static_cast<double>(d)));
+    return (FormatFixed("%.*Lg", std::numeric_limits<long double>::max_digits10, d));
 }
 
 String String::ValueOf(void *ptr, const fsize)
 {
-    std::stringstream strs;
+    char buffer[2 + sizeof(uintptr) * 2];
+    char *end = buffer + sizeof(buffer);
+    char *p = end;
+    auto value = reinterpret_cast<uintptr>(ptr);
 
-    strs << std::hex << (uintptr)ptr;
-    return (String("0x") + strs.str().c_str());
+    do
+    {
+        *--p = "0123456789abcdef"[value & 0xF];
+        value >>= 4;
+    } while (value != 0);
+    *--p = 'x';
+    *--p = '0';
+    return (String(p, static_cast<fsize>(end - p)));
 }
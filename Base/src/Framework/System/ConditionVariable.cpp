@@ -0,0 +1,169 @@
+// Copyright (c) 2020, BlockProject 3D
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without modification,
+// are permitted provided that the following conditions are met:
+// 
+//     * Redistributions of source code must retain the above copyright notice,
+//       this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above copyright notice,
+//       this list of conditions and the following disclaimer in the documentation
+//       and/or other materials provided with the distribution.
+//     * Neither the name of BlockProject 3D nor the names of its contributors
+//       may be used to endorse or promote products derived from this software
+//       without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include <cerrno>
+#include <cstdlib>
+#ifdef WINDOWS
+    #include <Windows.h>
+    using MutexType = CRITICAL_SECTION;
+    using ConditionType = CONDITION_VARIABLE;
+#else
+    #include <pthread.h>
+    #include <ctime>
+    using MutexType = pthread_mutex_t;
+    using ConditionType = pthread_cond_t;
+#endif
+#include "Framework/Memory/Memory.hpp"
+#include "Framework/System/ConditionVariable.hpp"
+#include "Framework/System/OSException.hpp"
+
+using namespace bpf::memory;
+using namespace bpf::system;
+using namespace bpf;
+
+ConditionVariable::ConditionVariable()
+    : _handle(malloc(sizeof(ConditionType)))
+{
+    if (_handle == nullptr)
+        throw MemoryException();
+#ifdef WINDOWS
+    InitializeConditionVariable(reinterpret_cast<ConditionType *>(_handle));
+#else
+    pthread_condattr_t attr;
+    pthread_condattr_init(&attr);
+    #ifndef MAC
+    // Timeouts must not be affected by changes of the system clock
+    pthread_condattr_setclock(&attr, CLOCK_MONOTONIC);
+    #endif
+    int res = pthread_cond_init(reinterpret_cast<ConditionType *>(_handle), &attr);
+    pthread_condattr_destroy(&attr);
+    if (res != 0)
+    {
+        free(_handle);
+        throw OSException("Could not create condition variable");
+    }
+#endif
+}
+
+ConditionVariable::~ConditionVariable()
+{
+    if (_handle == nullptr)
+        return;
+#ifndef WINDOWS
+    pthread_cond_destroy(reinterpret_cast<ConditionType *>(_handle));
+#endif
+    free(_handle);
+}
+
+ConditionVariable::ConditionVariable(ConditionVariable &&other) noexcept
+    : _handle(other._handle)
+{
+    other._handle = nullptr;
+}
+
+ConditionVariable &ConditionVariable::operator=(ConditionVariable &&other) noexcept
+{
+    if (_handle != nullptr)
+    {
+#ifndef WINDOWS
+        pthread_cond_destroy(reinterpret_cast<ConditionType *>(_handle));
+#endif
+        free(_handle);
+    }
+    _handle = other._handle;
+    other._handle = nullptr;
+    return (*this);
+}
+
+void ConditionVariable::Wait(const Mutex &mutex) const
+{
+#ifdef WINDOWS
+    if (!SleepConditionVariableCS(reinterpret_cast<ConditionType *>(_handle),
+                                  reinterpret_cast<MutexType *>(mutex._handle), INFINITE))
+        throw OSException("Could not wait for condition variable");
+#else
+    if (pthread_cond_wait(reinterpret_cast<ConditionType *>(_handle), reinterpret_cast<MutexType *>(mutex._handle)) != 0)
+        throw OSException("Could not wait for condition variable");
+#endif
+}
+
+bool ConditionVariable::Wait(const Mutex &mutex, const uint32 milliseconds) const
+{
+#ifdef WINDOWS
+    if (!SleepConditionVariableCS(reinterpret_cast<ConditionType *>(_handle),
+                                  reinterpret_cast<MutexType *>(mutex._handle), (DWORD)milliseconds))
+    {
+        if (GetLastError() == ERROR_TIMEOUT)
+            return (false);
+        throw OSException("Could not wait for condition variable");
+    }
+    return (true);
+#else
+    struct timespec ts;
+    #ifdef MAC
+    ts.tv_sec = milliseconds / 1000;
+    ts.tv_nsec = (milliseconds % 1000) * 1000000;
+    int res = pthread_cond_timedwait_relative_np(reinterpret_cast<ConditionType *>(_handle),
+                                                 reinterpret_cast<MutexType *>(mutex._handle), &ts);
+    #else
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    ts.tv_sec += milliseconds / 1000;
+    ts.tv_nsec += (milliseconds % 1000) * 1000000;
+    if (ts.tv_nsec >= 1000000000)
+    {
+        ++ts.tv_sec;
+        ts.tv_nsec -= 1000000000;
+    }
+    int res = pthread_cond_timedwait(reinterpret_cast<ConditionType *>(_handle),
+                                     reinterpret_cast<MutexType *>(mutex._handle), &ts);
+    #endif
+    if (res == ETIMEDOUT)
+        return (false);
+    if (res != 0)
+        throw OSException("Could not wait for condition variable");
+    return (true);
+#endif
+}
+
+void ConditionVariable::Signal() const noexcept
+{
+#ifdef WINDOWS
+    WakeConditionVariable(reinterpret_cast<ConditionType *>(_handle));
+#else
+    pthread_cond_signal(reinterpret_cast<ConditionType *>(_handle));
+#endif
+}
+
+void ConditionVariable::Broadcast() const noexcept
+{
+#ifdef WINDOWS
+    WakeAllConditionVariable(reinterpret_cast<ConditionType *>(_handle));
+#else
+    pthread_cond_broadcast(reinterpret_cast<ConditionType *>(_handle));
+#endif
+}
@@ -27,6 +27,7 @@
 // SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #ifdef WINDOWS
+    #include "Framework/Memory/Memory.hpp"
     #include <Windows.h>
     #include <intrin.h>
     #undef ERROR
@@ -34,21 +35,23 @@
     #include <sys/sysctl.h>
     #include <sys/types.h>
 #else
+    #include <cstdio>
+    #include <cstdlib>
+    #include <dirent.h>
+    #include <fcntl.h>
     #include <sys/sysinfo.h>
     #include <sys/utsname.h>
 #endif
 #ifndef WINDOWS
     #include <unistd.h>
 #endif
+#include <cstring>
 
-#ifndef WINDOWS // We assume compiler supports GCC style asm
-
-    #define INSTRUCTION_CPUID(val)                                                                                     \
-        asm("movl $" #val ", %eax");                                                                                   \
-        asm("cpuid")
-
-    #define READ_REGISTER(name, val) asm("movl %%" #name ", %0" : "=r"(val) :)
-
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)
+    #define BPF_CPU_X86
+    #ifndef WINDOWS
+        #include <cpuid.h>
+    #endif
 #endif
 
 #include "Framework/System/Platform.hpp"
@@ -85,75 +88,327 @@ RTL_OSVERSIONINFOW GetRealOSVersion()
 }
 #endif
 
-String Platform::CPUIDIntToStr(fint data)
+#ifdef BPF_CPU_X86
+static void __internal_CPUID(const uint32 leaf, const uint32 subleaf, uint32 regs[4])
 {
-    String res = "";
-    TypeExpander<int> exp(data);
-    res += static_cast<char>(exp.Bytes[0]);
-    res += static_cast<char>(exp.Bytes[1]);
-    res += static_cast<char>(exp.Bytes[2]);
-    res += static_cast<char>(exp.Bytes[3]);
-    return (res);
+    #ifdef WINDOWS
+    int info[4];
+    __cpuidex(info, static_cast<int>(leaf), static_cast<int>(subleaf));
+    for (int i = 0; i != 4; ++i)
+        regs[i] = static_cast<uint32>(info[i]);
+    #else
+    __cpuid_count(leaf, subleaf, regs[0], regs[1], regs[2], regs[3]);
+    #endif
 }
 
-String Platform::IdentifyCPUBranding()
+// Returns the register states enabled by the operating system (XCR0)
+static uint64 __internal_XGETBV()
 {
-#ifdef WINDOWS
-    fint cpuInfo[4] = {-1};
-    char CPUBrandString[0x40];
-    memset(CPUBrandString, 0, sizeof(CPUBrandString));
-    __cpuid(cpuInfo, 0x80000002);
-    memcpy(CPUBrandString, cpuInfo, sizeof(cpuInfo));
-    __cpuid(cpuInfo, 0x80000003);
-    memcpy(CPUBrandString + 16, cpuInfo, sizeof(cpuInfo));
-    __cpuid(cpuInfo, 0x80000004);
-    memcpy(CPUBrandString + 32, cpuInfo, sizeof(cpuInfo));
-    return (String(CPUBrandString));
+    #ifdef WINDOWS
+    return (_xgetbv(0));
+    #else
+    uint32 low;
+    uint32 high;
+    __asm__ volatile("xgetbv" : "=a"(low), "=d"(high) : "c"(0));
+    return ((static_cast<uint64>(high) << 32) | low);
+    #endif
+}
+#endif
+
+static uint32 __internal_DetectFeatures()
+{
+    uint32 features = 0;
+
+#ifdef BPF_CPU_X86
+    uint32 regs[4];
+    __internal_CPUID(0, 0, regs);
+    uint32 maxLeaf = regs[0];
+    if (maxLeaf < 1)
+        return (0);
+    __internal_CPUID(1, 0, regs);
+    uint32 ecx = regs[2];
+    uint32 edx = regs[3];
+    if (edx & (1 << 26))
+        features |= CPU_FEATURE_SSE2;
+    if (ecx & (1 << 0))
+        features |= CPU_FEATURE_SSE3;
+    if (ecx & (1 << 9))
+        features |= CPU_FEATURE_SSSE3;
+    if (ecx & (1 << 19))
+        features |= CPU_FEATURE_SSE41;
+    if (ecx & (1 << 20))
+        features |= CPU_FEATURE_SSE42;
+    if (ecx & (1 << 23))
+        features |= CPU_FEATURE_POPCNT;
+    if (ecx & (1 << 25))
+        features |= CPU_FEATURE_AES;
+    // AVX registers are only usable if the operating system saves them on context switches
+    uint64 xcr0 = (ecx & (1 << 27)) ? __internal_XGETBV() : 0;
+    bool avxState = (xcr0 & 0x6) == 0x6;
+    bool avx512State = avxState && (xcr0 & 0xE0) == 0xE0;
+    if (avxState && (ecx & (1 << 28)))
+        features |= CPU_FEATURE_AVX;
+    if (avxState && (ecx & (1 << 12)))
+        features |= CPU_FEATURE_FMA;
+    if (maxLeaf >= 7)
+    {
+        __internal_CPUID(7, 0, regs);
+        uint32 ebx = regs[1];
+        if (ebx & (1 << 3))
+            features |= CPU_FEATURE_BMI1;
+        if (ebx & (1 << 8))
+            features |= CPU_FEATURE_BMI2;
+        if (avxState && (ebx & (1 << 5)))
+            features |= CPU_FEATURE_AVX2;
+        if (avx512State && (ebx & (1 << 16)))
+        {
+            features |= CPU_FEATURE_AVX512F;
+            if (ebx & (1 << 17))
+                features |= CPU_FEATURE_AVX512DQ;
+            if (ebx & (1 << 30))
+                features |= CPU_FEATURE_AVX512BW;
+            if (ebx & (1U << 31))
+                features |= CPU_FEATURE_AVX512VL;
+        }
+    }
+#elif defined(__aarch64__) || defined(_M_ARM64) || defined(__ARM_NEON)
+    features |= CPU_FEATURE_NEON;
+#endif
+    return (features);
+}
+
+#if !defined(WINDOWS) && !defined(MAC)
+static bool __internal_ReadSysFile(const char *path, char *buf, const fsize size)
+{
+    int fd = open(path, O_RDONLY | O_CLOEXEC);
+    if (fd == -1)
+        return (false);
+    auto len = read(fd, buf, size - 1);
+    close(fd);
+    if (len <= 0)
+        return (false);
+    buf[len] = '\0';
+    return (true);
+}
+
+// Parses a sysfs size such as "48K" or "32M"
+static fsize __internal_ReadSysSize(const char *path)
+{
+    char buf[64];
+    if (!__internal_ReadSysFile(path, buf, sizeof(buf)))
+        return (0);
+    char *end;
+    fsize size = static_cast<fsize>(std::strtoull(buf, &end, 10));
+    if (*end == 'K')
+        size <<= 10;
+    else if (*end == 'M')
+        size <<= 20;
+    else if (*end == 'G')
+        size <<= 30;
+    return (size);
+}
+
+// Counts the processors of a sysfs CPU list such as "0-3,8-11" and returns the first one
+static fint __internal_ParseCPUList(const char *list, fint &first)
+{
+    fint count = 0;
+    first = -1;
+    while (*list >= '0' && *list <= '9')
+    {
+        char *end;
+        long low = std::strtol(list, &end, 10);
+        long high = low;
+        if (*end == '-')
+            high = std::strtol(end + 1, &end, 10);
+        if (first == -1)
+            first = static_cast<fint>(low);
+        count += static_cast<fint>(high - low + 1);
+        if (*end != ',')
+            break;
+        list = end + 1;
+    }
+    return (count);
+}
+
+static void __internal_DetectTopology(CPU &cpu)
+{
+    char path[128];
+    char buf[256];
+    fint physical = 0;
+    long configured = sysconf(_SC_NPROCESSORS_CONF);
+
+    for (long i = 0; i < configured; ++i)
+    {
+        // Offline processors have no topology: they are skipped
+        std::snprintf(path, sizeof(path), "/sys/devices/system/cpu/cpu%ld/topology/thread_siblings_list", i);
+        if (!__internal_ReadSysFile(path, buf, sizeof(buf)))
+            continue;
+        fint first;
+        fint siblings = __internal_ParseCPUList(buf, first);
+        if (siblings > cpu.ThreadsPerCore)
+            cpu.ThreadsPerCore = siblings;
+        if (first == i)
+            ++physical;
+    }
+    if (physical > 0)
+        cpu.NumPhysicalCores = physical;
+    for (int i = 0; i != 16; ++i)
+    {
+        std::snprintf(path, sizeof(path), "/sys/devices/system/cpu/cpu0/cache/index%d/level", i);
+        if (!__internal_ReadSysFile(path, buf, sizeof(buf)))
+            break;
+        int level = std::atoi(buf);
+        std::snprintf(path, sizeof(path), "/sys/devices/system/cpu/cpu0/cache/index%d/type", i);
+        if (!__internal_ReadSysFile(path, buf, sizeof(buf)) || std::strncmp(buf, "Instruction", 11) == 0)
+            continue;
+        std::snprintf(path, sizeof(path), "/sys/devices/system/cpu/cpu0/cache/index%d/size", i);
+        fsize size = __internal_ReadSysSize(path);
+        if (level == 1)
+        {
+            cpu.L1CacheSize = size;
+            std::snprintf(path, sizeof(path), "/sys/devices/system/cpu/cpu0/cache/index%d/coherency_line_size", i);
+            cpu.CacheLineSize = __internal_ReadSysSize(path);
+        }
+        else if (level == 2)
+            cpu.L2CacheSize = size;
+        else if (level == 3)
+            cpu.L3CacheSize = size;
+    }
+    DIR *dir = opendir("/sys/devices/system/node");
+    if (dir != nullptr)
+    {
+        fint nodes = 0;
+        struct dirent *ent;
+        while ((ent = readdir(dir)) != nullptr)
+        {
+            if (std::strncmp(ent->d_name, "node", 4) == 0 && ent->d_name[4] >= '0' && ent->d_name[4] <= '9')
+                ++nodes;
+        }
+        closedir(dir);
+        if (nodes > 0)
+            cpu.NumNodes = nodes;
+    }
+    if (__internal_ReadSysFile("/sys/devices/system/cpu/cpu0/cpufreq/cpuinfo_max_freq", buf, sizeof(buf)))
+        cpu.Freq = std::atoi(buf) / 1000;
+}
+#elif MAC
+static uint64 __internal_SysctlValue(const char *name)
+{
+    uint64 value = 0;
+    size_t size = sizeof(value);
+    if (sysctlbyname(name, &value, &size, nullptr, 0) != 0)
+        return (0);
+    // Some entries are 32 bits
+    if (size == sizeof(uint32))
+    {
+        uint32 small;
+        std::memcpy(&small, &value, sizeof(uint32));
+        return (small);
+    }
+    return (value);
+}
+
+static void __internal_DetectTopology(CPU &cpu)
+{
+    auto physical = static_cast<fint>(__internal_SysctlValue("hw.physicalcpu"));
+    if (physical > 0)
+        cpu.NumPhysicalCores = physical;
+    cpu.CacheLineSize = static_cast<fsize>(__internal_SysctlValue("hw.cachelinesize"));
+    cpu.L1CacheSize = static_cast<fsize>(__internal_SysctlValue("hw.l1dcachesize"));
+    cpu.L2CacheSize = static_cast<fsize>(__internal_SysctlValue("hw.l2cachesize"));
+    cpu.L3CacheSize = static_cast<fsize>(__internal_SysctlValue("hw.l3cachesize"));
+    auto freq = __internal_SysctlValue("hw.cpufrequency_max");
+    if (freq > 0)
+        cpu.Freq = static_cast<fint>(freq / 1000000);
+}
 #else
-    #if defined(__arm__) || defined(__aarch64__)
+static void __internal_DetectTopology(CPU &cpu)
+{
+    DWORD len = 0;
+    GetLogicalProcessorInformationEx(RelationAll, nullptr, &len);
+    if (len == 0)
+        return;
+    auto *buf = static_cast<uint8 *>(memory::Memory::Malloc(len));
+    if (GetLogicalProcessorInformationEx(RelationAll, reinterpret_cast<PSYSTEM_LOGICAL_PROCESSOR_INFORMATION_EX>(buf), &len))
+    {
+        fint physical = 0;
+        fint nodes = 0;
+        for (DWORD offset = 0; offset < len;)
+        {
+            auto *info = reinterpret_cast<PSYSTEM_LOGICAL_PROCESSOR_INFORMATION_EX>(buf + offset);
+            if (info->Relationship == RelationProcessorCore)
+            {
+                ++physical;
+                fint siblings = 0;
+                for (KAFFINITY mask = info->Processor.GroupMask[0].Mask; mask != 0; mask &= mask - 1)
+                    ++siblings;
+                if (siblings > cpu.ThreadsPerCore)
+                    cpu.ThreadsPerCore = siblings;
+            }
+            else if (info->Relationship == RelationNumaNode)
+                ++nodes;
+            else if (info->Relationship == RelationCache && info->Cache.Type != CacheInstruction)
+            {
+                if (info->Cache.Level == 1)
+                {
+                    cpu.L1CacheSize = info->Cache.CacheSize;
+                    cpu.CacheLineSize = info->Cache.LineSize;
+                }
+                else if (info->Cache.Level == 2)
+                    cpu.L2CacheSize = info->Cache.CacheSize;
+                else if (info->Cache.Level == 3)
+                    cpu.L3CacheSize = info->Cache.CacheSize;
+            }
+            offset += info->Size;
+        }
+        if (physical > 0)
+            cpu.NumPhysicalCores = physical;
+        if (nodes > 0)
+            cpu.NumNodes = nodes;
+    }
+    memory::Memory::Free(buf);
+    DWORD mhz = 0;
+    DWORD size = sizeof(mhz);
+    if (RegGetValueW(HKEY_LOCAL_MACHINE, L"HARDWARE\\DESCRIPTION\\System\\CentralProcessor\\0", L"~MHz",
+                     RRF_RT_REG_DWORD, nullptr, &mhz, &size) == ERROR_SUCCESS)
+        cpu.Freq = static_cast<fint>(mhz);
+}
+#endif
+
+String Platform::IdentifyCPUBranding()
+{
+#ifdef BPF_CPU_X86
+    uint32 regs[4];
+    char brand[49];
+    __internal_CPUID(0x80000000, 0, regs);
+    if (regs[0] < 0x80000004)
+        return ("Generic CPU");
+    for (uint32 i = 0; i != 3; ++i)
+    {
+        __internal_CPUID(0x80000002 + i, 0, regs);
+        std::memcpy(brand + i * 16, regs, sizeof(regs));
+    }
+    brand[48] = '\0';
+    // The brand string is padded with spaces
+    fsize start = 0;
+    fsize end = std::strlen(brand);
+    while (start < end && brand[start] == ' ')
+        ++start;
+    while (end > start && brand[end - 1] == ' ')
+        --end;
+    return (String(brand + start, end - start));
+#elif MAC
+    char brand[128];
+    size_t size = sizeof(brand);
+    if (sysctlbyname("machdep.cpu.brand_string", brand, &size, nullptr, 0) == 0)
+        return (String(brand));
+    return ("Generic CPU");
+#elif defined(__arm__) || defined(__aarch64__) || defined(_M_ARM64)
     // For getting a name here go ask ARM architecture team to provide the missing cpuid instruction or an instruction
     // that can obtain brand name
     return ("Generic ARM Processor");
-    #else
-        #ifdef BUILD_DEBUG
-    String res = "";
-    fint reg_eax = 0;
-    fint reg_ebx = 0;
-    fint reg_ecx = 0;
-    fint reg_edx = 0;
-
-    INSTRUCTION_CPUID(0x80000002);
-    READ_REGISTER(eax, reg_eax);
-    READ_REGISTER(ebx, reg_ebx);
-    READ_REGISTER(ecx, reg_ecx);
-    READ_REGISTER(edx, reg_edx);
-    res += CPUIDIntToStr(reg_eax);
-    res += CPUIDIntToStr(reg_ebx);
-    res += CPUIDIntToStr(reg_ecx);
-    res += CPUIDIntToStr(reg_edx);
-    INSTRUCTION_CPUID(0x80000003);
-    READ_REGISTER(eax, reg_eax);
-    READ_REGISTER(ebx, reg_ebx);
-    READ_REGISTER(ecx, reg_ecx);
-    READ_REGISTER(edx, reg_edx);
-    res += CPUIDIntToStr(reg_eax);
-    res += CPUIDIntToStr(reg_ebx);
-    res += CPUIDIntToStr(reg_ecx);
-    res += CPUIDIntToStr(reg_edx);
-    INSTRUCTION_CPUID(0x80000004);
-    READ_REGISTER(eax, reg_eax);
-    READ_REGISTER(ebx, reg_ebx);
-    READ_REGISTER(ecx, reg_ecx);
-    READ_REGISTER(edx, reg_edx);
-    res += CPUIDIntToStr(reg_eax);
-    res += CPUIDIntToStr(reg_ebx);
-    res += CPUIDIntToStr(reg_ecx);
-    res += CPUIDIntToStr(reg_edx);
-    return (res);
-        #else
-    return ("Generic CPU"); // In optimized build attempting to call cpuid crashes the application under unix
-        #endif
-    #endif
+#else
+    return ("Generic CPU");
 #endif
 }
 
@@ -212,26 +467,63 @@ const OS &Platform::GetOSInfo()
     return (os);
 }
 
-const CPU &Platform::GetCPUInfo()
+CPU Platform::InitCPUInfo()
 {
-    static CPU cpi = {IdentifyCPUBranding(), 0, 0};
+    CPU cpi;
 
+    cpi.Name = IdentifyCPUBranding();
 #ifdef WINDOWS
     SYSTEM_INFO sysInfo;
     GetSystemInfo(&sysInfo);
     cpi.NumCores = sysInfo.dwNumberOfProcessors;
-    cpi.Freq = 1; // Cannot reliably find CPU frequency
 #elif MAC
     fint ncores = 1;
     size_t sz = sizeof(fint);
     if (sysctlbyname("hw.activecpu", &ncores, &sz, nullptr, 0))
         sysctlbyname("hw.ncpu", &ncores, &sz, nullptr, 0);
     cpi.NumCores = ncores;
-    cpi.Freq = 1; // Cannot reliably find CPU frequency
 #else
     cpi.NumCores = get_nprocs();
-    cpi.Freq = 1; // Cannot reliably find CPU frequency
 #endif
+    cpi.Freq = 0;
+    cpi.NumPhysicalCores = 0;
+    cpi.ThreadsPerCore = 1;
+    cpi.NumNodes = 1;
+    cpi.CacheLineSize = 0;
+    cpi.L1CacheSize = 0;
+    cpi.L2CacheSize = 0;
+    cpi.L3CacheSize = 0;
+    cpi.Features = __internal_DetectFeatures();
+    __internal_DetectTopology(cpi);
+#ifdef BPF_CPU_X86
+    uint32 regs[4];
+    __internal_CPUID(0, 0, regs);
+    if (cpi.Freq <= 0 && regs[0] >= 0x16)
+    {
+        // Processor base frequency in MHz; hypervisors commonly report 0 or garbage so anything below 100 MHz is
+        // treated as unknown
+        __internal_CPUID(0x16, 0, regs);
+        if ((regs[0] & 0xFFFF) >= 100)
+            cpi.Freq = static_cast<fint>(regs[0] & 0xFFFF);
+    }
+    if (cpi.CacheLineSize == 0)
+    {
+        // CLFLUSH line size
+        __internal_CPUID(1, 0, regs);
+        cpi.CacheLineSize = ((regs[1] >> 8) & 0xFF) * 8;
+    }
+#endif
+    if (cpi.Freq <= 0)
+        cpi.Freq = 1; // Cannot reliably find CPU frequency
+    if (cpi.NumPhysicalCores <= 0)
+        cpi.NumPhysicalCores = cpi.NumCores / cpi.ThreadsPerCore > 0 ? cpi.NumCores / cpi.ThreadsPerCore : 1;
+    return (cpi);
+}
+
+const CPU &Platform::GetCPUInfo()
+{
+    static CPU cpi = Platform::InitCPUInfo();
+
     return (cpi);
 }
 
@@ -43,10 +43,17 @@ constexpr int PIPE_READ = 0;
     #include <cstring>
     #include <set>
 #elif LINUX
+    #include "Framework/Memory/Memory.hpp"
     #include <fcntl.h>
     #include <cstring>
     #include <unistd.h>
     #include <wait.h>
+    // posix_spawn needs the chdir and closefrom file actions to match the fork based implementation
+    #if defined(__GLIBC__) && (__GLIBC__ > 2 || (__GLIBC__ == 2 && __GLIBC_MINOR__ >= 34))
+        #define BPF_PROCESS_SPAWN
+        #include <cerrno>
+        #include <spawn.h>
+    #endif
 #else
     #include <fcntl.h>
     #include <signal.h>
@@ -173,6 +180,20 @@ void Process::Builder::CleanupHandles(void *fdStdOut[2], void *fdStdErr[2], void
 
 #else
 
+static int CreatePipe(int fds[2])
+{
+    // Pipes are never inherited by an exec: the child ends are explicitly duplicated on the standard streams
+#ifdef LINUX
+    return (pipe2(fds, O_CLOEXEC));
+#else
+    if (pipe(fds) != 0)
+        return (-1);
+    fcntl(fds[0], F_SETFD, FD_CLOEXEC);
+    fcntl(fds[1], F_SETFD, FD_CLOEXEC);
+    return (0);
+#endif
+}
+
 void Process::Builder::CleanupHandles(int fdStdOut[2], int fdStdErr[2], int fdStdIn[2], int commonfd[2])
 {
     for (int i = 0; i != 2; ++i)
@@ -217,11 +238,12 @@ void Process::Builder::ProcessWorker(int fdStdOut[2], int fdStdErr[2], int fdStd
         close(commonfd[PIPE_WRITE]);
         exit(1);
     }
-    if (_redirectStdOut && dup2(fdStdOut[PIPE_WRITE], 1) == -1)
+    // dup2 on the same descriptor would leave it close-on-exec
+    if (_redirectStdOut && (fdStdOut[PIPE_WRITE] == 1 ? fcntl(1, F_SETFD, 0) : dup2(fdStdOut[PIPE_WRITE], 1)) == -1)
         goto redirecterr;
-    if (_redirectStdErr && dup2(fdStdErr[PIPE_WRITE], 2) == -1)
+    if (_redirectStdErr && (fdStdErr[PIPE_WRITE] == 2 ? fcntl(2, F_SETFD, 0) : dup2(fdStdErr[PIPE_WRITE], 2)) == -1)
         goto redirecterr;
-    if (_redirectStdIn && dup2(fdStdIn[PIPE_READ], 0) == -1)
+    if (_redirectStdIn && (fdStdIn[PIPE_READ] == 0 ? fcntl(0, F_SETFD, 0) : dup2(fdStdIn[PIPE_READ], 0)) == -1)
         goto redirecterr;
     BP_IGNORE(chdir(*_workDir.PlatformPath()))
     for (auto &a : _argv)
@@ -273,16 +295,26 @@ mallocerr:
     exit(1);
 }
 
-Process Process::Builder::ProcessMaster(int pid, int fdStdOut[2], int fdStdErr[2], int fdStdIn[2], int commonfd[2])
+void Process::Builder::CloseChildEnds(int fdStdOut[2], int fdStdErr[2], int fdStdIn[2])
 {
-    if (commonfd[PIPE_WRITE] != -1)
-        close(commonfd[PIPE_WRITE]);
     if (fdStdOut[PIPE_WRITE] != -1)
         close(fdStdOut[PIPE_WRITE]);
     if (fdStdErr[PIPE_WRITE] != -1)
         close(fdStdErr[PIPE_WRITE]);
     if (fdStdIn[PIPE_READ] != -1)
         close(fdStdIn[PIPE_READ]);
+    // Forget the child ends: the PipeStreams would otherwise close them a second time, possibly after the descriptor
+    // numbers have been reused
+    fdStdOut[PIPE_WRITE] = -1;
+    fdStdErr[PIPE_WRITE] = -1;
+    fdStdIn[PIPE_READ] = -1;
+}
+
+Process Process::Builder::ProcessMaster(int pid, int fdStdOut[2], int fdStdErr[2], int fdStdIn[2], int commonfd[2])
+{
+    if (commonfd[PIPE_WRITE] != -1)
+        close(commonfd[PIPE_WRITE]);
+    CloseChildEnds(fdStdOut, fdStdErr, fdStdIn);
 
     char buf[4096];
     auto len = read(commonfd[PIPE_READ], buf, 4096);
@@ -292,6 +324,81 @@ Process Process::Builder::ProcessMaster(int pid, int fdStdOut[2], int fdStdErr[2
     close(commonfd[PIPE_READ]);
     return (Process(pid, fdStdIn, fdStdOut, fdStdErr));
 }
+
+    #ifdef BPF_PROCESS_SPAWN
+Process Process::Builder::ProcessSpawn(int fdStdOut[2], int fdStdErr[2], int fdStdIn[2])
+{
+    // argv points directly into the argument strings, the environment is packed in a single block
+    fsize envSize = (_envp.Size() + 1) * sizeof(char *);
+    for (auto &kv : _envp)
+        envSize += kv.Key.Size() + kv.Value.Size() + 2;
+    auto **argv = static_cast<char **>(memory::Memory::Malloc((_argv.Size() + 1) * sizeof(char *)));
+    auto **envp = static_cast<char **>(memory::Memory::Malloc(envSize));
+    fsize i = 0;
+    for (auto &a : _argv)
+        argv[i++] = const_cast<char *>(*a);
+    argv[i] = nullptr;
+    i = 0;
+    auto *str = reinterpret_cast<char *>(envp + _envp.Size() + 1);
+    for (auto &kv : _envp)
+    {
+        envp[i++] = str;
+        std::memcpy(str, *kv.Key, kv.Key.Size());
+        str += kv.Key.Size();
+        *str++ = '=';
+        std::memcpy(str, *kv.Value, kv.Value.Size() + 1); // Copy with additional '\0'
+        str += kv.Value.Size() + 1;
+    }
+    envp[i] = nullptr;
+
+    posix_spawn_file_actions_t actions;
+    auto workDir = _workDir.PlatformPath();
+    int err = posix_spawn_file_actions_init(&actions);
+    // adddup2 on the same descriptor would leave it close-on-exec: clear the flag here instead
+    if (err == 0 && _redirectStdOut)
+    {
+        if (fdStdOut[PIPE_WRITE] == 1)
+            err = fcntl(1, F_SETFD, 0);
+        else
+            err = posix_spawn_file_actions_adddup2(&actions, fdStdOut[PIPE_WRITE], 1);
+    }
+    if (err == 0 && _redirectStdErr)
+    {
+        if (fdStdErr[PIPE_WRITE] == 2)
+            err = fcntl(2, F_SETFD, 0);
+        else
+            err = posix_spawn_file_actions_adddup2(&actions, fdStdErr[PIPE_WRITE], 2);
+    }
+    if (err == 0 && _redirectStdIn)
+    {
+        if (fdStdIn[PIPE_READ] == 0)
+            err = fcntl(0, F_SETFD, 0);
+        else
+            err = posix_spawn_file_actions_adddup2(&actions, fdStdIn[PIPE_READ], 0);
+    }
+    if (err == 0)
+        err = posix_spawn_file_actions_addchdir_np(&actions, *workDir);
+    if (err == 0)
+        err = posix_spawn_file_actions_addclosefrom_np(&actions, 3);
+    pid_t pid = -1;
+    if (err == 0)
+        err = posix_spawn(&pid, *_appExe, &actions, nullptr, argv, envp);
+    posix_spawn_file_actions_destroy(&actions);
+    memory::Memory::Free(argv);
+    memory::Memory::Free(envp);
+    if (err != 0)
+    {
+        int commonfd[2] = {-1, -1};
+        if (err == -1)
+            err = errno;
+        CleanupHandles(fdStdOut, fdStdErr, fdStdIn, commonfd);
+        errno = err;
+        throw OSException(String("Could not create process: ") + OSPrivate::ObtainLastErrorString());
+    }
+    CloseChildEnds(fdStdOut, fdStdErr, fdStdIn);
+    return (Process(pid, fdStdIn, fdStdOut, fdStdErr));
+}
+    #endif
 #endif
 
 Process Process::Builder::Build()
@@ -400,24 +507,30 @@ Process Process::Builder::Build()
     int fdStdOut[2] = {-1, -1};
     int fdStdIn[2] = {-1, -1};
     int fdStdErr[2] = {-1, -1};
-    int commonfd[2];
-    if (pipe(commonfd) != 0)
-        throw OSException("Could not create common pipe");
-    if (_redirectStdOut && pipe(fdStdOut) != 0)
+    int commonfd[2] = {-1, -1};
+    if (_redirectStdOut && CreatePipe(fdStdOut) != 0)
     {
         CleanupHandles(fdStdOut, fdStdErr, fdStdIn, commonfd);
         throw OSException("Could not create standard output redirection");
     }
-    if (_redirectStdErr && pipe(fdStdErr) != 0)
+    if (_redirectStdErr && CreatePipe(fdStdErr) != 0)
     {
         CleanupHandles(fdStdOut, fdStdErr, fdStdIn, commonfd);
         throw OSException("Could not create standard error redirection");
     }
-    if (_redirectStdIn && pipe(fdStdIn) != 0)
+    if (_redirectStdIn && CreatePipe(fdStdIn) != 0)
     {
         CleanupHandles(fdStdOut, fdStdErr, fdStdIn, commonfd);
         throw OSException("Could not create standard input redirection");
     }
+    #ifdef BPF_PROCESS_SPAWN
+    return (ProcessSpawn(fdStdOut, fdStdErr, fdStdIn));
+    #else
+    if (CreatePipe(commonfd) != 0)
+    {
+        CleanupHandles(fdStdOut, fdStdErr, fdStdIn, commonfd);
+        throw OSException("Could not create common pipe");
+    }
     auto pid = fork();
     if (pid == -1)
     {
@@ -432,6 +545,7 @@ Process Process::Builder::Build()
     }
     else // Master
         return (ProcessMaster(pid, fdStdOut, fdStdErr, fdStdIn, commonfd));
+    #endif
 #endif
 }
 
@@ -0,0 +1,694 @@
+// Copyright (c) 2020, BlockProject 3D
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without modification,
+// are permitted provided that the following conditions are met:
+// 
+//     * Redistributions of source code must retain the above copyright notice,
+//       this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above copyright notice,
+//       this list of conditions and the following disclaimer in the documentation
+//       and/or other materials provided with the distribution.
+//     * Neither the name of BlockProject 3D nor the names of its contributors
+//       may be used to endorse or promote products derived from this software
+//       without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include "Framework/System/ProcessSupervisor.hpp"
+#include "../IO/OSPrivate.hpp"
+#include "Framework/IO/DynamicByteBuf.hpp"
+#include "Framework/Memory/MemUtils.hpp"
+#include "Framework/Memory/Memory.hpp"
+#include "Framework/System/OSException.hpp"
+#ifndef WINDOWS
+    #include <cerrno>
+    #include <csignal>
+    #include <ctime>
+    #include <fcntl.h>
+    #include <sys/wait.h>
+    #include <unistd.h>
+    #ifdef LINUX
+        #include <sys/epoll.h>
+        #include <sys/syscall.h>
+    #else
+        #include <poll.h>
+    #endif
+#endif
+
+using namespace bpf::collection;
+using namespace bpf::memory;
+using namespace bpf::system;
+using namespace bpf;
+
+#ifdef WINDOWS
+namespace bpf
+{
+    namespace system
+    {
+        class ProcessReactor
+        {
+        };
+
+        struct SupervisedProcess
+        {
+        };
+    }
+}
+
+ProcessSupervisor::ProcessSupervisor(fsize bufferSize)
+    : _reactor(nullptr)
+    , _buffer(nullptr)
+    , _bufferSize(bufferSize)
+    , _nextId(0)
+    , _polled(0)
+{
+    throw OSException("ProcessSupervisor is not supported on Windows");
+}
+
+ProcessSupervisor::~ProcessSupervisor()
+{
+}
+
+uint64 ProcessSupervisor::Spawn(Process::Builder &, OutputCallback, ExitCallback)
+{
+    throw OSException("ProcessSupervisor is not supported on Windows");
+}
+
+uint64 ProcessSupervisor::Add(Process &&, OutputCallback, ExitCallback)
+{
+    throw OSException("ProcessSupervisor is not supported on Windows");
+}
+
+void ProcessSupervisor::Write(uint64, const void *, fsize)
+{
+    throw OSException("ProcessSupervisor is not supported on Windows");
+}
+
+void ProcessSupervisor::CloseInput(uint64)
+{
+    throw OSException("ProcessSupervisor is not supported on Windows");
+}
+
+void ProcessSupervisor::Kill(uint64, bool)
+{
+    throw OSException("ProcessSupervisor is not supported on Windows");
+}
+
+fsize ProcessSupervisor::Poll()
+{
+    throw OSException("ProcessSupervisor is not supported on Windows");
+}
+
+fsize ProcessSupervisor::Wait(int)
+{
+    throw OSException("ProcessSupervisor is not supported on Windows");
+}
+
+void ProcessSupervisor::WaitAll()
+{
+    throw OSException("ProcessSupervisor is not supported on Windows");
+}
+
+bool ProcessSupervisor::IsEventDriven() const noexcept
+{
+    return (false);
+}
+#else
+namespace _bpf_internal_supervisor
+{
+    constexpr int PIPE_WRITE = 1;
+    constexpr int PIPE_READ = 0;
+
+    // The low bits of an event token identify the descriptor of the process the event is about
+    constexpr uint64 TOKEN_OUTPUT = 0;
+    constexpr uint64 TOKEN_ERROR = 1;
+    constexpr uint64 TOKEN_INPUT = 2;
+    constexpr uint64 TOKEN_EXIT = 3;
+    constexpr uint64 TOKEN_BITS = 2;
+
+    // Interval in milliseconds at which waitpid is polled for processes without a pidfd
+    constexpr int POLL_INTERVAL = 10;
+
+    constexpr fsize MAX_EVENTS = 64;
+
+    int TakeDescriptor(int &fd)
+    {
+        int res = fd;
+        fd = -1;
+        if (res != -1)
+        {
+            fcntl(res, F_SETFD, FD_CLOEXEC);
+            fcntl(res, F_SETFL, fcntl(res, F_GETFL) | O_NONBLOCK);
+        }
+        return (res);
+    }
+
+    // Writes to a pipe without raising SIGPIPE if the reading end has been closed
+    ssize_t WriteNoSignal(int fd, const void *buf, fsize size)
+    {
+        sigset_t pipeSet;
+        sigset_t pending;
+        sigset_t old;
+        sigemptyset(&pipeSet);
+        sigaddset(&pipeSet, SIGPIPE);
+        sigpending(&pending);
+        bool alreadyPending = sigismember(&pending, SIGPIPE) == 1;
+        pthread_sigmask(SIG_BLOCK, &pipeSet, &old);
+        ssize_t res = write(fd, buf, size);
+        int err = errno;
+        if (res == -1 && err == EPIPE && !alreadyPending)
+        {
+#ifdef LINUX
+            struct timespec zero = {0, 0};
+            while (sigtimedwait(&pipeSet, nullptr, &zero) == -1 && errno == EINTR)
+                ;
+#else
+            int sig;
+            sigwait(&pipeSet, &sig);
+#endif
+        }
+        pthread_sigmask(SIG_SETMASK, &old, nullptr);
+        errno = err;
+        return (res);
+    }
+}
+
+using namespace _bpf_internal_supervisor;
+
+namespace bpf
+{
+    namespace system
+    {
+        struct SupervisedProcess
+        {
+            Process Proc;
+            ProcessSupervisor::OutputCallback OnOutput;
+            ProcessSupervisor::ExitCallback OnExit;
+            int Output;
+            int Error;
+            int Input;
+            int PidFd;
+            bool Writing;
+            bool CloseWhenFlushed;
+            bool Exited;
+            io::DynamicByteBuf Pending;
+
+            SupervisedProcess(Process &&proc, ProcessSupervisor::OutputCallback &&onOutput, ProcessSupervisor::ExitCallback &&onExit)
+                : Proc(std::move(proc))
+                , OnOutput(std::move(onOutput))
+                , OnExit(std::move(onExit))
+                , Output(-1)
+                , Error(-1)
+                , Input(-1)
+                , PidFd(-1)
+                , Writing(false)
+                , CloseWhenFlushed(false)
+                , Exited(false)
+            {
+            }
+        };
+
+#ifdef LINUX
+        class ProcessReactor
+        {
+        private:
+            int _epoll;
+            bool _pidfd;
+
+        public:
+            ProcessReactor()
+                : _epoll(epoll_create1(EPOLL_CLOEXEC))
+                , _pidfd(false)
+            {
+                if (_epoll == -1)
+                    throw OSException(String("Could not create epoll instance: ") + OSPrivate::ObtainLastErrorString());
+                int fd = OpenPidFd(getpid());
+                if (fd != -1)
+                {
+                    _pidfd = true;
+                    close(fd);
+                }
+            }
+
+            ~ProcessReactor()
+            {
+                close(_epoll);
+            }
+
+            static int OpenPidFd(int pid)
+            {
+    #ifdef SYS_pidfd_open
+                return (static_cast<int>(syscall(SYS_pidfd_open, pid, 0)));
+    #else
+                return (static_cast<int>(syscall(434, pid, 0)));
+    #endif
+            }
+
+            inline bool HasPidFd() const noexcept
+            {
+                return (_pidfd);
+            }
+
+            void Add(int fd, uint64 token, bool write)
+            {
+                struct epoll_event ev;
+                ev.events = write ? EPOLLOUT : EPOLLIN;
+                ev.data.u64 = token;
+                if (epoll_ctl(_epoll, EPOLL_CTL_ADD, fd, &ev) == -1)
+                    throw OSException(String("Could not watch process descriptor: ") + OSPrivate::ObtainLastErrorString());
+            }
+
+            void Remove(int fd)
+            {
+                struct epoll_event ev;
+                epoll_ctl(_epoll, EPOLL_CTL_DEL, fd, &ev);
+            }
+
+            fsize Wait(uint64 *tokens, int timeout)
+            {
+                struct epoll_event events[MAX_EVENTS];
+                int res = epoll_wait(_epoll, events, static_cast<int>(MAX_EVENTS), timeout);
+                if (res == -1)
+                {
+                    if (errno == EINTR)
+                        return (0);
+                    throw OSException(String("Could not wait for process events: ") + OSPrivate::ObtainLastErrorString());
+                }
+                for (int i = 0; i != res; ++i)
+                    tokens[i] = events[i].data.u64;
+                return (static_cast<fsize>(res));
+            }
+        };
+#else
+        class ProcessReactor
+        {
+        private:
+            ArrayList<struct pollfd> _fds;
+            ArrayList<uint64> _tokens;
+
+        public:
+            static int OpenPidFd(int)
+            {
+                return (-1);
+            }
+
+            inline bool HasPidFd() const noexcept
+            {
+                return (false);
+            }
+
+            void Add(int fd, uint64 token, bool write)
+            {
+                struct pollfd p;
+                p.fd = fd;
+                p.events = write ? POLLOUT : POLLIN;
+                p.revents = 0;
+                _fds.Add(p);
+                _tokens.Add(token);
+            }
+
+            void Remove(int fd)
+            {
+                for (fsize i = 0; i != _fds.Size(); ++i)
+                {
+                    if (_fds[i].fd == fd)
+                    {
+                        _fds[i] = _fds.Last();
+                        _tokens[i] = _tokens.Last();
+                        _fds.RemoveLast();
+                        _tokens.RemoveLast();
+                        return;
+                    }
+                }
+            }
+
+            fsize Wait(uint64 *tokens, int timeout)
+            {
+                if (_fds.Size() == 0)
+                {
+                    if (timeout != 0)
+                        ::poll(nullptr, 0, timeout);
+                    return (0);
+                }
+                if (::poll(&_fds[0], static_cast<nfds_t>(_fds.Size()), timeout) == -1)
+                {
+                    if (errno == EINTR)
+                        return (0);
+                    throw OSException(String("Could not wait for process events: ") + OSPrivate::ObtainLastErrorString());
+                }
+                fsize count = 0;
+                for (fsize i = 0; i != _fds.Size() && count != MAX_EVENTS; ++i)
+                {
+                    if (_fds[i].revents != 0)
+                        tokens[count++] = _tokens[i];
+                }
+                return (count);
+            }
+        };
+#endif
+    }
+}
+
+ProcessSupervisor::ProcessSupervisor(fsize bufferSize)
+    : _reactor(MemUtils::New<ProcessReactor>())
+    , _buffer(nullptr)
+    , _bufferSize(bufferSize > 0 ? bufferSize : 1)
+    , _nextId(0)
+    , _polled(0)
+{
+    _buffer = static_cast<uint8 *>(Memory::Malloc(_bufferSize));
+}
+
+ProcessSupervisor::~ProcessSupervisor()
+{
+    for (auto &entry : _children)
+    {
+        SupervisedProcess *child = entry.Value;
+        if (child->Proc._running)
+        {
+            kill(child->Proc._pid, SIGKILL);
+            while (waitpid(child->Proc._pid, nullptr, 0) == -1 && errno == EINTR)
+                ;
+            child->Proc._running = false;
+        }
+        Retire(child);
+    }
+    Memory::Free(_buffer);
+    MemUtils::Delete(_reactor);
+}
+
+bool ProcessSupervisor::IsEventDriven() const noexcept
+{
+    return (_reactor->HasPidFd());
+}
+
+uint64 ProcessSupervisor::Spawn(Process::Builder &builder, OutputCallback onOutput, ExitCallback onExit)
+{
+    return (Add(builder.Build(), std::move(onOutput), std::move(onExit)));
+}
+
+uint64 ProcessSupervisor::Add(Process &&process, OutputCallback onOutput, ExitCallback onExit)
+{
+    uint64 id = _nextId++;
+    auto *child = MemUtils::New<SupervisedProcess>(std::move(process), std::move(onOutput), std::move(onExit));
+    Process &proc = child->Proc;
+    child->Output = TakeDescriptor(proc._stdOut._pipfd[PIPE_READ]);
+    child->Error = TakeDescriptor(proc._stdErr._pipfd[PIPE_READ]);
+    child->Input = TakeDescriptor(proc._stdIn._pipfd[PIPE_WRITE]);
+    try
+    {
+        if (child->Output != -1)
+            _reactor->Add(child->Output, (id << TOKEN_BITS) | TOKEN_OUTPUT, false);
+        if (child->Error != -1)
+            _reactor->Add(child->Error, (id << TOKEN_BITS) | TOKEN_ERROR, false);
+        if (!proc._running)
+        {
+            child->Exited = true;
+            _exited.Add(id);
+        }
+        else
+        {
+            child->PidFd = ProcessReactor::OpenPidFd(proc._pid);
+            if (child->PidFd != -1)
+                _reactor->Add(child->PidFd, (id << TOKEN_BITS) | TOKEN_EXIT, false);
+            else
+                ++_polled;
+        }
+    }
+    catch (const OSException &)
+    {
+        Retire(child);
+        throw;
+    }
+    _children.Add(id, child);
+    return (id);
+}
+
+SupervisedProcess &ProcessSupervisor::Get(uint64 id)
+{
+    auto it = _children.FindByKey(id);
+    if (it == _children.end())
+        throw OSException(String("Unknown supervised process ") + String::ValueOf(id));
+    return (*it->Value);
+}
+
+void ProcessSupervisor::Write(uint64 id, const void *buf, fsize size)
+{
+    SupervisedProcess &child = Get(id);
+    if (child.Input == -1)
+        throw OSException("The target process does not allow standard input redirection");
+    if (child.CloseWhenFlushed)
+        throw OSException("The standard input of the target process is closed");
+    if (size == 0)
+        return;
+    const uint8 *data = static_cast<const uint8 *>(buf);
+    if (child.Pending.Size() == 0)
+    {
+        ssize_t res = WriteNoSignal(child.Input, data, size);
+        if (res == -1 && errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR)
+            return; // The process no longer reads its input: there is nobody to deliver the bytes to
+        if (res > 0)
+        {
+            data += res;
+            size -= static_cast<fsize>(res);
+        }
+        if (size == 0)
+            return;
+    }
+    child.Pending.Write(data, size);
+    if (!child.Writing)
+    {
+        _reactor->Add(child.Input, (id << TOKEN_BITS) | TOKEN_INPUT, true);
+        child.Writing = true;
+    }
+}
+
+void ProcessSupervisor::CloseInput(SupervisedProcess &child)
+{
+    if (child.Input == -1)
+        return;
+    if (child.Writing)
+        _reactor->Remove(child.Input);
+    close(child.Input);
+    child.Input = -1;
+    child.Writing = false;
+    child.Pending.Clear();
+}
+
+void ProcessSupervisor::CloseInput(uint64 id)
+{
+    SupervisedProcess &child = Get(id);
+    if (child.Pending.Size() == 0)
+        CloseInput(child);
+    else
+        child.CloseWhenFlushed = true;
+}
+
+void ProcessSupervisor::Flush(SupervisedProcess &child)
+{
+    while (child.Pending.Size() > 0)
+    {
+        io::ByteView view = child.Pending.Peek();
+        ssize_t res = WriteNoSignal(child.Input, *view, view.Size());
+        if (res == -1)
+        {
+            if (errno == EINTR)
+                continue;
+            if (errno == EAGAIN || errno == EWOULDBLOCK)
+                return;
+            CloseInput(child);
+            return;
+        }
+        child.Pending.Consume(static_cast<fsize>(res));
+    }
+    _reactor->Remove(child.Input);
+    child.Writing = false;
+    if (child.CloseWhenFlushed)
+        CloseInput(child);
+}
+
+void ProcessSupervisor::Kill(uint64 id, bool force)
+{
+    SupervisedProcess &child = Get(id);
+    if (child.Exited)
+        return;
+    if (kill(child.Proc._pid, force ? SIGKILL : SIGINT) == -1)
+        throw OSException("Could not terminate process");
+}
+
+void ProcessSupervisor::Read(uint64 id, SupervisedProcess &child, EProcessStream stream, bool drain)
+{
+    int &fd = stream == EProcessStream::STANDARD_OUTPUT ? child.Output : child.Error;
+
+    // Outside of drain mode a single read is issued so that one verbose process cannot starve the others
+    while (fd != -1)
+    {
+        ssize_t res = read(fd, _buffer, _bufferSize);
+        if (res > 0)
+        {
+            if (child.OnOutput)
+                child.OnOutput(id, stream, _buffer, static_cast<fsize>(res));
+            if (!drain)
+                return;
+            continue;
+        }
+        if (res == -1 && errno == EINTR)
+            continue;
+        if (res == -1 && (errno == EAGAIN || errno == EWOULDBLOCK))
+            return;
+        _reactor->Remove(fd);
+        close(fd);
+        fd = -1;
+    }
+}
+
+void ProcessSupervisor::Retire(SupervisedProcess *child)
+{
+    // A grandchild may still hold the output pipes: they must leave the reactor together with the record, otherwise
+    // their events keep waking the reactor for an id which no longer exists
+    int *fds[] = {&child->Output, &child->Error, &child->PidFd};
+    for (int *fd : fds)
+    {
+        if (*fd != -1)
+        {
+            _reactor->Remove(*fd);
+            close(*fd);
+            *fd = -1;
+        }
+    }
+    CloseInput(*child);
+    MemUtils::Delete(child);
+}
+
+void ProcessSupervisor::Reap(uint64 id, SupervisedProcess &child)
+{
+    int status;
+    int res;
+
+    while ((res = waitpid(child.Proc._pid, &status, WNOHANG)) == -1 && errno == EINTR)
+        ;
+    if (res == 0)
+        return;
+    if (res != -1)
+    {
+        child.Proc._crashed = WIFSIGNALED(status);
+        child.Proc._lastExitCode = WIFSIGNALED(status) ? WTERMSIG(status) : WEXITSTATUS(status);
+    }
+    child.Proc._running = false;
+    if (child.PidFd != -1)
+    {
+        _reactor->Remove(child.PidFd);
+        close(child.PidFd);
+        child.PidFd = -1;
+    }
+    else
+        --_polled;
+    child.Exited = true;
+    _exited.Add(id);
+}
+
+fsize ProcessSupervisor::Dispatch(int timeout)
+{
+    uint64 tokens[MAX_EVENTS];
+    fsize count = 0;
+
+    if (_exited.Size() == 0)
+    {
+        if (_polled > 0 && (timeout < 0 || timeout > POLL_INTERVAL))
+            timeout = POLL_INTERVAL;
+        fsize events = _reactor->Wait(tokens, timeout);
+        for (fsize i = 0; i != events; ++i)
+        {
+            uint64 id = tokens[i] >> TOKEN_BITS;
+            auto it = _children.FindByKey(id);
+            if (it == _children.end())
+                continue;
+            SupervisedProcess &child = *it->Value;
+            switch (tokens[i] & ((1 << TOKEN_BITS) - 1))
+            {
+            case TOKEN_OUTPUT:
+                Read(id, child, EProcessStream::STANDARD_OUTPUT, false);
+                break;
+            case TOKEN_ERROR:
+                Read(id, child, EProcessStream::STANDARD_ERROR, false);
+                break;
+            case TOKEN_INPUT:
+                if (child.Input != -1)
+                    Flush(child);
+                break;
+            default:
+                if (!child.Exited)
+                    Reap(id, child);
+                break;
+            }
+        }
+        if (_polled > 0)
+        {
+            for (auto &entry : _children)
+            {
+                if (!entry.Value->Exited && entry.Value->PidFd == -1)
+                    Reap(entry.Key, *entry.Value);
+            }
+        }
+    }
+    // Output written right before termination may still be in the pipes: deliver it before the exit callback
+    while (_exited.Size() > 0)
+    {
+        uint64 id = _exited.Last();
+        _exited.RemoveLast();
+        auto it = _children.FindByKey(id);
+        if (it == _children.end())
+            continue;
+        SupervisedProcess *child = it->Value;
+        _children.RemoveAt(id);
+        Read(id, *child, EProcessStream::STANDARD_OUTPUT, true);
+        Read(id, *child, EProcessStream::STANDARD_ERROR, true);
+        CloseInput(*child);
+        ++count;
+        try
+        {
+            if (child->OnExit)
+                child->OnExit(id, child->Proc);
+        }
+        catch (...)
+        {
+            Retire(child);
+            throw;
+        }
+        Retire(child);
+    }
+    return (count);
+}
+
+fsize ProcessSupervisor::Poll()
+{
+    if (_children.Size() == 0)
+        return (0);
+    return (Dispatch(0));
+}
+
+fsize ProcessSupervisor::Wait(int timeout)
+{
+    if (_children.Size() == 0)
+        return (0);
+    return (Dispatch(timeout));
+}
+
+void ProcessSupervisor::WaitAll()
+{
+    while (_children.Size() > 0)
+        Dispatch(-1);
+}
+#endif
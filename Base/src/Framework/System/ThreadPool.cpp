@@ -38,14 +38,28 @@ class ThreadRuntime final : public Thread
 {
 private:
     ThreadPool *_pool;
+    bool _active; // Protected by the input mutex of the pool
 
 public:
     explicit ThreadRuntime(const String &name, ThreadPool *pool)
         : Thread(name)
         , _pool(pool)
+        , _active(false)
     {
     }
 
+    /**
+     * Starts this thread if it has stopped or is about to stop; must be called with the input mutex locked
+     */
+    void Wake()
+    {
+        if (_active)
+            return;
+        _active = true;
+        Join();
+        Start();
+    }
+
     void ReLink(ThreadPool *newpool)
     {
         _pool = newpool;
@@ -53,11 +67,16 @@ public:
 
     void Run() final
     {
-        while (_pool->_sharedInputQueue.Size() > 0)
+        while (true)
         {
             ThreadPool::Task task;
             {
                 auto lock = ScopeLock(_pool->_inputMutex);
+                if (_pool->_sharedInputQueue.Size() == 0)
+                {
+                    _active = false;
+                    return;
+                }
                 task = _pool->_sharedInputQueue.Pop();
             }
             if (task.Processing1)
@@ -68,6 +87,7 @@ public:
                 {
                     auto lock = ScopeLock(_pool->_outputMutex);
                     _pool->_sharedOutputQueue.Push(std::move(task));
+                    _pool->_completed.Broadcast();
                 }
             }
         }
@@ -94,6 +114,7 @@ ThreadPool::ThreadPool(ThreadPool &&other) noexcept
     , _sharedInputQueue(std::move(other._sharedInputQueue))
     , _outputMutex(std::move(other._outputMutex))
     , _sharedOutputQueue(std::move(other._sharedOutputQueue))
+    , _completed(std::move(other._completed))
     , _threads(other._threads)
 {
     other._threads = nullptr;
@@ -122,6 +143,7 @@ ThreadPool &ThreadPool::operator=(ThreadPool &&other) noexcept
     _sharedInputQueue = std::move(other._sharedInputQueue);
     _outputMutex = std::move(other._outputMutex);
     _sharedOutputQueue = std::move(other._sharedOutputQueue);
+    _completed = std::move(other._completed);
     _threads = other._threads;
     other._threads = nullptr;
     other._tcount = 0;
@@ -134,7 +156,7 @@ ThreadPool &ThreadPool::operator=(ThreadPool &&other) noexcept
     return (*this);
 }
 
-void ThreadPool::Run(std::function<Dynamic()> processing, std::function<void(Dynamic &)> callback)
+void ThreadPool::Run(Function<Dynamic()> processing, Function<void(Dynamic &)> callback)
 {
     if (!processing || !callback)
         throw OSException("Invalid argument in call to Run");
@@ -142,32 +164,56 @@ void ThreadPool::Run(std::function<Dynamic()> processing, std::function<void(Dyn
     Task t;
     t.Callback = std::move(callback);
     t.Processing = std::move(processing);
-    {
-        auto lock = ScopeLock(_inputMutex);
-        _sharedInputQueue.Push(std::move(t));
-    }
+    auto lock = ScopeLock(_inputMutex);
+    _sharedInputQueue.Push(std::move(t));
     for (fsize i = 0; i != _tcount; ++i)
-    {
-        if (!_threads[i].IsRunning())
-            _threads[i].Start();
-    }
+        _threads[i].Wake();
 }
 
-void ThreadPool::Run(std::function<void()> processing)
+void ThreadPool::Run(Function<void()> processing)
 {
     if (!processing)
         throw OSException("Invalid argument in call to Run");
     Task t;
     t.Processing1 = std::move(processing);
+    auto lock = ScopeLock(_inputMutex);
+    _sharedInputQueue.Push(std::move(t));
+    for (fsize i = 0; i != _tcount; ++i)
+        _threads[i].Wake();
+}
+
+void ThreadPool::ParallelFor(fsize count, const Function<void(fsize, fsize)> &func, fsize grain)
+{
+    if (grain == 0)
+        grain = 1;
+    fsize parts = (count + grain - 1) / grain;
+    if (parts > _tcount + 1)
+        parts = _tcount + 1;
+    if (parts <= 1)
     {
-        auto lock = ScopeLock(_inputMutex);
-        _sharedInputQueue.Push(std::move(t));
+        if (count > 0)
+            func(0, count);
+        return;
     }
-    for (fsize i = 0; i != _tcount; ++i)
+    fsize size = count / parts;
+    fsize done = 0;
+    const auto *f = &func;
+    auto *d = &done;
+    // Part 0 runs on the calling thread, the last part takes the remainder
+    for (fsize i = 1; i != parts; ++i)
     {
-        if (!_threads[i].IsRunning())
-            _threads[i].Start();
+        fsize start = i * size;
+        fsize end = i == parts - 1 ? count : start + size;
+        Run(
+            [f, start, end]() {
+                (*f)(start, end);
+                return (Dynamic());
+            },
+            [d](Dynamic &) { ++*d; });
     }
+    func(0, size);
+    while (done != parts - 1)
+        Wait();
 }
 
 void ThreadPool::Poll()
@@ -185,3 +231,15 @@ void ThreadPool::Poll()
         --_tasks;
     }
 }
+
+void ThreadPool::Wait()
+{
+    if (IsIdle())
+        return;
+    {
+        auto lock = ScopeLock(_outputMutex);
+        while (_sharedOutputQueue.Size() == 0)
+            _completed.Wait(_outputMutex);
+    }
+    Poll();
+}
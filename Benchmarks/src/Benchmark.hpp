@@ -0,0 +1,102 @@
+// Copyright (c) 2020, BlockProject 3D
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without modification,
+// are permitted provided that the following conditions are met:
+// 
+//     * Redistributions of source code must retain the above copyright notice,
+//       this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above copyright notice,
+//       this list of conditions and the following disclaimer in the documentation
+//       and/or other materials provided with the distribution.
+//     * Neither the name of BlockProject 3D nor the names of its contributors
+//       may be used to endorse or promote products derived from this software
+//       without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#pragma once
+#include <Framework/Collection/Array.hpp>
+#include <Framework/IO/Console.hpp>
+#include <Framework/String.hpp>
+#include <Framework/System/Timer.hpp>
+#include <functional>
+
+namespace benchmarks
+{
+    /**
+     * Runs a function several times
+     * @param func the function to measure
+     * @param runs the number of runs
+     * @return time in seconds of the fastest run
+     */
+    inline double Measure(const std::function<void()> &func, const bpf::fsize runs = 3)
+    {
+        double best = -1;
+        for (bpf::fsize i = 0; i != runs; ++i)
+        {
+            bpf::system::Timer timer;
+            func();
+            double time = timer.Reset();
+            if (best < 0 || time < best)
+                best = time;
+        }
+        return (best);
+    }
+
+    /**
+     * Returns a throughput in MB/s
+     * @param bytes the number of bytes processed
+     * @param seconds the time taken
+     * @return formatted throughput
+     */
+    inline bpf::String Throughput(const bpf::uint64 bytes, const double seconds)
+    {
+        if (seconds <= 0)
+            return ("inf MB/s");
+        return (bpf::String::ValueOf(static_cast<double>(bytes) / (1024.0 * 1024.0) / seconds, 1) + " MB/s");
+    }
+
+    /**
+     * Compression codecs ratio and speed
+     * @param args optional path to a corpus file
+     */
+    void Compression(const bpf::collection::Array<bpf::String> &args);
+
+    /**
+     * Dense matrix product GFLOPS at several sizes
+     */
+    void Matrix(const bpf::collection::Array<bpf::String> &args);
+
+    /**
+     * AVL Map against BTreeMap insert, lookup and iteration speed
+     */
+    void OrderedMap(const bpf::collection::Array<bpf::String> &args);
+
+    /**
+     * Integer and double text conversions of NumberConvert against stringstream and strtoll/strtod
+     */
+    void Numbers(const bpf::collection::Array<bpf::String> &args);
+
+    /**
+     * Binary heap against 4-ary heap PriorityQueue push and pop speed
+     */
+    void PriorityQueue(const bpf::collection::Array<bpf::String> &args);
+
+    /**
+     * Process spawn latency of Process::Builder against fork and execve, with a small and a large parent heap
+     * @param args optional resident size of the parent in MB
+     */
+    void Spawn(const bpf::collection::Array<bpf::String> &args);
+}
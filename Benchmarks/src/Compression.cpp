@@ -0,0 +1,131 @@
+// Copyright (c) 2020, BlockProject 3D
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without modification,
+// are permitted provided that the following conditions are met:
+// 
+//     * Redistributions of source code must retain the above copyright notice,
+//       this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above copyright notice,
+//       this list of conditions and the following disclaimer in the documentation
+//       and/or other materials provided with the distribution.
+//     * Neither the name of BlockProject 3D nor the names of its contributors
+//       may be used to endorse or promote products derived from this software
+//       without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include "Benchmark.hpp"
+#include <Framework/Compression/Compressor.hpp>
+#include <Framework/IO/ByteBuf.hpp>
+#include <Framework/IO/FileStream.hpp>
+#include <cstring>
+
+using namespace bpf::compression;
+using namespace bpf::collection;
+using namespace bpf::io;
+using namespace bpf;
+
+constexpr fsize BLOCK_SIZE = 256 * 1024;
+constexpr fsize CORPUS_SIZE = 8 * 1024 * 1024;
+
+static ByteBuf LoadCorpus(const File &file)
+{
+    FileStream stream(file, FILE_MODE_READ);
+    ByteBuf buf(static_cast<fsize>(file.GetSizeBytes()));
+    while (buf.GetWrittenBytes() < buf.Size())
+    {
+        fsize len = stream.Read(*buf + buf.GetWrittenBytes(), buf.Size() - buf.GetWrittenBytes());
+        if (len == 0)
+            break;
+        buf.Seek(buf.GetWrittenBytes() + len);
+    }
+    return (buf);
+}
+
+/**
+ * Half text, a quarter of structured binary records and a quarter of random bytes
+ */
+static ByteBuf GenerateCorpus()
+{
+    ByteBuf buf(CORPUS_SIZE);
+    const char *words[] = {"the ", "asset ", "mesh ", "texture ", "shader ", "level ", "player ", "0.5, ", "\n"};
+    uint32 seed = 42;
+    auto next = [&seed]() {
+        seed = seed * 1103515245 + 12345;
+        return (seed >> 8);
+    };
+    while (buf.GetWrittenBytes() < CORPUS_SIZE / 2)
+    {
+        const char *word = words[next() % 9];
+        buf.Write(word, std::strlen(word));
+    }
+    for (uint32 i = 0; buf.GetWrittenBytes() + 16 <= CORPUS_SIZE * 3 / 4; ++i)
+    {
+        uint32 record[4] = {i, i * 3, next() % 16, 0xFFFF};
+        buf.Write(record, sizeof(record));
+    }
+    while (buf.GetWrittenBytes() < CORPUS_SIZE)
+    {
+        auto b = static_cast<uint8>(next());
+        buf.Write(&b, 1);
+    }
+    return (buf);
+}
+
+static void Run(const ByteBuf &corpus, const ECompressionCodec codec, const ECompressionLevel level, const char *levelName)
+{
+    auto compressor = Compressor::Create(codec, level);
+    fsize size = corpus.GetWrittenBytes();
+    fsize blocks = (size + BLOCK_SIZE - 1) / BLOCK_SIZE;
+    fsize bound = compressor->GetBound(BLOCK_SIZE);
+    ByteBuf compressed(blocks * bound);
+    ByteBuf out(BLOCK_SIZE);
+    Array<fsize> sizes(blocks);
+    fsize total = 0;
+    double compress = benchmarks::Measure([&]() {
+        total = 0;
+        for (fsize i = 0; i != blocks; ++i)
+        {
+            fsize len = size - i * BLOCK_SIZE < BLOCK_SIZE ? size - i * BLOCK_SIZE : BLOCK_SIZE;
+            sizes[i] = compressor->Compress(*corpus + i * BLOCK_SIZE, len, *compressed + i * bound, bound);
+            total += sizes[i];
+        }
+    });
+    double decompress = benchmarks::Measure([&]() {
+        for (fsize i = 0; i != blocks; ++i)
+            compressor->Decompress(*compressed + i * bound, sizes[i], *out, BLOCK_SIZE);
+    });
+    io::Console::WriteLine(Compressor::GetName(codec) + " " + levelName + ": ratio "
+                           + String::ValueOf(static_cast<double>(size) / static_cast<double>(total), 2)
+                           + ", compress " + benchmarks::Throughput(size, compress)
+                           + ", decompress " + benchmarks::Throughput(size, decompress));
+}
+
+void benchmarks::Compression(const Array<String> &args)
+{
+    ByteBuf corpus = args.Size() > 2 ? LoadCorpus(File(args[2])) : GenerateCorpus();
+    io::Console::WriteLine(String("Corpus: ") + String::ValueOf(corpus.GetWrittenBytes()) + " bytes");
+    for (auto codec : {ECompressionCodec::ZLIB, ECompressionCodec::LZ4, ECompressionCodec::ZSTD})
+    {
+        if (!Compressor::IsAvailable(codec))
+        {
+            io::Console::WriteLine(Compressor::GetName(codec) + ": not available");
+            continue;
+        }
+        Run(corpus, codec, ECompressionLevel::LOW, "LOW");
+        Run(corpus, codec, ECompressionLevel::DEFAULT, "DEFAULT");
+        Run(corpus, codec, ECompressionLevel::HIGH, "HIGH");
+    }
+}
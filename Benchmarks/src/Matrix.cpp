@@ -0,0 +1,105 @@
+// Copyright (c) 2020, BlockProject 3D
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without modification,
+// are permitted provided that the following conditions are met:
+// 
+//     * Redistributions of source code must retain the above copyright notice,
+//       this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above copyright notice,
+//       this list of conditions and the following disclaimer in the documentation
+//       and/or other materials provided with the distribution.
+//     * Neither the name of BlockProject 3D nor the names of its contributors
+//       may be used to endorse or promote products derived from this software
+//       without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include "Benchmark.hpp"
+#include <Framework/Math/Matrix.hpp>
+#include <Framework/System/Platform.hpp>
+#include <Framework/System/ThreadPool.hpp>
+
+using namespace bpf::collection;
+using namespace bpf::math;
+using namespace bpf::io;
+using namespace bpf;
+
+static Matrix<float> GenerateMatrix(const fsize n, const uint32 seed)
+{
+    Matrix<float> mat(n, n);
+    uint32 state = seed;
+
+    for (fsize i = 0; i != n * n; ++i)
+    {
+        state = state * 1103515245 + 12345;
+        (*mat)[i] = static_cast<float>((state >> 8) % 1000) / 500.0f - 1.0f;
+    }
+    return (mat);
+}
+
+/**
+ * Reference i-j-k product, the loop order used before the GEMM engine
+ */
+static void NaiveMultiply(const Matrix<float> &a, const Matrix<float> &b, Matrix<float> &c)
+{
+    fsize n = a.Rows();
+
+    for (fsize i = 0; i != n; ++i)
+    {
+        for (fsize j = 0; j != n; ++j)
+        {
+            float res = 0;
+            for (fsize k = 0; k != n; ++k)
+                res += (*a)[i * n + k] * (*b)[k * n + j];
+            (*c)[i * n + j] = res;
+        }
+    }
+}
+
+static String Gflops(const fsize n, const double seconds)
+{
+    if (seconds <= 0)
+        return ("inf GFLOPS");
+    double flops = 2.0 * static_cast<double>(n) * static_cast<double>(n) * static_cast<double>(n);
+    return (String::ValueOf(flops / seconds / 1e9, 2) + " GFLOPS");
+}
+
+namespace benchmarks
+{
+    void Matrix(const Array<String> &)
+    {
+        const fsize sizes[] = {64, 128, 256, 512, 1024};
+        fsize threads = system::Platform::GetCPUInfo().NumPhysicalCores;
+        system::ThreadPool pool(threads > 1 ? threads - 1 : 1, "GEMM");
+
+        Console::WriteLine(String("Single precision square products, ") + String::ValueOf(threads) + " thread(s) for the parallel run");
+        for (auto n : sizes)
+        {
+            auto a = GenerateMatrix(n, 1);
+            auto b = GenerateMatrix(n, 2);
+            bpf::math::Matrix<float> c(n, n);
+            String line = String("n=") + String::ValueOf(n) + ": ";
+            if (n <= 512)
+            {
+                double naive = Measure([&]() { NaiveMultiply(a, b, c); }, n <= 256 ? 3 : 1);
+                line += String("naive ") + Gflops(n, naive) + ", ";
+            }
+            double blocked = Measure([&]() { c = a * b; });
+            double parallel = Measure([&]() { c = bpf::math::Matrix<float>::Multiply(pool, a, b); });
+            line += String("blocked ") + Gflops(n, blocked) + ", parallel " + Gflops(n, parallel);
+            Console::WriteLine(line);
+        }
+    }
+}
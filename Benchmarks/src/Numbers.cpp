@@ -0,0 +1,187 @@
+// Copyright (c) 2020, BlockProject 3D
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without modification,
+// are permitted provided that the following conditions are met:
+// 
+//     * Redistributions of source code must retain the above copyright notice,
+//       this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above copyright notice,
+//       this list of conditions and the following disclaimer in the documentation
+//       and/or other materials provided with the distribution.
+//     * Neither the name of BlockProject 3D nor the names of its contributors
+//       may be used to endorse or promote products derived from this software
+//       without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include "Benchmark.hpp"
+#include <Framework/NumberConvert.hpp>
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+#include <sstream>
+
+using namespace bpf::collection;
+using namespace bpf::io;
+using namespace bpf;
+
+static String Rate(const fsize count, const double seconds)
+{
+    if (seconds <= 0)
+        return ("inf M/s");
+    return (String::ValueOf(static_cast<double>(count) / seconds / 1e6, 2) + " M/s");
+}
+
+static void Report(const char *name, const fsize count, const double legacy, const double current, const uint64 checksum)
+{
+    Console::WriteLine(String(name) + ": stringstream/strto* " + Rate(count, legacy) + ", NumberConvert "
+                       + Rate(count, current) + " (checksum " + String::ValueOf(checksum % 1000) + ")");
+}
+
+/**
+ * Text buffer holding one number per line, as read from a CSV column
+ */
+struct Column
+{
+    Array<char> Text;
+    Array<fsize> Offsets;
+    Array<fsize> Lengths;
+};
+
+template <typename T>
+static Column MakeColumn(const Array<T> &values)
+{
+    Column column;
+    column.Text = Array<char>(values.Size() * NumberConvert::MAX_CHARS);
+    column.Offsets = Array<fsize>(values.Size());
+    column.Lengths = Array<fsize>(values.Size());
+    fsize pos = 0;
+    for (fsize i = 0; i != values.Size(); ++i)
+    {
+        column.Offsets[i] = pos;
+        column.Lengths[i] = NumberConvert::Format(values[i], *column.Text + pos);
+        pos += column.Lengths[i];
+        column.Text[pos++] = '\0';
+    }
+    return (column);
+}
+
+static void Integers(const Array<int64> &values)
+{
+    uint64 sum = 0;
+    Column column = MakeColumn(values);
+
+    double legacy = benchmarks::Measure([&]() {
+        for (auto v : values)
+        {
+            std::stringstream strs;
+            strs << v;
+            sum += strs.str().size();
+        }
+    });
+    double current = benchmarks::Measure([&]() {
+        char buffer[NumberConvert::MAX_CHARS];
+        for (auto v : values)
+            sum += NumberConvert::Format(v, buffer);
+    });
+    Report("int64 format", values.Size(), legacy, current, sum);
+    legacy = benchmarks::Measure([&]() {
+        for (fsize i = 0; i != values.Size(); ++i)
+        {
+            errno = 0;
+            char *end;
+            sum += static_cast<uint64>(std::strtoll(*column.Text + column.Offsets[i], &end, 0));
+        }
+    });
+    current = benchmarks::Measure([&]() {
+        for (fsize i = 0; i != values.Size(); ++i)
+        {
+            int64 v = 0;
+            NumberConvert::Parse(*column.Text + column.Offsets[i], column.Lengths[i], v);
+            sum += static_cast<uint64>(v);
+        }
+    });
+    Report("int64 parse", values.Size(), legacy, current, sum);
+}
+
+static void Doubles(const Array<double> &values)
+{
+    uint64 sum = 0;
+    Column column = MakeColumn(values);
+
+    double legacy = benchmarks::Measure([&]() {
+        for (auto v : values)
+        {
+            std::stringstream strs;
+            strs.precision(17);
+            strs << v;
+            sum += strs.str().size();
+        }
+    });
+    double current = benchmarks::Measure([&]() {
+        char buffer[NumberConvert::MAX_CHARS];
+        for (auto v : values)
+            sum += NumberConvert::Format(v, buffer);
+    });
+    Report("double format", values.Size(), legacy, current, sum);
+    legacy = benchmarks::Measure([&]() {
+        for (fsize i = 0; i != values.Size(); ++i)
+        {
+            errno = 0;
+            char *end;
+            double d = std::strtod(*column.Text + column.Offsets[i], &end);
+            uint64 bits;
+            std::memcpy(&bits, &d, sizeof(double));
+            sum += bits;
+        }
+    });
+    current = benchmarks::Measure([&]() {
+        for (fsize i = 0; i != values.Size(); ++i)
+        {
+            double d = 0;
+            NumberConvert::Parse(*column.Text + column.Offsets[i], column.Lengths[i], d);
+            uint64 bits;
+            std::memcpy(&bits, &d, sizeof(double));
+            sum += bits;
+        }
+    });
+    Report("double parse", values.Size(), legacy, current, sum);
+}
+
+namespace benchmarks
+{
+    void Numbers(const Array<String> &)
+    {
+        constexpr fsize count = 1000000;
+        Array<int64> integers(count);
+        Array<double> doubles(count);
+        Array<double> prices(count);
+        uint64 state = 0x9E3779B97F4A7C15;
+
+        for (fsize i = 0; i != count; ++i)
+        {
+            state = state * 6364136223846793005 + 1442695040888963407;
+            integers[i] = static_cast<int64>(state) >> (state % 48);
+            doubles[i] = static_cast<double>(state >> 11) / static_cast<double>(1ULL << 53) * 1e6;
+            prices[i] = static_cast<double>(state % 10000000) / 100.0;
+        }
+        Console::WriteLine(String::ValueOf(count) + " values per run; stringstream uses 17 digits for doubles");
+        Integers(integers);
+        Console::WriteLine("Random doubles in [0, 1e6):");
+        Doubles(doubles);
+        Console::WriteLine("Two decimal prices:");
+        Doubles(prices);
+    }
+}
@@ -0,0 +1,99 @@
+// Copyright (c) 2020, BlockProject 3D
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without modification,
+// are permitted provided that the following conditions are met:
+// 
+//     * Redistributions of source code must retain the above copyright notice,
+//       this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above copyright notice,
+//       this list of conditions and the following disclaimer in the documentation
+//       and/or other materials provided with the distribution.
+//     * Neither the name of BlockProject 3D nor the names of its contributors
+//       may be used to endorse or promote products derived from this software
+//       without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include "Benchmark.hpp"
+#include <Framework/Collection/ArrayList.hpp>
+#include <Framework/Collection/BTreeMap.hpp>
+#include <Framework/Collection/Map.hpp>
+
+using namespace bpf::collection;
+using namespace bpf::io;
+using namespace bpf;
+
+static String Rate(const fsize count, const double seconds)
+{
+    if (seconds <= 0)
+        return ("inf Mops/s");
+    return (String::ValueOf(static_cast<double>(count) / seconds / 1e6, 2) + " Mops/s");
+}
+
+template <typename MapType>
+static void RunMap(const char *name, const Array<uint32> &keys, const std::function<void(MapType &)> &fill)
+{
+    MapType map;
+    uint64 sum = 0;
+
+    double insert = benchmarks::Measure([&]() {
+        map.Clear();
+        fill(map);
+    }, 1);
+    double lookup = benchmarks::Measure([&]() {
+        for (auto key : keys)
+            sum += map[key];
+    });
+    double iterate = benchmarks::Measure([&]() {
+        for (auto &entry : map)
+            sum += entry.Value;
+    });
+    Console::WriteLine(String(name) + ": insert " + Rate(keys.Size(), insert) + ", lookup " + Rate(keys.Size(), lookup)
+                       + ", iterate " + Rate(keys.Size(), iterate) + " (checksum " + String::ValueOf(sum % 1000) + ")");
+}
+
+namespace benchmarks
+{
+    void OrderedMap(const Array<String> &)
+    {
+        constexpr fsize count = 1000000;
+        Array<uint32> keys(count);
+
+        // Multiplying by an odd constant is a bijection on uint32: distinct keys in random order
+        for (fsize i = 0; i != count; ++i)
+            keys[i] = static_cast<uint32>(i) * 2654435761u;
+        // Lookups use another order than insertions so that allocation order does not favor node based maps
+        Array<uint32> lookups(count);
+        for (fsize i = 0; i != count; ++i)
+            lookups[i] = keys[i * 7919 % count];
+        Console::WriteLine(String::ValueOf(count) + " random uint32 keys");
+        RunMap<Map<uint32, uint32>>("Map", lookups, [&](Map<uint32, uint32> &map) {
+            for (auto key : keys)
+                map.Add(key, key);
+        });
+        RunMap<BTreeMap<uint32, uint32>>("BTreeMap", lookups, [&](BTreeMap<uint32, uint32> &map) {
+            for (auto key : keys)
+                map.Add(key, key);
+        });
+        ArrayList<BTreeMap<uint32, uint32>::Entry> sorted(count);
+        for (fsize i = 0; i != count; ++i)
+            sorted.Add({static_cast<uint32>(i) * 4096u, static_cast<uint32>(i)});
+        Array<uint32> sortedKeys(count);
+        for (fsize i = 0; i != count; ++i)
+            sortedKeys[i] = lookups[i] % count * 4096u;
+        RunMap<BTreeMap<uint32, uint32>>("BTreeMap bulk load", sortedKeys,
+                                          [&](BTreeMap<uint32, uint32> &map) { map.BulkLoad(&sorted[0], count); });
+    }
+}
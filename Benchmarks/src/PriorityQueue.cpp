@@ -0,0 +1,159 @@
+// Copyright (c) 2020, BlockProject 3D
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without modification,
+// are permitted provided that the following conditions are met:
+// 
+//     * Redistributions of source code must retain the above copyright notice,
+//       this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above copyright notice,
+//       this list of conditions and the following disclaimer in the documentation
+//       and/or other materials provided with the distribution.
+//     * Neither the name of BlockProject 3D nor the names of its contributors
+//       may be used to endorse or promote products derived from this software
+//       without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include "Benchmark.hpp"
+#include <Framework/Collection/PriorityQueue.hpp>
+
+using namespace bpf::collection;
+using namespace bpf::io;
+using namespace bpf;
+
+/**
+ * The binary heap PriorityQueue used before the 4-ary heap, kept as a reference: keys and values in two
+ * separate 1-based arrays
+ */
+template <typename K, typename V, template <typename> class HeapFunc>
+class BinaryHeap
+{
+private:
+    fsize _count;
+    Array<K> _keys;
+    Array<V> _values;
+
+    void Swap(fsize a, fsize b)
+    {
+        K key = std::move(_keys[a]);
+        V value = std::move(_values[a]);
+        _keys[a] = std::move(_keys[b]);
+        _values[a] = std::move(_values[b]);
+        _keys[b] = std::move(key);
+        _values[b] = std::move(value);
+    }
+
+public:
+    BinaryHeap()
+        : _count(0)
+        , _keys(8)
+        , _values(8)
+    {
+    }
+
+    void Push(const K &key, const V &value)
+    {
+        if (_count + 1 >= _keys.Size())
+        {
+            _keys.Resize(_keys.Size() * 2);
+            _values.Resize(_values.Size() * 2);
+        }
+        fsize i = ++_count;
+        _keys[i] = key;
+        _values[i] = value;
+        while (i > 1 && HeapFunc<K>::Eval(_keys[i], _keys[i / 2]))
+        {
+            Swap(i, i / 2);
+            i /= 2;
+        }
+    }
+
+    V Pop()
+    {
+        V v = std::move(_values[1]);
+        _keys[1] = std::move(_keys[_count]);
+        _values[1] = std::move(_values[_count]);
+        --_count;
+        fsize i = 1;
+        while (i * 2 <= _count)
+        {
+            fsize k = i * 2;
+            if (k + 1 <= _count && HeapFunc<K>::Eval(_keys[k + 1], _keys[k]))
+                ++k;
+            if (!HeapFunc<K>::Eval(_keys[k], _keys[i]))
+                break;
+            Swap(i, k);
+            i = k;
+        }
+        return (v);
+    }
+
+    fsize Size() const
+    {
+        return (_count);
+    }
+};
+
+static String Rate(const fsize count, const double seconds)
+{
+    if (seconds <= 0)
+        return ("inf Mops/s");
+    return (String::ValueOf(static_cast<double>(count) / seconds / 1e6, 2) + " Mops/s");
+}
+
+template <typename QueueType>
+static void RunQueue(const char *name, const Array<uint32> &keys)
+{
+    uint64 sum = 0;
+
+    double fill = benchmarks::Measure([&]() {
+        QueueType queue;
+        for (auto key : keys)
+            queue.Push(key, key);
+        while (queue.Size() > 0)
+            sum += queue.Pop();
+    });
+    // Steady state of a timer queue: every pop is followed by a push of a later deadline
+    constexpr fsize live = 10000;
+    double steady = benchmarks::Measure([&]() {
+        QueueType queue;
+        for (fsize i = 0; i != live; ++i)
+            queue.Push(keys[i], keys[i]);
+        for (fsize i = live; i != keys.Size(); ++i)
+        {
+            uint32 top = queue.Pop();
+            sum += top;
+            queue.Push(top + keys[i] % 65536, keys[i]);
+        }
+    });
+    Console::WriteLine(String(name) + ": push+pop " + Rate(keys.Size() * 2, fill) + ", steady " + Rate((keys.Size() - live) * 2, steady)
+                       + " (checksum " + String::ValueOf(sum % 1000) + ")");
+}
+
+namespace benchmarks
+{
+    void PriorityQueue(const Array<String> &)
+    {
+        constexpr fsize count = 1000000;
+        Array<uint32> keys(count);
+
+        for (fsize i = 0; i != count; ++i)
+            keys[i] = static_cast<uint32>(i) * 2654435761u;
+        Console::WriteLine(String::ValueOf(count) + " random uint32 keys, min heap");
+        RunQueue<BinaryHeap<uint32, uint32, MinHeap>>("Binary heap", keys);
+        RunQueue<bpf::collection::PriorityQueue<uint32, uint32, MinHeap>>("4-ary heap", keys);
+        RunQueue<bpf::collection::PriorityQueue<uint32, uint32, MinHeap, true>>("4-ary indexed heap", keys);
+    }
+}
@@ -0,0 +1,124 @@
+// Copyright (c) 2020, BlockProject 3D
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without modification,
+// are permitted provided that the following conditions are met:
+// 
+//     * Redistributions of source code must retain the above copyright notice,
+//       this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above copyright notice,
+//       this list of conditions and the following disclaimer in the documentation
+//       and/or other materials provided with the distribution.
+//     * Neither the name of BlockProject 3D nor the names of its contributors
+//       may be used to endorse or promote products derived from this software
+//       without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include "Benchmark.hpp"
+#include <Framework/Memory/Memory.hpp>
+#include <Framework/Scalar.hpp>
+#include <Framework/System/Process.hpp>
+#include <cstring>
+#ifndef WINDOWS
+    #include <fcntl.h>
+    #include <sys/wait.h>
+    #include <unistd.h>
+#endif
+
+using namespace bpf::collection;
+using namespace bpf::io;
+using namespace bpf;
+
+#ifndef WINDOWS
+/**
+ * Previous Process::Builder strategy: fork, then report exec failures through a close-on-exec pipe
+ */
+static void ForkSpawn(const char *path)
+{
+    int commonfd[2];
+    char *argv[] = {const_cast<char *>(path), nullptr};
+    char *envp[] = {nullptr};
+
+    if (pipe(commonfd) != 0)
+        return;
+    fcntl(commonfd[1], F_SETFD, FD_CLOEXEC);
+    int pid = fork();
+    if (pid == 0)
+    {
+        close(commonfd[0]);
+        execve(path, argv, envp);
+        _exit(1);
+    }
+    close(commonfd[1]);
+    char buf[64];
+    while (read(commonfd[0], buf, sizeof(buf)) > 0)
+        ;
+    close(commonfd[0]);
+    waitpid(pid, nullptr, 0);
+}
+#endif
+
+static String Latency(const fsize count, const double seconds)
+{
+    return (String::ValueOf(seconds / static_cast<double>(count) * 1e6, 1) + " us");
+}
+
+static void Run(const fsize count, const String &path)
+{
+#ifndef WINDOWS
+    double legacy = benchmarks::Measure([&]() {
+        for (fsize i = 0; i != count; ++i)
+            ForkSpawn(*path);
+    });
+#endif
+    double current = benchmarks::Measure([&]() {
+        for (fsize i = 0; i != count; ++i)
+        {
+            auto proc = system::Process::Builder().SetApplication(path).Build();
+            proc.Wait();
+        }
+    });
+#ifndef WINDOWS
+    Console::WriteLine(String("  fork+execve ") + Latency(count, legacy) + ", Process::Builder " + Latency(count, current));
+#else
+    Console::WriteLine(String("  Process::Builder ") + Latency(count, current));
+#endif
+}
+
+namespace benchmarks
+{
+    void Spawn(const Array<String> &args)
+    {
+        constexpr fsize count = 200;
+        fsize resident = 1024;
+#ifdef WINDOWS
+        String path = "C:/Windows/System32/whoami.exe";
+#else
+        String path = "/bin/true";
+#endif
+
+        if (args.Size() > 2)
+            resident = UInt::Parse(args[2]);
+        Console::WriteLine(String::ValueOf(count) + " spawns of " + path + " per run, average latency per spawn");
+        Console::WriteLine("Parent with a small heap:");
+        Run(count, path);
+        // Touching every page makes fork copy the page tables of the whole heap
+        auto *heap = static_cast<uint8 *>(memory::Memory::Malloc(resident * 1024 * 1024));
+        std::memset(heap, 1, resident * 1024 * 1024);
+        Console::WriteLine(String("Parent with ") + String::ValueOf(resident) + " MB resident:");
+        Run(count, path);
+        memory::Memory::Free(heap);
+    }
+}
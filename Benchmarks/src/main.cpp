@@ -0,0 +1,79 @@
+// Copyright (c) 2020, BlockProject 3D
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without modification,
+// are permitted provided that the following conditions are met:
+// 
+//     * Redistributions of source code must retain the above copyright notice,
+//       this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above copyright notice,
+//       this list of conditions and the following disclaimer in the documentation
+//       and/or other materials provided with the distribution.
+//     * Neither the name of BlockProject 3D nor the names of its contributors
+//       may be used to endorse or promote products derived from this software
+//       without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include "Benchmark.hpp"
+#include <Framework/RuntimeException.hpp>
+#include <Framework/System/Application.hpp>
+
+using namespace bpf::collection;
+using namespace bpf::io;
+using namespace bpf;
+
+struct Benchmark
+{
+    const char *Name;
+    void (*Run)(const Array<String> &args);
+};
+
+static const Benchmark BENCHMARKS[] = {
+    {"Compression", &benchmarks::Compression},
+    {"Matrix", &benchmarks::Matrix},
+    {"Numbers", &benchmarks::Numbers},
+    {"OrderedMap", &benchmarks::OrderedMap},
+    {"PriorityQueue", &benchmarks::PriorityQueue},
+    {"Spawn", &benchmarks::Spawn}
+};
+
+int Main(bpf::system::Application &, const Array<String> &args)
+{
+    bool found = false;
+
+    try
+    {
+        for (auto &bench : BENCHMARKS)
+        {
+            if (args.Size() > 1 && args[1] != bench.Name)
+                continue;
+            found = true;
+            Console::WriteLine(String("==> ") + bench.Name);
+            bench.Run(args);
+        }
+    }
+    catch (const RuntimeException &e)
+    {
+        Console::WriteLine(String("An unhandled exception of type ") + e.Type() + " has occured:", EConsoleStream::ERROR);
+        Console::WriteLine(e.Message(), EConsoleStream::ERROR);
+        return (1);
+    }
+    if (!found)
+    {
+        Console::WriteLine(String("Unknown benchmark: ") + args[1], EConsoleStream::ERROR);
+        return (1);
+    }
+    return (0);
+}
@@ -0,0 +1,195 @@
+// Copyright (c) 2020, BlockProject 3D
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without modification,
+// are permitted provided that the following conditions are met:
+// 
+//     * Redistributions of source code must retain the above copyright notice,
+//       this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above copyright notice,
+//       this list of conditions and the following disclaimer in the documentation
+//       and/or other materials provided with the distribution.
+//     * Neither the name of BlockProject 3D nor the names of its contributors
+//       may be used to endorse or promote products derived from this software
+//       without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#pragma once
+#include "Framework/Compression/Compressor.hpp"
+#include <Framework/Collection/ArrayList.hpp>
+#include <Framework/Collection/List.hpp>
+#include <Framework/IO/ByteBuf.hpp>
+#include <Framework/IO/IOutputStream.hpp>
+#include <Framework/System/ThreadPool.hpp>
+
+namespace bpf
+{
+    namespace compression
+    {
+        /**
+         * Magic number at the start of a block compressed container ("BPZC")
+         */
+        constexpr uint32 BLOCK_COMPRESSION_MAGIC = 0x435A5042;
+
+        /**
+         * Magic number at the end of a block compressed container ("BPZI")
+         */
+        constexpr uint32 BLOCK_COMPRESSION_INDEX_MAGIC = 0x495A5042;
+
+        /**
+         * Version of the block compressed container format
+         */
+        constexpr uint16 BLOCK_COMPRESSION_VERSION = 1;
+
+        /**
+         * Default uncompressed size in bytes of a block
+         */
+        constexpr fsize BLOCK_COMPRESSION_SIZE = 256 * 1024;
+
+        /**
+         * Size in bytes of the container header: magic, version, codec and block size
+         */
+        constexpr fsize BLOCK_COMPRESSION_HEADER_SIZE = 12;
+
+        /**
+         * Size in bytes of the container footer: index offset, block count, uncompressed size and magic
+         */
+        constexpr fsize BLOCK_COMPRESSION_FOOTER_SIZE = 28;
+
+        /**
+         * Size in bytes of one index entry: offset, compressed size and uncompressed size
+         */
+        constexpr fsize BLOCK_COMPRESSION_ENTRY_SIZE = 16;
+
+        /**
+         * Output stream filter writing a seekable block compressed container to another stream.
+         * Data is split into fixed size blocks which are compressed independently on a ThreadPool with any
+         * ECompressionCodec, then written in order followed by an index of all blocks. BlockInflateInputStream uses
+         * the index to decompress only the blocks covering the requested range.
+         * All values are stored little endian
+         */
+        class BPF_COMPRESSION_API BlockDeflateOutputStream final : public io::IOutputStream
+        {
+        private:
+            struct Block
+            {
+                memory::UniquePtr<ICompressor> Compressor;
+                io::ByteBuf Input;
+                io::ByteBuf Output;
+                fsize Size;
+                fsize CompressedSize;
+                bool Done;
+                bool Failed;
+
+                inline Block(memory::UniquePtr<ICompressor> &&compressor, fsize size)
+                    : Compressor(std::move(compressor))
+                    , Input(size)
+                    , Output(Compressor->GetBound(size))
+                    , Size(0)
+                    , CompressedSize(0)
+                    , Done(false)
+                    , Failed(false)
+                {
+                }
+            };
+
+            struct Entry
+            {
+                uint64 Offset;
+                uint32 CompressedSize;
+                uint32 Size;
+            };
+
+            io::IOutputStream &_stream;
+            system::ThreadPool _pool;
+            fsize _blockSize;
+            fsize _maxBlocks;
+            ECompressionCodec _codec;
+            int _level;
+            Block *_current;
+            collection::List<Block *> _pending;
+            collection::List<Block *> _free;
+            collection::ArrayList<Entry> _index;
+            uint64 _offset;
+            uint64 _size;
+            bool _finished;
+
+            void WriteRaw(const void *buf, fsize size);
+            void Recycle(Block *block);
+            void Submit();
+            void Drain(bool all);
+
+        public:
+            /**
+             * Constructs a BlockDeflateOutputStream and writes the container header
+             * @param stream the stream receiving the container, it must be positioned at the start of the container
+             * @param codec the codec used to compress blocks
+             * @param level the native codec level (see Compressor::Create)
+             * @param blockSize the uncompressed size in bytes of each block
+             * @param threads the number of compression threads
+             * @throw IOException in case of system error or if the codec is not available
+             */
+            BlockDeflateOutputStream(io::IOutputStream &stream, ECompressionCodec codec, int level,
+                                     fsize blockSize = BLOCK_COMPRESSION_SIZE, fsize threads = 4);
+
+            /**
+             * Constructs a BlockDeflateOutputStream and writes the container header
+             * @param stream the stream receiving the container, it must be positioned at the start of the container
+             * @param level the compression level
+             * @param blockSize the uncompressed size in bytes of each block
+             * @param threads the number of compression threads
+             * @param codec the codec used to compress blocks
+             * @throw IOException in case of system error or if the codec is not available
+             */
+            explicit BlockDeflateOutputStream(io::IOutputStream &stream, ECompressionLevel level = ECompressionLevel::DEFAULT,
+                                              fsize blockSize = BLOCK_COMPRESSION_SIZE, fsize threads = 4,
+                                              ECompressionCodec codec = ECompressionCodec::ZLIB)
+                : BlockDeflateOutputStream(stream, codec, Compressor::GetLevel(codec, level), blockSize, threads)
+            {
+            }
+
+            /**
+             * Finishes the container if Finish was not called
+             */
+            ~BlockDeflateOutputStream();
+
+            /**
+             * Cannot copy a BlockDeflateOutputStream
+             */
+            BlockDeflateOutputStream(const BlockDeflateOutputStream &other) = delete;
+
+            /**
+             * Cannot copy a BlockDeflateOutputStream
+             */
+            BlockDeflateOutputStream &operator=(const BlockDeflateOutputStream &other) = delete;
+
+            /**
+             * Appends bytes to the container, full blocks are handed to the compression threads.
+             * Memory usage is bounded: when too many blocks are waiting this function waits for the oldest one
+             * @param buf the buffer with the bytes to write
+             * @param bufsize the size of the buffer
+             * @throw IOException in case of system error or if the container is finished
+             * @return number of bytes consumed, always bufsize
+             */
+            fsize Write(const void *buf, fsize bufsize) final;
+
+            /**
+             * Compresses the last partial block, waits for all blocks and writes the index
+             * @throw IOException in case of system error
+             */
+            void Finish();
+        };
+    }
+}
@@ -0,0 +1,147 @@
+// Copyright (c) 2020, BlockProject 3D
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without modification,
+// are permitted provided that the following conditions are met:
+// 
+//     * Redistributions of source code must retain the above copyright notice,
+//       this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above copyright notice,
+//       this list of conditions and the following disclaimer in the documentation
+//       and/or other materials provided with the distribution.
+//     * Neither the name of BlockProject 3D nor the names of its contributors
+//       may be used to endorse or promote products derived from this software
+//       without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#pragma once
+#include "Framework/Compression/BlockDeflateOutputStream.hpp"
+#include <Framework/IO/FileStream.hpp>
+
+namespace bpf
+{
+    namespace compression
+    {
+        /**
+         * Random access reader for containers written by BlockDeflateOutputStream.
+         * Only the blocks covering a requested range are read and decompressed; the last partially read block is
+         * cached so that small sequential reads do not decompress the same block twice
+         */
+        class BPF_COMPRESSION_API BlockInflateInputStream final : public io::IInputStream
+        {
+        private:
+            struct Entry
+            {
+                uint64 Offset;
+                uint32 CompressedSize;
+                uint32 Size;
+            };
+
+            io::FileStream _file;
+            memory::UniquePtr<ICompressor> _compressor;
+            collection::ArrayList<Entry> _index;
+            fsize _blockSize;
+            uint64 _size;
+            uint64 _pos;
+            io::ByteBuf _compressed;
+            io::ByteBuf _cache;
+            fsize _cachedBlock;
+
+            void ReadFully(uint64 pos, void *buf, fsize size);
+            void Decompress(fsize block, void *out);
+
+        public:
+            /**
+             * Opens a block compressed container and loads its index
+             * @param file the container file
+             * @throw IOException in case of system error or if the file is not a valid container
+             */
+            explicit BlockInflateInputStream(const io::File &file);
+
+            /**
+             * Returns the codec used to compress the blocks of the container
+             * @return the codec
+             */
+            inline ECompressionCodec GetCodec() const noexcept
+            {
+                return (_compressor->GetCodec());
+            }
+
+            /**
+             * Returns the uncompressed size of the container
+             * @return size in bytes
+             */
+            inline uint64 GetSize() const noexcept
+            {
+                return (_size);
+            }
+
+            /**
+             * Returns the number of blocks in the container
+             * @return number of blocks
+             */
+            inline fsize GetBlockCount() const noexcept
+            {
+                return (_index.Size());
+            }
+
+            /**
+             * Returns the uncompressed size of each block (except the last one)
+             * @return size in bytes
+             */
+            inline fsize GetBlockSize() const noexcept
+            {
+                return (_blockSize);
+            }
+
+            /**
+             * Returns the current uncompressed stream position
+             * @return position in bytes
+             */
+            inline uint64 GetPosition() const noexcept
+            {
+                return (_pos);
+            }
+
+            /**
+             * Sets the uncompressed stream position used by Read
+             * @param pos new position in bytes
+             */
+            inline void Seek(uint64 pos) noexcept
+            {
+                _pos = pos;
+            }
+
+            /**
+             * Reads uncompressed bytes at an arbitrary position, decompressing only the blocks covering them
+             * @param pos uncompressed position in bytes to start reading at
+             * @param buf buffer to receive the read bytes
+             * @param bufsize the size of the receiving buffer
+             * @throw IOException in case of system error or corrupted data
+             * @return number of bytes read, less than bufsize only at the end of the container
+             */
+            fsize ReadAt(uint64 pos, void *buf, fsize bufsize);
+
+            /**
+             * Reads uncompressed bytes at the current position
+             * @param buf buffer to receive the read bytes
+             * @param bufsize the size of the receiving buffer
+             * @throw IOException in case of system error or corrupted data
+             * @return number of bytes read
+             */
+            fsize Read(void *buf, fsize bufsize) final;
+        };
+    }
+}
@@ -0,0 +1,93 @@
+// Copyright (c) 2020, BlockProject 3D
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without modification,
+// are permitted provided that the following conditions are met:
+// 
+//     * Redistributions of source code must retain the above copyright notice,
+//       this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above copyright notice,
+//       this list of conditions and the following disclaimer in the documentation
+//       and/or other materials provided with the distribution.
+//     * Neither the name of BlockProject 3D nor the names of its contributors
+//       may be used to endorse or promote products derived from this software
+//       without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#pragma once
+#include "Framework/Compression/ECompressionLevel.hpp"
+#include "Framework/Compression/ICompressor.hpp"
+#include <Framework/Memory/Utility.hpp>
+#include <Framework/String.hpp>
+
+namespace bpf
+{
+    namespace compression
+    {
+        /**
+         * Factory for compression codecs. LZ4 and Zstandard are optional, they are compiled in with the
+         * BPF_COMPRESSION_LZ4 and BPF_COMPRESSION_ZSTD CMake options
+         */
+        class BPF_COMPRESSION_API Compressor
+        {
+        public:
+            /**
+             * Checks if a codec is compiled in
+             * @param codec the codec to check
+             * @return true if Create can instantiate the codec
+             */
+            static bool IsAvailable(ECompressionCodec codec) noexcept;
+
+            /**
+             * Returns the display name of a codec
+             * @param codec the codec
+             * @return name of the codec
+             */
+            static String GetName(ECompressionCodec codec);
+
+            /**
+             * Converts a generic compression level to the native level of a codec
+             * @param codec the codec
+             * @param level the generic compression level
+             * @return native codec level to pass to Create
+             */
+            static int GetLevel(ECompressionCodec codec, ECompressionLevel level) noexcept;
+
+            /**
+             * Creates a compressor with a native codec level.
+             * ZLib accepts 1 to 9 (-1 for default), LZ4 uses the fast compressor below 3 (negative values trade
+             * ratio for speed) and LZ4HC from 3 to 12, Zstandard accepts its full range (negative values for speed)
+             * @param codec the codec
+             * @param level the native codec level
+             * @throw IOException if the codec is not available or could not be initialized
+             * @return new compressor
+             */
+            static memory::UniquePtr<ICompressor> Create(ECompressionCodec codec, int level);
+
+            /**
+             * Creates a compressor
+             * @param codec the codec
+             * @param level the compression level
+             * @throw IOException if the codec is not available or could not be initialized
+             * @return new compressor
+             */
+            inline static memory::UniquePtr<ICompressor> Create(ECompressionCodec codec,
+                                                                ECompressionLevel level = ECompressionLevel::DEFAULT)
+            {
+                return (Create(codec, GetLevel(codec, level)));
+            }
+        };
+    }
+}
@@ -0,0 +1,113 @@
+// Copyright (c) 2020, BlockProject 3D
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without modification,
+// are permitted provided that the following conditions are met:
+// 
+//     * Redistributions of source code must retain the above copyright notice,
+//       this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above copyright notice,
+//       this list of conditions and the following disclaimer in the documentation
+//       and/or other materials provided with the distribution.
+//     * Neither the name of BlockProject 3D nor the names of its contributors
+//       may be used to endorse or promote products derived from this software
+//       without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#pragma once
+#include "Framework/Compression/ECompressionLevel.hpp"
+#include <Framework/IO/ByteBuf.hpp>
+#include <Framework/IO/IOutputStream.hpp>
+
+namespace bpf
+{
+    namespace compression
+    {
+        /**
+         * Default size in bytes of the internal window of the compression streams
+         */
+        constexpr fsize COMPRESSION_WINDOW_SIZE = 16384;
+
+        /**
+         * Output stream filter compressing everything written to it using ZLib before forwarding it to another stream.
+         * Memory usage is constant: compressed data is forwarded each time the internal window is full
+         */
+        class BPF_COMPRESSION_API DeflateOutputStream final : public io::IOutputStream
+        {
+        private:
+            void *_handle;
+            io::IOutputStream &_stream;
+            io::ByteBuf _window;
+            bool _finished;
+
+            void Run(int flush);
+
+        public:
+            /**
+             * Constructs a DeflateOutputStream
+             * @param stream the stream receiving compressed data
+             * @param level the compression level
+             * @param windowSize the size in bytes of the internal output window
+             * @throw IOException if ZLib could not be initialized
+             */
+            explicit DeflateOutputStream(io::IOutputStream &stream, ECompressionLevel level = ECompressionLevel::DEFAULT, fsize windowSize = COMPRESSION_WINDOW_SIZE);
+
+            /**
+             * Finishes the compressed stream if Finish was not called
+             */
+            ~DeflateOutputStream();
+
+            /**
+             * Cannot copy a DeflateOutputStream
+             */
+            DeflateOutputStream(const DeflateOutputStream &other) = delete;
+
+            /**
+             * Cannot copy a DeflateOutputStream
+             */
+            DeflateOutputStream &operator=(const DeflateOutputStream &other) = delete;
+
+            /**
+             * Compresses bytes into the underlying stream
+             * @param buf the buffer with the bytes to write
+             * @param bufsize the size of the buffer
+             * @throw IOException in case of system error or if the stream is finished
+             * @return number of bytes consumed, always bufsize
+             */
+            fsize Write(const void *buf, fsize bufsize) final;
+
+            /**
+             * Forwards all pending compressed data to the underlying stream and inserts a sync point: a reader can
+             * decompress everything written so far without waiting for more data. Flushing too often degrades
+             * compression
+             * @throw IOException in case of system error
+             */
+            void Flush();
+
+            /**
+             * Terminates the compressed stream and forwards the remaining data and the checksum to the underlying
+             * stream. No data can be written after calling this function
+             * @throw IOException in case of system error
+             */
+            void Finish();
+
+            /**
+             * Returns the Adler32 checksum value of the data written so far
+             * @return 32 bits unsigned
+             */
+            uint32 GetAdler32() const;
+        };
+    }
+}
@@ -0,0 +1,92 @@
+// Copyright (c) 2020, BlockProject 3D
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without modification,
+// are permitted provided that the following conditions are met:
+// 
+//     * Redistributions of source code must retain the above copyright notice,
+//       this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above copyright notice,
+//       this list of conditions and the following disclaimer in the documentation
+//       and/or other materials provided with the distribution.
+//     * Neither the name of BlockProject 3D nor the names of its contributors
+//       may be used to endorse or promote products derived from this software
+//       without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#pragma once
+#include "Framework/Compression/ECompressionCodec.hpp"
+#include <Framework/Types.hpp>
+
+namespace bpf
+{
+    namespace compression
+    {
+        /**
+         * Represents a one shot block compression codec.
+         * Instances keep their codec context between calls to avoid re-allocating it for every block,
+         * as such they are not thread safe: use one instance per thread
+         */
+        class BPF_COMPRESSION_API ICompressor
+        {
+        public:
+            virtual ~ICompressor() {}
+
+            /**
+             * Returns the codec implemented by this compressor
+             * @return the codec
+             */
+            virtual ECompressionCodec GetCodec() const noexcept = 0;
+
+            /**
+             * Returns the maximum compressed size of a block
+             * @param size the uncompressed size of the block in bytes
+             * @return size in bytes of the output buffer to pass to Compress
+             */
+            virtual fsize GetBound(fsize size) const noexcept = 0;
+
+            /**
+             * Sets a dictionary used by both Compress and Decompress. Data compressed with a dictionary can only be
+             * decompressed with the same dictionary. The dictionary is copied
+             * @param dict pointer to the dictionary, nullptr to remove the current dictionary
+             * @param size the size in bytes of the dictionary
+             * @throw IOException if the codec could not load the dictionary
+             */
+            virtual void SetDictionary(const void *dict, fsize size) = 0;
+
+            /**
+             * Compresses a block
+             * @param in the data to compress
+             * @param inSize the size in bytes of the data to compress
+             * @param out the output buffer
+             * @param outSize the size of the output buffer, GetBound(inSize) guarantees success
+             * @throw IOException if the output buffer is too small or the codec failed
+             * @return number of bytes written to the output buffer
+             */
+            virtual fsize Compress(const void *in, fsize inSize, void *out, fsize outSize) = 0;
+
+            /**
+             * Decompresses a block
+             * @param in the compressed data
+             * @param inSize the size in bytes of the compressed data
+             * @param out the output buffer
+             * @param outSize the size of the output buffer, must be at least the uncompressed size of the block
+             * @throw IOException if the data is corrupted or the output buffer is too small
+             * @return number of bytes written to the output buffer
+             */
+            virtual fsize Decompress(const void *in, fsize inSize, void *out, fsize outSize) = 0;
+        };
+    }
+}
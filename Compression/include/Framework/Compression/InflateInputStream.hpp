@@ -0,0 +1,94 @@
+// Copyright (c) 2020, BlockProject 3D
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without modification,
+// are permitted provided that the following conditions are met:
+// 
+//     * Redistributions of source code must retain the above copyright notice,
+//       this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above copyright notice,
+//       this list of conditions and the following disclaimer in the documentation
+//       and/or other materials provided with the distribution.
+//     * Neither the name of BlockProject 3D nor the names of its contributors
+//       may be used to endorse or promote products derived from this software
+//       without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#pragma once
+#include "Framework/Compression/DeflateOutputStream.hpp"
+#include <Framework/IO/ByteBuf.hpp>
+#include <Framework/IO/IInputStream.hpp>
+
+namespace bpf
+{
+    namespace compression
+    {
+        /**
+         * Input stream filter decompressing ZLib data read from another stream.
+         * Memory usage is constant: compressed data is read from the underlying stream one window at a time, or
+         * directly from its memory when it supports zero-copy reads.
+         * Read returns as soon as some data is available, which makes this stream usable on top of data written
+         * with DeflateOutputStream::Flush sync points.
+         * The underlying stream is read in window sized chunks, so bytes following the end of the compressed
+         * stream may be consumed
+         */
+        class BPF_COMPRESSION_API InflateInputStream final : public io::IInputStream
+        {
+        private:
+            void *_handle;
+            io::IInputStream &_stream;
+            io::ByteBuf _window;
+            bool _end;
+
+            bool Fill();
+
+        public:
+            /**
+             * Constructs an InflateInputStream
+             * @param stream the stream to read compressed data from
+             * @param windowSize the size in bytes of the internal input window
+             * @throw IOException if ZLib could not be initialized
+             */
+            explicit InflateInputStream(io::IInputStream &stream, fsize windowSize = COMPRESSION_WINDOW_SIZE);
+
+            ~InflateInputStream();
+
+            /**
+             * Cannot copy an InflateInputStream
+             */
+            InflateInputStream(const InflateInputStream &other) = delete;
+
+            /**
+             * Cannot copy an InflateInputStream
+             */
+            InflateInputStream &operator=(const InflateInputStream &other) = delete;
+
+            /**
+             * Reads and decompresses bytes from the underlying stream
+             * @param buf buffer to receive the decompressed bytes
+             * @param bufsize the size of the receiving buffer
+             * @throw IOException in case of system error, corrupted data or truncated stream
+             * @return number of bytes read, 0 once the end of the compressed stream is reached
+             */
+            fsize Read(void *buf, fsize bufsize) final;
+
+            /**
+             * Returns the Adler32 checksum value of the data read so far
+             * @return 32 bits unsigned
+             */
+            uint32 GetAdler32() const;
+        };
+    }
+}
@@ -27,33 +27,13 @@
 // SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #pragma once
+#include "Framework/Compression/ECompressionLevel.hpp"
 #include <Framework/IO/ByteBuf.hpp>
 
 namespace bpf
 {
     namespace compression
     {
-        /**
-         * Enumeration for level of compression
-         */
-        enum class ECompressionLevel
-        {
-            /**
-             * Low compression
-             */
-            LOW,
-
-            /**
-             * High compression
-             */
-            HIGH,
-
-            /**
-             * Default compression
-             */
-            DEFAULT
-        };
-
         /**
          * Represents data compression using ZLib
          */
@@ -62,6 +42,7 @@ namespace bpf
         private:
             void *_handle;
             io::ByteBuf _input;
+            fsize _inputSize;
 
         public:
             /**
@@ -84,6 +65,22 @@ namespace bpf
              */
             void SetInput(io::ByteBuf &&inflated);
 
+            /**
+             * Sets the input buffer without copying it
+             * @param inflated pointer to the data to compress, must stay valid until the input is fully deflated
+             * @param size the size in bytes of the data
+             */
+            void SetInput(const void *inflated, fsize size);
+
+            /**
+             * Sets the input buffer without copying it
+             * @param inflated view of the data to compress, the bytes must stay valid until the input is fully deflated
+             */
+            inline void SetInput(const io::ByteView &inflated)
+            {
+                SetInput(*inflated, inflated.Size());
+            }
+
             /**
              * Returns the Adler32 checksum value of the compressed data
              * @return 32 bits unsigned
@@ -63,6 +63,22 @@ namespace bpf
              */
             void SetInput(io::ByteBuf &&deflated);
 
+            /**
+             * Sets the input buffer without copying it
+             * @param deflated pointer to the data to de-compress, must stay valid until the input is fully inflated
+             * @param size the size in bytes of the data
+             */
+            void SetInput(const void *deflated, fsize size);
+
+            /**
+             * Sets the input buffer without copying it
+             * @param deflated view of the data to de-compress, the bytes must stay valid until the input is fully inflated
+             */
+            inline void SetInput(const io::ByteView &deflated)
+            {
+                SetInput(*deflated, deflated.Size());
+            }
+
             /**
              * Returns the Adler32 checksum value of the compressed data
              * @return 32 bits unsigned
@@ -0,0 +1,233 @@
+// Copyright (c) 2020, BlockProject 3D
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without modification,
+// are permitted provided that the following conditions are met:
+// 
+//     * Redistributions of source code must retain the above copyright notice,
+//       this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above copyright notice,
+//       this list of conditions and the following disclaimer in the documentation
+//       and/or other materials provided with the distribution.
+//     * Neither the name of BlockProject 3D nor the names of its contributors
+//       may be used to endorse or promote products derived from this software
+//       without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include "Framework/Compression/BlockDeflateOutputStream.hpp"
+#include <Framework/IO/IOException.hpp>
+#include <Framework/Memory/MemUtils.hpp>
+
+using namespace bpf::compression;
+using namespace bpf::collection;
+using namespace bpf::memory;
+using namespace bpf::io;
+using namespace bpf;
+
+static void EncodeLE(uint8 *out, uint64 value, fsize bytes)
+{
+    for (fsize i = 0; i != bytes; ++i)
+        out[i] = static_cast<uint8>(value >> (i * 8));
+}
+
+BlockDeflateOutputStream::BlockDeflateOutputStream(io::IOutputStream &stream, const ECompressionCodec codec,
+                                                   const int level, const fsize blockSize, const fsize threads)
+    : _stream(stream)
+    , _pool(threads > 0 ? threads : 1, "BlockDeflate")
+    , _blockSize(blockSize > 0 ? blockSize : BLOCK_COMPRESSION_SIZE)
+    , _maxBlocks((threads > 0 ? threads : 1) * 2)
+    , _codec(codec)
+    , _level(level)
+    , _current(nullptr)
+    , _offset(0)
+    , _size(0)
+    , _finished(false)
+{
+    // Block sizes are stored on 32 bits in the index
+    if (_blockSize > 0xFFFFFFFF - 1024)
+        throw IOException("Block size too large");
+    if (!Compressor::IsAvailable(codec))
+        throw IOException(String("Compression codec not available: ") + Compressor::GetName(codec));
+    uint8 header[BLOCK_COMPRESSION_HEADER_SIZE];
+    EncodeLE(header, BLOCK_COMPRESSION_MAGIC, 4);
+    EncodeLE(header + 4, BLOCK_COMPRESSION_VERSION, 2);
+    EncodeLE(header + 6, static_cast<uint64>(codec), 2);
+    EncodeLE(header + 8, _blockSize, 4);
+    WriteRaw(header, BLOCK_COMPRESSION_HEADER_SIZE);
+}
+
+BlockDeflateOutputStream::~BlockDeflateOutputStream()
+{
+    try
+    {
+        Finish();
+    }
+    catch (const IOException &)
+    {
+        // Nothing can be reported from a destructor
+    }
+    // Tasks still reference their block until the pool is idle
+    while (_pending.Size() > 0)
+    {
+        _pool.Poll();
+        if (_pending.First()->Done)
+        {
+            MemUtils::Delete(_pending.First());
+            _pending.RemoveAt(0);
+        }
+        else
+            _pool.Wait();
+    }
+    for (auto *block : _free)
+        MemUtils::Delete(block);
+    MemUtils::Delete(_current);
+}
+
+void BlockDeflateOutputStream::Recycle(Block *block)
+{
+    block->Input.Reset();
+    block->Size = 0;
+    block->CompressedSize = 0;
+    block->Done = false;
+    block->Failed = false;
+    _free.Add(block);
+}
+
+void BlockDeflateOutputStream::WriteRaw(const void *buf, fsize size)
+{
+    auto *data = reinterpret_cast<const uint8 *>(buf);
+    while (size > 0)
+    {
+        fsize written = _stream.Write(data, size);
+        if (written == 0)
+            throw IOException("Block deflate failed: could not write to the underlying stream");
+        data += written;
+        size -= written;
+        _offset += written;
+    }
+}
+
+void BlockDeflateOutputStream::Submit()
+{
+    Block *block = _current;
+    _current = nullptr;
+    _pending.Add(block);
+    // The block is owned by this stream and only recycled once its callback ran
+    _pool.Run([block]() {
+        try
+        {
+            block->CompressedSize = block->Compressor->Compress(*block->Input, block->Size, *block->Output,
+                                                                block->Output.Size());
+        }
+        catch (const IOException &)
+        {
+            block->Failed = true;
+        }
+        return (Dynamic());
+    }, [block](Dynamic &) {
+        block->Done = true;
+    });
+}
+
+void BlockDeflateOutputStream::Drain(const bool all)
+{
+    while (_pending.Size() > 0)
+    {
+        _pool.Poll();
+        Block *block = _pending.First();
+        if (!block->Done)
+        {
+            if (!all && _pending.Size() < _maxBlocks)
+                return;
+            _pool.Wait();
+            continue;
+        }
+        _pending.RemoveAt(0);
+        if (block->Failed)
+        {
+            Recycle(block);
+            throw IOException("Block deflate failed: could not compress block");
+        }
+        Entry entry;
+        entry.Offset = _offset;
+        entry.CompressedSize = static_cast<uint32>(block->CompressedSize);
+        entry.Size = static_cast<uint32>(block->Size);
+        try
+        {
+            WriteRaw(*block->Output, block->CompressedSize);
+        }
+        catch (const IOException &)
+        {
+            Recycle(block);
+            throw;
+        }
+        Recycle(block);
+        _index.Add(entry);
+    }
+}
+
+fsize BlockDeflateOutputStream::Write(const void *buf, fsize bufsize)
+{
+    if (_finished)
+        throw IOException("Block deflate failed: the stream is finished");
+    auto *data = reinterpret_cast<const uint8 *>(buf);
+    fsize remaining = bufsize;
+    while (remaining > 0)
+    {
+        if (_current == nullptr && _free.Size() > 0)
+        {
+            _current = _free.Last();
+            _free.RemoveLast();
+        }
+        else if (_current == nullptr)
+            _current = MemUtils::New<Block>(Compressor::Create(_codec, _level), _blockSize);
+        fsize len = _current->Input.Write(data, remaining);
+        _current->Size += len;
+        data += len;
+        remaining -= len;
+        _size += len;
+        if (_current->Size == _blockSize)
+        {
+            Submit();
+            Drain(false);
+        }
+    }
+    return (bufsize);
+}
+
+void BlockDeflateOutputStream::Finish()
+{
+    if (_finished)
+        return;
+    _finished = true;
+    if (_current != nullptr && _current->Size > 0)
+        Submit();
+    Drain(true);
+    uint64 indexOffset = _offset;
+    uint8 entry[BLOCK_COMPRESSION_ENTRY_SIZE];
+    for (fsize i = 0; i != _index.Size(); ++i)
+    {
+        EncodeLE(entry, _index[i].Offset, 8);
+        EncodeLE(entry + 8, _index[i].CompressedSize, 4);
+        EncodeLE(entry + 12, _index[i].Size, 4);
+        WriteRaw(entry, BLOCK_COMPRESSION_ENTRY_SIZE);
+    }
+    uint8 footer[BLOCK_COMPRESSION_FOOTER_SIZE];
+    EncodeLE(footer, indexOffset, 8);
+    EncodeLE(footer + 8, _index.Size(), 8);
+    EncodeLE(footer + 16, _size, 8);
+    EncodeLE(footer + 24, BLOCK_COMPRESSION_INDEX_MAGIC, 4);
+    WriteRaw(footer, BLOCK_COMPRESSION_FOOTER_SIZE);
+}
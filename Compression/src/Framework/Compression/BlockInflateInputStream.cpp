@@ -0,0 +1,175 @@
+// Copyright (c) 2020, BlockProject 3D
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without modification,
+// are permitted provided that the following conditions are met:
+// 
+//     * Redistributions of source code must retain the above copyright notice,
+//       this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above copyright notice,
+//       this list of conditions and the following disclaimer in the documentation
+//       and/or other materials provided with the distribution.
+//     * Neither the name of BlockProject 3D nor the names of its contributors
+//       may be used to endorse or promote products derived from this software
+//       without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include "Framework/Compression/BlockInflateInputStream.hpp"
+#include <Framework/IO/IOException.hpp>
+#include <cstring>
+
+using namespace bpf::compression;
+using namespace bpf::io;
+using namespace bpf;
+
+static uint64 DecodeLE(const uint8 *in, fsize bytes)
+{
+    uint64 value = 0;
+    for (fsize i = 0; i != bytes; ++i)
+        value |= static_cast<uint64>(in[i]) << (i * 8);
+    return (value);
+}
+
+BlockInflateInputStream::BlockInflateInputStream(const io::File &file)
+    : _file(file, FILE_MODE_READ)
+    , _blockSize(0)
+    , _size(0)
+    , _pos(0)
+    , _compressed(0)
+    , _cache(0)
+    , _cachedBlock(static_cast<fsize>(-1))
+{
+    uint64 fileSize = file.GetSizeBytes();
+    if (fileSize < BLOCK_COMPRESSION_HEADER_SIZE + BLOCK_COMPRESSION_FOOTER_SIZE)
+        throw IOException("Invalid block compressed file");
+    uint8 header[BLOCK_COMPRESSION_HEADER_SIZE];
+    uint8 footer[BLOCK_COMPRESSION_FOOTER_SIZE];
+    ReadFully(0, header, BLOCK_COMPRESSION_HEADER_SIZE);
+    ReadFully(fileSize - BLOCK_COMPRESSION_FOOTER_SIZE, footer, BLOCK_COMPRESSION_FOOTER_SIZE);
+    if (DecodeLE(header, 4) != BLOCK_COMPRESSION_MAGIC || DecodeLE(footer + 24, 4) != BLOCK_COMPRESSION_INDEX_MAGIC)
+        throw IOException("Invalid block compressed file");
+    if (DecodeLE(header + 4, 2) != BLOCK_COMPRESSION_VERSION)
+        throw IOException("Unsupported block compressed file version");
+    auto codec = static_cast<ECompressionCodec>(DecodeLE(header + 6, 2));
+    if (!Compressor::IsAvailable(codec))
+        throw IOException("Unsupported block compressed file codec");
+    _compressor = Compressor::Create(codec);
+    _blockSize = static_cast<fsize>(DecodeLE(header + 8, 4));
+    uint64 indexOffset = DecodeLE(footer, 8);
+    uint64 count = DecodeLE(footer + 8, 8);
+    _size = DecodeLE(footer + 16, 8);
+    uint64 indexEnd = fileSize - BLOCK_COMPRESSION_FOOTER_SIZE;
+    if (_blockSize == 0 || indexOffset < BLOCK_COMPRESSION_HEADER_SIZE || indexOffset > indexEnd
+        || (indexEnd - indexOffset) / BLOCK_COMPRESSION_ENTRY_SIZE != count
+        || (indexEnd - indexOffset) % BLOCK_COMPRESSION_ENTRY_SIZE != 0)
+        throw IOException("Invalid block compressed file");
+    ByteBuf index(static_cast<fsize>(indexEnd - indexOffset));
+    ReadFully(indexOffset, *index, index.Size());
+    uint64 total = 0;
+    fsize maxCompressed = 0;
+    for (uint64 i = 0; i != count; ++i)
+    {
+        const uint8 *data = *index + i * BLOCK_COMPRESSION_ENTRY_SIZE;
+        Entry entry;
+        entry.Offset = DecodeLE(data, 8);
+        entry.CompressedSize = static_cast<uint32>(DecodeLE(data + 8, 4));
+        entry.Size = static_cast<uint32>(DecodeLE(data + 12, 4));
+        // Every block but the last one is full: this is what makes block lookup a division
+        if (entry.Size == 0 || entry.Size > _blockSize || (i + 1 != count && entry.Size != _blockSize)
+            || entry.Offset < BLOCK_COMPRESSION_HEADER_SIZE || entry.Offset + entry.CompressedSize > indexOffset)
+            throw IOException("Invalid block compressed file");
+        if (entry.CompressedSize > maxCompressed)
+            maxCompressed = entry.CompressedSize;
+        total += entry.Size;
+        _index.Add(entry);
+    }
+    if (total != _size)
+        throw IOException("Invalid block compressed file");
+    _compressed = ByteBuf(maxCompressed);
+    _cache = ByteBuf(_blockSize);
+}
+
+void BlockInflateInputStream::ReadFully(uint64 pos, void *buf, fsize size)
+{
+    auto *data = reinterpret_cast<uint8 *>(buf);
+    while (size > 0)
+    {
+        fsize len = _file.ReadAt(pos, data, size);
+        if (len == 0)
+            throw IOException("Invalid block compressed file: unexpected end of file");
+        data += len;
+        size -= len;
+        pos += len;
+    }
+}
+
+void BlockInflateInputStream::Decompress(const fsize block, void *out)
+{
+    const Entry &entry = _index[block];
+    ReadFully(entry.Offset, *_compressed, entry.CompressedSize);
+    try
+    {
+        if (_compressor->Decompress(*_compressed, entry.CompressedSize, out, entry.Size) == entry.Size)
+            return;
+    }
+    catch (const IOException &)
+    {
+        // Reported below with the block number
+    }
+    throw IOException(String("Block inflate failed: corrupted block ") + String::ValueOf(block));
+}
+
+fsize BlockInflateInputStream::ReadAt(uint64 pos, void *buf, fsize bufsize)
+{
+    if (pos >= _size)
+        return (0);
+    if (bufsize > _size - pos)
+        bufsize = static_cast<fsize>(_size - pos);
+    auto *out = reinterpret_cast<uint8 *>(buf);
+    fsize remaining = bufsize;
+    while (remaining > 0)
+    {
+        auto block = static_cast<fsize>(pos / _blockSize);
+        auto offset = static_cast<fsize>(pos % _blockSize);
+        fsize blockSize = _index[block].Size;
+        fsize len = blockSize - offset;
+        if (len > remaining)
+            len = remaining;
+        if (len == blockSize && block != _cachedBlock)
+            Decompress(block, out); // Whole block requested: skip the cache copy
+        else
+        {
+            if (block != _cachedBlock)
+            {
+                // Invalidate first so that a failed decompression does not leave a half written block cached
+                _cachedBlock = static_cast<fsize>(-1);
+                Decompress(block, *_cache);
+                _cachedBlock = block;
+            }
+            std::memcpy(out, *_cache + offset, len);
+        }
+        out += len;
+        pos += len;
+        remaining -= len;
+    }
+    return (bufsize);
+}
+
+fsize BlockInflateInputStream::Read(void *buf, fsize bufsize)
+{
+    fsize len = ReadAt(_pos, buf, bufsize);
+    _pos += len;
+    return (len);
+}
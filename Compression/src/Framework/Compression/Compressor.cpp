@@ -0,0 +1,112 @@
+// Copyright (c) 2020, BlockProject 3D
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without modification,
+// are permitted provided that the following conditions are met:
+// 
+//     * Redistributions of source code must retain the above copyright notice,
+//       this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above copyright notice,
+//       this list of conditions and the following disclaimer in the documentation
+//       and/or other materials provided with the distribution.
+//     * Neither the name of BlockProject 3D nor the names of its contributors
+//       may be used to endorse or promote products derived from this software
+//       without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include "Framework/Compression/Compressor.hpp"
+#include "LZ4Compressor.hpp"
+#include "ZLibCompressor.hpp"
+#include "ZLibLevel.hpp"
+#include "ZstdCompressor.hpp"
+#include <Framework/IO/IOException.hpp>
+
+using namespace bpf::compression;
+using namespace bpf::memory;
+using namespace bpf::io;
+using namespace bpf;
+
+bool Compressor::IsAvailable(const ECompressionCodec codec) noexcept
+{
+    switch (codec)
+    {
+    case ECompressionCodec::ZLIB:
+        return (true);
+    case ECompressionCodec::LZ4:
+#ifdef BPF_COMPRESSION_LZ4
+        return (true);
+#else
+        return (false);
+#endif
+    case ECompressionCodec::ZSTD:
+#ifdef BPF_COMPRESSION_ZSTD
+        return (true);
+#else
+        return (false);
+#endif
+    }
+    return (false);
+}
+
+String Compressor::GetName(const ECompressionCodec codec)
+{
+    switch (codec)
+    {
+    case ECompressionCodec::ZLIB:
+        return ("ZLib");
+    case ECompressionCodec::LZ4:
+        return ("LZ4");
+    case ECompressionCodec::ZSTD:
+        return ("Zstandard");
+    }
+    return ("Unknown");
+}
+
+int Compressor::GetLevel(const ECompressionCodec codec, const ECompressionLevel level) noexcept
+{
+    switch (codec)
+    {
+    case ECompressionCodec::ZLIB:
+        return (ZLibLevel(level));
+    case ECompressionCodec::LZ4:
+        // The fast compressor by default, LZ4HC default level for HIGH
+        return (level == ECompressionLevel::HIGH ? 9 : 1);
+    case ECompressionCodec::ZSTD:
+        if (level == ECompressionLevel::LOW)
+            return (1);
+        return (level == ECompressionLevel::HIGH ? 19 : 3);
+    }
+    return (0);
+}
+
+UniquePtr<ICompressor> Compressor::Create(const ECompressionCodec codec, const int level)
+{
+    switch (codec)
+    {
+    case ECompressionCodec::ZLIB:
+        return (MakeUnique<ZLibCompressor>(level));
+#ifdef BPF_COMPRESSION_LZ4
+    case ECompressionCodec::LZ4:
+        return (MakeUnique<LZ4Compressor>(level));
+#endif
+#ifdef BPF_COMPRESSION_ZSTD
+    case ECompressionCodec::ZSTD:
+        return (MakeUnique<ZstdCompressor>(level));
+#endif
+    default:
+        break;
+    }
+    throw IOException(String("Compression codec not available: ") + GetName(codec));
+}
@@ -0,0 +1,142 @@
+// Copyright (c) 2020, BlockProject 3D
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without modification,
+// are permitted provided that the following conditions are met:
+// 
+//     * Redistributions of source code must retain the above copyright notice,
+//       this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above copyright notice,
+//       this list of conditions and the following disclaimer in the documentation
+//       and/or other materials provided with the distribution.
+//     * Neither the name of BlockProject 3D nor the names of its contributors
+//       may be used to endorse or promote products derived from this software
+//       without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include "Framework/Compression/DeflateOutputStream.hpp"
+#include "ZLibLevel.hpp"
+#include <Framework/IO/IOException.hpp>
+#include <Framework/Memory/Memory.hpp>
+#include <Framework/Memory/MemoryException.hpp>
+
+using namespace bpf::compression;
+using namespace bpf::memory;
+using namespace bpf::io;
+using namespace bpf;
+
+/**
+ * Largest chunk handed to zlib at once, its counters are 32 bits
+ */
+constexpr fsize MAX_ZLIB_CHUNK = 1 << 30;
+
+DeflateOutputStream::DeflateOutputStream(io::IOutputStream &stream, const ECompressionLevel level, const fsize windowSize)
+    : _handle(Memory::Malloc(sizeof(z_stream_s)))
+    , _stream(stream)
+    , _window(windowSize > 0 ? windowSize : COMPRESSION_WINDOW_SIZE)
+    , _finished(false)
+{
+    z_stream_s *zstream = reinterpret_cast<z_stream_s *>(_handle);
+    zstream->zalloc = Z_NULL;
+    zstream->zfree = Z_NULL;
+    zstream->opaque = Z_NULL;
+    zstream->avail_in = 0;
+    zstream->next_in = Z_NULL;
+    auto ret = deflateInit(zstream, ZLibLevel(level));
+    if (ret != Z_OK)
+    {
+        Memory::Free(zstream);
+        throw IOException(String("Could not initialize zlib: ") + String::ValueOf(ret));
+    }
+}
+
+DeflateOutputStream::~DeflateOutputStream()
+{
+    try
+    {
+        Finish();
+    }
+    catch (const IOException &)
+    {
+        // Nothing can be reported from a destructor
+    }
+    z_stream_s *zstream = reinterpret_cast<z_stream_s *>(_handle);
+    deflateEnd(zstream);
+    Memory::Free(zstream);
+}
+
+void DeflateOutputStream::Run(int flush)
+{
+    z_stream_s *zstream = reinterpret_cast<z_stream_s *>(_handle);
+
+    do
+    {
+        zstream->next_out = *_window;
+        zstream->avail_out = (uInt)_window.Size();
+        auto ret = deflate(zstream, flush);
+        if (ret == Z_STREAM_ERROR)
+            throw IOException("Deflate failed: Z_STREAM_ERROR");
+        fsize len = _window.Size() - zstream->avail_out;
+        const uint8 *data = *_window;
+        while (len > 0)
+        {
+            fsize written = _stream.Write(data, len);
+            if (written == 0)
+                throw IOException("Deflate failed: could not write to the underlying stream");
+            data += written;
+            len -= written;
+        }
+    } while (zstream->avail_out == 0);
+}
+
+fsize DeflateOutputStream::Write(const void *buf, fsize bufsize)
+{
+    if (_finished)
+        throw IOException("Deflate failed: the stream is finished");
+    z_stream_s *zstream = reinterpret_cast<z_stream_s *>(_handle);
+    auto *data = reinterpret_cast<const uint8 *>(buf);
+    fsize remaining = bufsize;
+    while (remaining > 0)
+    {
+        fsize len = remaining > MAX_ZLIB_CHUNK ? MAX_ZLIB_CHUNK : remaining;
+        zstream->next_in = const_cast<Bytef *>(data);
+        zstream->avail_in = (uInt)len;
+        Run(Z_NO_FLUSH);
+        data += len;
+        remaining -= len;
+    }
+    return (bufsize);
+}
+
+void DeflateOutputStream::Flush()
+{
+    if (_finished)
+        return;
+    Run(Z_SYNC_FLUSH);
+}
+
+void DeflateOutputStream::Finish()
+{
+    if (_finished)
+        return;
+    _finished = true;
+    Run(Z_FINISH);
+}
+
+uint32 DeflateOutputStream::GetAdler32() const
+{
+    z_stream_s *zstream = reinterpret_cast<z_stream_s *>(_handle);
+    return (zstream->adler);
+}
@@ -0,0 +1,127 @@
+// Copyright (c) 2020, BlockProject 3D
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without modification,
+// are permitted provided that the following conditions are met:
+// 
+//     * Redistributions of source code must retain the above copyright notice,
+//       this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above copyright notice,
+//       this list of conditions and the following disclaimer in the documentation
+//       and/or other materials provided with the distribution.
+//     * Neither the name of BlockProject 3D nor the names of its contributors
+//       may be used to endorse or promote products derived from this software
+//       without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include "Framework/Compression/InflateInputStream.hpp"
+#include <Framework/IO/IOException.hpp>
+#include <Framework/Memory/Memory.hpp>
+#include <Framework/Memory/MemoryException.hpp>
+#include <zlib.h>
+
+using namespace bpf::compression;
+using namespace bpf::memory;
+using namespace bpf::io;
+using namespace bpf;
+
+/**
+ * Largest chunk handed to zlib at once, its counters are 32 bits
+ */
+constexpr fsize MAX_ZLIB_CHUNK = 1 << 30;
+
+InflateInputStream::InflateInputStream(io::IInputStream &stream, const fsize windowSize)
+    : _handle(Memory::Malloc(sizeof(z_stream_s)))
+    , _stream(stream)
+    , _window(windowSize > 0 ? windowSize : COMPRESSION_WINDOW_SIZE)
+    , _end(false)
+{
+    z_stream_s *zstream = reinterpret_cast<z_stream_s *>(_handle);
+    zstream->zalloc = Z_NULL;
+    zstream->zfree = Z_NULL;
+    zstream->opaque = Z_NULL;
+    zstream->avail_in = 0;
+    zstream->next_in = Z_NULL;
+    auto ret = inflateInit(zstream);
+    if (ret != Z_OK)
+    {
+        Memory::Free(zstream);
+        throw IOException(String("Could not initialize zlib: ") + String::ValueOf(ret));
+    }
+}
+
+InflateInputStream::~InflateInputStream()
+{
+    z_stream_s *zstream = reinterpret_cast<z_stream_s *>(_handle);
+    inflateEnd(zstream);
+    Memory::Free(zstream);
+}
+
+bool InflateInputStream::Fill()
+{
+    z_stream_s *zstream = reinterpret_cast<z_stream_s *>(_handle);
+    const uint8 *data;
+    fsize len = _stream.ReadDirect(data, MAX_ZLIB_CHUNK);
+
+    if (len == 0)
+    {
+        len = _stream.Read(*_window, _window.Size());
+        data = *_window;
+    }
+    zstream->next_in = const_cast<Bytef *>(data);
+    zstream->avail_in = (uInt)len;
+    return (len > 0);
+}
+
+fsize InflateInputStream::Read(void *buf, fsize bufsize)
+{
+    if (_end || bufsize == 0)
+        return (0);
+    z_stream_s *zstream = reinterpret_cast<z_stream_s *>(_handle);
+    uInt size = (uInt)(bufsize > MAX_ZLIB_CHUNK ? MAX_ZLIB_CHUNK : bufsize);
+    zstream->next_out = reinterpret_cast<Bytef *>(buf);
+    zstream->avail_out = size;
+    while (zstream->avail_out > 0)
+    {
+        auto ret = inflate(zstream, Z_NO_FLUSH);
+        switch (ret)
+        {
+        case Z_NEED_DICT:
+        case Z_DATA_ERROR:
+        case Z_STREAM_ERROR:
+            throw IOException("Inflate failed: Z_DATA_ERROR");
+        case Z_MEM_ERROR:
+            throw MemoryException();
+        }
+        if (ret == Z_STREAM_END)
+        {
+            _end = true;
+            break;
+        }
+        // Output space left means all input has been consumed: return what is available instead of blocking on
+        // the underlying stream
+        if (zstream->avail_out == 0 || zstream->avail_out != size)
+            break;
+        if (!Fill())
+            throw IOException("Inflate failed: unexpected end of compressed stream");
+    }
+    return (size - zstream->avail_out);
+}
+
+uint32 InflateInputStream::GetAdler32() const
+{
+    z_stream_s *zstream = reinterpret_cast<z_stream_s *>(_handle);
+    return (zstream->adler);
+}
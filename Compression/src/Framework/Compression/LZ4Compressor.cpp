@@ -0,0 +1,143 @@
+// Copyright (c) 2020, BlockProject 3D
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without modification,
+// are permitted provided that the following conditions are met:
+// 
+//     * Redistributions of source code must retain the above copyright notice,
+//       this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above copyright notice,
+//       this list of conditions and the following disclaimer in the documentation
+//       and/or other materials provided with the distribution.
+//     * Neither the name of BlockProject 3D nor the names of its contributors
+//       may be used to endorse or promote products derived from this software
+//       without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#ifdef BPF_COMPRESSION_LZ4
+    #include "LZ4Compressor.hpp"
+    #include <Framework/IO/IOException.hpp>
+    #include <cstring>
+
+using namespace bpf::compression;
+using namespace bpf::io;
+using namespace bpf;
+
+/**
+ * LZ4 only uses the last 64 KB of a dictionary
+ */
+constexpr fsize MAX_LZ4_DICT = 64 * 1024;
+
+LZ4Compressor::LZ4Compressor(const int level)
+    : _stream(nullptr)
+    , _streamHC(nullptr)
+    , _level(level)
+    , _dict(0)
+    , _dictSize(0)
+{
+    if (level >= LZ4HC_CLEVEL_MIN)
+    {
+        _level = level > LZ4HC_CLEVEL_MAX ? LZ4HC_CLEVEL_MAX : level;
+        _streamHC = LZ4_createStreamHC();
+    }
+    else
+    {
+        // Below 1 the level is turned into the acceleration factor of the fast compressor
+        _level = level < 1 ? 1 - level : 1;
+        _stream = LZ4_createStream();
+    }
+    if (_stream == nullptr && _streamHC == nullptr)
+        throw IOException("Could not initialize LZ4");
+}
+
+LZ4Compressor::~LZ4Compressor()
+{
+    if (_stream != nullptr)
+        LZ4_freeStream(_stream);
+    if (_streamHC != nullptr)
+        LZ4_freeStreamHC(_streamHC);
+}
+
+fsize LZ4Compressor::GetBound(const fsize size) const noexcept
+{
+    if (size > LZ4_MAX_INPUT_SIZE)
+        return (0);
+    return (static_cast<fsize>(LZ4_compressBound(static_cast<int>(size))));
+}
+
+void LZ4Compressor::SetDictionary(const void *dict, fsize size)
+{
+    if (dict == nullptr || size == 0)
+    {
+        _dictSize = 0;
+        return;
+    }
+    if (size > MAX_LZ4_DICT)
+    {
+        dict = reinterpret_cast<const uint8 *>(dict) + size - MAX_LZ4_DICT;
+        size = MAX_LZ4_DICT;
+    }
+    _dict = ByteBuf(size);
+    std::memcpy(*_dict, dict, size);
+    _dictSize = static_cast<int>(size);
+}
+
+fsize LZ4Compressor::Compress(const void *in, const fsize inSize, void *out, fsize outSize)
+{
+    if (inSize > LZ4_MAX_INPUT_SIZE)
+        throw IOException("LZ4 failed: block too large");
+    if (outSize > LZ4_MAX_INPUT_SIZE)
+        outSize = LZ4_MAX_INPUT_SIZE;
+    auto *src = reinterpret_cast<const char *>(in);
+    auto *dst = reinterpret_cast<char *>(out);
+    int len;
+    if (_streamHC != nullptr)
+    {
+        LZ4_resetStreamHC_fast(_streamHC, _level);
+        if (_dictSize > 0)
+            LZ4_loadDictHC(_streamHC, reinterpret_cast<const char *>(*_dict), _dictSize);
+        len = LZ4_compress_HC_continue(_streamHC, src, dst, static_cast<int>(inSize), static_cast<int>(outSize));
+    }
+    else
+    {
+        LZ4_resetStream_fast(_stream);
+        if (_dictSize > 0)
+            LZ4_loadDict(_stream, reinterpret_cast<const char *>(*_dict), _dictSize);
+        len = LZ4_compress_fast_continue(_stream, src, dst, static_cast<int>(inSize), static_cast<int>(outSize), _level);
+    }
+    if (len <= 0 && inSize > 0)
+        throw IOException("LZ4 failed: output buffer too small");
+    return (static_cast<fsize>(len));
+}
+
+fsize LZ4Compressor::Decompress(const void *in, const fsize inSize, void *out, fsize outSize)
+{
+    if (inSize > LZ4_MAX_INPUT_SIZE)
+        throw IOException("LZ4 failed: block too large");
+    if (outSize > LZ4_MAX_INPUT_SIZE)
+        outSize = LZ4_MAX_INPUT_SIZE;
+    auto *src = reinterpret_cast<const char *>(in);
+    auto *dst = reinterpret_cast<char *>(out);
+    int len;
+    if (_dictSize > 0)
+        len = LZ4_decompress_safe_usingDict(src, dst, static_cast<int>(inSize), static_cast<int>(outSize),
+                                            reinterpret_cast<const char *>(*_dict), _dictSize);
+    else
+        len = LZ4_decompress_safe(src, dst, static_cast<int>(inSize), static_cast<int>(outSize));
+    if (len < 0)
+        throw IOException("LZ4 failed: corrupted block");
+    return (static_cast<fsize>(len));
+}
+#endif
@@ -40,6 +40,7 @@ using namespace bpf;
 ZDeflater::ZDeflater(const ECompressionLevel level)
     : _handle(Memory::Malloc(sizeof(z_stream_s)))
     , _input(0)
+    , _inputSize(0)
 {
     z_stream_s *stream = reinterpret_cast<z_stream_s *>(_handle);
     stream->zalloc = Z_NULL;
@@ -84,6 +85,7 @@ uint32 ZDeflater::GetAdler32() const
 void ZDeflater::SetInput(const io::ByteBuf &deflated)
 {
     _input = deflated;
+    _inputSize = _input.Size();
     z_stream_s *stream = reinterpret_cast<z_stream_s *>(_handle);
     stream->avail_in = (uInt)_input.Size();
     stream->next_in = *_input;
@@ -95,6 +97,7 @@ void ZDeflater::SetInput(const io::ByteBuf &deflated)
 void ZDeflater::SetInput(io::ByteBuf &&deflated)
 {
     _input = std::move(deflated);
+    _inputSize = _input.Size();
     z_stream_s *stream = reinterpret_cast<z_stream_s *>(_handle);
     stream->avail_in = (uInt)_input.Size();
     stream->next_in = *_input;
@@ -103,6 +106,18 @@ void ZDeflater::SetInput(io::ByteBuf &&deflated)
     stream->adler = 0;
 }
 
+void ZDeflater::SetInput(const void *inflated, fsize size)
+{
+    _input = ByteBuf(0);
+    _inputSize = size;
+    z_stream_s *stream = reinterpret_cast<z_stream_s *>(_handle);
+    stream->avail_in = (uInt)size;
+    stream->next_in = reinterpret_cast<Bytef *>(const_cast<void *>(inflated));
+    stream->total_in = 0;
+    stream->total_out = 0;
+    stream->adler = 0;
+}
+
 fsize ZDeflater::Deflate(io::ByteBuf &out)
 {
     return (Deflate(*out, out.Size()));
@@ -114,7 +129,7 @@ fsize ZDeflater::Deflate(void *out, const fsize size)
     stream->avail_out = (uInt)size;
     stream->next_out = reinterpret_cast<Bytef *>(out);
     int func = Z_NO_FLUSH;
-    if (stream->total_in >= _input.Size())
+    if (stream->total_in >= _inputSize)
         func = Z_FINISH;
     auto ret = deflate(stream, func);
     switch (ret)
@@ -93,6 +93,18 @@ void ZInflater::SetInput(io::ByteBuf &&deflated)
     _end = false;
 }
 
+void ZInflater::SetInput(const void *deflated, fsize size)
+{
+    _input = ByteBuf(0);
+    z_stream_s *stream = reinterpret_cast<z_stream_s *>(_handle);
+    stream->avail_in = (uInt)size;
+    stream->next_in = reinterpret_cast<Bytef *>(const_cast<void *>(deflated));
+    stream->total_in = 0;
+    stream->total_out = 0;
+    stream->adler = 0;
+    _end = false;
+}
+
 fsize ZInflater::Inflate(io::ByteBuf &out)
 {
     return (Inflate(*out, out.Size()));
@@ -0,0 +1,120 @@
+// Copyright (c) 2020, BlockProject 3D
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without modification,
+// are permitted provided that the following conditions are met:
+// 
+//     * Redistributions of source code must retain the above copyright notice,
+//       this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above copyright notice,
+//       this list of conditions and the following disclaimer in the documentation
+//       and/or other materials provided with the distribution.
+//     * Neither the name of BlockProject 3D nor the names of its contributors
+//       may be used to endorse or promote products derived from this software
+//       without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include "ZLibCompressor.hpp"
+#include <Framework/IO/IOException.hpp>
+#include <cstring>
+
+using namespace bpf::compression;
+using namespace bpf::io;
+using namespace bpf;
+
+/**
+ * Largest block handed to zlib at once, its counters are 32 bits
+ */
+constexpr fsize MAX_ZLIB_BLOCK = 0xFFFFFFFF;
+
+ZLibCompressor::ZLibCompressor(const int level)
+    : _dict(0)
+    , _dictSize(0)
+{
+    std::memset(&_deflate, 0, sizeof(z_stream_s));
+    std::memset(&_inflate, 0, sizeof(z_stream_s));
+    auto ret = deflateInit(&_deflate, level);
+    if (ret != Z_OK)
+        throw IOException(String("Could not initialize zlib: ") + String::ValueOf(ret));
+    ret = inflateInit(&_inflate);
+    if (ret != Z_OK)
+    {
+        deflateEnd(&_deflate);
+        throw IOException(String("Could not initialize zlib: ") + String::ValueOf(ret));
+    }
+}
+
+ZLibCompressor::~ZLibCompressor()
+{
+    deflateEnd(&_deflate);
+    inflateEnd(&_inflate);
+}
+
+fsize ZLibCompressor::GetBound(const fsize size) const noexcept
+{
+    return (compressBound((uLong)size));
+}
+
+void ZLibCompressor::SetDictionary(const void *dict, const fsize size)
+{
+    if (dict == nullptr || size == 0)
+    {
+        _dictSize = 0;
+        return;
+    }
+    if (size > MAX_ZLIB_BLOCK)
+        throw IOException("ZLib dictionary too large");
+    _dict = ByteBuf(size);
+    std::memcpy(*_dict, dict, size);
+    _dictSize = size;
+}
+
+fsize ZLibCompressor::Compress(const void *in, const fsize inSize, void *out, const fsize outSize)
+{
+    if (inSize > MAX_ZLIB_BLOCK)
+        throw IOException("Deflate failed: block too large");
+    deflateReset(&_deflate);
+    if (_dictSize > 0)
+        deflateSetDictionary(&_deflate, *_dict, (uInt)_dictSize);
+    _deflate.next_in = const_cast<Bytef *>(reinterpret_cast<const Bytef *>(in));
+    _deflate.avail_in = (uInt)inSize;
+    _deflate.next_out = reinterpret_cast<Bytef *>(out);
+    _deflate.avail_out = (uInt)(outSize > MAX_ZLIB_BLOCK ? MAX_ZLIB_BLOCK : outSize);
+    auto ret = deflate(&_deflate, Z_FINISH);
+    if (ret != Z_STREAM_END)
+        throw IOException("Deflate failed: output buffer too small");
+    return (_deflate.total_out);
+}
+
+fsize ZLibCompressor::Decompress(const void *in, const fsize inSize, void *out, const fsize outSize)
+{
+    if (inSize > MAX_ZLIB_BLOCK)
+        throw IOException("Inflate failed: block too large");
+    inflateReset(&_inflate);
+    _inflate.next_in = const_cast<Bytef *>(reinterpret_cast<const Bytef *>(in));
+    _inflate.avail_in = (uInt)inSize;
+    _inflate.next_out = reinterpret_cast<Bytef *>(out);
+    _inflate.avail_out = (uInt)(outSize > MAX_ZLIB_BLOCK ? MAX_ZLIB_BLOCK : outSize);
+    auto ret = inflate(&_inflate, Z_FINISH);
+    if (ret == Z_NEED_DICT && _dictSize > 0)
+    {
+        if (inflateSetDictionary(&_inflate, *_dict, (uInt)_dictSize) != Z_OK)
+            throw IOException("Inflate failed: wrong dictionary");
+        ret = inflate(&_inflate, Z_FINISH);
+    }
+    if (ret != Z_STREAM_END)
+        throw IOException(String("Inflate failed: ") + String::ValueOf(ret));
+    return (_inflate.total_out);
+}
@@ -0,0 +1,64 @@
+// Copyright (c) 2020, BlockProject 3D
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without modification,
+// are permitted provided that the following conditions are met:
+// 
+//     * Redistributions of source code must retain the above copyright notice,
+//       this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above copyright notice,
+//       this list of conditions and the following disclaimer in the documentation
+//       and/or other materials provided with the distribution.
+//     * Neither the name of BlockProject 3D nor the names of its contributors
+//       may be used to endorse or promote products derived from this software
+//       without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#pragma once
+#include "Framework/Compression/ICompressor.hpp"
+#include <Framework/IO/ByteBuf.hpp>
+#include <zlib.h>
+
+namespace bpf
+{
+    namespace compression
+    {
+        class ZLibCompressor final : public ICompressor
+        {
+        private:
+            z_stream_s _deflate;
+            z_stream_s _inflate;
+            io::ByteBuf _dict;
+            fsize _dictSize;
+
+        public:
+            explicit ZLibCompressor(int level);
+            ~ZLibCompressor();
+
+            ZLibCompressor(const ZLibCompressor &other) = delete;
+            ZLibCompressor &operator=(const ZLibCompressor &other) = delete;
+
+            ECompressionCodec GetCodec() const noexcept final
+            {
+                return (ECompressionCodec::ZLIB);
+            }
+
+            fsize GetBound(fsize size) const noexcept final;
+            void SetDictionary(const void *dict, fsize size) final;
+            fsize Compress(const void *in, fsize inSize, void *out, fsize outSize) final;
+            fsize Decompress(const void *in, fsize inSize, void *out, fsize outSize) final;
+        };
+    }
+}
@@ -0,0 +1,110 @@
+// Copyright (c) 2020, BlockProject 3D
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without modification,
+// are permitted provided that the following conditions are met:
+// 
+//     * Redistributions of source code must retain the above copyright notice,
+//       this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above copyright notice,
+//       this list of conditions and the following disclaimer in the documentation
+//       and/or other materials provided with the distribution.
+//     * Neither the name of BlockProject 3D nor the names of its contributors
+//       may be used to endorse or promote products derived from this software
+//       without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#ifdef BPF_COMPRESSION_ZSTD
+    #include "ZstdCompressor.hpp"
+    #include <Framework/IO/IOException.hpp>
+
+using namespace bpf::compression;
+using namespace bpf::io;
+using namespace bpf;
+
+ZstdCompressor::ZstdCompressor(const int level)
+    : _cctx(ZSTD_createCCtx())
+    , _dctx(ZSTD_createDCtx())
+    , _cdict(nullptr)
+    , _ddict(nullptr)
+    , _level(level)
+{
+    if (_cctx == nullptr || _dctx == nullptr)
+    {
+        ZSTD_freeCCtx(_cctx);
+        ZSTD_freeDCtx(_dctx);
+        throw IOException("Could not initialize Zstandard");
+    }
+}
+
+ZstdCompressor::~ZstdCompressor()
+{
+    FreeDictionary();
+    ZSTD_freeCCtx(_cctx);
+    ZSTD_freeDCtx(_dctx);
+}
+
+void ZstdCompressor::FreeDictionary()
+{
+    ZSTD_freeCDict(_cdict);
+    ZSTD_freeDDict(_ddict);
+    _cdict = nullptr;
+    _ddict = nullptr;
+}
+
+fsize ZstdCompressor::GetBound(const fsize size) const noexcept
+{
+    return (ZSTD_compressBound(size));
+}
+
+void ZstdCompressor::SetDictionary(const void *dict, const fsize size)
+{
+    FreeDictionary();
+    if (dict == nullptr || size == 0)
+        return;
+    // Both digested dictionaries copy the buffer
+    _cdict = ZSTD_createCDict(dict, size, _level);
+    _ddict = ZSTD_createDDict(dict, size);
+    if (_cdict == nullptr || _ddict == nullptr)
+    {
+        FreeDictionary();
+        throw IOException("Zstandard failed: could not load dictionary");
+    }
+}
+
+fsize ZstdCompressor::Compress(const void *in, const fsize inSize, void *out, const fsize outSize)
+{
+    size_t res;
+    if (_cdict != nullptr)
+        res = ZSTD_compress_usingCDict(_cctx, out, outSize, in, inSize, _cdict);
+    else
+        res = ZSTD_compressCCtx(_cctx, out, outSize, in, inSize, _level);
+    if (ZSTD_isError(res))
+        throw IOException(String("Zstandard failed: ") + ZSTD_getErrorName(res));
+    return (res);
+}
+
+fsize ZstdCompressor::Decompress(const void *in, const fsize inSize, void *out, const fsize outSize)
+{
+    size_t res;
+    if (_ddict != nullptr)
+        res = ZSTD_decompress_usingDDict(_dctx, out, outSize, in, inSize, _ddict);
+    else
+        res = ZSTD_decompressDCtx(_dctx, out, outSize, in, inSize);
+    if (ZSTD_isError(res))
+        throw IOException(String("Zstandard failed: ") + ZSTD_getErrorName(res));
+    return (res);
+}
+#endif
@@ -0,0 +1,68 @@
+// Copyright (c) 2020, BlockProject 3D
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without modification,
+// are permitted provided that the following conditions are met:
+// 
+//     * Redistributions of source code must retain the above copyright notice,
+//       this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above copyright notice,
+//       this list of conditions and the following disclaimer in the documentation
+//       and/or other materials provided with the distribution.
+//     * Neither the name of BlockProject 3D nor the names of its contributors
+//       may be used to endorse or promote products derived from this software
+//       without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#pragma once
+#ifdef BPF_COMPRESSION_ZSTD
+    #include "Framework/Compression/ICompressor.hpp"
+    #include <zstd.h>
+
+namespace bpf
+{
+    namespace compression
+    {
+        class ZstdCompressor final : public ICompressor
+        {
+        private:
+            ZSTD_CCtx *_cctx;
+            ZSTD_DCtx *_dctx;
+            ZSTD_CDict *_cdict;
+            ZSTD_DDict *_ddict;
+            int _level;
+
+            void FreeDictionary();
+
+        public:
+            explicit ZstdCompressor(int level);
+            ~ZstdCompressor();
+
+            ZstdCompressor(const ZstdCompressor &other) = delete;
+            ZstdCompressor &operator=(const ZstdCompressor &other) = delete;
+
+            ECompressionCodec GetCodec() const noexcept final
+            {
+                return (ECompressionCodec::ZSTD);
+            }
+
+            fsize GetBound(fsize size) const noexcept final;
+            void SetDictionary(const void *dict, fsize size) final;
+            fsize Compress(const void *in, fsize inSize, void *out, fsize outSize) final;
+            fsize Decompress(const void *in, fsize inSize, void *out, fsize outSize) final;
+        };
+    }
+}
+#endif
@@ -29,6 +29,7 @@
 #include <iostream>
 #include <gtest/gtest.h>
 #include <Framework/BaseConvert.hpp>
+#include <cstring>
 
 TEST(BaseConvert, FromStringBin)
 {
@@ -87,3 +88,80 @@ TEST(BaseConvert, ToStringHex)
 	EXPECT_STREQ(*bin.ToString(5), "5");
 	EXPECT_STREQ(*bin.ToString(175), "AF");
 }
+
+TEST(BaseConvert, Decimal)
+{
+	bpf::BaseConvert<bpf::uint64> dec("0123456789");
+
+	EXPECT_EQ(dec.GetBitsPerDigit(), 0U);
+	EXPECT_EQ(dec.FromString("18446744073709551615"), 18446744073709551615ULL);
+	EXPECT_STREQ(*dec.ToString(18446744073709551615ULL), "18446744073709551615");
+	EXPECT_STREQ(*dec.ToString(0), "0");
+	EXPECT_THROW(dec.FromString("18446744073709551616"), bpf::ParseException);
+	EXPECT_THROW(dec.FromString("12a"), bpf::ParseException);
+}
+
+TEST(BaseConvert, Overflow)
+{
+	bpf::BaseConvert<bpf::fint> hex("0123456789ABCDEF");
+
+	EXPECT_EQ(hex.FromString("7FFFFFFF"), 2147483647);
+	EXPECT_THROW(hex.FromString("80000000"), bpf::ParseException);
+	EXPECT_THROW(hex.FromString("af"), bpf::ParseException);
+	EXPECT_STREQ(*hex.ToString(-1), "");
+}
+
+TEST(BaseConvert, Unicode)
+{
+	bpf::BaseConvert<bpf::fint> base("aéb");
+
+	EXPECT_STREQ(*base.ToString(0), "a");
+	EXPECT_STREQ(*base.ToString(5), "éb");
+	EXPECT_EQ(base.FromString("éb"), 5);
+	EXPECT_EQ(base.FromString(base.ToString(123456)), 123456);
+	EXPECT_THROW(base.FromString("c"), bpf::ParseException);
+}
+
+TEST(BaseConvert, Base64)
+{
+	bpf::BaseConvert<bpf::uint64> b64("ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/");
+	char out[16];
+	bpf::uint8 back[16];
+
+	EXPECT_EQ(b64.GetBitsPerDigit(), 6U);
+	EXPECT_EQ(b64.GetEncodedSize(3), 4U);
+	EXPECT_EQ(b64.Encode("Man", 3, out), 4U);
+	EXPECT_EQ(std::memcmp(out, "TWFu", 4), 0);
+	EXPECT_EQ(b64.Encode("Ma", 2, out), 3U);
+	EXPECT_EQ(std::memcmp(out, "TWE", 3), 0);
+	EXPECT_EQ(b64.Decode("TWFu", 4, back), 3U);
+	EXPECT_EQ(std::memcmp(back, "Man", 3), 0);
+	EXPECT_EQ(b64.Decode("TWE", 3, back), 2U);
+	EXPECT_EQ(std::memcmp(back, "Ma", 2), 0);
+	EXPECT_THROW(b64.Decode("TW=", 3, back), bpf::ParseException);
+	EXPECT_STREQ(*b64.ToString(4095), "//");
+	EXPECT_EQ(b64.FromString("//"), 4095U);
+}
+
+TEST(BaseConvert, Base32)
+{
+	bpf::BaseConvert<bpf::uint32> b32("ABCDEFGHIJKLMNOPQRSTUVWXYZ234567");
+	bpf::BaseConvert<bpf::uint32> oct("01234567");
+	bpf::BaseConvert<bpf::uint32> dec("0123456789");
+	char out[64];
+	bpf::uint8 data[19];
+	bpf::uint8 back[19];
+
+	EXPECT_EQ(b32.Encode("foobar", 6, out), 10U);
+	EXPECT_EQ(std::memcmp(out, "MZXW6YTBOI", 10), 0);
+	for (bpf::uint8 i = 0; i != 19; ++i)
+		data[i] = static_cast<bpf::uint8>(i * 37 + 11);
+	for (bpf::fsize size = 0; size != 19; ++size)
+	{
+		bpf::fsize len = oct.Encode(data, size, out);
+		EXPECT_EQ(len, oct.GetEncodedSize(size));
+		EXPECT_EQ(oct.Decode(out, len, back), size);
+		EXPECT_EQ(std::memcmp(back, data, size), 0);
+	}
+	EXPECT_THROW(dec.Encode(data, 1, out), bpf::RuntimeException);
+}
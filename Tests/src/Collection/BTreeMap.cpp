@@ -0,0 +1,339 @@
+// Copyright (c) 2020, BlockProject 3D
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without modification,
+// are permitted provided that the following conditions are met:
+// 
+//     * Redistributions of source code must retain the above copyright notice,
+//       this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above copyright notice,
+//       this list of conditions and the following disclaimer in the documentation
+//       and/or other materials provided with the distribution.
+//     * Neither the name of BlockProject 3D nor the names of its contributors
+//       may be used to endorse or promote products derived from this software
+//       without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include <cassert>
+#include <iostream>
+#include <map>
+#include <gtest/gtest.h>
+#include <Framework/Collection/ArrayList.hpp>
+#include <Framework/Collection/BTreeMap.hpp>
+#include <Framework/Collection/Stringifier.BTreeMap.hpp>
+
+using namespace bpf::collection;
+using namespace bpf;
+
+template <typename K, typename V>
+static void CheckSame(const BTreeMap<K, V> &map, const std::map<K, V> &ref)
+{
+    EXPECT_EQ(map.Size(), ref.size());
+    auto it = ref.begin();
+    for (auto &entry : map)
+    {
+        ASSERT_TRUE(it != ref.end());
+        EXPECT_EQ(entry.Key, it->first);
+        EXPECT_EQ(entry.Value, it->second);
+        ++it;
+    }
+    EXPECT_TRUE(it == ref.end());
+    auto rit = ref.rbegin();
+    for (auto i = map.rbegin(); i != map.rend(); ++i)
+    {
+        ASSERT_TRUE(rit != ref.rend());
+        EXPECT_EQ(i->Key, rit->first);
+        ++rit;
+    }
+    EXPECT_TRUE(rit == ref.rend());
+}
+
+TEST(BTreeMap, Creation_1)
+{
+    BTreeMap<String, int> map;
+
+    map["test1"] = 0;
+    map["test2"] = 3;
+    map["test3"] = 7;
+    EXPECT_EQ(map.Size(), 3U);
+    EXPECT_EQ(map["test2"], 3);
+}
+
+TEST(BTreeMap, Creation_List)
+{
+    BTreeMap<int, int> lst = { { 0, 0 }, { 1, 3 }, { 2, 7 } };
+    BTreeMap<int, int> lst1 = { { 2, 7 }, { 0, 0 }, { 1, 3 }, { 1, 4 } };
+
+    EXPECT_EQ(lst[0], 0);
+    EXPECT_EQ(lst[1], 3);
+    EXPECT_EQ(lst[2], 7);
+    EXPECT_STREQ(*String::ValueOf(lst1), "{'0': 0, '1': 4, '2': 7}");
+}
+
+TEST(BTreeMap, Add)
+{
+    BTreeMap<int, int> lst = { { 0, 0 }, { 1, 1 } };
+
+    lst.Add(2, 2);
+    lst.Add(3, 3);
+    lst.Add(-2, -2);
+    lst.Add(-1, -1);
+    lst.Add(3, 4);
+    EXPECT_EQ(lst.Size(), 6U);
+    EXPECT_STREQ(*String::ValueOf(lst), "{'-2': -2, '-1': -1, '0': 0, '1': 1, '2': 2, '3': 4}");
+    const auto &clst = lst;
+    EXPECT_THROW(clst[42], IndexException);
+}
+
+TEST(BTreeMap, FindByKey)
+{
+    BTreeMap<int, int> lst = { { 0, 0 }, { 1, 3 }, { 2, 7 } };
+
+    EXPECT_EQ(lst.begin(), lst.FindByKey(0));
+    EXPECT_EQ(--lst.end(), lst.FindByKey(2));
+    EXPECT_EQ(lst.end(), lst.FindByKey(3));
+    EXPECT_EQ(lst.end(), lst.FindByKey(-1));
+    EXPECT_EQ(--lst.end(), lst.FindByValue(7));
+    EXPECT_EQ(lst.FindMin()->Key, 0);
+    EXPECT_EQ(lst.FindMax()->Key, 2);
+}
+
+TEST(BTreeMap, Bounds)
+{
+    BTreeMap<int, int> map;
+
+    for (int i = 0; i != 1000; ++i)
+        map.Add(i * 2, i);
+    EXPECT_EQ(map.LowerBound(10)->Key, 10);
+    EXPECT_EQ(map.LowerBound(11)->Key, 12);
+    EXPECT_EQ(map.UpperBound(10)->Key, 12);
+    EXPECT_EQ(map.LowerBound(-5), map.begin());
+    EXPECT_EQ(map.LowerBound(1998)->Key, 1998);
+    EXPECT_EQ(map.UpperBound(1998), map.end());
+    EXPECT_EQ(map.LowerBound(5000), map.end());
+    int expected = 100;
+    fsize count = 0;
+    for (auto &entry : map.Range(100, 301))
+    {
+        EXPECT_EQ(entry.Key, expected);
+        expected += 2;
+        ++count;
+    }
+    EXPECT_EQ(count, 101U);
+    const auto &cmap = map;
+    count = 0;
+    for (auto &entry : cmap.Range(301, 100))
+    {
+        (void)entry;
+        ++count;
+    }
+    EXPECT_EQ(count, 0U);
+}
+
+TEST(BTreeMap, BulkLoad)
+{
+    for (fsize n : {0, 1, 7, 100, 5000, 100000})
+    {
+        ArrayList<BTreeMap<int, int>::Entry> entries;
+        std::map<int, int> ref;
+        for (fsize i = 0; i != n; ++i)
+        {
+            entries.Add({(int)i * 3, (int)i});
+            ref[(int)i * 3] = (int)i;
+        }
+        BTreeMap<int, int> map;
+        map.BulkLoad(n > 0 ? &entries[0] : nullptr, n);
+        CheckSame(map, ref);
+        for (fsize i = 0; i < n; i += 7)
+        {
+            map.Add((int)i * 3 + 1, 0);
+            ref[(int)i * 3 + 1] = 0;
+        }
+        for (fsize i = 0; i < n; i += 3)
+        {
+            map.RemoveAt((int)i * 3);
+            ref.erase((int)i * 3);
+        }
+        CheckSame(map, ref);
+    }
+    BTreeMap<int, int>::Entry unsorted[] = { { 3, 0 }, { 1, 1 }, { 2, 2 }, { 1, 3 } };
+    BTreeMap<int, int> map;
+    map.BulkLoad(unsorted, 4);
+    EXPECT_STREQ(*String::ValueOf(map), "{'1': 3, '2': 2, '3': 0}");
+}
+
+TEST(BTreeMap, Random)
+{
+    BTreeMap<int, int> map;
+    std::map<int, int> ref;
+    uint32 state = 42;
+
+    for (int i = 0; i != 200000; ++i)
+    {
+        state = state * 1103515245 + 12345;
+        int key = (int)((state >> 8) % 20000);
+        if ((state >> 4) % 3 == 0)
+        {
+            map.RemoveAt(key);
+            ref.erase(key);
+        }
+        else
+        {
+            map.Add(key, i);
+            ref[key] = i;
+        }
+    }
+    CheckSame(map, ref);
+    EXPECT_GT(map.Height(), 1U);
+    for (auto &entry : ref)
+        map.RemoveAt(entry.first);
+    EXPECT_EQ(map.Size(), 0U);
+    EXPECT_EQ(map.Height(), 0U);
+    EXPECT_EQ(map.begin(), map.end());
+}
+
+TEST(BTreeMap, Equal)
+{
+    BTreeMap<int, int> lst = { { 0, 0 }, { 1, 3 }, { 2, 7 } };
+    BTreeMap<int, int> lst1 = { { 0, 0 }, { 1, 3 }, { 2, 7 } };
+    BTreeMap<int, int> lst2 = { { 0, 0 }, { 1, 3 } };
+    BTreeMap<int, int> lst3 = { { 0, 0 }, { 1, 3 }, { 2, 4 } };
+
+    EXPECT_TRUE(lst == lst1);
+    EXPECT_FALSE(lst != lst1);
+    EXPECT_FALSE(lst == lst2);
+    EXPECT_TRUE(lst != lst2);
+    EXPECT_FALSE(lst == lst3);
+    EXPECT_TRUE(lst != lst3);
+}
+
+TEST(BTreeMap, Concatenate)
+{
+    BTreeMap<int, int> lst = { { 0, 0 }, { 1, 3 }, { 2, 7 } };
+    BTreeMap<int, int> lst1 = { { 3, 0 }, { 1, 5 }, { 4, 7 } };
+
+    auto concatenated = lst + lst1;
+    EXPECT_STREQ(*String::ValueOf(concatenated), "{'0': 0, '1': 5, '2': 7, '3': 0, '4': 7}");
+    lst1 += lst;
+    EXPECT_STREQ(*String::ValueOf(lst1), "{'0': 0, '1': 3, '2': 7, '3': 0, '4': 7}");
+}
+
+TEST(BTreeMap, CopyMove)
+{
+    BTreeMap<String, String> lst;
+
+    for (int i = 0; i != 500; ++i)
+        lst.Add(String::ValueOf(i), String::ValueOf(i * 2));
+    auto copy = lst;
+    EXPECT_TRUE(copy == lst);
+    EXPECT_EQ(copy["42"], "84");
+    auto mv = std::move(copy);
+    EXPECT_EQ(copy.Size(), 0U);
+    EXPECT_EQ(copy.begin(), copy.end());
+    EXPECT_TRUE(mv == lst);
+    copy = mv;
+    EXPECT_TRUE(copy == lst);
+}
+
+TEST(BTreeMap, Remove)
+{
+    BTreeMap<int, int> lst = { { 0, 0 }, { 1, 3 }, { 2, 7 }, { 3, 0 } };
+
+    lst.Remove(0, false);
+    EXPECT_STREQ(*String::ValueOf(lst), "{'1': 3, '2': 7, '3': 0}");
+    lst.Add(0, 0);
+    lst.Remove(0);
+    EXPECT_STREQ(*String::ValueOf(lst), "{'1': 3, '2': 7}");
+    lst.Remove<ops::Less>(7);
+    EXPECT_STREQ(*String::ValueOf(lst), "{'2': 7}");
+}
+
+TEST(BTreeMap, RemoveAt)
+{
+    BTreeMap<int, int> lst = { { 0, 0 }, { 1, 3 }, { 2, 7 }, { 3, 0 } };
+
+    lst.RemoveAt(2);
+    EXPECT_STREQ(*String::ValueOf(lst), "{'0': 0, '1': 3, '3': 0}");
+    lst.RemoveAt(++lst.begin());
+    EXPECT_STREQ(*String::ValueOf(lst), "{'0': 0, '3': 0}");
+    auto it = lst.begin();
+    lst.RemoveAt(it);
+    EXPECT_STREQ(*String::ValueOf(lst), "{'3': 0}");
+    EXPECT_EQ(it->Key, 3);
+    lst.RemoveAt(--lst.end());
+    EXPECT_STREQ(*String::ValueOf(lst), "{}");
+    lst.RemoveAt(lst.end());
+    BTreeMap<int, int> map;
+    for (int i = 0; i != 1000; ++i)
+        map.Add(i, i);
+    auto pos = map.begin();
+    while (pos != map.end())
+    {
+        if (pos->Key % 2 == 0)
+            map.RemoveAt(pos);
+        else
+            ++pos;
+    }
+    EXPECT_EQ(map.Size(), 500U);
+    EXPECT_EQ(map.begin()->Key, 1);
+}
+
+TEST(BTreeMap, Iterator)
+{
+    BTreeMap<int, int> lst = { { 0, 0 }, { 1, 3 }, { 2, 7 }, { 3, 0 } };
+
+    auto it = lst.begin();
+    ++it;
+    --it;
+    EXPECT_EQ(it, lst.begin());
+    --it;
+    ++it;
+    EXPECT_EQ(it, ++lst.begin());
+    it = lst.end();
+    --it;
+    ++it;
+    EXPECT_EQ(it, lst.end());
+    ++it;
+    --it;
+    EXPECT_EQ(it, --lst.end());
+    it = lst.begin();
+    it += 42;
+    EXPECT_EQ(it, lst.end());
+    it -= 42;
+    EXPECT_EQ(it->Value, 0);
+}
+
+TEST(BTreeMap, ReverseIterator)
+{
+    BTreeMap<int, int> lst = { { 0, 0 }, { 1, 3 }, { 2, 7 }, { 3, 0 } };
+
+    auto it = lst.rbegin();
+    ++it;
+    --it;
+    EXPECT_EQ(it, lst.rbegin());
+    --it;
+    ++it;
+    EXPECT_EQ(it, ++lst.rbegin());
+    it = lst.rend();
+    --it;
+    ++it;
+    EXPECT_EQ(it, lst.rend());
+    ++it;
+    --it;
+    EXPECT_EQ(it, --lst.rend());
+    EXPECT_EQ(lst.rbegin()->Key, 3);
+    const auto &map = lst;
+    EXPECT_EQ((--map.rend())->Key, 0);
+}
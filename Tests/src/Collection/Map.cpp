@@ -719,3 +719,21 @@ TEST(Map, Swap_Err_2)
     lst.Swap(--lst.end(), --lst.end());
     EXPECT_STREQ(*String::ValueOf(lst), "{'0': 0, '1': 7}");
 }
+
+TEST(Map, RemoveAt_Many)
+{
+    Map<int, int> map;
+
+    for (int i = 0; i != 10000; ++i)
+        map.Add((i * 7919) % 10000, i);
+    for (int i = 0; i != 10000; i += 2)
+        map.RemoveAt(i);
+    EXPECT_EQ(map.Size(), 5000U);
+    int expected = 1;
+    for (auto &entry : map)
+    {
+        EXPECT_EQ(entry.Key, expected);
+        expected += 2;
+    }
+    EXPECT_EQ(expected, 10001);
+}
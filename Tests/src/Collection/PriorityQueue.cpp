@@ -28,6 +28,8 @@
 
 #include <cassert>
 #include <iostream>
+#include <random>
+#include <set>
 #include <gtest/gtest.h>
 #include <Framework/Collection/PriorityQueue.hpp>
 #include <Framework/Memory/Utility.hpp>
@@ -154,4 +156,126 @@ TEST(PriorityQueue, Push_Pop_NonCopy)
     EXPECT_EQ(*queue.Pop(), 1);
     EXPECT_EQ(*queue.Pop(), 42);
     EXPECT_THROW(queue.Pop(), IndexException);
-}
\ No newline at end of file
+}
+
+TEST(PriorityQueue, Emplace_NonDefault)
+{
+    struct Item
+    {
+        int A;
+        int B;
+
+        Item(int a, int b)
+            : A(a)
+            , B(b)
+        {
+        }
+    };
+    PriorityQueue<int, Item, MinHeap> queue;
+
+    queue.Emplace(3, 1, 2);
+    queue.Emplace(1, 3, 4);
+    EXPECT_EQ(queue.Top().A, 3);
+    EXPECT_EQ(queue.TopKey(), 1);
+    EXPECT_EQ(queue.Pop().B, 4);
+    EXPECT_EQ(queue.Pop().B, 2);
+    EXPECT_EQ(queue.Size(), 0U);
+}
+
+TEST(PriorityQueue, Random_MaxHeap)
+{
+    PriorityQueue<int, int> queue;
+    std::multiset<int> ref;
+    std::mt19937 rng(7);
+
+    queue.Reserve(100);
+    EXPECT_GE(queue.Capacity(), 100U);
+    for (int i = 0; i != 5000; ++i)
+    {
+        if (rng() % 3 != 0 || ref.empty())
+        {
+            int v = static_cast<int>(rng() % 1000);
+            queue.Push(v, v);
+            ref.insert(v);
+        }
+        else
+        {
+            EXPECT_EQ(queue.Pop(), *ref.rbegin());
+            ref.erase(std::prev(ref.end()));
+        }
+        EXPECT_EQ(queue.Size(), ref.size());
+    }
+    auto copy = queue;
+    fsize size = queue.Size();
+    while (!ref.empty())
+    {
+        EXPECT_EQ(copy.Pop(), *ref.rbegin());
+        ref.erase(std::prev(ref.end()));
+    }
+    EXPECT_EQ(copy.Size(), 0U);
+    EXPECT_EQ(queue.Size(), size);
+}
+
+TEST(PriorityQueue, Indexed_UpdatePriority)
+{
+    PriorityQueue<int, int, MinHeap, true> queue;
+    PriorityQueue<int, int, MinHeap, true>::Handle handles[10];
+
+    for (int i = 0; i != 10; ++i)
+        handles[i] = queue.Push(i * 10, i);
+    EXPECT_EQ(queue.Top(), 0);
+    queue.UpdatePriority(handles[7], -5);
+    EXPECT_EQ(queue.Top(), 7);
+    queue.UpdatePriority(handles[7], 1000);
+    EXPECT_EQ(queue.Top(), 0);
+    queue.UpdatePriority(handles[0], 55);
+    EXPECT_EQ(queue.Pop(), 1);
+    EXPECT_FALSE(queue.Contains(handles[1]));
+    EXPECT_TRUE(queue.Contains(handles[0]));
+    EXPECT_THROW(queue.UpdatePriority(handles[1], 0), IndexException);
+    int expected[] = {2, 3, 4, 5, 0, 6, 8, 9, 7};
+    for (int v : expected)
+        EXPECT_EQ(queue.Pop(), v);
+    EXPECT_EQ(queue.Size(), 0U);
+}
+
+TEST(PriorityQueue, Indexed_Remove)
+{
+    PriorityQueue<int, UniquePtr<int>, MinHeap, true> queue;
+    std::mt19937 rng(3);
+    std::set<std::pair<int, int>> ref;
+    PriorityQueue<int, UniquePtr<int>, MinHeap, true>::Handle handles[200];
+
+    for (int i = 0; i != 200; ++i)
+    {
+        int key = static_cast<int>(rng() % 50);
+        handles[i] = queue.Emplace(key, MakeUnique<int>(i));
+        ref.insert({key, i});
+    }
+    for (int i = 0; i < 200; i += 3)
+    {
+        auto ptr = queue.Remove(handles[i]);
+        EXPECT_EQ(*ptr, i);
+        EXPECT_FALSE(queue.Contains(handles[i]));
+        for (auto it = ref.begin(); it != ref.end(); ++it)
+        {
+            if (it->second == i)
+            {
+                ref.erase(it);
+                break;
+            }
+        }
+    }
+    EXPECT_EQ(queue.Size(), ref.size());
+    // Freed handles are reused
+    auto handle = queue.Emplace(-1, MakeUnique<int>(-1));
+    EXPECT_TRUE(queue.Contains(handle));
+    EXPECT_EQ(*queue.Pop(), -1);
+    while (queue.Size() > 0)
+    {
+        int key = queue.TopKey();
+        EXPECT_EQ(key, ref.begin()->first);
+        queue.Pop();
+        ref.erase(ref.begin());
+    }
+}
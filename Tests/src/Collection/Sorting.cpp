@@ -0,0 +1,280 @@
+// Copyright (c) 2020, BlockProject 3D
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without modification,
+// are permitted provided that the following conditions are met:
+// 
+//     * Redistributions of source code must retain the above copyright notice,
+//       this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above copyright notice,
+//       this list of conditions and the following disclaimer in the documentation
+//       and/or other materials provided with the distribution.
+//     * Neither the name of BlockProject 3D nor the names of its contributors
+//       may be used to endorse or promote products derived from this software
+//       without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include <algorithm>
+#include <cassert>
+#include <iostream>
+#include <random>
+#include <vector>
+#include <gtest/gtest.h>
+#include <Framework/Collection/Array.hpp>
+#include <Framework/Collection/ArrayList.hpp>
+#include <Framework/Collection/List.hpp>
+#include <Framework/Collection/Sorting.hpp>
+#include <Framework/System/ThreadPool.hpp>
+
+using namespace bpf::collection;
+using namespace bpf;
+
+struct Record
+{
+    int Key;
+    int Order;
+
+    bool operator<(const Record &other) const
+    {
+        return (Key < other.Key);
+    }
+
+    bool operator>(const Record &other) const
+    {
+        return (Key > other.Key);
+    }
+};
+
+static std::vector<int> Generate(const fsize count, const int pattern)
+{
+    std::mt19937 rng(static_cast<unsigned>(count * 31 + pattern));
+    std::vector<int> values(count);
+    for (fsize i = 0; i != count; ++i)
+    {
+        switch (pattern)
+        {
+        case 0:
+            values[i] = static_cast<int>(rng());
+            break;
+        case 1:
+            values[i] = static_cast<int>(i);
+            break;
+        case 2:
+            values[i] = static_cast<int>(count - i);
+            break;
+        case 3:
+            values[i] = 42;
+            break;
+        case 4:
+            values[i] = static_cast<int>(rng() % 4);
+            break;
+        default:
+            values[i] = i % 64 == 0 ? static_cast<int>(rng()) : static_cast<int>(i);
+            break;
+        }
+    }
+    return (values);
+}
+
+static std::vector<Record> GenerateRecords(const fsize count, const int distinct)
+{
+    std::mt19937 rng(static_cast<unsigned>(count + distinct));
+    std::vector<Record> values(count);
+    for (fsize i = 0; i != count; ++i)
+        values[i] = Record{static_cast<int>(rng() % distinct), static_cast<int>(i)};
+    return (values);
+}
+
+static const fsize SIZES[] = {0, 1, 2, 7, 23, 24, 100, 129, 1000, 5000, 70000};
+
+TEST(Sorting, Unstable)
+{
+    for (auto size : SIZES)
+    {
+        for (int pattern = 0; pattern != 6; ++pattern)
+        {
+            auto values = Generate(size, pattern);
+            auto expected = values;
+            std::sort(expected.begin(), expected.end());
+            Sorting::Unstable(values.data(), size);
+            EXPECT_EQ(values, expected);
+            std::sort(expected.begin(), expected.end(), [](int a, int b) { return (a > b); });
+            Sorting::Unstable<ops::Greater>(values.data(), size);
+            EXPECT_EQ(values, expected);
+        }
+    }
+}
+
+TEST(Sorting, Unstable_Records)
+{
+    for (auto size : SIZES)
+    {
+        auto values = GenerateRecords(size, 16);
+        Sorting::Unstable(values.data(), size);
+        for (fsize i = 1; i < size; ++i)
+            EXPECT_LE(values[i - 1].Key, values[i].Key);
+    }
+}
+
+TEST(Sorting, Unstable_Adversarial)
+{
+    // Organ pipe and sawtooth inputs defeat naive pivot selection
+    std::vector<Record> values(20000);
+    for (fsize i = 0; i != values.size(); ++i)
+        values[i] = Record{static_cast<int>(i < 10000 ? i : 20000 - i), 0};
+    Sorting::Unstable(values.data(), values.size());
+    for (fsize i = 1; i < values.size(); ++i)
+        EXPECT_LE(values[i - 1].Key, values[i].Key);
+    for (fsize i = 0; i != values.size(); ++i)
+        values[i] = Record{static_cast<int>(i % 100), 0};
+    Sorting::Unstable(values.data(), values.size());
+    for (fsize i = 1; i < values.size(); ++i)
+        EXPECT_LE(values[i - 1].Key, values[i].Key);
+}
+
+TEST(Sorting, Stable)
+{
+    for (auto size : SIZES)
+    {
+        for (int distinct : {1, 4, 1000})
+        {
+            auto values = GenerateRecords(size, distinct);
+            auto expected = values;
+            std::stable_sort(expected.begin(), expected.end());
+            Sorting::Stable(values.data(), size);
+            for (fsize i = 0; i != size; ++i)
+            {
+                EXPECT_EQ(values[i].Key, expected[i].Key);
+                EXPECT_EQ(values[i].Order, expected[i].Order);
+            }
+            std::stable_sort(expected.begin(), expected.end(), [](const Record &a, const Record &b) { return (a > b); });
+            Sorting::Stable<ops::Greater>(values.data(), size);
+            for (fsize i = 0; i != size; ++i)
+                EXPECT_EQ(values[i].Order, expected[i].Order);
+        }
+    }
+}
+
+TEST(Sorting, Stable_Scratch)
+{
+    Array<Record> scratch(2501);
+    for (int pass = 0; pass != 3; ++pass)
+    {
+        auto values = GenerateRecords(5000, 10 + pass);
+        auto expected = values;
+        std::stable_sort(expected.begin(), expected.end());
+        Sorting::Stable(values.data(), values.size(), *scratch);
+        for (fsize i = 0; i != values.size(); ++i)
+            EXPECT_EQ(values[i].Order, expected[i].Order);
+    }
+}
+
+TEST(Sorting, Radix_Integers)
+{
+    std::mt19937_64 rng(1);
+    std::vector<int64> values(10000);
+    for (auto &v : values)
+        v = static_cast<int64>(rng());
+    values[0] = 0;
+    values[1] = -1;
+    auto expected = values;
+    std::sort(expected.begin(), expected.end());
+    Sorting::Radix(values.data(), values.size());
+    EXPECT_EQ(values, expected);
+    std::vector<uint8> bytes(1000);
+    for (auto &v : bytes)
+        v = static_cast<uint8>(rng());
+    auto expectedBytes = bytes;
+    std::sort(expectedBytes.begin(), expectedBytes.end());
+    Sorting::Radix(bytes.data(), bytes.size());
+    EXPECT_EQ(bytes, expectedBytes);
+}
+
+TEST(Sorting, Radix_Floats)
+{
+    std::mt19937 rng(2);
+    std::uniform_real_distribution<double> dist(-1e6, 1e6);
+    std::vector<double> values(5000);
+    for (auto &v : values)
+        v = dist(rng);
+    values[0] = 0.0;
+    values[1] = -1e-300;
+    values[2] = 1e-300;
+    auto expected = values;
+    std::sort(expected.begin(), expected.end());
+    std::vector<double> scratch(values.size());
+    Sorting::Radix(values.data(), values.size(), scratch.data());
+    EXPECT_EQ(values, expected);
+    std::vector<float> floats(3000);
+    for (auto &v : floats)
+        v = static_cast<float>(dist(rng));
+    auto expectedFloats = floats;
+    std::sort(expectedFloats.begin(), expectedFloats.end(), [](float a, float b) { return (a > b); });
+    Sorting::Unstable<ops::Greater>(floats.data(), floats.size());
+    EXPECT_EQ(floats, expectedFloats);
+}
+
+TEST(Sorting, Parallel)
+{
+    system::ThreadPool pool(3);
+    for (fsize size : {fsize(1000), fsize(100000), fsize(250001)})
+    {
+        auto values = Generate(size, 0);
+        auto expected = values;
+        std::sort(expected.begin(), expected.end());
+        Sorting::Parallel(pool, values.data(), size);
+        EXPECT_EQ(values, expected);
+        auto records = GenerateRecords(size, 100);
+        auto expectedRecords = records;
+        std::stable_sort(expectedRecords.begin(), expectedRecords.end());
+        Sorting::Parallel(pool, records.data(), size, true);
+        for (fsize i = 0; i != size; ++i)
+            EXPECT_EQ(records[i].Order, expectedRecords[i].Order);
+    }
+}
+
+TEST(Sorting, Collections)
+{
+    system::ThreadPool pool(2);
+    auto values = Generate(50000, 0);
+    auto expected = values;
+    std::sort(expected.begin(), expected.end());
+
+    ArrayList<int> lst;
+    Array<int> arr(values.size());
+    List<int> list;
+    for (fsize i = 0; i != values.size(); ++i)
+    {
+        lst.Add(values[i]);
+        arr[i] = values[i];
+        list.Add(values[i]);
+    }
+    lst.Sort(pool);
+    arr.Sort(pool, true);
+    list.Sort();
+    fsize i = 0;
+    for (auto &v : list)
+    {
+        EXPECT_EQ(lst[i], expected[i]);
+        EXPECT_EQ(arr[i], expected[i]);
+        EXPECT_EQ(v, expected[i]);
+        ++i;
+    }
+
+    Array<int, 8> fixed = {5, 3, 8, 1, 9, 2, 7, 4};
+    fixed.Sort<ops::Greater>();
+    EXPECT_EQ(fixed[0], 9);
+    EXPECT_EQ(fixed[7], 1);
+}
@@ -26,10 +26,19 @@
 // NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
 // SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
+#include <Framework/Compression/BlockDeflateOutputStream.hpp>
+#include <Framework/Compression/BlockInflateInputStream.hpp>
+#include <Framework/Compression/Compressor.hpp>
+#include <Framework/Compression/DeflateOutputStream.hpp>
+#include <Framework/Compression/InflateInputStream.hpp>
 #include <Framework/Compression/ZDeflater.hpp>
 #include <Framework/Compression/ZInflater.hpp>
+#include <Framework/IO/BinaryReader.hpp>
+#include <Framework/IO/BinaryWriter.hpp>
+#include <Framework/IO/FileStream.hpp>
 #include <Framework/IO/IOException.hpp>
 #include <cassert>
+#include <cstring>
 #include <gtest/gtest.h>
 #include <iostream>
 
@@ -104,3 +113,342 @@ TEST(Compression, InflateDeflate_Err)
     inflater.SetInput(buf);
     EXPECT_THROW(inflater.Inflate(inflated, 29), bpf::io::IOException);
 }
+
+TEST(Compression, InflateDeflate_NoCopy)
+{
+    bpf::compression::ZDeflater deflater;
+    bpf::compression::ZInflater inflater;
+    const char *text = "This is a testThis is a test";
+    bpf::uint8 deflated[128];
+    bpf::uint8 inflated[29];
+    bpf::fsize len = 0;
+    bpf::fsize total = 0;
+
+    deflater.SetInput(text, 29);
+    while ((len = deflater.Deflate(deflated + total, 8)) > 0)
+        total += len;
+    inflater.SetInput(deflated, total);
+    EXPECT_EQ(inflater.Inflate(inflated, 29), 29U);
+    EXPECT_STREQ(reinterpret_cast<const char *>(inflated), text);
+}
+
+TEST(Compression, Stream_File)
+{
+    bpf::io::File f("./compressed.z");
+    {
+        bpf::io::FileStream stream(f, bpf::io::FILE_MODE_WRITE | bpf::io::FILE_MODE_TRUNCATE);
+        bpf::compression::DeflateOutputStream deflate(stream, bpf::compression::ECompressionLevel::LOW, 1024);
+        bpf::io::BinaryWriter writer(deflate);
+        for (bpf::uint32 i = 0; i != 100000; ++i)
+            writer << i << bpf::String("item");
+        writer.Flush();
+        deflate.Finish();
+        EXPECT_THROW(deflate.Write("a", 1), bpf::io::IOException);
+    }
+    EXPECT_LT(f.GetSizeBytes(), (bpf::uint64)(100000 * 12));
+    {
+        bpf::io::FileStream stream(f, bpf::io::FILE_MODE_READ);
+        bpf::compression::InflateInputStream inflate(stream, 1024);
+        bpf::io::BinaryReader reader(inflate);
+        for (bpf::uint32 i = 0; i != 100000; ++i)
+        {
+            bpf::uint32 v;
+            bpf::String str;
+            reader >> v >> str;
+            ASSERT_EQ(v, i);
+            ASSERT_EQ(str, "item");
+        }
+        bpf::uint8 b;
+        EXPECT_EQ(reader.Read(&b, 1), (bpf::fsize)0);
+    }
+    f.Delete();
+}
+
+TEST(Compression, Stream_ZInflaterCompat)
+{
+    bpf::io::ByteBuf deflated(256);
+    {
+        bpf::compression::DeflateOutputStream deflate(deflated);
+        deflate.Write("This is a testThis is a test", 29);
+    }
+    bpf::compression::ZInflater inflater;
+    bpf::uint8 inflated[29];
+    inflater.SetInput(*deflated, deflated.GetWrittenBytes());
+    EXPECT_EQ(inflater.Inflate(inflated, 29), 29U);
+    EXPECT_STREQ(reinterpret_cast<const char *>(inflated), "This is a testThis is a test");
+}
+
+class Pipe final : public bpf::io::IInputStream, public bpf::io::IOutputStream
+{
+private:
+    bpf::uint8 _data[1024];
+    bpf::fsize _read = 0;
+    bpf::fsize _written = 0;
+
+public:
+    bpf::fsize Write(const void *buf, bpf::fsize bufsize) final
+    {
+        std::memcpy(_data + _written, buf, bufsize);
+        _written += bufsize;
+        return (bufsize);
+    }
+
+    bpf::fsize Read(void *buf, bpf::fsize bufsize) final
+    {
+        if (bufsize > _written - _read)
+            bufsize = _written - _read;
+        std::memcpy(buf, _data + _read, bufsize);
+        _read += bufsize;
+        return (bufsize);
+    }
+};
+
+TEST(Compression, Stream_SyncFlush)
+{
+    Pipe pipe;
+    bpf::compression::DeflateOutputStream deflate(pipe);
+    bpf::compression::InflateInputStream inflate(pipe, 16);
+    char buf[32];
+
+    deflate.Write("Hello", 5);
+    deflate.Flush();
+    EXPECT_EQ(inflate.Read(buf, 32), (bpf::fsize)5);
+    EXPECT_EQ(std::memcmp(buf, "Hello", 5), 0);
+    deflate.Write(" world", 6);
+    deflate.Flush();
+    EXPECT_EQ(inflate.Read(buf, 32), (bpf::fsize)6);
+    EXPECT_EQ(std::memcmp(buf, " world", 6), 0);
+    deflate.Finish();
+    EXPECT_EQ(inflate.Read(buf, 32), (bpf::fsize)0);
+    EXPECT_EQ(inflate.GetAdler32(), deflate.GetAdler32());
+}
+
+TEST(Compression, Stream_Truncated)
+{
+    bpf::io::ByteBuf deflated(1024);
+    {
+        bpf::compression::DeflateOutputStream deflate(deflated);
+        for (int i = 0; i != 100; ++i)
+            deflate.Write(&i, sizeof(int));
+    }
+    bpf::io::ByteBuf truncated(deflated.GetWrittenBytes() / 2);
+    truncated.Write(*deflated, truncated.Size());
+    truncated.Seek(0);
+    bpf::compression::InflateInputStream inflate(truncated);
+    char buf[1024];
+    bpf::fsize total = 0;
+    EXPECT_THROW(
+        {
+            bpf::fsize len;
+            while ((len = inflate.Read(buf, 1024)) > 0)
+                total += len;
+        },
+        bpf::io::IOException);
+    EXPECT_GT(total, (bpf::fsize)0);
+}
+
+static void WriteBlockFile(const bpf::io::File &f, bpf::fsize count)
+{
+    bpf::io::FileStream stream(f, bpf::io::FILE_MODE_WRITE | bpf::io::FILE_MODE_TRUNCATE);
+    bpf::compression::BlockDeflateOutputStream deflate(stream, bpf::compression::ECompressionLevel::LOW, 65536, 4);
+    for (bpf::uint32 i = 0; i != count; ++i)
+        deflate.Write(&i, sizeof(bpf::uint32));
+    deflate.Finish();
+    EXPECT_THROW(deflate.Write("a", 1), bpf::io::IOException);
+}
+
+TEST(Compression, Block_RoundTrip)
+{
+    bpf::io::File f("./compressed.bz");
+    WriteBlockFile(f, 1000000);
+    EXPECT_LT(f.GetSizeBytes(), (bpf::uint64)4000000);
+    bpf::compression::BlockInflateInputStream inflate(f);
+    EXPECT_EQ(inflate.GetSize(), (bpf::uint64)4000000);
+    EXPECT_EQ(inflate.GetBlockSize(), (bpf::fsize)65536);
+    EXPECT_EQ(inflate.GetBlockCount(), (bpf::fsize)62);
+    bpf::io::BinaryReader reader(inflate);
+    for (bpf::uint32 i = 0; i != 1000000; ++i)
+    {
+        bpf::uint32 v;
+        reader >> v;
+        ASSERT_EQ(v, i);
+    }
+    bpf::uint8 b;
+    EXPECT_EQ(reader.Read(&b, 1), (bpf::fsize)0);
+    f.Delete();
+}
+
+TEST(Compression, Block_RandomAccess)
+{
+    bpf::io::File f("./compressed.bz");
+    WriteBlockFile(f, 1000000);
+    bpf::compression::BlockInflateInputStream inflate(f);
+    bpf::uint32 buf[50000];
+    // Within a block, across a block boundary, several whole blocks and past the end
+    bpf::uint64 ranges[][2] = {{40, 100}, {65532, 8}, {65536 * 3 - 400, 150000}, {65536 * 10, 131072}, {3999000, 4000}};
+    for (auto &range : ranges)
+    {
+        bpf::fsize len = inflate.ReadAt(range[0], buf, (bpf::fsize)range[1]);
+        bpf::uint64 expected = range[0] + range[1] > 4000000 ? 4000000 - range[0] : range[1];
+        ASSERT_EQ(len, (bpf::fsize)expected);
+        for (bpf::fsize i = 0; i != len / 4; ++i)
+            ASSERT_EQ(buf[i], (bpf::uint32)(range[0] / 4 + i));
+    }
+    EXPECT_EQ(inflate.ReadAt(4000000, buf, 4), (bpf::fsize)0);
+    inflate.Seek(400000);
+    EXPECT_EQ(inflate.Read(buf, 8), (bpf::fsize)8);
+    EXPECT_EQ(buf[0], (bpf::uint32)100000);
+    EXPECT_EQ(buf[1], (bpf::uint32)100001);
+    EXPECT_EQ(inflate.GetPosition(), (bpf::uint64)400008);
+    f.Delete();
+}
+
+TEST(Compression, Block_Empty)
+{
+    bpf::io::File f("./compressed.bz");
+    WriteBlockFile(f, 0);
+    bpf::compression::BlockInflateInputStream inflate(f);
+    bpf::uint8 b;
+    EXPECT_EQ(inflate.GetSize(), (bpf::uint64)0);
+    EXPECT_EQ(inflate.GetBlockCount(), (bpf::fsize)0);
+    EXPECT_EQ(inflate.Read(&b, 1), (bpf::fsize)0);
+    f.Delete();
+}
+
+TEST(Compression, Block_Invalid)
+{
+    bpf::io::File f("./compressed.bz");
+    {
+        bpf::io::FileStream stream(f, bpf::io::FILE_MODE_WRITE | bpf::io::FILE_MODE_TRUNCATE);
+        char data[64] = "This is not a block compressed file";
+        stream.Write(data, 64);
+    }
+    EXPECT_THROW(bpf::compression::BlockInflateInputStream inflate(f), bpf::io::IOException);
+    WriteBlockFile(f, 100000);
+    {
+        // Corrupt the middle of the first block
+        bpf::io::FileStream stream(f, bpf::io::FILE_MODE_WRITE);
+        bpf::uint8 garbage[64];
+        for (auto &b : garbage)
+            b = 0xAB;
+        stream.WriteAt(100, garbage, 64);
+    }
+    bpf::compression::BlockInflateInputStream inflate(f);
+    bpf::uint32 buf[16];
+    EXPECT_EQ(inflate.ReadAt(65536, buf, 64), (bpf::fsize)64);
+    EXPECT_EQ(buf[0], (bpf::uint32)16384);
+    EXPECT_THROW(inflate.ReadAt(0, buf, 64), bpf::io::IOException);
+    f.Delete();
+}
+
+static const bpf::compression::ECompressionCodec Codecs[] = {
+    bpf::compression::ECompressionCodec::ZLIB,
+    bpf::compression::ECompressionCodec::LZ4,
+    bpf::compression::ECompressionCodec::ZSTD
+};
+
+static bpf::io::ByteBuf MakeCorpus(bpf::fsize size)
+{
+    bpf::io::ByteBuf buf(size);
+    const char *words[] = {"block", "project", "framework", "compression", "codec", "stream", " ", "\n"};
+    bpf::uint32 seed = 42;
+    while (buf.GetWrittenBytes() < size)
+    {
+        seed = seed * 1103515245 + 12345;
+        const char *word = words[(seed >> 16) % 8];
+        buf.Write(word, std::strlen(word));
+    }
+    return (buf);
+}
+
+TEST(Compression, Codec_RoundTrip)
+{
+    bpf::io::ByteBuf corpus = MakeCorpus(1024 * 1024);
+    bpf::io::ByteBuf out(1024 * 1024);
+    for (auto codec : Codecs)
+    {
+        if (!bpf::compression::Compressor::IsAvailable(codec))
+        {
+            EXPECT_THROW(bpf::compression::Compressor::Create(codec), bpf::io::IOException);
+            continue;
+        }
+        for (auto level : {bpf::compression::ECompressionLevel::LOW, bpf::compression::ECompressionLevel::DEFAULT,
+                           bpf::compression::ECompressionLevel::HIGH})
+        {
+            auto compressor = bpf::compression::Compressor::Create(codec, level);
+            EXPECT_EQ(compressor->GetCodec(), codec);
+            bpf::io::ByteBuf compressed(compressor->GetBound(corpus.Size()));
+            bpf::fsize len = compressor->Compress(*corpus, corpus.Size(), *compressed, compressed.Size());
+            EXPECT_LT(len, corpus.Size() / 2);
+            EXPECT_EQ(compressor->Decompress(*compressed, len, *out, out.Size()), corpus.Size());
+            EXPECT_EQ(std::memcmp(*out, *corpus, corpus.Size()), 0);
+            EXPECT_THROW(compressor->Decompress(*compressed, len, *out, 1024), bpf::io::IOException);
+            EXPECT_THROW(compressor->Compress(*corpus, corpus.Size(), *compressed, 16), bpf::io::IOException);
+        }
+    }
+}
+
+TEST(Compression, Codec_Dictionary)
+{
+    const char dict[] = "framework compression codec stream block project";
+    const char data[] = "block project framework, compression codec stream";
+    char out[64];
+    for (auto codec : Codecs)
+    {
+        if (!bpf::compression::Compressor::IsAvailable(codec))
+            continue;
+        auto compressor = bpf::compression::Compressor::Create(codec, bpf::compression::ECompressionLevel::HIGH);
+        compressor->SetDictionary(dict, sizeof(dict));
+        bpf::uint8 compressed[256];
+        bpf::fsize len = compressor->Compress(data, sizeof(data), compressed, 256);
+        auto other = bpf::compression::Compressor::Create(codec);
+        other->SetDictionary(dict, sizeof(dict));
+        EXPECT_EQ(other->Decompress(compressed, len, out, 64), sizeof(data));
+        EXPECT_STREQ(out, data);
+        // LZ4 has no dictionary identifier, a missing dictionary produces garbage or an error
+        if (codec != bpf::compression::ECompressionCodec::LZ4)
+        {
+            other->SetDictionary(nullptr, 0);
+            EXPECT_THROW(other->Decompress(compressed, len, out, 64), bpf::io::IOException);
+        }
+    }
+}
+
+TEST(Compression, Codec_Corrupted)
+{
+    bpf::uint8 garbage[256];
+    bpf::uint8 out[1024];
+    for (bpf::fsize i = 0; i != 256; ++i)
+        garbage[i] = (bpf::uint8)(i * 37 + 11);
+    for (auto codec : Codecs)
+    {
+        if (!bpf::compression::Compressor::IsAvailable(codec))
+            continue;
+        auto compressor = bpf::compression::Compressor::Create(codec);
+        EXPECT_THROW(compressor->Decompress(garbage, 256, out, 1024), bpf::io::IOException);
+    }
+}
+
+TEST(Compression, Block_Codecs)
+{
+    bpf::io::File f("./compressed.bz");
+    bpf::io::ByteBuf corpus = MakeCorpus(1000000);
+    bpf::uint8 buf[100000];
+    for (auto codec : Codecs)
+    {
+        if (!bpf::compression::Compressor::IsAvailable(codec))
+            continue;
+        {
+            bpf::io::FileStream stream(f, bpf::io::FILE_MODE_WRITE | bpf::io::FILE_MODE_TRUNCATE);
+            bpf::compression::BlockDeflateOutputStream deflate(stream, bpf::compression::ECompressionLevel::DEFAULT,
+                                                               32768, 2, codec);
+            deflate.Write(*corpus, corpus.Size());
+        }
+        bpf::compression::BlockInflateInputStream inflate(f);
+        EXPECT_EQ(inflate.GetCodec(), codec);
+        EXPECT_EQ(inflate.GetSize(), (bpf::uint64)1000000);
+        EXPECT_EQ(inflate.ReadAt(123456, buf, 100000), (bpf::fsize)100000);
+        EXPECT_EQ(std::memcmp(buf, *corpus + 123456, 100000), 0);
+    }
+    f.Delete();
+}
@@ -144,3 +144,35 @@ TEST(Dynamic, Compare)
     EXPECT_EQ(i, 42);
     EXPECT_EQ(f, 42.42f);
 }
+
+TEST(Dynamic, Inline)
+{
+    struct Pair
+    {
+        int A;
+        double B;
+
+        bool operator==(const Pair &other) const
+        {
+            return (A == other.A && B == other.B);
+        }
+    };
+    bpf::Dynamic dyn = Pair{1, 2.5};
+    auto copy = dyn;
+
+    EXPECT_EQ(((Pair &)copy).A, 1);
+    EXPECT_EQ(((Pair &)copy).B, 2.5);
+    EXPECT_EQ(dyn, copy);
+    ((Pair &)copy).A = 2;
+    EXPECT_NE(dyn, copy);
+    EXPECT_EQ(((Pair &)dyn).A, 1);
+    EXPECT_THROW((void)((int)dyn), bpf::memory::ClassCastException);
+    copy = bpf::String("heap");
+    EXPECT_NE(dyn, copy);
+    EXPECT_STREQ(*(bpf::String &)copy, "heap");
+    copy = 42;
+    EXPECT_EQ((int)copy, 42);
+    auto moved = std::move(copy);
+    EXPECT_EQ(copy, nullptr); //NOLINT
+    EXPECT_EQ((int)moved, 42);
+}
@@ -0,0 +1,133 @@
+// Copyright (c) 2020, BlockProject 3D
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without modification,
+// are permitted provided that the following conditions are met:
+// 
+//     * Redistributions of source code must retain the above copyright notice,
+//       this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above copyright notice,
+//       this list of conditions and the following disclaimer in the documentation
+//       and/or other materials provided with the distribution.
+//     * Neither the name of BlockProject 3D nor the names of its contributors
+//       may be used to endorse or promote products derived from this software
+//       without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include <Framework/Function.hpp>
+#include <Framework/Memory/Utility.hpp>
+#include <gtest/gtest.h>
+
+static int Twice(int x)
+{
+    return (x * 2);
+}
+
+TEST(Function, Null)
+{
+    bpf::Function<void()> f;
+    bpf::Function<int(int)> g = nullptr;
+    int (*ptr)(int) = nullptr;
+    bpf::Function<int(int)> h = ptr;
+
+    EXPECT_FALSE(f);
+    EXPECT_FALSE(g);
+    EXPECT_FALSE(h);
+    EXPECT_THROW(f(), bpf::RuntimeException);
+}
+
+TEST(Function, Basic)
+{
+    int calls = 0;
+    bpf::Function<int(int)> f = [&calls](int x) {
+        ++calls;
+        return (x + 1);
+    };
+    bpf::Function<int(int)> g = &Twice;
+
+    EXPECT_TRUE(f);
+    EXPECT_EQ(f(41), 42);
+    EXPECT_EQ(g(21), 42);
+    EXPECT_EQ(calls, 1);
+    f = nullptr;
+    EXPECT_FALSE(f);
+}
+
+TEST(Function, Inline)
+{
+    int a = 1;
+    auto small = [&a](int x) { return (x + a); };
+    struct Big
+    {
+        double Values[16];
+        int operator()(int x) const
+        {
+            return (x + static_cast<int>(Values[15]));
+        }
+    };
+
+    EXPECT_TRUE(bpf::Function<int(int)>::IsStoredInline<decltype(small)>());
+    EXPECT_FALSE(bpf::Function<int(int)>::IsStoredInline<Big>());
+    EXPECT_TRUE((bpf::Function<int(int), sizeof(Big)>::IsStoredInline<Big>()));
+    Big big;
+    big.Values[15] = 2.0;
+    bpf::Function<int(int)> f = big;
+    bpf::Function<int(int), sizeof(Big)> g = big;
+    EXPECT_EQ(f(40), 42);
+    EXPECT_EQ(g(40), 42);
+}
+
+TEST(Function, Move)
+{
+    struct Owner
+    {
+        bpf::memory::UniquePtr<int> Ptr;
+        int operator()() const
+        {
+            return (*Ptr);
+        }
+    };
+    bpf::Function<int()> f = Owner{bpf::memory::MakeUnique<int>(42)};
+    bpf::Function<int()> g = std::move(f);
+
+    EXPECT_FALSE(f); //NOLINT
+    EXPECT_EQ(g(), 42);
+    f = std::move(g);
+    EXPECT_FALSE(g); //NOLINT
+    EXPECT_EQ(f(), 42);
+}
+
+TEST(Function, Destroy)
+{
+    auto shared = bpf::memory::MakeShared<int>(1);
+    {
+        bpf::Function<int()> small = [shared]() { return (*shared); };
+        struct Big
+        {
+            bpf::memory::SharedPtr<int> Ptr;
+            char Padding[64];
+            int operator()() const
+            {
+                return (*Ptr);
+            }
+        };
+        bpf::Function<int()> big = Big{shared, {}};
+        EXPECT_EQ(shared.GetUseCount(), 3);
+        auto moved = std::move(big);
+        EXPECT_EQ(moved(), 1);
+        EXPECT_EQ(shared.GetUseCount(), 3);
+    }
+    EXPECT_EQ(shared.GetUseCount(), 1);
+}
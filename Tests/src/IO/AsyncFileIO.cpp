@@ -0,0 +1,206 @@
+// Copyright (c) 2020, BlockProject 3D
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without modification,
+// are permitted provided that the following conditions are met:
+// 
+//     * Redistributions of source code must retain the above copyright notice,
+//       this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above copyright notice,
+//       this list of conditions and the following disclaimer in the documentation
+//       and/or other materials provided with the distribution.
+//     * Neither the name of BlockProject 3D nor the names of its contributors
+//       may be used to endorse or promote products derived from this software
+//       without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include <Framework/Collection/ArrayList.hpp>
+#include <Framework/IO/AsyncFileIO.hpp>
+#include <Framework/IO/FileStream.hpp>
+#include <Framework/IO/IOException.hpp>
+#include <gtest/gtest.h>
+
+static void SetupTestFile(const bpf::io::File &f, bpf::uint32 count)
+{
+    bpf::io::FileStream stream(f, bpf::io::FILE_MODE_WRITE | bpf::io::FILE_MODE_TRUNCATE);
+    for (bpf::uint32 i = 0; i != count; ++i)
+        stream.Write(&i, 4);
+}
+
+static void TestReads(bool kernelQueue)
+{
+    bpf::io::File f("./async_io.bin");
+    SetupTestFile(f, 4096);
+    {
+        bpf::io::FileStream stream(f, bpf::io::FILE_MODE_READ);
+        bpf::io::AsyncFileIO io(64, 16, 4, kernelQueue);
+        bpf::uint32 values[512];
+        int completed = 0;
+        for (bpf::uint32 i = 0; i != 512; ++i)
+        {
+            io.Read(stream, i * 8 * 4, &values[i], 4, [&completed](const bpf::io::AsyncIOResult &res) {
+                EXPECT_TRUE(res.Success);
+                EXPECT_EQ(res.Bytes, (bpf::fsize)4);
+                ++completed;
+            });
+        }
+        EXPECT_EQ(io.GetPendingCount(), (bpf::fsize)512);
+        EXPECT_GT(io.Submit(), (bpf::fsize)0);
+        io.WaitAll();
+        EXPECT_EQ(completed, 512);
+        EXPECT_EQ(io.GetPendingCount(), (bpf::fsize)0);
+        for (bpf::uint32 i = 0; i != 512; ++i)
+            EXPECT_EQ(values[i], i * 8);
+    }
+    f.Delete();
+}
+
+TEST(AsyncFileIO, Read_Kernel)
+{
+    TestReads(true);
+}
+
+TEST(AsyncFileIO, Read_ThreadPool)
+{
+    bpf::io::AsyncFileIO io(8, 8, 2, false);
+    EXPECT_FALSE(io.IsKernelQueue());
+    TestReads(false);
+}
+
+static void TestWrites(bool kernelQueue)
+{
+    bpf::io::File f("./async_io.bin");
+    {
+        bpf::io::FileStream stream(f, bpf::io::FILE_MODE_READ | bpf::io::FILE_MODE_WRITE | bpf::io::FILE_MODE_TRUNCATE);
+        bpf::io::AsyncFileIO io(16, 4, 2, kernelQueue);
+        bpf::uint32 values[256];
+        for (bpf::uint32 i = 0; i != 256; ++i)
+        {
+            values[i] = i * 3;
+            io.Write(stream, i * 4, &values[i], 4, nullptr);
+        }
+        io.WaitAll();
+        char header[4] = {'B', 'P', 'F', '!'};
+        bpf::uint32 first = 0;
+        bpf::io::IOVector vecs[] = {{header, 4}, {&first, 4}};
+        bpf::fsize written = 0;
+        io.WriteV(stream, 1024, vecs, 2, [&written](const bpf::io::AsyncIOResult &res) { written = res.Bytes; });
+        EXPECT_EQ(io.Wait(), (bpf::fsize)1);
+        EXPECT_EQ(written, (bpf::fsize)8);
+        char check[4];
+        bpf::io::IOVector rvecs[] = {{check, 4}, {&first, 4}};
+        bool done = false;
+        io.ReadV(stream, 1024, rvecs, 2, [&done](const bpf::io::AsyncIOResult &res) {
+            EXPECT_EQ(res.Bytes, (bpf::fsize)8);
+            done = true;
+        });
+        io.WaitAll();
+        EXPECT_TRUE(done);
+        EXPECT_EQ(std::memcmp(check, "BPF!", 4), 0);
+        EXPECT_EQ(first, (bpf::uint32)0);
+        for (bpf::uint32 i = 0; i != 256; ++i)
+        {
+            bpf::uint32 v;
+            EXPECT_EQ(stream.ReadAt(i * 4, &v, 4), (bpf::fsize)4);
+            EXPECT_EQ(v, i * 3);
+        }
+    }
+    f.Delete();
+}
+
+TEST(AsyncFileIO, Write_Kernel)
+{
+    TestWrites(true);
+}
+
+TEST(AsyncFileIO, Write_ThreadPool)
+{
+    TestWrites(false);
+}
+
+static void TestErrors(bool kernelQueue)
+{
+    bpf::io::File f("./async_io.bin");
+    SetupTestFile(f, 4);
+    {
+        bpf::io::FileStream stream(f, bpf::io::FILE_MODE_READ);
+        bpf::io::AsyncFileIO io(4, 4, 1, kernelQueue);
+        bpf::uint32 v = 0;
+        bool failed = false;
+        io.Write(stream, 0, &v, 4, [&failed](const bpf::io::AsyncIOResult &res) {
+            failed = !res.Success && res.Error.Size() > 0;
+        });
+        bpf::fsize bytes = 1;
+        io.Read(stream, 1000, &v, 4, [&bytes](const bpf::io::AsyncIOResult &res) { bytes = res.Bytes; });
+        io.WaitAll();
+        EXPECT_TRUE(failed);
+        EXPECT_EQ(bytes, (bpf::fsize)0);
+    }
+    f.Delete();
+}
+
+TEST(AsyncFileIO, Errors_Kernel)
+{
+    TestErrors(true);
+}
+
+TEST(AsyncFileIO, Errors_ThreadPool)
+{
+    TestErrors(false);
+}
+
+TEST(AsyncFileIO, FileQueueDepth)
+{
+    bpf::io::File f("./async_io.bin");
+    SetupTestFile(f, 64);
+    {
+        bpf::io::FileStream stream(f, bpf::io::FILE_MODE_READ);
+        bpf::io::AsyncFileIO io(32, 1, 4, false);
+        bpf::uint32 values[64];
+        bpf::collection::ArrayList<bpf::uint64> order;
+        for (bpf::uint32 i = 0; i != 64; ++i)
+            io.Read(stream, i * 4, &values[i], 4, [&order](const bpf::io::AsyncIOResult &res) { order.Add(res.Id); });
+        EXPECT_EQ(io.Submit(), (bpf::fsize)1);
+        io.WaitAll();
+        ASSERT_EQ(order.Size(), (bpf::fsize)64);
+        for (bpf::uint32 i = 0; i != 64; ++i)
+        {
+            EXPECT_EQ(order[i], (bpf::uint64)i);
+            EXPECT_EQ(values[i], i);
+        }
+    }
+    f.Delete();
+}
+
+TEST(AsyncFileIO, ChainedRequests)
+{
+    bpf::io::File f("./async_io.bin");
+    SetupTestFile(f, 16);
+    {
+        bpf::io::FileStream stream(f, bpf::io::FILE_MODE_READ);
+        bpf::io::AsyncFileIO io;
+        bpf::uint32 v = 0;
+        bpf::uint32 sum = 0;
+        bpf::io::AsyncFileIO::Callback next = [&](const bpf::io::AsyncIOResult &res) {
+            sum += v;
+            if (res.Id < 15)
+                io.Read(stream, (res.Id + 1) * 4, &v, 4, next);
+        };
+        io.Read(stream, 0, &v, 4, next);
+        io.WaitAll();
+        EXPECT_EQ(sum, (bpf::uint32)120);
+    }
+    f.Delete();
+}
@@ -172,6 +172,19 @@ TEST(BinaryReadWrite, ReadWrite_Unbuffered)
     EXPECT_STREQ(test, "test");
 }
 
+TEST(BinaryReadWrite, Read_ByteBuf_EOF)
+{
+    bpf::io::ByteBuf buf(64);
+    buf.Write("this is a test", 14);
+    buf.Seek(5);
+    bpf::io::BinaryReader r(buf);
+    char out[32];
+
+    EXPECT_EQ(r.Read(out, sizeof(out)), 9U);
+    EXPECT_EQ(bpf::String(out, 9), "is a test");
+    EXPECT_EQ(r.Read(out, sizeof(out)), 0U);
+}
+
 TEST(BinaryReadWrite, ReadWrite_String_Test_1_1)
 {
     {
@@ -27,6 +27,7 @@
 // SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include <iostream>
+#include <limits>
 #include <gtest/gtest.h>
 #include <Framework/IO/ByteBuf.hpp>
 
@@ -175,4 +176,48 @@ TEST(ByteBuf, Shift)
     buf.Shift(2);
     buf[4] = '\0';
     EXPECT_STREQ(reinterpret_cast<const char *>(*buf), "ST");
-}
\ No newline at end of file
+}
+TEST(ByteBuf, View)
+{
+    bpf::io::ByteBuf buf(16);
+    buf.Write("Hello World", 11);
+    bpf::io::ByteView view = buf.View();
+    EXPECT_EQ(view.Size(), 11U);
+    EXPECT_EQ(*view, *buf);
+    EXPECT_EQ(view[4], 'o');
+    EXPECT_THROW(view[11], bpf::IndexException);
+    EXPECT_TRUE(view.Sub(6) == bpf::io::ByteView("World", 5));
+    EXPECT_TRUE(view.Sub(6, 100) == bpf::io::ByteView("World", 5));
+    EXPECT_TRUE(view.Sub(11).IsEmpty());
+    EXPECT_THROW(view.Sub(12), bpf::IndexException);
+    EXPECT_TRUE(buf.View(0, 5) != bpf::io::ByteView("World", 5));
+    EXPECT_THROW(buf.View(10, 7), bpf::IndexException);
+    bpf::io::ByteBuf copy(view.Sub(0, 5));
+    EXPECT_EQ(copy.Size(), 5U);
+    EXPECT_TRUE(copy.View() == bpf::io::ByteView("Hello", 5));
+    bpf::fsize count = 0;
+    for (auto b : view)
+        count += b == 'o' ? 1 : 0;
+    EXPECT_EQ(count, 2U);
+}
+
+TEST(ByteBuf, ReadDirect)
+{
+    bpf::io::ByteBuf buf(16);
+    buf.Write("Hello World", 11);
+    buf.Seek(0);
+    const bpf::uint8 *data;
+    EXPECT_EQ(buf.ReadDirect(data, 5), 5U);
+    EXPECT_EQ(data, *buf);
+    EXPECT_EQ(buf.ReadDirect(data, 100), 6U);
+    EXPECT_EQ(data, *buf + 5);
+    EXPECT_EQ(buf.ReadDirect(data, 100), 0U);
+    buf.Clear();
+    buf.Write("Test", 4);
+    buf.Seek(0);
+    char out[2];
+    EXPECT_EQ(buf.Read(out, 2), 2U);
+    EXPECT_EQ(buf.ReadDirect(data, std::numeric_limits<bpf::fsize>::max()), 2U);
+    EXPECT_EQ(data, *buf + 2);
+    EXPECT_EQ(buf.ReadDirect(data, std::numeric_limits<bpf::fsize>::max()), 0U);
+}
@@ -0,0 +1,141 @@
+// Copyright (c) 2020, BlockProject 3D
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without modification,
+// are permitted provided that the following conditions are met:
+// 
+//     * Redistributions of source code must retain the above copyright notice,
+//       this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above copyright notice,
+//       this list of conditions and the following disclaimer in the documentation
+//       and/or other materials provided with the distribution.
+//     * Neither the name of BlockProject 3D nor the names of its contributors
+//       may be used to endorse or promote products derived from this software
+//       without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include <Framework/Collection/ArrayList.hpp>
+#include <Framework/IO/DirectoryWalker.hpp>
+#include <Framework/IO/FileStream.hpp>
+#include <Framework/IO/IOException.hpp>
+#include <gtest/gtest.h>
+
+static void SetupTree()
+{
+    bpf::io::File("./walk_me").CreateDir();
+    bpf::io::File("./walk_me/a").CreateDir();
+    bpf::io::File("./walk_me/a/b").CreateDir();
+    bpf::io::File("./walk_me/c").CreateDir();
+    const char *files[] = {"./walk_me/root.txt", "./walk_me/a/a1.txt", "./walk_me/a/a2.bin", "./walk_me/a/b/b1.txt",
+                           "./walk_me/c/c1.bin"};
+    for (auto *name : files)
+        bpf::io::FileStream(bpf::io::File(name), bpf::io::FILE_MODE_WRITE | bpf::io::FILE_MODE_TRUNCATE);
+}
+
+static void CleanupTree()
+{
+    const char *files[] = {"./walk_me/root.txt", "./walk_me/a/a1.txt", "./walk_me/a/a2.bin", "./walk_me/a/b/b1.txt",
+                           "./walk_me/c/c1.bin", "./walk_me/a/b", "./walk_me/a", "./walk_me/c", "./walk_me"};
+    for (auto *name : files)
+        bpf::io::File(name).Delete();
+}
+
+static bool Contains(const bpf::collection::ArrayList<bpf::String> &list, const bpf::String &str)
+{
+    for (auto &s : list)
+    {
+        if (s == str)
+            return (true);
+    }
+    return (false);
+}
+
+TEST(DirectoryWalker, OpenExcept)
+{
+    EXPECT_THROW(bpf::io::DirectoryWalker walker(bpf::io::File("./doesnotexist")), bpf::io::IOException);
+}
+
+TEST(DirectoryWalker, Recursive)
+{
+    SetupTree();
+    {
+        bpf::io::DirectoryWalker walker(bpf::io::File("./walk_me"));
+        bpf::collection::ArrayList<bpf::String> paths;
+        while (walker.Next())
+        {
+            paths.Add(walker.GetRelativePath());
+            if (walker.GetName() == "b")
+            {
+                EXPECT_EQ(walker.GetType(), bpf::io::EFileType::DIRECTORY);
+                EXPECT_EQ(walker.GetDepth(), (bpf::fsize)1);
+            }
+            if (walker.GetName() == "b1.txt")
+            {
+                EXPECT_EQ(walker.GetType(), bpf::io::EFileType::FILE);
+                EXPECT_EQ(walker.GetDepth(), (bpf::fsize)2);
+                EXPECT_TRUE(walker.GetFile().Exists());
+                EXPECT_EQ(walker.GetNameLength(), (bpf::fsize)6);
+            }
+        }
+        EXPECT_EQ(paths.Size(), (bpf::fsize)8);
+        EXPECT_TRUE(Contains(paths, "a/b/b1.txt"));
+        EXPECT_TRUE(Contains(paths, "c/c1.bin"));
+        EXPECT_TRUE(Contains(paths, "root.txt"));
+        EXPECT_FALSE(Contains(paths, "."));
+        EXPECT_FALSE(Contains(paths, ".."));
+        EXPECT_FALSE(walker.Next());
+    }
+    CleanupTree();
+}
+
+TEST(DirectoryWalker, NonRecursive)
+{
+    SetupTree();
+    {
+        bpf::io::DirectoryWalker walker(bpf::io::File("./walk_me"), false);
+        bpf::fsize count = 0;
+        while (walker.Next())
+        {
+            EXPECT_EQ(walker.GetDepth(), (bpf::fsize)0);
+            ++count;
+        }
+        EXPECT_EQ(count, (bpf::fsize)3);
+    }
+    CleanupTree();
+}
+
+TEST(DirectoryWalker, FilterAndSkip)
+{
+    SetupTree();
+    {
+        bpf::io::DirectoryWalker walker(bpf::io::File("./walk_me"));
+        walker.SetFilter([](const bpf::io::DirectoryWalker &w) {
+            return (w.GetType() == bpf::io::EFileType::DIRECTORY || w.GetName().EndsWith(".txt"));
+        });
+        bpf::collection::ArrayList<bpf::String> paths;
+        while (walker.Next())
+        {
+            if (walker.GetName() == "b")
+                walker.Skip();
+            paths.Add(walker.GetRelativePath());
+        }
+        EXPECT_EQ(paths.Size(), (bpf::fsize)5);
+        EXPECT_TRUE(Contains(paths, "a/a1.txt"));
+        EXPECT_TRUE(Contains(paths, "a/b"));
+        EXPECT_FALSE(Contains(paths, "a/b/b1.txt"));
+        EXPECT_FALSE(Contains(paths, "a/a2.bin"));
+    }
+    CleanupTree();
+}
@@ -0,0 +1,139 @@
+// Copyright (c) 2020, BlockProject 3D
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without modification,
+// are permitted provided that the following conditions are met:
+// 
+//     * Redistributions of source code must retain the above copyright notice,
+//       this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above copyright notice,
+//       this list of conditions and the following disclaimer in the documentation
+//       and/or other materials provided with the distribution.
+//     * Neither the name of BlockProject 3D nor the names of its contributors
+//       may be used to endorse or promote products derived from this software
+//       without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include <Framework/IO/BinaryReader.hpp>
+#include <Framework/IO/BinaryWriter.hpp>
+#include <Framework/IO/DynamicByteBuf.hpp>
+#include <Framework/Memory/Utility.hpp>
+#include <gtest/gtest.h>
+
+TEST(DynamicByteBuf, WriteRead)
+{
+    bpf::io::DynamicByteBuf buf(8);
+    char out[32];
+
+    EXPECT_EQ(buf.Write("This is a test", 15), 15U);
+    EXPECT_EQ(buf.Size(), 15U);
+    EXPECT_EQ(buf.GetSegmentCount(), 2U);
+    EXPECT_EQ(buf.Read(out, 32), 15U);
+    EXPECT_STREQ(out, "This is a test");
+    EXPECT_EQ(buf.Size(), 0U);
+    EXPECT_EQ(buf.GetSegmentCount(), 0U);
+    EXPECT_EQ(buf.Read(out, 32), 0U);
+}
+
+TEST(DynamicByteBuf, Recycle)
+{
+    bpf::io::DynamicByteBuf buf(8);
+    char out[8];
+
+    buf.Write("abcdefgh", 8);
+    const bpf::uint8 *first = *buf.Peek();
+    EXPECT_EQ(buf.Read(out, 8), 8U);
+    buf.Write("ijkl", 4);
+    // The consumed segment is reused instead of allocating a new one
+    EXPECT_EQ(*buf.Peek(), first);
+    EXPECT_TRUE(buf.Peek() == bpf::io::ByteView("ijkl", 4));
+}
+
+TEST(DynamicByteBuf, PeekConsume)
+{
+    bpf::io::DynamicByteBuf buf(4);
+
+    EXPECT_TRUE(buf.Peek().IsEmpty());
+    buf.Write(bpf::io::ByteView("0123456789", 10));
+    EXPECT_TRUE(buf.Peek() == bpf::io::ByteView("0123", 4));
+    buf.Consume(6);
+    EXPECT_EQ(buf.Size(), 4U);
+    EXPECT_TRUE(buf.Peek() == bpf::io::ByteView("67", 2));
+    buf.Consume(100);
+    EXPECT_EQ(buf.Size(), 0U);
+    buf.Write("ab", 2);
+    buf.Clear();
+    EXPECT_EQ(buf.Size(), 0U);
+    EXPECT_TRUE(buf.Peek().IsEmpty());
+}
+
+TEST(DynamicByteBuf, Append)
+{
+    bpf::io::DynamicByteBuf buf(4);
+    auto shared = bpf::memory::MakeShared<bpf::io::ByteBuf>(8);
+    char out[16];
+
+    shared->Write("ABCDEFGH", 8);
+    buf.Write("xy", 2);
+    buf.Append(shared, 2, 4);
+    EXPECT_THROW(buf.Append(shared, 6, 4), bpf::IndexException);
+    buf.Write("z", 1);
+    EXPECT_EQ(buf.GetSegmentCount(), 3U);
+    EXPECT_EQ(shared.GetUseCount(), 2);
+    // The appended buffer is shared, not copied
+    EXPECT_EQ(buf.Read(out, 2), 2U);
+    EXPECT_EQ(*buf.Peek(), **shared + 2);
+    EXPECT_EQ(buf.Read(out, 16), 5U);
+    EXPECT_TRUE(bpf::io::ByteView(out, 5) == bpf::io::ByteView("CDEFz", 5));
+    EXPECT_EQ(shared.GetUseCount(), 1);
+    EXPECT_TRUE(shared->View() == bpf::io::ByteView("ABCDEFGH", 8));
+}
+
+TEST(DynamicByteBuf, ReadDirect)
+{
+    bpf::io::DynamicByteBuf buf(4);
+    const bpf::uint8 *data;
+
+    buf.Write("abcdef", 6);
+    EXPECT_EQ(buf.ReadDirect(data, 100), 4U);
+    EXPECT_TRUE(bpf::io::ByteView(data, 4) == bpf::io::ByteView("abcd", 4));
+    EXPECT_EQ(buf.ReadDirect(data, 1), 1U);
+    EXPECT_EQ(*data, 'e');
+    EXPECT_EQ(buf.ReadDirect(data, 100), 1U);
+    EXPECT_EQ(*data, 'f');
+    EXPECT_EQ(buf.ReadDirect(data, 100), 0U);
+    EXPECT_EQ(buf.Size(), 0U);
+}
+
+TEST(DynamicByteBuf, Pipeline)
+{
+    bpf::io::DynamicByteBuf buf(64);
+    {
+        bpf::io::BinaryWriter writer(buf);
+        for (bpf::uint32 i = 0; i != 10000; ++i)
+            writer << i << bpf::String("item");
+    }
+    EXPECT_EQ(buf.Size(), 10000U * 12U);
+    bpf::io::BinaryReader reader(buf);
+    for (bpf::uint32 i = 0; i != 10000; ++i)
+    {
+        bpf::uint32 v;
+        bpf::String str;
+        reader >> v >> str;
+        ASSERT_EQ(v, i);
+        ASSERT_EQ(str, "item");
+    }
+    EXPECT_EQ(buf.Size(), 0U);
+}
@@ -258,3 +258,51 @@ TEST(File, WorkDir)
     EXPECT_FALSE(g_app->SetWorkingDirectory(bpf::io::File("/root")));
 #endif
 }
+
+TEST(File, Copy)
+{
+    bpf::io::File f("./copy_me.txt");
+    bpf::io::File dst("./copied.txt");
+    SetupTestFile(f);
+    EXPECT_TRUE(f.CopyTo(dst));
+    EXPECT_EQ(dst.GetSizeBytes(), 14U);
+    EXPECT_FALSE(f.CopyTo(dst));
+    EXPECT_TRUE(f.CopyTo(dst, true));
+    EXPECT_FALSE(f.CopyTo(f, true));
+    EXPECT_EQ(f.GetSizeBytes(), 14U);
+    {
+        bpf::io::FileStream stream(dst, bpf::io::FILE_MODE_READ);
+        char buf[15];
+        EXPECT_EQ(stream.Read(buf, 14), (bpf::fsize)14);
+        buf[14] = '\0';
+        EXPECT_STREQ(buf, "This is a test");
+    }
+    EXPECT_TRUE(dst.Delete());
+    EXPECT_TRUE(f.Delete());
+    EXPECT_FALSE(f.CopyTo(dst));
+}
+
+TEST(File, Copy_Large)
+{
+    bpf::io::File f("./copy_me.bin");
+    bpf::io::File dir("./copy_dir");
+    EXPECT_TRUE(dir.CreateDir());
+    {
+        bpf::io::FileStream stream(f, bpf::io::FILE_MODE_WRITE | bpf::io::FILE_MODE_TRUNCATE);
+        for (bpf::uint32 i = 0; i != 1 << 18; ++i)
+            stream.Write(&i, 4);
+    }
+    EXPECT_TRUE(f.CopyTo(dir));
+    bpf::io::File dst = dir + "copy_me.bin";
+    EXPECT_EQ(dst.GetSizeBytes(), (bpf::uint64)(4 << 18));
+    {
+        bpf::io::FileStream stream(dst, bpf::io::FILE_MODE_READ);
+        bpf::uint32 v;
+        stream.Seek(4 * 123456);
+        EXPECT_EQ(stream.Read(&v, 4), (bpf::fsize)4);
+        EXPECT_EQ(v, (bpf::uint32)123456);
+    }
+    EXPECT_TRUE(dst.Delete());
+    EXPECT_TRUE(dir.Delete());
+    EXPECT_TRUE(f.Delete());
+}
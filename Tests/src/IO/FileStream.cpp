@@ -135,3 +135,36 @@ TEST(FileStream, Unicode)
     stream1.Close();
     f.Delete();
 }
+
+TEST(FileStream, Positional)
+{
+    bpf::io::File f("./positional.txt");
+    {
+        bpf::io::FileStream stream(f, bpf::io::FILE_MODE_READ | bpf::io::FILE_MODE_WRITE | bpf::io::FILE_MODE_TRUNCATE);
+        EXPECT_EQ(stream.Write("This is a test", 14), (bpf::fsize)14);
+        EXPECT_EQ(stream.WriteAt(5, "IS", 2), (bpf::fsize)2);
+        char buf[5];
+        EXPECT_EQ(stream.ReadAt(8, buf, 4), (bpf::fsize)4);
+        buf[4] = '\0';
+        EXPECT_STREQ(buf, "a te");
+        EXPECT_EQ(stream.ReadAt(12, buf, 4), (bpf::fsize)2);
+        EXPECT_EQ(stream.ReadAt(20, buf, 4), (bpf::fsize)0);
+    }
+    {
+        bpf::io::FileStream stream(f, bpf::io::FILE_MODE_READ);
+        char part1[8];
+        char part2[7];
+        bpf::io::IOVector vecs[] = {{part1, 7}, {part2, 6}};
+        EXPECT_EQ(stream.ReadV(1, vecs, 2), (bpf::fsize)13);
+        part1[7] = '\0';
+        part2[6] = '\0';
+        EXPECT_STREQ(part1, "his IS ");
+        EXPECT_STREQ(part2, "a test");
+        EXPECT_THROW(stream.WriteAt(0, "T", 1), bpf::io::IOException);
+    }
+    {
+        bpf::io::FileStream stream(f, bpf::io::FILE_MODE_WRITE | bpf::io::FILE_MODE_APPEND);
+        EXPECT_THROW(stream.WriteAt(0, "T", 1), bpf::io::IOException);
+    }
+    f.Delete();
+}
@@ -0,0 +1,166 @@
+// Copyright (c) 2020, BlockProject 3D
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without modification,
+// are permitted provided that the following conditions are met:
+// 
+//     * Redistributions of source code must retain the above copyright notice,
+//       this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above copyright notice,
+//       this list of conditions and the following disclaimer in the documentation
+//       and/or other materials provided with the distribution.
+//     * Neither the name of BlockProject 3D nor the names of its contributors
+//       may be used to endorse or promote products derived from this software
+//       without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include <Framework/IO/BinaryReader.hpp>
+#include <Framework/IO/BinaryWriter.hpp>
+#include <Framework/IO/FileStream.hpp>
+#include <Framework/IO/IOException.hpp>
+#include <Framework/IO/MMapInputStream.hpp>
+#include <Framework/IO/TextReader.hpp>
+#include <gtest/gtest.h>
+
+static void SetupTestFile(bpf::io::File &f, bpf::uint32 count)
+{
+    bpf::io::FileStream stream(f, bpf::io::FILE_MODE_WRITE | bpf::io::FILE_MODE_TRUNCATE);
+    bpf::io::BinaryWriter writer(stream);
+    for (bpf::uint32 i = 0; i != count; ++i)
+        writer << i;
+    writer.Flush();
+}
+
+TEST(MMapInputStream, OpenExcept)
+{
+    EXPECT_THROW(bpf::io::MMapInputStream stream(bpf::io::File("./doesnotexist.txt")), bpf::io::IOException);
+}
+
+TEST(MMapInputStream, Empty)
+{
+    bpf::io::File f("./mmap_stream.bin");
+    SetupTestFile(f, 0);
+    {
+        bpf::io::MMapInputStream stream(f);
+        char buf[4];
+        const bpf::uint8 *data;
+        EXPECT_EQ(stream.GetSize(), (bpf::uint64)0);
+        EXPECT_EQ(stream.Read(buf, 4), (bpf::fsize)0);
+        EXPECT_EQ(stream.ReadDirect(data, 4), (bpf::fsize)0);
+        EXPECT_EQ(data, nullptr);
+    }
+    f.Delete();
+}
+
+TEST(MMapInputStream, Read_SlidingWindow)
+{
+    bpf::io::File f("./mmap_stream.bin");
+    SetupTestFile(f, 10000);
+    {
+        bpf::io::MMapInputStream stream(f, bpf::io::EMapAdvice::SEQUENTIAL, 4096);
+        bpf::uint32 buf[3];
+        bpf::uint32 expected = 0;
+        bpf::fsize len;
+        while ((len = stream.Read(buf, sizeof(buf))) == sizeof(buf))
+        {
+            for (bpf::uint32 v : buf)
+                EXPECT_EQ(v, expected++);
+        }
+        EXPECT_EQ(len, (bpf::fsize)4);
+        EXPECT_EQ(buf[0], expected);
+        EXPECT_EQ(stream.GetPosition(), (bpf::uint64)40000);
+    }
+    f.Delete();
+}
+
+TEST(MMapInputStream, ReadDirect)
+{
+    bpf::io::File f("./mmap_stream.bin");
+    SetupTestFile(f, 10000);
+    {
+        bpf::io::MMapInputStream stream(f, bpf::io::EMapAdvice::SEQUENTIAL, 6000);
+        const bpf::uint8 *data;
+        EXPECT_EQ(stream.ReadDirect(data, 100000), (bpf::fsize)6000);
+        EXPECT_EQ(stream.ReadDirect(data, 8), (bpf::fsize)8);
+        EXPECT_EQ(reinterpret_cast<const bpf::uint32 *>(data)[0], (bpf::uint32)1500);
+        EXPECT_EQ(stream.ReadDirect(data, 100000), (bpf::fsize)5992);
+        stream.Seek(39996);
+        EXPECT_EQ(stream.ReadDirect(data, 100000), (bpf::fsize)4);
+        EXPECT_EQ(reinterpret_cast<const bpf::uint32 *>(data)[0], (bpf::uint32)9999);
+        EXPECT_EQ(stream.ReadDirect(data, 100000), (bpf::fsize)0);
+    }
+    f.Delete();
+}
+
+TEST(MMapInputStream, Seek)
+{
+    bpf::io::File f("./mmap_stream.bin");
+    SetupTestFile(f, 10000);
+    {
+        bpf::io::MMapInputStream stream(f, bpf::io::EMapAdvice::RANDOM, 4096);
+        bpf::uint32 v;
+        stream.Seek(4 * 5000);
+        EXPECT_EQ(stream.Read(&v, 4), (bpf::fsize)4);
+        EXPECT_EQ(v, (bpf::uint32)5000);
+        stream.Seek(4 * 3);
+        EXPECT_EQ(stream.Read(&v, 4), (bpf::fsize)4);
+        EXPECT_EQ(v, (bpf::uint32)3);
+        stream.Seek(4 * 10000);
+        EXPECT_EQ(stream.Read(&v, 4), (bpf::fsize)0);
+    }
+    f.Delete();
+}
+
+TEST(MMapInputStream, BinaryReader)
+{
+    bpf::io::File f("./mmap_stream.bin");
+    SetupTestFile(f, 10000);
+    {
+        bpf::io::MMapInputStream stream(f, bpf::io::EMapAdvice::SEQUENTIAL, 4098);
+        bpf::io::BinaryReader reader(stream);
+        for (bpf::uint32 i = 0; i != 10000; ++i)
+        {
+            bpf::uint32 v;
+            reader >> v;
+            EXPECT_EQ(v, i);
+        }
+        bpf::uint8 b;
+        EXPECT_EQ(reader.Read(&b, 1), (bpf::fsize)0);
+    }
+    f.Delete();
+}
+
+TEST(MMapInputStream, TextReader)
+{
+    bpf::io::File f("./mmap_stream.txt");
+    {
+        bpf::io::FileStream stream(f, bpf::io::FILE_MODE_WRITE | bpf::io::FILE_MODE_TRUNCATE);
+        for (int i = 0; i != 1000; ++i)
+        {
+            auto line = bpf::String::ValueOf(i) + "\n";
+            stream.Write(*line, line.Size());
+        }
+    }
+    {
+        bpf::io::MMapInputStream stream(f, bpf::io::EMapAdvice::SEQUENTIAL, 100);
+        bpf::io::TextReader reader(stream);
+        bpf::String line;
+        int i = 0;
+        while (reader.ReadLine(line))
+            EXPECT_EQ(line, bpf::String::ValueOf(i++));
+        EXPECT_EQ(i, 1000);
+    }
+    f.Delete();
+}
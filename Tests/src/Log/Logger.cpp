@@ -26,8 +26,18 @@
 // NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
 // SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
+#include <Framework/IO/BinaryWriter.hpp>
+#include <Framework/IO/ByteBuf.hpp>
+#include <Framework/IO/FileStream.hpp>
+#include <Framework/IO/IOException.hpp>
+#include <Framework/Log/AsyncLogAdapter.hpp>
+#include <Framework/Log/BinaryFileLogger.hpp>
+#include <Framework/Log/BinaryLogReader.hpp>
+#include <Framework/Log/FileLogger.hpp>
 #include <Framework/Log/Logger.hpp>
 #include <Framework/Memory/Utility.hpp>
+#include <Framework/System/Thread.hpp>
+#include <atomic>
 #include <gtest/gtest.h>
 
 class MemoryLog final : public bpf::log::ILogAdapter
@@ -135,3 +145,372 @@ TEST(Logger, MinLevel_2)
     lg.Error("Test");
     EXPECT_STREQ(*log.Last(), "[UT] 0 Test");
 }
+
+class GatedLog final : public bpf::log::ILogAdapter
+{
+private:
+    bpf::collection::List<bpf::String> &_log;
+    std::atomic<bool> &_gate;
+    std::atomic<bool> &_entered;
+
+public:
+    GatedLog(bpf::collection::List<bpf::String> &log, std::atomic<bool> &gate, std::atomic<bool> &entered)
+        : _log(log)
+        , _gate(gate)
+        , _entered(entered)
+    {
+    }
+
+    void LogMessage(bpf::log::ELogLevel level, const bpf::String &category, const bpf::String &msg) final
+    {
+        _entered = true;
+        while (!_gate)
+            bpf::system::Thread::Sleep(1);
+        _log.Add(bpf::String('[') + category + "] " + bpf::String::ValueOf((int)level) + ' ' + msg);
+    }
+};
+
+class LogThread final : public bpf::system::Thread
+{
+private:
+    bpf::log::Logger &_logger;
+    int _id;
+
+public:
+    LogThread(bpf::log::Logger &logger, int id)
+        : Thread("LogThread")
+        , _logger(logger)
+        , _id(id)
+    {
+    }
+
+    void Run() final
+    {
+        for (int i = 0; i != 1000; ++i)
+            _logger.Info("Thread [] message []", _id, i);
+    }
+};
+
+class SubmitThread final : public bpf::system::Thread
+{
+private:
+    bpf::log::AsyncLogBackend &_backend;
+    std::atomic<bool> &_submitted;
+
+public:
+    SubmitThread(bpf::log::AsyncLogBackend &backend, std::atomic<bool> &submitted)
+        : Thread("SubmitThread")
+        , _backend(backend)
+        , _submitted(submitted)
+    {
+    }
+
+    void Run() final
+    {
+        _backend.Submit(bpf::log::ELogLevel::INFO, "UT", "4");
+        _submitted = true;
+    }
+};
+
+TEST(Logger, Async_Basic)
+{
+    bpf::collection::List<bpf::String> log;
+    auto backend = bpf::memory::MakeShared<bpf::log::AsyncLogBackend>();
+    auto lg = bpf::log::Logger("UT");
+
+    backend->AddHandler(bpf::memory::MakeUnique<MemoryLog>(log));
+    lg.AddHandler(bpf::memory::MakeUnique<bpf::log::AsyncLogAdapter>(backend));
+    lg.SetLevel(bpf::log::ELogLevel::DEBUG);
+    lg.Debug("Test");
+    lg.Info("Test []", 42);
+    lg.Warning("Test");
+    lg.Error("Test");
+    lg.Flush();
+    ASSERT_EQ(log.Size(), 4u);
+    EXPECT_STREQ(*log[0], "[UT] 3 Test");
+    EXPECT_STREQ(*log[1], "[UT] 2 Test 42");
+    EXPECT_STREQ(*log[2], "[UT] 1 Test");
+    EXPECT_STREQ(*log[3], "[UT] 0 Test");
+    EXPECT_EQ(backend->GetDroppedCount(), 0u);
+}
+
+TEST(Logger, Async_MultiThread)
+{
+    bpf::collection::List<bpf::String> log;
+    auto backend = bpf::memory::MakeShared<bpf::log::AsyncLogBackend>(64);
+    auto lg = bpf::log::Logger("UT");
+
+    backend->AddHandler(bpf::memory::MakeUnique<MemoryLog>(log));
+    lg.AddHandler(bpf::memory::MakeUnique<bpf::log::AsyncLogAdapter>(backend));
+    {
+        LogThread t1(lg, 1);
+        LogThread t2(lg, 2);
+        LogThread t3(lg, 3);
+        t1.Start();
+        t2.Start();
+        t3.Start();
+        t1.Join();
+        t2.Join();
+        t3.Join();
+    }
+    lg.Flush();
+    EXPECT_EQ(log.Size(), 3000u);
+    EXPECT_EQ(backend->GetDroppedCount(), 0u);
+}
+
+TEST(Logger, Async_Drop)
+{
+    bpf::collection::List<bpf::String> log;
+    std::atomic<bool> gate(false);
+    std::atomic<bool> entered(false);
+    bpf::log::AsyncLogBackend backend(2, bpf::log::EOverflowPolicy::DROP);
+
+    backend.AddHandler(bpf::memory::MakeUnique<GatedLog>(log, gate, entered));
+    EXPECT_TRUE(backend.Submit(bpf::log::ELogLevel::INFO, "UT", "1"));
+    while (!entered)
+        bpf::system::Thread::Sleep(1);
+    EXPECT_TRUE(backend.Submit(bpf::log::ELogLevel::INFO, "UT", "2"));
+    EXPECT_TRUE(backend.Submit(bpf::log::ELogLevel::INFO, "UT", "3"));
+    EXPECT_FALSE(backend.Submit(bpf::log::ELogLevel::INFO, "UT", "4"));
+    EXPECT_EQ(backend.GetDroppedCount(), 1u);
+    gate = true;
+    backend.Flush();
+    ASSERT_EQ(log.Size(), 3u);
+    EXPECT_STREQ(*log.Last(), "[UT] 2 3");
+}
+
+TEST(Logger, Async_Block)
+{
+    bpf::collection::List<bpf::String> log;
+    std::atomic<bool> gate(false);
+    std::atomic<bool> entered(false);
+    std::atomic<bool> submitted(false);
+    bpf::log::AsyncLogBackend backend(2, bpf::log::EOverflowPolicy::BLOCK);
+
+    backend.AddHandler(bpf::memory::MakeUnique<GatedLog>(log, gate, entered));
+    backend.Submit(bpf::log::ELogLevel::INFO, "UT", "1");
+    while (!entered)
+        bpf::system::Thread::Sleep(1);
+    backend.Submit(bpf::log::ELogLevel::INFO, "UT", "2");
+    backend.Submit(bpf::log::ELogLevel::INFO, "UT", "3");
+    SubmitThread producer(backend, submitted);
+    producer.Start();
+    bpf::system::Thread::Sleep(50);
+    EXPECT_FALSE(submitted);
+    gate = true;
+    producer.Join();
+    EXPECT_TRUE(submitted);
+    backend.Flush();
+    ASSERT_EQ(log.Size(), 4u);
+    EXPECT_STREQ(*log.Last(), "[UT] 2 4");
+    EXPECT_EQ(backend.GetDroppedCount(), 0u);
+}
+
+TEST(Logger, Async_CountDrops)
+{
+    bpf::collection::List<bpf::String> log;
+    std::atomic<bool> gate(false);
+    std::atomic<bool> entered(false);
+    bpf::log::AsyncLogBackend backend(2, bpf::log::EOverflowPolicy::COUNT_DROPS);
+
+    backend.AddHandler(bpf::memory::MakeUnique<GatedLog>(log, gate, entered));
+    backend.Submit(bpf::log::ELogLevel::INFO, "UT", "1");
+    while (!entered)
+        bpf::system::Thread::Sleep(1);
+    backend.Submit(bpf::log::ELogLevel::INFO, "UT", "2");
+    backend.Submit(bpf::log::ELogLevel::INFO, "UT", "3");
+    backend.Submit(bpf::log::ELogLevel::INFO, "UT", "4");
+    backend.Submit(bpf::log::ELogLevel::INFO, "UT", "5");
+    EXPECT_EQ(backend.GetDroppedCount(), 2u);
+    gate = true;
+    backend.Flush();
+    EXPECT_EQ(log.Size(), 4u);
+    EXPECT_NE(log.FindByValue("[AsyncLog] 1 2 log message(s) dropped: queue is full"), log.end());
+}
+
+TEST(Logger, FileLogger)
+{
+    bpf::io::File f("./logger_test.txt");
+    {
+        auto lg = bpf::log::Logger("UT");
+        lg.AddHandler(bpf::memory::MakeUnique<bpf::log::FileLogger>(f, 16));
+        lg.Info("This is a test");
+        lg.Error("Second line");
+    }
+    char buf[256];
+    bpf::io::FileStream stream(f, bpf::io::FILE_MODE_READ);
+    auto len = stream.Read(buf, sizeof(buf) - 1);
+    stream.Close();
+    buf[len] = '\0';
+    auto str = bpf::String(buf);
+    EXPECT_TRUE(str.StartsWith("("));
+    EXPECT_TRUE(str.Contains(")[UT][INFO] This is a test"));
+    EXPECT_TRUE(str.Contains(")[UT][ERROR] Second line"));
+    f.Delete();
+}
+
+TEST(Logger, BinaryFile_Corrupted)
+{
+    bpf::uint32 lengths[] = {0xFFFFFFFF, 1000};
+    for (auto len : lengths)
+    {
+        bpf::io::ByteBuf buf(64);
+        bpf::io::BinaryWriter writer(buf);
+        writer << bpf::log::BINARY_LOG_MAGIC << bpf::log::BINARY_LOG_VERSION << bpf::log::BINARY_LOG_FORMAT
+               << (bpf::uint32)0 << len;
+        writer.Write("abc", 3);
+        writer.Flush();
+        buf.Seek(0);
+        bpf::log::BinaryLogReader reader(buf);
+        bpf::String category;
+        bpf::log::LogRecord record;
+        EXPECT_THROW(reader.ReadNext(category, record), bpf::io::IOException);
+    }
+}
+
+class RecordLog final : public bpf::log::ILogAdapter
+{
+private:
+    bpf::collection::List<bpf::log::LogRecord> &_log;
+
+public:
+    explicit RecordLog(bpf::collection::List<bpf::log::LogRecord> &log)
+        : _log(log)
+    {
+    }
+
+    void LogMessage(bpf::log::ELogLevel, const bpf::String &, const bpf::String &) final
+    {
+    }
+
+    void Log(const bpf::String &, const bpf::log::LogRecord &record) final
+    {
+        _log.Add(record);
+    }
+};
+
+TEST(Logger, Structured_Lazy)
+{
+    bpf::collection::List<bpf::log::LogRecord> log;
+    auto lg = bpf::log::Logger("UT");
+
+    lg.AddHandler(bpf::memory::MakeUnique<RecordLog>(log));
+    lg.SetLevel(bpf::log::ELogLevel::INFO);
+    lg.Debug("Ignored []", 1);
+    EXPECT_EQ(log.Size(), 0u);
+    lg.Info("Value [] [] [] [.2] []", 42, 42u, bpf::String("str"), 3.14159, true);
+    ASSERT_EQ(log.Size(), 1u);
+    EXPECT_EQ(log.Last().GetArgumentCount(), 5u);
+    EXPECT_TRUE(log.Last().GetText().IsEmpty());
+    EXPECT_STREQ(*log.Last().ToString(), "Value 42 42 str 3.14 TRUE");
+}
+
+TEST(Logger, Structured_Format)
+{
+    bpf::log::LogRecord rec(bpf::log::ELogLevel::INFO, "[4,right,0]|[3,left, ]|\\[]", 7, "ab");
+    EXPECT_STREQ(*rec.ToString(), "0007|ab |\\[]");
+    bpf::log::LogRecord rec1(bpf::log::ELogLevel::INFO, "No args []");
+    EXPECT_STREQ(*rec1.ToString(), "No args []");
+    bpf::log::LogRecord rec2(bpf::log::ELogLevel::INFO, "Too many []", 1, 2);
+    EXPECT_STREQ(*rec2.ToString(), "Too many 1");
+}
+
+TEST(Logger, Structured_Escapes)
+{
+    bpf::collection::List<bpf::String> log;
+    auto lg = bpf::log::Logger("UT");
+
+    lg.AddHandler(bpf::memory::MakeUnique<MemoryLog>(log));
+    lg.Info("Loading C:\\Users\\x");
+    lg.Info(bpf::String("Loading C:\\Users\\x"));
+    EXPECT_STREQ(*log.First(), "[UT] 2 Loading C:\\Users\\x");
+    EXPECT_EQ(log.First(), log.Last());
+    log.Clear();
+    lg.Info("v=[] rest C:\\a", 3);
+    lg.Info(bpf::String("v=[] rest C:\\a"), 3);
+    EXPECT_STREQ(*log.First(), "[UT] 2 v=3 rest C:\\a");
+    EXPECT_EQ(log.First(), log.Last());
+    log.Clear();
+    lg.Info("lit \\[] then []", 1, 2);
+    lg.Info(bpf::String("lit \\[] then []"), 1, 2);
+    EXPECT_STREQ(*log.First(), "[UT] 2 lit [] then []");
+    EXPECT_EQ(log.First(), log.Last());
+    log.Clear();
+    lg.Info("[] and \\[] then [] \\ end", "a", 1, 2);
+    lg.Info(bpf::String("[] and \\[] then [] \\ end"), "a", 1, 2);
+    EXPECT_EQ(log.First(), log.Last());
+    log.Clear();
+    lg.Info("surplus [] \\ []", 1, 2, 3);
+    lg.Info(bpf::String("surplus [] \\ []"), 1, 2, 3);
+    EXPECT_EQ(log.First(), log.Last());
+    log.Clear();
+    char buf[32] = "Buffer []";
+    lg.Info(buf, 5); // Mutable buffers are copied instead of referenced
+    buf[0] = 'X';
+    EXPECT_STREQ(*log.Last(), "[UT] 2 Buffer 5");
+}
+
+TEST(Logger, Structured_Fallback)
+{
+    char big[200];
+    for (int i = 0; i != 199; ++i)
+        big[i] = 'a';
+    big[199] = 0;
+    bpf::log::LogRecord rec(bpf::log::ELogLevel::INFO, "Big []", big);
+    EXPECT_EQ(rec.GetFormat(), nullptr);
+    EXPECT_EQ(rec.ToString(), bpf::String("Big ") + big);
+    bpf::log::LogRecord rec1(bpf::log::ELogLevel::INFO, "Pointer []", (void *)nullptr);
+    EXPECT_EQ(rec1.GetFormat(), nullptr);
+    EXPECT_STREQ(*rec1.ToString(), "Pointer 0x0");
+}
+
+TEST(Logger, Structured_CompatAdapter)
+{
+    bpf::collection::List<bpf::String> log;
+    auto lg = bpf::log::Logger("UT");
+
+    lg.AddHandler(bpf::memory::MakeUnique<MemoryLog>(log));
+    lg.Info("Test [] []", 1, "a");
+    EXPECT_STREQ(*log.Last(), "[UT] 2 Test 1 a");
+    BP_LOG_WARNING(lg, "Macro []", 2);
+    EXPECT_STREQ(*log.Last(), "[UT] 1 Macro 2");
+}
+
+TEST(Logger, BinaryFile)
+{
+    bpf::io::File f("./logger_test.bin");
+    {
+        auto backend = bpf::memory::MakeShared<bpf::log::AsyncLogBackend>();
+        backend->AddHandler(bpf::memory::MakeUnique<bpf::log::BinaryFileLogger>(f));
+        auto lg = bpf::log::Logger("UT");
+        auto lg1 = bpf::log::Logger("UT1");
+        lg.AddHandler(bpf::memory::MakeUnique<bpf::log::AsyncLogAdapter>(backend));
+        lg1.AddHandler(bpf::memory::MakeUnique<bpf::log::AsyncLogAdapter>(backend));
+        for (int i = 0; i != 3; ++i)
+            lg.Info("Iteration [] of []", i, bpf::String("loop"));
+        lg1.Error(bpf::String("Text message"));
+        lg1.Warning("Float [.1]", 2.5f);
+    }
+    bpf::io::FileStream stream(f, bpf::io::FILE_MODE_READ);
+    bpf::log::BinaryLogReader reader(stream);
+    bpf::String category;
+    bpf::log::LogRecord record;
+    for (int i = 0; i != 3; ++i)
+    {
+        ASSERT_TRUE(reader.ReadNext(category, record));
+        EXPECT_STREQ(*category, "UT");
+        EXPECT_EQ(record.GetLevel(), bpf::log::ELogLevel::INFO);
+        EXPECT_GT(record.GetTime(), 0);
+        EXPECT_EQ(record.ToString(), bpf::String("Iteration ") + bpf::String::ValueOf(i) + " of loop");
+    }
+    ASSERT_TRUE(reader.ReadNext(category, record));
+    EXPECT_STREQ(*category, "UT1");
+    EXPECT_EQ(record.GetLevel(), bpf::log::ELogLevel::ERROR);
+    EXPECT_STREQ(*record.ToString(), "Text message");
+    ASSERT_TRUE(reader.ReadNext(category, record));
+    EXPECT_EQ(record.GetLevel(), bpf::log::ELogLevel::WARNING);
+    EXPECT_STREQ(*record.ToString(), "Float 2.5");
+    EXPECT_FALSE(reader.ReadNext(category, record));
+    stream.Close();
+    f.Delete();
+}
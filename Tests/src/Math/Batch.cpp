@@ -0,0 +1,188 @@
+// Copyright (c) 2020, BlockProject 3D
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without modification,
+// are permitted provided that the following conditions are met:
+// 
+//     * Redistributions of source code must retain the above copyright notice,
+//       this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above copyright notice,
+//       this list of conditions and the following disclaimer in the documentation
+//       and/or other materials provided with the distribution.
+//     * Neither the name of BlockProject 3D nor the names of its contributors
+//       may be used to endorse or promote products derived from this software
+//       without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include <cassert>
+#include <iostream>
+#include <gtest/gtest.h>
+#include <Framework/Math/Batch.hpp>
+#include <Framework/Math/Transform3.hpp>
+#include <Framework/Collection/Array.hpp>
+
+using namespace bpf::math;
+using namespace bpf::collection;
+using namespace bpf;
+
+static Matrix4f GetTestMatrix()
+{
+    Transform3f transform(Vector3f(1, -2, 3), Vector3f(2, 0.5f, 1), Quaternionf(Vector3f(0.3f, 1.2f, -0.7f)));
+
+    return (transform.ToMatrix());
+}
+
+static Vector3f GetTestPoint(fsize i)
+{
+    return (Vector3f((float)(i % 17) - 8.0f, (float)(i % 5) * 0.25f, -(float)(i % 11)));
+}
+
+static void ExpectNear(const Vector3f &a, const Vector3f &b)
+{
+    EXPECT_NEAR(a.X, b.X, 1e-4f);
+    EXPECT_NEAR(a.Y, b.Y, 1e-4f);
+    EXPECT_NEAR(a.Z, b.Z, 1e-4f);
+}
+
+TEST(Batch, TransformPoints)
+{
+    Matrix4f mat = GetTestMatrix();
+    Array<Vector3f> points(37);
+    Array<Vector3f> res(37);
+
+    for (fsize i = 0; i != points.Size(); ++i)
+        points[i] = GetTestPoint(i);
+    Batchf::TransformPoints(mat, *points, *res, points.Size());
+    for (fsize i = 0; i != points.Size(); ++i)
+    {
+        auto expected = mat * Vector4f(points[i], 1);
+        ExpectNear(res[i], Vector3f(expected.X, expected.Y, expected.Z));
+    }
+    Batchf::TransformDirections(mat, *points, *points, points.Size());
+    for (fsize i = 0; i != points.Size(); ++i)
+    {
+        auto expected = mat * Vector4f(GetTestPoint(i), 0);
+        ExpectNear(points[i], Vector3f(expected.X, expected.Y, expected.Z));
+    }
+}
+
+TEST(Batch, Transform4)
+{
+    Matrix4f mat = GetTestMatrix();
+    Array<Vector4f> vecs(13);
+
+    for (fsize i = 0; i != vecs.Size(); ++i)
+        vecs[i] = Vector4f(GetTestPoint(i), (float)i);
+    Batchf::Transform(mat, *vecs, *vecs, vecs.Size());
+    for (fsize i = 0; i != vecs.Size(); ++i)
+    {
+        auto expected = mat * Vector4f(GetTestPoint(i), (float)i);
+        ExpectNear(Vector3f(vecs[i].X, vecs[i].Y, vecs[i].Z), Vector3f(expected.X, expected.Y, expected.Z));
+        EXPECT_NEAR(vecs[i].W, expected.W, 1e-4f);
+    }
+}
+
+TEST(Batch, TransformSpan)
+{
+    Matrix4f mat = GetTestMatrix();
+    Array<float> x(1003);
+    Array<float> y(1003);
+    Array<float> z(1003);
+
+    for (fsize i = 0; i != x.Size(); ++i)
+    {
+        auto p = GetTestPoint(i);
+        x[i] = p.X;
+        y[i] = p.Y;
+        z[i] = p.Z;
+    }
+    Vector3fSpan span(*x, *y, *z, x.Size());
+    Batchf::TransformPoints(mat, span, span);
+    for (fsize i = 0; i != span.Size; ++i)
+    {
+        auto expected = mat * Vector4f(GetTestPoint(i), 1);
+        ExpectNear(span[i], Vector3f(expected.X, expected.Y, expected.Z));
+    }
+}
+
+TEST(Batch, Bounds)
+{
+    Array<Vector3f> points(23);
+    Array<float> x(23);
+    Array<float> y(23);
+    Array<float> z(23);
+
+    for (fsize i = 0; i != points.Size(); ++i)
+    {
+        points[i] = GetTestPoint(i);
+        x[i] = points[i].X;
+        y[i] = points[i].Y;
+        z[i] = points[i].Z;
+    }
+    auto box = Batchf::ComputeBounds(*points, points.Size());
+    EXPECT_EQ(box.GetMin(), Vector3f(-8, 0, -10));
+    EXPECT_EQ(box.GetMax(), Vector3f(8, 1, 0));
+    auto box1 = Batchf::ComputeBounds(Vector3fSpan(*x, *y, *z, x.Size()));
+    EXPECT_EQ(box1.GetMin(), Vector3f(-8, 0, -10));
+    EXPECT_EQ(box1.GetMax(), Vector3f(8, 1, 0));
+    auto empty = Batchf::ComputeBounds(*points, 0);
+    EXPECT_EQ(empty.Extent, Vector3f::Zero);
+}
+
+TEST(Batch, ToMatrices)
+{
+    Array<Quaternionf> quats(9);
+    Array<Matrix4f> mats(9);
+
+    for (fsize i = 0; i != quats.Size(); ++i)
+        quats[i] = Quaternionf(Vector3f((float)i * 0.1f, (float)i * -0.3f, 1.0f));
+    Batchf::ToMatrices(*quats, *mats, quats.Size());
+    for (fsize i = 0; i != quats.Size(); ++i)
+    {
+        auto expected = quats[i].ToMatrix();
+        for (fsize j = 0; j != 16; ++j)
+            EXPECT_NEAR((*mats[i])[j], (*expected)[j], 1e-5f);
+    }
+}
+
+TEST(Batch, Parallel)
+{
+    Matrix4f mat = GetTestMatrix();
+    Array<Vector3f> points(10000);
+    Array<Vector3f> res(10000);
+    system::ThreadPool pool(3);
+
+    for (fsize i = 0; i != points.Size(); ++i)
+        points[i] = GetTestPoint(i);
+    Batchf::TransformPoints(pool, mat, *points, *res, points.Size());
+    for (fsize i = 0; i != points.Size(); ++i)
+    {
+        auto expected = mat * Vector4f(points[i], 1);
+        ExpectNear(res[i], Vector3f(expected.X, expected.Y, expected.Z));
+    }
+    EXPECT_TRUE(pool.IsIdle());
+}
+
+TEST(Batch, Transform3)
+{
+    Transform3f transform(Vector3f(5, 0, -1), Vector3f(2));
+    Vector3f points[] = {Vector3f::Zero, Vector3f(1, 2, 3)};
+
+    transform.LocalToWorld(points, points, 2);
+    EXPECT_EQ(points[0], Vector3f(5, 0, -1));
+    EXPECT_EQ(points[1], Vector3f(7, 4, 5));
+    transform.WorldToLocal(points, points, 2);
+    ExpectNear(points[1], Vector3f(1, 2, 3));
+}
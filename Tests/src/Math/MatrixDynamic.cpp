@@ -31,6 +31,7 @@
 #include <gtest/gtest.h>
 #include <Framework/Math/Matrix.hpp>
 #include <Framework/Math/Stringifier.Matrix.hpp>
+#include <Framework/System/ThreadPool.hpp>
 
 TEST(MatrixDynamic, Create_Test_1)
 {
@@ -313,6 +314,120 @@ TEST(MatrixDynamic, Matrix_Inverse_2)
     EXPECT_THROW(mat1.GetDeterminant(), bpf::math::NonSquareMatrixException);
 }
 
+TEST(MatrixDynamic, Matrix_Inverse_LU)
+{
+    bpf::math::Matrix<double> mat(12, 12);
+
+    for (bpf::fsize i = 0; i != 12; ++i)
+    {
+        for (bpf::fsize j = 0; j != 12; ++j)
+            mat(i, j) = i == j ? 20.0 : (double)((i * 5 + j * 11) % 7) - 3.0;
+    }
+    bpf::math::Matrix<double> res = mat * mat.Inverse();
+    for (bpf::fsize i = 0; i != 12; ++i)
+    {
+        for (bpf::fsize j = 0; j != 12; ++j)
+            EXPECT_NEAR(res(i, j), i == j ? 1.0 : 0.0, 1e-9);
+    }
+    EXPECT_THROW(bpf::math::Matrix<double>::Zero(12, 12).Inverse(), bpf::math::NonInvertibleMatrixException);
+}
+
+TEST(MatrixDynamic, Determinant)
+{
+    bpf::math::Matrix<int> mat(5, 5, {
+        0, 2, 1, 3, 1,
+        1, 0, 2, 0, 4,
+        3, 1, 0, 2, 2,
+        2, 2, 1, 0, 1,
+        1, 3, 0, 1, 0
+    });
+    bpf::math::Matrix<double> diag = bpf::math::Matrix<double>::Identity(20) * 2.0;
+
+    EXPECT_EQ(mat.GetDeterminant(), -82);
+    diag.SwapRows(0, 19);
+    EXPECT_NEAR(diag.GetDeterminant(), -1048576.0, 1e-6);
+}
+
+TEST(MatrixDynamic, Solve)
+{
+    bpf::math::Matrix<double> mat(3, 3, {
+        2, 1, -1,
+        -3, -1, 2,
+        -2, 1, 2
+    });
+    bpf::math::Vector<double> res = bpf::math::Matrix<double>::Solve(mat, bpf::math::Vector<double>({8, -11, -3}));
+
+    EXPECT_NEAR(res(0), 2.0, 1e-12);
+    EXPECT_NEAR(res(1), 3.0, 1e-12);
+    EXPECT_NEAR(res(2), -1.0, 1e-12);
+    EXPECT_THROW(bpf::math::Matrix<double>::Solve(mat, bpf::math::Vector<double>({1, 2})), bpf::math::IncompatibleMatrixSizeException);
+    EXPECT_THROW(bpf::math::Matrix<double>::Solve(bpf::math::Matrix<double>(2, 3), res), bpf::math::NonSquareMatrixException);
+}
+
+template <typename T>
+static bpf::math::Matrix<T> GenMatrix(bpf::fsize n, bpf::fsize m, bpf::fsize seed)
+{
+    bpf::math::Matrix<T> mat(n, m);
+
+    for (bpf::fsize i = 0; i != n * m; ++i)
+        (*mat)[i] = (T)((i * 7 + seed * 13) % 19) - (T)9;
+    return (mat);
+}
+
+template <typename T>
+static bpf::math::Matrix<T> NaiveMultiply(const bpf::math::Matrix<T> &a, const bpf::math::Matrix<T> &b)
+{
+    bpf::math::Matrix<T> res(a.Rows(), b.Columns());
+
+    for (bpf::fsize i = 0; i != a.Rows(); ++i)
+    {
+        for (bpf::fsize j = 0; j != b.Columns(); ++j)
+        {
+            T sum = 0;
+            for (bpf::fsize k = 0; k != a.Columns(); ++k)
+                sum += a(i, k) * b(k, j);
+            res(i, j) = sum;
+        }
+    }
+    return (res);
+}
+
+TEST(MatrixDynamic, Gemm)
+{
+    // Sizes chosen to cross the KC depth and leave partial register tiles on both borders
+    auto a = GenMatrix<double>(137, 301, 1);
+    auto b = GenMatrix<double>(301, 71, 2);
+    auto ai = GenMatrix<int>(45, 33, 3);
+    auto bi = GenMatrix<int>(33, 29, 4);
+    auto af = GenMatrix<float>(66, 70, 5);
+    auto bf = GenMatrix<float>(70, 13, 6);
+
+    EXPECT_EQ(a * b, NaiveMultiply(a, b));
+    EXPECT_EQ(ai * bi, NaiveMultiply(ai, bi));
+    EXPECT_EQ(af * bf, NaiveMultiply(af, bf));
+}
+
+TEST(MatrixDynamic, Gemm_MultiplyAdd)
+{
+    auto a = GenMatrix<float>(90, 40, 1);
+    auto b = GenMatrix<float>(40, 50, 2);
+    bpf::math::Matrix<float> c(90, 50, 1.0f);
+    bpf::math::Matrix<float> expected = NaiveMultiply(a, b) + bpf::math::Matrix<float>(90, 50, 1.0f);
+    bpf::system::ThreadPool pool(3);
+
+    c.MultiplyAdd(a, b);
+    EXPECT_EQ(c, expected);
+    EXPECT_THROW(c.MultiplyAdd(b, a), bpf::math::IncompatibleMatrixSizeException);
+    EXPECT_THROW(c.MultiplyAdd(a, a), bpf::math::IncompatibleMatrixSizeException);
+    auto big = GenMatrix<double>(300, 200, 3);
+    auto big1 = GenMatrix<double>(200, 150, 4);
+    EXPECT_EQ(bpf::math::Matrix<double>::Multiply(pool, big, big1), NaiveMultiply(big, big1));
+    bpf::math::Matrix<double> acc = NaiveMultiply(big, big1);
+    acc.MultiplyAdd(pool, big, big1);
+    EXPECT_EQ(acc, NaiveMultiply(big, big1) * 2.0);
+    EXPECT_TRUE(pool.IsIdle());
+}
+
 TEST(MatrixDynamic, Stringifier)
 {
     bpf::math::Matrix<int> mat(4, 4, {
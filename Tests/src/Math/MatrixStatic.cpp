@@ -311,6 +311,92 @@ TEST(MatrixStatic, Matrix_Inverse_2)
     EXPECT_THROW(mat.Inverse(), bpf::math::NonInvertibleMatrixException);
 }
 
+TEST(MatrixStatic, Matrix_Inverse_3)
+{
+    bpf::math::Matrix3f mat3 = {
+        2, -1, 0,
+        -1, 2, -1,
+        0, -1, 2
+    };
+    bpf::math::Matrix4f mat4 = {
+        4, 7, 2, 3,
+        0, 5, 0, 1,
+        1, 0, 3, 0,
+        2, 6, 1, 8
+    };
+    bpf::math::Matrix3f res3 = mat3 * mat3.Inverse();
+    bpf::math::Matrix4f res4 = mat4 * mat4.Inverse();
+
+    for (bpf::fsize i = 0; i != 3; ++i)
+    {
+        for (bpf::fsize j = 0; j != 3; ++j)
+            EXPECT_NEAR(res3(i, j), i == j ? 1.0f : 0.0f, 1e-5f);
+    }
+    for (bpf::fsize i = 0; i != 4; ++i)
+    {
+        for (bpf::fsize j = 0; j != 4; ++j)
+            EXPECT_NEAR(res4(i, j), i == j ? 1.0f : 0.0f, 1e-5f);
+    }
+    EXPECT_FLOAT_EQ(mat3.GetDeterminant(), 4.0f);
+}
+
+TEST(MatrixStatic, Matrix_Inverse_LU)
+{
+    bpf::math::Matrix<double, 6, 6> mat;
+
+    for (bpf::fsize i = 0; i != 6; ++i)
+    {
+        for (bpf::fsize j = 0; j != 6; ++j)
+            mat(i, j) = i == j ? 10.0 : (double)((i * 7 + j * 3) % 5) - 2.0;
+    }
+    bpf::math::Matrix<double, 6, 6> res = mat * mat.Inverse();
+    for (bpf::fsize i = 0; i != 6; ++i)
+    {
+        for (bpf::fsize j = 0; j != 6; ++j)
+            EXPECT_NEAR(res(i, j), i == j ? 1.0 : 0.0, 1e-12);
+    }
+    EXPECT_THROW((bpf::math::Matrix<double, 6, 6>().Inverse()), bpf::math::NonInvertibleMatrixException);
+}
+
+TEST(MatrixStatic, Determinant)
+{
+    bpf::math::Matrix<int, 4, 4> mat4 = {
+        5, 9, 8, 5,
+        7, 2, 6, 7,
+        1, 3, 1, 0,
+        8, 4, 5, 2
+    };
+    bpf::math::Matrix<int, 5, 5> mat5 = {
+        0, 2, 1, 3, 1,
+        1, 0, 2, 0, 4,
+        3, 1, 0, 2, 2,
+        2, 2, 1, 0, 1,
+        1, 3, 0, 1, 0
+    };
+    bpf::math::Matrix<double, 5, 5> matd;
+
+    for (bpf::fsize i = 0; i != 25; ++i)
+        (*matd)[i] = (double)(*mat5)[i];
+    EXPECT_EQ(mat4.GetDeterminant(), -235);
+    EXPECT_EQ(mat5.GetDeterminant(), -82);
+    EXPECT_NEAR(matd.GetDeterminant(), -82.0, 1e-9);
+}
+
+TEST(MatrixStatic, Solve)
+{
+    bpf::math::Matrix3<double> mat = {
+        2, 1, -1,
+        -3, -1, 2,
+        -2, 1, 2
+    };
+    bpf::math::Vector3<double> res = bpf::math::Matrix3<double>::Solve(mat, bpf::math::Vector3<double>(8, -11, -3));
+
+    EXPECT_NEAR(res.X, 2.0, 1e-12);
+    EXPECT_NEAR(res.Y, 3.0, 1e-12);
+    EXPECT_NEAR(res.Z, -1.0, 1e-12);
+    EXPECT_THROW(bpf::math::Matrix3<double>::Solve(bpf::math::Matrix3<double>(), res), bpf::math::NonInvertibleMatrixException);
+}
+
 TEST(MatrixStatic, Multiply_Vec2)
 {
     bpf::math::Matrix2<int> mat = {
@@ -363,4 +449,37 @@ TEST(MatrixStatic, Stringifier)
     };
 
     EXPECT_STREQ(*bpf::String::ValueOf(mat), "Matrix(\n\t5\t9\t8\t5\n\t7\t2\t6\t7\n\t3\t4\t1\t6\n\t4\t5\t8\t1\n)");
-}
\ No newline at end of file
+}
+TEST(MatrixStatic, SIMD_Matrix4f)
+{
+    bpf::math::Matrix4f a;
+    bpf::math::Matrix4f b;
+    bpf::math::Matrix4<double> ad;
+    bpf::math::Matrix4<double> bd;
+    for (bpf::fsize i = 0; i != 4; ++i)
+    {
+        for (bpf::fsize j = 0; j != 4; ++j)
+        {
+            a(i, j) = (float)(i * 4 + j) * 0.5f - 3.0f;
+            b(i, j) = (float)((i + 2) * (j + 1) % 7) - 1.5f;
+            ad(i, j) = a(i, j);
+            bd(i, j) = b(i, j);
+        }
+    }
+    auto mul = a * b;
+    auto muld = ad * bd;
+    auto tr = a.Transpose();
+    bpf::math::Vector4f v(1.0f, -2.0f, 0.5f, 3.0f);
+    auto mv = a * v;
+    auto mvd = ad * bpf::math::Vector4<double>(1.0, -2.0, 0.5, 3.0);
+    for (bpf::fsize i = 0; i != 4; ++i)
+    {
+        for (bpf::fsize j = 0; j != 4; ++j)
+        {
+            EXPECT_FLOAT_EQ(mul(i, j), (float)muld(i, j));
+            EXPECT_EQ(tr(i, j), a(j, i));
+        }
+        EXPECT_FLOAT_EQ(mv(i), (float)mvd(i));
+    }
+    EXPECT_EQ(a * bpf::math::Matrix4f::Identity, a);
+}
@@ -138,3 +138,26 @@ TEST(Quat, Stringifier)
 
     EXPECT_STREQ(*bpf::String::ValueOf(q), "Quaternion(1 + 2i + 3j + 4k)");
 }
+
+TEST(Quat, SIMD_Float)
+{
+    bpf::math::Quaternionf a(0.5f, 1.0f, -2.0f, 0.25f);
+    bpf::math::Quaternionf b(-1.5f, 0.75f, 2.0f, 3.0f);
+    bpf::math::Quaternion<double> ad(0.5, 1.0, -2.0, 0.25);
+    bpf::math::Quaternion<double> bd(-1.5, 0.75, 2.0, 3.0);
+    auto mul = a * b;
+    auto muld = ad * bd;
+    EXPECT_FLOAT_EQ(mul.W, (float)muld.W);
+    EXPECT_FLOAT_EQ(mul.I, (float)muld.I);
+    EXPECT_FLOAT_EQ(mul.J, (float)muld.J);
+    EXPECT_FLOAT_EQ(mul.K, (float)muld.K);
+    // Rotation matches q * p * conjugate(q), including for non unit quaternions
+    bpf::math::Vector3f v(1.0f, 2.0f, -3.0f);
+    auto rot = a.Rotate(v);
+    auto rotd = ad.Rotate(bpf::math::Vector3<double>(1.0, 2.0, -3.0));
+    EXPECT_FLOAT_EQ(rot.X, (float)rotd.X);
+    EXPECT_FLOAT_EQ(rot.Y, (float)rotd.Y);
+    EXPECT_FLOAT_EQ(rot.Z, (float)rotd.Z);
+    auto unit = bpf::math::Quaternionf(bpf::math::Vector3f::Up, bpf::math::Mathf::Pi / 2);
+    EXPECT_NEAR(unit.Rotate(bpf::math::Vector3f::Forward).Norm(), 1.0f, 1e-5f);
+}
@@ -0,0 +1,142 @@
+// Copyright (c) 2020, BlockProject 3D
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without modification,
+// are permitted provided that the following conditions are met:
+// 
+//     * Redistributions of source code must retain the above copyright notice,
+//       this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above copyright notice,
+//       this list of conditions and the following disclaimer in the documentation
+//       and/or other materials provided with the distribution.
+//     * Neither the name of BlockProject 3D nor the names of its contributors
+//       may be used to endorse or promote products derived from this software
+//       without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include <cassert>
+#include <iostream>
+#include <gtest/gtest.h>
+#include <Framework/Math/Random.hpp>
+#include <cstring>
+
+using namespace bpf::math;
+using namespace bpf;
+
+TEST(Random, Seed)
+{
+    Random a(42);
+    Random b(42);
+    Random c(43);
+    Random d;
+    Random e;
+    bool diff = false;
+    bool diff1 = false;
+
+    for (fsize i = 0; i != 64; ++i)
+    {
+        uint64 v = a.NextUInt64();
+        EXPECT_EQ(v, b.NextUInt64());
+        diff |= v != c.NextUInt64();
+        diff1 |= d.NextUInt64() != e.NextUInt64();
+    }
+    EXPECT_TRUE(diff);
+    EXPECT_TRUE(diff1);
+}
+
+TEST(Random, Bounds)
+{
+    Random rnd(1);
+    bool seen[4] = {false, false, false, false};
+
+    for (fsize i = 0; i != 1000; ++i)
+    {
+        fint v = rnd.NextInt(10, 13);
+        ASSERT_GE(v, 10);
+        ASSERT_LE(v, 13);
+        seen[v - 10] = true;
+        EXPECT_LE(rnd.NextInt(5), 5);
+        EXPECT_GE(rnd.NextInt(5), 0);
+        EXPECT_GE(rnd.NextInt(-3, -1), -3);
+        EXPECT_LE(rnd.NextInt(-3, -1), -1);
+        EXPECT_LE(rnd.NextByte(7), 7);
+        uint16 s = rnd.NextShort(100, 200);
+        EXPECT_GE(s, 100);
+        EXPECT_LE(s, 200);
+    }
+    EXPECT_TRUE(seen[0] && seen[1] && seen[2] && seen[3]);
+    EXPECT_EQ(rnd.NextInt(7, 7), 7);
+    rnd.NextInt(Int::MinValue, Int::MaxValue);
+}
+
+TEST(Random, Floats)
+{
+    Random rnd(2);
+    double sum = 0;
+
+    for (fsize i = 0; i != 10000; ++i)
+    {
+        float f = rnd.NextFloat();
+        double d = rnd.NextDouble();
+        ASSERT_GE(f, 0.0f);
+        ASSERT_LT(f, 1.0f);
+        ASSERT_GE(d, 0.0);
+        ASSERT_LT(d, 1.0);
+        sum += d;
+        float g = rnd.NextFloat(5.0f);
+        ASSERT_GE(g, 5.0f);
+        ASSERT_LT(g, 6.0f);
+    }
+    EXPECT_NEAR(sum / 10000, 0.5, 0.02);
+}
+
+TEST(Random, Fill)
+{
+    Random rnd(3);
+    float floats[1027];
+    double doubles[33];
+    uint8 bytes[45];
+    double sum = 0;
+
+    rnd.Fill(floats, 1027);
+    for (auto f : floats)
+    {
+        ASSERT_GE(f, 0.0f);
+        ASSERT_LT(f, 1.0f);
+        sum += f;
+    }
+    EXPECT_NEAR(sum / 1027, 0.5, 0.05);
+    rnd.Fill(doubles, 33);
+    for (auto d : doubles)
+    {
+        ASSERT_GE(d, 0.0);
+        ASSERT_LT(d, 1.0);
+    }
+    std::memset(bytes, 0, sizeof(bytes));
+    rnd.Fill(bytes, 45);
+    fsize zeros = 0;
+    for (auto b : bytes)
+        zeros += b == 0 ? 1 : 0;
+    EXPECT_LT(zeros, 10U);
+}
+
+TEST(Random, Jump)
+{
+    Random a(4);
+    Random b = a;
+
+    b.Jump();
+    EXPECT_NE(a.NextUInt64(), b.NextUInt64());
+}
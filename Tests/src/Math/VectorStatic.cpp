@@ -778,4 +778,26 @@ TEST(VectorStatic, Stringifier)
     bpf::math::Vector4<int> v = { 0, 4, 2, 6 };
 
     EXPECT_STREQ(*bpf::String::ValueOf(v), "Vector(0, 4, 2, 6)");
-}
\ No newline at end of file
+}
+TEST(VectorStatic, SIMD_Vector4f)
+{
+    bpf::math::Vector4f a(1.0f, -2.0f, 3.5f, 4.0f);
+    bpf::math::Vector4f b(0.5f, 4.0f, -1.0f, 2.0f);
+
+    EXPECT_EQ(a + b, bpf::math::Vector4f(1.5f, 2.0f, 2.5f, 6.0f));
+    EXPECT_EQ(a - b, bpf::math::Vector4f(0.5f, -6.0f, 4.5f, 2.0f));
+    EXPECT_EQ(a * b, bpf::math::Vector4f(0.5f, -8.0f, -3.5f, 8.0f));
+    EXPECT_EQ(a / b, bpf::math::Vector4f(2.0f, -0.5f, -3.5f, 2.0f));
+    EXPECT_EQ(a * 2.0f, bpf::math::Vector4f(2.0f, -4.0f, 7.0f, 8.0f));
+    EXPECT_FLOAT_EQ(a.Dot(b), 0.5f - 8.0f - 3.5f + 8.0f);
+    EXPECT_FLOAT_EQ(a.NormSquared(), 1.0f + 4.0f + 12.25f + 16.0f);
+    auto c = a;
+    c += b;
+    EXPECT_EQ(c, a + b);
+    c -= b;
+    EXPECT_EQ(c, a);
+    c *= b;
+    EXPECT_EQ(c, a * b);
+    c *= 0.5f;
+    EXPECT_EQ(c, a * b * 0.5f);
+}
@@ -111,3 +111,98 @@ TEST(MathEval, EvaluateErr)
 	EXPECT_THROW(calc.Evaluate(" 0 / 0 "), bpf::EvalException);
 	EXPECT_THROW(calc.EvalNbr("12", 4, ptr), bpf::IndexException);
 }
+
+TEST(MathEval, Associativity)
+{
+	bpf::MathEval<int> calc;
+	EXPECT_EQ(calc.Evaluate("10 - 4 - 3"), 3);
+	EXPECT_EQ(calc.Evaluate("64 / 4 / 2"), 8);
+	EXPECT_EQ(calc.Evaluate("2 ^ 3 ^ 2"), 512);
+	EXPECT_EQ(calc.Evaluate("-2 ^ 2"), -4);
+}
+
+TEST(MathEval, Functions)
+{
+	bpf::MathEval<double> calc;
+	EXPECT_EQ(calc.Evaluate("sqrt(16) + abs(-2)"), 6);
+	EXPECT_EQ(calc.Evaluate("max(1, min(8, 3))"), 3);
+	EXPECT_EQ(calc.Evaluate("clamp(12, 0, 10)"), 10);
+	EXPECT_EQ(calc.Evaluate("pow(2, 10)"), 1024);
+	EXPECT_EQ(calc.Evaluate("floor(2.5) + ceil(2.5)"), 5);
+	EXPECT_NEAR(calc.Evaluate("sin(0) + cos(0) + exp(0) + log(1)"), 2, 1e-12);
+}
+
+TEST(MathEval, Variables)
+{
+	bpf::MathEval<double> calc;
+	auto prog = calc.Compile("x * x + y * 2 - x");
+	EXPECT_EQ(prog.GetVariables().Size(), 2U);
+	EXPECT_EQ(prog.GetVariableIndex("x"), 0);
+	EXPECT_EQ(prog.GetVariableIndex("y"), 1);
+	EXPECT_EQ(prog.GetVariableIndex("z"), -1);
+	EXPECT_EQ(prog.Evaluate({3, 4}), 14);
+	EXPECT_EQ(prog.Evaluate({-1, 0.5}), 3);
+	bpf::collection::ArrayList<bpf::String> order;
+	order.Add("y");
+	order.Add("x");
+	auto prog1 = calc.Compile("x - y", order);
+	EXPECT_EQ(prog1.GetVariableIndex("y"), 0);
+	EXPECT_EQ(prog1.Evaluate({1, 5}), 4);
+	EXPECT_THROW(prog1.Evaluate({1}), bpf::EvalException);
+	EXPECT_THROW(prog1.Evaluate(), bpf::EvalException);
+}
+
+TEST(MathEval, ConstantFolding)
+{
+	bpf::MathEval<double> calc;
+	EXPECT_EQ(calc.Compile("(1 + 2) * sqrt(4) - 3").GetInstructionCount(), 1U);
+	auto prog = calc.Compile("x * (2 + 3) + max(1, 2)");
+	EXPECT_EQ(prog.GetInstructionCount(), 5U);
+	EXPECT_EQ(prog.Evaluate({2}), 12);
+	EXPECT_THROW(calc.Compile("x + 1 / 0"), bpf::EvalException);
+}
+
+TEST(MathEval, Batch)
+{
+	bpf::MathEval<double> calc;
+	auto prog = calc.Compile("a * b - a / 2 + min(a, b) ^ 2");
+	double a[150];
+	double b[150];
+	double out[150];
+	for (int i = 0; i != 150; ++i)
+	{
+		a[i] = i + 1;
+		b[i] = 150 - i;
+	}
+	const double *vars[] = {a, b};
+	prog.Evaluate(vars, out, 150);
+	for (int i = 0; i != 150; ++i)
+		EXPECT_EQ(out[i], prog.Evaluate({a[i], b[i]}));
+}
+
+TEST(MathEval, EmptyProgram)
+{
+	bpf::MathEval<double>::Program prog;
+	double out[4];
+	EXPECT_THROW(prog.Evaluate(), bpf::EvalException);
+	EXPECT_THROW(prog.Evaluate(nullptr, out, 4), bpf::EvalException);
+}
+
+TEST(MathEval, CompileErr)
+{
+	bpf::MathEval<double> calc;
+	EXPECT_THROW(calc.Evaluate("x + 1"), bpf::EvalException);
+	EXPECT_THROW(calc.Evaluate("foo(1)"), bpf::EvalException);
+	EXPECT_THROW(calc.Evaluate("min(1)"), bpf::EvalException);
+	EXPECT_THROW(calc.Evaluate("(1 + 2"), bpf::EvalException);
+	EXPECT_THROW(calc.Evaluate("1 + 2)"), bpf::EvalException);
+	EXPECT_THROW(calc.Evaluate("1 +"), bpf::EvalException);
+	EXPECT_THROW(calc.Evaluate("5 % 0"), bpf::EvalException);
+	bpf::String deep;
+	for (int i = 0; i != 100; ++i)
+		deep += "1 + (x + ";
+	deep += "1";
+	for (int i = 0; i != 100; ++i)
+		deep += ")";
+	EXPECT_THROW(calc.Compile(deep), bpf::EvalException);
+}
@@ -0,0 +1,155 @@
+// Copyright (c) 2020, BlockProject 3D
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without modification,
+// are permitted provided that the following conditions are met:
+// 
+//     * Redistributions of source code must retain the above copyright notice,
+//       this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above copyright notice,
+//       this list of conditions and the following disclaimer in the documentation
+//       and/or other materials provided with the distribution.
+//     * Neither the name of BlockProject 3D nor the names of its contributors
+//       may be used to endorse or promote products derived from this software
+//       without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include <Framework/Collection/List.hpp>
+#include <Framework/Collection/Map.hpp>
+#include <Framework/Collection/Stringifier.List.hpp>
+#include <Framework/Collection/Stringifier.Map.hpp>
+#include <Framework/Memory/PoolAllocator.hpp>
+#include <Framework/String.hpp>
+#include <gtest/gtest.h>
+
+using namespace bpf::collection;
+using namespace bpf::memory;
+using namespace bpf;
+
+class Counted
+{
+public:
+    static int Alive;
+    int Val;
+
+    explicit Counted(int v)
+        : Val(v)
+    {
+        ++Alive;
+    }
+
+    Counted(const Counted &other)
+        : Val(other.Val)
+    {
+        ++Alive;
+    }
+
+    ~Counted()
+    {
+        --Alive;
+    }
+};
+
+int Counted::Alive = 0;
+
+TEST(PoolAllocator, Basic)
+{
+    PoolAllocator<Counted> pool;
+
+    EXPECT_EQ(pool.Capacity(), 0U);
+    Counted *a = pool.New(1);
+    Counted *b = pool.New(2);
+    EXPECT_EQ(Counted::Alive, 2);
+    EXPECT_EQ(pool.Capacity(), 32U);
+    EXPECT_NE(a, b);
+    pool.Delete(a);
+    EXPECT_EQ(Counted::Alive, 1);
+    Counted *c = pool.New(3);
+    EXPECT_EQ(c, a);
+    EXPECT_EQ(c->Val, 3);
+    pool.Delete(b);
+    pool.Delete(c);
+    pool.Delete(nullptr);
+    EXPECT_EQ(Counted::Alive, 0);
+    for (int i = 0; i != 100; ++i)
+        pool.New(i);
+    EXPECT_EQ(pool.Capacity(), 32U + 64U + 128U);
+    PoolAllocator<Counted> moved(std::move(pool));
+    EXPECT_EQ(pool.Capacity(), 0U);
+    EXPECT_EQ(moved.Capacity(), 224U);
+    moved.Release();
+    EXPECT_EQ(moved.Capacity(), 0U);
+    Counted::Alive = 0;
+}
+
+TEST(PoolAllocator, List)
+{
+    List<int, PoolAllocator> lst = {0, 1, 2};
+
+    for (int i = 3; i != 10000; ++i)
+        lst.Add(i);
+    lst.RemoveAt(0);
+    lst.Insert(0, 42);
+    EXPECT_EQ(lst.Size(), 10000U);
+    EXPECT_EQ(lst[0], 42);
+    EXPECT_EQ(lst[9999], 9999);
+    auto copy = lst;
+    EXPECT_TRUE(copy == lst);
+    auto moved = std::move(copy);
+    EXPECT_EQ(copy.Size(), 0U);
+    EXPECT_TRUE(moved == lst);
+    lst.Clear();
+    EXPECT_EQ(lst.Size(), 0U);
+    lst.Add(7);
+    EXPECT_STREQ(*String::ValueOf(lst), "[7]");
+    moved = std::move(lst);
+    EXPECT_STREQ(*String::ValueOf(moved), "[7]");
+}
+
+TEST(PoolAllocator, List_NonTrivial)
+{
+    {
+        List<Counted, PoolAllocator> lst;
+        for (int i = 0; i != 1000; ++i)
+            lst.Add(Counted(i));
+        EXPECT_EQ(Counted::Alive, 1000);
+        lst.RemoveLast();
+        EXPECT_EQ(Counted::Alive, 999);
+        lst.Clear();
+        EXPECT_EQ(Counted::Alive, 0);
+        lst.Add(Counted(1));
+    }
+    EXPECT_EQ(Counted::Alive, 0);
+}
+
+TEST(PoolAllocator, Map)
+{
+    Map<int, int, ops::Greater, ops::Less, PoolAllocator> map;
+
+    for (int i = 0; i != 10000; ++i)
+        map.Add((i * 7919) % 10000, i);
+    for (int i = 0; i != 10000; i += 2)
+        map.RemoveAt(i);
+    EXPECT_EQ(map.Size(), 5000U);
+    EXPECT_EQ(map.FindMin()->Key, 1);
+    auto copy = map;
+    EXPECT_TRUE(copy == map);
+    copy.Clear();
+    EXPECT_EQ(copy.Size(), 0U);
+    EXPECT_EQ(copy.begin(), copy.end());
+    Map<String, String, ops::Greater, ops::Less, PoolAllocator> strings = {{"a", "b"}, {"c", "d"}};
+    strings.RemoveAt("a");
+    EXPECT_STREQ(*String::ValueOf(strings), "{'c': d}");
+}
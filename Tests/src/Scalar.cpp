@@ -27,6 +27,8 @@
 // SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include <cassert>
+#include <cmath>
+#include <cstring>
 #include <iostream>
 #include <gtest/gtest.h>
 #include <Framework/Scalar.hpp>
@@ -240,4 +242,64 @@ TEST(Double, TryParse)
 	float res;
 	EXPECT_TRUE(bpf::Float::TryParse("42", res));
 	EXPECT_EQ(res, 42);
-}
\ No newline at end of file
+}
+TEST(Int, Parse_Syntax)
+{
+    EXPECT_EQ(bpf::Int::Parse("0x1F"), 31);
+    EXPECT_EQ(bpf::Int::Parse("-0x10"), -16);
+    EXPECT_EQ(bpf::Int::Parse("017"), 15);
+    EXPECT_EQ(bpf::Int::Parse("  +42"), 42);
+    EXPECT_THROW(bpf::Int::Parse("2147483648"), bpf::ParseException);
+    EXPECT_EQ(bpf::Int::Parse("-2147483648"), bpf::Int::MinValue);
+    EXPECT_THROW(bpf::Int::Parse(""), bpf::ParseException);
+    EXPECT_THROW(bpf::Int::Parse("42 "), bpf::ParseException);
+    EXPECT_THROW(bpf::Int::Parse("0x"), bpf::ParseException);
+    EXPECT_THROW(bpf::Int::Parse("09"), bpf::ParseException);
+    EXPECT_THROW(bpf::UInt::Parse("-1"), bpf::ParseException);
+    EXPECT_EQ(bpf::UInt64::Parse("18446744073709551615"), bpf::UInt64::MaxValue);
+    EXPECT_THROW(bpf::UInt64::Parse("18446744073709551616"), bpf::ParseException);
+    EXPECT_EQ(bpf::Int64::Parse("-9223372036854775808"), bpf::Int64::MinValue);
+    EXPECT_THROW(bpf::Int64::Parse("9223372036854775808"), bpf::ParseException);
+}
+
+TEST(Double, Parse_Exact)
+{
+    EXPECT_EQ(bpf::Double::Parse("0.1"), 0.1);
+    EXPECT_EQ(bpf::Double::Parse("1e23"), 1e23);
+    EXPECT_EQ(bpf::Double::Parse("-.5e-3"), -0.0005);
+    EXPECT_EQ(bpf::Double::Parse("9007199254740993"), 9007199254740992.0);
+    EXPECT_EQ(bpf::Double::Parse("2.2250738585072011e-308"), 2.2250738585072011e-308);
+    EXPECT_EQ(bpf::Double::Parse("4.9406564584124654e-324"), 4.9406564584124654e-324);
+    EXPECT_EQ(bpf::Double::Parse("123456789012345678901234567890"), 123456789012345678901234567890.0);
+    EXPECT_EQ(bpf::Double::Parse("0x1.8p3"), 12.0);
+    EXPECT_EQ(bpf::Double::Parse("-inf"), -std::numeric_limits<double>::infinity());
+    EXPECT_TRUE(std::isnan(bpf::Double::Parse("nan")));
+    EXPECT_EQ(bpf::Float::Parse("16777217"), 16777216.0f);
+    EXPECT_EQ(bpf::Float::Parse("3.4028235e38"), bpf::Float::MaxValue);
+    EXPECT_THROW(bpf::Double::Parse("1e400"), bpf::ParseException);
+    EXPECT_THROW(bpf::Double::Parse("1e-400"), bpf::ParseException);
+    EXPECT_THROW(bpf::Float::Parse("1e39"), bpf::ParseException);
+    EXPECT_THROW(bpf::Double::Parse("1e"), bpf::ParseException);
+    EXPECT_THROW(bpf::Double::Parse("."), bpf::ParseException);
+    EXPECT_THROW(bpf::Double::Parse("4.2x"), bpf::ParseException);
+}
+
+TEST(Double, RoundTrip)
+{
+    bpf::uint64 bits = 0x9E3779B97F4A7C15;
+    for (int i = 0; i != 100000; ++i)
+    {
+        bits = bits * 6364136223846793005 + 1442695040888963407;
+        double d;
+        std::memcpy(&d, &bits, sizeof(double));
+        if (std::isnan(d))
+            continue;
+        EXPECT_EQ(bpf::Double::Parse(bpf::String::ValueOf(d)), d);
+        float f;
+        bpf::uint32 half = static_cast<bpf::uint32>(bits >> 32);
+        std::memcpy(&f, &half, sizeof(float));
+        if (std::isnan(f))
+            continue;
+        EXPECT_EQ(bpf::Float::Parse(bpf::String::ValueOf(f)), f);
+    }
+}
@@ -29,6 +29,7 @@
 #include <Framework/Collection/List.hpp>
 #include <Framework/Collection/Stringifier.Array.hpp>
 #include <Framework/Collection/Stringifier.List.hpp>
+#include <Framework/Scalar.hpp>
 #include <Framework/String.hpp>
 #include <Framework/TypeInfo.hpp>
 #include <gtest/gtest.h>
@@ -679,6 +680,23 @@ TEST(String, ValueOf)
     EXPECT_STREQ(*bpf::String::ValueOf((void *)s), "0x456789f");
 }
 
+TEST(String, ValueOf_Shortest)
+{
+    EXPECT_STREQ(*bpf::String::ValueOf(0.1 + 0.2), "0.30000000000000004");
+    EXPECT_STREQ(*bpf::String::ValueOf(0.1f), "0.1");
+    EXPECT_STREQ(*bpf::String::ValueOf(123456.0), "123456");
+    EXPECT_STREQ(*bpf::String::ValueOf(-0.0), "-0");
+    EXPECT_STREQ(*bpf::String::ValueOf(0.00001), "0.00001");
+    EXPECT_STREQ(*bpf::String::ValueOf(1e-7), "1e-07");
+    EXPECT_STREQ(*bpf::String::ValueOf(1e20), "1e+20");
+    EXPECT_STREQ(*bpf::String::ValueOf(bpf::Double::MaxValue), "1.7976931348623157e+308");
+    EXPECT_STREQ(*bpf::String::ValueOf(5e-324), "5e-324");
+    EXPECT_STREQ(*bpf::String::ValueOf(bpf::Float::MaxValue), "3.4028235e+38");
+    EXPECT_STREQ(*bpf::String::ValueOf(bpf::Int64::MinValue), "-9223372036854775808");
+    EXPECT_STREQ(*bpf::String::ValueOf(bpf::UInt64::MaxValue), "18446744073709551615");
+    EXPECT_STREQ(*bpf::String::ValueOf(-5, 3), "-05");
+}
+
 TEST(String, Safety)
 {
     bpf::String str = "this is a test";
@@ -26,6 +26,7 @@
 // NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
 // SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
+#include <Framework/System/CPUDispatch.hpp>
 #include <Framework/System/Platform.hpp>
 #include <Framework/System/PluginInterface.hpp>
 #include <cassert>
@@ -81,6 +82,70 @@ TEST(Platform, CPU)
     EXPECT_GT(var.Freq, 0);     // Frequency has to be at least greater than 0Mhz
 }
 
+TEST(Platform, CPU_Topology)
+{
+    const auto &var = bpf::system::Platform::GetCPUInfo();
+
+    EXPECT_GT(var.NumPhysicalCores, 0);
+    EXPECT_LE(var.NumPhysicalCores, var.NumCores);
+    EXPECT_GE(var.ThreadsPerCore, 1);
+    EXPECT_GE(var.NumNodes, 1);
+    EXPECT_EQ(var.CacheLineSize & (var.CacheLineSize - 1), 0U); // Either unknown or a power of two
+    EXPECT_GE(var.L2CacheSize, var.L1CacheSize);
+    EXPECT_TRUE(var.HasFeatures(0));
+#if defined(__x86_64__) || defined(_M_X64)
+    EXPECT_TRUE(var.HasFeatures(bpf::system::CPU_FEATURE_SSE2)); // Part of the x86-64 baseline
+#endif
+#ifdef __AVX2__
+    EXPECT_TRUE(var.HasFeatures(bpf::system::CPU_FEATURE_AVX | bpf::system::CPU_FEATURE_AVX2));
+#endif
+    if (var.HasFeatures(bpf::system::CPU_FEATURE_AVX2))
+    {
+        EXPECT_TRUE(var.HasFeatures(bpf::system::CPU_FEATURE_AVX));
+    }
+}
+
+static int DispatchPortable(int a)
+{
+    return (a + 1);
+}
+
+static int DispatchSSE2(int a)
+{
+    return (a + 2);
+}
+
+static int DispatchAVX2(int a)
+{
+    return (a + 3);
+}
+
+TEST(Platform, CPUDispatch)
+{
+    using Dispatch = bpf::system::CPUDispatch<int(int)>;
+    Dispatch portable(0, {{bpf::system::CPU_FEATURE_AVX2 | bpf::system::CPU_FEATURE_FMA, &DispatchAVX2},
+                          {bpf::system::CPU_FEATURE_SSE2, &DispatchSSE2},
+                          {0, &DispatchPortable}});
+    Dispatch sse2(bpf::system::CPU_FEATURE_SSE2 | bpf::system::CPU_FEATURE_AVX2,
+                  {{bpf::system::CPU_FEATURE_AVX2 | bpf::system::CPU_FEATURE_FMA, &DispatchAVX2},
+                   {bpf::system::CPU_FEATURE_SSE2, &DispatchSSE2},
+                   {0, &DispatchPortable}});
+    static const Dispatch native = {{bpf::system::CPU_FEATURE_AVX2 | bpf::system::CPU_FEATURE_FMA, &DispatchAVX2},
+                                    {bpf::system::CPU_FEATURE_SSE2, &DispatchSSE2},
+                                    {0, &DispatchPortable}};
+
+    EXPECT_EQ(portable(1), 2);
+    EXPECT_EQ(sse2(1), 3);
+    EXPECT_EQ(portable.Get(), &DispatchPortable);
+    EXPECT_NE(native.Get(), nullptr);
+    if (bpf::system::Platform::GetCPUInfo().HasFeatures(bpf::system::CPU_FEATURE_AVX2 | bpf::system::CPU_FEATURE_FMA))
+    {
+        EXPECT_EQ(native(1), 4);
+    }
+    EXPECT_THROW(Dispatch(bpf::system::CPU_FEATURE_SSE2, {{bpf::system::CPU_FEATURE_AVX2, &DispatchAVX2}}),
+                 bpf::RuntimeException);
+}
+
 TEST(Platform, RAM)
 {
     auto var = bpf::system::Platform::GetRAMInfo();
@@ -0,0 +1,227 @@
+// Copyright (c) 2020, BlockProject 3D
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without modification,
+// are permitted provided that the following conditions are met:
+// 
+//     * Redistributions of source code must retain the above copyright notice,
+//       this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above copyright notice,
+//       this list of conditions and the following disclaimer in the documentation
+//       and/or other materials provided with the distribution.
+//     * Neither the name of BlockProject 3D nor the names of its contributors
+//       may be used to endorse or promote products derived from this software
+//       without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include <Framework/Collection/HashMap.hpp>
+#include <Framework/System/Application.hpp>
+#include <Framework/System/OSException.hpp>
+#include <Framework/System/ProcessSupervisor.hpp>
+#include <chrono>
+#include <gtest/gtest.h>
+#include <thread>
+#ifdef LINUX
+    #include <dirent.h>
+#endif
+
+extern bpf::system::Application *g_app;
+
+#ifndef WINDOWS
+TEST(ProcessSupervisor, Echo)
+{
+    bpf::system::ProcessSupervisor supervisor;
+    bpf::String out;
+    bpf::String err;
+    bool exited = false;
+    auto builder = bpf::system::Process::Builder()
+        .SetApplication((g_app->Props.AppRoot + "BPF.Tests").Path())
+        .SetEnvironment({{"__BPF_PARSE__", ""}})
+        .RedirectInput()
+        .RedirectOutput()
+        .RedirectError();
+    auto id = supervisor.Spawn(builder,
+        [&](bpf::uint64, bpf::system::EProcessStream stream, const bpf::uint8 *data, bpf::fsize size)
+        {
+            EXPECT_FALSE(exited);
+            auto str = bpf::String(reinterpret_cast<const char *>(data), size);
+            if (stream == bpf::system::EProcessStream::STANDARD_OUTPUT)
+                out += str;
+            else
+                err += str;
+        },
+        [&](bpf::uint64, bpf::system::Process &process)
+        {
+            exited = true;
+            EXPECT_FALSE(process.IsRunning());
+            EXPECT_FALSE(process.IsCrashed());
+            EXPECT_EQ(process.GetExitCode(), 2U);
+        });
+    EXPECT_EQ(supervisor.GetRunningCount(), 1U);
+    supervisor.Write(id, "this is a test\n", 15);
+    supervisor.CloseInput(id);
+    supervisor.WaitAll();
+    EXPECT_TRUE(exited);
+    EXPECT_EQ(supervisor.GetRunningCount(), 0U);
+    EXPECT_TRUE(out.StartsWith("this is a test"));
+    EXPECT_TRUE(err.StartsWith("TestError: this is a test"));
+    EXPECT_THROW(supervisor.Write(id, "a", 1), bpf::system::OSException);
+    EXPECT_EQ(supervisor.Wait(), 0U);
+}
+
+TEST(ProcessSupervisor, Many)
+{
+    bpf::system::ProcessSupervisor supervisor;
+    bpf::collection::HashMap<bpf::uint64, bpf::fsize> output;
+    bpf::fsize exits = 0;
+
+    for (int i = 0; i != 32; ++i)
+    {
+        auto builder = bpf::system::Process::Builder().SetApplication("uname").RedirectOutput();
+        auto id = supervisor.Spawn(builder,
+            [&](bpf::uint64 id, bpf::system::EProcessStream, const bpf::uint8 *, bpf::fsize size)
+            {
+                output[id] += size;
+            },
+            [&](bpf::uint64 id, bpf::system::Process &process)
+            {
+                ++exits;
+                EXPECT_EQ(process.GetExitCode(), 0U);
+                EXPECT_GT(output[id], 0U);
+            });
+        output.Add(id, 0);
+    }
+    EXPECT_EQ(supervisor.GetRunningCount(), 32U);
+    supervisor.WaitAll();
+    EXPECT_EQ(exits, 32U);
+    EXPECT_EQ(supervisor.GetRunningCount(), 0U);
+}
+
+TEST(ProcessSupervisor, LargeInput)
+{
+    bpf::system::ProcessSupervisor supervisor(4096);
+    bpf::fsize received = 0;
+    bpf::fsize maxChunk = 0;
+    bool exited = false;
+    auto builder = bpf::system::Process::Builder().SetApplication("cat").RedirectInput().RedirectOutput();
+    auto id = supervisor.Spawn(builder,
+        [&](bpf::uint64, bpf::system::EProcessStream, const bpf::uint8 *data, bpf::fsize size)
+        {
+            for (bpf::fsize i = 0; i != size; ++i)
+                EXPECT_EQ(data[i], static_cast<bpf::uint8>((received + i) % 251));
+            received += size;
+            if (size > maxChunk)
+                maxChunk = size;
+        },
+        [&](bpf::uint64, bpf::system::Process &process)
+        {
+            exited = true;
+            EXPECT_EQ(process.GetExitCode(), 0U);
+        });
+    bpf::uint8 block[1000];
+    for (bpf::fsize i = 0; i != 1024; ++i)
+    {
+        for (bpf::fsize j = 0; j != 1000; ++j)
+            block[j] = static_cast<bpf::uint8>((i * 1000 + j) % 251);
+        // Writes never block: what the pipe cannot take is queued and flushed by the reactor
+        supervisor.Write(id, block, 1000);
+    }
+    supervisor.CloseInput(id);
+    supervisor.WaitAll();
+    EXPECT_TRUE(exited);
+    EXPECT_EQ(received, 1024000U);
+    EXPECT_LE(maxChunk, 4096U);
+}
+
+TEST(ProcessSupervisor, Kill)
+{
+    bpf::system::ProcessSupervisor supervisor;
+    bool exited = false;
+    auto builder = bpf::system::Process::Builder().SetApplication("sleep").SetArguments({"10"});
+    auto id = supervisor.Spawn(builder, nullptr,
+        [&](bpf::uint64, bpf::system::Process &process)
+        {
+            exited = true;
+            EXPECT_TRUE(process.IsCrashed());
+            EXPECT_EQ(process.GetExitCode(), 9U);
+        });
+    EXPECT_EQ(supervisor.Poll(), 0U);
+    EXPECT_THROW(supervisor.Write(id, "a", 1), bpf::system::OSException);
+    supervisor.Kill(id, true);
+    supervisor.WaitAll();
+    EXPECT_TRUE(exited);
+    EXPECT_THROW(supervisor.Kill(id, true), bpf::system::OSException);
+}
+
+#ifdef LINUX
+static bpf::fsize CountDescriptors()
+{
+    bpf::fsize count = 0;
+    DIR *dir = opendir("/proc/self/fd");
+
+    if (dir == nullptr)
+        return (0);
+    while (readdir(dir) != nullptr)
+        ++count;
+    closedir(dir);
+    return (count);
+}
+
+TEST(ProcessSupervisor, Grandchild)
+{
+    bpf::system::ProcessSupervisor supervisor;
+    bpf::String out;
+    bool exited = false;
+    auto count = CountDescriptors();
+    auto builder = bpf::system::Process::Builder()
+        .SetApplication("sh")
+        .SetArguments({"-c", "echo hi; (sleep 0.2; echo late) &"})
+        .RedirectOutput();
+    supervisor.Spawn(builder,
+        [&](bpf::uint64, bpf::system::EProcessStream, const bpf::uint8 *data, bpf::fsize size)
+        {
+            out += bpf::String(reinterpret_cast<const char *>(data), size);
+        },
+        [&](bpf::uint64, bpf::system::Process &) { exited = true; });
+    supervisor.WaitAll();
+    EXPECT_TRUE(exited);
+    EXPECT_TRUE(out.StartsWith("hi"));
+    EXPECT_EQ(CountDescriptors(), count);
+    // Let the grandchild write to and close the pipe it inherited
+    std::this_thread::sleep_for(std::chrono::milliseconds(400));
+    auto builder1 = bpf::system::Process::Builder().SetApplication("sleep").SetArguments({"10"});
+    auto id = supervisor.Spawn(builder1, nullptr, nullptr);
+    auto start = std::chrono::steady_clock::now();
+    EXPECT_EQ(supervisor.Wait(200), 0U);
+    auto elapsed = std::chrono::steady_clock::now() - start;
+    EXPECT_GE(std::chrono::duration_cast<std::chrono::milliseconds>(elapsed).count(), 150);
+    supervisor.Kill(id, true);
+    supervisor.WaitAll();
+    EXPECT_FALSE(out.Contains("late"));
+}
+#endif
+
+TEST(ProcessSupervisor, Destroy)
+{
+    bool exited = false;
+    {
+        bpf::system::ProcessSupervisor supervisor;
+        auto builder = bpf::system::Process::Builder().SetApplication("sleep").SetArguments({"10"});
+        supervisor.Spawn(builder, nullptr, [&](bpf::uint64, bpf::system::Process &) { exited = true; });
+        EXPECT_EQ(supervisor.Wait(10), 0U);
+    }
+    EXPECT_FALSE(exited);
+}
+#endif
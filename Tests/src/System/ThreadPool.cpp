@@ -174,3 +174,35 @@ TEST(ThreadPool, Run_5)
         pool.Poll();
     EXPECT_EQ(res, 16384u);
 }
+
+TEST(ThreadPool, Wait)
+{
+    auto pool = bpf::system::ThreadPool(2, "Test");
+    bpf::fsize count = 0;
+    for (bpf::fsize i = 0; i != 6; ++i)
+    {
+        pool.Run(
+            [] {
+              bpf::system::Thread::Sleep(5);
+              return (bpf::Dynamic());
+            },
+            [&count](bpf::Dynamic &) { ++count; });
+    }
+    while (!pool.IsIdle())
+        pool.Wait();
+    EXPECT_EQ(count, 6u);
+    pool.Wait();
+}
+
+TEST(ThreadPool, ParallelFor)
+{
+    auto pool = bpf::system::ThreadPool(3, "Test");
+    bpf::uint8 items[10000] = {0};
+    pool.ParallelFor(10000, [&items](bpf::fsize start, bpf::fsize end) {
+        for (bpf::fsize i = start; i != end; ++i)
+            ++items[i];
+    }, 100);
+    for (bpf::fsize i = 0; i != 10000; ++i)
+        EXPECT_EQ(items[i], 1);
+    EXPECT_TRUE(pool.IsIdle());
+}